@@ -0,0 +1,26 @@
+#ifndef CMDSTAN_ARGUMENTS_ARG_CG_ITER_HPP
+#define CMDSTAN_ARGUMENTS_ARG_CG_ITER_HPP
+
+#include <cmdstan/arguments/singleton_argument.hpp>
+
+namespace cmdstan {
+
+  class arg_cg_iter: public int_argument {
+  public:
+    arg_cg_iter(): int_argument() {
+      _name = "cg_iter";
+      _description = "Maximum number of conjugate gradient iterations per step";
+      _validity = "0 < cg_iter";
+      _default = "100";
+      _default_value = 100;
+      _constrained = true;
+      _good_value = 10;
+      _bad_value = 0;
+      _value = _default_value;
+    }
+
+    bool is_valid(int value) { return value > 0; }
+  };
+
+}
+#endif
@@ -0,0 +1,41 @@
+#ifndef CMDSTAN_ARGUMENTS_ARG_NEWTON_CG_HPP
+#define CMDSTAN_ARGUMENTS_ARG_NEWTON_CG_HPP
+
+#include <cmdstan/arguments/categorical_argument.hpp>
+#include <cmdstan/arguments/arg_cg_iter.hpp>
+#include <cmdstan/arguments/arg_tolerance.hpp>
+
+namespace cmdstan {
+
+  class arg_newton_cg: public categorical_argument {
+  public:
+    arg_newton_cg() {
+      _name = "newton_cg";
+      _description = "Truncated Newton with conjugate gradients"
+        " and trust region";
+
+      _subarguments.push_back(new arg_cg_iter());
+      _subarguments.push_back(
+                              new arg_tolerance("tol_obj",
+                                                "Convergence tolerance on absolute changes "
+                                                "in objective function value",
+                                                1e-12));
+      _subarguments.push_back(
+                              new arg_tolerance("tol_rel_obj",
+                                                "Convergence tolerance on relative changes "
+                                                "in objective function value",
+                                                1e+4));
+      _subarguments.push_back(
+                              new arg_tolerance("tol_grad",
+                                                "Convergence tolerance on the norm of the gradient",
+                                                1e-8));
+      _subarguments.push_back(
+                              new arg_tolerance("tol_param",
+                                                "Convergence tolerance on changes "
+                                                "in parameter value",
+                                                1e-8));
+    }
+  };
+
+}
+#endif
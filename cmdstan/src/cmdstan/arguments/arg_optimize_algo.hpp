@@ -5,6 +5,7 @@
 #include <cmdstan/arguments/arg_bfgs.hpp>
 #include <cmdstan/arguments/arg_lbfgs.hpp>
 #include <cmdstan/arguments/arg_newton.hpp>
+#include <cmdstan/arguments/arg_newton_cg.hpp>
 
 namespace cmdstan {
 
@@ -17,6 +18,7 @@ namespace cmdstan {
       _values.push_back(new arg_bfgs());
       _values.push_back(new arg_lbfgs());
       _values.push_back(new arg_newton());
+      _values.push_back(new arg_newton_cg());
 
       _default_cursor = 1;
       _cursor = _default_cursor;
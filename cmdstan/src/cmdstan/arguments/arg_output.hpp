@@ -5,6 +5,7 @@
 #include <cmdstan/arguments/arg_output_file.hpp>
 #include <cmdstan/arguments/arg_diagnostic_file.hpp>
 #include <cmdstan/arguments/arg_refresh.hpp>
+#include <cmdstan/arguments/arg_output_format.hpp>
 
 namespace cmdstan {
 
@@ -17,6 +18,7 @@ namespace cmdstan {
       _subarguments.push_back(new arg_output_file());
       _subarguments.push_back(new arg_diagnostic_file());
       _subarguments.push_back(new arg_refresh());
+      _subarguments.push_back(new arg_output_format());
     }
   };
 
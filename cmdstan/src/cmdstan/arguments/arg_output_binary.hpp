@@ -0,0 +1,17 @@
+#ifndef CMDSTAN_ARGUMENTS_ARG_OUTPUT_BINARY_HPP
+#define CMDSTAN_ARGUMENTS_ARG_OUTPUT_BINARY_HPP
+
+#include <cmdstan/arguments/unvalued_argument.hpp>
+
+namespace cmdstan {
+
+  class arg_output_binary: public unvalued_argument {
+  public:
+    arg_output_binary() {
+      _name = "binary";
+      _description = "Binary columns of float64, read by stansummary";
+    }
+  };
+
+}
+#endif
@@ -0,0 +1,17 @@
+#ifndef CMDSTAN_ARGUMENTS_ARG_OUTPUT_CSV_HPP
+#define CMDSTAN_ARGUMENTS_ARG_OUTPUT_CSV_HPP
+
+#include <cmdstan/arguments/unvalued_argument.hpp>
+
+namespace cmdstan {
+
+  class arg_output_csv: public unvalued_argument {
+  public:
+    arg_output_csv() {
+      _name = "csv";
+      _description = "Comma separated values";
+    }
+  };
+
+}
+#endif
@@ -0,0 +1,25 @@
+#ifndef CMDSTAN_ARGUMENTS_ARG_OUTPUT_FORMAT_HPP
+#define CMDSTAN_ARGUMENTS_ARG_OUTPUT_FORMAT_HPP
+
+#include <cmdstan/arguments/list_argument.hpp>
+#include <cmdstan/arguments/arg_output_csv.hpp>
+#include <cmdstan/arguments/arg_output_binary.hpp>
+
+namespace cmdstan {
+
+  class arg_output_format: public list_argument {
+  public:
+    arg_output_format() {
+      _name = "format";
+      _description = "Format of output and diagnostic files";
+
+      _values.push_back(new arg_output_csv());
+      _values.push_back(new arg_output_binary());
+
+      _default_cursor = 0;
+      _cursor = _default_cursor;
+    }
+  };
+
+}
+#endif
@@ -9,6 +9,8 @@
 #include <cmdstan/arguments/arg_random.hpp>
 #include <cmdstan/write_model.hpp>
 #include <cmdstan/write_stan.hpp>
+#include <stan/callbacks/async_writer.hpp>
+#include <stan/callbacks/binary_writer.hpp>
 #include <stan/callbacks/interrupt.hpp>
 #include <stan/callbacks/logger.hpp>
 #include <stan/callbacks/stream_logger.hpp>
@@ -19,6 +21,7 @@
 #include <stan/services/optimize/bfgs.hpp>
 #include <stan/services/optimize/lbfgs.hpp>
 #include <stan/services/optimize/newton.hpp>
+#include <stan/services/optimize/newton_cg.hpp>
 #include <stan/services/sample/fixed_param.hpp>
 #include <stan/services/sample/hmc_nuts_dense_e.hpp>
 #include <stan/services/sample/hmc_nuts_dense_e_adapt.hpp>
@@ -35,6 +38,7 @@
 #include <stan/services/experimental/advi/fullrank.hpp>
 #include <stan/services/experimental/advi/meanfield.hpp>
 #include <boost/date_time/posix_time/posix_time_types.hpp>
+#include <boost/scoped_ptr.hpp>
 #include <fstream>
 #include <sstream>
 #include <stdexcept>
@@ -90,13 +94,28 @@ namespace cmdstan {
 
     stan::io::dump data_var_context(get_var_context(dynamic_cast<string_argument*>(parser.arg("data")->arg("file"))->value()));
 
+    bool binary_output = dynamic_cast<list_argument*>(parser.arg("output")->arg("format"))->value() == "binary";
+    std::fstream::openmode output_mode = binary_output
+      ? std::fstream::out | std::fstream::binary : std::fstream::out;
+
     std::fstream output_stream(dynamic_cast<string_argument*>(parser.arg("output")->arg("file"))->value().c_str(),
-                               std::fstream::out);
-    stan::callbacks::stream_writer sample_writer(output_stream, "# ");
+                               output_mode);
+    boost::scoped_ptr<stan::callbacks::writer> sample_writer_ptr;
+    if (binary_output)
+      sample_writer_ptr.reset(new stan::callbacks::binary_writer(output_stream));
+    else
+      sample_writer_ptr.reset(new stan::callbacks::stream_writer(output_stream, "# "));
+    // format and write draws on a background thread
+    stan::callbacks::async_writer sample_writer(*sample_writer_ptr);
 
     std::fstream diagnostic_stream(dynamic_cast<string_argument*>(parser.arg("output")->arg("diagnostic_file"))->value().c_str(),
-                                   std::fstream::out);
-    stan::callbacks::stream_writer diagnostic_writer(diagnostic_stream, "# ");
+                                   output_mode);
+    boost::scoped_ptr<stan::callbacks::writer> diagnostic_writer_ptr;
+    if (binary_output)
+      diagnostic_writer_ptr.reset(new stan::callbacks::binary_writer(diagnostic_stream));
+    else
+      diagnostic_writer_ptr.reset(new stan::callbacks::stream_writer(diagnostic_stream, "# "));
+    stan::callbacks::async_writer diagnostic_writer(*diagnostic_writer_ptr);
 
 
     //////////////////////////////////////////////////
@@ -159,6 +178,30 @@ namespace cmdstan {
                                                        logger,
                                                        init_writer,
                                                        sample_writer);
+      } else if (algo->value() == "newton_cg") {
+        int cg_iter = dynamic_cast<int_argument*>(algo->arg("newton_cg")->arg("cg_iter"))->value();
+        double tol_obj = dynamic_cast<real_argument*>(algo->arg("newton_cg")->arg("tol_obj"))->value();
+        double tol_rel_obj = dynamic_cast<real_argument*>(algo->arg("newton_cg")->arg("tol_rel_obj"))->value();
+        double tol_grad = dynamic_cast<real_argument*>(algo->arg("newton_cg")->arg("tol_grad"))->value();
+        double tol_param = dynamic_cast<real_argument*>(algo->arg("newton_cg")->arg("tol_param"))->value();
+
+        return_code = stan::services::optimize::newton_cg(model,
+                                                          init_context,
+                                                          random_seed,
+                                                          id,
+                                                          init_radius,
+                                                          cg_iter,
+                                                          tol_obj,
+                                                          tol_rel_obj,
+                                                          tol_grad,
+                                                          tol_param,
+                                                          num_iterations,
+                                                          save_iterations,
+                                                          refresh,
+                                                          interrupt,
+                                                          logger,
+                                                          init_writer,
+                                                          sample_writer);
       } else if (algo->value() == "bfgs") {
         double init_alpha = dynamic_cast<real_argument*>(algo->arg("bfgs")->arg("init_alpha"))->value();
         double tol_obj = dynamic_cast<real_argument*>(algo->arg("bfgs")->arg("tol_obj"))->value();
@@ -861,6 +904,9 @@ namespace cmdstan {
       }
     }
 
+    // write any draws the writers still hold before the streams are closed
+    sample_writer.flush();
+    diagnostic_writer.flush();
     output_stream.close();
     diagnostic_stream.close();
     for (size_t i = 0; i < valid_arguments.size(); ++i)
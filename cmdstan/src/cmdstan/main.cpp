@@ -2,10 +2,18 @@
 #include <stan/services/error_codes.hpp>
 #include <boost/exception/diagnostic_information.hpp> 
 #include <boost/exception_ptr.hpp> 
+#ifdef STAN_COMPILED_TAPE
+#include <stan/model/compiled_tape_model.hpp>
+#endif
 
 int main(int argc, const char* argv[]) {
   try {
+#ifdef STAN_COMPILED_TAPE
+    return cmdstan::command<stan::model::compiled_tape_model<stan_model> >(
+        argc, argv);
+#else
     return cmdstan::command<stan_model>(argc,argv);
+#endif
   } catch (const std::exception& e) {
     std::cout << e.what() << std::endl;
     return stan::services::error_codes::SOFTWARE;
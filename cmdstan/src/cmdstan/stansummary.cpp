@@ -65,23 +65,20 @@ int main(int argc, const char* argv[]) {
   
   Eigen::VectorXi thin(filenames.size());
   
-  ifstream.open(filenames[0].c_str());
-  
-  stan::io::stan_csv stan_csv = stan::io::stan_csv_reader::parse(ifstream, &std::cout);
+  stan::io::stan_csv stan_csv
+    = stan::io::stan_csv_reader::parse_file(filenames[0], &std::cout);
   warmup_times(0) = stan_csv.timing.warmup;
   sampling_times(0) = stan_csv.timing.sampling;
   
   stan::mcmc::chains<> chains(stan_csv);
-  ifstream.close();
   
   thin(0) = stan_csv.metadata.thin;
   
   for (std::vector<std::string>::size_type chain = 1; 
        chain < filenames.size(); chain++) {
-    ifstream.open(filenames[chain].c_str());
-    stan_csv = stan::io::stan_csv_reader::parse(ifstream, &std::cout);
+    stan_csv = stan::io::stan_csv_reader::parse_file(filenames[chain],
+                                                     &std::cout);
     chains.add(stan_csv);
-    ifstream.close();
     thin(chain) = stan_csv.metadata.thin;
     
     warmup_times(chain) = stan_csv.timing.warmup;
@@ -111,19 +108,20 @@ int main(int argc, const char* argv[]) {
   values.setZero();
   Eigen::VectorXd probs(3);
   probs << 0.05, 0.5, 0.95;
-  
+
+  // mean, sd, quantiles, n_eff and R_hat of all parameters at once
+  Eigen::MatrixXd summary = chains.summary(probs);
   for (int i = 0; i < chains.num_params(); i++) {
-    double sd = chains.sd(i);
-    double n_eff = chains.effective_sample_size(i);
-    values(i,0) = chains.mean(i);
+    double sd = summary(i,1);
+    double n_eff = summary(i,5);
+    values(i,0) = summary(i,0);
     values(i,1) = sd / sqrt(n_eff);
     values(i,2) = sd;
-    Eigen::VectorXd quantiles = chains.quantiles(i,probs);
     for (int j = 0; j < 3; j++)
-      values(i,3+j) = quantiles(j);
+      values(i,3+j) = summary(i,2+j);
     values(i,6) = n_eff;
     values(i,7) = n_eff / total_sampling_time;
-    values(i,8) = chains.split_potential_scale_reduction(i);
+    values(i,8) = summary(i,6);
   }
   
   // Prepare header
@@ -7,9 +7,10 @@ TEST(CmdStanArguments, arg_optimize_algo) {
   EXPECT_EQ("algorithm", arg.name());
   EXPECT_EQ("Optimization algorithm", arg.description());
 
-  ASSERT_EQ(3U, arg.values().size());
+  ASSERT_EQ(4U, arg.values().size());
   EXPECT_EQ("bfgs", arg.values()[0]->name());
   EXPECT_EQ("lbfgs", arg.values()[1]->name());
   EXPECT_EQ("newton", arg.values()[2]->name());
+  EXPECT_EQ("newton_cg", arg.values()[3]->name());
 }
 
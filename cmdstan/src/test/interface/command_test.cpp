@@ -94,6 +94,7 @@ TEST(StanUiCommand, printReallyPrints) {
 
   // OPTIMIZATION
   test_optimize_prints(path + " optimize algorithm=newton");
+  test_optimize_prints(path + " optimize algorithm=newton_cg");
   test_optimize_prints(path + " optimize algorithm=bfgs");
 }
 
@@ -119,3 +119,45 @@ TEST(stack_alloc, in_stack_second_block) {
   EXPECT_FALSE(allocator.in_stack(x));
   EXPECT_FALSE(allocator.in_stack(y));
 }
+
+TEST(stack_alloc, recover_all_coalesces_blocks) {
+  stan::math::stack_alloc allocator;
+  for (int i = 0; i < 10; ++i)
+    allocator.alloc(stan::math::DEFAULT_INITIAL_NBYTES / 2);
+  EXPECT_LT(1U, allocator.num_blocks());
+  size_t bytes_reserved = allocator.bytes_reserved();
+  size_t bytes_used = allocator.bytes_used();
+  EXPECT_LE(10 * (stan::math::DEFAULT_INITIAL_NBYTES / 2), bytes_used);
+  EXPECT_LE(bytes_used, bytes_reserved);
+
+  allocator.recover_all();
+  EXPECT_EQ(1U, allocator.num_blocks());
+  EXPECT_EQ(bytes_reserved, allocator.bytes_reserved());
+  EXPECT_EQ(0U, allocator.bytes_used());
+  EXPECT_EQ(bytes_used, allocator.peak_bytes_used());
+
+  // the same allocations now fit in the first block
+  for (int rep = 0; rep < 3; ++rep) {
+    for (int i = 0; i < 10; ++i)
+      allocator.alloc(stan::math::DEFAULT_INITIAL_NBYTES / 2);
+    EXPECT_EQ(1U, allocator.num_blocks());
+    allocator.recover_all();
+    EXPECT_EQ(1U, allocator.num_blocks());
+    EXPECT_EQ(bytes_reserved, allocator.bytes_reserved());
+  }
+}
+
+TEST(stack_alloc, peak_bytes_used_nested) {
+  stan::math::stack_alloc allocator;
+  allocator.alloc(100);
+  allocator.start_nested();
+  allocator.alloc(1000);
+  size_t nested_bytes_used = allocator.bytes_used();
+  allocator.recover_nested();
+  EXPECT_LT(allocator.bytes_used(), nested_bytes_used);
+  EXPECT_EQ(nested_bytes_used, allocator.peak_bytes_used());
+  allocator.free_all();
+  EXPECT_EQ(1U, allocator.num_blocks());
+  EXPECT_EQ(0U, allocator.bytes_used());
+  EXPECT_EQ(nested_bytes_used, allocator.peak_bytes_used());
+}
@@ -0,0 +1,88 @@
+#include <stan/math/mix/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/util.hpp>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <test/unit/math/prim/arr/functor/lorenz.hpp>
+#include <vector>
+
+TEST(MixMatFunctor, ode_forward_jacobian) {
+  lorenz_ode_fun lorenz;
+  stan::math::ode_forward_jacobian<lorenz_ode_fun> lorenz_jac(lorenz);
+  std::vector<double> y(3);
+  y[0] = 10.0;
+  y[1] = 1.0;
+  y[2] = 1.5;
+  std::vector<double> theta(3);
+  theta[0] = 10.0;
+  theta[1] = 28.0;
+  theta[2] = 8.0 / 3.0;
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  Eigen::MatrixXd Jy(3, 3);
+  Eigen::MatrixXd Jtheta(3, 3);
+  lorenz_jac(0.5, y, theta, x, x_int, 0, Jy, Jtheta);
+
+  stan::math::ode_system<lorenz_ode_fun> system(lorenz, theta, x, x_int, 0);
+  Eigen::VectorXd dy_dt(3);
+  Eigen::MatrixXd Jy_rev(3, 3);
+  Eigen::MatrixXd Jtheta_rev(3, 3);
+  system.jacobian(0.5, y, dy_dt, Jy_rev, Jtheta_rev);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      EXPECT_FLOAT_EQ(Jy_rev(i, j), Jy(i, j));
+      EXPECT_FLOAT_EQ(Jtheta_rev(i, j), Jtheta(i, j));
+    }
+  }
+}
+
+TEST(MixMatFunctor, ode_forward_jacobian_wrong_size) {
+  harm_osc_ode_wrong_size_1_fun harm_osc;
+  stan::math::ode_forward_jacobian<harm_osc_ode_wrong_size_1_fun>
+    harm_osc_jac(harm_osc);
+  std::vector<double> y(2, 1.0);
+  std::vector<double> theta(1, 0.15);
+  std::vector<double> x;
+  std::vector<int> x_int;
+  Eigen::MatrixXd Jy(2, 2);
+  Eigen::MatrixXd Jtheta(2, 1);
+  EXPECT_THROW_MSG(harm_osc_jac(0, y, theta, x, x_int, 0, Jy, Jtheta),
+                   std::invalid_argument,
+                   "ode_forward_jacobian: dy_dt (3) and states (2)");
+}
+
+TEST(MixMatFunctor, ode_forward_jacobian_rk45) {
+  using stan::math::var;
+  harm_osc_ode_fun harm_osc;
+  std::vector<double> ts;
+  for (int i = 0; i < 10; i++)
+    ts.push_back(0.5 * (i + 1));
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  std::vector<var> y0(2);
+  y0[0] = 1.0;
+  y0[1] = 0.5;
+  std::vector<var> theta(1, 0.15);
+  std::vector<std::vector<var> > ys
+    = stan::math::integrate_ode_rk45(stan::math::make_ode_with_jacobian(harm_osc),
+                                     y0, 0, ts, theta, x, x_int);
+  std::vector<std::vector<var> > ys_ref
+    = stan::math::integrate_ode_rk45(harm_osc, y0, 0, ts, theta, x, x_int);
+  std::vector<var> vars(y0);
+  vars.push_back(theta[0]);
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (size_t i = 0; i < 2; ++i) {
+      EXPECT_FLOAT_EQ(ys_ref[n][i].val(), ys[n][i].val());
+      std::vector<double> grad;
+      std::vector<double> grad_ref;
+      stan::math::set_zero_all_adjoints();
+      ys[n][i].grad(vars, grad);
+      stan::math::set_zero_all_adjoints();
+      ys_ref[n][i].grad(vars, grad_ref);
+      for (size_t j = 0; j < vars.size(); ++j)
+        EXPECT_FLOAT_EQ(grad_ref[j], grad[j]);
+    }
+  }
+  stan::math::recover_memory();
+}
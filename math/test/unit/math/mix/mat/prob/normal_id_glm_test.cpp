@@ -0,0 +1,40 @@
+#include <stan/math/mix/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/mix/mat/prob/higher_order_utils.hpp>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+// parameters are alpha, beta (2) and sigma; y and x are data
+template <bool fused>
+struct normal_id_glm_functor {
+  template <typename T>
+  T operator()(const Matrix<T, Dynamic, 1>& theta) const {
+    Matrix<double, Dynamic, 1> y(3);
+    y << 5.1, -3.2, 1.2;
+    Matrix<double, Dynamic, Dynamic> x(3, 2);
+    x << -1.2, 0.46, -0.42, 2.4, 0.25, 0.27;
+    Matrix<T, Dynamic, 1> beta = theta.segment(1, 2);
+    if (fused)
+      return stan::math::normal_id_glm_lpdf(y, x, theta(0), beta, theta(3));
+    Matrix<T, Dynamic, 1> mu = stan::math::multiply(x, beta);
+    for (int i = 0; i < 3; ++i)
+      mu(i) += theta(0);
+    return stan::math::normal_lpdf(y, mu, theta(3));
+  }
+};
+
+TEST(ProbDistributionsNormalIdGlm, hessian_matches_normal) {
+  Matrix<double, Dynamic, 1> theta(4);
+  theta << 0.5, 0.3, -1.8, 1.7;
+  double f_fused, f;
+  Matrix<double, Dynamic, 1> grad_fused, grad;
+  Matrix<double, Dynamic, Dynamic> hess_fused, hess;
+  stan::math::hessian(normal_id_glm_functor<true>(), theta, f_fused,
+                      grad_fused, hess_fused);
+  stan::math::hessian(normal_id_glm_functor<false>(), theta, f, grad, hess);
+  EXPECT_FLOAT_EQ(f, f_fused);
+  for (int i = 0; i < theta.size(); ++i)
+    EXPECT_FLOAT_EQ(grad(i), grad_fused(i));
+  test_hess_eq(hess, hess_fused);
+}
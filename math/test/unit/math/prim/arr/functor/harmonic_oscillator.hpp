@@ -2,6 +2,7 @@
 #define TEST_UNIT_MATH_ODE_HARMONIC_OSCILLATOR
 
 #include <stan/math/prim/scal.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stdexcept>
 
 struct harm_osc_ode_fun {
@@ -25,6 +26,27 @@ struct harm_osc_ode_fun {
   }
 };
 
+struct harm_osc_ode_jacobian {
+  int* calls_;
+
+  explicit harm_osc_ode_jacobian(int* calls) : calls_(calls) { }
+
+  void operator()(double t_in,
+                  const std::vector<double>& y_in,
+                  const std::vector<double>& theta,
+                  const std::vector<double>& x,
+                  const std::vector<int>& x_int,
+                  std::ostream* msgs,
+                  Eigen::MatrixXd& Jy,
+                  Eigen::MatrixXd& Jtheta) const {
+    ++*calls_;
+    Jy << 0, 1,
+        -1, -theta.at(0);
+    Jtheta << 0,
+        -y_in.at(1);
+  }
+};
+
 struct harm_osc_ode_data_fun {
   template <typename T0, typename T1, typename T2>
   inline
@@ -44,3 +44,34 @@ TEST(ProbAutocorrelation,fft_next_good_size) {
   EXPECT_EQ(128U, stan::math::fft_next_good_size(128));
   EXPECT_EQ(135U, stan::math::fft_next_good_size(129));
 }
+
+TEST(ProbAutocorrelation,eigen) {
+  std::fstream f("test/unit/math/prim/mat/fun/ar1.csv");
+  std::vector<double> y;
+  Eigen::MatrixXd ys(1000, 2);
+  for (size_t i = 0; i < 1000; ++i) {
+    double temp;
+    f >> temp;
+    y.push_back(temp);
+    ys(i, 0) = 0;
+    ys(i, 1) = temp;
+  }
+
+  std::vector<double> ac;
+  stan::math::autocorrelation(y, ac);
+
+  Eigen::FFT<double> fft;
+  Eigen::VectorXd ac_eigen;
+  stan::math::autocorrelation(ys.col(1), ac_eigen, fft);
+  ASSERT_EQ(1000, ac_eigen.size());
+  for (size_t i = 0; i < 1000; ++i)
+    EXPECT_NEAR(ac[i], ac_eigen(i), 1e-8);
+
+  // the engine can be reused for a different length
+  stan::math::autocorrelation(ys.col(1).head(999), ac_eigen, fft);
+  EXPECT_EQ(999, ac_eigen.size());
+  EXPECT_FLOAT_EQ(1.0, ac_eigen(0));
+  stan::math::autocorrelation(ys.col(1), ac_eigen, fft);
+  for (size_t i = 0; i < 1000; ++i)
+    EXPECT_NEAR(ac[i], ac_eigen(i), 1e-8);
+}
@@ -34,3 +34,25 @@ TEST(ProbAutocovariance,test1) {
    EXPECT_NEAR(0.90, ac[5], 0.01);
 }
 
+TEST(ProbAutocovariance,eigen) {
+  std::fstream f("test/unit/math/prim/mat/fun/ar1.csv");
+  std::vector<double> y;
+  Eigen::MatrixXd ys(1000, 2);
+  for (size_t i = 0; i < 1000; ++i) {
+    double temp;
+    f >> temp;
+    y.push_back(temp);
+    ys(i, 0) = 0;
+    ys(i, 1) = temp;
+  }
+
+  std::vector<double> acov;
+  stan::math::autocovariance(y, acov);
+
+  Eigen::FFT<double> fft;
+  Eigen::VectorXd acov_eigen;
+  stan::math::autocovariance(ys.col(1), acov_eigen, fft);
+  ASSERT_EQ(1000, acov_eigen.size());
+  for (size_t i = 0; i < 1000; ++i)
+    EXPECT_NEAR(acov[i], acov_eigen(i), 1e-8);
+}
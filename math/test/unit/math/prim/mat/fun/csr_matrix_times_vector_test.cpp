@@ -154,3 +154,22 @@ TEST(SparseStuff, csr_matrix_times_vector_v_short) {
                std::invalid_argument);
 }
 
+
+// Test that multiplication of an Eigen sparse matrix is correct.
+TEST(SparseStuff, csr_matrix_times_vector_sparse_matrix) {
+  stan::math::matrix_d m(2, 3);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a;
+  m << 2.0, 0.0, 6.0, 8.0, 0.0, 12.0;
+  a = m.sparseView();
+
+  stan::math::vector_d b(3);
+  b << 22, 33, 44;
+
+  stan::math::vector_d result = stan::math::csr_matrix_times_vector(a, b);
+  EXPECT_FLOAT_EQ( 308.0, result(0));
+  EXPECT_FLOAT_EQ( 704.0, result(1));
+
+  stan::math::vector_d c(2);
+  EXPECT_THROW(stan::math::csr_matrix_times_vector(a, c),
+               std::invalid_argument);
+}
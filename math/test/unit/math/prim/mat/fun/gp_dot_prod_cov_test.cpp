@@ -0,0 +1,88 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+TEST(MathPrimMat, vec_double_gp_dot_prod_cov) {
+  double sigma = 0.5;
+
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = 1.5;
+
+  Eigen::MatrixXd cov;
+  EXPECT_NO_THROW(cov = stan::math::gp_dot_prod_cov(x, sigma));
+  ASSERT_EQ(3, cov.rows());
+  ASSERT_EQ(3, cov.cols());
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_FLOAT_EQ(sigma * sigma + x[i] * x[j], cov(i, j))
+        << "index: (" << i << ", " << j << ")";
+}
+
+TEST(MathPrimMat, vec_eigen_gp_dot_prod_cov) {
+  double sigma = 0.5;
+
+  std::vector<Eigen::Matrix<double, -1, 1> > x(3);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i].resize(2, 1);
+    x[i] << i, 1.5 - i;
+  }
+
+  Eigen::MatrixXd cov = stan::math::gp_dot_prod_cov(x, sigma);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_FLOAT_EQ(sigma * sigma + x[i].dot(x[j]), cov(i, j))
+        << "index: (" << i << ", " << j << ")";
+}
+
+TEST(MathPrimMat, gp_dot_prod_cov_cross) {
+  double sigma = 0.5;
+
+  std::vector<double> x1(3);
+  x1[0] = -2;
+  x1[1] = -1;
+  x1[2] = 1.5;
+  std::vector<double> x2(2);
+  x2[0] = 1;
+  x2[1] = -3;
+
+  Eigen::MatrixXd cov = stan::math::gp_dot_prod_cov(x1, x2, sigma);
+  ASSERT_EQ(3, cov.rows());
+  ASSERT_EQ(2, cov.cols());
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 2; j++)
+      EXPECT_FLOAT_EQ(sigma * sigma + x1[i] * x2[j], cov(i, j))
+        << "index: (" << i << ", " << j << ")";
+
+  std::vector<Eigen::Matrix<double, 1, -1> > y1(2);
+  std::vector<Eigen::Matrix<double, 1, -1> > y2(1);
+  y1[0].resize(1, 2);
+  y1[1].resize(1, 2);
+  y2[0].resize(1, 2);
+  y1[0] << 1, 2;
+  y1[1] << -1, 0.5;
+  y2[0] << 3, -2;
+  cov = stan::math::gp_dot_prod_cov(y1, y2, sigma);
+  ASSERT_EQ(2, cov.rows());
+  ASSERT_EQ(1, cov.cols());
+  EXPECT_FLOAT_EQ(0.25 - 1, cov(0, 0));
+  EXPECT_FLOAT_EQ(0.25 - 4, cov(1, 0));
+}
+
+TEST(MathPrimMat, gp_dot_prod_cov_domain_error) {
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+
+  EXPECT_NO_THROW(stan::math::gp_dot_prod_cov(x, 0.0));
+  EXPECT_THROW(stan::math::gp_dot_prod_cov(x, -0.5), std::domain_error);
+  EXPECT_THROW(stan::math::gp_dot_prod_cov(
+                   x, std::numeric_limits<double>::infinity()),
+               std::domain_error);
+  x[2] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(stan::math::gp_dot_prod_cov(x, 0.5), std::domain_error);
+  EXPECT_THROW(stan::math::gp_dot_prod_cov(x, x, 0.5), std::domain_error);
+}
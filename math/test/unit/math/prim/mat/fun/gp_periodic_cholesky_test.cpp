@@ -0,0 +1,31 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(MathPrimMat, gp_periodic_cholesky) {
+  std::vector<double> x(4);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+  x[3] = 1;
+
+  Eigen::MatrixXd cov = stan::math::gp_periodic_cov(x, 0.7, 1.3, 2.2);
+  cov.diagonal().array() += 0.1;
+  Eigen::MatrixXd L_expected = cov.llt().matrixL();
+  Eigen::MatrixXd L = stan::math::gp_periodic_cholesky(x, 0.7, 1.3, 2.2, 0.1);
+  for (int i = 0; i < L.size(); ++i)
+    EXPECT_FLOAT_EQ(L_expected(i), L(i));
+}
+
+TEST(MathPrimMat, gp_periodic_cholesky_domain_error) {
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -2;
+  x[2] = -0.5;
+
+  EXPECT_THROW(stan::math::gp_periodic_cholesky(x, 1.0, 1.3, 2.2, -0.1),
+               std::domain_error);
+  EXPECT_THROW(stan::math::gp_periodic_cholesky(x, 1.0, 1.3, 2.2, 0.0),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::gp_periodic_cholesky(x, 1.0, 1.3, 2.2, 0.1));
+}
@@ -0,0 +1,102 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+double gp_periodic_cov_expected(double d, double sigma, double l,
+                                double p) {
+  double u = std::sin(stan::math::pi() * d / p);
+  return sigma * sigma * std::exp(-2 * u * u / (l * l));
+}
+
+TEST(MathPrimMat, vec_double_gp_periodic_cov) {
+  double sigma = 0.2;
+  double l = 5;
+  double p = 3;
+
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+
+  Eigen::MatrixXd cov;
+  EXPECT_NO_THROW(cov = stan::math::gp_periodic_cov(x, sigma, l, p));
+  ASSERT_EQ(3, cov.rows());
+  ASSERT_EQ(3, cov.cols());
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_FLOAT_EQ(gp_periodic_cov_expected(std::fabs(x[i] - x[j]),
+                                               sigma, l, p),
+                      cov(i, j))
+        << "index: (" << i << ", " << j << ")";
+}
+
+TEST(MathPrimMat, vec_eigen_gp_periodic_cov) {
+  double sigma = 0.2;
+  double l = 5;
+  double p = 3;
+
+  std::vector<Eigen::Matrix<double, -1, 1> > x(3);
+  for (size_t i = 0; i < x.size(); ++i) {
+    x[i].resize(3, 1);
+    x[i] << 2 * i, 3 * i, 4 * i;
+  }
+
+  Eigen::MatrixXd cov = stan::math::gp_periodic_cov(x, sigma, l, p);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_FLOAT_EQ(gp_periodic_cov_expected(
+                          stan::math::distance(x[i], x[j]), sigma, l, p),
+                      cov(i, j))
+        << "index: (" << i << ", " << j << ")";
+}
+
+TEST(MathPrimMat, vec_double_gp_periodic_cov_cross) {
+  double sigma = 0.2;
+  double l = 5;
+  double p = 3;
+
+  std::vector<double> x1(3);
+  x1[0] = -2;
+  x1[1] = -1;
+  x1[2] = -0.5;
+  std::vector<double> x2(2);
+  x2[0] = 1;
+  x2[1] = -1;
+
+  Eigen::MatrixXd cov = stan::math::gp_periodic_cov(x1, x2, sigma, l, p);
+  ASSERT_EQ(3, cov.rows());
+  ASSERT_EQ(2, cov.cols());
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 2; j++)
+      EXPECT_FLOAT_EQ(gp_periodic_cov_expected(std::fabs(x1[i] - x2[j]),
+                                               sigma, l, p),
+                      cov(i, j))
+        << "index: (" << i << ", " << j << ")";
+}
+
+TEST(MathPrimMat, gp_periodic_cov_domain_error) {
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+
+  EXPECT_THROW(stan::math::gp_periodic_cov(x, -0.2, 5.0, 3.0),
+               std::domain_error);
+  EXPECT_THROW(stan::math::gp_periodic_cov(x, 0.2, 0.0, 3.0),
+               std::domain_error);
+  EXPECT_THROW(stan::math::gp_periodic_cov(x, x, 0.2, 5.0, -3.0),
+               std::domain_error);
+  x[2] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(stan::math::gp_periodic_cov(x, 0.2, 5.0, 3.0),
+               std::domain_error);
+  x[2] = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(stan::math::gp_periodic_cov(x, 0.2, 5.0, 3.0),
+               std::domain_error);
+}
+
+TEST(MathPrimMat, gp_periodic_cov_empty) {
+  std::vector<double> x;
+  Eigen::MatrixXd cov = stan::math::gp_periodic_cov(x, 0.2, 5.0, 3.0);
+  EXPECT_EQ(0, cov.size());
+}
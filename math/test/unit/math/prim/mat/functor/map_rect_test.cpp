@@ -0,0 +1,68 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+struct map_rect_prim_lpdf {
+  template <typename T1, typename T2>
+  Eigen::Matrix<typename stan::return_type<T1, T2>::type, Eigen::Dynamic, 1>
+  operator()(const Eigen::Matrix<T1, Eigen::Dynamic, 1>& eta,
+             const Eigen::Matrix<T2, Eigen::Dynamic, 1>& theta,
+             const std::vector<double>& x_r, const std::vector<int>& x_i,
+             std::ostream* msgs = 0) const {
+    Eigen::Matrix<typename stan::return_type<T1, T2>::type, Eigen::Dynamic, 1>
+      res(1);
+    res(0) = stan::math::normal_log(x_r, eta(0) + theta(0), x_i[0]);
+    return res;
+  }
+};
+
+TEST(MathPrimMatFunctor, map_rect_values) {
+  Eigen::VectorXd shared_params(1);
+  shared_params << 1;
+  std::vector<Eigen::VectorXd> job_params(3, Eigen::VectorXd(1));
+  std::vector<std::vector<double> > x_r(3, std::vector<double>(2));
+  std::vector<std::vector<int> > x_i(3, std::vector<int>(1, 2));
+  for (int i = 0; i < 3; ++i) {
+    job_params[i] << i;
+    x_r[i][0] = i;
+    x_r[i][1] = -i;
+  }
+
+  Eigen::VectorXd res
+    = stan::math::map_rect<0, map_rect_prim_lpdf>(shared_params, job_params,
+                                                  x_r, x_i);
+  ASSERT_EQ(3, res.size());
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(stan::math::normal_log(x_r[i], 1 + i, 2), res(i));
+}
+
+TEST(MathPrimMatFunctor, map_rect_empty) {
+  Eigen::VectorXd shared_params(1);
+  shared_params << 1;
+  std::vector<Eigen::VectorXd> job_params;
+  std::vector<std::vector<double> > x_r;
+  std::vector<std::vector<int> > x_i;
+  Eigen::VectorXd res
+    = stan::math::map_rect<0, map_rect_prim_lpdf>(shared_params, job_params,
+                                                  x_r, x_i);
+  EXPECT_EQ(0, res.size());
+}
+
+TEST(MathPrimMatFunctor, map_rect_size_mismatch) {
+  Eigen::VectorXd shared_params(1);
+  std::vector<Eigen::VectorXd> job_params(2, Eigen::VectorXd(1));
+  std::vector<std::vector<double> > x_r(3, std::vector<double>(2));
+  std::vector<std::vector<int> > x_i(2, std::vector<int>(1, 2));
+  EXPECT_THROW((stan::math::map_rect<0, map_rect_prim_lpdf>(shared_params,
+                                                            job_params,
+                                                            x_r, x_i)),
+               std::invalid_argument);
+
+  x_r.resize(2);
+  job_params[1].resize(2);
+  EXPECT_THROW((stan::math::map_rect<0, map_rect_prim_lpdf>(shared_params,
+                                                            job_params,
+                                                            x_r, x_i)),
+               std::invalid_argument);
+}
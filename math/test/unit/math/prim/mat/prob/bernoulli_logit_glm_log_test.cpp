@@ -0,0 +1,18 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(ProbBernoulliLogitGlm, log_matches_lpmf) {
+  std::vector<int> n(2, 1);
+  Eigen::MatrixXd x(2, 2);
+  x << 1, 2, 3, 4;
+  Eigen::VectorXd beta(2);
+  beta << 0.3, -2;
+
+  EXPECT_FLOAT_EQ((stan::math::bernoulli_logit_glm_lpmf(n, x, 1.0, beta)),
+                  (stan::math::bernoulli_logit_glm_log(n, x, 1.0, beta)));
+  EXPECT_FLOAT_EQ((stan::math::bernoulli_logit_glm_lpmf<true>(n, x, 1.0, beta)),
+                  (stan::math::bernoulli_logit_glm_log<true>(n, x, 1.0, beta)));
+  EXPECT_FLOAT_EQ((stan::math::bernoulli_logit_glm_lpmf<false>(n, x, 1.0, beta)),
+                  (stan::math::bernoulli_logit_glm_log<false>(n, x, 1.0, beta)));
+}
@@ -0,0 +1,66 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+TEST(ProbDistributionsBernoulliLogitGlm, matches_bernoulli_logit) {
+  std::vector<int> n(4);
+  n[0] = 1;
+  n[1] = 0;
+  n[2] = 1;
+  n[3] = 0;
+  Matrix<double, Dynamic, Dynamic> x(4, 2);
+  x << -12, 46, -42, 24, 25, 27, 0.1, -0.3;
+  Matrix<double, Dynamic, 1> beta(2);
+  beta << 0.3, 0.02;
+  Matrix<double, Dynamic, 1> alpha(4);
+  alpha << 0.5, -7, 2, 1;
+  Matrix<double, Dynamic, 1> theta = x * beta + alpha;
+
+  EXPECT_FLOAT_EQ(stan::math::bernoulli_logit_lpmf(n, theta),
+                  stan::math::bernoulli_logit_glm_lpmf(n, x, alpha, beta));
+  theta = x * beta;
+  theta.array() += 0.5;
+  EXPECT_FLOAT_EQ(stan::math::bernoulli_logit_lpmf(n, theta),
+                  stan::math::bernoulli_logit_glm_lpmf(n, x, 0.5, beta));
+  EXPECT_FLOAT_EQ(0.0, stan::math::bernoulli_logit_glm_lpmf<true>(n, x,
+                                                                  alpha,
+                                                                  beta));
+}
+
+TEST(ProbDistributionsBernoulliLogitGlm, extreme_values) {
+  std::vector<int> n(2);
+  n[0] = 1;
+  n[1] = 0;
+  Matrix<double, Dynamic, Dynamic> x(2, 1);
+  x << 40, 40;
+  Matrix<double, Dynamic, 1> beta(1);
+  beta << 1;
+  Matrix<double, Dynamic, 1> theta = x * beta;
+  EXPECT_FLOAT_EQ(stan::math::bernoulli_logit_lpmf(n, theta),
+                  stan::math::bernoulli_logit_glm_lpmf(n, x, 0.0, beta));
+}
+
+TEST(ProbDistributionsBernoulliLogitGlm, errors) {
+  std::vector<int> n(2, 1);
+  Matrix<double, Dynamic, Dynamic> x(2, 2);
+  x << 1, 2, 3, 4;
+  Matrix<double, Dynamic, 1> beta(2);
+  beta << 0.3, -2;
+
+  EXPECT_NO_THROW(stan::math::bernoulli_logit_glm_lpmf(n, x, 1.0, beta));
+  n[1] = 2;
+  EXPECT_THROW(stan::math::bernoulli_logit_glm_lpmf(n, x, 1.0, beta),
+               std::domain_error);
+  n[1] = 0;
+  EXPECT_THROW(stan::math::bernoulli_logit_glm_lpmf(
+                   n, x, std::numeric_limits<double>::infinity(), beta),
+               std::domain_error);
+  n.push_back(1);
+  EXPECT_THROW(stan::math::bernoulli_logit_glm_lpmf(n, x, 1.0, beta),
+               std::invalid_argument);
+}
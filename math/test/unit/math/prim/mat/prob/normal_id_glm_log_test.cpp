@@ -0,0 +1,22 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+
+TEST(ProbNormalIdGlm, log_matches_lpdf) {
+  Eigen::MatrixXd x(2, 2);
+  x << 1, 2, 3, 4;
+  Eigen::VectorXd beta(2);
+  beta << 0.3, -2;
+  Eigen::VectorXd y(2);
+  y << 1, 2;
+
+  EXPECT_FLOAT_EQ((stan::math::normal_id_glm_lpdf(y, x, 1.0, beta, 2.0)),
+                  (stan::math::normal_id_glm_log(y, x, 1.0, beta, 2.0)));
+  EXPECT_FLOAT_EQ((stan::math::normal_id_glm_lpdf<true>(y, x, 1.0, beta,
+                                                        2.0)),
+                  (stan::math::normal_id_glm_log<true>(y, x, 1.0, beta,
+                                                       2.0)));
+  EXPECT_FLOAT_EQ((stan::math::normal_id_glm_lpdf<false>(y, x, 1.0, beta,
+                                                         2.0)),
+                  (stan::math::normal_id_glm_log<false>(y, x, 1.0, beta,
+                                                        2.0)));
+}
@@ -0,0 +1,77 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+TEST(ProbDistributionsNormalIdGlm, matches_normal) {
+  Matrix<double, Dynamic, Dynamic> x(3, 2);
+  x << -12, 46, -42, 24, 25, 27;
+  Matrix<double, Dynamic, 1> beta(2);
+  beta << 0.3, -2;
+  Matrix<double, Dynamic, 1> y(3);
+  y << 51, 32, 12;
+  Matrix<double, Dynamic, 1> alpha(3);
+  alpha << 3, -7, 2;
+  Matrix<double, Dynamic, 1> sigma(3);
+  sigma << 10, 4, 6;
+  Matrix<double, Dynamic, 1> mu = x * beta + alpha;
+
+  EXPECT_FLOAT_EQ(stan::math::normal_lpdf(y, mu, sigma),
+                  stan::math::normal_id_glm_lpdf(y, x, alpha, beta, sigma));
+  EXPECT_FLOAT_EQ(stan::math::normal_lpdf(y, mu, 5.0),
+                  stan::math::normal_id_glm_lpdf(y, x, alpha, beta, 5.0));
+
+  mu = x * beta;
+  mu.array() += 0.5;
+  std::vector<double> y_vec(y.data(), y.data() + 3);
+  EXPECT_FLOAT_EQ(stan::math::normal_lpdf(y_vec, mu, sigma),
+                  stan::math::normal_id_glm_lpdf(y_vec, x, 0.5, beta, sigma));
+  EXPECT_FLOAT_EQ(0.0, stan::math::normal_id_glm_lpdf<true>(y, x, alpha,
+                                                            beta, sigma));
+}
+
+TEST(ProbDistributionsNormalIdGlm, zero_rows) {
+  Matrix<double, Dynamic, Dynamic> x(0, 2);
+  Matrix<double, Dynamic, 1> beta(2);
+  beta << 0.3, -2;
+  Matrix<double, Dynamic, 1> y(0);
+  EXPECT_FLOAT_EQ(0.0, stan::math::normal_id_glm_lpdf(y, x, 1.0, beta,
+                                                      2.0));
+}
+
+TEST(ProbDistributionsNormalIdGlm, errors) {
+  Matrix<double, Dynamic, Dynamic> x(2, 2);
+  x << 1, 2, 3, 4;
+  Matrix<double, Dynamic, 1> beta(2);
+  beta << 0.3, -2;
+  Matrix<double, Dynamic, 1> y(2);
+  y << 1, 2;
+  double inf = std::numeric_limits<double>::infinity();
+
+  EXPECT_NO_THROW(stan::math::normal_id_glm_lpdf(y, x, 1.0, beta, 2.0));
+  EXPECT_THROW(stan::math::normal_id_glm_lpdf(y, x, 1.0, beta, -2.0),
+               std::domain_error);
+  EXPECT_THROW(stan::math::normal_id_glm_lpdf(y, x, inf, beta, 2.0),
+               std::domain_error);
+  Matrix<double, Dynamic, 1> y_nan = y;
+  y_nan(1) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(stan::math::normal_id_glm_lpdf(y_nan, x, 1.0, beta, 2.0),
+               std::domain_error);
+  Matrix<double, Dynamic, Dynamic> x_inf = x;
+  x_inf(1, 0) = inf;
+  EXPECT_THROW(stan::math::normal_id_glm_lpdf(y, x_inf, 1.0, beta, 2.0),
+               std::domain_error);
+
+  Matrix<double, Dynamic, 1> y3(3);
+  y3 << 1, 2, 3;
+  EXPECT_THROW(stan::math::normal_id_glm_lpdf(y3, x, 1.0, beta, 2.0),
+               std::invalid_argument);
+  Matrix<double, Dynamic, 1> beta3(3);
+  beta3 << 1, 2, 3;
+  EXPECT_THROW(stan::math::normal_id_glm_lpdf(y, x, 1.0, beta3, 2.0),
+               std::invalid_argument);
+}
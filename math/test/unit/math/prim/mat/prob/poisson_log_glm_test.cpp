@@ -0,0 +1,53 @@
+#include <stan/math/prim/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+
+TEST(ProbDistributionsPoissonLogGlm, matches_poisson_log) {
+  std::vector<int> n(3);
+  n[0] = 15;
+  n[1] = 3;
+  n[2] = 0;
+  Matrix<double, Dynamic, Dynamic> x(3, 2);
+  x << -1.2, 0.46, -0.42, 2.4, 0.25, 0.27;
+  Matrix<double, Dynamic, 1> beta(2);
+  beta << 0.3, 0.8;
+  Matrix<double, Dynamic, 1> alpha(3);
+  alpha << 0.5, -0.7, 2;
+  Matrix<double, Dynamic, 1> theta = x * beta + alpha;
+
+  EXPECT_FLOAT_EQ(stan::math::poisson_log_lpmf(n, theta),
+                  stan::math::poisson_log_glm_lpmf(n, x, alpha, beta));
+  EXPECT_FLOAT_EQ(stan::math::poisson_log_lpmf<true>(n, theta),
+                  stan::math::poisson_log_glm_lpmf<true>(n, x, alpha, beta));
+  theta = x * beta;
+  theta.array() += 1.5;
+  EXPECT_FLOAT_EQ(stan::math::poisson_log_lpmf(n, theta),
+                  stan::math::poisson_log_glm_lpmf(n, x, 1.5, beta));
+}
+
+TEST(ProbDistributionsPoissonLogGlm, errors) {
+  std::vector<int> n(2, 1);
+  Matrix<double, Dynamic, Dynamic> x(2, 2);
+  x << 1, 2, 3, 4;
+  Matrix<double, Dynamic, 1> beta(2);
+  beta << 0.3, -2;
+
+  EXPECT_NO_THROW(stan::math::poisson_log_glm_lpmf(n, x, 1.0, beta));
+  n[1] = -1;
+  EXPECT_THROW(stan::math::poisson_log_glm_lpmf(n, x, 1.0, beta),
+               std::domain_error);
+  n[1] = 0;
+  beta(0) = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(stan::math::poisson_log_glm_lpmf(n, x, 1.0, beta),
+               std::domain_error);
+  beta(0) = 0.3;
+  Matrix<double, Dynamic, 1> alpha(3);
+  alpha << 1, 2, 3;
+  EXPECT_THROW(stan::math::poisson_log_glm_lpmf(n, x, alpha, beta),
+               std::invalid_argument);
+}
@@ -16,12 +16,12 @@ TEST(AgradRevErrorHandlingScalar, CheckConsistentSizeVarCheckVectorized) {
     a.push_back(var(i));
   }
 
-  size_t stack_size = stan::math::ChainableStack::var_stack_.size();
+  size_t stack_size = stan::math::ChainableStack::instance().var_stack_.size();
 
   EXPECT_EQ(10U,stack_size);
   EXPECT_NO_THROW(check_consistent_sizes(function,"a",a,"b",b));
 
-  size_t stack_size_after_call = stan::math::ChainableStack::var_stack_.size();
+  size_t stack_size_after_call = stan::math::ChainableStack::instance().var_stack_.size();
   EXPECT_EQ(10U,stack_size_after_call);
   stan::math::recover_memory();
 }
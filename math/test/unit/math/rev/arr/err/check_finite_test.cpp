@@ -13,17 +13,17 @@ TEST(AgradRevErrorHandlingScalar, CheckFiniteVarCheckVectorized) {
   for (int i = 0; i < N; ++i)
     a.push_back(var(i));
 
-  size_t stack_size = stan::math::ChainableStack::var_stack_.size();
+  size_t stack_size = stan::math::ChainableStack::instance().var_stack_.size();
 
   EXPECT_EQ(5U,stack_size);
   EXPECT_NO_THROW(check_finite(function,"a",a));
 
-  size_t stack_size_after_call = stan::math::ChainableStack::var_stack_.size();
+  size_t stack_size_after_call = stan::math::ChainableStack::instance().var_stack_.size();
   EXPECT_EQ(5U,stack_size_after_call);
 
   a[1] = std::numeric_limits<double>::infinity();
   EXPECT_THROW(check_finite(function,"a",a),std::domain_error);
-  stack_size_after_call = stan::math::ChainableStack::var_stack_.size();
+  stack_size_after_call = stan::math::ChainableStack::instance().var_stack_.size();
   EXPECT_EQ(6U,stack_size_after_call);
 
   stan::math::recover_memory();
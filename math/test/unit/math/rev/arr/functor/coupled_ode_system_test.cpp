@@ -542,3 +542,51 @@ TEST_F(StanAgradRevOde, memory_recovery_exception_vv) {
   }
 }
 
+
+// ******************** Analytic Jacobian ****************************
+
+template <typename T1, typename T2>
+void test_coupled_ode_system_analytic_jacobian(const std::vector<T1>& y0,
+                                               const std::vector<T2>& theta) {
+  using stan::math::coupled_ode_system;
+  using stan::math::ode_with_jacobian;
+  typedef ode_with_jacobian<harm_osc_ode_fun, harm_osc_ode_jacobian>
+    harm_osc_jac_fun;
+  std::vector<double> x;
+  std::vector<int> x_int;
+  harm_osc_ode_fun harm_osc;
+  int calls = 0;
+  harm_osc_jac_fun harm_osc_jac(harm_osc, harm_osc_ode_jacobian(&calls));
+
+  coupled_ode_system<harm_osc_ode_fun, T1, T2>
+    system(harm_osc, y0, theta, x, x_int, 0);
+  coupled_ode_system<harm_osc_jac_fun, T1, T2>
+    system_jac(harm_osc_jac, y0, theta, x, x_int, 0);
+  ASSERT_EQ(system.size(), system_jac.size());
+
+  std::vector<double> z(system.size());
+  for (size_t n = 0; n < z.size(); n++)
+    z[n] = 0.3 * n - 0.7;
+  std::vector<double> dz_dt(system.size());
+  std::vector<double> dz_dt_jac(system.size());
+  system(z, dz_dt, 0.5);
+  system_jac(z, dz_dt_jac, 0.5);
+  EXPECT_EQ(1, calls);
+  for (size_t n = 0; n < z.size(); n++)
+    EXPECT_FLOAT_EQ(dz_dt[n], dz_dt_jac[n]);
+}
+
+TEST_F(StanAgradRevOde, coupled_ode_system_analytic_jacobian) {
+  using stan::math::var;
+  std::vector<double> y0_d(2);
+  y0_d[0] = 1.0;
+  y0_d[1] = 0.5;
+  std::vector<double> theta_d(1, 0.15);
+  std::vector<var> y0_v(y0_d.begin(), y0_d.end());
+  std::vector<var> theta_v(theta_d.begin(), theta_d.end());
+
+  test_coupled_ode_system_analytic_jacobian(y0_d, theta_v);
+  test_coupled_ode_system_analytic_jacobian(y0_v, theta_d);
+  test_coupled_ode_system_analytic_jacobian(y0_v, theta_v);
+  EXPECT_TRUE(stan::math::empty_nested());
+}
@@ -9,7 +9,7 @@ namespace test {
 
   void check_varis_on_stack(const std::vector<stan::math::var>& x) {
     for (size_t n = 0; n < x.size(); ++n)
-      EXPECT_TRUE(stan::math::ChainableStack::memalloc_.in_stack(x[n].vi_))
+      EXPECT_TRUE(stan::math::ChainableStack::instance().memalloc_.in_stack(x[n].vi_))
         << n << " is not on the stack";
   }
   
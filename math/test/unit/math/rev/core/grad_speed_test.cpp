@@ -0,0 +1,105 @@
+#include <stan/math/rev/core.hpp>
+#include <gtest/gtest.h>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+// Compares the reverse sweep over linear nodes with the sweep over
+// equivalent varis propagating through virtual chain() calls.
+
+namespace {
+
+  class virtual_add_vv_vari : public stan::math::op_vv_vari {
+  public:
+    virtual_add_vv_vari(stan::math::vari* avi, stan::math::vari* bvi)
+      : op_vv_vari(avi->val_ + bvi->val_, avi, bvi) {
+    }
+    void chain() {
+      avi_->adj_ += adj_;
+      bvi_->adj_ += adj_;
+    }
+  };
+
+  class virtual_multiply_vd_vari : public stan::math::op_vd_vari {
+  public:
+    virtual_multiply_vd_vari(stan::math::vari* avi, double b)
+      : op_vd_vari(avi->val_ * b, avi, b) {
+    }
+    void chain() {
+      avi_->adj_ += adj_ * bd_;
+    }
+  };
+
+  class virtual_multiply_vv_vari : public stan::math::op_vv_vari {
+  public:
+    virtual_multiply_vv_vari(stan::math::vari* avi, stan::math::vari* bvi)
+      : op_vv_vari(avi->val_ * bvi->val_, avi, bvi) {
+    }
+    void chain() {
+      avi_->adj_ += bvi_->val_ * adj_;
+      bvi_->adj_ += avi_->val_ * adj_;
+    }
+  };
+
+  const int N = 1000;
+  const int TERMS = 200;
+  const int REPS = 20;
+
+  // sum_n x[n % N] * x[(n + 1) % N] * c_n
+  stan::math::var linear_nodes(const std::vector<stan::math::var>& x) {
+    stan::math::var sum = 0;
+    for (int n = 0; n < N * TERMS; ++n)
+      sum += x[n % N] * x[(n + 1) % N] * (1.0 / (1 + n));
+    return sum;
+  }
+
+  stan::math::var virtual_nodes(const std::vector<stan::math::var>& x) {
+    using stan::math::var;
+    var sum = 0;
+    for (int n = 0; n < N * TERMS; ++n) {
+      var term(new virtual_multiply_vv_vari(x[n % N].vi_,
+                                            x[(n + 1) % N].vi_));
+      term = var(new virtual_multiply_vd_vari(term.vi_, 1.0 / (1 + n)));
+      sum = var(new virtual_add_vv_vari(sum.vi_, term.vi_));
+    }
+    return sum;
+  }
+
+  template <typename F>
+  double time_sweeps(const F& f, std::vector<double>& g) {
+    using stan::math::var;
+    std::vector<var> x;
+    for (int n = 0; n < N; ++n)
+      x.push_back(var(0.5 + n / static_cast<double>(N)));
+    var y = f(x);
+    std::chrono::steady_clock::time_point start
+      = std::chrono::steady_clock::now();
+    for (int r = 0; r < REPS; ++r) {
+      stan::math::set_zero_all_adjoints();
+      y.grad();
+    }
+    std::chrono::duration<double> elapsed
+      = std::chrono::steady_clock::now() - start;
+    g.clear();
+    for (int n = 0; n < N; ++n)
+      g.push_back(x[n].adj());
+    stan::math::recover_memory();
+    return elapsed.count();
+  }
+
+}
+
+TEST(AgradRevGrad, speed_of_linear_node_sweep) {
+  std::vector<double> g_linear, g_virtual;
+  time_sweeps(linear_nodes, g_linear);  // warm up the tape capacity
+  double linear = time_sweeps(linear_nodes, g_linear);
+  double virt = time_sweeps(virtual_nodes, g_virtual);
+  std::cout << "grad() over " << 3 * N * TERMS << " nodes, "
+            << REPS << " sweeps:" << std::endl
+            << "  linear nodes:  " << linear << " s" << std::endl
+            << "  virtual nodes: " << virt << " s" << std::endl;
+
+  ASSERT_EQ(g_virtual.size(), g_linear.size());
+  for (size_t n = 0; n < g_linear.size(); ++n)
+    EXPECT_FLOAT_EQ(g_virtual[n], g_linear[n]);
+}
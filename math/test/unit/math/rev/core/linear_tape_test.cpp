@@ -0,0 +1,105 @@
+#include <stan/math/rev/core.hpp>
+#include <test/unit/math/rev/mat/fun/util.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+// virtual node computing a * b, as the arithmetic varis did before
+// they were recorded as linear nodes
+class virtual_multiply_vari : public stan::math::op_vv_vari {
+public:
+  virtual_multiply_vari(stan::math::vari* avi, stan::math::vari* bvi)
+    : op_vv_vari(avi->val_ * bvi->val_, avi, bvi) {
+  }
+  void chain() {
+    avi_->adj_ += bvi_->val_ * adj_;
+    bvi_->adj_ += avi_->val_ * adj_;
+  }
+};
+
+TEST(AgradRevLinearTape, n_ary_node) {
+  using stan::math::vari;
+  AVAR a = 2, b = 3, c = 5, d = 7;
+  vari* operands[4] = { a.vi_, b.vi_, c.vi_, d.vi_ };
+  double partials[4] = { 1, -2, 3, -4 };
+  vari* result = new vari(17, false);
+  stan::math::push_linear_node(result, 4, operands, partials);
+  AVAR f(result);
+
+  AVEC x = createAVEC(a, b, c, d);
+  VEC g;
+  f.grad(x, g);
+  ASSERT_EQ(4U, g.size());
+  for (int n = 0; n < 4; ++n)
+    EXPECT_FLOAT_EQ(partials[n], g[n]);
+}
+
+TEST(AgradRevLinearTape, interleaved_with_virtual_nodes) {
+  using stan::math::var;
+  // y = ((a * b) + a) (virtual *) b, then - a, then (virtual *) y
+  AVAR a = 2, b = 3;
+  var y = a * b + a;
+  y = var(new virtual_multiply_vari(y.vi_, b.vi_));
+  y = y - a;
+  var f = var(new virtual_multiply_vari(y.vi_, y.vi_));
+  // y = (a * b + a) * b - a = a b^2 + a b - a
+  double y_val = 2 * 9 + 2 * 3 - 2;
+  EXPECT_FLOAT_EQ(y_val * y_val, f.val());
+
+  AVEC x = createAVEC(a, b);
+  VEC g;
+  f.grad(x, g);
+  EXPECT_FLOAT_EQ(2 * y_val * (9 + 3 - 1), g[0]);
+  EXPECT_FLOAT_EQ(2 * y_val * (2 * 2 * 3 + 2), g[1]);
+}
+
+TEST(AgradRevLinearTape, nested) {
+  using stan::math::var;
+  stan::math::ChainableStack::AutodiffStackStorage& stack
+    = stan::math::ChainableStack::instance();
+  AVAR a = 2;
+  var outer = a * a;
+  size_t num_nodes = stack.op_results_.size();
+  size_t num_operands = stack.op_operands_.size();
+
+  stan::math::start_nested();
+  AVAR b = 3;
+  var inner = b * b * a;
+  inner.grad();
+  EXPECT_FLOAT_EQ(2 * 3 * 2, b.adj());
+  EXPECT_FLOAT_EQ(9, a.adj());
+  stan::math::recover_memory_nested();
+  EXPECT_EQ(num_nodes, stack.op_results_.size());
+  EXPECT_EQ(num_operands, stack.op_operands_.size());
+
+  a.vi_->set_zero_adjoint();
+  outer.grad();
+  EXPECT_FLOAT_EQ(4, a.adj());
+  stan::math::recover_memory();
+  EXPECT_EQ(0U, stack.op_results_.size());
+  EXPECT_EQ(0U, stack.op_partials_.size());
+}
+
+TEST(AgradRevLinearTape, nan_partials) {
+  AVAR a = std::numeric_limits<double>::quiet_NaN();
+  AVAR b = 3;
+  AVAR f = a * b;
+  AVEC x = createAVEC(a, b);
+  VEC g;
+  f.grad(x, g);
+  EXPECT_TRUE(stan::math::is_nan(g[0]));
+  EXPECT_TRUE(stan::math::is_nan(g[1]));
+}
+
+TEST(AgradRevLinearTape, zero_all_adjoints) {
+  AVAR a = 2, b = 3;
+  AVAR f = a * b + b;
+  f.grad();
+  EXPECT_FLOAT_EQ(3, b.adj());
+  stan::math::set_zero_all_adjoints();
+  EXPECT_FLOAT_EQ(0, f.adj());
+  EXPECT_FLOAT_EQ(0, b.adj());
+  f.grad();
+  EXPECT_FLOAT_EQ(3, b.adj());
+  stan::math::recover_memory();
+}
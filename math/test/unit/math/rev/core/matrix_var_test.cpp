@@ -0,0 +1,114 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+
+TEST(AgradRevMatrixVar, construct_from_double) {
+  using stan::math::matrix_var;
+  Eigen::MatrixXd a(2, 3);
+  a << 1, 2, 3, 4, 5, 6;
+
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  matrix_var A(a);
+  EXPECT_EQ(stack_size,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  EXPECT_EQ(2, A.rows());
+  EXPECT_EQ(3, A.cols());
+  EXPECT_EQ(6, A.size());
+  for (int i = 0; i < a.size(); ++i) {
+    EXPECT_FLOAT_EQ(a(i), A.val()(i));
+    EXPECT_FLOAT_EQ(0, A.adj()(i));
+  }
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrixVar, construct_from_var) {
+  using stan::math::matrix_var;
+  using stan::math::var;
+  Eigen::Matrix<var, -1, 1> x(3);
+  x << 1, 2, 3;
+  matrix_var X(x);
+  EXPECT_EQ(3, X.rows());
+  EXPECT_EQ(1, X.cols());
+  X.adj() << 4, 5, 6;
+
+  var f = X(0) + X(2, 0);
+  f.grad();
+  EXPECT_FLOAT_EQ(4, f.val());
+  EXPECT_FLOAT_EQ(5, x(0).adj());
+  EXPECT_FLOAT_EQ(5, x(1).adj());
+  EXPECT_FLOAT_EQ(7, x(2).adj());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrixVar, element) {
+  using stan::math::matrix_var;
+  using stan::math::var;
+  Eigen::MatrixXd a(2, 2);
+  a << 1, 2, 3, 4;
+  matrix_var A(a);
+
+  var f = A(0, 1) * A(1, 0);
+  EXPECT_FLOAT_EQ(6, f.val());
+  f.grad();
+  EXPECT_FLOAT_EQ(0, A.adj()(0, 0));
+  EXPECT_FLOAT_EQ(3, A.adj()(0, 1));
+  EXPECT_FLOAT_EQ(2, A.adj()(1, 0));
+  EXPECT_FLOAT_EQ(0, A.adj()(1, 1));
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrixVar, set_zero_all_adjoints) {
+  using stan::math::matrix_var;
+  using stan::math::var;
+  Eigen::MatrixXd a(2, 2);
+  a << 1, 2, 3, 4;
+  matrix_var A(a);
+  var f = stan::math::sum(A);
+  f.grad();
+  EXPECT_FLOAT_EQ(1, A.adj()(1, 1));
+
+  stan::math::set_zero_all_adjoints();
+  for (int i = 0; i < A.size(); ++i)
+    EXPECT_FLOAT_EQ(0, A.adj()(i));
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrixVar, nested) {
+  using stan::math::matrix_var;
+  using stan::math::var;
+  Eigen::MatrixXd a(2, 2);
+  a << 1, 2, 3, 4;
+  matrix_var A(a);
+
+  stan::math::start_nested();
+  matrix_var B = stan::math::multiply(A, a);
+  var f = stan::math::sum(B);
+  f.grad();
+  EXPECT_FLOAT_EQ(3, A.adj()(0, 0));
+  EXPECT_FLOAT_EQ(7, A.adj()(0, 1));
+  stan::math::set_zero_all_adjoints_nested();
+  EXPECT_FLOAT_EQ(0, B.adj()(0, 0));
+  stan::math::recover_memory_nested();
+
+  stan::math::set_zero_all_adjoints();
+  var g = stan::math::sum(A);
+  g.grad();
+  EXPECT_FLOAT_EQ(1, A.adj()(0, 0));
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrixVar, one_node_per_operation) {
+  using stan::math::matrix_var;
+  using stan::math::multiply;
+  Eigen::MatrixXd a = Eigen::MatrixXd::Random(20, 20);
+  matrix_var A(a);
+  matrix_var B(a);
+
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  matrix_var C = multiply(A, B);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  EXPECT_TRUE(C.val().isApprox(a * a));
+  stan::math::recover_memory();
+}
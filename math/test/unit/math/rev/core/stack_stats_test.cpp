@@ -0,0 +1,76 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <new>
+
+namespace {
+  size_t num_operator_new = 0;
+}
+
+void* operator new(size_t size) {
+  ++num_operator_new;
+  void* ptr = std::malloc(size);
+  if (!ptr)
+    throw std::bad_alloc();
+  return ptr;
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+struct sum_of_products {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    T sum = 0;
+    for (int i = 0; i < 20000; ++i)
+      sum += x(i % x.size()) * x((i + 1) % x.size()) / (1 + i);
+    return sum;
+  }
+};
+
+TEST(AgradRevStackStats, steady_state) {
+  using stan::math::get_stack_stats;
+  using stan::math::stack_stats;
+  Eigen::VectorXd x = Eigen::VectorXd::LinSpaced(10, 0.1, 1.0);
+  Eigen::VectorXd grad_fx;
+  double fx;
+
+  stan::math::gradient(sum_of_products(), x, fx, grad_fx);
+  stack_stats warm = get_stack_stats();
+  EXPECT_EQ(0U, warm.bytes_used);
+  EXPECT_EQ(0U, warm.var_stack_size);
+  EXPECT_EQ(1U, warm.num_blocks);
+  EXPECT_LT(stan::math::DEFAULT_INITIAL_NBYTES, warm.peak_bytes_used);
+  EXPECT_LE(warm.peak_bytes_used, warm.bytes_reserved);
+  EXPECT_EQ(0U, warm.linear_node_size);
+  EXPECT_LT(20000U, warm.linear_node_capacity);
+
+  size_t num_new = num_operator_new;
+  for (int n = 0; n < 10; ++n)
+    stan::math::gradient(sum_of_products(), x, fx, grad_fx);
+  EXPECT_EQ(num_new, num_operator_new);
+
+  stack_stats steady = get_stack_stats();
+  EXPECT_EQ(1U, steady.num_blocks);
+  EXPECT_EQ(warm.bytes_reserved, steady.bytes_reserved);
+  EXPECT_EQ(warm.peak_bytes_used, steady.peak_bytes_used);
+  EXPECT_EQ(warm.var_stack_capacity, steady.var_stack_capacity);
+  EXPECT_EQ(warm.linear_node_capacity, steady.linear_node_capacity);
+}
+
+TEST(AgradRevStackStats, in_use) {
+  using stan::math::var;
+  stan::math::recover_memory();
+  var a = 2;
+  var b = a * a;
+  EXPECT_FLOAT_EQ(4, b.val());
+  stan::math::stack_stats stats = stan::math::get_stack_stats();
+  EXPECT_EQ(1U, stats.var_stack_size);
+  EXPECT_EQ(1U, stats.var_nochain_stack_size);
+  EXPECT_EQ(0U, stats.var_alloc_stack_size);
+  EXPECT_EQ(1U, stats.linear_node_size);
+  EXPECT_LT(0U, stats.bytes_used);
+  EXPECT_LE(stats.bytes_used, stats.peak_bytes_used);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,75 @@
+#define STAN_THREADS
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/fun/exp.hpp>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+using stan::math::ChainableStack;
+using stan::math::var;
+
+TEST(AgradRevThreads, instance_differs_across_threads) {
+  ChainableStack::AutodiffStackStorage* main_stack
+    = &ChainableStack::instance();
+  ChainableStack::AutodiffStackStorage* thread_stack = 0;
+  std::thread t([&]() { thread_stack = &ChainableStack::instance(); });
+  t.join();
+  EXPECT_NE(main_stack, thread_stack);
+}
+
+TEST(AgradRevThreads, tapes_are_independent) {
+  var a = 2.0;
+  size_t main_size = ChainableStack::instance().var_stack_.size();
+  EXPECT_LT(0U, main_size);
+
+  size_t thread_size_before = 1;
+  size_t thread_size_after = 0;
+  double thread_adj = 0;
+  std::thread t([&]() {
+      thread_size_before = ChainableStack::instance().var_stack_.size();
+      var x = 3.0;
+      var f = x * x;
+      thread_size_after = ChainableStack::instance().var_stack_.size();
+      f.grad();
+      thread_adj = x.adj();
+      stan::math::recover_memory();
+    });
+  t.join();
+
+  EXPECT_EQ(0U, thread_size_before);
+  EXPECT_EQ(1U, thread_size_after);
+  EXPECT_FLOAT_EQ(6.0, thread_adj);
+  EXPECT_EQ(main_size, ChainableStack::instance().var_stack_.size());
+  EXPECT_FLOAT_EQ(2.0, a.val());
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevThreads, concurrent_gradients) {
+  const int N = 8;
+  std::vector<double> vals(N);
+  std::vector<double> grads(N);
+  std::vector<std::thread> threads;
+  for (int n = 0; n < N; ++n) {
+    threads.emplace_back([&, n]() {
+        for (int iter = 0; iter < 100; ++iter) {
+          var x = n;
+          var f = x * exp(x);
+          stan::math::start_nested();
+          var g = f * f;
+          EXPECT_FLOAT_EQ(f.val() * f.val(), g.val());
+          stan::math::recover_memory_nested();
+          f.grad();
+          vals[n] = f.val();
+          grads[n] = x.adj();
+          stan::math::recover_memory();
+        }
+      });
+  }
+  for (size_t n = 0; n < threads.size(); ++n)
+    threads[n].join();
+
+  for (int n = 0; n < N; ++n) {
+    EXPECT_FLOAT_EQ(n * std::exp(n), vals[n]);
+    EXPECT_FLOAT_EQ((1 + n) * std::exp(n), grads[n]);
+  }
+}
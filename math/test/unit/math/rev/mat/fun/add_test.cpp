@@ -211,3 +211,28 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::add(m, 2.0));
   test::check_varis_on_stack(stan::math::add(1.0, m));
 }
+
+TEST(AgradRevMatrix, add_matrix_var) {
+  using stan::math::add;
+  using stan::math::matrix_d;
+  using stan::math::matrix_var;
+  using stan::math::multiply;
+  using stan::math::sum;
+  using stan::math::var;
+  matrix_d a(2, 2), b(2, 2);
+  a << 1, 2, 3, 4;
+  b << -1, 0.5, 2, 3;
+
+  matrix_var A(a), B(b);
+  var f = sum(multiply(add(add(A, b), add(a, multiply(2.0, B))), a));
+  EXPECT_FLOAT_EQ(((a + b + a + 2 * b) * a).sum(), f.val());
+  f.grad();
+  matrix_d g = Eigen::MatrixXd::Ones(2, 2) * a.transpose();
+  for (int i = 0; i < a.size(); ++i) {
+    EXPECT_FLOAT_EQ(g(i), A.adj()(i));
+    EXPECT_FLOAT_EQ(2 * g(i), B.adj()(i));
+  }
+
+  EXPECT_THROW(add(A, matrix_var(matrix_d(2, 3))), std::invalid_argument);
+  stan::math::recover_memory();
+}
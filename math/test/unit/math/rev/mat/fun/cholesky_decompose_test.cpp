@@ -443,3 +443,48 @@ TEST(AgradRevMatrix, check_varis_on_stack_large) {
   X = stan::math::multiply(X, stan::math::transpose(X));
   test::check_varis_on_stack(stan::math::cholesky_decompose(X));
 }
+
+void test_cholesky_matrix_var(int M) {
+  using stan::math::cholesky_decompose;
+  using stan::math::matrix_d;
+  using stan::math::matrix_v;
+  using stan::math::matrix_var;
+  using stan::math::multiply;
+  using stan::math::sum;
+  using stan::math::var;
+  matrix_d x = matrix_d::Random(M, M);
+  matrix_d a = x * x.transpose() + M * matrix_d::Identity(M, M);
+  matrix_d w = matrix_d::Random(M, M);
+
+  matrix_v a_v = a;
+  var f_v = sum(multiply(cholesky_decompose(a_v), w));
+
+  matrix_var A(a);
+  var f = sum(multiply(cholesky_decompose(A), w));
+  EXPECT_FLOAT_EQ(f_v.val(), f.val());
+  f.grad();
+  matrix_d a_adj = A.adj();
+  stan::math::set_zero_all_adjoints();
+  f_v.grad();
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_NEAR(a_v(i).adj(), a_adj(i), 1e-8);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevMatrix, cholesky_decompose_matrix_var) {
+  test_cholesky_matrix_var(1);
+  test_cholesky_matrix_var(5);
+  test_cholesky_matrix_var(50);
+
+  using stan::math::cholesky_decompose;
+  using stan::math::matrix_d;
+  using stan::math::matrix_var;
+  matrix_d a(2, 2);
+  a << 1, 2, 3, 4;
+  EXPECT_THROW(cholesky_decompose(matrix_var(a)), std::domain_error);
+  a << 1, 2, 2, 1;
+  EXPECT_THROW(cholesky_decompose(matrix_var(a)), std::domain_error);
+  EXPECT_THROW(cholesky_decompose(matrix_var(matrix_d(2, 3))),
+               std::invalid_argument);
+  stan::math::recover_memory();
+}
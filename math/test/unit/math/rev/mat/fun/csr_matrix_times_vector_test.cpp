@@ -0,0 +1,149 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+// sparse 3 x 4 matrix with an empty row and an empty column
+Eigen::SparseMatrix<double, Eigen::RowMajor> csr_test_matrix() {
+  stan::math::matrix_d m(3, 4);
+  m << 2.0, 0.0, -1.5, 3.0,
+       0.0, 0.0, 0.0, 0.0,
+       4.0, 0.0, 0.5, -2.0;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a = m.sparseView();
+  return a;
+}
+
+stan::math::vector_d csr_test_vector() {
+  stan::math::vector_d b(4);
+  b << 1.0, -2.0, 0.25, 3.0;
+  return b;
+}
+
+double csr_test_adj(double) {
+  return 0;
+}
+
+double csr_test_adj(const stan::math::var& x) {
+  return x.adj();
+}
+
+template <typename T1, typename T2>
+void test_csr_gradients() {
+  using stan::math::csr_extract_u;
+  using stan::math::csr_extract_v;
+  using stan::math::csr_extract_w;
+  using stan::math::csr_matrix_times_vector;
+  using stan::math::var;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a = csr_test_matrix();
+  stan::math::matrix_d a_dense = a;
+  stan::math::vector_d w_d = csr_extract_w(a);
+  std::vector<int> v = csr_extract_v(a);
+  std::vector<int> u = csr_extract_u(a);
+  stan::math::vector_d b_d = csr_test_vector();
+  stan::math::vector_d c(3);
+  c << 1.0, 10.0, -3.0;
+
+  Eigen::Matrix<T1, -1, 1> w = w_d;
+  Eigen::Matrix<T2, -1, 1> b = b_d;
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  Eigen::Matrix<var, -1, 1> result
+    = csr_matrix_times_vector(3, 4, w, v, u, b);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  stan::math::vector_d expected = a_dense * b_d;
+  ASSERT_EQ(3, result.size());
+  var f = 0;
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_FLOAT_EQ(expected(i), result(i).val());
+    f += c(i) * result(i);
+  }
+  f.grad();
+
+  // d f / d b = A' c, d f / d a(i, j) = c(i) * b(j)
+  stan::math::vector_d b_grad = a_dense.transpose() * c;
+  if (!stan::is_constant<T2>::value) {
+    for (int j = 0; j < 4; ++j)
+      EXPECT_FLOAT_EQ(b_grad(j), csr_test_adj(b(j)));
+  }
+  int k = 0;
+  for (int i = 0; i < 3; ++i)
+    for (int nze = u[i] - 1; nze < u[i + 1] - 1; ++nze, ++k) {
+      if (!stan::is_constant<T1>::value) {
+        EXPECT_FLOAT_EQ(c(i) * b_d(v[nze] - 1),
+                        csr_test_adj(w(k)));
+      }
+    }
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, csr_matrix_times_vector_vv) {
+  test_csr_gradients<stan::math::var, stan::math::var>();
+}
+
+TEST(AgradRevSparse, csr_matrix_times_vector_dv) {
+  test_csr_gradients<double, stan::math::var>();
+}
+
+TEST(AgradRevSparse, csr_matrix_times_vector_vd) {
+  test_csr_gradients<stan::math::var, double>();
+}
+
+TEST(AgradRevSparse, csr_matrix_times_vector_sparse_matrix) {
+  using stan::math::csr_matrix_times_vector;
+  using stan::math::var;
+  using stan::math::vector_v;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a = csr_test_matrix();
+  stan::math::matrix_d a_dense = a;
+  stan::math::vector_d b_d = csr_test_vector();
+  vector_v b = b_d;
+
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  vector_v result = csr_matrix_times_vector(a, b);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  stan::math::vector_d expected = a_dense * b_d;
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(expected(i), result(i).val());
+  result(2).grad();
+  for (int j = 0; j < 4; ++j)
+    EXPECT_FLOAT_EQ(a_dense(2, j), b(j).adj());
+
+  // uncompressed storage
+  stan::math::set_zero_all_adjoints();
+  a.uncompress();
+  vector_v result2 = csr_matrix_times_vector(a, b);
+  EXPECT_FLOAT_EQ(expected(0), result2(0).val());
+  result2(0).grad();
+  for (int j = 0; j < 4; ++j)
+    EXPECT_FLOAT_EQ(a_dense(0, j), b(j).adj());
+
+  EXPECT_THROW(csr_matrix_times_vector(a, vector_v(3)),
+               std::invalid_argument);
+  stan::math::recover_memory();
+}
+
+TEST(AgradRevSparse, csr_matrix_times_vector_errors) {
+  using stan::math::csr_extract_u;
+  using stan::math::csr_extract_v;
+  using stan::math::csr_extract_w;
+  using stan::math::csr_matrix_times_vector;
+  using stan::math::vector_v;
+  Eigen::SparseMatrix<double, Eigen::RowMajor> a = csr_test_matrix();
+  vector_v w = csr_extract_w(a);
+  std::vector<int> v = csr_extract_v(a);
+  std::vector<int> u = csr_extract_u(a);
+  vector_v b = csr_test_vector();
+
+  EXPECT_THROW(csr_matrix_times_vector(0, 4, w, v, u, b),
+               std::domain_error);
+  EXPECT_THROW(csr_matrix_times_vector(3, 5, w, v, u, b),
+               std::invalid_argument);
+  std::vector<int> u_short(u.begin(), u.end() - 1);
+  EXPECT_THROW(csr_matrix_times_vector(3, 4, w, v, u_short, b),
+               std::invalid_argument);
+  v[0] = 5;
+  EXPECT_THROW(csr_matrix_times_vector(3, 4, w, v, u, b),
+               std::out_of_range);
+  stan::math::recover_memory();
+}
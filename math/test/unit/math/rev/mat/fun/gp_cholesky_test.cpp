@@ -0,0 +1,81 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+// gradient of a weighted sum of the Cholesky factor of the sum of a
+// squared exponential and a periodic kernel plus a nugget
+std::vector<double> gp_cholesky_sum_grad(int N, bool fused,
+                                         Eigen::MatrixXd& L_d) {
+  using stan::math::var;
+  std::vector<double> x(N);
+  for (int i = 0; i < N; ++i)
+    x[i] = 0.37 * i - 0.01 * i * i;
+  var s1 = 0.7;
+  var l1 = 1.3;
+  var s2 = 0.4;
+  var l2 = 0.9;
+  var p = 2.2;
+  double delta = 1e-2;
+  Eigen::Matrix<var, -1, -1> L;
+  if (fused) {
+    L = stan::math::gp_cholesky(x,
+          stan::math::gp_kernel_sum(
+              stan::math::gp_exp_quad_kernel(s1, l1),
+              stan::math::gp_periodic_kernel(s2, l2, p)),
+          delta);
+  } else {
+    std::vector<var> x_v(x.begin(), x.end());
+    Eigen::Matrix<var, -1, -1> cov
+      = stan::math::add(stan::math::cov_exp_quad(x_v, s1, l1),
+                        stan::math::gp_periodic_cov(x_v, s2, l2, p));
+    for (int i = 0; i < N; ++i)
+      cov(i, i) += delta;
+    L = stan::math::cholesky_decompose(cov);
+  }
+  L_d = stan::math::value_of(L);
+  var f = 0;
+  for (int j = 0; j < N; ++j)
+    for (int i = j; i < N; ++i)
+      f += (1.0 + i + 0.5 * j) * L(i, j);
+  std::vector<var> params;
+  params.push_back(s1);
+  params.push_back(l1);
+  params.push_back(s2);
+  params.push_back(l2);
+  params.push_back(p);
+  std::vector<double> grad;
+  f.grad(params, grad);
+  stan::math::recover_memory();
+  return grad;
+}
+
+TEST(RevMath, gp_cholesky_sum_kernel) {
+  for (int N = 1; N < 60; N += 29) {
+    Eigen::MatrixXd L;
+    Eigen::MatrixXd L_expected;
+    std::vector<double> grad = gp_cholesky_sum_grad(N, true, L);
+    std::vector<double> grad_expected
+      = gp_cholesky_sum_grad(N, false, L_expected);
+    for (int i = 0; i < L.size(); ++i)
+      EXPECT_NEAR(L_expected(i), L(i), 1e-10);
+    ASSERT_EQ(5U, grad.size());
+    for (size_t i = 0; i < grad.size(); ++i)
+      EXPECT_FLOAT_EQ(grad_expected[i], grad[i]);
+  }
+}
+
+TEST(RevMath, gp_cholesky_not_pos_definite) {
+  std::vector<double> x(3);
+  x[0] = 1;
+  x[1] = 1;
+  x[2] = 3;
+  stan::math::var sigma = 1;
+  stan::math::var l = 1;
+  // repeated input
+  EXPECT_THROW(stan::math::gp_cholesky(x,
+                 stan::math::gp_exp_quad_kernel(sigma, l), 0.0),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::gp_cholesky(x,
+                    stan::math::gp_exp_quad_kernel(sigma, l), 0.5));
+  stan::math::recover_memory();
+}
@@ -0,0 +1,142 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+typedef std::vector<stan::math::var> gp_cov_params;
+
+// weighted sum of the elements of a covariance matrix
+stan::math::var gp_cov_weighted_sum(
+    const Eigen::Matrix<stan::math::var, -1, -1>& cov) {
+  stan::math::var f = 0;
+  for (int j = 0; j < cov.cols(); ++j)
+    for (int i = 0; i < cov.rows(); ++i)
+      f += (1.0 + i + 0.5 * j) * cov(i, j);
+  return f;
+}
+
+std::vector<double> gp_cov_sum_grad(bool fused, Eigen::MatrixXd& cov_d) {
+  using stan::math::var;
+  std::vector<double> x(4);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+  x[3] = 1.5;
+  var s1 = 0.7;
+  var l1 = 1.3;
+  var s2 = 0.4;
+  var l2 = 0.9;
+  var p = 2.2;
+  Eigen::Matrix<var, -1, -1> cov;
+  if (fused) {
+    cov = stan::math::gp_cov(x,
+            stan::math::gp_kernel_sum(
+                stan::math::gp_exp_quad_kernel(s1, l1),
+                stan::math::gp_periodic_kernel(s2, l2, p)));
+  } else {
+    std::vector<var> x_v(x.begin(), x.end());
+    cov = stan::math::add(stan::math::cov_exp_quad(x_v, s1, l1),
+                          stan::math::gp_periodic_cov(x_v, s2, l2, p));
+  }
+  cov_d = stan::math::value_of(cov);
+  var f = gp_cov_weighted_sum(cov);
+  gp_cov_params params;
+  params.push_back(s1);
+  params.push_back(l1);
+  params.push_back(s2);
+  params.push_back(l2);
+  params.push_back(p);
+  std::vector<double> grad;
+  f.grad(params, grad);
+  stan::math::recover_memory();
+  return grad;
+}
+
+std::vector<double> gp_cov_product_grad(bool fused,
+                                        Eigen::MatrixXd& cov_d) {
+  using stan::math::var;
+  std::vector<Eigen::VectorXd> x(3, Eigen::VectorXd(2));
+  x[0] << 1, 2;
+  x[1] << -1, 0.5;
+  x[2] << 0.3, -2;
+  var s1 = 0.7;
+  var l1 = 1.3;
+  double s2 = 0.4;
+  Eigen::Matrix<var, -1, -1> cov;
+  if (fused) {
+    cov = stan::math::gp_cov(x,
+            stan::math::gp_kernel_product(
+                stan::math::gp_matern52_kernel(s1, l1),
+                stan::math::gp_dot_prod_kernel(s2)));
+  } else {
+    std::vector<Eigen::Matrix<var, -1, 1> > x_v(3);
+    for (int i = 0; i < 3; ++i)
+      x_v[i] = x[i];
+    cov = stan::math::elt_multiply(stan::math::gp_matern52_cov(x_v, s1, l1),
+                                   stan::math::gp_dot_prod_cov(x_v, s2));
+  }
+  cov_d = stan::math::value_of(cov);
+  var f = gp_cov_weighted_sum(cov);
+  gp_cov_params params;
+  params.push_back(s1);
+  params.push_back(l1);
+  std::vector<double> grad;
+  f.grad(params, grad);
+  stan::math::recover_memory();
+  return grad;
+}
+
+TEST(RevMath, gp_cov_sum_kernel) {
+  Eigen::MatrixXd cov;
+  Eigen::MatrixXd cov_expected;
+  std::vector<double> grad = gp_cov_sum_grad(true, cov);
+  std::vector<double> grad_expected = gp_cov_sum_grad(false, cov_expected);
+  for (int i = 0; i < cov.size(); ++i)
+    EXPECT_FLOAT_EQ(cov_expected(i), cov(i));
+  ASSERT_EQ(5U, grad.size());
+  for (size_t i = 0; i < grad.size(); ++i)
+    EXPECT_FLOAT_EQ(grad_expected[i], grad[i]);
+}
+
+TEST(RevMath, gp_cov_product_kernel) {
+  Eigen::MatrixXd cov;
+  Eigen::MatrixXd cov_expected;
+  std::vector<double> grad = gp_cov_product_grad(true, cov);
+  std::vector<double> grad_expected
+    = gp_cov_product_grad(false, cov_expected);
+  for (int i = 0; i < cov.size(); ++i)
+    EXPECT_FLOAT_EQ(cov_expected(i), cov(i));
+  ASSERT_EQ(2U, grad.size());
+  for (size_t i = 0; i < grad.size(); ++i)
+    EXPECT_FLOAT_EQ(grad_expected[i], grad[i]);
+}
+
+TEST(RevMath, gp_cov_one_node) {
+  using stan::math::var;
+  std::vector<double> x(10);
+  for (size_t i = 0; i < x.size(); ++i)
+    x[i] = 0.3 * i;
+  var s1 = 0.7;
+  var l1 = 1.3;
+  var s2 = 0.4;
+  var l2 = 0.9;
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  Eigen::Matrix<var, -1, -1> cov
+    = stan::math::gp_cov(x,
+        stan::math::gp_kernel_sum(stan::math::gp_matern32_kernel(s1, l1),
+                                  stan::math::gp_matern52_kernel(s2, l2)));
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  EXPECT_EQ(10, cov.rows());
+  EXPECT_EQ(10, cov.cols());
+  stan::math::recover_memory();
+}
+
+TEST(RevMath, gp_cov_empty) {
+  std::vector<double> x;
+  stan::math::var sigma = 0.7;
+  stan::math::var l = 1.3;
+  Eigen::Matrix<stan::math::var, -1, -1> cov
+    = stan::math::gp_cov(x, stan::math::gp_exp_quad_kernel(sigma, l));
+  EXPECT_EQ(0, cov.size());
+}
@@ -0,0 +1,60 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(RevMath, gp_dot_prod_cov_real) {
+  using stan::math::var;
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = 0.5;
+  var sigma = 0.7;
+
+  Eigen::Matrix<var, -1, -1> cov = stan::math::gp_dot_prod_cov(x, sigma);
+  var f = 0;
+  for (int j = 0; j < 3; ++j) {
+    for (int i = 0; i < 3; ++i) {
+      EXPECT_FLOAT_EQ(0.49 + x[i] * x[j], cov(i, j).val());
+      f += (1.0 + i + 0.5 * j) * cov(i, j);
+    }
+  }
+  f.grad();
+  // sum of the weights times the derivative 2 sigma
+  EXPECT_FLOAT_EQ(22.5 * 2 * 0.7, sigma.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevMath, gp_dot_prod_cov_vector) {
+  using stan::math::var;
+  std::vector<Eigen::VectorXd> x(3, Eigen::VectorXd(2));
+  x[0] << 1, 2;
+  x[1] << -1, 0.5;
+  x[2] << 0.3, -2;
+  var sigma = 1.5;
+
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  Eigen::Matrix<var, -1, -1> cov = stan::math::gp_dot_prod_cov(x, sigma);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  for (int j = 0; j < 3; ++j)
+    for (int i = 0; i < 3; ++i)
+      EXPECT_FLOAT_EQ(2.25 + x[i].dot(x[j]), cov(i, j).val());
+  cov(2, 1).grad();
+  EXPECT_FLOAT_EQ(3.0, sigma.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevMath, gp_dot_prod_cov_domain_error) {
+  using stan::math::var;
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+  EXPECT_THROW(stan::math::gp_dot_prod_cov(x, var(-1)),
+               std::domain_error);
+  x[1] = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(stan::math::gp_dot_prod_cov(x, var(1)),
+               std::domain_error);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,50 @@
+#include <test/unit/math/rev/mat/fun/gp_util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+struct gp_matern52_cholesky_fun {
+  double delta_;
+  explicit gp_matern52_cholesky_fun(double delta) : delta_(delta) { }
+
+  template <typename T_x>
+  Eigen::Matrix<stan::math::var, -1, -1>
+  operator()(const std::vector<T_x>& x,
+             const std::vector<stan::math::var>& theta) const {
+    return stan::math::gp_matern52_cholesky(x, theta[0], theta[1], delta_);
+  }
+};
+
+TEST(RevMath, gp_matern52_cholesky) {
+  gp_matern52_cholesky_fun f(1e-3);
+  std::vector<double> theta{0.7, 1.3};
+  expect_gp_matches_generic(f, gp_inputs(1), theta);
+  expect_gp_matches_generic(f, gp_inputs(5), theta);
+  expect_gp_matches_generic(f, gp_inputs(40), theta);
+}
+
+TEST(RevMath, gp_matern52_cholesky_one_node) {
+  std::vector<double> theta{0.7, 1.3};
+  expect_gp_one_node(gp_matern52_cholesky_fun(0.1), theta);
+}
+
+TEST(RevMath, gp_matern52_cholesky_domain_error) {
+  using stan::math::var;
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -2;
+  x[2] = -0.5;
+  var sigma = 1;
+  var l = 1.3;
+  EXPECT_THROW(stan::math::gp_matern52_cholesky(x, var(-1), l, 0.1),
+               std::domain_error);
+  EXPECT_THROW(stan::math::gp_matern52_cholesky(x, sigma, l, -0.1),
+               std::domain_error);
+  // repeated input
+  EXPECT_THROW(stan::math::gp_matern52_cholesky(x, sigma, l, 0.0),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::gp_matern52_cholesky(x, sigma, l, 0.1));
+  stan::math::recover_memory();
+
+  expect_gp_inputs_finite(gp_matern52_cholesky_fun(0.1),
+                          std::vector<double>{0.7, 1.3});
+}
@@ -0,0 +1,52 @@
+#include <test/unit/math/rev/mat/fun/gp_util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+struct gp_periodic_cholesky_fun {
+  double delta_;
+  explicit gp_periodic_cholesky_fun(double delta) : delta_(delta) { }
+
+  template <typename T_x>
+  Eigen::Matrix<stan::math::var, -1, -1>
+  operator()(const std::vector<T_x>& x,
+             const std::vector<stan::math::var>& theta) const {
+    return stan::math::gp_periodic_cholesky(x, theta[0], theta[1], theta[2],
+                                            delta_);
+  }
+};
+
+TEST(RevMath, gp_periodic_cholesky) {
+  gp_periodic_cholesky_fun f(1e-3);
+  std::vector<double> theta{0.7, 1.3, 2.2};
+  expect_gp_matches_generic(f, gp_inputs(1), theta);
+  expect_gp_matches_generic(f, gp_inputs(5), theta);
+  expect_gp_matches_generic(f, gp_inputs(40), theta);
+}
+
+TEST(RevMath, gp_periodic_cholesky_one_node) {
+  std::vector<double> theta{0.7, 1.3, 2.2};
+  expect_gp_one_node(gp_periodic_cholesky_fun(0.1), theta);
+}
+
+TEST(RevMath, gp_periodic_cholesky_domain_error) {
+  using stan::math::var;
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -2;
+  x[2] = -0.5;
+  var sigma = 1;
+  var l = 1.3;
+  var p = 2.2;
+  EXPECT_THROW(stan::math::gp_periodic_cholesky(x, var(-1), l, p, 0.1),
+               std::domain_error);
+  EXPECT_THROW(stan::math::gp_periodic_cholesky(x, sigma, l, p, -0.1),
+               std::domain_error);
+  // repeated input
+  EXPECT_THROW(stan::math::gp_periodic_cholesky(x, sigma, l, p, 0.0),
+               std::domain_error);
+  EXPECT_NO_THROW(stan::math::gp_periodic_cholesky(x, sigma, l, p, 0.1));
+  stan::math::recover_memory();
+
+  expect_gp_inputs_finite(gp_periodic_cholesky_fun(0.1),
+                          std::vector<double>{0.7, 1.3, 2.2});
+}
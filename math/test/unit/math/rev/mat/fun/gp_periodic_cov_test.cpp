@@ -0,0 +1,89 @@
+#include <test/unit/math/rev/mat/fun/gp_util.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+struct gp_periodic_cov_fun {
+  template <typename T_x>
+  Eigen::Matrix<stan::math::var, -1, -1>
+  operator()(const std::vector<T_x>& x,
+             const std::vector<stan::math::var>& theta) const {
+    return stan::math::gp_periodic_cov(x, theta[0], theta[1], theta[2]);
+  }
+};
+
+TEST(RevMath, gp_periodic_cov_real) {
+  using stan::math::var;
+  std::vector<double> x(4);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+  x[3] = 1.5;
+
+  expect_gp_matches_generic(gp_periodic_cov_fun(), x,
+                            std::vector<double>{0.7, 1.3, 2.2});
+  Eigen::Matrix<var, -1, -1> cov
+    = stan::math::gp_periodic_cov(x, var(0.7), var(1.3), var(2.2));
+  for (int j = 0; j < 4; ++j) {
+    for (int i = 0; i < 4; ++i) {
+      double u = std::sin(stan::math::pi() * std::fabs(x[i] - x[j]) / 2.2);
+      EXPECT_FLOAT_EQ(0.49 * std::exp(-2 * u * u / (1.3 * 1.3)),
+                      cov(i, j).val());
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(RevMath, gp_periodic_cov_vector) {
+  std::vector<Eigen::VectorXd> x(3, Eigen::VectorXd(2));
+  x[0] << 1, 2;
+  x[1] << -1, 0.5;
+  x[2] << 0.3, -2;
+
+  expect_gp_matches_generic(gp_periodic_cov_fun(), x,
+                            std::vector<double>{1.5, 0.8, 3});
+}
+
+TEST(RevMath, gp_periodic_cov_data_hyperparameters) {
+  using stan::math::var;
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+  var p = 2.2;
+
+  Eigen::Matrix<var, -1, -1> cov
+    = stan::math::gp_periodic_cov(x, 0.7, 1.3, p);
+  cov(2, 0).grad();
+  double r = 1.5;
+  double k = cov(2, 0).val();
+  EXPECT_FLOAT_EQ(k * 2 * stan::math::pi() * r
+                  * std::sin(2 * stan::math::pi() * r / 2.2)
+                  / (1.3 * 1.3 * 2.2 * 2.2),
+                  p.adj());
+  stan::math::recover_memory();
+}
+
+TEST(RevMath, gp_periodic_cov_one_node) {
+  expect_gp_one_node(gp_periodic_cov_fun(), std::vector<double>{0.7, 1.3, 2.2});
+}
+
+TEST(RevMath, gp_periodic_cov_domain_error) {
+  using stan::math::var;
+  std::vector<double> x(3);
+  x[0] = -2;
+  x[1] = -1;
+  x[2] = -0.5;
+  var sigma = 0.7;
+  var l = 1.3;
+  var p = 2.2;
+  EXPECT_THROW(stan::math::gp_periodic_cov(x, var(-1), l, p),
+               std::domain_error);
+  EXPECT_THROW(stan::math::gp_periodic_cov(x, sigma, var(0), p),
+               std::domain_error);
+  EXPECT_THROW(stan::math::gp_periodic_cov(x, sigma, l, var(-2)),
+               std::domain_error);
+  stan::math::recover_memory();
+
+  expect_gp_inputs_finite(gp_periodic_cov_fun(),
+                          std::vector<double>{0.7, 1.3, 2.2});
+}
@@ -0,0 +1,102 @@
+#ifndef TEST_UNIT_MATH_REV_MAT_FUN_GP_UTIL_HPP
+#define TEST_UNIT_MATH_REV_MAT_FUN_GP_UTIL_HPP
+
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <limits>
+#include <vector>
+
+// Checks shared by the tests of the Gaussian process kernels.  Each
+// kernel is passed as a functor f, where f(x, theta) returns the
+// covariance matrix or Cholesky factor for the inputs x and the
+// hyperparameters theta.
+
+// inputs as vars, for the generic implementation
+inline std::vector<stan::math::var>
+gp_var_inputs(const std::vector<double>& x) {
+  return std::vector<stan::math::var>(x.begin(), x.end());
+}
+
+inline std::vector<Eigen::Matrix<stan::math::var, -1, 1> >
+gp_var_inputs(const std::vector<Eigen::VectorXd>& x) {
+  std::vector<Eigen::Matrix<stan::math::var, -1, 1> > x_v(x.size());
+  for (size_t i = 0; i < x.size(); ++i)
+    x_v[i] = stan::math::to_var(x[i]);
+  return x_v;
+}
+
+// N distinct inputs, spread unevenly
+inline std::vector<double> gp_inputs(int N) {
+  std::vector<double> x(N);
+  for (int i = 0; i < N; ++i)
+    x[i] = 0.37 * i - 0.01 * i * i;
+  return x;
+}
+
+// Gradient of a weighted sum of f(x, theta) with respect to theta.
+template <class F, typename T_x>
+std::vector<double> gp_weighted_sum_grad(const F& f,
+                                         const std::vector<T_x>& x,
+                                         const std::vector<double>& theta_d,
+                                         Eigen::MatrixXd& result_d) {
+  using stan::math::var;
+  std::vector<var> theta(theta_d.begin(), theta_d.end());
+  Eigen::Matrix<var, -1, -1> result = f(x, theta);
+  result_d = stan::math::value_of(result);
+  var g = 0;
+  for (int j = 0; j < result.cols(); ++j)
+    for (int i = 0; i < result.rows(); ++i)
+      g += (1.0 + i + 0.5 * j) * result(i, j);
+  std::vector<double> grad;
+  g.grad(theta, grad);
+  stan::math::recover_memory();
+  return grad;
+}
+
+// Expect the single-node implementation, taking double inputs, to
+// match the generic one, taking the inputs as vars, in value and in
+// the gradient with respect to the hyperparameters.
+template <class F, typename T_x>
+void expect_gp_matches_generic(const F& f, const std::vector<T_x>& x,
+                               const std::vector<double>& theta) {
+  Eigen::MatrixXd result;
+  Eigen::MatrixXd result_v;
+  std::vector<double> grad = gp_weighted_sum_grad(f, x, theta, result);
+  std::vector<double> grad_v
+    = gp_weighted_sum_grad(f, gp_var_inputs(x), theta, result_v);
+  ASSERT_EQ(result_v.rows(), result.rows());
+  ASSERT_EQ(result_v.cols(), result.cols());
+  for (int i = 0; i < result.size(); ++i)
+    EXPECT_NEAR(result_v(i), result(i), 1e-10);
+  ASSERT_EQ(theta.size(), grad.size());
+  for (size_t i = 0; i < grad.size(); ++i)
+    EXPECT_FLOAT_EQ(grad_v[i], grad[i]);
+}
+
+// Expect the whole matrix to be computed on a single vari.
+template <class F>
+void expect_gp_one_node(const F& f, const std::vector<double>& theta_d) {
+  std::vector<stan::math::var> theta(theta_d.begin(), theta_d.end());
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  Eigen::Matrix<stan::math::var, -1, -1> result = f(gp_inputs(10), theta);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  stan::math::recover_memory();
+}
+
+// Expect a domain error if an input is nan or infinite.
+template <class F>
+void expect_gp_inputs_finite(const F& f, const std::vector<double>& theta_d) {
+  std::vector<stan::math::var> theta(theta_d.begin(), theta_d.end());
+  std::vector<double> x = gp_inputs(3);
+  x[1] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW(f(x, theta), std::domain_error);
+  x[1] = std::numeric_limits<double>::infinity();
+  EXPECT_THROW(f(x, theta), std::domain_error);
+  x[1] = -std::numeric_limits<double>::infinity();
+  EXPECT_THROW(f(x, theta), std::domain_error);
+  stan::math::recover_memory();
+}
+
+#endif
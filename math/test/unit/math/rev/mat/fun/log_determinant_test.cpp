@@ -80,3 +80,30 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   X << 2, 3, 6, 7;
   test::check_varis_on_stack(stan::math::log_determinant(X));
 }
+
+TEST(AgradRevMatrix, log_determinant_matrix_var) {
+  using stan::math::log_determinant;
+  using stan::math::matrix_d;
+  using stan::math::matrix_v;
+  using stan::math::matrix_var;
+  using stan::math::var;
+  matrix_d a(3, 3);
+  a << 2, -1, 0.5, 1, 3, -2, 0, 1, 4;
+
+  matrix_v a_v = a;
+  var f_v = log_determinant(a_v);
+
+  matrix_var A(a);
+  var f = log_determinant(A);
+  EXPECT_FLOAT_EQ(f_v.val(), f.val());
+  f.grad();
+  matrix_d a_adj = A.adj();
+  stan::math::set_zero_all_adjoints();
+  f_v.grad();
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_FLOAT_EQ(a_v(i).adj(), a_adj(i));
+
+  EXPECT_THROW(log_determinant(matrix_var(matrix_d(2, 3))),
+               std::invalid_argument);
+  stan::math::recover_memory();
+}
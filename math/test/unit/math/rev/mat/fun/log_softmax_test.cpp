@@ -22,7 +22,7 @@ TEST(AgradRevMatrix,logSoftmaxLeak) {
     }
     Matrix<var,Dynamic,1> theta = log_softmax(x);
   }
-  EXPECT_TRUE(stan::math::ChainableStack::memalloc_.bytes_allocated() > 4000000);
+  EXPECT_TRUE(stan::math::ChainableStack::instance().memalloc_.bytes_allocated() > 4000000);
 }
 
 TEST(AgradRevMatrix,log_softmax) {
@@ -184,3 +184,37 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::mdivide_left(A, value_of(A)));
   test::check_varis_on_stack(stan::math::mdivide_left(value_of(A), A));
 }
+
+TEST(AgradRevMatrix, mdivide_left_matrix_var) {
+  using stan::math::matrix_d;
+  using stan::math::matrix_v;
+  using stan::math::matrix_var;
+  using stan::math::mdivide_left;
+  using stan::math::multiply;
+  using stan::math::sum;
+  using stan::math::var;
+  matrix_d a(3, 3), b(3, 2), w(2, 2);
+  a << 0.5, -1, 2, 1, 3, -2, 4, 1, 0.25;
+  b << -1, 0.5, 2, 3, -2, 1;
+  w << 1, -2, 3, 0.5;
+
+  matrix_v a_v = a, b_v = b;
+  var f_v = sum(multiply(mdivide_left(a_v, b_v), w));
+
+  matrix_var A(a), B(b);
+  var f = sum(multiply(mdivide_left(A, B), w));
+  EXPECT_FLOAT_EQ(f_v.val(), f.val());
+  f.grad();
+  matrix_d a_adj = A.adj();
+  matrix_d b_adj = B.adj();
+  stan::math::set_zero_all_adjoints();
+  f_v.grad();
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_FLOAT_EQ(a_v(i).adj(), a_adj(i));
+  for (int i = 0; i < b.size(); ++i)
+    EXPECT_FLOAT_EQ(b_v(i).adj(), b_adj(i));
+
+  EXPECT_THROW(mdivide_left(B, B), std::invalid_argument);
+  EXPECT_THROW(mdivide_left(A, matrix_var(w)), std::invalid_argument);
+  stan::math::recover_memory();
+}
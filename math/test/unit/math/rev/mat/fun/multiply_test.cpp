@@ -1724,3 +1724,44 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::multiply(s, value_of(s)));
   test::check_varis_on_stack(stan::math::multiply(value_of(s), s));
 }
+
+TEST(AgradRevMatrix, multiply_matrix_var) {
+  using stan::math::matrix_d;
+  using stan::math::matrix_v;
+  using stan::math::matrix_var;
+  using stan::math::multiply;
+  using stan::math::sum;
+  using stan::math::var;
+  matrix_d a(2, 3), b(3, 2), w(2, 2);
+  a << 1, 2, 3, 4, 5, 6;
+  b << -1, 0.5, 2, 3, -2, 1;
+  w << 1, -2, 3, 0.5;
+
+  matrix_v a_v = a, b_v = b;
+  var c = 2.5, c_v = 2.5;
+  var f_v = sum(multiply(multiply(c_v, multiply(a_v, b_v)), w));
+
+  matrix_var A(a), B(b);
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  matrix_var AB = multiply(A, B);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  var f = sum(multiply(multiply(c, AB), w));
+  EXPECT_FLOAT_EQ(f_v.val(), f.val());
+  f.grad();
+  matrix_d a_adj = A.adj();
+  matrix_d b_adj = B.adj();
+  double c_adj = c.adj();
+  stan::math::set_zero_all_adjoints();
+  f_v.grad();
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_FLOAT_EQ(a_v(i).adj(), a_adj(i));
+  for (int i = 0; i < b.size(); ++i)
+    EXPECT_FLOAT_EQ(b_v(i).adj(), b_adj(i));
+  EXPECT_FLOAT_EQ(c_v.adj(), c_adj);
+
+  EXPECT_THROW(multiply(A, A), std::invalid_argument);
+  EXPECT_THROW(multiply(A, a), std::invalid_argument);
+  stan::math::recover_memory();
+}
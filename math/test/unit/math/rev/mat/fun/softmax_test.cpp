@@ -23,7 +23,7 @@ TEST(AgradRevMatrix,softmaxLeak) {
     Matrix<var,Dynamic,1> theta = softmax(x);
   }
   // test is greater than because leak is on heap, not stack
-  EXPECT_TRUE(stan::math::ChainableStack::memalloc_.bytes_allocated() > 200000);
+  EXPECT_TRUE(stan::math::ChainableStack::instance().memalloc_.bytes_allocated() > 200000);
 }
 
 TEST(AgradRevMatrix,softmax) {
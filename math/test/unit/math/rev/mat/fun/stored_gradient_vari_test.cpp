@@ -7,14 +7,14 @@ TEST(StoredGradientVari, propagate3) {
   using stan::math::var;
   using stan::math::vari;
   vari** xs
-    = (vari**) stan::math::ChainableStack::memalloc_.alloc(3 * sizeof(vari*));
+    = (vari**) stan::math::ChainableStack::instance().memalloc_.alloc(3 * sizeof(vari*));
   var xs1 = 1; // value not used here
   var xs2 = 4; // value not used here
   var xs3 = 9; // value not used here
   xs[0] = xs1.vi_;
   xs[1] = xs2.vi_;
   xs[2] = xs3.vi_;
-  double* partials = (double*) stan::math::ChainableStack::memalloc_.alloc(3 * sizeof(double));
+  double* partials = (double*) stan::math::ChainableStack::instance().memalloc_.alloc(3 * sizeof(double));
   partials[0] = 10;
   partials[1] = 100;
   partials[2] = 1000;
@@ -63,14 +63,14 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   using stan::math::var;
   using stan::math::vari;
   vari** xs
-    = (vari**) stan::math::ChainableStack::memalloc_.alloc(3 * sizeof(vari*));
+    = (vari**) stan::math::ChainableStack::instance().memalloc_.alloc(3 * sizeof(vari*));
   var xs1 = 1; // value not used here
   var xs2 = 4; // value not used here
   var xs3 = 9; // value not used here
   xs[0] = xs1.vi_;
   xs[1] = xs2.vi_;
   xs[2] = xs3.vi_;
-  double* partials = (double*) stan::math::ChainableStack::memalloc_.alloc(3 * sizeof(double));
+  double* partials = (double*) stan::math::ChainableStack::instance().memalloc_.alloc(3 * sizeof(double));
   partials[0] = 10;
   partials[1] = 100;
   partials[2] = 1000;
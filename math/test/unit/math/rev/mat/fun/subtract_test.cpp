@@ -249,3 +249,29 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::subtract(s, value_of(rv)));
   test::check_varis_on_stack(stan::math::subtract(value_of(s), rv));
 }
+
+TEST(AgradRevMatrix, subtract_matrix_var) {
+  using stan::math::matrix_d;
+  using stan::math::matrix_var;
+  using stan::math::multiply;
+  using stan::math::subtract;
+  using stan::math::sum;
+  using stan::math::var;
+  matrix_d a(2, 2), b(2, 2);
+  a << 1, 2, 3, 4;
+  b << -1, 0.5, 2, 3;
+
+  matrix_var A(a), B(b);
+  var f = sum(multiply(subtract(subtract(A, b), subtract(a, B)), a));
+  EXPECT_FLOAT_EQ(((a - b - a + b) * a).sum(), f.val());
+  f.grad();
+  matrix_d g = Eigen::MatrixXd::Ones(2, 2) * a.transpose();
+  for (int i = 0; i < a.size(); ++i) {
+    EXPECT_FLOAT_EQ(g(i), A.adj()(i));
+    EXPECT_FLOAT_EQ(g(i), B.adj()(i));
+  }
+
+  EXPECT_THROW(subtract(A, matrix_var(matrix_d(3, 2))),
+               std::invalid_argument);
+  stan::math::recover_memory();
+}
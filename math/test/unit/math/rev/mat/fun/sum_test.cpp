@@ -96,3 +96,21 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::sum(v));
   test::check_varis_on_stack(stan::math::sum(rv));
 }
+
+TEST(AgradRevMatrix, sum_matrix_var) {
+  using stan::math::matrix_d;
+  using stan::math::matrix_var;
+  using stan::math::sum;
+  using stan::math::var;
+  matrix_d a(2, 3);
+  a << 1, 2, 3, 4, 5, 6;
+
+  matrix_var A(a);
+  var f = sum(A);
+  EXPECT_FLOAT_EQ(21, f.val());
+  f.grad();
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_FLOAT_EQ(1, A.adj()(i));
+  EXPECT_FLOAT_EQ(0, sum(matrix_var(matrix_d(0, 0))).val());
+  stan::math::recover_memory();
+}
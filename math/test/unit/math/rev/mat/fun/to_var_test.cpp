@@ -89,3 +89,25 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::to_var(v));
   test::check_varis_on_stack(stan::math::to_var(rv));
 }
+
+TEST(AgradRevMatrix, to_var_matrix_var) {
+  using stan::math::matrix_d;
+  using stan::math::matrix_v;
+  using stan::math::matrix_var;
+  using stan::math::to_var;
+  using stan::math::var;
+  matrix_d a(2, 3);
+  a << 1, 2, 3, 4, 5, 6;
+
+  matrix_var A(a);
+  matrix_v a_v = to_var(A);
+  EXPECT_EQ(2, a_v.rows());
+  EXPECT_EQ(3, a_v.cols());
+  var f = a_v(1, 2) * a_v(0, 1);
+  EXPECT_FLOAT_EQ(12, f.val());
+  f.grad();
+  EXPECT_FLOAT_EQ(6, A.adj()(0, 1));
+  EXPECT_FLOAT_EQ(2, A.adj()(1, 2));
+  EXPECT_FLOAT_EQ(0, A.adj()(0, 0));
+  stan::math::recover_memory();
+}
@@ -83,3 +83,26 @@ TEST(AgradRevMatrix, check_varis_on_stack) {
   test::check_varis_on_stack(stan::math::transpose(b));
   test::check_varis_on_stack(stan::math::transpose(c));
 }
+
+TEST(AgradRevMatrix, transpose_matrix_var) {
+  using stan::math::matrix_d;
+  using stan::math::matrix_var;
+  using stan::math::multiply;
+  using stan::math::sum;
+  using stan::math::transpose;
+  using stan::math::var;
+  matrix_d a(2, 3), w(2, 2);
+  a << 1, 2, 3, 4, 5, 6;
+  w << 1, -2, 3, 0.5;
+
+  matrix_var A(a);
+  matrix_var At = transpose(A);
+  EXPECT_EQ(3, At.rows());
+  EXPECT_EQ(2, At.cols());
+  var f = sum(multiply(At, w));
+  f.grad();
+  matrix_d g = (Eigen::MatrixXd::Ones(3, 2) * w.transpose()).transpose();
+  for (int i = 0; i < a.size(); ++i)
+    EXPECT_FLOAT_EQ(g(i), A.adj()(i));
+  stan::math::recover_memory();
+}
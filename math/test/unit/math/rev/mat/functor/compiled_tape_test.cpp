@@ -0,0 +1,134 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+struct static_fun {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    std::vector<T> terms;
+    terms.push_back(-0.5 * stan::math::square((x(0) - 1.5) / x(1)));
+    terms.push_back(-stan::math::log(x(1)));
+    terms.push_back(stan::math::exp(x(2)) / (1 + x(0) * x(0)));
+    terms.push_back(stan::math::log1p_exp(-x(2)) - stan::math::sqrt(x(1)));
+    terms.push_back(3.0 / x(1) - x(2) * 2.0 + 2.0 - x(0));
+    terms.push_back(stan::math::log_inv_logit(x(0))
+                    + stan::math::log1m_inv_logit(x(2)));
+    terms.push_back(stan::math::inv_logit(-x(1)) + stan::math::expm1(x(0))
+                    + stan::math::log1p(x(1)));
+    return stan::math::sum(terms);
+  }
+};
+
+struct branching_fun {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    if (x(0) > 0)
+      return x(0) * x(1);
+    return stan::math::fabs(x(1)) * 2.0;
+  }
+};
+
+struct matrix_fun {
+  template <typename T>
+  T operator()(const Eigen::Matrix<T, Eigen::Dynamic, 1>& x) const {
+    return stan::math::dot_self(x);
+  }
+};
+
+void expect_replay_matches(const Eigen::VectorXd& x,
+                           stan::math::compiled_tape& tape) {
+  double fx, fx_expected;
+  Eigen::VectorXd grad_fx, grad_fx_expected;
+  ASSERT_TRUE(tape.replay(x, fx, grad_fx));
+  stan::math::gradient(static_fun(), x, fx_expected, grad_fx_expected);
+  EXPECT_FLOAT_EQ(fx_expected, fx);
+  ASSERT_EQ(grad_fx_expected.size(), grad_fx.size());
+  for (int i = 0; i < grad_fx.size(); ++i)
+    EXPECT_FLOAT_EQ(grad_fx_expected(i), grad_fx(i));
+}
+
+TEST(AgradRevCompiledTape, replay_static_function) {
+  stan::math::compiled_tape tape;
+  EXPECT_FALSE(tape.compiled());
+
+  Eigen::VectorXd x(3);
+  x << 0.3, 1.2, -0.4;
+  double fx, fx_expected;
+  Eigen::VectorXd grad_fx, grad_fx_expected;
+  EXPECT_TRUE(tape.record(static_fun(), x, fx, grad_fx));
+  EXPECT_TRUE(tape.compiled());
+  EXPECT_LT(20U, tape.num_ops());
+  stan::math::gradient(static_fun(), x, fx_expected, grad_fx_expected);
+  EXPECT_FLOAT_EQ(fx_expected, fx);
+  for (int i = 0; i < 3; ++i)
+    EXPECT_FLOAT_EQ(grad_fx_expected(i), grad_fx(i));
+
+  expect_replay_matches(x, tape);
+  x << -1.1, 0.7, 2.5;
+  expect_replay_matches(x, tape);
+  x << 4, 3, 0.1;
+  expect_replay_matches(x, tape);
+
+  // replay leaves the autodiff stack untouched
+  EXPECT_EQ(0U, stan::math::ChainableStack::instance().var_stack_.size());
+  EXPECT_EQ(0U, stan::math::ChainableStack::instance().op_results_.size());
+  EXPECT_EQ(0, stan::math::num_tape_recordings().load());
+}
+
+TEST(AgradRevCompiledTape, replay_fails) {
+  stan::math::compiled_tape tape;
+  Eigen::VectorXd x(3);
+  double fx;
+  Eigen::VectorXd grad_fx;
+  EXPECT_FALSE(tape.replay(x, fx, grad_fx));
+
+  x << 0.3, 1.2, -0.4;
+  ASSERT_TRUE(tape.record(static_fun(), x, fx, grad_fx));
+  // log of a negative argument
+  x << 0.3, -1.2, -0.4;
+  EXPECT_FALSE(tape.replay(x, fx, grad_fx));
+  Eigen::VectorXd y(2);
+  y << 0.3, 1.2;
+  EXPECT_FALSE(tape.replay(y, fx, grad_fx));
+}
+
+TEST(AgradRevCompiledTape, control_flow_divergence) {
+  stan::math::compiled_tape tape;
+  Eigen::VectorXd x(2);
+  double fx;
+  Eigen::VectorXd grad_fx;
+
+  x << 2, 3;
+  ASSERT_TRUE(tape.record(branching_fun(), x, fx, grad_fx));
+  x << 5, 7;
+  ASSERT_TRUE(tape.replay(x, fx, grad_fx));
+  EXPECT_FLOAT_EQ(35, fx);
+  EXPECT_FLOAT_EQ(7, grad_fx(0));
+  EXPECT_FLOAT_EQ(5, grad_fx(1));
+  x << -5, 7;
+  EXPECT_FALSE(tape.replay(x, fx, grad_fx));
+
+  // the branch inside fabs() is recorded as well
+  ASSERT_TRUE(tape.record(branching_fun(), x, fx, grad_fx));
+  EXPECT_FLOAT_EQ(14, fx);
+  x << -1, 4;
+  ASSERT_TRUE(tape.replay(x, fx, grad_fx));
+  EXPECT_FLOAT_EQ(8, fx);
+  EXPECT_FLOAT_EQ(2, grad_fx(1));
+  x << -1, -4;
+  EXPECT_FALSE(tape.replay(x, fx, grad_fx));
+}
+
+TEST(AgradRevCompiledTape, not_compilable) {
+  stan::math::compiled_tape tape;
+  Eigen::VectorXd x(2);
+  x << 2, 3;
+  double fx;
+  Eigen::VectorXd grad_fx;
+  EXPECT_FALSE(tape.record(matrix_fun(), x, fx, grad_fx));
+  EXPECT_FLOAT_EQ(13, fx);
+  EXPECT_FLOAT_EQ(4, grad_fx(0));
+  EXPECT_FLOAT_EQ(6, grad_fx(1));
+  EXPECT_FALSE(tape.compiled());
+  EXPECT_FALSE(tape.replay(x, fx, grad_fx));
+}
@@ -52,5 +52,5 @@ TEST(AgradAutoDiff, RecoverMemory) {
   }
   // depends on starting allocation of 65K not being exceeded
   // without recovery_memory in autodiff::apply_recover(), takes 67M 
-  EXPECT_TRUE(stan::math::ChainableStack::memalloc_.bytes_allocated() < 100000);
+  EXPECT_TRUE(stan::math::ChainableStack::instance().memalloc_.bytes_allocated() < 100000);
 }  
@@ -0,0 +1,254 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+#include <test/unit/math/prim/arr/functor/lorenz.hpp>
+
+// linear system dy_i/dt = -sum_j theta[i * N + j] * y_j + theta[N * N + i]
+struct linear_ode_fun {
+  template <typename T0, typename T1, typename T2>
+  inline
+  std::vector<typename stan::return_type<T1, T2>::type>
+  operator()(const T0& t_in,
+             const std::vector<T1>& y,
+             const std::vector<T2>& theta,
+             const std::vector<double>& x,
+             const std::vector<int>& x_int,
+             std::ostream* msgs) const {
+    size_t N = y.size();
+    std::vector<typename stan::return_type<T1, T2>::type> dy_dt(N);
+    for (size_t i = 0; i < N; ++i) {
+      dy_dt[i] = theta[N * N + i];
+      for (size_t j = 0; j < N; ++j)
+        dy_dt[i] -= theta[i * N + j] * y[j];
+    }
+    return dy_dt;
+  }
+};
+
+// Values of the solutions and gradient of a weighted sum of all of
+// them with respect to the initial state and the parameters.
+template <typename T_y0, typename T_theta, typename F>
+void ode_grad(const F& f, bool adjoint,
+              const std::vector<double>& y0_d, double t0,
+              const std::vector<double>& ts,
+              const std::vector<double>& theta_d,
+              const std::vector<double>& x,
+              const std::vector<int>& x_int,
+              std::vector<double>& y, std::vector<double>& grad) {
+  using stan::math::var;
+  std::vector<T_y0> y0(y0_d.begin(), y0_d.end());
+  std::vector<T_theta> theta(theta_d.begin(), theta_d.end());
+  std::vector<std::vector<var> > res
+    = adjoint
+    ? stan::math::integrate_ode_adjoint(f, y0, t0, ts, theta, x, x_int)
+    : stan::math::integrate_ode_bdf(f, y0, t0, ts, theta, x, x_int);
+
+  var lp = 0;
+  y.clear();
+  for (size_t n = 0; n < res.size(); ++n) {
+    for (size_t i = 0; i < res[n].size(); ++i) {
+      y.push_back(res[n][i].val());
+      lp += (1.0 + 0.1 * n - 0.3 * i) * res[n][i];
+    }
+  }
+  std::vector<var> vars;
+  for (size_t i = 0; i < y0.size(); ++i)
+    if (stan::is_var<T_y0>::value)
+      vars.push_back(y0[i]);
+  for (size_t m = 0; m < theta.size(); ++m)
+    if (stan::is_var<T_theta>::value)
+      vars.push_back(theta[m]);
+  lp.grad(vars, grad);
+  stan::math::recover_memory();
+}
+
+template <typename T_y0, typename T_theta, typename F>
+void ode_adjoint_test(const F& f,
+                      const std::vector<double>& y0, double t0,
+                      const std::vector<double>& ts,
+                      const std::vector<double>& theta,
+                      const std::vector<double>& x,
+                      const std::vector<int>& x_int,
+                      double tol) {
+  std::vector<double> y_adj, grad_adj, y_bdf, grad_bdf;
+  ode_grad<T_y0, T_theta>(f, true, y0, t0, ts, theta, x, x_int,
+                          y_adj, grad_adj);
+  ode_grad<T_y0, T_theta>(f, false, y0, t0, ts, theta, x, x_int,
+                          y_bdf, grad_bdf);
+  ASSERT_EQ(y_bdf.size(), y_adj.size());
+  for (size_t n = 0; n < y_bdf.size(); ++n)
+    EXPECT_FLOAT_EQ(y_bdf[n], y_adj[n]);
+  ASSERT_EQ(grad_bdf.size(), grad_adj.size());
+  for (size_t k = 0; k < grad_bdf.size(); ++k)
+    EXPECT_NEAR(grad_bdf[k], grad_adj[k], tol * (1 + std::fabs(grad_bdf[k])))
+      << "gradient " << k;
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, harm_osc) {
+  using stan::math::var;
+  harm_osc_ode_fun harm_osc;
+  std::vector<double> y0(2);
+  y0[0] = 1.0;
+  y0[1] = 0.0;
+  std::vector<double> theta(1, 0.15);
+  std::vector<double> ts;
+  for (int i = 0; i < 100; i++)
+    ts.push_back(0.1 * (i + 1));
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  ode_adjoint_test<var, double>(harm_osc, y0, 0, ts, theta, x, x_int, 1e-6);
+  ode_adjoint_test<double, var>(harm_osc, y0, 0, ts, theta, x, x_int, 1e-6);
+  ode_adjoint_test<var, var>(harm_osc, y0, 0, ts, theta, x, x_int, 1e-6);
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, lorenz) {
+  using stan::math::var;
+  lorenz_ode_fun lorenz;
+  std::vector<double> y0(3);
+  y0[0] = 10.0;
+  y0[1] = 1.0;
+  y0[2] = 1.0;
+  std::vector<double> theta(3);
+  theta[0] = 10.0;
+  theta[1] = 28.0;
+  theta[2] = 8.0 / 3.0;
+  std::vector<double> ts;
+  for (int i = 0; i < 10; i++)
+    ts.push_back(0.1 * (i + 1));
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  ode_adjoint_test<var, var>(lorenz, y0, 0, ts, theta, x, x_int, 1e-5);
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, many_params) {
+  using stan::math::var;
+  linear_ode_fun linear;
+  size_t N = 4;
+  std::vector<double> y0(N);
+  std::vector<double> theta(N * N + N);
+  for (size_t i = 0; i < N; ++i) {
+    y0[i] = 1.0 + 0.5 * i;
+    for (size_t j = 0; j < N; ++j)
+      theta[i * N + j] = i == j ? 1.0 + 0.2 * i : 0.1 * (i + 1.0) / (j + 2.0);
+    theta[N * N + i] = 0.3 * i;
+  }
+  std::vector<double> ts;
+  ts.push_back(0.5);
+  ts.push_back(1.0);
+  ts.push_back(4.0);
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  ode_adjoint_test<double, var>(linear, y0, -0.5, ts, theta, x, x_int, 1e-6);
+  ode_adjoint_test<var, var>(linear, y0, -0.5, ts, theta, x, x_int, 1e-6);
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, repeated_grad) {
+  using stan::math::var;
+  harm_osc_ode_fun harm_osc;
+  std::vector<var> y0(2);
+  y0[0] = 1.0;
+  y0[1] = 0.0;
+  std::vector<var> theta(1, 0.15);
+  std::vector<double> ts;
+  ts.push_back(1.0);
+  ts.push_back(2.0);
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  std::vector<std::vector<var> > res
+    = stan::math::integrate_ode_adjoint(harm_osc, y0, 0, ts, theta, x, x_int);
+  std::vector<std::vector<var> > res_bdf
+    = stan::math::integrate_ode_bdf(harm_osc, y0, 0, ts, theta, x, x_int);
+  std::vector<var> vars(y0);
+  vars.push_back(theta[0]);
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (size_t i = 0; i < 2; ++i) {
+      std::vector<double> grad, grad_bdf;
+      stan::math::set_zero_all_adjoints();
+      res[n][i].grad(vars, grad);
+      stan::math::set_zero_all_adjoints();
+      res_bdf[n][i].grad(vars, grad_bdf);
+      for (size_t k = 0; k < vars.size(); ++k)
+        EXPECT_NEAR(grad_bdf[k], grad[k], 1e-6);
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, one_node) {
+  using stan::math::var;
+  linear_ode_fun linear;
+  std::vector<double> y0(2, 1.0);
+  std::vector<var> theta(6, 0.5);
+  std::vector<double> ts;
+  for (int i = 0; i < 10; i++)
+    ts.push_back(0.1 * (i + 1));
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  size_t stack_size
+    = stan::math::ChainableStack::instance().var_stack_.size();
+  std::vector<std::vector<var> > res
+    = stan::math::integrate_ode_adjoint(linear, y0, 0, ts, theta, x, x_int);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, data) {
+  harm_osc_ode_fun harm_osc;
+  std::vector<double> y0(2);
+  y0[0] = 1.0;
+  y0[1] = 0.0;
+  std::vector<double> theta(1, 0.15);
+  std::vector<double> ts(1, 10.0);
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  std::vector<std::vector<double> > res
+    = stan::math::integrate_ode_adjoint(harm_osc, y0, 0, ts, theta, x, x_int);
+  EXPECT_NEAR(-0.421907, res[0][0], 1e-5);
+  EXPECT_NEAR(0.246407, res[0][1], 1e-5);
+}
+
+TEST(StanMathOdeIntegrateODEAdjoint, error_conditions) {
+  using stan::math::var;
+  harm_osc_ode_fun harm_osc;
+  std::vector<var> y0(2, 1.0);
+  std::vector<var> theta(1, 0.15);
+  std::vector<double> ts(2);
+  ts[0] = 1.0;
+  ts[1] = 2.0;
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  std::vector<var> y0_bad;
+  EXPECT_THROW(stan::math::integrate_ode_adjoint(harm_osc, y0_bad, 0, ts,
+                                                 theta, x, x_int),
+               std::invalid_argument);
+  EXPECT_THROW(stan::math::integrate_ode_adjoint(harm_osc, y0, 1.5, ts,
+                                                 theta, x, x_int),
+               std::domain_error);
+  std::vector<double> ts_bad(ts);
+  ts_bad[1] = 0.5;
+  EXPECT_THROW(stan::math::integrate_ode_adjoint(harm_osc, y0, 0, ts_bad,
+                                                 theta, x, x_int),
+               std::domain_error);
+  std::vector<var> theta_bad(1, std::numeric_limits<double>::infinity());
+  EXPECT_THROW(stan::math::integrate_ode_adjoint(harm_osc, y0, 0, ts,
+                                                 theta_bad, x, x_int),
+               std::domain_error);
+  EXPECT_THROW(stan::math::integrate_ode_adjoint(harm_osc, y0, 0, ts,
+                                                 theta, x, x_int, 0, -1),
+               std::invalid_argument);
+  std::vector<double> ts_long(1, 1e4);
+  EXPECT_THROW(stan::math::integrate_ode_adjoint(harm_osc, y0, 0, ts_long,
+                                                 theta, x, x_int, 0,
+                                                 1e-10, 1e-10, 5),
+               std::runtime_error);
+  stan::math::recover_memory();
+}
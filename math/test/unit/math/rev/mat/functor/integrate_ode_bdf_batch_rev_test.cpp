@@ -0,0 +1,192 @@
+#define STAN_THREADS
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+
+struct harm_osc_ode_print_fun {
+  template <typename T0, typename T1, typename T2>
+  inline
+  std::vector<typename stan::return_type<T1, T2>::type>
+  operator()(const T0& t_in,
+             const std::vector<T1>& y_in,
+             const std::vector<T2>& theta,
+             const std::vector<double>& x,
+             const std::vector<int>& x_int,
+             std::ostream* msgs) const {
+    if (msgs && t_in == 0)
+      *msgs << x_int[0] << ";";
+    if (theta[0] < 0)
+      throw std::domain_error("negative damping");
+    return harm_osc_ode_fun()(t_in, y_in, theta, x, x_int, msgs);
+  }
+};
+
+class StanMathOdeIntegrateODEBDFBatch : public ::testing::Test {
+public:
+  void SetUp() {
+    setenv("STAN_NUM_THREADS", "3", 1);
+    J = 7;
+    y0_d.resize(J, std::vector<double>(2));
+    theta_d.resize(J, std::vector<double>(1));
+    ts.resize(J);
+    x.resize(J);
+    x_int.resize(J, std::vector<int>(1));
+    for (int j = 0; j < J; ++j) {
+      y0_d[j][0] = 1.0 + 0.1 * j;
+      y0_d[j][1] = -0.2 * j;
+      theta_d[j][0] = 0.05 + 0.03 * j;
+      for (int i = 0; i <= j % 3; ++i)
+        ts[j].push_back(0.5 + 0.75 * i + 0.1 * j);
+      x_int[j][0] = j;
+    }
+  }
+
+  void TearDown() {
+    unsetenv("STAN_NUM_THREADS");
+    stan::math::recover_memory();
+  }
+
+  // Compares the solutions and their gradients with respect to the
+  // initial states and the parameters to those of integrate_ode_bdf.
+  template <typename T_initial, typename T_param>
+  void test_matches_serial() {
+    using stan::math::var;
+    harm_osc_ode_fun harm_osc;
+    std::vector<std::vector<T_initial> > y0(J);
+    std::vector<std::vector<T_param> > theta(J);
+    for (int j = 0; j < J; ++j) {
+      y0[j].assign(y0_d[j].begin(), y0_d[j].end());
+      theta[j].assign(theta_d[j].begin(), theta_d[j].end());
+    }
+    std::vector<var> vars;
+    for (int j = 0; j < J; ++j) {
+      for (size_t n = 0; n < 2; ++n)
+        if (stan::is_var<T_initial>::value)
+          vars.push_back(y0[j][n]);
+      if (stan::is_var<T_param>::value)
+        vars.push_back(theta[j][0]);
+    }
+
+    std::vector<std::vector<std::vector<var> > > ys
+      = stan::math::integrate_ode_bdf_batch(harm_osc, y0, 0.0, ts, theta,
+                                            x, x_int);
+    ASSERT_EQ(static_cast<size_t>(J), ys.size());
+    for (int j = 0; j < J; ++j) {
+      std::vector<std::vector<var> > ys_ref
+        = stan::math::integrate_ode_bdf(harm_osc, y0[j], 0.0, ts[j],
+                                        theta[j], x[j], x_int[j]);
+      ASSERT_EQ(ys_ref.size(), ys[j].size());
+      for (size_t n = 0; n < ys_ref.size(); ++n) {
+        for (size_t i = 0; i < 2; ++i) {
+          EXPECT_FLOAT_EQ(ys_ref[n][i].val(), ys[j][n][i].val());
+          std::vector<double> grad;
+          std::vector<double> grad_ref;
+          stan::math::set_zero_all_adjoints();
+          ys[j][n][i].grad(vars, grad);
+          stan::math::set_zero_all_adjoints();
+          ys_ref[n][i].grad(vars, grad_ref);
+          for (size_t k = 0; k < vars.size(); ++k)
+            EXPECT_FLOAT_EQ(grad_ref[k], grad[k]);
+        }
+      }
+    }
+  }
+
+  int J;
+  std::vector<std::vector<double> > y0_d;
+  std::vector<std::vector<double> > theta_d;
+  std::vector<std::vector<double> > ts;
+  std::vector<std::vector<double> > x;
+  std::vector<std::vector<int> > x_int;
+};
+
+TEST_F(StanMathOdeIntegrateODEBDFBatch, var_var_matches_serial) {
+  test_matches_serial<stan::math::var, stan::math::var>();
+}
+
+TEST_F(StanMathOdeIntegrateODEBDFBatch, double_var_matches_serial) {
+  test_matches_serial<double, stan::math::var>();
+}
+
+TEST_F(StanMathOdeIntegrateODEBDFBatch, var_double_matches_serial) {
+  test_matches_serial<stan::math::var, double>();
+}
+
+TEST_F(StanMathOdeIntegrateODEBDFBatch, data) {
+  harm_osc_ode_fun harm_osc;
+  std::vector<std::vector<std::vector<double> > > ys
+    = stan::math::integrate_ode_bdf_batch(harm_osc, y0_d, 0.0, ts, theta_d,
+                                          x, x_int);
+  ASSERT_EQ(static_cast<size_t>(J), ys.size());
+  for (int j = 0; j < J; ++j) {
+    std::vector<std::vector<double> > ys_ref
+      = stan::math::integrate_ode_bdf(harm_osc, y0_d[j], 0.0, ts[j],
+                                      theta_d[j], x[j], x_int[j]);
+    ASSERT_EQ(ys_ref.size(), ys[j].size());
+    for (size_t n = 0; n < ys_ref.size(); ++n)
+      for (size_t i = 0; i < 2; ++i)
+        EXPECT_FLOAT_EQ(ys_ref[n][i], ys[j][n][i]);
+  }
+}
+
+TEST_F(StanMathOdeIntegrateODEBDFBatch, empty) {
+  harm_osc_ode_fun harm_osc;
+  std::vector<std::vector<double> > empty_d;
+  std::vector<std::vector<int> > empty_i;
+  EXPECT_EQ(0U, stan::math::integrate_ode_bdf_batch(harm_osc, empty_d, 0.0,
+                                                    empty_d, empty_d, empty_d,
+                                                    empty_i).size());
+}
+
+TEST_F(StanMathOdeIntegrateODEBDFBatch, messages_in_order) {
+  harm_osc_ode_print_fun harm_osc;
+  std::stringstream msgs;
+  stan::math::integrate_ode_bdf_batch(harm_osc, y0_d, 0.0, ts, theta_d,
+                                      x, x_int, &msgs);
+  size_t pos = 0;
+  for (int j = 0; j < J; ++j) {
+    std::stringstream msg;
+    msg << j << ";";
+    size_t next = msgs.str().find(msg.str(), pos);
+    ASSERT_NE(std::string::npos, next);
+    pos = next;
+  }
+}
+
+TEST_F(StanMathOdeIntegrateODEBDFBatch, error_conditions) {
+  using stan::math::var;
+  harm_osc_ode_print_fun harm_osc;
+  std::vector<std::vector<var> > theta(J, std::vector<var>(1, 0.15));
+
+  std::vector<std::vector<double> > ts_short(ts.begin(), ts.end() - 1);
+  EXPECT_THROW(stan::math::integrate_ode_bdf_batch(harm_osc, y0_d, 0.0,
+                                                   ts_short, theta, x, x_int),
+               std::invalid_argument);
+
+  std::vector<std::vector<double> > y0_bad(y0_d);
+  y0_bad[3].push_back(1.0);
+  EXPECT_THROW(stan::math::integrate_ode_bdf_batch(harm_osc, y0_bad, 0.0,
+                                                   ts, theta, x, x_int),
+               std::invalid_argument);
+
+  std::vector<std::vector<double> > ts_bad(ts);
+  ts_bad[5][0] = -1.0;
+  EXPECT_THROW(stan::math::integrate_ode_bdf_batch(harm_osc, y0_d, 0.0,
+                                                   ts_bad, theta, x, x_int),
+               std::domain_error);
+
+  std::vector<std::vector<var> > theta_bad(theta);
+  theta_bad[4][0] = -1.0;
+  EXPECT_THROW(stan::math::integrate_ode_bdf_batch(harm_osc, y0_d, 0.0,
+                                                   ts, theta_bad, x, x_int),
+               std::domain_error);
+
+  EXPECT_THROW(stan::math::integrate_ode_bdf_batch(harm_osc, y0_d, 0.0,
+                                                   ts, theta, x, x_int,
+                                                   0, -1),
+               std::invalid_argument);
+}
@@ -0,0 +1,64 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+#include <test/unit/math/prim/arr/functor/harmonic_oscillator.hpp>
+
+// Solutions and their gradients with respect to the initial state and
+// the parameter, with a sensitivity or an adjoint solve.
+template <typename F>
+void harm_osc_grads(const F& f, bool adjoint,
+                    std::vector<double>& y, std::vector<double>& grads) {
+  using stan::math::var;
+  std::vector<var> y0(2);
+  y0[0] = 1.0;
+  y0[1] = 0.5;
+  std::vector<var> theta(1, 0.15);
+  std::vector<double> ts;
+  for (int i = 0; i < 10; i++)
+    ts.push_back(0.5 * (i + 1));
+  std::vector<double> x;
+  std::vector<int> x_int;
+
+  std::vector<std::vector<var> > ys
+    = adjoint
+    ? stan::math::integrate_ode_adjoint(f, y0, 0, ts, theta, x, x_int)
+    : stan::math::integrate_ode_bdf(f, y0, 0, ts, theta, x, x_int);
+  std::vector<var> vars(y0);
+  vars.push_back(theta[0]);
+  y.clear();
+  grads.clear();
+  for (size_t n = 0; n < ts.size(); ++n) {
+    for (size_t i = 0; i < 2; ++i) {
+      y.push_back(ys[n][i].val());
+      std::vector<double> grad;
+      stan::math::set_zero_all_adjoints();
+      ys[n][i].grad(vars, grad);
+      grads.insert(grads.end(), grad.begin(), grad.end());
+    }
+  }
+  stan::math::recover_memory();
+}
+
+TEST(StanMathOdeIntegrateODEBDF, analytic_jacobian) {
+  harm_osc_ode_fun harm_osc;
+  int calls = 0;
+  for (int k = 0; k < 2; ++k) {
+    bool adjoint = k == 1;
+    std::vector<double> y;
+    std::vector<double> grads;
+    std::vector<double> y_ref;
+    std::vector<double> grads_ref;
+    harm_osc_grads(harm_osc, adjoint, y_ref, grads_ref);
+    harm_osc_grads(stan::math::make_ode_with_jacobian(harm_osc,
+                                                      harm_osc_ode_jacobian(&calls)),
+                   adjoint, y, grads);
+    EXPECT_GT(calls, 0);
+    calls = 0;
+    ASSERT_EQ(y_ref.size(), y.size());
+    for (size_t n = 0; n < y.size(); ++n)
+      EXPECT_NEAR(y_ref[n], y[n], 1e-8);
+    ASSERT_EQ(grads_ref.size(), grads.size());
+    for (size_t n = 0; n < grads.size(); ++n)
+      EXPECT_NEAR(grads_ref[n], grads[n], 1e-7);
+  }
+}
@@ -0,0 +1,163 @@
+#define STAN_THREADS
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <stdexcept>
+#include <vector>
+
+struct map_rect_rev_lpdf {
+  template <typename T1, typename T2>
+  Eigen::Matrix<typename stan::return_type<T1, T2>::type, Eigen::Dynamic, 1>
+  operator()(const Eigen::Matrix<T1, Eigen::Dynamic, 1>& eta,
+             const Eigen::Matrix<T2, Eigen::Dynamic, 1>& theta,
+             const std::vector<double>& x_r, const std::vector<int>& x_i,
+             std::ostream* msgs = 0) const {
+    Eigen::Matrix<typename stan::return_type<T1, T2>::type, Eigen::Dynamic, 1>
+      res(2);
+    res(0) = stan::math::normal_log(x_r, eta(0) + theta(0), eta(1));
+    res(1) = theta(0) * theta(1) * x_i[0];
+    if (msgs)
+      *msgs << x_i[0];
+    return res;
+  }
+};
+
+struct map_rect_rev_throws {
+  template <typename T1, typename T2>
+  Eigen::Matrix<typename stan::return_type<T1, T2>::type, Eigen::Dynamic, 1>
+  operator()(const Eigen::Matrix<T1, Eigen::Dynamic, 1>& eta,
+             const Eigen::Matrix<T2, Eigen::Dynamic, 1>& theta,
+             const std::vector<double>& x_r, const std::vector<int>& x_i,
+             std::ostream* msgs = 0) const {
+    if (x_i[0] == 3)
+      throw std::domain_error("job failed");
+    return eta + theta;
+  }
+};
+
+class MathRevMatFunctorMapRect : public ::testing::Test {
+public:
+  void SetUp() {
+    setenv("STAN_NUM_THREADS", "4", 1);
+    N = 10;
+    shared_params_d.resize(2);
+    shared_params_d << 0.5, 2.0;
+    job_params_d.resize(N, Eigen::VectorXd(2));
+    x_r.resize(N, std::vector<double>(3));
+    x_i.resize(N, std::vector<int>(1));
+    for (int i = 0; i < N; ++i) {
+      job_params_d[i] << 0.1 * i, 1 + i;
+      for (int j = 0; j < 3; ++j)
+        x_r[i][j] = i + 0.3 * j;
+      x_i[i][0] = i;
+    }
+  }
+
+  void TearDown() {
+    unsetenv("STAN_NUM_THREADS");
+    stan::math::recover_memory();
+  }
+
+  int N;
+  Eigen::VectorXd shared_params_d;
+  std::vector<Eigen::VectorXd> job_params_d;
+  std::vector<std::vector<double> > x_r;
+  std::vector<std::vector<int> > x_i;
+};
+
+TEST_F(MathRevMatFunctorMapRect, var_var_matches_serial) {
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> shared_params = shared_params_d;
+  std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1> > job_params;
+  for (int i = 0; i < N; ++i)
+    job_params.push_back(job_params_d[i]);
+
+  std::stringstream msgs;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> res
+    = stan::math::map_rect<0, map_rect_rev_lpdf>(shared_params, job_params,
+                                                 x_r, x_i, &msgs);
+  ASSERT_EQ(2 * N, res.size());
+  EXPECT_EQ("0123456789", msgs.str());
+
+  std::vector<var> operands;
+  operands.push_back(shared_params(0));
+  operands.push_back(shared_params(1));
+  for (int i = 0; i < N; ++i) {
+    operands.push_back(job_params[i](0));
+    operands.push_back(job_params[i](1));
+  }
+
+  for (int k = 0; k < res.size(); ++k) {
+    stan::math::start_nested();
+    Eigen::Matrix<var, Eigen::Dynamic, 1> expected
+      = map_rect_rev_lpdf()(shared_params, job_params[k / 2], x_r[k / 2],
+                            x_i[k / 2]);
+    var expected_k = expected(k % 2);
+    EXPECT_FLOAT_EQ(expected_k.val(), res(k).val());
+
+    std::vector<double> g_expected;
+    expected_k.grad(operands, g_expected);
+    stan::math::set_zero_all_adjoints_nested();
+    stan::math::recover_memory_nested();
+
+    std::vector<double> g_res;
+    stan::math::set_zero_all_adjoints();
+    res(k).grad(operands, g_res);
+    stan::math::set_zero_all_adjoints();
+    for (size_t j = 0; j < operands.size(); ++j)
+      EXPECT_FLOAT_EQ(g_expected[j], g_res[j]);
+  }
+}
+
+TEST_F(MathRevMatFunctorMapRect, data_shared_params) {
+  using stan::math::var;
+  std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1> > job_params;
+  for (int i = 0; i < N; ++i)
+    job_params.push_back(job_params_d[i]);
+
+  Eigen::Matrix<var, Eigen::Dynamic, 1> res
+    = stan::math::map_rect<1, map_rect_rev_lpdf>(shared_params_d, job_params,
+                                                 x_r, x_i);
+  ASSERT_EQ(2 * N, res.size());
+  std::vector<var> operands(job_params[4].data(),
+                            job_params[4].data() + 2);
+  std::vector<double> g;
+  res(9).grad(operands, g);
+  // d/dtheta (theta(0) * theta(1) * x_i) for job 4
+  EXPECT_FLOAT_EQ(job_params_d[4](1) * 4, g[0]);
+  EXPECT_FLOAT_EQ(job_params_d[4](0) * 4, g[1]);
+}
+
+TEST_F(MathRevMatFunctorMapRect, data_job_params) {
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> shared_params = shared_params_d;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> res
+    = stan::math::map_rect<2, map_rect_rev_lpdf>(shared_params, job_params_d,
+                                                 x_r, x_i);
+  ASSERT_EQ(2 * N, res.size());
+  EXPECT_EQ(2U + 2 * N,
+            stan::math::ChainableStack::instance().var_stack_.size());
+}
+
+TEST_F(MathRevMatFunctorMapRect, exception_propagates) {
+  using stan::math::var;
+  Eigen::Matrix<var, Eigen::Dynamic, 1> shared_params = shared_params_d;
+  std::vector<Eigen::Matrix<var, Eigen::Dynamic, 1> > job_params;
+  for (int i = 0; i < N; ++i)
+    job_params.push_back(job_params_d[i]);
+  EXPECT_THROW((stan::math::map_rect<3, map_rect_rev_throws>(shared_params,
+                                                             job_params,
+                                                             x_r, x_i)),
+               std::domain_error);
+  EXPECT_TRUE(stan::math::empty_nested());
+}
+
+TEST_F(MathRevMatFunctorMapRect, bad_num_threads) {
+  using stan::math::var;
+  setenv("STAN_NUM_THREADS", "0", 1);
+  Eigen::Matrix<var, Eigen::Dynamic, 1> shared_params = shared_params_d;
+  EXPECT_THROW((stan::math::map_rect<4, map_rect_rev_lpdf>(shared_params,
+                                                           job_params_d,
+                                                           x_r, x_i)),
+               std::invalid_argument);
+}
@@ -237,3 +237,100 @@ TEST_F(StanMathRevOdeSystem, ode_system_jac_Mv_Mm_Mm) {
     for(size_t j = 0; j < M; j++)
       EXPECT_FLOAT_EQ(Jtheta_ref(i,j), Jtheta(i,j));
 }
+
+// ************ vector-jacobian products ************************
+
+TEST_F(StanMathRevOdeSystem, ode_system_vector_jac_m) {
+  stan::math::ode_system<harm_osc_ode_fun> ode_system(ode_rhs, theta, x, x_int, &msgs);
+
+  Eigen::VectorXd lambda(N);
+  lambda << 0.3, -1.7;
+  Eigen::VectorXd lambda_Jy(N);
+
+  ode_system.vector_jacobian(t0, y0, lambda, lambda_Jy);
+
+  Eigen::VectorXd lambda_Jy_ref = Jy_ref.transpose() * lambda;
+  for(size_t i = 0; i < N; i++)
+    EXPECT_FLOAT_EQ(lambda_Jy_ref(i), lambda_Jy(i));
+}
+
+TEST_F(StanMathRevOdeSystem, ode_system_vector_jac_m_m) {
+  stan::math::ode_system<harm_osc_ode_fun> ode_system(ode_rhs, theta, x, x_int, &msgs);
+
+  Eigen::VectorXd lambda(N);
+  lambda << 0.3, -1.7;
+  std::vector<double> lambda_Jy_raw(N, 0);
+  Eigen::Map<Eigen::VectorXd> lambda_Jy(&lambda_Jy_raw[0], N);
+  Eigen::VectorXd lambda_Jtheta(M);
+
+  ode_system.vector_jacobian(t0, y0, lambda, lambda_Jy, lambda_Jtheta);
+
+  Eigen::VectorXd lambda_Jy_ref = Jy_ref.transpose() * lambda;
+  Eigen::VectorXd lambda_Jtheta_ref = Jtheta_ref.transpose() * lambda;
+  for(size_t i = 0; i < N; i++)
+    EXPECT_FLOAT_EQ(lambda_Jy_ref(i), lambda_Jy(i));
+  for(size_t i = 0; i < M; i++)
+    EXPECT_FLOAT_EQ(lambda_Jtheta_ref(i), lambda_Jtheta(i));
+}
+
+TEST_F(StanMathRevOdeSystem, ode_system_vector_jac_wrong_size) {
+  stan::math::ode_system<harm_osc_ode_wrong_size_1_fun>
+    ode_system1(ode_wrong_size_1_rhs, theta, x, x_int, &msgs);
+
+  Eigen::VectorXd lambda(N);
+  lambda << 0.3, -1.7;
+  Eigen::VectorXd lambda_Jy(N);
+  Eigen::VectorXd lambda_Jtheta(M);
+
+  EXPECT_THROW_MSG(ode_system1.vector_jacobian(t0, y0, lambda, lambda_Jy,
+                                               lambda_Jtheta),
+                   std::runtime_error,
+                   "ode_system: size of state vector y (2) and derivative vector dy_dt (3) in the ODE functor do not match in size.");
+}
+
+TEST_F(StanMathRevOdeSystem, ode_system_analytic_jac) {
+  using stan::math::ode_with_jacobian;
+  int calls = 0;
+  ode_with_jacobian<harm_osc_ode_fun, harm_osc_ode_jacobian>
+    ode_jac_rhs = stan::math::make_ode_with_jacobian(ode_rhs,
+                                                     harm_osc_ode_jacobian(&calls));
+  stan::math::ode_system<ode_with_jacobian<harm_osc_ode_fun,
+                                           harm_osc_ode_jacobian> >
+    ode_system(ode_jac_rhs, theta, x, x_int, &msgs);
+
+  Eigen::VectorXd dy_dt(N);
+  std::vector<double> Jy_raw(N*N, 0);
+  Eigen::Map<Eigen::MatrixXd> Jy(&Jy_raw[0], N, N);
+  Eigen::MatrixXd Jtheta(N, M);
+
+  ode_system.jacobian(t0, y0, dy_dt, Jy);
+  EXPECT_EQ(1, calls);
+  EXPECT_FLOAT_EQ( 2.0, dy_dt[0]);
+  EXPECT_FLOAT_EQ(-2.0, dy_dt[1]);
+  for(size_t i = 0; i < N; i++)
+    for(size_t j = 0; j < N; j++)
+      EXPECT_FLOAT_EQ(Jy_ref(i,j), Jy(i,j));
+
+  Eigen::MatrixXd Jy2(N, N);
+  ode_system.jacobian(t0, y0, dy_dt, Jy2, Jtheta);
+  EXPECT_EQ(2, calls);
+  for(size_t i = 0; i < N; i++)
+    for(size_t j = 0; j < N; j++)
+      EXPECT_FLOAT_EQ(Jy_ref(i,j), Jy2(i,j));
+  for(size_t i = 0; i < N; i++)
+    for(size_t j = 0; j < M; j++)
+      EXPECT_FLOAT_EQ(Jtheta_ref(i,j), Jtheta(i,j));
+
+  Eigen::VectorXd lambda(N);
+  lambda << 0.3, -1.7;
+  Eigen::VectorXd lambda_Jy(N);
+  Eigen::VectorXd lambda_Jtheta(M);
+  ode_system.vector_jacobian(t0, y0, lambda, lambda_Jy, lambda_Jtheta);
+  EXPECT_EQ(3, calls);
+  Eigen::VectorXd lambda_Jy_ref = Jy_ref.transpose() * lambda;
+  Eigen::VectorXd lambda_Jtheta_ref = Jtheta_ref.transpose() * lambda;
+  for(size_t i = 0; i < N; i++)
+    EXPECT_FLOAT_EQ(lambda_Jy_ref(i), lambda_Jy(i));
+  for(size_t i = 0; i < M; i++)
+    EXPECT_FLOAT_EQ(lambda_Jtheta_ref(i), lambda_Jtheta(i));
+}
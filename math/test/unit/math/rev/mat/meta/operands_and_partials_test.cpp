@@ -10,7 +10,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsVec) {
 
   vector_d d_vec(4);
   operands_and_partials<vector_d > o3(d_vec);
-  EXPECT_EQ(4, sizeof(o3));
+  EXPECT_EQ(5, sizeof(o3));
 
   vector_v v_vec(4);
   var v1 = var(0.0);
@@ -47,7 +47,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsStdVec) {
 
   std::vector<double> d_vec(4);
   operands_and_partials<std::vector<double> > o3(d_vec);
-  EXPECT_EQ(4, sizeof(o3));
+  EXPECT_EQ(5, sizeof(o3));
 
   std::vector<var> v_vec;
   var v1 = var(0.0);
@@ -86,7 +86,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsMat) {
   d_mat << 10.0, 20.0, 30.0, 40.0;
   operands_and_partials<matrix_d > o3(d_mat);
 
-  EXPECT_EQ(4, sizeof(o3));
+  EXPECT_EQ(5, sizeof(o3));
 
   matrix_v v_mat(2, 2);
   var v1 = var(0.0);
@@ -128,7 +128,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsMatMultivar) {
   d_mat_vec.push_back(d_mat);
   operands_and_partials<std::vector<matrix_d> > o3(d_mat_vec);
 
-  EXPECT_EQ(4, sizeof(o3));
+  EXPECT_EQ(5, sizeof(o3));
 
   matrix_v v_mat1(2, 2);
   var v1 = var(0.0);
@@ -192,7 +192,7 @@ TEST(AgradPartialsVari, OperandsAndPartialsMultivar) {
   d_vec_vec.push_back(d_vec2);
   operands_and_partials<std::vector<vector_d> > o3(d_vec_vec);
 
-  EXPECT_EQ(4, sizeof(o3));
+  EXPECT_EQ(5, sizeof(o3));
 
   vector_v v_vec1(2);
   var v1 = var(0.0);
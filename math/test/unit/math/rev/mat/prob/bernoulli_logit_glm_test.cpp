@@ -0,0 +1,106 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using stan::math::var;
+
+// parameters are x (4 x 2), alpha (4), beta (2)
+template <bool fused>
+struct bernoulli_logit_glm_functor {
+  std::vector<int> n_;
+  explicit bernoulli_logit_glm_functor(const std::vector<int>& n) : n_(n) { }
+
+  template <typename T>
+  T operator()(const Matrix<T, Dynamic, 1>& theta) const {
+    Matrix<T, Dynamic, Dynamic> x(4, 2);
+    for (int i = 0; i < 8; ++i)
+      x(i) = theta(i);
+    Matrix<T, Dynamic, 1> alpha = theta.segment(8, 4);
+    Matrix<T, Dynamic, 1> beta = theta.segment(12, 2);
+    if (fused)
+      return stan::math::bernoulli_logit_glm_lpmf(n_, x, alpha, beta);
+    return stan::math::bernoulli_logit_lpmf(
+        n_, stan::math::add(stan::math::multiply(x, beta), alpha));
+  }
+};
+
+TEST(AgradRevBernoulliLogitGlm, gradient_matches_bernoulli_logit) {
+  std::vector<int> n(4);
+  n[0] = 1;
+  n[1] = 0;
+  n[2] = 1;
+  n[3] = 0;
+  Matrix<double, Dynamic, 1> theta(14);
+  theta << -1.2, 0.46, -0.42, 2.4, 0.25, 0.27, 12, -8,
+    0.5, -0.7, 2, 1,  0.3, 2.8;
+  double f_fused, f;
+  Matrix<double, Dynamic, 1> grad_fused, grad;
+  stan::math::gradient(bernoulli_logit_glm_functor<true>(n), theta,
+                       f_fused, grad_fused);
+  stan::math::gradient(bernoulli_logit_glm_functor<false>(n), theta, f,
+                       grad);
+  EXPECT_FLOAT_EQ(f, f_fused);
+  for (int i = 0; i < theta.size(); ++i)
+    EXPECT_FLOAT_EQ(grad(i), grad_fused(i)) << i;
+}
+
+TEST(AgradRevBernoulliLogitGlm, gradient_extreme_values) {
+  // the linear predictor is 27.5, -24.7, 3.45 and 18, beyond the
+  // cutoff of the Taylor approximations for the first two draws
+  std::vector<int> n(4);
+  n[0] = 1;
+  n[1] = 0;
+  n[2] = 1;
+  n[3] = 0;
+  Matrix<double, Dynamic, 1> theta(14);
+  theta << 10, -10, 0.5, 8, 2, 1, 0.2, -3,
+    0.5, -0.7, 2, 1,  2.5, 1;
+  Matrix<double, Dynamic, Dynamic> x(4, 2);
+  for (int i = 0; i < 8; ++i)
+    x(i) = theta(i);
+  Matrix<double, Dynamic, 1> eta
+    = x * theta.segment(12, 2) + theta.segment(8, 4);
+
+  // d/d eta log inv_logit(sign * eta) = sign / (1 + exp(sign * eta))
+  Matrix<double, Dynamic, 1> d_eta(4);
+  for (int i = 0; i < 4; ++i) {
+    double sign = 2 * n[i] - 1;
+    d_eta(i) = sign / (1 + std::exp(sign * eta(i)));
+  }
+  Matrix<double, Dynamic, 1> expected(14);
+  for (int j = 0; j < 2; ++j)
+    expected.segment(4 * j, 4) = d_eta * theta(12 + j);
+  expected.segment(8, 4) = d_eta;
+  expected.segment(12, 2) = x.transpose() * d_eta;
+
+  double f_fused, f;
+  Matrix<double, Dynamic, 1> grad_fused, grad;
+  stan::math::gradient(bernoulli_logit_glm_functor<true>(n), theta,
+                       f_fused, grad_fused);
+  stan::math::gradient(bernoulli_logit_glm_functor<false>(n), theta, f,
+                       grad);
+  for (int i = 0; i < theta.size(); ++i) {
+    EXPECT_FLOAT_EQ(expected(i), grad_fused(i)) << i;
+    EXPECT_FLOAT_EQ(expected(i), grad(i)) << i;
+  }
+}
+
+TEST(AgradRevBernoulliLogitGlm, one_vari) {
+  std::vector<int> n(3, 1);
+  n[1] = 0;
+  Matrix<double, Dynamic, Dynamic> x(3, 2);
+  x << -1.2, 0.46, -0.42, 2.4, 0.25, 0.27;
+  Matrix<var, Dynamic, 1> beta(2);
+  beta << 0.3, -1.8;
+  var alpha = 0.5;
+
+  size_t stack_size = stan::math::ChainableStack::instance().var_stack_.size();
+  var lp = stan::math::bernoulli_logit_glm_lpmf(n, x, alpha, beta);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  test::check_varis_on_stack(lp);
+  stan::math::recover_memory();
+}
@@ -0,0 +1,82 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using stan::math::var;
+
+// parameters are y (3), x (3 x 2), alpha (3), beta (2), sigma (3)
+template <bool fused>
+struct normal_id_glm_functor {
+  template <typename T>
+  T operator()(const Matrix<T, Dynamic, 1>& theta) const {
+    Matrix<T, Dynamic, 1> y = theta.segment(0, 3);
+    Matrix<T, Dynamic, Dynamic> x(3, 2);
+    for (int i = 0; i < 6; ++i)
+      x(i) = theta(3 + i);
+    Matrix<T, Dynamic, 1> alpha = theta.segment(9, 3);
+    Matrix<T, Dynamic, 1> beta = theta.segment(12, 2);
+    Matrix<T, Dynamic, 1> sigma = theta.segment(14, 3);
+    if (fused)
+      return stan::math::normal_id_glm_lpdf(y, x, alpha, beta, sigma);
+    return stan::math::normal_lpdf(y, stan::math::add(stan::math::multiply(x,
+                                                                    beta),
+                                                      alpha), sigma);
+  }
+};
+
+TEST(AgradRevNormalIdGlm, gradient_matches_normal) {
+  Matrix<double, Dynamic, 1> theta(17);
+  theta << 5.1, -3.2, 1.2,  -1.2, 0.46, -0.42, 2.4, 0.25, 0.27,
+    0.5, -0.7, 2,  0.3, -1.8,  2.5, 1.4, 0.9;
+  double f_fused, f;
+  Matrix<double, Dynamic, 1> grad_fused, grad;
+  stan::math::gradient(normal_id_glm_functor<true>(), theta, f_fused,
+                       grad_fused);
+  stan::math::gradient(normal_id_glm_functor<false>(), theta, f, grad);
+  EXPECT_FLOAT_EQ(f, f_fused);
+  for (int i = 0; i < theta.size(); ++i)
+    EXPECT_FLOAT_EQ(grad(i), grad_fused(i)) << i;
+}
+
+TEST(AgradRevNormalIdGlm, data_x_scalar_parameters) {
+  Matrix<double, Dynamic, Dynamic> x(3, 2);
+  x << -1.2, 0.46, -0.42, 2.4, 0.25, 0.27;
+  Matrix<double, Dynamic, 1> y(3);
+  y << 5.1, -3.2, 1.2;
+  Matrix<var, Dynamic, 1> beta(2);
+  beta << 0.3, -1.8;
+  var alpha = 0.5;
+  var sigma = 1.7;
+
+  size_t stack_size = stan::math::ChainableStack::instance().var_stack_.size();
+  var lp = stan::math::normal_id_glm_lpdf(y, x, alpha, beta, sigma);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  test::check_varis_on_stack(lp);
+  lp.grad();
+  std::vector<double> grad_fused;
+  grad_fused.push_back(alpha.adj());
+  grad_fused.push_back(beta(0).adj());
+  grad_fused.push_back(beta(1).adj());
+  grad_fused.push_back(sigma.adj());
+  stan::math::set_zero_all_adjoints();
+
+  var lp2 = stan::math::normal_lpdf(y, stan::math::add(
+      stan::math::multiply(x, beta), alpha), sigma);
+  EXPECT_FLOAT_EQ(lp2.val(), lp.val());
+  lp2.grad();
+  EXPECT_FLOAT_EQ(alpha.adj(), grad_fused[0]);
+  EXPECT_FLOAT_EQ(beta(0).adj(), grad_fused[1]);
+  EXPECT_FLOAT_EQ(beta(1).adj(), grad_fused[2]);
+  EXPECT_FLOAT_EQ(sigma.adj(), grad_fused[3]);
+
+  EXPECT_FLOAT_EQ(
+      (stan::math::normal_lpdf<true>(y, stan::math::add(
+          stan::math::multiply(x, beta), alpha), sigma).val()),
+      (stan::math::normal_id_glm_lpdf<true>(y, x, alpha, beta,
+                                            sigma).val()));
+  stan::math::recover_memory();
+}
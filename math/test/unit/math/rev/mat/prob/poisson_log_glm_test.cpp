@@ -0,0 +1,62 @@
+#include <stan/math/rev/mat.hpp>
+#include <gtest/gtest.h>
+#include <test/unit/math/rev/mat/util.hpp>
+#include <vector>
+
+using Eigen::Dynamic;
+using Eigen::Matrix;
+using stan::math::var;
+
+// parameters are x (3 x 2), alpha (3), beta (2)
+template <bool fused>
+struct poisson_log_glm_functor {
+  std::vector<int> n_;
+  explicit poisson_log_glm_functor(const std::vector<int>& n) : n_(n) { }
+
+  template <typename T>
+  T operator()(const Matrix<T, Dynamic, 1>& theta) const {
+    Matrix<T, Dynamic, Dynamic> x(3, 2);
+    for (int i = 0; i < 6; ++i)
+      x(i) = theta(i);
+    Matrix<T, Dynamic, 1> alpha = theta.segment(6, 3);
+    Matrix<T, Dynamic, 1> beta = theta.segment(9, 2);
+    if (fused)
+      return stan::math::poisson_log_glm_lpmf(n_, x, alpha, beta);
+    return stan::math::poisson_log_lpmf(
+        n_, stan::math::add(stan::math::multiply(x, beta), alpha));
+  }
+};
+
+TEST(AgradRevPoissonLogGlm, gradient_matches_poisson_log) {
+  std::vector<int> n(3);
+  n[0] = 15;
+  n[1] = 3;
+  n[2] = 0;
+  Matrix<double, Dynamic, 1> theta(11);
+  theta << -1.2, 0.46, -0.42, 2.4, 0.25, 0.27,  0.5, -0.7, 2,  0.3, 0.8;
+  double f_fused, f;
+  Matrix<double, Dynamic, 1> grad_fused, grad;
+  stan::math::gradient(poisson_log_glm_functor<true>(n), theta, f_fused,
+                       grad_fused);
+  stan::math::gradient(poisson_log_glm_functor<false>(n), theta, f, grad);
+  EXPECT_FLOAT_EQ(f, f_fused);
+  for (int i = 0; i < theta.size(); ++i)
+    EXPECT_FLOAT_EQ(grad(i), grad_fused(i)) << i;
+}
+
+TEST(AgradRevPoissonLogGlm, one_vari) {
+  std::vector<int> n(3, 2);
+  Matrix<double, Dynamic, Dynamic> x(3, 2);
+  x << -1.2, 0.46, -0.42, 2.4, 0.25, 0.27;
+  Matrix<var, Dynamic, 1> beta(2);
+  beta << 0.3, -1.8;
+  Matrix<double, Dynamic, 1> alpha(3);
+  alpha << 0.1, 0.2, 0.3;
+
+  size_t stack_size = stan::math::ChainableStack::instance().var_stack_.size();
+  var lp = stan::math::poisson_log_glm_lpmf(n, x, alpha, beta);
+  EXPECT_EQ(stack_size + 1,
+            stan::math::ChainableStack::instance().var_stack_.size());
+  test::check_varis_on_stack(lp);
+  stan::math::recover_memory();
+}
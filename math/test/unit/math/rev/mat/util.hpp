@@ -11,7 +11,7 @@ namespace test {
   void check_varis_on_stack(const Eigen::Matrix<stan::math::var, R, C>& x) {
     for (int j = 0; j < x.cols(); ++j)
       for (int i = 0; i < x.rows(); ++i) 
-        EXPECT_TRUE(stan::math::ChainableStack::memalloc_.in_stack(x(i, j).vi_))
+        EXPECT_TRUE(stan::math::ChainableStack::instance().memalloc_.in_stack(x(i, j).vi_))
           << i << ", " << j << " is not on the stack";
   }
 
@@ -45,21 +45,21 @@ TEST(AgradRevErrorHandlingScalar, CheckLessOrEqualVarCheckUnivariate) {
   const std::string function = "check_less_or_equal";
   var a(5.0);
 
-  size_t stack_size = stan::math::ChainableStack::var_stack_.size();
+  size_t stack_size = stan::math::ChainableStack::instance().var_stack_.size();
 
   EXPECT_EQ(1U,stack_size);
   EXPECT_THROW(check_less_or_equal(function,"a",a,2.0),std::domain_error);
 
-  size_t stack_size_after_call = stan::math::ChainableStack::var_stack_.size();
+  size_t stack_size_after_call = stan::math::ChainableStack::instance().var_stack_.size();
   EXPECT_EQ(1U,stack_size_after_call);
 
   EXPECT_NO_THROW(check_less_or_equal(function,"a",a,5.0));
 
-  stack_size_after_call = stan::math::ChainableStack::var_stack_.size();
+  stack_size_after_call = stan::math::ChainableStack::instance().var_stack_.size();
   EXPECT_EQ(1U,stack_size_after_call);
 
   EXPECT_NO_THROW(check_less_or_equal(function,"a",a,10.0));
-  stack_size_after_call = stan::math::ChainableStack::var_stack_.size();
+  stack_size_after_call = stan::math::ChainableStack::instance().var_stack_.size();
   EXPECT_EQ(1U,stack_size_after_call);
 
   stan::math::recover_memory();
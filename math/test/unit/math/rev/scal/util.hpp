@@ -7,7 +7,7 @@
 namespace test {
 
   void check_varis_on_stack(const stan::math::var& x) {
-    EXPECT_TRUE(stan::math::ChainableStack::memalloc_.in_stack(x.vi_))
+    EXPECT_TRUE(stan::math::ChainableStack::instance().memalloc_.in_stack(x.vi_))
       << "not on the stack";
   }
   
@@ -46,6 +46,7 @@
 #include <stan/math/fwd/mat/functor/gradient.hpp>
 #include <stan/math/fwd/mat/functor/hessian.hpp>
 #include <stan/math/fwd/mat/functor/jacobian.hpp>
+#include <stan/math/fwd/mat/functor/ode_forward_jacobian.hpp>
 
 #include <stan/math/fwd/mat/meta/operands_and_partials.hpp>
 
@@ -0,0 +1,105 @@
+#ifndef STAN_MATH_FWD_MAT_FUNCTOR_ODE_FORWARD_JACOBIAN_HPP
+#define STAN_MATH_FWD_MAT_FUNCTOR_ODE_FORWARD_JACOBIAN_HPP
+
+#include <stan/math/fwd/core.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/arr/functor/ode_with_jacobian.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Jacobian functor for ode_with_jacobian which computes the
+     * Jacobian of the right hand side of an ODE system with forward
+     * mode autodiff.
+     *
+     * Each column is the directional derivative of the right hand
+     * side along one state or parameter and takes a single
+     * evaluation of the base functor on <code>fvar<double></code>
+     * arguments.  No expression graph is built, so there is no
+     * nested reverse mode stack to set up, sweep once per equation
+     * and recover on every call.  The base functor must be callable
+     * with <code>fvar<double></code> states and parameters.
+     *
+     * @tparam F type of functor for the base ode system.
+     */
+    template <typename F>
+    struct ode_forward_jacobian {
+      const F f_;
+
+      /**
+       * Construct the Jacobian functor for the specified base
+       * functor, which is copied.
+       *
+       * @param[in] f the base ODE system functor.
+       */
+      explicit ode_forward_jacobian(const F& f) : f_(f) { }
+
+      /**
+       * Assign the Jacobians of the right hand side of the ODE
+       * system with respect to the states and the parameters.
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[in] theta parameters.
+       * @param[in] x real data.
+       * @param[in] x_int integer data.
+       * @param[in, out] msgs stream to which messages are printed.
+       * @param[out] Jy N x N Jacobian with respect to the states.
+       * @param[out] Jtheta N x M Jacobian with respect to the
+       * parameters.
+       * @throw std::invalid_argument if the base functor does not
+       * return as many derivatives as there are states.
+       */
+      inline void operator()(double t, const std::vector<double>& y,
+                             const std::vector<double>& theta,
+                             const std::vector<double>& x,
+                             const std::vector<int>& x_int,
+                             std::ostream* msgs,
+                             Eigen::MatrixXd& Jy,
+                             Eigen::MatrixXd& Jtheta) const {
+        using std::vector;
+        const size_t N = y.size();
+        const size_t M = theta.size();
+        vector<fvar<double> > y_fvar(y.begin(), y.end());
+        vector<fvar<double> > theta_fvar(theta.begin(), theta.end());
+        for (size_t j = 0; j < N + M; ++j) {
+          fvar<double>& z_j = j < N ? y_fvar[j] : theta_fvar[j - N];
+          z_j.d_ = 1;
+          vector<fvar<double> > dy_dt_fvar
+            = f_(t, y_fvar, theta_fvar, x, x_int, msgs);
+          z_j.d_ = 0;
+          check_size_match("ode_forward_jacobian", "dy_dt",
+                           dy_dt_fvar.size(), "states", N);
+          for (size_t i = 0; i < N; ++i) {
+            if (j < N)
+              Jy(i, j) = dy_dt_fvar[i].d_;
+            else
+              Jtheta(i, j - N) = dy_dt_fvar[i].d_;
+          }
+        }
+      }
+    };
+
+    /**
+     * Return the specified ODE system functor paired with a
+     * Jacobian computed by forward mode autodiff, for use when no
+     * analytic Jacobian is available.
+     *
+     * @tparam F type of functor for the base ode system.
+     * @param[in] f the base ODE system functor.
+     * @return ODE system with the forward mode Jacobian.
+     */
+    template <typename F>
+    inline ode_with_jacobian<F, ode_forward_jacobian<F> >
+    make_ode_with_jacobian(const F& f) {
+      return ode_with_jacobian<F, ode_forward_jacobian<F> >
+        (f, ode_forward_jacobian<F>(f));
+    }
+
+  }
+}
+#endif
@@ -18,7 +18,8 @@ namespace stan {
           : partial_(0), partials_(partial_), operand_(op) {}
 
       private:
-        template<typename, typename, typename, typename, typename>
+        template<typename, typename, typename, typename, typename,
+                 typename>
         friend class stan::math::operands_and_partials;
         const Op& operand_;
 
@@ -52,18 +53,20 @@ namespace stan {
      * @tparam Op2 type of the second operand
      * @tparam Op3 type of the third operand
      * @tparam Op4 type of the fourth operand
+     * @tparam Op5 type of the fifth operand
      * @tparam T_return_type return type of the expression. This defaults
      *   to a template metaprogram that calculates the scalar promotion of
-     *   Op1 -- Op4
+     *   Op1 -- Op5
      */
     template <typename Op1, typename Op2, typename Op3, typename Op4,
-              typename Dx>
-    class operands_and_partials<Op1, Op2, Op3, Op4, fvar<Dx> > {
+              typename Op5, typename Dx>
+    class operands_and_partials<Op1, Op2, Op3, Op4, Op5, fvar<Dx> > {
     public:
       internal::ops_partials_edge<Dx, Op1> edge1_;
       internal::ops_partials_edge<Dx, Op2> edge2_;
       internal::ops_partials_edge<Dx, Op3> edge3_;
       internal::ops_partials_edge<Dx, Op4> edge4_;
+      internal::ops_partials_edge<Dx, Op5> edge5_;
       typedef fvar<Dx> T_return_type;
       explicit operands_and_partials(const Op1& o1)
         : edge1_(o1) { }
@@ -74,6 +77,9 @@ namespace stan {
       operands_and_partials(const Op1& o1, const Op2& o2, const Op3& o3,
                             const Op4& o4)
         : edge1_(o1), edge2_(o2), edge3_(o3), edge4_(o4) { }
+      operands_and_partials(const Op1& o1, const Op2& o2, const Op3& o3,
+                            const Op4& o4, const Op5& o5)
+        : edge1_(o1), edge2_(o2), edge3_(o3), edge4_(o4), edge5_(o5) { }
 
       /**
        * Build the node to be stored on the autodiff graph.
@@ -89,7 +95,8 @@ namespace stan {
        * @return the value with its derivative
        */
       T_return_type build(Dx value) {
-        Dx deriv = edge1_.dx() + edge2_.dx() + edge3_.dx() + edge4_.dx();
+        Dx deriv = edge1_.dx() + edge2_.dx() + edge3_.dx() + edge4_.dx()
+          + edge5_.dx();
         return T_return_type(value, deriv);
       }
     };
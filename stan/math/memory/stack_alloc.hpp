@@ -64,6 +64,12 @@ namespace stan {
      * recovered, with the blocks being reused, or all blocks may be
      * freed, resetting the stack of blocks to its original state.
      *
+     * When all memory is recovered while more than one block is
+     * held, the blocks are replaced by a single block holding all of
+     * their bytes.  Repeating the same computation, such as a
+     * gradient evaluation, then runs in the first block without
+     * further calls to <code>malloc()</code>.
+     *
      * Alignment up to 8 byte boundaries guaranteed for the first malloc,
      * and after that it's up to the caller.  On 64-bit architectures,
      * all struct values should be padded to 8-byte boundaries if they
@@ -78,6 +84,7 @@ namespace stan {
       char* cur_block_end_;        // ptr to cur_block_ptr_ + sizes_[cur_block_]
       char* next_loc_;             // ptr to next available spot in cur
                                    // block
+      size_t peak_bytes_used_;     // max of bytes_used() at recoveries
       // next three for keeping track of nested allocations on top of stack:
       std::vector<size_t> nested_cur_blocks_;
       std::vector<char*> nested_next_locs_;
@@ -115,6 +122,30 @@ namespace stan {
         return result;
       }
 
+      /**
+       * Replace all blocks by a single block of their total size.
+       * Only valid when no memory is in use.
+       */
+      void coalesce_blocks() {
+        size_t total = bytes_reserved();
+        char* block = eight_byte_aligned_malloc(total);
+        if (!block)
+          return;  // keep the existing blocks
+        for (size_t i = 0; i < blocks_.size(); ++i)
+          free(blocks_[i]);
+        blocks_.assign(1, block);
+        sizes_.assign(1, total);
+      }
+
+      /**
+       * Record the number of bytes in use if it is the largest so far.
+       */
+      void update_peak_bytes_used() {
+        size_t used = bytes_used();
+        if (used > peak_bytes_used_)
+          peak_bytes_used_ = used;
+      }
+
     public:
       /**
        * Construct a resizable stack allocator initially holding the
@@ -130,7 +161,8 @@ namespace stan {
         sizes_(1, initial_nbytes),
         cur_block_(0),
         cur_block_end_(blocks_[0] + initial_nbytes),
-        next_loc_(blocks_[0]) {
+        next_loc_(blocks_[0]),
+        peak_bytes_used_(0) {
         if (!blocks_[0])
           throw std::bad_alloc();  // no msg allowed in bad_alloc ctor
       }
@@ -191,6 +223,9 @@ namespace stan {
        * function free_all().
        */
       inline void recover_all() {
+        update_peak_bytes_used();
+        if (unlikely(blocks_.size() > 1))
+          coalesce_blocks();
         cur_block_ = 0;
         next_loc_ = blocks_[0];
         cur_block_end_ = next_loc_ + sizes_[0];
@@ -210,6 +245,7 @@ namespace stan {
        * recover memory back to the last start_nested call.
        */
       inline void recover_nested() {
+        update_peak_bytes_used();
         if (unlikely(nested_cur_blocks_.empty()))
           recover_all();
 
@@ -221,6 +257,12 @@ namespace stan {
 
         cur_block_end_ = nested_cur_block_ends_.back();
         nested_cur_block_ends_.pop_back();
+
+        // outermost nesting started on an empty allocator, as in
+        // gradient(), so nothing is in use any more
+        if (unlikely(nested_cur_blocks_.empty() && next_loc_ == blocks_[0]
+                     && blocks_.size() > 1))
+          recover_all();
       }
 
       /**
@@ -229,12 +271,15 @@ namespace stan {
        * destructor will free all memory.
        */
       inline void free_all() {
+        update_peak_bytes_used();
         // frees all BUT the first (index 0) block
         for (size_t i = 1; i < blocks_.size(); ++i)
           if (blocks_[i])
             free(blocks_[i]);
         sizes_.resize(1);
         blocks_.resize(1);
+        cur_block_ = 0;
+        next_loc_ = blocks_[0];
         recover_all();
       }
 
@@ -256,6 +301,53 @@ namespace stan {
         return sum;
       }
 
+      /**
+       * Return the number of bytes in use, counting the unused ends
+       * of all blocks before the current one.
+       *
+       * @return number of bytes in use
+       */
+      inline size_t bytes_used() const {
+        size_t sum = next_loc_ - blocks_[cur_block_];
+        for (size_t i = 0; i < cur_block_; ++i)
+          sum += sizes_[i];
+        return sum;
+      }
+
+      /**
+       * Return the largest number of bytes in use, as reported by
+       * <code>bytes_used()</code>, over the lifetime of this
+       * allocator.
+       *
+       * @return peak number of bytes in use
+       */
+      inline size_t peak_bytes_used() const {
+        size_t used = bytes_used();
+        return used > peak_bytes_used_ ? used : peak_bytes_used_;
+      }
+
+      /**
+       * Return the total number of bytes of all blocks held by this
+       * allocator, whether in use or not.
+       *
+       * @return number of bytes obtained from the heap
+       */
+      inline size_t bytes_reserved() const {
+        size_t sum = 0;
+        for (size_t i = 0; i < sizes_.size(); ++i)
+          sum += sizes_[i];
+        return sum;
+      }
+
+      /**
+       * Return the number of blocks held by this allocator.
+       *
+       * @return number of blocks
+       */
+      inline size_t num_blocks() const {
+        return blocks_.size();
+      }
+
       /**
        * Indicates whether the memory in the pointer
        * is in the stack.
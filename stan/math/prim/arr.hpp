@@ -36,6 +36,7 @@
 #include <stan/math/prim/arr/functor/coupled_ode_observer.hpp>
 #include <stan/math/prim/arr/functor/coupled_ode_system.hpp>
 #include <stan/math/prim/arr/functor/integrate_ode_rk45.hpp>
+#include <stan/math/prim/arr/functor/ode_with_jacobian.hpp>
 
 #include <stan/math/prim/scal.hpp>
 
@@ -0,0 +1,100 @@
+#ifndef STAN_MATH_PRIM_ARR_FUNCTOR_ODE_WITH_JACOBIAN_HPP
+#define STAN_MATH_PRIM_ARR_FUNCTOR_ODE_WITH_JACOBIAN_HPP
+
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * ODE system functor paired with a functor for the Jacobian of
+     * its right hand side.
+     *
+     * The object is a drop-in replacement for the base functor in
+     * integrate_ode_rk45(), integrate_ode_bdf() and
+     * integrate_ode_adjoint().  Wherever the solvers need the
+     * Jacobian of the right hand side they call the Jacobian functor
+     * rather than re-running the base functor on autodiff variables
+     * and sweeping the expression graph once per equation.
+     *
+     * The Jacobian functor must have the signature
+     *
+     * <code>
+     * void operator()(double t, const std::vector<double>& y,
+     *                 const std::vector<double>& theta,
+     *                 const std::vector<double>& x,
+     *                 const std::vector<int>& x_int,
+     *                 std::ostream* msgs,
+     *                 Eigen::MatrixXd& Jy,
+     *                 Eigen::MatrixXd& Jtheta) const;
+     * </code>
+     *
+     * and assign the N x N Jacobian with respect to the states to
+     * <code>Jy</code> and the N x M Jacobian with respect to the
+     * parameters to <code>Jtheta</code> (N states, M parameters).
+     * Both matrices are passed in with the correct sizes.
+     * ode_forward_jacobian computes them with forward mode autodiff
+     * when no analytic expression is at hand.
+     *
+     * @tparam F type of functor for the base ode system.
+     * @tparam F_jac type of functor for the Jacobian.
+     */
+    template <typename F, typename F_jac>
+    struct ode_with_jacobian {
+      const F f_;
+      const F_jac jac_;
+
+      /**
+       * Construct the system from the base functor and the Jacobian
+       * functor, both of which are copied.
+       *
+       * @param[in] f the base ODE system functor.
+       * @param[in] jac the Jacobian functor.
+       */
+      ode_with_jacobian(const F& f, const F_jac& jac)
+        : f_(f), jac_(jac) { }
+
+      /**
+       * Return the right hand side of the base ODE system.
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[in] theta parameters.
+       * @param[in] x real data.
+       * @param[in] x_int integer data.
+       * @param[in, out] msgs stream to which messages are printed.
+       * @return time derivative of the state.
+       */
+      template <typename T0, typename T1, typename T2>
+      inline std::vector<typename stan::return_type<T1, T2>::type>
+      operator()(const T0& t,
+                 const std::vector<T1>& y,
+                 const std::vector<T2>& theta,
+                 const std::vector<double>& x,
+                 const std::vector<int>& x_int,
+                 std::ostream* msgs) const {
+        return f_(t, y, theta, x, x_int, msgs);
+      }
+    };
+
+    /**
+     * Return the specified ODE system functor paired with the
+     * specified functor for the Jacobian of its right hand side.
+     *
+     * @tparam F type of functor for the base ode system.
+     * @tparam F_jac type of functor for the Jacobian.
+     * @param[in] f the base ODE system functor.
+     * @param[in] jac the Jacobian functor.
+     * @return ODE system with the Jacobian.
+     */
+    template <typename F, typename F_jac>
+    inline ode_with_jacobian<F, F_jac>
+    make_ode_with_jacobian(const F& f, const F_jac& jac) {
+      return ode_with_jacobian<F, F_jac>(f, jac);
+    }
+
+  }
+}
+#endif
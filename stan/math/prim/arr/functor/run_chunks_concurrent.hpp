@@ -0,0 +1,128 @@
+#ifndef STAN_MATH_PRIM_ARR_FUNCTOR_RUN_CHUNKS_CONCURRENT_HPP
+#define STAN_MATH_PRIM_ARR_FUNCTOR_RUN_CHUNKS_CONCURRENT_HPP
+
+#include <boost/lexical_cast.hpp>
+#include <cstdlib>
+#include <exception>
+#include <future>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stan {
+  namespace math {
+    namespace internal {
+
+      /**
+       * Return the number of threads that may be used for the
+       * specified number of independent jobs.
+       *
+       * The number of threads is read from the environment variable
+       * <code>STAN_NUM_THREADS</code>.  If it is not set, one thread
+       * is used; the value -1 requests one thread per core.  The
+       * result never exceeds the number of jobs.  Unless Stan is
+       * compiled with <code>STAN_THREADS</code>, a single thread is
+       * always used since the autodiff stack is then shared.
+       *
+       * @param num_jobs number of jobs
+       * @return number of threads to use
+       * @throw std::invalid_argument if <code>STAN_NUM_THREADS</code>
+       *   is not a positive integer or -1
+       */
+      inline int get_num_threads(int num_jobs) {
+        int num_threads = 1;
+#ifdef STAN_THREADS
+        const char* env_stan_num_threads = std::getenv("STAN_NUM_THREADS");
+        if (env_stan_num_threads != 0) {
+          try {
+            const int env_num_threads
+              = boost::lexical_cast<int>(env_stan_num_threads);
+            if (env_num_threads > 0)
+              num_threads = env_num_threads;
+            else if (env_num_threads == -1)
+              num_threads = std::thread::hardware_concurrency();
+            else
+              throw std::invalid_argument("");
+          } catch (...) {
+            throw std::invalid_argument(
+                std::string("get_num_threads: STAN_NUM_THREADS must be a"
+                            " positive number or -1, found ")
+                + env_stan_num_threads);
+          }
+        }
+#endif
+        if (num_threads > num_jobs)
+          num_threads = num_jobs;
+        if (num_threads < 1)
+          num_threads = 1;
+        return num_threads;
+      }
+
+      /**
+       * Run the specified number of independent jobs, split into
+       * consecutive chunks which run on up to
+       * <code>get_num_threads()</code> threads.
+       *
+       * The chunk functor is called as
+       * <code>execute_chunk(start, size, out)</code> and must run
+       * the jobs <code>start</code> to <code>start + size - 1</code>,
+       * writing messages to <code>out</code>.  The first chunk runs
+       * on the calling thread.  With more than one thread, messages
+       * are buffered per chunk and appended to <code>msgs</code> in
+       * job order, and the first exception thrown by any chunk is
+       * rethrown after all chunks have finished.
+       *
+       * @tparam F type of chunk functor
+       * @param num_jobs number of jobs
+       * @param execute_chunk chunk functor
+       * @param msgs stream for messages of the jobs
+       */
+      template <typename F>
+      void run_chunks_concurrent(int num_jobs, const F& execute_chunk,
+                                 std::ostream* msgs) {
+        const int num_threads = get_num_threads(num_jobs);
+        if (num_threads <= 1) {
+          execute_chunk(0, num_jobs, msgs);
+          return;
+        }
+        const int num_jobs_per_thread = num_jobs / num_threads;
+        std::vector<std::stringstream> chunk_msgs(num_threads);
+        std::vector<std::future<void> > futures;
+        futures.reserve(num_threads - 1);
+        int start = num_jobs_per_thread;
+        for (int t = 1; t < num_threads; ++t) {
+          const int size = num_jobs_per_thread
+            + (t <= num_jobs % num_threads ? 1 : 0);
+          futures.emplace_back(std::async(std::launch::async,
+                                          execute_chunk, start, size,
+                                          &chunk_msgs[t]));
+          start += size;
+        }
+        std::exception_ptr first_exception;
+        try {
+          execute_chunk(0, num_jobs_per_thread, &chunk_msgs[0]);
+        } catch (...) {
+          first_exception = std::current_exception();
+        }
+        for (size_t t = 0; t < futures.size(); ++t) {
+          try {
+            futures[t].get();
+          } catch (...) {
+            if (!first_exception)
+              first_exception = std::current_exception();
+          }
+        }
+        if (msgs)
+          for (int t = 0; t < num_threads; ++t)
+            *msgs << chunk_msgs[t].str();
+        if (first_exception)
+          std::rethrow_exception(first_exception);
+      }
+
+    }
+  }
+}
+#endif
@@ -1,6 +1,7 @@
 #ifndef STAN_MATH_PRIM_MAT_FUN_AUTOCORRELATION_HPP
 #define STAN_MATH_PRIM_MAT_FUN_AUTOCORRELATION_HPP
 
+#include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/fun/mean.hpp>
 #include <unsupported/Eigen/FFT>
 #include <complex>
@@ -124,6 +125,51 @@ namespace stan {
       return autocorrelation(y, ac, fft);
     }
 
+
+    /**
+     * Write autocorrelation estimates for every lag for the specified
+     * input sequence into the specified result using the specified
+     * FFT engine.  The result is resized to the length of the input
+     * sequence with lags given by index.
+     *
+     * <p>The input may be any Eigen vector expression, such as a
+     * column block of a matrix, so no copy of the sequence is needed.
+     * Only half of the spectrum of the real signal is transformed.
+     *
+     * @tparam T Scalar type.
+     * @tparam Derived Type of input sequence.
+     * @param y Input sequence.
+     * @param ac Autocorrelations.
+     * @param fft FFT engine instance.
+     */
+    template <typename T, typename Derived>
+    void autocorrelation(const Eigen::MatrixBase<Derived>& y,
+                         Eigen::Matrix<T, Eigen::Dynamic, 1>& ac,
+                         Eigen::FFT<T>& fft) {
+      size_t N = y.size();
+      size_t M = fft_next_good_size(N);
+      size_t Mt2 = 2 * M;
+
+      // centered_signal = y-mean(y) followed by zeroes
+      Eigen::Matrix<T, Eigen::Dynamic, 1> centered_signal(Mt2);
+      centered_signal.setZero();
+      centered_signal.head(N) = y.array() - y.mean();
+
+      Eigen::Matrix<std::complex<T>, Eigen::Dynamic, 1> freqvec;
+      fft.SetFlag(Eigen::FFT<T>::HalfSpectrum);
+      fft.fwd(freqvec, centered_signal);
+      for (int i = 0; i < freqvec.size(); ++i)
+        freqvec(i) = std::complex<T>(norm(freqvec(i)), 0.0);
+
+      Eigen::Matrix<T, Eigen::Dynamic, 1> ac_tmp;
+      fft.inv(ac_tmp, freqvec, Mt2);
+      fft.ClearFlag(Eigen::FFT<T>::HalfSpectrum);
+
+      for (size_t i = 0; i < N; ++i)
+        ac_tmp(i) /= (N - i);
+      ac = ac_tmp.head(N) / ac_tmp(0);
+    }
+
   }
 }
 #endif
@@ -63,6 +63,32 @@ namespace stan {
       autocovariance(y, acov, fft);
     }
 
+
+    /**
+     * Write autocovariance estimates for every lag for the specified
+     * input sequence into the specified result using the specified
+     * FFT engine.  The result is resized to the length of the input
+     * sequence with lags given by index.
+     *
+     * <p>The input may be any Eigen vector expression, such as a
+     * column block of a matrix, so no copy of the sequence is needed.
+     *
+     * @tparam T Scalar type.
+     * @tparam Derived Type of input sequence.
+     * @param y Input sequence.
+     * @param acov Autocovariances.
+     * @param fft FFT engine instance.
+     */
+    template <typename T, typename Derived>
+    void autocovariance(const Eigen::MatrixBase<Derived>& y,
+                        Eigen::Matrix<T, Eigen::Dynamic, 1>& acov,
+                        Eigen::FFT<T>& fft) {
+      autocorrelation(y, acov, fft);
+
+      T var = (y.array() - y.mean()).square().sum() / y.size();
+      acov *= var;
+    }
+
   }
 }
 #endif
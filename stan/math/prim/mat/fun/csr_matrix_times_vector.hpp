@@ -1,6 +1,9 @@
 #ifndef STAN_MATH_PRIM_MAT_FUN_CSR_MATRIX_TIMES_VECTOR_HPP
 #define STAN_MATH_PRIM_MAT_FUN_CSR_MATRIX_TIMES_VECTOR_HPP
 
+#include <stan/math/prim/mat/fun/csr_extract_u.hpp>
+#include <stan/math/prim/mat/fun/csr_extract_v.hpp>
+#include <stan/math/prim/mat/fun/csr_extract_w.hpp>
 #include <stan/math/prim/mat/fun/csr_u_to_z.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/fun/dot_product.hpp>
@@ -114,6 +117,29 @@ namespace stan {
       }
       return result;
     }
+
+    /**
+     * Return the multiplication of the specified sparse matrix by
+     * the specified dense vector.
+     *
+     * @tparam T1 Type of sparse matrix entries.
+     * @tparam T2 Type of dense vector entries.
+     * @param A Sparse matrix in row major storage.
+     * @param b Eigen vector which the matrix is multiplied by.
+     * @return Dense vector for the product.
+     * @throw std::invalid_argument if the columns of A do not match
+     *   the size of b.
+     */
+    template <typename T1, typename T2>
+    inline
+    Eigen::Matrix<typename boost::math::tools::promote_args<T1, T2>::type,
+                  Eigen::Dynamic, 1>
+    csr_matrix_times_vector(const Eigen::SparseMatrix<T1,
+                                                      Eigen::RowMajor>& A,
+                            const Eigen::Matrix<T2, Eigen::Dynamic, 1>& b) {
+      return csr_matrix_times_vector(A.rows(), A.cols(), csr_extract_w(A),
+                                     csr_extract_v(A), csr_extract_u(A), b);
+    }
     /** @}*/   // end of csr_format group
 
   }
@@ -0,0 +1,187 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_GP_DOT_PROD_COV_HPP
+#define STAN_MATH_PRIM_MAT_FUN_GP_DOT_PROD_COV_HPP
+
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/dot_product.hpp>
+#include <stan/math/prim/mat/meta/get.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/mat/meta/is_vector_like.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/fun/square.hpp>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns a dot product covariance matrix of real inputs,
+     *
+     * <code>k(x, x') = sigma^2 + x x'</code>.
+     *
+     * @tparam T_x type of elements
+     * @tparam T_sigma type of sigma
+     *
+     * @param x std::vector of real inputs
+     * @param sigma standard deviation of the constant term
+     * @return covariance matrix
+     * @throw std::domain_error if sigma < 0 or sigma or x are nan
+     *   or infinite
+     */
+    template<typename T_x, typename T_sigma>
+    inline typename
+    Eigen::Matrix<typename stan::return_type<T_x, T_sigma>::type,
+                  Eigen::Dynamic, Eigen::Dynamic>
+    gp_dot_prod_cov(const std::vector<T_x>& x,
+                    const T_sigma& sigma) {
+      check_nonnegative("gp_dot_prod_cov", "sigma", sigma);
+      check_finite("gp_dot_prod_cov", "sigma", sigma);
+      for (size_t n = 0; n < x.size(); ++n)
+        check_finite("gp_dot_prod_cov", "x", x[n]);
+
+      int x_size = x.size();
+      Eigen::Matrix<typename stan::return_type<T_x, T_sigma>::type,
+                    Eigen::Dynamic, Eigen::Dynamic>
+        cov(x_size, x_size);
+
+      T_sigma sigma_sq = square(sigma);
+      for (int j = 0; j < x_size; ++j) {
+        for (int i = j; i < x_size; ++i) {
+          cov(i, j) = sigma_sq + x[i] * x[j];
+          cov(j, i) = cov(i, j);
+        }
+      }
+      return cov;
+    }
+
+    /**
+     * Returns a dot product covariance matrix of vector inputs,
+     *
+     * <code>k(x, x') = sigma^2 + x^T x'</code>.
+     *
+     * @tparam T_x type of the elements of the vectors
+     * @tparam R number of rows, can be Eigen::Dynamic
+     * @tparam C number of columns, can be Eigen::Dynamic
+     * @tparam T_sigma type of sigma
+     *
+     * @param x std::vector of vectors of the same size
+     * @param sigma standard deviation of the constant term
+     * @return covariance matrix
+     * @throw std::domain_error if sigma < 0 or sigma or x are nan
+     *   or infinite
+     */
+    template<typename T_x, int R, int C, typename T_sigma>
+    inline typename
+    Eigen::Matrix<typename stan::return_type<T_x, T_sigma>::type,
+                  Eigen::Dynamic, Eigen::Dynamic>
+    gp_dot_prod_cov(const std::vector<Eigen::Matrix<T_x, R, C> >& x,
+                    const T_sigma& sigma) {
+      check_nonnegative("gp_dot_prod_cov", "sigma", sigma);
+      check_finite("gp_dot_prod_cov", "sigma", sigma);
+      for (size_t n = 0; n < x.size(); ++n)
+        check_finite("gp_dot_prod_cov", "x", x[n]);
+
+      int x_size = x.size();
+      Eigen::Matrix<typename stan::return_type<T_x, T_sigma>::type,
+                    Eigen::Dynamic, Eigen::Dynamic>
+        cov(x_size, x_size);
+
+      T_sigma sigma_sq = square(sigma);
+      for (int j = 0; j < x_size; ++j) {
+        for (int i = j; i < x_size; ++i) {
+          cov(i, j) = sigma_sq + dot_product(x[i], x[j]);
+          cov(j, i) = cov(i, j);
+        }
+      }
+      return cov;
+    }
+
+    /**
+     * Returns a dot product cross covariance matrix between two sets
+     * of real inputs.
+     *
+     * @tparam T_x1 type of first elements
+     * @tparam T_x2 type of second elements
+     * @tparam T_sigma type of sigma
+     *
+     * @param x1 std::vector of real inputs
+     * @param x2 std::vector of real inputs
+     * @param sigma standard deviation of the constant term
+     * @return cross covariance matrix
+     * @throw std::domain_error if sigma < 0 or sigma or x are nan
+     *   or infinite
+     */
+    template<typename T_x1, typename T_x2, typename T_sigma>
+    inline typename
+    Eigen::Matrix<typename stan::return_type<T_x1, T_x2, T_sigma>::type,
+                  Eigen::Dynamic, Eigen::Dynamic>
+    gp_dot_prod_cov(const std::vector<T_x1>& x1,
+                    const std::vector<T_x2>& x2,
+                    const T_sigma& sigma) {
+      check_nonnegative("gp_dot_prod_cov", "sigma", sigma);
+      check_finite("gp_dot_prod_cov", "sigma", sigma);
+      for (size_t n = 0; n < x1.size(); ++n)
+        check_finite("gp_dot_prod_cov", "x1", x1[n]);
+      for (size_t n = 0; n < x2.size(); ++n)
+        check_finite("gp_dot_prod_cov", "x2", x2[n]);
+
+      Eigen::Matrix<typename stan::return_type<T_x1, T_x2, T_sigma>::type,
+                    Eigen::Dynamic, Eigen::Dynamic>
+        cov(x1.size(), x2.size());
+
+      T_sigma sigma_sq = square(sigma);
+      for (size_t i = 0; i < x1.size(); ++i)
+        for (size_t j = 0; j < x2.size(); ++j)
+          cov(i, j) = sigma_sq + x1[i] * x2[j];
+      return cov;
+    }
+
+    /**
+     * Returns a dot product cross covariance matrix between two sets
+     * of vector inputs.
+     *
+     * @tparam T_x1 type of the elements of the first vectors
+     * @tparam R1 number of rows, can be Eigen::Dynamic
+     * @tparam C1 number of columns, can be Eigen::Dynamic
+     * @tparam T_x2 type of the elements of the second vectors
+     * @tparam R2 number of rows, can be Eigen::Dynamic
+     * @tparam C2 number of columns, can be Eigen::Dynamic
+     * @tparam T_sigma type of sigma
+     *
+     * @param x1 std::vector of vectors
+     * @param x2 std::vector of vectors of the same size as those of x1
+     * @param sigma standard deviation of the constant term
+     * @return cross covariance matrix
+     * @throw std::domain_error if sigma < 0 or sigma or x are nan
+     *   or infinite
+     */
+    template<typename T_x1, int R1, int C1, typename T_x2, int R2, int C2,
+             typename T_sigma>
+    inline typename
+    Eigen::Matrix<typename stan::return_type<T_x1, T_x2, T_sigma>::type,
+                  Eigen::Dynamic, Eigen::Dynamic>
+    gp_dot_prod_cov(const std::vector<Eigen::Matrix<T_x1, R1, C1> >& x1,
+                    const std::vector<Eigen::Matrix<T_x2, R2, C2> >& x2,
+                    const T_sigma& sigma) {
+      check_nonnegative("gp_dot_prod_cov", "sigma", sigma);
+      check_finite("gp_dot_prod_cov", "sigma", sigma);
+      for (size_t n = 0; n < x1.size(); ++n)
+        check_finite("gp_dot_prod_cov", "x1", x1[n]);
+      for (size_t n = 0; n < x2.size(); ++n)
+        check_finite("gp_dot_prod_cov", "x2", x2[n]);
+
+      Eigen::Matrix<typename stan::return_type<T_x1, T_x2, T_sigma>::type,
+                    Eigen::Dynamic, Eigen::Dynamic>
+        cov(x1.size(), x2.size());
+
+      T_sigma sigma_sq = square(sigma);
+      for (size_t i = 0; i < x1.size(); ++i)
+        for (size_t j = 0; j < x2.size(); ++j)
+          cov(i, j) = sigma_sq + dot_product(x1[i], x2[j]);
+      return cov;
+    }
+
+  }
+}
+#endif
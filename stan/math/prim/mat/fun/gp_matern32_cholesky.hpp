@@ -0,0 +1,58 @@
+#ifndef STAN_MATH_PRIM_MAT_FUN_GP_MATERN32_CHOLESKY_HPP
+#define STAN_MATH_PRIM_MAT_FUN_GP_MATERN32_CHOLESKY_HPP
+
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/cholesky_decompose.hpp>
+#include <stan/math/prim/mat/fun/gp_matern32_cov.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns the Cholesky factor of a Matern 3/2 covariance matrix
+     * with <code>delta</code> added to its diagonal.
+     *
+     * The reverse-mode specialization computes the factor and its
+     * gradient with respect to the hyperparameters on a single node,
+     * without the intermediate covariance matrix.
+     *
+     * @tparam T_x type of std::vector of elements
+     * @tparam T_sigma type of sigma
+     * @tparam T_l type of length scale
+     * @tparam T_delta type of delta
+     *
+     * @param x std::vector of elements that can be used in square distance.
+     *    This function assumes each element of x is the same size.
+     * @param sigma standard deviation
+     * @param l length scale
+     * @param delta nugget added to the diagonal
+     * @return lower triangular Cholesky factor
+     * @throw std::domain_error if sigma <= 0, l <= 0, delta < 0,
+     *   x is nan or infinite, or the covariance matrix is not
+     *   positive definite
+     */
+    template<typename T_x, typename T_sigma, typename T_l, typename T_delta>
+    inline typename
+    Eigen::Matrix<typename stan::return_type<T_x, T_sigma, T_l,
+                                             T_delta>::type,
+                  Eigen::Dynamic, Eigen::Dynamic>
+    gp_matern32_cholesky(const std::vector<T_x>& x,
+                         const T_sigma& sigma,
+                         const T_l& l,
+                         const T_delta& delta) {
+      check_nonnegative("gp_matern32_cholesky", "delta", delta);
+      Eigen::Matrix<typename stan::return_type<T_x, T_sigma, T_l,
+                                               T_delta>::type,
+                    Eigen::Dynamic, Eigen::Dynamic>
+        cov = gp_matern32_cov(x, sigma, l);
+      for (int i = 0; i < cov.rows(); ++i)
+        cov(i, i) += delta;
+      return cholesky_decompose(cov);
+    }
+
+  }
+}
+#endif
@@ -36,13 +36,14 @@ namespace stan {
      * <p>See <code>value_of(T)</code> for a polymorphic
      * implementation using static casts.
      *
-     * <p>This inline pass-through no-op should be compiled away.
+     * <p>This inline pass-through no-op should be compiled away;
+     * it returns a reference, so that no copy is made.
      *
      * @param x Specified matrix.
      * @return Specified matrix.
      */
     template <int R, int C>
-    inline typename Eigen::Matrix<double, R, C>
+    inline const Eigen::Matrix<double, R, C>&
     value_of(const Eigen::Matrix<double, R, C>& x) {
       return x;
     }
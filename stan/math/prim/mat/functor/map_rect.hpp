@@ -0,0 +1,107 @@
+#ifndef STAN_MATH_PRIM_MAT_FUNCTOR_MAP_RECT_HPP
+#define STAN_MATH_PRIM_MAT_FUNCTOR_MAP_RECT_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/arr/err/check_matching_sizes.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/mat/functor/map_rect_concurrent.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Map N function evaluations to parameters and data which are in
+     * rectangular format and return the concatenated results.
+     *
+     * Each job <code>i</code> evaluates the user functor as
+     *
+     * <code>f(shared_params, job_params[i], x_r[i], x_i[i], msgs)</code>
+     *
+     * which must return a column vector; the outputs of all jobs are
+     * concatenated in job order.  The jobs must be independent of one
+     * another.  This makes it possible to split a log density into
+     * shards which are evaluated in parallel.  If the parameters are
+     * autodiff variables, the value and the partial derivatives of
+     * each output are computed per job on a nested autodiff stack
+     * and are linked into the calling stack as precomputed gradients.
+     *
+     * The jobs are executed with
+     * <code>internal::map_rect_concurrent</code>, which uses up to
+     * <code>STAN_NUM_THREADS</code> threads when Stan is compiled with
+     * <code>STAN_THREADS</code>.
+     *
+     * The functor must be default constructible and all jobs must
+     * have the same number of job-specific parameters, real data and
+     * integer data.
+     *
+     * @tparam call_id unique identifier of the call site
+     * @tparam F type of user functor
+     * @tparam T_shared_param type of shared parameters
+     * @tparam T_job_param type of job-specific parameters
+     * @param shared_params shared parameters
+     * @param job_params job-specific parameters, one vector per job
+     * @param x_r real data, one array per job
+     * @param x_i integer data, one array per job
+     * @param msgs stream for messages of the user functor
+     * @return outputs of all jobs concatenated in job order
+     * @throw std::invalid_argument if the number of jobs of the
+     *   arguments differ or the arguments are not rectangular
+     */
+    template <int call_id, typename F,
+              typename T_shared_param, typename T_job_param>
+    Eigen::Matrix<typename stan::return_type<T_shared_param,
+                                             T_job_param>::type,
+                  Eigen::Dynamic, 1>
+    map_rect(const Eigen::Matrix<T_shared_param, Eigen::Dynamic, 1>&
+             shared_params,
+             const std::vector<Eigen::Matrix<T_job_param, Eigen::Dynamic, 1> >&
+             job_params,
+             const std::vector<std::vector<double> >& x_r,
+             const std::vector<std::vector<int> >& x_i,
+             std::ostream* msgs = 0) {
+      static const char* function = "map_rect";
+      typedef Eigen::Matrix<typename stan::return_type<T_shared_param,
+                                                       T_job_param>::type,
+                            Eigen::Dynamic, 1> return_t;
+
+      check_matching_sizes(function, "job parameters", job_params,
+                           "real data", x_r);
+      check_matching_sizes(function, "job parameters", job_params,
+                           "int data", x_i);
+
+      const int num_jobs = job_params.size();
+      if (num_jobs == 0)
+        return return_t();
+
+      const int size_job_params = job_params[0].size();
+      const int size_x_r = x_r[0].size();
+      const int size_x_i = x_i[0].size();
+      for (int i = 1; i < num_jobs; ++i) {
+        check_size_match(function,
+                         "Size of one of the vectors of the job specific "
+                         "parameters", job_params[i].size(),
+                         "size of the first vector of the job specific "
+                         "parameters", size_job_params);
+        check_size_match(function,
+                         "Size of one of the arrays of the job specific "
+                         "real data", x_r[i].size(),
+                         "size of the first array of the job specific "
+                         "real data", size_x_r);
+        check_size_match(function,
+                         "Size of one of the arrays of the job specific "
+                         "int data", x_i[i].size(),
+                         "size of the first array of the job specific "
+                         "int data", size_x_i);
+      }
+
+      return internal::map_rect_concurrent<call_id, F>(shared_params,
+                                                       job_params,
+                                                       x_r, x_i, msgs);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,60 @@
+#ifndef STAN_MATH_PRIM_MAT_FUNCTOR_MAP_RECT_COMBINE_HPP
+#define STAN_MATH_PRIM_MAT_FUNCTOR_MAP_RECT_COMBINE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <vector>
+
+namespace stan {
+  namespace math {
+    namespace internal {
+
+      /**
+       * Combines the outputs of the <code>map_rect</code> jobs into a
+       * single result vector.
+       *
+       * For <code>double</code> inputs the function values of all jobs
+       * are concatenated in job order.  The autodiff specializations
+       * in <code>stan/math/rev/mat/functor/map_rect_combine.hpp</code>
+       * additionally link the results to the parameters on the
+       * autodiff stack.
+       *
+       * @tparam T_shared_param type of shared parameters
+       * @tparam T_job_param type of job-specific parameters
+       */
+      template <typename T_shared_param, typename T_job_param>
+      class map_rect_combine {
+      public:
+        typedef Eigen::Matrix<double, Eigen::Dynamic, 1> result_t;
+
+        map_rect_combine(const Eigen::Matrix<T_shared_param,
+                                             Eigen::Dynamic, 1>&,
+                         const std::vector<Eigen::Matrix<T_job_param,
+                                                         Eigen::Dynamic, 1> >&)
+        { }
+
+        /**
+         * Concatenate the function values of the jobs.
+         *
+         * @param job_output outputs of <code>map_rect_reduce</code>
+         * @param world_f_out number of outputs of each job
+         * @return function values of all jobs
+         */
+        result_t operator()(const std::vector<Eigen::MatrixXd>& job_output,
+                            const std::vector<int>& world_f_out) const {
+          int num_outputs = 0;
+          for (size_t i = 0; i < world_f_out.size(); ++i)
+            num_outputs += world_f_out[i];
+          result_t out(num_outputs);
+          int offset = 0;
+          for (size_t i = 0; i < job_output.size(); ++i) {
+            out.segment(offset, world_f_out[i]) = job_output[i].row(0);
+            offset += world_f_out[i];
+          }
+          return out;
+        }
+      };
+
+    }
+  }
+}
+#endif
@@ -0,0 +1,81 @@
+#ifndef STAN_MATH_PRIM_MAT_FUNCTOR_MAP_RECT_CONCURRENT_HPP
+#define STAN_MATH_PRIM_MAT_FUNCTOR_MAP_RECT_CONCURRENT_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/functor/map_rect_combine.hpp>
+#include <stan/math/prim/mat/functor/map_rect_reduce.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/arr/functor/run_chunks_concurrent.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace math {
+    namespace internal {
+
+      /**
+       * Evaluates the jobs of <code>map_rect</code> in the current
+       * process, splitting them into consecutive chunks which run on
+       * up to <code>get_num_threads()</code> threads with
+       * <code>run_chunks_concurrent()</code>.
+       *
+       * Each job is reduced to its function values and, for autodiff
+       * arguments, its partial derivatives by
+       * <code>map_rect_reduce</code>, using a nested autodiff stack on
+       * the worker thread.  The results are then combined on the
+       * calling thread's stack by <code>map_rect_combine</code>.
+       * Messages written by the user functor are buffered per chunk
+       * and appended to <code>msgs</code> in job order.
+       *
+       * @tparam call_id unique identifier of the call site
+       * @tparam F type of user functor
+       * @tparam T_shared_param type of shared parameters
+       * @tparam T_job_param type of job-specific parameters
+       * @param shared_params shared parameters
+       * @param job_params job-specific parameters, one vector per job
+       * @param x_r real data, one array per job
+       * @param x_i integer data, one array per job
+       * @param msgs stream for messages of the user functor
+       * @return outputs of all jobs concatenated in job order
+       */
+      template <int call_id, typename F,
+                typename T_shared_param, typename T_job_param>
+      Eigen::Matrix<typename stan::return_type<T_shared_param,
+                                               T_job_param>::type,
+                    Eigen::Dynamic, 1>
+      map_rect_concurrent(
+          const Eigen::Matrix<T_shared_param, Eigen::Dynamic, 1>&
+          shared_params,
+          const std::vector<Eigen::Matrix<T_job_param, Eigen::Dynamic, 1> >&
+          job_params,
+          const std::vector<std::vector<double> >& x_r,
+          const std::vector<std::vector<int> >& x_i,
+          std::ostream* msgs = 0) {
+        typedef map_rect_reduce<F, T_shared_param, T_job_param> ReduceF;
+        typedef map_rect_combine<T_shared_param, T_job_param> CombineF;
+
+        const int num_jobs = job_params.size();
+        const Eigen::VectorXd shared_params_dbl = value_of(shared_params);
+        std::vector<Eigen::MatrixXd> job_output(num_jobs);
+        std::vector<int> world_f_out(num_jobs, 0);
+
+        auto execute_chunk = [&](int start, int size, std::ostream* out) {
+          const int end = start + size;
+          for (int i = start; i != end; ++i) {
+            job_output[i] = ReduceF()(shared_params_dbl,
+                                      value_of(job_params[i]),
+                                      x_r[i], x_i[i], out);
+            world_f_out[i] = job_output[i].cols();
+          }
+        };
+
+        run_chunks_concurrent(num_jobs, execute_chunk, msgs);
+
+        return CombineF(shared_params, job_params)(job_output, world_f_out);
+      }
+
+    }
+  }
+}
+#endif
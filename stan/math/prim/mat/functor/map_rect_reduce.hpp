@@ -0,0 +1,47 @@
+#ifndef STAN_MATH_PRIM_MAT_FUNCTOR_MAP_RECT_REDUCE_HPP
+#define STAN_MATH_PRIM_MAT_FUNCTOR_MAP_RECT_REDUCE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace math {
+    namespace internal {
+
+      /**
+       * Evaluates a single job of <code>map_rect</code> on
+       * <code>double</code> inputs.
+       *
+       * The result is a matrix with one column per output of the
+       * job.  The first row holds the function values.  If the shared
+       * or job-specific parameters are autodiff variables, the
+       * following rows hold the partial derivatives of the outputs
+       * with respect to the shared and then the job-specific
+       * parameters.  The autodiff specializations are defined in
+       * <code>stan/math/rev/mat/functor/map_rect_reduce.hpp</code>.
+       *
+       * @tparam F type of user functor
+       * @tparam T_shared_param type of shared parameters
+       * @tparam T_job_param type of job-specific parameters
+       */
+      template <typename F, typename T_shared_param, typename T_job_param>
+      struct map_rect_reduce;
+
+      template <typename F>
+      struct map_rect_reduce<F, double, double> {
+        Eigen::MatrixXd
+        operator()(const Eigen::VectorXd& shared_params,
+                   const Eigen::VectorXd& job_specific_params,
+                   const std::vector<double>& x_r,
+                   const std::vector<int>& x_i,
+                   std::ostream* msgs = 0) const {
+          return F()(shared_params, job_specific_params, x_r, x_i, msgs)
+            .transpose();
+        }
+      };
+
+    }
+  }
+}
+#endif
@@ -0,0 +1,44 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_NORMAL_ID_GLM_LOG_HPP
+#define STAN_MATH_PRIM_MAT_PROB_NORMAL_ID_GLM_LOG_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/prob/normal_id_glm_lpdf.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * @deprecated use <code>normal_id_glm_lpdf</code>
+     */
+    template <bool propto, typename T_y, typename T_x, typename T_alpha,
+              typename T_beta, typename T_scale>
+    typename return_type<T_y, T_x, T_alpha, T_beta, T_scale>::type
+    normal_id_glm_log(const T_y& y,
+                      const Eigen::Matrix<T_x, Eigen::Dynamic,
+                                          Eigen::Dynamic>& x,
+                      const T_alpha& alpha,
+                      const Eigen::Matrix<T_beta, Eigen::Dynamic, 1>& beta,
+                      const T_scale& sigma) {
+      return normal_id_glm_lpdf<propto>(y, x, alpha, beta, sigma);
+    }
+
+    /**
+     * @deprecated use <code>normal_id_glm_lpdf</code>
+     */
+    template <typename T_y, typename T_x, typename T_alpha, typename T_beta,
+              typename T_scale>
+    inline
+    typename return_type<T_y, T_x, T_alpha, T_beta, T_scale>::type
+    normal_id_glm_log(const T_y& y,
+                      const Eigen::Matrix<T_x, Eigen::Dynamic,
+                                          Eigen::Dynamic>& x,
+                      const T_alpha& alpha,
+                      const Eigen::Matrix<T_beta, Eigen::Dynamic, 1>& beta,
+                      const T_scale& sigma) {
+      return normal_id_glm_lpdf(y, x, alpha, beta, sigma);
+    }
+
+  }
+}
+#endif
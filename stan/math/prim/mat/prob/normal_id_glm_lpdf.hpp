@@ -0,0 +1,168 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_NORMAL_ID_GLM_LPDF_HPP
+#define STAN_MATH_PRIM_MAT_PROB_NORMAL_ID_GLM_LPDF_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/meta/is_constant_struct.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
+#include <stan/math/prim/scal/meta/partials_type.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+#include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/scal/err/check_consistent_size.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_not_nan.hpp>
+#include <stan/math/prim/scal/err/check_positive_finite.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <cmath>
+#include <string>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns the log density of the normal linear regression of the
+     * dependent variables y on the independent variables x, that is
+     * the sum of <code>normal_lpdf(y[n] | alpha[n] + x.row(n) * beta,
+     * sigma[n])</code> over the rows of x.
+     *
+     * <p>The density and its gradient are computed in a single pass
+     * with matrix-vector products of x, and only one node is put on
+     * the expression graph, rather than one for the product, one for
+     * each element of the linear predictor and one for the density.
+     *
+     * @tparam T_y type of (vector of) dependent variables
+     * @tparam T_x type of scalars of the design matrix
+     * @tparam T_alpha type of (vector of) intercepts
+     * @tparam T_beta type of scalars of the coefficients
+     * @tparam T_scale type of (vector of) scales
+     * @param y (vector of) dependent variables, one for each row of x
+     * @param x design matrix
+     * @param alpha (vector of) intercepts
+     * @param beta vector of coefficients, one for each column of x
+     * @param sigma (vector of) positive scales
+     * @return log density
+     * @throw std::domain_error if y is nan, if x, alpha or beta are
+     * not finite or if sigma is not positive and finite
+     * @throw std::invalid_argument if container sizes mismatch
+     */
+    template <bool propto, typename T_y, typename T_x, typename T_alpha,
+              typename T_beta, typename T_scale>
+    typename return_type<T_y, T_x, T_alpha, T_beta, T_scale>::type
+    normal_id_glm_lpdf(const T_y& y,
+                       const Eigen::Matrix<T_x, Eigen::Dynamic,
+                                           Eigen::Dynamic>& x,
+                       const T_alpha& alpha,
+                       const Eigen::Matrix<T_beta, Eigen::Dynamic, 1>& beta,
+                       const T_scale& sigma) {
+      static const std::string function = "normal_id_glm_lpdf";
+      typedef typename stan::partials_return_type<T_y, T_x, T_alpha,
+                                                  T_beta, T_scale>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1>
+        T_partials_vector;
+
+      using std::log;
+      using stan::is_constant_struct;
+
+      const size_t N = x.rows();
+
+      check_consistent_size(function, "Vector of dependent variables",
+                            y, N);
+      check_consistent_size(function, "Vector of intercepts", alpha, N);
+      check_consistent_size(function, "Vector of scale parameters",
+                            sigma, N);
+      check_size_match(function, "Columns of design matrix", x.cols(),
+                       "Size of coefficients", beta.size());
+      check_not_nan(function, "Vector of dependent variables", y);
+      check_finite(function, "Design matrix", x);
+      check_finite(function, "Intercept", alpha);
+      check_finite(function, "Coefficients", beta);
+      check_positive_finite(function, "Scale parameter", sigma);
+
+      if (N == 0)
+        return 0.0;
+      if (!include_summand<propto, T_y, T_x, T_alpha, T_beta,
+                           T_scale>::value)
+        return 0.0;
+
+      operands_and_partials<T_y,
+                            Eigen::Matrix<T_x, Eigen::Dynamic,
+                                          Eigen::Dynamic>,
+                            T_alpha,
+                            Eigen::Matrix<T_beta, Eigen::Dynamic, 1>,
+                            T_scale>
+        ops_partials(y, x, alpha, beta, sigma);
+
+      scalar_seq_view<T_y> y_vec(y);
+      scalar_seq_view<T_alpha> alpha_vec(alpha);
+      scalar_seq_view<T_scale> sigma_vec(sigma);
+
+      // values of x are not copied if x is data
+      const Eigen::Matrix<typename partials_type<T_x>::type,
+                          Eigen::Dynamic, Eigen::Dynamic>& x_val
+        = value_of(x);
+      const T_partials_vector beta_val
+        = value_of(beta).template cast<T_partials_return>();
+
+      // the linear predictor, overwritten by the derivatives of the
+      // log density with respect to it
+      T_partials_vector mu_derivative
+        = x_val.template cast<T_partials_return>() * beta_val;
+
+      T_partials_return logp(0.0);
+      for (size_t n = 0; n < N; n++) {
+        const T_partials_return inv_sigma = 1.0 / value_of(sigma_vec[n]);
+        const T_partials_return y_minus_mu_over_sigma
+          = (value_of(y_vec[n]) - mu_derivative(n)
+             - value_of(alpha_vec[n])) * inv_sigma;
+        const T_partials_return y_minus_mu_over_sigma_squared
+          = y_minus_mu_over_sigma * y_minus_mu_over_sigma;
+
+        if (include_summand<propto, T_scale>::value)
+          logp -= log(value_of(sigma_vec[n]));
+        logp -= 0.5 * y_minus_mu_over_sigma_squared;
+
+        mu_derivative(n) = y_minus_mu_over_sigma * inv_sigma;
+        if (!is_constant_struct<T_y>::value)
+          ops_partials.edge1_.partials_[n] -= mu_derivative(n);
+        if (!is_constant_struct<T_alpha>::value)
+          ops_partials.edge3_.partials_[n] += mu_derivative(n);
+        if (!is_constant_struct<T_scale>::value)
+          ops_partials.edge5_.partials_[n]
+            += inv_sigma * (y_minus_mu_over_sigma_squared - 1);
+      }
+      if (include_summand<propto>::value)
+        logp += NEG_LOG_SQRT_TWO_PI * N;
+
+      if (!is_constant_struct<T_x>::value)
+        ops_partials.edge2_.partials_
+          = mu_derivative * beta_val.transpose();
+      if (!is_constant_struct<T_beta>::value)
+        ops_partials.edge4_.partials_
+          = x_val.template cast<T_partials_return>().transpose()
+          * mu_derivative;
+      return ops_partials.build(logp);
+    }
+
+    template <typename T_y, typename T_x, typename T_alpha,
+              typename T_beta, typename T_scale>
+    inline
+    typename return_type<T_y, T_x, T_alpha, T_beta, T_scale>::type
+    normal_id_glm_lpdf(const T_y& y,
+                       const Eigen::Matrix<T_x, Eigen::Dynamic,
+                                           Eigen::Dynamic>& x,
+                       const T_alpha& alpha,
+                       const Eigen::Matrix<T_beta, Eigen::Dynamic, 1>& beta,
+                       const T_scale& sigma) {
+      return normal_id_glm_lpdf<false>(y, x, alpha, beta, sigma);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,43 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_POISSON_LOG_GLM_LOG_HPP
+#define STAN_MATH_PRIM_MAT_PROB_POISSON_LOG_GLM_LOG_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/prob/poisson_log_glm_lpmf.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * @deprecated use <code>poisson_log_glm_lpmf</code>
+     */
+    template <bool propto, typename T_n, typename T_x, typename T_alpha,
+              typename T_beta>
+    typename return_type<T_x, T_alpha, T_beta>::type
+    poisson_log_glm_log(const T_n& n,
+                        const Eigen::Matrix<T_x, Eigen::Dynamic,
+                                            Eigen::Dynamic>& x,
+                        const T_alpha& alpha,
+                        const Eigen::Matrix<T_beta, Eigen::Dynamic, 1>&
+                        beta) {
+      return poisson_log_glm_lpmf<propto>(n, x, alpha, beta);
+    }
+
+    /**
+     * @deprecated use <code>poisson_log_glm_lpmf</code>
+     */
+    template <typename T_n, typename T_x, typename T_alpha, typename T_beta>
+    inline
+    typename return_type<T_x, T_alpha, T_beta>::type
+    poisson_log_glm_log(const T_n& n,
+                        const Eigen::Matrix<T_x, Eigen::Dynamic,
+                                            Eigen::Dynamic>& x,
+                        const T_alpha& alpha,
+                        const Eigen::Matrix<T_beta, Eigen::Dynamic, 1>&
+                        beta) {
+      return poisson_log_glm_lpmf(n, x, alpha, beta);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,146 @@
+#ifndef STAN_MATH_PRIM_MAT_PROB_POISSON_LOG_GLM_LPMF_HPP
+#define STAN_MATH_PRIM_MAT_PROB_POISSON_LOG_GLM_LPMF_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/value_of.hpp>
+#include <stan/math/prim/mat/meta/is_constant_struct.hpp>
+#include <stan/math/prim/mat/meta/length.hpp>
+#include <stan/math/prim/scal/meta/is_constant_struct.hpp>
+#include <stan/math/prim/scal/meta/partials_return_type.hpp>
+#include <stan/math/prim/scal/meta/partials_type.hpp>
+#include <stan/math/prim/scal/meta/operands_and_partials.hpp>
+#include <stan/math/prim/scal/meta/scalar_seq_view.hpp>
+#include <stan/math/prim/scal/meta/include_summand.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/prim/scal/err/check_consistent_size.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/scal/fun/lgamma.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <cmath>
+#include <string>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns the log probability of the Poisson regression with log
+     * link of the counts n on the independent variables x, that is
+     * the sum of <code>poisson_log_lpmf(n[i] | alpha[i] + x.row(i) *
+     * beta)</code> over the rows of x.
+     *
+     * <p>The probability and its gradient are computed in a single
+     * pass with matrix-vector products of x, and only one node is put
+     * on the expression graph.
+     *
+     * @tparam T_n type of (vector of) counts
+     * @tparam T_x type of scalars of the design matrix
+     * @tparam T_alpha type of (vector of) intercepts
+     * @tparam T_beta type of scalars of the coefficients
+     * @param n (vector of) non-negative counts, one for each row of x
+     * @param x design matrix
+     * @param alpha (vector of) intercepts
+     * @param beta vector of coefficients, one for each column of x
+     * @return log probability
+     * @throw std::domain_error if n is negative or if x, alpha or beta
+     * are not finite
+     * @throw std::invalid_argument if container sizes mismatch
+     */
+    template <bool propto, typename T_n, typename T_x, typename T_alpha,
+              typename T_beta>
+    typename return_type<T_x, T_alpha, T_beta>::type
+    poisson_log_glm_lpmf(const T_n& n,
+                         const Eigen::Matrix<T_x, Eigen::Dynamic,
+                                             Eigen::Dynamic>& x,
+                         const T_alpha& alpha,
+                         const Eigen::Matrix<T_beta, Eigen::Dynamic, 1>&
+                         beta) {
+      static const std::string function = "poisson_log_glm_lpmf";
+      typedef typename stan::partials_return_type<T_n, T_x, T_alpha,
+                                                  T_beta>::type
+        T_partials_return;
+      typedef Eigen::Matrix<T_partials_return, Eigen::Dynamic, 1>
+        T_partials_vector;
+
+      using std::exp;
+      using stan::is_constant_struct;
+
+      const size_t N = x.rows();
+
+      check_consistent_size(function, "Vector of dependent variables",
+                            n, N);
+      check_consistent_size(function, "Vector of intercepts", alpha, N);
+      check_size_match(function, "Columns of design matrix", x.cols(),
+                       "Size of coefficients", beta.size());
+      check_nonnegative(function, "Vector of dependent variables", n);
+      check_finite(function, "Design matrix", x);
+      check_finite(function, "Intercept", alpha);
+      check_finite(function, "Coefficients", beta);
+
+      if (N == 0)
+        return 0.0;
+      if (!include_summand<propto, T_x, T_alpha, T_beta>::value)
+        return 0.0;
+
+      operands_and_partials<Eigen::Matrix<T_x, Eigen::Dynamic,
+                                          Eigen::Dynamic>,
+                            T_alpha,
+                            Eigen::Matrix<T_beta, Eigen::Dynamic, 1> >
+        ops_partials(x, alpha, beta);
+
+      scalar_seq_view<T_n> n_vec(n);
+      scalar_seq_view<T_alpha> alpha_vec(alpha);
+
+      // values of x are not copied if x is data
+      const Eigen::Matrix<typename partials_type<T_x>::type,
+                          Eigen::Dynamic, Eigen::Dynamic>& x_val
+        = value_of(x);
+      const T_partials_vector beta_val
+        = value_of(beta).template cast<T_partials_return>();
+
+      // the linear predictor, overwritten by the derivatives of the
+      // log probability with respect to it
+      T_partials_vector theta_derivative
+        = x_val.template cast<T_partials_return>() * beta_val;
+
+      T_partials_return logp(0.0);
+      for (size_t i = 0; i < N; i++) {
+        const T_partials_return theta
+          = theta_derivative(i) + value_of(alpha_vec[i]);
+        const T_partials_return exp_theta = exp(theta);
+
+        if (include_summand<propto>::value)
+          logp -= lgamma(n_vec[i] + 1.0);
+        logp += n_vec[i] * theta - exp_theta;
+
+        theta_derivative(i) = n_vec[i] - exp_theta;
+        if (!is_constant_struct<T_alpha>::value)
+          ops_partials.edge2_.partials_[i] += theta_derivative(i);
+      }
+
+      if (!is_constant_struct<T_x>::value)
+        ops_partials.edge1_.partials_
+          = theta_derivative * beta_val.transpose();
+      if (!is_constant_struct<T_beta>::value)
+        ops_partials.edge3_.partials_
+          = x_val.template cast<T_partials_return>().transpose()
+          * theta_derivative;
+      return ops_partials.build(logp);
+    }
+
+    template <typename T_n, typename T_x, typename T_alpha, typename T_beta>
+    inline
+    typename return_type<T_x, T_alpha, T_beta>::type
+    poisson_log_glm_lpmf(const T_n& n,
+                         const Eigen::Matrix<T_x, Eigen::Dynamic,
+                                             Eigen::Dynamic>& x,
+                         const T_alpha& alpha,
+                         const Eigen::Matrix<T_beta, Eigen::Dynamic, 1>&
+                         beta) {
+      return poisson_log_glm_lpmf<false>(n, x, alpha, beta);
+    }
+
+  }
+}
+#endif
@@ -26,6 +26,10 @@ namespace stan {
         T& operator[] (int /*i*/) {
           throw std::logic_error("Don't do this");
         }
+        template <typename Y>
+        void operator=(const Y& /*y*/) {
+          throw std::logic_error("Don't do this");
+        }
       };
     }
   }
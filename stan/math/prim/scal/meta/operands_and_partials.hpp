@@ -8,8 +8,9 @@ namespace stan {
   namespace math {
     template <typename Op1 = double, typename Op2 = double,
               typename Op3 = double, typename Op4 = double,
+              typename Op5 = double,
               typename T_return_type
-              = typename return_type<Op1, Op2, Op3, Op4>::type>
+              = typename return_type<Op1, Op2, Op3, Op4, Op5>::type>
     class operands_and_partials;  // Forward declaration
 
     namespace internal {
@@ -34,7 +35,8 @@ namespace stan {
         explicit ops_partials_edge(const Op& /* op */) {}
 
       private:
-        template<typename, typename, typename, typename, typename>
+        template<typename, typename, typename, typename, typename,
+                 typename>
         friend class stan::math::operands_and_partials;
 
         void dump_partials(ViewElt* /* partials */) const {}  // reverse mode
@@ -65,7 +67,7 @@ namespace stan {
      *
      * This base template is instantiated when all operands are
      * primitives and we don't want to calculate derivatives at
-     * all. So all Op1 - Op4 must be arithmetic primitives
+     * all. So all Op1 - Op5 must be arithmetic primitives
      * like int or double. This is controlled with the
      * T_return_type type parameter.
      *
@@ -73,12 +75,13 @@ namespace stan {
      * @tparam Op2 type of the second operand
      * @tparam Op3 type of the third operand
      * @tparam Op4 type of the fourth operand
+     * @tparam Op5 type of the fifth operand
      * @tparam T_return_type return type of the expression. This defaults
      *   to calling a template metaprogram that calculates the scalar
-     *   promotion of Op1..Op4
+     *   promotion of Op1..Op5
      */
     template <typename Op1, typename Op2,
-              typename Op3, typename Op4,
+              typename Op3, typename Op4, typename Op5,
               typename T_return_type>
     class operands_and_partials {
     public:
@@ -87,6 +90,8 @@ namespace stan {
       operands_and_partials(const Op1& op1, const Op2& op2, const Op3& op3) {}
       operands_and_partials(const Op1& op1, const Op2& op2, const Op3& op3,
                             const Op4& op4) {}
+      operands_and_partials(const Op1& op1, const Op2& op2, const Op3& op3,
+                            const Op4& op4, const Op5& op5) {}
 
       /**
        * Build the node to be stored on the autodiff graph.
@@ -110,6 +115,7 @@ namespace stan {
       internal::ops_partials_edge<double, Op2> edge2_;
       internal::ops_partials_edge<double, Op3> edge3_;
       internal::ops_partials_edge<double, Op4> edge4_;
+      internal::ops_partials_edge<double, Op5> edge5_;
     };
   }  // namespace math
 }  // namespace stan
@@ -83,7 +83,7 @@ namespace stan {
         if (!is_constant_struct<T_prob>::value) {
           static const double cutoff = 20.0;
           if (ntheta > cutoff)
-            ops_partials.edge1_.partials_[n] -= exp_m_ntheta;
+            ops_partials.edge1_.partials_[n] += sign * exp_m_ntheta;
           else if (ntheta < -cutoff)
             ops_partials.edge1_.partials_[n] += sign;
           else
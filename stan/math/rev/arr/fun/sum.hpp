@@ -30,7 +30,7 @@ namespace stan {
 
       explicit sum_v_vari(const std::vector<var> &v1)
         : vari(sum_of_val(v1)),
-          v_(reinterpret_cast<vari**>(ChainableStack::memalloc_
+          v_(reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                       .alloc(v1.size() * sizeof(vari*)))),
           length_(v1.size()) {
         for (size_t i = 0; i < length_; i++)
@@ -53,7 +53,18 @@ namespace stan {
     inline var sum(const std::vector<var>& m) {
       if (m.size() == 0)
         return 0.0;
-      return var(new sum_v_vari(m));
+      double result = 0;
+      for (size_t i = 0; i < m.size(); ++i)
+        result += m[i].val();
+      vari* sum_vi = new vari(result, false);
+      ChainableStack::AutodiffStackStorage& stack
+        = push_linear_node(sum_vi, m.size());
+      for (size_t i = 0; i < m.size(); ++i) {
+        stack.op_operands_.push_back(m[i].vi_);
+        stack.op_partials_.push_back(1.0);
+      }
+      record_replay_op(stack, REPLAY_SUM);
+      return var(sum_vi);
     }
 
   }
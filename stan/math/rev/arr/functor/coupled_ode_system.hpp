@@ -4,10 +4,13 @@
 #include <stan/math/prim/arr/meta/get.hpp>
 #include <stan/math/prim/arr/meta/length.hpp>
 #include <stan/math/prim/arr/functor/coupled_ode_system.hpp>
+#include <stan/math/prim/arr/functor/ode_with_jacobian.hpp>
 #include <stan/math/prim/arr/fun/value_of.hpp>
 #include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/rev/scal/fun/value_of_rec.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/rev/core.hpp>
+#include <algorithm>
 #include <ostream>
 #include <stdexcept>
 #include <vector>
@@ -37,6 +40,126 @@ namespace stan {
           y[n][m] += y0[m];
     }
 
+    /**
+     * Assign the right hand side of the base ODE system and its
+     * Jacobians with respect to the states and, if
+     * <code>Jtheta</code> has columns, the parameters.
+     *
+     * <p>The Jacobians are computed with nested reverse mode, one
+     * sweep per equation.
+     *
+     * @tparam F type of functor for the base ode system.
+     * @param[in] f the base ODE system functor.
+     * @param[in] t time.
+     * @param[in] y state of the base ode system.
+     * @param[in] theta parameters of the base ode.
+     * @param[in] x real data.
+     * @param[in] x_int integer data.
+     * @param[in, out] msgs stream to which messages are printed.
+     * @param[out] dy_dt the first N elements are assigned the right
+     * hand side of the base ODE system.
+     * @param[out] Jy N x N Jacobian with respect to the states.
+     * @param[out] Jtheta N x M Jacobian with respect to the
+     * parameters, or an N x 0 matrix if it is not needed.
+     * @throw exception if the system function does not return the
+     * same number of derivatives as the state vector size.
+     */
+    template <typename F>
+    inline void coupled_ode_jacobian(const F& f, double t,
+                                     const std::vector<double>& y,
+                                     const std::vector<double>& theta,
+                                     const std::vector<double>& x,
+                                     const std::vector<int>& x_int,
+                                     std::ostream* msgs,
+                                     std::vector<double>& dy_dt,
+                                     Eigen::MatrixXd& Jy,
+                                     Eigen::MatrixXd& Jtheta) {
+      using std::vector;
+      const size_t N = y.size();
+      const size_t M = Jtheta.cols();
+      vector<double> grad(N + M);
+      try {
+        start_nested();
+
+        vector<var> z_vars;
+        z_vars.reserve(N + M);
+
+        vector<var> y_vars(y.begin(), y.end());
+        z_vars.insert(z_vars.end(), y_vars.begin(), y_vars.end());
+
+        vector<var> dy_dt_vars;
+        if (M > 0) {
+          vector<var> theta_vars(theta.begin(), theta.end());
+          z_vars.insert(z_vars.end(), theta_vars.begin(), theta_vars.end());
+          dy_dt_vars = f(t, y_vars, theta_vars, x, x_int, msgs);
+        } else {
+          dy_dt_vars = f(t, y_vars, theta, x, x_int, msgs);
+        }
+
+        check_size_match("coupled_ode_system", "dz_dt", dy_dt_vars.size(),
+                         "states", N);
+
+        for (size_t i = 0; i < N; i++) {
+          dy_dt[i] = dy_dt_vars[i].val();
+          set_zero_all_adjoints_nested();
+          dy_dt_vars[i].grad(z_vars, grad);
+          for (size_t j = 0; j < N; j++)
+            Jy(i, j) = grad[j];
+          for (size_t j = 0; j < M; j++)
+            Jtheta(i, j) = grad[N + j];
+        }
+      } catch (const std::exception& e) {
+        recover_memory_nested();
+        throw;
+      }
+      recover_memory_nested();
+    }
+
+    /**
+     * Assign the right hand side of the base ODE system and its
+     * Jacobians with the Jacobian functor of the system.
+     *
+     * @tparam F type of functor for the base ode system.
+     * @tparam F_jac type of functor for the Jacobian.
+     * @param[in] f the base ODE system with its Jacobian functor.
+     * @param[in] t time.
+     * @param[in] y state of the base ode system.
+     * @param[in] theta parameters of the base ode.
+     * @param[in] x real data.
+     * @param[in] x_int integer data.
+     * @param[in, out] msgs stream to which messages are printed.
+     * @param[out] dy_dt the first N elements are assigned the right
+     * hand side of the base ODE system.
+     * @param[out] Jy N x N Jacobian with respect to the states.
+     * @param[out] Jtheta N x M Jacobian with respect to the
+     * parameters, or an N x 0 matrix if it is not needed.
+     * @throw exception if the system function does not return the
+     * same number of derivatives as the state vector size.
+     */
+    template <typename F, typename F_jac>
+    inline void coupled_ode_jacobian(const ode_with_jacobian<F, F_jac>& f,
+                                     double t,
+                                     const std::vector<double>& y,
+                                     const std::vector<double>& theta,
+                                     const std::vector<double>& x,
+                                     const std::vector<int>& x_int,
+                                     std::ostream* msgs,
+                                     std::vector<double>& dy_dt,
+                                     Eigen::MatrixXd& Jy,
+                                     Eigen::MatrixXd& Jtheta) {
+      const size_t N = y.size();
+      std::vector<double> f_y = f.f_(t, y, theta, x, x_int, msgs);
+      check_size_match("coupled_ode_system", "dz_dt", f_y.size(),
+                       "states", N);
+      std::copy(f_y.begin(), f_y.end(), dy_dt.begin());
+      if (Jtheta.cols() == static_cast<int>(theta.size())) {
+        f.jac_(t, y, theta, x, x_int, msgs, Jy, Jtheta);
+      } else {
+        Eigen::MatrixXd Jtheta_full(N, theta.size());
+        f.jac_(t, y, theta, x, x_int, msgs, Jy, Jtheta_full);
+      }
+    }
+
     /**
      * The coupled ODE system for known initial values and unknown
      * parameters.
@@ -122,46 +245,20 @@ namespace stan {
                       double t) const {
         using std::vector;
 
-        vector<double> grad(N_ + M_);
-
-        try {
-          start_nested();
-
-          vector<var> z_vars;
-          z_vars.reserve(N_ + M_);
-
-          vector<var> y_vars(z.begin(), z.begin() + N_);
-          z_vars.insert(z_vars.end(), y_vars.begin(), y_vars.end());
-
-          vector<var> theta_vars(theta_dbl_.begin(), theta_dbl_.end());
-          z_vars.insert(z_vars.end(), theta_vars.begin(), theta_vars.end());
-
-          vector<var> dy_dt_vars = f_(t, y_vars, theta_vars, x_, x_int_, msgs_);
-
-          check_size_match("coupled_ode_system", "dz_dt", dy_dt_vars.size(),
-                           "states", N_);
-
-          for (size_t i = 0; i < N_; i++) {
-            dz_dt[i] = dy_dt_vars[i].val();
-            set_zero_all_adjoints_nested();
-            dy_dt_vars[i].grad(z_vars, grad);
-
-            for (size_t j = 0; j < M_; j++) {
-              // orders derivatives by equation (i.e. if there are 2 eqns
-              // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as:
-              // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
-              double temp_deriv = grad[N_ + j];
-              for (size_t k = 0; k < N_; k++)
-                temp_deriv += z[N_ + N_ * j + k] * grad[k];
-
-              dz_dt[N_ + i + j * N_] = temp_deriv;
-            }
-          }
-        } catch (const std::exception& e) {
-          recover_memory_nested();
-          throw;
+        vector<double> y(z.begin(), z.begin() + N_);
+        Eigen::MatrixXd Jy(N_, N_);
+        Eigen::MatrixXd Jtheta(N_, M_);
+        coupled_ode_jacobian(f_, t, y, theta_dbl_, x_, x_int_, msgs_,
+                             dz_dt, Jy, Jtheta);
+
+        // orders derivatives by equation (i.e. if there are 2 eqns
+        // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as:
+        // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
+        if (M_ > 0) {
+          Eigen::Map<const Eigen::MatrixXd> dy_dtheta(&z[N_], N_, M_);
+          Eigen::Map<Eigen::MatrixXd>(&dz_dt[N_], N_, M_)
+            = Jy * dy_dtheta + Jtheta;
         }
-        recover_memory_nested();
       }
 
       /**
@@ -316,43 +413,17 @@ namespace stan {
         for (size_t n = 0; n < N_; n++)
           y[n] += y0_dbl_[n];
 
-        std::vector<double> grad(N_);
-
-        try {
-          start_nested();
-
-          vector<var> z_vars;
-          z_vars.reserve(N_);
-
-          vector<var> y_vars(y.begin(), y.end());
-          z_vars.insert(z_vars.end(), y_vars.begin(), y_vars.end());
-
-          vector<var> dy_dt_vars = f_(t, y_vars, theta_dbl_, x_, x_int_, msgs_);
-
-          check_size_match("coupled_ode_system", "dz_dt", dy_dt_vars.size(),
-                           "states", N_);
-
-          for (size_t i = 0; i < N_; i++) {
-            dz_dt[i] = dy_dt_vars[i].val();
-            set_zero_all_adjoints_nested();
-            dy_dt_vars[i].grad(z_vars, grad);
-
-            for (size_t j = 0; j < N_; j++) {
-              // orders derivatives by equation (i.e. if there are 2 eqns
-              // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as:
-              // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
-              double temp_deriv = grad[j];
-              for (size_t k = 0; k < N_; k++)
-                temp_deriv += z[N_ + N_ * j + k] * grad[k];
-
-              dz_dt[N_ + i + j * N_] = temp_deriv;
-            }
-          }
-        } catch (const std::exception& e) {
-          recover_memory_nested();
-          throw;
-        }
-        recover_memory_nested();
+        Eigen::MatrixXd Jy(N_, N_);
+        Eigen::MatrixXd Jtheta(N_, 0);
+        coupled_ode_jacobian(f_, t, y, theta_dbl_, x_, x_int_, msgs_,
+                             dz_dt, Jy, Jtheta);
+
+        // orders derivatives by equation (i.e. if there are 2 eqns
+        // (y1, y2) and 2 initial values (a, b), dy_dt will be ordered
+        // as: dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
+        Eigen::Map<const Eigen::MatrixXd> dy_dy0(&z[N_], N_, N_);
+        Eigen::Map<Eigen::MatrixXd>(&dz_dt[N_], N_, N_)
+          = Jy * dy_dy0 + Jy;
       }
 
       /**
@@ -521,46 +592,23 @@ namespace stan {
         for (size_t n = 0; n < N_; n++)
           y[n] += y0_dbl_[n];
 
-        vector<double> grad(N_ + M_);
-
-        try {
-          start_nested();
-
-          vector<var> z_vars;
-          z_vars.reserve(N_ + M_);
-
-          vector<var> y_vars(y.begin(), y.end());
-          z_vars.insert(z_vars.end(), y_vars.begin(), y_vars.end());
-
-          vector<var> theta_vars(theta_dbl_.begin(), theta_dbl_.end());
-          z_vars.insert(z_vars.end(), theta_vars.begin(), theta_vars.end());
-
-          vector<var> dy_dt_vars = f_(t, y_vars, theta_vars, x_, x_int_, msgs_);
-
-          check_size_match("coupled_ode_system", "dz_dt", dy_dt_vars.size(),
-                           "states", N_);
-
-          for (size_t i = 0; i < N_; i++) {
-            dz_dt[i] = dy_dt_vars[i].val();
-            set_zero_all_adjoints_nested();
-            dy_dt_vars[i].grad(z_vars, grad);
-
-            for (size_t j = 0; j < N_ + M_; j++) {
-              // orders derivatives by equation (i.e. if there are 2 eqns
-              // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as:
-              // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
-              double temp_deriv = grad[j];
-              for (size_t k = 0; k < N_; k++)
-                temp_deriv += z[N_ + N_ * j + k] * grad[k];
-
-              dz_dt[N_ + i + j * N_] = temp_deriv;
-            }
-          }
-        } catch (const std::exception& e) {
-          recover_memory_nested();
-          throw;
+        Eigen::MatrixXd Jy(N_, N_);
+        Eigen::MatrixXd Jtheta(N_, M_);
+        coupled_ode_jacobian(f_, t, y, theta_dbl_, x_, x_int_, msgs_,
+                             dz_dt, Jy, Jtheta);
+
+        // orders derivatives by equation (i.e. if there are 2 eqns
+        // (y1, y2) and 2 parameters (a, b), dy_dt will be ordered as:
+        // dy1_dt, dy2_dt, dy1_da, dy2_da, dy1_db, dy2_db
+        Eigen::Map<const Eigen::MatrixXd> dy_dy0(&z[N_], N_, N_);
+        Eigen::Map<Eigen::MatrixXd>(&dz_dt[N_], N_, N_)
+          = Jy * dy_dy0 + Jy;
+        if (M_ > 0) {
+          Eigen::Map<const Eigen::MatrixXd> dy_dtheta(&z[N_ + N_ * N_],
+                                                      N_, M_);
+          Eigen::Map<Eigen::MatrixXd>(&dz_dt[N_ + N_ * N_], N_, M_)
+            = Jy * dy_dtheta + Jtheta;
         }
-        recover_memory_nested();
       }
 
       /**
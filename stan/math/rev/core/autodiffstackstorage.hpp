@@ -7,49 +7,83 @@
 namespace stan {
   namespace math {
 
+    struct tape_recording;
+
+    /**
+     * Provides access to the autodiff tape (the stacks of chainable
+     * variables, the linear nodes, the nesting bookkeeping and the
+     * arena allocator).
+     *
+     * The tape is held in a single <code>AutodiffStackStorage</code>
+     * instance returned by <code>instance()</code>.  By default there
+     * is one instance per process.  If the preprocessor symbol
+     * <code>STAN_THREADS</code> is defined, the instance is declared
+     * <code>thread_local</code>, so that every thread records to and
+     * sweeps its own tape.  Independent gradient calculations can then
+     * run concurrently in separate threads of the same process.  Vars
+     * must not be shared across threads in this mode, because each
+     * var lives on the tape of the thread which created it.
+     *
+     * @tparam ChainableT type of chainable variable implementation
+     * @tparam ChainableAllocT type of chainable allocated object
+     */
     template<typename ChainableT,
              typename ChainableAllocT>
-    struct AutodiffStackStorage {
-      static std::vector<ChainableT*> var_stack_;
-      static std::vector<ChainableT*> var_nochain_stack_;
-      static std::vector<ChainableAllocT*> var_alloc_stack_;
-      static stack_alloc memalloc_;
-
-      // nested positions
-      static std::vector<size_t> nested_var_stack_sizes_;
-      static std::vector<size_t> nested_var_nochain_stack_sizes_;
-      static std::vector<size_t> nested_var_alloc_stack_starts_;
-    };
+    struct AutodiffStackSingleton {
+      typedef AutodiffStackSingleton<ChainableT, ChainableAllocT>
+      AutodiffStackSingleton_t;
 
-    template<typename ChainableT, typename ChainableAllocT>
-    std::vector<ChainableT*>
-    AutodiffStackStorage<ChainableT, ChainableAllocT>::var_stack_;
+      struct AutodiffStackStorage {
+        AutodiffStackStorage() : recording_(0) { }
+        AutodiffStackStorage(const AutodiffStackStorage&) = delete;
+        AutodiffStackStorage& operator=(const AutodiffStackStorage&)
+          = delete;
 
-    template<typename ChainableT, typename ChainableAllocT>
-    std::vector<ChainableT*>
-    AutodiffStackStorage<ChainableT, ChainableAllocT>::var_nochain_stack_;
+        std::vector<ChainableT*> var_stack_;
+        std::vector<ChainableT*> var_nochain_stack_;
+        std::vector<ChainableAllocT*> var_alloc_stack_;
+        stack_alloc memalloc_;
 
-    template<typename ChainableT, typename ChainableAllocT>
-    std::vector<ChainableAllocT*>
-    AutodiffStackStorage<ChainableT, ChainableAllocT>::var_alloc_stack_;
+        // linear nodes, swept without virtual calls (see linear_tape.hpp)
+        std::vector<ChainableT*> op_results_;
+        std::vector<size_t> op_stack_positions_;
+        std::vector<size_t> op_arities_;
+        std::vector<ChainableT*> op_operands_;
+        std::vector<double> op_partials_;
 
-    template<typename ChainableT, typename ChainableAllocT>
-    stack_alloc
-    AutodiffStackStorage<ChainableT, ChainableAllocT>::memalloc_;
+        // installed by compiled_tape while recording, otherwise null
+        tape_recording* recording_;
 
-    template<typename ChainableT, typename ChainableAllocT>
-    std::vector<size_t>
-    AutodiffStackStorage<ChainableT, ChainableAllocT>::nested_var_stack_sizes_;
+        // nested positions
+        std::vector<size_t> nested_var_stack_sizes_;
+        std::vector<size_t> nested_var_nochain_stack_sizes_;
+        std::vector<size_t> nested_var_alloc_stack_starts_;
+        std::vector<size_t> nested_op_sizes_;
+        std::vector<size_t> nested_op_operand_sizes_;
+      };
 
-    template<typename ChainableT, typename ChainableAllocT>
-    std::vector<size_t>
-    AutodiffStackStorage<ChainableT, ChainableAllocT>
-    ::nested_var_nochain_stack_sizes_;
+      AutodiffStackSingleton() = delete;
+      explicit AutodiffStackSingleton(const AutodiffStackSingleton_t&)
+        = delete;
+      AutodiffStackSingleton& operator=(const AutodiffStackSingleton_t&)
+        = delete;
 
-    template<typename ChainableT, typename ChainableAllocT>
-    std::vector<size_t>
-    AutodiffStackStorage<ChainableT, ChainableAllocT>
-    ::nested_var_alloc_stack_starts_;
+      /**
+       * Return the autodiff tape for the calling thread.  Unless
+       * <code>STAN_THREADS</code> is defined, all threads share the
+       * same tape.
+       *
+       * @return reference to the autodiff tape
+       */
+      static inline AutodiffStackStorage& instance() {
+#ifdef STAN_THREADS
+        thread_local static AutodiffStackStorage instance_;
+#else
+        static AutodiffStackStorage instance_;
+#endif
+        return instance_;
+      }
+    };
 
   }
 }
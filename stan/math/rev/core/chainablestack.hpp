@@ -9,7 +9,7 @@ namespace stan {
     class vari;
     class chainable_alloc;
 
-    typedef AutodiffStackStorage<vari, chainable_alloc> ChainableStack;
+    typedef AutodiffStackSingleton<vari, chainable_alloc> ChainableStack;
 
   }
 }
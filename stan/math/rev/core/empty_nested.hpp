@@ -10,7 +10,7 @@ namespace stan {
      * Return true if there is no nested autodiff being executed.
      */
     static inline bool empty_nested() {
-      return ChainableStack::nested_var_stack_sizes_.empty();
+      return ChainableStack::instance().nested_var_stack_sizes_.empty();
     }
 
   }
@@ -35,7 +35,7 @@ namespace stan {
         alpha_ = alpha->vi_;
         // TODO(carpenter): replace this with array alloc fun call
         v1_ = reinterpret_cast<vari**>
-          (ChainableStack::memalloc_
+          (ChainableStack::instance().memalloc_
            .alloc(2 * length_ * sizeof(vari*)));
         v2_ = v1_ + length_;
         for (size_t i = 0; i < length_; i++)
@@ -4,7 +4,7 @@
 #include <stan/math/rev/core/chainable_alloc.hpp>
 #include <stan/math/rev/core/chainablestack.hpp>
 #include <stan/math/rev/core/empty_nested.hpp>
-#include <stan/math/rev/core/nested_size.hpp>
+#include <stan/math/rev/core/linear_tape.hpp>
 #include <stan/math/rev/core/vari.hpp>
 #include <vector>
 
@@ -19,6 +19,11 @@ namespace stan {
      * rule is applied working down the stack from this vari and
      * calling each vari's <code>chain()</code> method in turn.
      *
+     * <p>Linear nodes (see <code>push_linear_node()</code>) are not
+     * on the stack.  They are propagated without virtual calls from
+     * their own arrays, interleaved with the stack in the order in
+     * which they were recorded.
+     *
      * <p>This function computes a nested gradient only going back as far
      * as the last nesting.
      *
@@ -34,14 +39,25 @@ namespace stan {
       //   size_t begin = empty_nested() ? 0 : end - nested_size();
       //   for (size_t i = end; --i > begin; )
       //     var_stack_[i]->chain();
+      // with the linear nodes recorded after var_stack_[i - 1]
+      // propagated before it
 
-      typedef std::vector<vari*>::reverse_iterator it_t;
       vi->init_dependent();
-      it_t begin = ChainableStack::var_stack_.rbegin();
-      it_t end = empty_nested()
-        ? ChainableStack::var_stack_.rend() : begin + nested_size();
-      for (it_t it = begin; it < end; ++it) {
-        (*it)->chain();
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      std::vector<vari*>& var_stack = stack.var_stack_;
+      size_t begin = 0;
+      size_t op_begin = 0;
+      if (!empty_nested()) {
+        begin = stack.nested_var_stack_sizes_.back();
+        op_begin = stack.nested_op_sizes_.back();
+      }
+      size_t k = stack.op_results_.size();
+      size_t j = stack.op_operands_.size();
+      for (size_t i = var_stack.size(); ; ) {
+        chain_linear_nodes(i, op_begin, k, j);
+        if (i == begin)
+          break;
+        var_stack[--i]->chain();
       }
     }
 
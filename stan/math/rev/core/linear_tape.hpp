@@ -0,0 +1,175 @@
+#ifndef STAN_MATH_REV_CORE_LINEAR_TAPE_HPP
+#define STAN_MATH_REV_CORE_LINEAR_TAPE_HPP
+
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <cstdlib>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Record a linear node for the specified result on the calling
+     * thread's tape and return the tape for storing its operands.
+     *
+     * A linear node is a variable whose adjoint propagates to its
+     * operands through partials that are known when it is
+     * constructed.  Instead of calling a virtual <code>chain()</code>
+     * method, <code>grad()</code> sweeps these nodes from arrays
+     * holding the result, the position relative to the stack of
+     * chainable variables, the number of operands and the operands
+     * and partials.  The result must not be on the stack of
+     * chainable variables; it is constructed with
+     * <code>vari(val, false)</code> so that its adjoint is still
+     * reset by <code>set_zero_all_adjoints()</code>.
+     *
+     * @param result variable for which the node is recorded
+     * @param arity number of operands
+     * @return autodiff tape
+     */
+    static inline ChainableStack::AutodiffStackStorage&
+    push_linear_node(vari* result, size_t arity) {
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      stack.op_results_.push_back(result);
+      stack.op_stack_positions_.push_back(stack.var_stack_.size());
+      stack.op_arities_.push_back(arity);
+      return stack;
+    }
+
+    /**
+     * Record a linear node with one operand.
+     *
+     * @param result variable for which the node is recorded
+     * @param avi operand
+     * @param da partial of result with respect to operand
+     * @return autodiff tape
+     */
+    static inline ChainableStack::AutodiffStackStorage&
+    push_linear_node(vari* result, vari* avi, double da) {
+      ChainableStack::AutodiffStackStorage& stack
+        = push_linear_node(result, 1);
+      stack.op_operands_.push_back(avi);
+      stack.op_partials_.push_back(da);
+      return stack;
+    }
+
+    /**
+     * Record a linear node with two operands.
+     *
+     * @param result variable for which the node is recorded
+     * @param avi first operand
+     * @param bvi second operand
+     * @param da partial of result with respect to first operand
+     * @param db partial of result with respect to second operand
+     * @return autodiff tape
+     */
+    static inline ChainableStack::AutodiffStackStorage&
+    push_linear_node(vari* result, vari* avi, vari* bvi,
+                     double da, double db) {
+      ChainableStack::AutodiffStackStorage& stack
+        = push_linear_node(result, 2);
+      stack.op_operands_.push_back(avi);
+      stack.op_operands_.push_back(bvi);
+      stack.op_partials_.push_back(da);
+      stack.op_partials_.push_back(db);
+      return stack;
+    }
+
+    /**
+     * Record a linear node with three operands.
+     *
+     * @param result variable for which the node is recorded
+     * @param avi first operand
+     * @param bvi second operand
+     * @param cvi third operand
+     * @param da partial of result with respect to first operand
+     * @param db partial of result with respect to second operand
+     * @param dc partial of result with respect to third operand
+     * @return autodiff tape
+     */
+    static inline ChainableStack::AutodiffStackStorage&
+    push_linear_node(vari* result, vari* avi, vari* bvi, vari* cvi,
+                     double da, double db, double dc) {
+      ChainableStack::AutodiffStackStorage& stack
+        = push_linear_node(result, 3);
+      stack.op_operands_.push_back(avi);
+      stack.op_operands_.push_back(bvi);
+      stack.op_operands_.push_back(cvi);
+      stack.op_partials_.push_back(da);
+      stack.op_partials_.push_back(db);
+      stack.op_partials_.push_back(dc);
+      return stack;
+    }
+
+    /**
+     * Record a linear node with the specified number of operands.
+     *
+     * @param result variable for which the node is recorded
+     * @param size number of operands
+     * @param operands operands
+     * @param partials partials of result with respect to operands
+     * @return autodiff tape
+     */
+    static inline ChainableStack::AutodiffStackStorage&
+    push_linear_node(vari* result, size_t size, vari* const* operands,
+                     const double* partials) {
+      ChainableStack::AutodiffStackStorage& stack
+        = push_linear_node(result, size);
+      stack.op_operands_.insert(stack.op_operands_.end(),
+                                operands, operands + size);
+      stack.op_partials_.insert(stack.op_partials_.end(),
+                                partials, partials + size);
+      return stack;
+    }
+
+    /**
+     * Propagate the adjoints of the linear nodes recorded after
+     * the chainable variable at the specified stack position, down
+     * to the specified first node.
+     *
+     * @param[in] stack_pos position on the stack of chainable
+     * variables
+     * @param[in] begin index of first node to propagate
+     * @param[in, out] k one past the index of the last node not yet
+     * propagated
+     * @param[in, out] j one past the index of the last operand not
+     * yet propagated
+     */
+    static inline void chain_linear_nodes(size_t stack_pos, size_t begin,
+                                          size_t& k, size_t& j) {
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      const std::vector<size_t>& positions = stack.op_stack_positions_;
+      const std::vector<size_t>& arities = stack.op_arities_;
+      std::vector<vari*>& operands = stack.op_operands_;
+      const std::vector<double>& partials = stack.op_partials_;
+      while (k > begin && positions[k - 1] >= stack_pos) {
+        --k;
+        double adj = stack.op_results_[k]->adj_;
+        switch (arities[k]) {
+          case 1:
+            j -= 1;
+            operands[j]->adj_ += adj * partials[j];
+            break;
+          case 2:
+            j -= 2;
+            operands[j]->adj_ += adj * partials[j];
+            operands[j + 1]->adj_ += adj * partials[j + 1];
+            break;
+          case 3:
+            j -= 3;
+            operands[j]->adj_ += adj * partials[j];
+            operands[j + 1]->adj_ += adj * partials[j + 1];
+            operands[j + 2]->adj_ += adj * partials[j + 2];
+            break;
+          default:
+            j -= arities[k];
+            for (size_t n = 0; n < arities[k]; ++n)
+              operands[j + n]->adj_ += adj * partials[j + n];
+        }
+      }
+    }
+
+  }
+}
+#endif
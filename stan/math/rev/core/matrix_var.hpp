@@ -0,0 +1,268 @@
+#ifndef STAN_MATH_REV_CORE_MATRIX_VAR_HPP
+#define STAN_MATH_REV_CORE_MATRIX_VAR_HPP
+
+#include <stan/math/rev/mat/fun/Eigen_NumTraits.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/vari.hpp>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * The node of a matrix-valued variable on the expression graph.
+     *
+     * The values and the adjoints of the matrix are each held
+     * contiguously in arena memory and exposed as
+     * <code>Eigen::Map</code>s, so that operations on matrix
+     * variables work on whole <code>double</code> matrices and put a
+     * single node on the stack, rather than one per element.
+     *
+     * This class is the base of the nodes of operations with matrix
+     * results, which implement <code>chain()</code> to propagate the
+     * adjoints of the result to those of their operands.  On its own
+     * it is a matrix of independent variables.
+     */
+    class matrix_var_vari : public vari {
+    public:
+      /**
+       * Values of the matrix.
+       */
+      Eigen::Map<Eigen::MatrixXd> values_;
+
+      /**
+       * Adjoints of the matrix, zero on construction.
+       */
+      Eigen::Map<Eigen::MatrixXd> adjoints_;
+
+      /**
+       * Construct a node for a matrix with the specified dimensions
+       * and uninitialized values.
+       *
+       * @param rows number of rows
+       * @param cols number of columns
+       * @param stacked true if <code>chain()</code> is called in
+       * the reverse pass, false for independent variables
+       */
+      matrix_var_vari(int rows, int cols, bool stacked = true)
+        : vari(0.0, stacked),
+          values_(ChainableStack::instance().memalloc_
+                  .alloc_array<double>(rows * cols), rows, cols),
+          adjoints_(ChainableStack::instance().memalloc_
+                    .alloc_array<double>(rows * cols), rows, cols) {
+        adjoints_.setZero();
+      }
+
+      /**
+       * Construct a node with the specified values.
+       *
+       * @tparam Derived type of matrix expression
+       * @param x values
+       * @param stacked true if <code>chain()</code> is called in
+       * the reverse pass, false for independent variables
+       */
+      template <typename Derived>
+      explicit matrix_var_vari(const Eigen::MatrixBase<Derived>& x,
+                               bool stacked = true)
+        : vari(0.0, stacked),
+          values_(ChainableStack::instance().memalloc_
+                  .alloc_array<double>(x.size()), x.rows(), x.cols()),
+          adjoints_(ChainableStack::instance().memalloc_
+                    .alloc_array<double>(x.size()), x.rows(), x.cols()) {
+        values_ = x;
+        adjoints_.setZero();
+      }
+
+      void set_zero_adjoint() {
+        adj_ = 0.0;
+        adjoints_.setZero();
+      }
+    };
+
+    namespace {
+      /**
+       * Matrix of the values of a matrix of scalar variables, which
+       * propagates its adjoints to the elements.
+       */
+      class matrix_var_gather_vari : public matrix_var_vari {
+      public:
+        vari** vis_;
+
+        template <int R, int C>
+        explicit matrix_var_gather_vari(const Eigen::Matrix<var, R, C>& x)
+          : matrix_var_vari(x.rows(), x.cols()),
+            vis_(ChainableStack::instance().memalloc_
+                 .alloc_array<vari*>(x.size())) {
+          for (int i = 0; i < x.size(); ++i) {
+            vis_[i] = x(i).vi_;
+            values_(i) = x(i).vi_->val_;
+          }
+        }
+
+        virtual void chain() {
+          for (int i = 0; i < adjoints_.size(); ++i)
+            vis_[i]->adj_ += adjoints_(i);
+        }
+      };
+
+      /**
+       * Element of a matrix variable.
+       */
+      class matrix_var_element_vari : public vari {
+      public:
+        matrix_var_vari* m_;
+        int i_;
+
+        matrix_var_element_vari(matrix_var_vari* m, int i)
+          : vari(m->values_(i)), m_(m), i_(i) { }
+
+        virtual void chain() {
+          m_->adjoints_(i_) += adj_;
+        }
+      };
+    }
+
+    /**
+     * A matrix-valued variable for reverse-mode automatic
+     * differentiation.
+     *
+     * Where <code>Eigen::Matrix&lt;var, R, C&gt;</code> is a matrix
+     * of separate scalar variables, a <code>matrix_var</code> points
+     * to a single <code>matrix_var_vari</code> holding the values and
+     * the adjoints of the whole matrix.  Operations on matrix
+     * variables, such as <code>multiply()</code>,
+     * <code>cholesky_decompose()</code> or
+     * <code>mdivide_left()</code>, compute their values and adjoints
+     * with matrix algebra on <code>double</code> matrices and add one
+     * node to the expression graph, whatever the size of the
+     * matrices.
+     *
+     * A <code>matrix_var</code> is constructed from a
+     * <code>double</code> matrix, as a matrix of independent
+     * variables, or from a matrix of scalar variables, whose adjoints
+     * it updates in the reverse pass.  Scalar variables are returned
+     * by the element access operator, <code>to_var()</code> and
+     * reductions such as <code>sum()</code>.
+     *
+     * Like <code>var</code>, a <code>matrix_var</code> is a pointer
+     * and is copied cheaply.  Its values cannot be changed.
+     */
+    class matrix_var {
+    public:
+      /**
+       * Pointer to the node holding the values and adjoints.
+       */
+      matrix_var_vari* vi_;
+
+      /**
+       * Construct an uninitialized matrix variable.
+       */
+      matrix_var() : vi_(0) { }
+
+      /**
+       * Construct a matrix variable pointing to the specified node.
+       *
+       * @param vi node
+       */
+      explicit matrix_var(matrix_var_vari* vi) : vi_(vi) { }
+
+      /**
+       * Construct a matrix of independent variables with the
+       * specified values.
+       *
+       * @tparam R number of rows, can be Eigen::Dynamic
+       * @tparam C number of columns, can be Eigen::Dynamic
+       * @param x values
+       */
+      template <int R, int C>
+      explicit matrix_var(const Eigen::Matrix<double, R, C>& x)
+        : vi_(new matrix_var_vari(x, false)) { }
+
+      /**
+       * Construct a matrix variable with the values of the specified
+       * scalar variables, whose adjoints are incremented by those of
+       * the matrix in the reverse pass.
+       *
+       * @tparam R number of rows, can be Eigen::Dynamic
+       * @tparam C number of columns, can be Eigen::Dynamic
+       * @param x scalar variables
+       */
+      template <int R, int C>
+      explicit matrix_var(const Eigen::Matrix<var, R, C>& x)
+        : vi_(new matrix_var_gather_vari(x)) { }
+
+      /**
+       * Return the number of rows.
+       *
+       * @return number of rows
+       */
+      int rows() const {
+        return vi_->values_.rows();
+      }
+
+      /**
+       * Return the number of columns.
+       *
+       * @return number of columns
+       */
+      int cols() const {
+        return vi_->values_.cols();
+      }
+
+      /**
+       * Return the number of elements.
+       *
+       * @return number of elements
+       */
+      int size() const {
+        return vi_->values_.size();
+      }
+
+      /**
+       * Return the values of the matrix.
+       *
+       * @return values
+       */
+      const Eigen::Map<Eigen::MatrixXd>& val() const {
+        return vi_->values_;
+      }
+
+      /**
+       * Return the adjoints of the matrix, which hold the gradient
+       * after a reverse pass.
+       *
+       * @return adjoints
+       */
+      Eigen::Map<Eigen::MatrixXd>& adj() const {
+        return vi_->adjoints_;
+      }
+
+      /**
+       * Return the element with the specified indexes as a scalar
+       * variable.  This adds a node to the expression graph, so
+       * whole-matrix operations should be preferred.
+       *
+       * @param i row, starting from 0
+       * @param j column, starting from 0
+       * @return element
+       */
+      var operator()(int i, int j) const {
+        return var(new matrix_var_element_vari(vi_, i + j * rows()));
+      }
+
+      /**
+       * Return the element with the specified index in column-major
+       * order as a scalar variable.
+       *
+       * @param i index, starting from 0
+       * @return element
+       */
+      var operator()(int i) const {
+        return var(new matrix_var_element_vari(vi_, i));
+      }
+    };
+
+  }
+}
+#endif
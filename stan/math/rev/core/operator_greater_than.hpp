@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/tape_recording.hpp>
 
 namespace stan {
   namespace math {
@@ -23,7 +24,8 @@ namespace stan {
      * @return True if first variable's value is greater than second's.
      */
     inline bool operator>(const var& a, const var& b) {
-      return a.val() > b.val();
+      return record_comparison(COMPARE_GT, a.vi_, a.val(), b.vi_, b.val(),
+                               a.val() > b.val());
     }
 
     /**
@@ -35,7 +37,8 @@ namespace stan {
      * @return True if first variable's value is greater than second value.
      */
     inline bool operator>(const var& a, double b) {
-      return a.val() > b;
+      return record_comparison(COMPARE_GT, a.vi_, a.val(), 0, b,
+                               a.val() > b);
     }
 
     /**
@@ -47,7 +50,8 @@ namespace stan {
      * @return True if first value is greater than second variable's value.
      */
     inline bool operator>(double a, const var& b) {
-      return a > b.val();
+      return record_comparison(COMPARE_GT, 0, a, b.vi_, b.val(),
+                               a > b.val());
     }
 
   }
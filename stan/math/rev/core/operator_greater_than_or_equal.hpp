@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_GREATER_THAN_OR_EQUAL_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/tape_recording.hpp>
 
 namespace stan {
   namespace math {
@@ -25,7 +26,8 @@ namespace stan {
      * to the second's.
      */
     inline bool operator>=(const var& a, const var& b) {
-      return a.val() >= b.val();
+      return record_comparison(COMPARE_GE, a.vi_, a.val(), b.vi_, b.val(),
+                               a.val() >= b.val());
     }
 
     /**
@@ -38,7 +40,8 @@ namespace stan {
      * to second value.
      */
     inline bool operator>=(const var& a, double b) {
-      return a.val() >= b;
+      return record_comparison(COMPARE_GE, a.vi_, a.val(), 0, b,
+                               a.val() >= b);
     }
 
     /**
@@ -51,7 +54,8 @@ namespace stan {
      * second variable's value.
      */
     inline bool operator>=(double a, const var& b) {
-      return a >= b.val();
+      return record_comparison(COMPARE_GE, 0, a, b.vi_, b.val(),
+                               a >= b.val());
     }
 
   }
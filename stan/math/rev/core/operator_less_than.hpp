@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_LESS_THAN_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/tape_recording.hpp>
 
 namespace stan {
   namespace math {
@@ -22,7 +23,8 @@ namespace stan {
      * @return True if first variable's value is less than second's.
      */
     inline bool operator<(const var& a, const var& b) {
-      return a.val() < b.val();
+      return record_comparison(COMPARE_LT, a.vi_, a.val(), b.vi_, b.val(),
+                               a.val() < b.val());
     }
 
     /**
@@ -34,7 +36,8 @@ namespace stan {
      * @return True if first variable's value is less than second value.
      */
     inline bool operator<(const var& a, double b) {
-      return a.val() < b;
+      return record_comparison(COMPARE_LT, a.vi_, a.val(), 0, b,
+                               a.val() < b);
     }
 
     /**
@@ -46,7 +49,8 @@ namespace stan {
      * @return True if first value is less than second variable's value.
      */
     inline bool operator<(double a, const var& b) {
-      return a < b.val();
+      return record_comparison(COMPARE_LT, 0, a, b.vi_, b.val(),
+                               a < b.val());
     }
 
   }
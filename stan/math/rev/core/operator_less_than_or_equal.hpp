@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_LESS_THAN_OR_EQUAL_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/tape_recording.hpp>
 
 namespace stan {
   namespace math {
@@ -24,7 +25,8 @@ namespace stan {
      * the second's.
      */
     inline bool operator<=(const var& a, const var& b) {
-      return a.val() <= b.val();
+      return record_comparison(COMPARE_LE, a.vi_, a.val(), b.vi_, b.val(),
+                               a.val() <= b.val());
     }
 
     /**
@@ -37,7 +39,8 @@ namespace stan {
      * the second value.
      */
     inline bool operator<=(const var& a, double b) {
-      return a.val() <= b;
+      return record_comparison(COMPARE_LE, a.vi_, a.val(), 0, b,
+                               a.val() <= b);
     }
 
     /**
@@ -50,7 +53,8 @@ namespace stan {
      * variable's value.
      */
     inline bool operator<=(double a, const var& b) {
-      return a <= b.val();
+      return record_comparison(COMPARE_LE, 0, a, b.vi_, b.val(),
+                               a <= b.val());
     }
 
   }
@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_LOGICAL_AND_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/operator_not_equal.hpp>
 
 namespace stan {
   namespace math {
@@ -15,7 +16,7 @@ namespace stan {
      * @return disjuntion of the argument's values
      */
     inline bool operator&&(const var& x, const var& y) {
-      return x.val() && y.val();
+      return x != 0.0 && y != 0.0;
     }
 
     /**
@@ -29,7 +30,7 @@ namespace stan {
      */
     template <typename T>
     inline bool operator&&(const var& x, double y) {
-      return x.val() && y;
+      return x != 0.0 && y;
     }
 
     /**
@@ -43,7 +44,7 @@ namespace stan {
      */
     template <typename T>
     inline bool operator&&(double x, const var& y) {
-      return x && y.val();
+      return x && y != 0.0;
     }
 
   }
@@ -2,58 +2,53 @@
 #define STAN_MATH_REV_CORE_OPERATOR_SUBTRACTION_HPP
 
 #include <stan/math/rev/core/var.hpp>
-#include <stan/math/rev/core/vv_vari.hpp>
-#include <stan/math/rev/core/vd_vari.hpp>
-#include <stan/math/rev/core/dv_vari.hpp>
+#include <stan/math/rev/core/linear_tape.hpp>
+#include <stan/math/rev/core/tape_recording.hpp>
 #include <stan/math/prim/scal/fun/is_nan.hpp>
-#include <limits>
+#include <stan/math/prim/scal/fun/constants.hpp>
 
 namespace stan {
   namespace math {
 
     namespace {
-      class subtract_vv_vari : public op_vv_vari {
+      class subtract_vv_vari : public vari {
       public:
         subtract_vv_vari(vari* avi, vari* bvi) :
-          op_vv_vari(avi->val_ - bvi->val_, avi, bvi) {
-        }
-        void chain() {
-          if (unlikely(is_nan(avi_->val_)
-                       || is_nan(bvi_->val_))) {
-            avi_->adj_ = std::numeric_limits<double>::quiet_NaN();
-            bvi_->adj_ = std::numeric_limits<double>::quiet_NaN();
-          } else {
-            avi_->adj_ += adj_;
-            bvi_->adj_ -= adj_;
-          }
+          vari(avi->val_ - bvi->val_, false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = unlikely(is_nan(avi->val_)
+                       || is_nan(bvi->val_))
+            ? push_linear_node(this, avi, bvi,
+                               NOT_A_NUMBER, NOT_A_NUMBER)
+            : push_linear_node(this, avi, bvi,
+                               1.0, -1.0);
+          record_replay_op(stack, REPLAY_SUBTRACT_VV);
         }
       };
 
-      class subtract_vd_vari : public op_vd_vari {
+      class subtract_vd_vari : public vari {
       public:
         subtract_vd_vari(vari* avi, double b) :
-          op_vd_vari(avi->val_ - b, avi, b) {
-        }
-        void chain() {
-          if (unlikely(is_nan(avi_->val_)
-                       || is_nan(bd_)))
-            avi_->adj_ = std::numeric_limits<double>::quiet_NaN();
-          else
-            avi_->adj_ += adj_;
+          vari(avi->val_ - b, false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = unlikely(is_nan(avi->val_)
+                       || is_nan(b))
+            ? push_linear_node(this, avi, NOT_A_NUMBER)
+            : push_linear_node(this, avi, 1.0);
+          record_replay_op(stack, REPLAY_SUBTRACT_VD, b);
         }
       };
 
-      class subtract_dv_vari : public op_dv_vari {
+      class subtract_dv_vari : public vari {
       public:
         subtract_dv_vari(double a, vari* bvi) :
-          op_dv_vari(a - bvi->val_, a, bvi) {
-        }
-        void chain() {
-          if (unlikely(is_nan(ad_)
-                       || is_nan(bvi_->val_)))
-            bvi_->adj_ = std::numeric_limits<double>::quiet_NaN();
-          else
-            bvi_->adj_ -= adj_;
+          vari(a - bvi->val_, false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = unlikely(is_nan(a)
+                       || is_nan(bvi->val_))
+            ? push_linear_node(this, bvi, NOT_A_NUMBER)
+            : push_linear_node(this, bvi, -1.0);
+          record_replay_op(stack, REPLAY_SUBTRACT_DV, a);
         }
       };
     }
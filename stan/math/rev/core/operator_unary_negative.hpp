@@ -2,24 +2,24 @@
 #define STAN_MATH_REV_CORE_OPERATOR_UNARY_NEGATIVE_HPP
 
 #include <stan/math/rev/core/var.hpp>
-#include <stan/math/rev/core/v_vari.hpp>
+#include <stan/math/rev/core/linear_tape.hpp>
+#include <stan/math/rev/core/tape_recording.hpp>
 #include <stan/math/prim/scal/fun/is_nan.hpp>
-#include <limits>
+#include <stan/math/prim/scal/fun/constants.hpp>
 
 namespace stan {
   namespace math {
 
     namespace {
-      class neg_vari : public op_v_vari {
+      class neg_vari : public vari {
       public:
         explicit neg_vari(vari* avi) :
-          op_v_vari(-(avi->val_), avi) {
-        }
-        void chain() {
-          if (unlikely(is_nan(avi_->val_)))
-            avi_->adj_ = std::numeric_limits<double>::quiet_NaN();
-          else
-            avi_->adj_ -= adj_;
+          vari(-(avi->val_), false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = unlikely(is_nan(avi->val_))
+            ? push_linear_node(this, avi, NOT_A_NUMBER)
+            : push_linear_node(this, avi, -1.0);
+          record_replay_op(stack, REPLAY_NEGATE);
         }
       };
     }
@@ -2,6 +2,7 @@
 #define STAN_MATH_REV_CORE_OPERATOR_UNARY_NOT_HPP
 
 #include <stan/math/rev/core/var.hpp>
+#include <stan/math/rev/core/operator_equal.hpp>
 
 namespace stan {
   namespace math {
@@ -14,7 +15,7 @@ namespace stan {
      * @return negation of argument value
      */
     inline bool operator!(const var& x) {
-      return !x.val();
+      return x == 0.0;
     }
 
   }
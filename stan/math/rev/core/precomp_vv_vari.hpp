@@ -2,27 +2,20 @@
 #define STAN_MATH_REV_CORE_PRECOMP_VV_VARI_HPP
 
 #include <stan/math/rev/core/vari.hpp>
-#include <stan/math/rev/core/vv_vari.hpp>
+#include <stan/math/rev/core/linear_tape.hpp>
 
 namespace stan {
   namespace math {
 
-    // use for single precomputed partials
-    class precomp_vv_vari : public op_vv_vari {
-    protected:
-      double da_;
-      double db_;
+    // use for single precomputed partials; propagated by grad() as a
+    // linear node rather than through chain()
+    class precomp_vv_vari : public vari {
     public:
       precomp_vv_vari(double val,
                        vari* avi, vari* bvi,
                        double da, double db)
-        : op_vv_vari(val, avi, bvi),
-          da_(da),
-          db_(db) {
-      }
-      void chain() {
-        avi_->adj_ += adj_ * da_;
-        bvi_->adj_ += adj_ * db_;
+        : vari(val, false) {
+        push_linear_node(this, avi, bvi, da, db);
       }
     };
 
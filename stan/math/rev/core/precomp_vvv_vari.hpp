@@ -2,30 +2,20 @@
 #define STAN_MATH_REV_CORE_PRECOMP_VVV_VARI_HPP
 
 #include <stan/math/rev/core/vari.hpp>
-#include <stan/math/rev/core/vvv_vari.hpp>
+#include <stan/math/rev/core/linear_tape.hpp>
 
 namespace stan {
   namespace math {
 
-    // use for single precomputed partials
-    class precomp_vvv_vari : public op_vvv_vari {
-    protected:
-      double da_;
-      double db_;
-      double dc_;
+    // use for single precomputed partials; propagated by grad() as a
+    // linear node rather than through chain()
+    class precomp_vvv_vari : public vari {
     public:
       precomp_vvv_vari(double val,
                        vari* avi, vari* bvi, vari* cvi,
                        double da, double db, double dc)
-        : op_vvv_vari(val, avi, bvi, cvi),
-          da_(da),
-          db_(db),
-          dc_(dc) {
-      }
-      void chain() {
-        avi_->adj_ += adj_ * da_;
-        bvi_->adj_ += adj_ * db_;
-        cvi_->adj_ += adj_ * dc_;
+        : vari(val, false) {
+        push_linear_node(this, avi, bvi, cvi, da, db, dc);
       }
     };
 
@@ -59,9 +59,9 @@ namespace stan {
                                  const std::vector<double>& gradients)
         : vari(val),
           size_(vars.size()),
-          varis_(ChainableStack::memalloc_
+          varis_(ChainableStack::instance().memalloc_
                  .alloc_array<vari*>(vars.size())),
-          gradients_(ChainableStack::memalloc_
+          gradients_(ChainableStack::instance().memalloc_
                      .alloc_array<double>(vars.size())) {
         check_consistent_sizes("precomputed_gradients_vari",
                                "vars", vars, "gradients", gradients);
@@ -4,6 +4,7 @@
 #include <stan/math/rev/core/chainablestack.hpp>
 #include <stan/math/rev/core/vari.hpp>
 #include <ostream>
+#include <vector>
 
 namespace stan {
   namespace math {
@@ -18,13 +19,14 @@ namespace stan {
      * @param o ostream to modify
      */
     inline void print_stack(std::ostream& o) {
-      o << "STACK, size=" << ChainableStack::var_stack_.size() << std::endl;
+      std::vector<vari*>& var_stack = ChainableStack::instance().var_stack_;
+      o << "STACK, size=" << var_stack.size() << std::endl;
       // TODO(carpenter): this shouldn't need to be cast any more
-      for (size_t i = 0; i < ChainableStack::var_stack_.size(); ++i)
+      for (size_t i = 0; i < var_stack.size(); ++i)
         o << i
-          << "  " << ChainableStack::var_stack_[i]
-          << "  " << (static_cast<vari*>(ChainableStack::var_stack_[i]))->val_
-          << " : " << (static_cast<vari*>(ChainableStack::var_stack_[i]))->adj_
+          << "  " << var_stack[i]
+          << "  " << (static_cast<vari*>(var_stack[i]))->val_
+          << " : " << (static_cast<vari*>(var_stack[i]))->adj_
           << std::endl;
     }
 
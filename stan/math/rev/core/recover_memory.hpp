@@ -19,13 +19,19 @@ namespace stan {
       if (!empty_nested())
         throw std::logic_error("empty_nested() must be true"
                                " before calling recover_memory()");
-      ChainableStack::var_stack_.clear();
-      ChainableStack::var_nochain_stack_.clear();
-      for (size_t i = 0; i < ChainableStack::var_alloc_stack_.size(); ++i) {
-        delete ChainableStack::var_alloc_stack_[i];
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      stack.var_stack_.clear();
+      stack.var_nochain_stack_.clear();
+      stack.op_results_.clear();
+      stack.op_stack_positions_.clear();
+      stack.op_arities_.clear();
+      stack.op_operands_.clear();
+      stack.op_partials_.clear();
+      for (size_t i = 0; i < stack.var_alloc_stack_.size(); ++i) {
+        delete stack.var_alloc_stack_[i];
       }
-      ChainableStack::var_alloc_stack_.clear();
-      ChainableStack::memalloc_.recover_all();
+      stack.var_alloc_stack_.clear();
+      stack.memalloc_.recover_all();
     }
 
   }
@@ -22,24 +22,33 @@ namespace stan {
         throw std::logic_error("empty_nested() must be false"
                                " before calling recover_memory_nested()");
 
-      ChainableStack::var_stack_
-        .resize(ChainableStack::nested_var_stack_sizes_.back());
-      ChainableStack::nested_var_stack_sizes_.pop_back();
-
-      ChainableStack::var_nochain_stack_
-        .resize(ChainableStack::nested_var_nochain_stack_sizes_.back());
-      ChainableStack::nested_var_nochain_stack_sizes_.pop_back();
-
-      for (size_t i = ChainableStack::nested_var_alloc_stack_starts_.back();
-           i < ChainableStack::var_alloc_stack_.size();
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      stack.var_stack_.resize(stack.nested_var_stack_sizes_.back());
+      stack.nested_var_stack_sizes_.pop_back();
+
+      stack.var_nochain_stack_
+        .resize(stack.nested_var_nochain_stack_sizes_.back());
+      stack.nested_var_nochain_stack_sizes_.pop_back();
+      size_t num_ops = stack.nested_op_sizes_.back();
+      stack.op_results_.resize(num_ops);
+      stack.op_stack_positions_.resize(num_ops);
+      stack.op_arities_.resize(num_ops);
+      stack.nested_op_sizes_.pop_back();
+      size_t num_operands = stack.nested_op_operand_sizes_.back();
+      stack.op_operands_.resize(num_operands);
+      stack.op_partials_.resize(num_operands);
+      stack.nested_op_operand_sizes_.pop_back();
+
+      for (size_t i = stack.nested_var_alloc_stack_starts_.back();
+           i < stack.var_alloc_stack_.size();
            ++i) {
-        delete ChainableStack::var_alloc_stack_[i];
+        delete stack.var_alloc_stack_[i];
       }
-      ChainableStack::var_alloc_stack_.resize
-        (ChainableStack::nested_var_alloc_stack_starts_.back());
-      ChainableStack::nested_var_alloc_stack_starts_.pop_back();
+      stack.var_alloc_stack_.resize
+        (stack.nested_var_alloc_stack_starts_.back());
+      stack.nested_var_alloc_stack_starts_.pop_back();
 
-      ChainableStack::memalloc_.recover_nested();
+      stack.memalloc_.recover_nested();
     }
 
   }
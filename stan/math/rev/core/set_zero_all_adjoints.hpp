@@ -12,10 +12,11 @@ namespace stan {
      * Reset all adjoint values in the stack to zero.
      */
     static void set_zero_all_adjoints() {
-      for (size_t i = 0; i < ChainableStack::var_stack_.size(); ++i)
-        ChainableStack::var_stack_[i]->set_zero_adjoint();
-      for (size_t i = 0; i < ChainableStack::var_nochain_stack_.size(); ++i)
-        ChainableStack::var_nochain_stack_[i]->set_zero_adjoint();
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      for (size_t i = 0; i < stack.var_stack_.size(); ++i)
+        stack.var_stack_[i]->set_zero_adjoint();
+      for (size_t i = 0; i < stack.var_nochain_stack_.size(); ++i)
+        stack.var_nochain_stack_[i]->set_zero_adjoint();
     }
 
   }
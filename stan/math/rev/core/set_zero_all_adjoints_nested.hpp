@@ -18,16 +18,17 @@ namespace stan {
       if (empty_nested())
         throw std::logic_error("empty_nested() must be false before calling"
                                " set_zero_all_adjoints_nested()");
-      size_t start1 = ChainableStack::nested_var_stack_sizes_.back();
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      size_t start1 = stack.nested_var_stack_sizes_.back();
       // avoid wrap with unsigned when start1 == 0
       for (size_t i = (start1 == 0U) ? 0U : (start1 - 1);
-           i < ChainableStack::var_stack_.size(); ++i)
-        ChainableStack::var_stack_[i]->set_zero_adjoint();
+           i < stack.var_stack_.size(); ++i)
+        stack.var_stack_[i]->set_zero_adjoint();
 
-      size_t start2 = ChainableStack::nested_var_nochain_stack_sizes_.back();
+      size_t start2 = stack.nested_var_nochain_stack_sizes_.back();
       for (size_t i = (start2 == 0U) ? 0U : (start2 - 1);
-           i < ChainableStack::var_nochain_stack_.size(); ++i) {
-        ChainableStack::var_nochain_stack_[i]->set_zero_adjoint();
+           i < stack.var_nochain_stack_.size(); ++i) {
+        stack.var_nochain_stack_[i]->set_zero_adjoint();
       }
     }
 
@@ -0,0 +1,102 @@
+#ifndef STAN_MATH_REV_CORE_STACK_STATS_HPP
+#define STAN_MATH_REV_CORE_STACK_STATS_HPP
+
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <cstdlib>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Memory statistics of the autodiff tape of the calling thread.
+     *
+     * The arena figures are those of the tape's
+     * <code>stack_alloc</code>; the stack figures are the sizes and
+     * retained capacities of the stacks of pointers to chainable
+     * variables and of the linear nodes.  A steady-state sequence of
+     * gradient evaluations allocates no memory once
+     * <code>num_blocks</code> is 1 and the capacities no longer change.
+     */
+    struct stack_stats {
+      /**
+       * Arena bytes in use.
+       */
+      size_t bytes_used;
+
+      /**
+       * Largest number of arena bytes in use so far.
+       */
+      size_t peak_bytes_used;
+
+      /**
+       * Arena bytes obtained from the heap.
+       */
+      size_t bytes_reserved;
+
+      /**
+       * Number of arena blocks.
+       */
+      size_t num_blocks;
+
+      /**
+       * Number of chainable variables on the stack.
+       */
+      size_t var_stack_size;
+
+      /**
+       * Retained capacity of the stack of chainable variables.
+       */
+      size_t var_stack_capacity;
+
+      /**
+       * Number of non-chaining variables on the stack.
+       */
+      size_t var_nochain_stack_size;
+
+      /**
+       * Retained capacity of the stack of non-chaining variables.
+       */
+      size_t var_nochain_stack_capacity;
+
+      /**
+       * Number of heap-allocated chainable objects on the stack.
+       */
+      size_t var_alloc_stack_size;
+
+      /**
+       * Number of linear nodes.
+       */
+      size_t linear_node_size;
+
+      /**
+       * Retained capacity of the linear nodes.
+       */
+      size_t linear_node_capacity;
+    };
+
+    /**
+     * Return the memory statistics of the autodiff tape of the
+     * calling thread.
+     *
+     * @return statistics of the autodiff tape
+     */
+    static inline stack_stats get_stack_stats() {
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      stack_stats stats;
+      stats.bytes_used = stack.memalloc_.bytes_used();
+      stats.peak_bytes_used = stack.memalloc_.peak_bytes_used();
+      stats.bytes_reserved = stack.memalloc_.bytes_reserved();
+      stats.num_blocks = stack.memalloc_.num_blocks();
+      stats.var_stack_size = stack.var_stack_.size();
+      stats.var_stack_capacity = stack.var_stack_.capacity();
+      stats.var_nochain_stack_size = stack.var_nochain_stack_.size();
+      stats.var_nochain_stack_capacity = stack.var_nochain_stack_.capacity();
+      stats.var_alloc_stack_size = stack.var_alloc_stack_.size();
+      stats.linear_node_size = stack.op_results_.size();
+      stats.linear_node_capacity = stack.op_results_.capacity();
+      return stats;
+    }
+
+  }
+}
+#endif
@@ -11,13 +11,15 @@ namespace stan {
      * can find it.
      */
     static inline void start_nested() {
-      ChainableStack::nested_var_stack_sizes_
-        .push_back(ChainableStack::var_stack_.size());
-      ChainableStack::nested_var_nochain_stack_sizes_
-        .push_back(ChainableStack::var_nochain_stack_.size());
-      ChainableStack::nested_var_alloc_stack_starts_
-        .push_back(ChainableStack::var_alloc_stack_.size());
-      ChainableStack::memalloc_.start_nested();
+      ChainableStack::AutodiffStackStorage& stack = ChainableStack::instance();
+      stack.nested_var_stack_sizes_.push_back(stack.var_stack_.size());
+      stack.nested_var_nochain_stack_sizes_
+        .push_back(stack.var_nochain_stack_.size());
+      stack.nested_var_alloc_stack_starts_
+        .push_back(stack.var_alloc_stack_.size());
+      stack.nested_op_sizes_.push_back(stack.op_results_.size());
+      stack.nested_op_operand_sizes_.push_back(stack.op_operands_.size());
+      stack.memalloc_.start_nested();
     }
 
   }
@@ -0,0 +1,171 @@
+#ifndef STAN_MATH_REV_CORE_TAPE_RECORDING_HPP
+#define STAN_MATH_REV_CORE_TAPE_RECORDING_HPP
+
+#include <stan/math/rev/core/chainablestack.hpp>
+#include <stan/math/rev/core/vari.hpp>
+#include <stan/math/prim/scal/meta/likely.hpp>
+#include <atomic>
+#include <cstdlib>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Operations of linear nodes which a <code>compiled_tape</code>
+     * can evaluate again for new values of its independent
+     * variables.  The suffixes <code>v</code> and <code>d</code>
+     * mark variable and constant operands.
+     */
+    enum replay_op {
+      REPLAY_ADD_VV,
+      REPLAY_ADD_VD,
+      REPLAY_SUBTRACT_VV,
+      REPLAY_SUBTRACT_VD,
+      REPLAY_SUBTRACT_DV,
+      REPLAY_MULTIPLY_VV,
+      REPLAY_MULTIPLY_VD,
+      REPLAY_DIVIDE_VV,
+      REPLAY_DIVIDE_VD,
+      REPLAY_DIVIDE_DV,
+      REPLAY_NEGATE,
+      REPLAY_SUM,
+      REPLAY_EXP,
+      REPLAY_EXPM1,
+      REPLAY_LOG,
+      REPLAY_LOG1P,
+      REPLAY_SQRT,
+      REPLAY_SQUARE,
+      REPLAY_INV_LOGIT,
+      REPLAY_LOG1P_EXP,
+      REPLAY_LOG_INV_LOGIT,
+      REPLAY_LOG1M_INV_LOGIT
+    };
+
+    /**
+     * Comparisons of variables, which decide the control flow of a
+     * recorded function.
+     */
+    enum replay_comparison {
+      COMPARE_LT,
+      COMPARE_LE,
+      COMPARE_GT,
+      COMPARE_GE,
+      COMPARE_EQ,
+      COMPARE_NE
+    };
+
+    /**
+     * The operations and comparisons evaluated while a tape is
+     * recorded for a <code>compiled_tape</code>.
+     *
+     * While a recording is installed on the calling thread's tape,
+     * the replayable operations tag the linear node they push with
+     * their <code>replay_op</code> and constant operand, and the
+     * comparison operators of <code>var</code> log their operands and
+     * outcome.  Linear nodes without a tag, and varis propagating
+     * through <code>chain()</code>, cannot be replayed.
+     */
+    struct tape_recording {
+      /**
+       * Indexes of the tagged linear nodes, in increasing order.
+       */
+      std::vector<size_t> nodes_;
+
+      /**
+       * Operation of each tagged linear node.
+       */
+      std::vector<int> ops_;
+
+      /**
+       * Constant operand of each tagged linear node, or zero.
+       */
+      std::vector<double> constants_;
+
+      /**
+       * Kind of each comparison.
+       */
+      std::vector<int> comparisons_;
+
+      /**
+       * Two operands of each comparison, null for constant operands.
+       */
+      std::vector<vari*> comparison_operands_;
+
+      /**
+       * Two constant operands of each comparison, used where the
+       * operand is null.
+       */
+      std::vector<double> comparison_constants_;
+
+      /**
+       * Outcome of each comparison.
+       */
+      std::vector<char> comparison_results_;
+    };
+
+    /**
+     * Return the number of recordings installed on the tapes of all
+     * threads.  While it is zero, comparisons need not look up the
+     * calling thread's tape.
+     *
+     * @return number of installed recordings
+     */
+    inline std::atomic<int>& num_tape_recordings() {
+      static std::atomic<int> num_recordings(0);
+      return num_recordings;
+    }
+
+    /**
+     * Tag the last linear node pushed on the specified tape with the
+     * specified operation, if a recording is installed.
+     *
+     * @param stack tape the node was pushed on, as returned by
+     * <code>push_linear_node()</code>
+     * @param op operation of node
+     * @param constant constant operand of operation
+     */
+    static inline void
+    record_replay_op(ChainableStack::AutodiffStackStorage& stack,
+                     replay_op op, double constant = 0) {
+      if (likely(stack.recording_ == 0))
+        return;
+      stack.recording_->nodes_.push_back(stack.op_results_.size() - 1);
+      stack.recording_->ops_.push_back(op);
+      stack.recording_->constants_.push_back(constant);
+    }
+
+    /**
+     * Log the specified comparison, if a recording is installed on
+     * the calling thread's tape, and return its outcome.
+     *
+     * @param cmp kind of comparison
+     * @param avi first operand, or null if constant
+     * @param a value of first operand
+     * @param bvi second operand, or null if constant
+     * @param b value of second operand
+     * @param result outcome of comparison
+     * @return outcome of comparison
+     */
+    static inline bool record_comparison(replay_comparison cmp,
+                                         vari* avi, double a,
+                                         vari* bvi, double b,
+                                         bool result) {
+      if (likely(num_tape_recordings().load(std::memory_order_relaxed)
+                 == 0))
+        return result;
+      tape_recording* recording = ChainableStack::instance().recording_;
+      if (recording == 0)
+        return result;
+      recording->comparisons_.push_back(cmp);
+      recording->comparison_operands_.push_back(avi);
+      recording->comparison_operands_.push_back(bvi);
+      recording->comparison_constants_.push_back(a);
+      recording->comparison_constants_.push_back(b);
+      recording->comparison_results_.push_back(result);
+      return result;
+    }
+
+  }
+}
+#endif
@@ -58,16 +58,16 @@ namespace stan {
       explicit vari(double x):
         val_(x),
         adj_(0.0) {
-        ChainableStack::var_stack_.push_back(this);
+        ChainableStack::instance().var_stack_.push_back(this);
       }
 
       vari(double x, bool stacked):
         val_(x),
         adj_(0.0) {
         if (stacked)
-          ChainableStack::var_stack_.push_back(this);
+          ChainableStack::instance().var_stack_.push_back(this);
         else
-          ChainableStack::var_nochain_stack_.push_back(this);
+          ChainableStack::instance().var_nochain_stack_.push_back(this);
       }
 
       /**
@@ -102,9 +102,11 @@ namespace stan {
       /**
        * Set the adjoint value of this variable to 0.  This is used to
        * reset adjoints before propagating derivatives again (for
-       * example in a Jacobian calculation).
+       * example in a Jacobian calculation).  Nodes holding more than
+       * one adjoint, such as those of matrix variables, reset all of
+       * them.
        */
-      void set_zero_adjoint() {
+      virtual void set_zero_adjoint() {
         adj_ = 0.0;
       }
 
@@ -132,7 +134,7 @@ namespace stan {
        * @return Pointer to allocated bytes.
        */
       static inline void* operator new(size_t nbytes) {
-        return ChainableStack::memalloc_.alloc(nbytes);
+        return ChainableStack::instance().memalloc_.alloc(nbytes);
       }
 
       /**
@@ -12,15 +12,28 @@
 #include <stan/math/prim/mat.hpp>
 #include <stan/math/rev/arr.hpp>
 
+#include <stan/math/rev/mat/fun/add.hpp>
 #include <stan/math/rev/mat/fun/cholesky_decompose.hpp>
 #include <stan/math/rev/mat/fun/columns_dot_product.hpp>
 #include <stan/math/rev/mat/fun/columns_dot_self.hpp>
 #include <stan/math/rev/mat/fun/cov_exp_quad.hpp>
 #include <stan/math/rev/mat/fun/crossprod.hpp>
+#include <stan/math/rev/mat/fun/csr_matrix_times_vector.hpp>
 #include <stan/math/rev/mat/fun/determinant.hpp>
 #include <stan/math/rev/mat/fun/divide.hpp>
 #include <stan/math/rev/mat/fun/dot_product.hpp>
 #include <stan/math/rev/mat/fun/dot_self.hpp>
+#include <stan/math/rev/mat/fun/gp_cholesky.hpp>
+#include <stan/math/rev/mat/fun/gp_cov.hpp>
+#include <stan/math/rev/mat/fun/gp_dot_prod_cov.hpp>
+#include <stan/math/rev/mat/fun/gp_exp_quad_cholesky.hpp>
+#include <stan/math/rev/mat/fun/gp_kernels.hpp>
+#include <stan/math/rev/mat/fun/gp_matern32_cholesky.hpp>
+#include <stan/math/rev/mat/fun/gp_matern32_cov.hpp>
+#include <stan/math/rev/mat/fun/gp_matern52_cholesky.hpp>
+#include <stan/math/rev/mat/fun/gp_matern52_cov.hpp>
+#include <stan/math/rev/mat/fun/gp_periodic_cholesky.hpp>
+#include <stan/math/rev/mat/fun/gp_periodic_cov.hpp>
 #include <stan/math/rev/mat/fun/grad.hpp>
 #include <stan/math/rev/mat/fun/initialize_variable.hpp>
 #include <stan/math/rev/mat/fun/LDLT_alloc.hpp>
@@ -43,6 +56,7 @@
 #include <stan/math/rev/mat/fun/softmax.hpp>
 #include <stan/math/rev/mat/fun/squared_distance.hpp>
 #include <stan/math/rev/mat/fun/stan_print.hpp>
+#include <stan/math/rev/mat/fun/subtract.hpp>
 #include <stan/math/rev/mat/fun/sum.hpp>
 #include <stan/math/rev/mat/fun/tcrossprod.hpp>
 #include <stan/math/rev/mat/fun/to_var.hpp>
@@ -50,14 +64,22 @@
 #include <stan/math/rev/mat/fun/trace_gen_quad_form.hpp>
 #include <stan/math/rev/mat/fun/trace_inv_quad_form_ldlt.hpp>
 #include <stan/math/rev/mat/fun/trace_quad_form.hpp>
+#include <stan/math/rev/mat/fun/transpose.hpp>
 #include <stan/math/rev/mat/fun/typedefs.hpp>
 #include <stan/math/rev/mat/fun/variance.hpp>
 #include <stan/math/rev/mat/functor/algebra_solver.hpp>
+#include <stan/math/rev/mat/functor/compiled_tape.hpp>
 #include <stan/math/rev/mat/functor/gradient.hpp>
 #include <stan/math/rev/mat/functor/jacobian.hpp>
+#include <stan/math/rev/mat/functor/map_rect_combine.hpp>
+#include <stan/math/rev/mat/functor/map_rect_reduce.hpp>
 #include <stan/math/rev/mat/functor/ode_system.hpp>
 #include <stan/math/rev/mat/functor/cvodes_utils.hpp>
 #include <stan/math/rev/mat/functor/cvodes_ode_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_integrator.hpp>
+#include <stan/math/rev/mat/functor/cvodes_adjoint_data.hpp>
 #include <stan/math/rev/mat/functor/integrate_ode_bdf.hpp>
+#include <stan/math/rev/mat/functor/integrate_ode_bdf_batch.hpp>
+#include <stan/math/rev/mat/functor/integrate_ode_adjoint.hpp>
 
 #endif
@@ -44,9 +44,9 @@ namespace stan {
                      const Eigen::Matrix<double, -1, -1>& L_A)
         : vari(0.0),
           M_(A.rows()),
-          variRefA_(ChainableStack::memalloc_.alloc_array<vari*>
+          variRefA_(ChainableStack::instance().memalloc_.alloc_array<vari*>
                     (A.rows() * (A.rows() + 1) / 2)),
-          variRefL_(ChainableStack::memalloc_.alloc_array<vari*>
+          variRefL_(ChainableStack::instance().memalloc_.alloc_array<vari*>
                     (A.rows() * (A.rows() + 1) / 2)) {
             size_t pos = 0;
             block_size_ = std::max((M_ / 8 / 16) * 16, 8);
@@ -65,8 +65,8 @@ namespace stan {
        * @param L cholesky factor
        * @param Lbar matrix of adjoints of L
        */
-      inline void symbolic_rev(Block_& L,
-                               Block_& Lbar) {
+      inline static void symbolic_rev(Block_& L,
+                                      Block_& Lbar) {
         using Eigen::Lower;
         using Eigen::Upper;
         using Eigen::StrictlyUpper;
@@ -79,41 +79,35 @@ namespace stan {
       }
 
       /**
+       * Replace the adjoints of a Cholesky factor with those of the
+       * lower triangular part of the factored matrix, working on
+       * blocks of the specified size.
+       *
        * Reverse mode differentiation algorithm refernce:
        *
        * Iain Murray: Differentiation of the Cholesky decomposition, 2016.
        *
+       * @param[in,out] L cholesky factor, overwritten
+       * @param[in,out] Lbar lower triangular adjoints of L, replaced by
+       * the adjoints of the lower triangular part of the matrix
+       * @param block_size number of rows of a block
        */
-      virtual void chain() {
-        using Eigen::MatrixXd;
+      static void blocked_rev(Eigen::MatrixXd& L, Eigen::MatrixXd& Lbar,
+                              int block_size) {
         using Eigen::Lower;
-        using Eigen::Block;
         using Eigen::Upper;
         using Eigen::StrictlyUpper;
-        MatrixXd Lbar(M_, M_);
-        MatrixXd L(M_, M_);
-
-        Lbar.setZero();
-        L.setZero();
-        size_t pos = 0;
-        for (size_type j = 0; j < M_; ++j) {
-          for (size_type i = j; i < M_; ++i) {
-            Lbar.coeffRef(i, j) = variRefL_[pos]->adj_;
-            L.coeffRef(i, j) = variRefL_[pos]->val_;
-            ++pos;
-          }
-        }
-
-        for (int k = M_; k > 0; k -= block_size_) {
-          int j = std::max(0, k - block_size_);
+        int M = L.rows();
+        for (int k = M; k > 0; k -= block_size) {
+          int j = std::max(0, k - block_size);
           Block_ R = L.block(j, 0, k - j, j);
           Block_ D = L.block(j, j, k - j, k - j);
-          Block_ B = L.block(k, 0, M_ - k, j);
-          Block_ C = L.block(k, j, M_ - k, k - j);
+          Block_ B = L.block(k, 0, M - k, j);
+          Block_ C = L.block(k, j, M - k, k - j);
           Block_ Rbar = Lbar.block(j, 0, k - j, j);
           Block_ Dbar = Lbar.block(j, j, k - j, k - j);
-          Block_ Bbar = Lbar.block(k, 0, M_ - k, j);
-          Block_ Cbar = Lbar.block(k, j, M_ - k, k - j);
+          Block_ Bbar = Lbar.block(k, 0, M - k, j);
+          Block_ Cbar = Lbar.block(k, j, M - k, k - j);
           if (Cbar.size() > 0) {
             Cbar
               = D.transpose().triangularView<Upper>()
@@ -127,6 +121,31 @@ namespace stan {
           Dbar.diagonal() *= 0.5;
           Dbar.triangularView<StrictlyUpper>().setZero();
         }
+      }
+
+      /**
+       * Reverse mode differentiation algorithm refernce:
+       *
+       * Iain Murray: Differentiation of the Cholesky decomposition, 2016.
+       *
+       */
+      virtual void chain() {
+        using Eigen::MatrixXd;
+        MatrixXd Lbar(M_, M_);
+        MatrixXd L(M_, M_);
+
+        Lbar.setZero();
+        L.setZero();
+        size_t pos = 0;
+        for (size_type j = 0; j < M_; ++j) {
+          for (size_type i = j; i < M_; ++i) {
+            Lbar.coeffRef(i, j) = variRefL_[pos]->adj_;
+            L.coeffRef(i, j) = variRefL_[pos]->val_;
+            ++pos;
+          }
+        }
+
+        blocked_rev(L, Lbar, block_size_);
         pos = 0;
         for (size_type j = 0; j < M_; ++j)
           for (size_type i = j; i < M_; ++i)
@@ -158,9 +177,9 @@ namespace stan {
                       const Eigen::Matrix<double, -1, -1>& L_A)
         : vari(0.0),
           M_(A.rows()),
-          variRefA_(ChainableStack::memalloc_.alloc_array<vari*>
+          variRefA_(ChainableStack::instance().memalloc_.alloc_array<vari*>
                     (A.rows() * (A.rows() + 1) / 2)),
-          variRefL_(ChainableStack::memalloc_.alloc_array<vari*>
+          variRefL_(ChainableStack::instance().memalloc_.alloc_array<vari*>
                     (A.rows() * (A.rows() + 1) / 2)) {
         size_t accum = 0;
         size_t accum_i = accum;
@@ -227,6 +246,27 @@ namespace stan {
       }
     };
 
+    namespace {
+      class cholesky_matrix_var_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* A_;
+
+        cholesky_matrix_var_vari(matrix_var_vari* A,
+                                 const Eigen::MatrixXd& L_A)
+          : matrix_var_vari(L_A), A_(A) { }
+
+        virtual void chain() {
+          using Eigen::Lower;
+          int M = values_.rows();
+          int block_size = std::min(std::max((M / 8 / 16) * 16, 8), 128);
+          Eigen::MatrixXd L = values_;
+          Eigen::MatrixXd Lbar = adjoints_.triangularView<Lower>();
+          cholesky_block::blocked_rev(L, Lbar, block_size);
+          A_->adjoints_.triangularView<Lower>() += Lbar;
+        }
+      };
+    }
+
     /**
      * Reverse mode specialization of cholesky decomposition
      *
@@ -282,6 +322,30 @@ namespace stan {
       }
       return L;
     }
+
+    /**
+     * Return the lower triangular Cholesky factor of a symmetric,
+     * positive definite matrix variable.
+     *
+     * The gradient is computed with the blocked algorithm of
+     * <code>cholesky_block</code> on the whole factor, whatever its
+     * size, and propagated to the lower triangular part of A, as for
+     * a matrix of scalar variables.
+     *
+     * @param A matrix
+     * @return L cholesky factor of A
+     * @throw std::domain_error if A is not square, symmetric and
+     * positive definite
+     */
+    inline matrix_var cholesky_decompose(const matrix_var& A) {
+      Eigen::MatrixXd L_A(A.val());
+      check_square("cholesky_decompose", "A", L_A);
+      check_symmetric("cholesky_decompose", "A", L_A);
+      Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>, Eigen::Lower> L_factor(L_A);
+      check_pos_definite("cholesky_decompose", "m", L_factor);
+      L_A.triangularView<Eigen::StrictlyUpper>().setZero();
+      return matrix_var(new cholesky_matrix_var_vari(A.vi_, L_A));
+    }
   }
 }
 #endif
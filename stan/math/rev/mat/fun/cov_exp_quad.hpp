@@ -72,10 +72,13 @@ namespace stan {
           size_ltri_(size_ * (size_ - 1) / 2),
           l_d_(value_of(l)), sigma_d_(value_of(sigma)),
           sigma_sq_d_(sigma_d_ * sigma_d_),
-          dist_(ChainableStack::memalloc_.alloc_array<double>(size_ltri_)),
+          dist_(ChainableStack::instance().memalloc_.alloc_array<double>(
+              size_ltri_)),
           l_vari_(l.vi_), sigma_vari_(sigma.vi_),
-          cov_lower_(ChainableStack::memalloc_.alloc_array<vari*>(size_ltri_)),
-          cov_diag_(ChainableStack::memalloc_.alloc_array<vari*>(size_)) {
+          cov_lower_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_ltri_)),
+          cov_diag_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_)) {
         double inv_half_sq_l_d = 0.5 / (l_d_ * l_d_);
         size_t pos = 0;
         for (size_t j = 0; j < size_ - 1; ++j) {
@@ -162,10 +165,13 @@ namespace stan {
           size_ltri_(size_ * (size_ - 1) / 2),
           l_d_(value_of(l)), sigma_d_(value_of(sigma)),
           sigma_sq_d_(sigma_d_ * sigma_d_),
-          dist_(ChainableStack::memalloc_.alloc_array<double>(size_ltri_)),
+          dist_(ChainableStack::instance().memalloc_.alloc_array<double>(
+              size_ltri_)),
           l_vari_(l.vi_),
-          cov_lower_(ChainableStack::memalloc_.alloc_array<vari*>(size_ltri_)),
-          cov_diag_(ChainableStack::memalloc_.alloc_array<vari*>(size_)) {
+          cov_lower_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_ltri_)),
+          cov_diag_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_)) {
         double inv_half_sq_l_d = 0.5 / (l_d_ * l_d_);
         size_t pos = 0;
         for (size_t j = 0; j < size_ - 1; ++j) {
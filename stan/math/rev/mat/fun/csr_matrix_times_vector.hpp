@@ -0,0 +1,266 @@
+#ifndef STAN_MATH_REV_MAT_FUN_CSR_MATRIX_TIMES_VECTOR_HPP
+#define STAN_MATH_REV_MAT_FUN_CSR_MATRIX_TIMES_VECTOR_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/csr_matrix_times_vector.hpp>
+#include <stan/math/prim/mat/fun/csr_u_to_z.hpp>
+#include <stan/math/prim/mat/fun/typedefs.hpp>
+#include <stan/math/prim/mat/err/check_range.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <stan/math/prim/scal/meta/is_constant.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/typedefs.hpp>
+#include <stan/math/rev/scal/fun/value_of.hpp>
+#include <Eigen/Sparse>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    namespace {
+      /**
+       * Product of a sparse matrix in compressed sparse row format
+       * and a dense vector, with a single node for the whole
+       * product.
+       *
+       * The structure and values of the matrix and the values of the
+       * vector are copied into the arena, and the product and its
+       * gradient are computed with the sparse kernels of Eigen: the
+       * adjoint of the vector is the transpose of the matrix times
+       * the adjoint of the result, and the adjoint of a non-zero
+       * value is the adjoint of its row of the result times the
+       * element of the vector in its column.
+       *
+       * The elements of the result are not on the stack.
+       *
+       * @tparam T1 type of the non-zero values, var or double
+       * @tparam T2 type of the vector, var or double
+       */
+      template <typename T1, typename T2>
+      class csr_matrix_times_vector_vari : public vari {
+      public:
+        typedef Eigen::Map<const Eigen::SparseMatrix<double,
+                                                     Eigen::RowMajor> >
+          sparse_map_t;
+
+        int m_;
+        int n_;
+        int nnz_;
+        int* u_;
+        int* v_;
+        double* w_;
+        double* b_;
+        vari** w_vis_;
+        vari** b_vis_;
+        vari** result_vis_;
+
+        /**
+         * Construct the product from zero-based row starts and
+         * column indexes.
+         *
+         * @param m number of rows
+         * @param n number of columns
+         * @param u position of the start of each row in w, followed by
+         * the end of the last row
+         * @param v column of each non-zero value
+         * @param w non-zero values
+         * @param b vector
+         */
+        template <typename Derived1, typename Derived2>
+        csr_matrix_times_vector_vari(int m, int n, const int* u,
+                                     const int* v,
+                                     const Eigen::DenseBase<Derived1>& w,
+                                     const Eigen::DenseBase<Derived2>& b)
+          : vari(0.0), m_(m), n_(n), nnz_(w.size()),
+            u_(ChainableStack::instance().memalloc_
+               .alloc_array<int>(m + 1)),
+            v_(ChainableStack::instance().memalloc_
+               .alloc_array<int>(w.size())),
+            w_(ChainableStack::instance().memalloc_
+               .alloc_array<double>(w.size())),
+            b_(ChainableStack::instance().memalloc_
+               .alloc_array<double>(n)),
+            w_vis_(0), b_vis_(0),
+            result_vis_(ChainableStack::instance().memalloc_
+                        .alloc_array<vari*>(m)) {
+          for (int i = 0; i <= m; ++i)
+            u_[i] = u[i];
+          for (int k = 0; k < nnz_; ++k) {
+            v_[k] = v[k];
+            w_[k] = value_of(w(k));
+          }
+          for (int j = 0; j < n; ++j)
+            b_[j] = value_of(b(j));
+          if (!is_constant<T1>::value) {
+            w_vis_ = ChainableStack::instance().memalloc_
+              .alloc_array<vari*>(nnz_);
+            for (int k = 0; k < nnz_; ++k)
+              w_vis_[k] = var_vi(w(k));
+          }
+          if (!is_constant<T2>::value) {
+            b_vis_ = ChainableStack::instance().memalloc_
+              .alloc_array<vari*>(n);
+            for (int j = 0; j < n; ++j)
+              b_vis_[j] = var_vi(b(j));
+          }
+
+          Eigen::VectorXd result
+            = matrix() * Eigen::Map<const Eigen::VectorXd>(b_, n_);
+          for (int i = 0; i < m; ++i)
+            result_vis_[i] = new vari(result(i), false);
+        }
+
+        sparse_map_t matrix() const {
+          return sparse_map_t(m_, n_, nnz_, u_, v_, w_);
+        }
+
+        virtual void chain() {
+          Eigen::VectorXd adj_result(m_);
+          for (int i = 0; i < m_; ++i)
+            adj_result(i) = result_vis_[i]->adj_;
+
+          if (!is_constant<T2>::value) {
+            Eigen::VectorXd adj_b = matrix().transpose() * adj_result;
+            for (int j = 0; j < n_; ++j)
+              b_vis_[j]->adj_ += adj_b(j);
+          }
+          if (!is_constant<T1>::value) {
+            for (int i = 0; i < m_; ++i)
+              for (int k = u_[i]; k < u_[i + 1]; ++k)
+                w_vis_[k]->adj_ += adj_result(i) * b_[v_[k]];
+          }
+        }
+
+      private:
+        static vari* var_vi(double) {
+          return 0;
+        }
+
+        static vari* var_vi(const var& x) {
+          return x.vi_;
+        }
+      };
+
+      template <typename T1, typename T2>
+      inline vector_v
+      csr_matrix_times_vector_rev(int m, int n,
+                                  const Eigen::Matrix<T1, -1, 1>& w,
+                                  const std::vector<int>& v,
+                                  const std::vector<int>& u,
+                                  const Eigen::Matrix<T2, -1, 1>& b) {
+        check_positive("csr_matrix_times_vector", "m", m);
+        check_positive("csr_matrix_times_vector", "n", n);
+        check_size_match("csr_matrix_times_vector", "n", n, "b", b.size());
+        check_size_match("csr_matrix_times_vector", "m", m,
+                         "u", u.size() - 1);
+        check_size_match("csr_matrix_times_vector", "w", w.size(),
+                         "v", v.size());
+        check_size_match("csr_matrix_times_vector", "u/z",
+                         u[m - 1] + csr_u_to_z(u, m - 1) - 1,
+                         "v", v.size());
+        for (unsigned int i = 0; i < v.size(); ++i)
+          check_range("csr_matrix_times_vector", "v[]", n, v[i]);
+
+        std::vector<int> u_zero(u.size());
+        for (size_t i = 0; i < u.size(); ++i)
+          u_zero[i] = u[i] - stan::error_index::value;
+        std::vector<int> v_zero(v.size());
+        for (size_t k = 0; k < v.size(); ++k)
+          v_zero[k] = v[k] - stan::error_index::value;
+
+        csr_matrix_times_vector_vari<T1, T2>* baseVari
+          = new csr_matrix_times_vector_vari<T1, T2>(m, n, u_zero.data(),
+                                                     v_zero.data(), w, b);
+        vector_v result(m);
+        for (int i = 0; i < m; ++i)
+          result(i).vi_ = baseVari->result_vis_[i];
+        return result;
+      }
+    }
+
+    /**
+     * Return the product of a sparse matrix in compressed sparse row
+     * format and a dense vector, see the double version for the
+     * arguments.
+     *
+     * One node is added to the expression graph for the whole
+     * product rather than one for each non-zero value, and the
+     * gradients of the values and of the vector are computed with
+     * sparse kernels.
+     *
+     * @param m Number of rows in matrix.
+     * @param n Number of columns in matrix.
+     * @param w Vector of non-zero values in matrix.
+     * @param v Column index of each non-zero value, same
+     *          length as w.
+     * @param u Index of where each row starts in w, length equal to
+     *          the number of rows plus one.
+     * @param b Eigen vector which the matrix is multiplied by.
+     * @return Dense vector for the product.
+     */
+    /** \addtogroup csr_format
+     */
+    inline vector_v
+    csr_matrix_times_vector(int m, int n, const vector_v& w,
+                            const std::vector<int>& v,
+                            const std::vector<int>& u, const vector_v& b) {
+      return csr_matrix_times_vector_rev(m, n, w, v, u, b);
+    }
+
+    inline vector_v
+    csr_matrix_times_vector(int m, int n, const vector_d& w,
+                            const std::vector<int>& v,
+                            const std::vector<int>& u, const vector_v& b) {
+      return csr_matrix_times_vector_rev(m, n, w, v, u, b);
+    }
+
+    inline vector_v
+    csr_matrix_times_vector(int m, int n, const vector_v& w,
+                            const std::vector<int>& v,
+                            const std::vector<int>& u, const vector_d& b) {
+      return csr_matrix_times_vector_rev(m, n, w, v, u, b);
+    }
+
+    /**
+     * Return the product of a sparse matrix of data and a dense
+     * vector of variables.
+     *
+     * The structure of the matrix is read directly from its
+     * compressed storage, without extracting the one-based indexes,
+     * and one node is added to the expression graph for the whole
+     * product.
+     *
+     * @param A sparse matrix
+     * @param b vector
+     * @return Dense vector for the product.
+     * @throw std::invalid_argument if the columns of A do not match
+     * the size of b
+     */
+    inline vector_v
+    csr_matrix_times_vector(const Eigen::SparseMatrix<double,
+                                                      Eigen::RowMajor>& A,
+                            const vector_v& b) {
+      check_size_match("csr_matrix_times_vector", "n", A.cols(),
+                       "b", b.size());
+      if (!A.isCompressed()) {
+        Eigen::SparseMatrix<double, Eigen::RowMajor> A_compressed(A);
+        A_compressed.makeCompressed();
+        return csr_matrix_times_vector(A_compressed, b);
+      }
+      Eigen::Map<const Eigen::VectorXd> w(A.valuePtr(), A.nonZeros());
+      csr_matrix_times_vector_vari<double, var>* baseVari
+        = new csr_matrix_times_vector_vari<double, var>(
+            A.rows(), A.cols(), A.outerIndexPtr(), A.innerIndexPtr(),
+            w, b);
+      vector_v result(A.rows());
+      for (int i = 0; i < A.rows(); ++i)
+        result(i).vi_ = baseVari->result_vis_[i];
+      return result;
+    }
+    /** @}*/   // end of csr_format group
+
+  }
+}
+#endif
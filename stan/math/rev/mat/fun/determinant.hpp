@@ -25,10 +25,10 @@ namespace stan {
             rows_(A.rows()),
             cols_(A.cols()),
             A_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * A.rows() * A.cols()))),
             adjARef_(reinterpret_cast<vari**>
-                     (ChainableStack::memalloc_
+                     (ChainableStack::instance().memalloc_
                       .alloc(sizeof(vari*) * A.rows() * A.cols()))) {
           size_t pos = 0;
           for (size_type j = 0; j < cols_; j++) {
@@ -86,7 +86,8 @@ namespace stan {
         inline void initialize(vari** &mem_v, const var *inv,
                                vari **shared = NULL) {
           if (shared == NULL) {
-            mem_v = reinterpret_cast<vari**>(ChainableStack::memalloc_
+            mem_v = reinterpret_cast<vari**>(ChainableStack::instance()
+                .memalloc_
                                              .alloc(length_*sizeof(vari*)));
             for (size_t i = 0; i < length_; i++)
               mem_v[i] = inv[i].vi_;
@@ -99,7 +100,8 @@ namespace stan {
                                const Eigen::DenseBase<Derived> &inv,
                                vari **shared = NULL) {
           if (shared == NULL) {
-            mem_v = reinterpret_cast<vari**>(ChainableStack::memalloc_
+            mem_v = reinterpret_cast<vari**>(ChainableStack::instance()
+                .memalloc_
                                              .alloc(length_*sizeof(vari*)));
             for (size_t i = 0; i < length_; i++)
               mem_v[i] = inv(i).vi_;
@@ -111,7 +113,8 @@ namespace stan {
         inline void initialize(double* &mem_d, const double *ind,
                                double *shared = NULL) {
           if (shared == NULL) {
-            mem_d = reinterpret_cast<double*>(ChainableStack::memalloc_
+            mem_d = reinterpret_cast<double*>(ChainableStack::instance()
+                .memalloc_
                                               .alloc(length_*sizeof(double)));
             for (size_t i = 0; i < length_; i++)
               mem_d[i] = ind[i];
@@ -125,7 +128,8 @@ namespace stan {
                                double *shared = NULL) {
           if (shared == NULL) {
             mem_d = reinterpret_cast<double*>
-              (ChainableStack::memalloc_.alloc(length_*sizeof(double)));
+              (ChainableStack::instance().memalloc_
+               .alloc(length_*sizeof(double)));
             for (size_t i = 0; i < length_; i++)
               mem_d[i] = ind(i);
           } else {
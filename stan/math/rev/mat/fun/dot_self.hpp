@@ -26,7 +26,7 @@ namespace stan {
         template<typename Derived>
         explicit dot_self_vari(const Eigen::DenseBase<Derived> &v) :
           vari(var_dot_self(v)), size_(v.size()) {
-          v_ = reinterpret_cast<vari**>(ChainableStack::memalloc_
+          v_ = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                         .alloc(size_*sizeof(vari*)));
           for (size_t i = 0; i < size_; i++)
             v_[i] = v[i].vi_;
@@ -35,7 +35,7 @@ namespace stan {
         explicit dot_self_vari(const Eigen::Matrix<var, R, C>& v) :
           vari(var_dot_self(v)), size_(v.size()) {
           v_ = reinterpret_cast<vari**>
-            (ChainableStack::memalloc_.alloc(size_ * sizeof(vari*)));
+            (ChainableStack::instance().memalloc_.alloc(size_ * sizeof(vari*)));
           for (size_t i = 0; i < size_; ++i)
             v_[i] = v(i).vi_;
         }
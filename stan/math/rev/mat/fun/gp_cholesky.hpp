@@ -0,0 +1,154 @@
+#ifndef STAN_MATH_REV_MAT_FUN_GP_CHOLESKY_HPP
+#define STAN_MATH_REV_MAT_FUN_GP_CHOLESKY_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/cholesky_decompose.hpp>
+#include <stan/math/rev/mat/fun/gp_cov.hpp>
+#include <stan/math/rev/mat/fun/gp_kernels.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/err/check_pos_definite.hpp>
+#include <algorithm>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * This is a subclass of the vari class for the Cholesky factor
+     * of the covariance matrix of a kernel.
+     *
+     * The class stores the statistics of each pair of inputs once,
+     * with pointers to the varis for the lower triangular part of
+     * the factor, which are on the var_nochain_stack_.  The
+     * covariance matrix itself has no varis: in the reverse pass the
+     * adjoints of the factor are replaced by those of the covariance
+     * matrix with the blocked algorithm of cholesky_block, and
+     * reduced to the gradients with respect to the hyperparameters.
+     *
+     * @tparam K type of kernel
+     */
+    template <class K>
+    class gp_cholesky_vari : public vari {
+    public:
+      const int size_;
+      const K kernel_;
+      double* stats_;
+      vari** L_;
+
+      /**
+       * Constructor for gp_cholesky.
+       *
+       * All memory allocated in
+       * ChainableStack's stack_alloc arena.
+       *
+       * @param kernel kernel
+       * @param stats statistics of the pairs of inputs, from
+       * gp_stats()
+       * @param L_A Cholesky factor of the covariance matrix
+       */
+      gp_cholesky_vari(const K& kernel, double* stats,
+                       const Eigen::MatrixXd& L_A)
+        : vari(0.0),
+          size_(L_A.rows()),
+          kernel_(kernel),
+          stats_(stats),
+          L_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_ * (size_ + 1) / 2)) {
+        size_t pos = 0;
+        for (int j = 0; j < size_; ++j)
+          for (int i = j; i < size_; ++i)
+            L_[pos++] = new vari(L_A.coeff(i, j), false);
+      }
+
+      virtual void chain() {
+        using Eigen::MatrixXd;
+        MatrixXd Lbar(size_, size_);
+        MatrixXd L(size_, size_);
+        Lbar.setZero();
+        L.setZero();
+        size_t pos = 0;
+        for (int j = 0; j < size_; ++j) {
+          for (int i = j; i < size_; ++i) {
+            Lbar.coeffRef(i, j) = L_[pos]->adj_;
+            L.coeffRef(i, j) = L_[pos]->val_;
+            ++pos;
+          }
+        }
+
+        int block_size = std::min(std::max((size_ / 8 / 16) * 16, 8), 128);
+        cholesky_block::blocked_rev(L, Lbar, block_size);
+
+        double grad[K::num_params] = { 0 };
+        const double* s = stats_;
+        for (int j = 0; j < size_; ++j) {
+          for (int i = j; i < size_; ++i) {
+            kernel_.grad(s, kernel_.value(s), Lbar.coeff(i, j), grad);
+            s += K::num_stats;
+          }
+        }
+        for (int m = 0; m < K::num_params; ++m) {
+          vari* vi = kernel_.param(m);
+          if (vi)
+            vi->adj_ += grad[m];
+        }
+      }
+    };
+
+    /**
+     * Returns the lower triangular Cholesky factor of the covariance
+     * matrix of the specified kernel at the specified inputs, with
+     * <code>delta</code> added to its diagonal.
+     *
+     * Only the factor has varis, and the gradient with respect to
+     * the hyperparameters of the kernel is computed on a single
+     * node, where <code>cholesky_decompose(gp_cov(x, kernel))</code>
+     * also keeps varis and pointers for the covariance matrix.
+     *
+     * Neither the inputs nor the hyperparameters are checked.
+     *
+     * @tparam T_x type of inputs, double or vector of doubles
+     * @tparam K type of kernel
+     * @param x std::vector of inputs
+     * @param kernel kernel
+     * @param delta nugget added to the diagonal
+     * @return lower triangular Cholesky factor
+     * @throw std::domain_error if the covariance matrix is not
+     * positive definite
+     */
+    template <typename T_x, class K>
+    inline Eigen::Matrix<var, -1, -1>
+    gp_cholesky(const std::vector<T_x>& x, const K& kernel, double delta) {
+      int x_size = x.size();
+      Eigen::Matrix<var, -1, -1> L(x_size, x_size);
+      if (x_size == 0)
+        return L;
+
+      double* stats = gp_stats(x, kernel);
+      Eigen::MatrixXd L_A(x_size, x_size);
+      const double* s = stats;
+      for (int j = 0; j < x_size; ++j) {
+        for (int i = j; i < x_size; ++i) {
+          L_A.coeffRef(i, j) = kernel.value(s);
+          s += K::num_stats;
+        }
+        L_A.coeffRef(j, j) += delta;
+      }
+      Eigen::LLT<Eigen::Ref<Eigen::MatrixXd>, Eigen::Lower> L_factor(L_A);
+      check_pos_definite("gp_cholesky", "covariance matrix", L_factor);
+
+      gp_cholesky_vari<K>* baseVari
+        = new gp_cholesky_vari<K>(kernel, stats, L_A);
+      vari* dummy = new vari(0.0, false);
+      size_t pos = 0;
+      for (int j = 0; j < x_size; ++j) {
+        for (int i = j; i < x_size; ++i)
+          L.coeffRef(i, j).vi_ = baseVari->L_[pos++];
+        for (int k = 0; k < j; ++k)
+          L.coeffRef(k, j).vi_ = dummy;
+      }
+      return L;
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,139 @@
+#ifndef STAN_MATH_REV_MAT_FUN_GP_COV_HPP
+#define STAN_MATH_REV_MAT_FUN_GP_COV_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/fun/gp_kernels.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Return the statistics of the specified kernel for each pair
+     * of inputs in the lower triangular part of the covariance
+     * matrix, in column-major order, allocated in the arena.
+     *
+     * @tparam T_x type of inputs, double or vector of doubles
+     * @tparam K type of kernel
+     * @param x std::vector of inputs
+     * @param kernel kernel
+     * @return array of K::num_stats statistics for each pair
+     */
+    template <typename T_x, class K>
+    inline double* gp_stats(const std::vector<T_x>& x, const K& kernel) {
+      size_t x_size = x.size();
+      double* stats = ChainableStack::instance().memalloc_
+        .alloc_array<double>(x_size * (x_size + 1) / 2 * K::num_stats);
+      double* s = stats;
+      for (size_t j = 0; j < x_size; ++j) {
+        for (size_t i = j; i < x_size; ++i) {
+          kernel.stats(x[i], x[j], s);
+          s += K::num_stats;
+        }
+      }
+      return stats;
+    }
+
+    /**
+     * This is a subclass of the vari class for the covariance matrix
+     * of a kernel.
+     *
+     * The class stores the statistics of each pair of inputs, such
+     * as their distance, once, with pointers to the varis for the
+     * lower triangular part of the covariance matrix.  Those varis
+     * are on the var_nochain_stack_, and the gradients with respect
+     * to all the hyperparameters are accumulated in a single pass
+     * over the matrix.
+     *
+     * @tparam K type of kernel
+     */
+    template <class K>
+    class gp_cov_vari : public vari {
+    public:
+      const size_t size_;
+      const size_t size_ltri_;
+      const K kernel_;
+      double* stats_;
+      vari** cov_;
+
+      /**
+       * Constructor for gp_cov.
+       *
+       * All memory allocated in
+       * ChainableStack's stack_alloc arena.
+       *
+       * @param size number of inputs
+       * @param kernel kernel
+       * @param stats statistics of the pairs of inputs, from
+       * gp_stats()
+       */
+      gp_cov_vari(size_t size, const K& kernel, double* stats)
+        : vari(0.0),
+          size_(size),
+          size_ltri_(size_ * (size_ + 1) / 2),
+          kernel_(kernel),
+          stats_(stats),
+          cov_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_ltri_)) {
+        for (size_t pos = 0; pos < size_ltri_; ++pos)
+          cov_[pos] = new vari(kernel_.value(stats_ + pos * K::num_stats),
+                               false);
+      }
+
+      virtual void chain() {
+        double grad[K::num_params] = { 0 };
+        for (size_t pos = 0; pos < size_ltri_; ++pos)
+          kernel_.grad(stats_ + pos * K::num_stats, cov_[pos]->val_,
+                       cov_[pos]->adj_, grad);
+        for (int m = 0; m < K::num_params; ++m) {
+          vari* vi = kernel_.param(m);
+          if (vi)
+            vi->adj_ += grad[m];
+        }
+      }
+    };
+
+    /**
+     * Returns the covariance matrix of the specified kernel at the
+     * specified inputs, with a single node on the stack for the
+     * gradient with respect to the hyperparameters of the kernel.
+     *
+     * Kernels, such as gp_matern32_kernel, may be composed with
+     * gp_kernel_sum() and gp_kernel_product(), for instance
+     *
+     * <code>gp_cov(x, gp_kernel_sum(gp_exp_quad_kernel(s1, l1),
+     * gp_periodic_kernel(s2, l2, p)))</code>.
+     *
+     * Neither the inputs nor the hyperparameters are checked.
+     *
+     * @tparam T_x type of inputs, double or vector of doubles
+     * @tparam K type of kernel
+     * @param x std::vector of inputs
+     * @param kernel kernel
+     * @return covariance matrix
+     */
+    template <typename T_x, class K>
+    inline Eigen::Matrix<var, -1, -1>
+    gp_cov(const std::vector<T_x>& x, const K& kernel) {
+      size_t x_size = x.size();
+      Eigen::Matrix<var, -1, -1> cov(x_size, x_size);
+      if (x_size == 0)
+        return cov;
+
+      double* stats = gp_stats(x, kernel);
+      gp_cov_vari<K>* baseVari = new gp_cov_vari<K>(x_size, kernel, stats);
+      size_t pos = 0;
+      for (size_t j = 0; j < x_size; ++j) {
+        for (size_t i = j; i < x_size; ++i) {
+          cov.coeffRef(i, j).vi_ = baseVari->cov_[pos];
+          cov.coeffRef(j, i).vi_ = cov.coeffRef(i, j).vi_;
+          ++pos;
+        }
+      }
+      return cov;
+    }
+
+  }
+}
+#endif
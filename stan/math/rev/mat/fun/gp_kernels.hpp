@@ -0,0 +1,427 @@
+#ifndef STAN_MATH_REV_MAT_FUN_GP_KERNELS_HPP
+#define STAN_MATH_REV_MAT_FUN_GP_KERNELS_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/fun/value_of.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/dot_product.hpp>
+#include <stan/math/prim/mat/fun/squared_distance.hpp>
+#include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/prim/scal/fun/squared_distance.hpp>
+#include <stan/math/prim/scal/fun/value_of.hpp>
+#include <cmath>
+
+namespace stan {
+  namespace math {
+
+    /*
+     * The kernels below are the building blocks of the single-node
+     * covariance matrices and Cholesky factors of gp_cov() and
+     * gp_cholesky().  A kernel holds the values of its
+     * hyperparameters as doubles, with the varis of those that are
+     * variables, and provides:
+     *
+     * - num_stats, the number of doubles computed once for each
+     *   pair of inputs by stats(), such as their distance,
+     * - value(), the covariance of a pair from its statistics,
+     * - grad(), which adds the adjoint of a covariance times its
+     *   derivatives with respect to the hyperparameters to an
+     *   array of num_params gradients,
+     * - param(), the vari of a hyperparameter, or 0 for data.
+     *
+     * Kernels are composed with gp_kernel_sum() and
+     * gp_kernel_product().
+     */
+
+    namespace {
+      inline vari* gp_param_vari(const var& x) {
+        return x.vi_;
+      }
+
+      inline vari* gp_param_vari(double x) {
+        return 0;
+      }
+    }
+
+    /**
+     * Squared exponential kernel,
+     * <code>sigma^2 exp(-d^2 / (2 l^2))</code>.
+     */
+    class gp_exp_quad_kernel {
+    public:
+      static const int num_stats = 1;
+      static const int num_params = 2;
+
+      double sigma_;
+      double l_;
+      double sigma_sq_;
+      double neg_half_inv_l_sq_;
+      vari* params_[num_params];
+
+      /**
+       * Construct a squared exponential kernel.
+       *
+       * @tparam T_sigma type of sigma, var or double
+       * @tparam T_l type of length scale, var or double
+       * @param sigma standard deviation
+       * @param l length scale
+       */
+      template <typename T_sigma, typename T_l>
+      gp_exp_quad_kernel(const T_sigma& sigma, const T_l& l)
+        : sigma_(value_of(sigma)), l_(value_of(l)),
+          sigma_sq_(sigma_ * sigma_),
+          neg_half_inv_l_sq_(-0.5 / (l_ * l_)) {
+        params_[0] = gp_param_vari(sigma);
+        params_[1] = gp_param_vari(l);
+      }
+
+      template <typename T_x1, typename T_x2>
+      void stats(const T_x1& x1, const T_x2& x2, double* s) const {
+        s[0] = squared_distance(x1, x2);
+      }
+
+      double value(const double* s) const {
+        return sigma_sq_ * std::exp(s[0] * neg_half_inv_l_sq_);
+      }
+
+      void grad(const double* s, double k, double adj, double* g) const {
+        g[0] += adj * 2 * k / sigma_;
+        g[1] += adj * k * s[0] / (l_ * l_ * l_);
+      }
+
+      vari* param(int m) const {
+        return params_[m];
+      }
+    };
+
+    /**
+     * Matern 3/2 kernel,
+     * <code>sigma^2 (1 + sqrt(3) d / l) exp(-sqrt(3) d / l)</code>.
+     */
+    class gp_matern32_kernel {
+    public:
+      static const int num_stats = 1;
+      static const int num_params = 2;
+
+      double sigma_;
+      double l_;
+      double sigma_sq_;
+      double root_3_inv_l_;
+      vari* params_[num_params];
+
+      /**
+       * Construct a Matern 3/2 kernel.
+       *
+       * @tparam T_sigma type of sigma, var or double
+       * @tparam T_l type of length scale, var or double
+       * @param sigma standard deviation
+       * @param l length scale
+       */
+      template <typename T_sigma, typename T_l>
+      gp_matern32_kernel(const T_sigma& sigma, const T_l& l)
+        : sigma_(value_of(sigma)), l_(value_of(l)),
+          sigma_sq_(sigma_ * sigma_),
+          root_3_inv_l_(std::sqrt(3.0) / l_) {
+        params_[0] = gp_param_vari(sigma);
+        params_[1] = gp_param_vari(l);
+      }
+
+      template <typename T_x1, typename T_x2>
+      void stats(const T_x1& x1, const T_x2& x2, double* s) const {
+        s[0] = std::sqrt(squared_distance(x1, x2));
+      }
+
+      double value(const double* s) const {
+        double a = root_3_inv_l_ * s[0];
+        return sigma_sq_ * (1 + a) * std::exp(-a);
+      }
+
+      void grad(const double* s, double k, double adj, double* g) const {
+        double a = root_3_inv_l_ * s[0];
+        g[0] += adj * 2 * k / sigma_;
+        g[1] += adj * k * a * a / ((1 + a) * l_);
+      }
+
+      vari* param(int m) const {
+        return params_[m];
+      }
+    };
+
+    /**
+     * Matern 5/2 kernel,
+     * <code>sigma^2 (1 + sqrt(5) d / l + 5 d^2 / (3 l^2))
+     * exp(-sqrt(5) d / l)</code>.
+     */
+    class gp_matern52_kernel {
+    public:
+      static const int num_stats = 1;
+      static const int num_params = 2;
+
+      double sigma_;
+      double l_;
+      double sigma_sq_;
+      double root_5_inv_l_;
+      vari* params_[num_params];
+
+      /**
+       * Construct a Matern 5/2 kernel.
+       *
+       * @tparam T_sigma type of sigma, var or double
+       * @tparam T_l type of length scale, var or double
+       * @param sigma standard deviation
+       * @param l length scale
+       */
+      template <typename T_sigma, typename T_l>
+      gp_matern52_kernel(const T_sigma& sigma, const T_l& l)
+        : sigma_(value_of(sigma)), l_(value_of(l)),
+          sigma_sq_(sigma_ * sigma_),
+          root_5_inv_l_(std::sqrt(5.0) / l_) {
+        params_[0] = gp_param_vari(sigma);
+        params_[1] = gp_param_vari(l);
+      }
+
+      template <typename T_x1, typename T_x2>
+      void stats(const T_x1& x1, const T_x2& x2, double* s) const {
+        s[0] = std::sqrt(squared_distance(x1, x2));
+      }
+
+      double value(const double* s) const {
+        double a = root_5_inv_l_ * s[0];
+        return sigma_sq_ * (1 + a + a * a / 3) * std::exp(-a);
+      }
+
+      void grad(const double* s, double k, double adj, double* g) const {
+        double a = root_5_inv_l_ * s[0];
+        g[0] += adj * 2 * k / sigma_;
+        g[1] += adj * k * a * a * (1 + a)
+          / ((3 + 3 * a + a * a) * l_);
+      }
+
+      vari* param(int m) const {
+        return params_[m];
+      }
+    };
+
+    /**
+     * Periodic kernel,
+     * <code>sigma^2 exp(-2 sin^2(pi d / p) / l^2)</code>.
+     */
+    class gp_periodic_kernel {
+    public:
+      static const int num_stats = 1;
+      static const int num_params = 3;
+
+      double sigma_;
+      double l_;
+      double p_;
+      double sigma_sq_;
+      double neg_two_inv_l_sq_;
+      double pi_inv_p_;
+      vari* params_[num_params];
+
+      /**
+       * Construct a periodic kernel.
+       *
+       * @tparam T_sigma type of sigma, var or double
+       * @tparam T_l type of length scale, var or double
+       * @tparam T_p type of period, var or double
+       * @param sigma standard deviation
+       * @param l length scale
+       * @param p period
+       */
+      template <typename T_sigma, typename T_l, typename T_p>
+      gp_periodic_kernel(const T_sigma& sigma, const T_l& l, const T_p& p)
+        : sigma_(value_of(sigma)), l_(value_of(l)), p_(value_of(p)),
+          sigma_sq_(sigma_ * sigma_),
+          neg_two_inv_l_sq_(-2 / (l_ * l_)),
+          pi_inv_p_(pi() / p_) {
+        params_[0] = gp_param_vari(sigma);
+        params_[1] = gp_param_vari(l);
+        params_[2] = gp_param_vari(p);
+      }
+
+      template <typename T_x1, typename T_x2>
+      void stats(const T_x1& x1, const T_x2& x2, double* s) const {
+        s[0] = std::sqrt(squared_distance(x1, x2));
+      }
+
+      double value(const double* s) const {
+        double u = std::sin(pi_inv_p_ * s[0]);
+        return sigma_sq_ * std::exp(u * u * neg_two_inv_l_sq_);
+      }
+
+      void grad(const double* s, double k, double adj, double* g) const {
+        double u = std::sin(pi_inv_p_ * s[0]);
+        g[0] += adj * 2 * k / sigma_;
+        g[1] += adj * k * 4 * u * u / (l_ * l_ * l_);
+        g[2] += adj * k * 2 * pi_inv_p_ * s[0]
+          * std::sin(2 * pi_inv_p_ * s[0]) / (l_ * l_ * p_);
+      }
+
+      vari* param(int m) const {
+        return params_[m];
+      }
+    };
+
+    /**
+     * Dot product kernel, <code>sigma^2 + x^T x'</code>.
+     */
+    class gp_dot_prod_kernel {
+    public:
+      static const int num_stats = 1;
+      static const int num_params = 1;
+
+      double sigma_;
+      double sigma_sq_;
+      vari* params_[num_params];
+
+      /**
+       * Construct a dot product kernel.
+       *
+       * @tparam T_sigma type of sigma, var or double
+       * @param sigma standard deviation of the constant term
+       */
+      template <typename T_sigma>
+      explicit gp_dot_prod_kernel(const T_sigma& sigma)
+        : sigma_(value_of(sigma)), sigma_sq_(sigma_ * sigma_) {
+        params_[0] = gp_param_vari(sigma);
+      }
+
+      void stats(double x1, double x2, double* s) const {
+        s[0] = x1 * x2;
+      }
+
+      template <int R1, int C1, int R2, int C2>
+      void stats(const Eigen::Matrix<double, R1, C1>& x1,
+                 const Eigen::Matrix<double, R2, C2>& x2,
+                 double* s) const {
+        s[0] = dot_product(x1, x2);
+      }
+
+      double value(const double* s) const {
+        return sigma_sq_ + s[0];
+      }
+
+      void grad(const double* s, double k, double adj, double* g) const {
+        g[0] += adj * 2 * sigma_;
+      }
+
+      vari* param(int m) const {
+        return params_[m];
+      }
+    };
+
+    /**
+     * Sum of two kernels.  The statistics and hyperparameters are
+     * those of the first kernel followed by those of the second.
+     *
+     * @tparam K1 type of first kernel
+     * @tparam K2 type of second kernel
+     */
+    template <class K1, class K2>
+    class gp_sum_kernel {
+    public:
+      static const int num_stats = K1::num_stats + K2::num_stats;
+      static const int num_params = K1::num_params + K2::num_params;
+
+      K1 k1_;
+      K2 k2_;
+
+      gp_sum_kernel(const K1& k1, const K2& k2) : k1_(k1), k2_(k2) { }
+
+      template <typename T_x1, typename T_x2>
+      void stats(const T_x1& x1, const T_x2& x2, double* s) const {
+        k1_.stats(x1, x2, s);
+        k2_.stats(x1, x2, s + K1::num_stats);
+      }
+
+      double value(const double* s) const {
+        return k1_.value(s) + k2_.value(s + K1::num_stats);
+      }
+
+      void grad(const double* s, double k, double adj, double* g) const {
+        k1_.grad(s, k1_.value(s), adj, g);
+        k2_.grad(s + K1::num_stats, k2_.value(s + K1::num_stats), adj,
+                 g + K1::num_params);
+      }
+
+      vari* param(int m) const {
+        return m < K1::num_params
+          ? k1_.param(m) : k2_.param(m - K1::num_params);
+      }
+    };
+
+    /**
+     * Elementwise product of two kernels.  The statistics and
+     * hyperparameters are those of the first kernel followed by
+     * those of the second.
+     *
+     * @tparam K1 type of first kernel
+     * @tparam K2 type of second kernel
+     */
+    template <class K1, class K2>
+    class gp_product_kernel {
+    public:
+      static const int num_stats = K1::num_stats + K2::num_stats;
+      static const int num_params = K1::num_params + K2::num_params;
+
+      K1 k1_;
+      K2 k2_;
+
+      gp_product_kernel(const K1& k1, const K2& k2) : k1_(k1), k2_(k2) { }
+
+      template <typename T_x1, typename T_x2>
+      void stats(const T_x1& x1, const T_x2& x2, double* s) const {
+        k1_.stats(x1, x2, s);
+        k2_.stats(x1, x2, s + K1::num_stats);
+      }
+
+      double value(const double* s) const {
+        return k1_.value(s) * k2_.value(s + K1::num_stats);
+      }
+
+      void grad(const double* s, double k, double adj, double* g) const {
+        double k1 = k1_.value(s);
+        double k2 = k2_.value(s + K1::num_stats);
+        k1_.grad(s, k1, adj * k2, g);
+        k2_.grad(s + K1::num_stats, k2, adj * k1, g + K1::num_params);
+      }
+
+      vari* param(int m) const {
+        return m < K1::num_params
+          ? k1_.param(m) : k2_.param(m - K1::num_params);
+      }
+    };
+
+    /**
+     * Return the sum of the specified kernels.
+     *
+     * @tparam K1 type of first kernel
+     * @tparam K2 type of second kernel
+     * @param k1 first kernel
+     * @param k2 second kernel
+     * @return sum kernel
+     */
+    template <class K1, class K2>
+    inline gp_sum_kernel<K1, K2> gp_kernel_sum(const K1& k1, const K2& k2) {
+      return gp_sum_kernel<K1, K2>(k1, k2);
+    }
+
+    /**
+     * Return the elementwise product of the specified kernels.
+     *
+     * @tparam K1 type of first kernel
+     * @tparam K2 type of second kernel
+     * @param k1 first kernel
+     * @param k2 second kernel
+     * @return product kernel
+     */
+    template <class K1, class K2>
+    inline gp_product_kernel<K1, K2>
+    gp_kernel_product(const K1& k1, const K2& k2) {
+      return gp_product_kernel<K1, K2>(k1, k2);
+    }
+
+  }
+}
+#endif
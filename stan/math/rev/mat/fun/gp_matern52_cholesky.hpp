@@ -0,0 +1,96 @@
+#ifndef STAN_MATH_REV_MAT_FUN_GP_MATERN52_CHOLESKY_HPP
+#define STAN_MATH_REV_MAT_FUN_GP_MATERN52_CHOLESKY_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/meta/is_var.hpp>
+#include <stan/math/rev/mat/fun/gp_cholesky.hpp>
+#include <stan/math/rev/mat/fun/gp_kernels.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/gp_matern52_cholesky.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns the Cholesky factor of a Matern 5/2 covariance matrix with
+     * <code>delta</code> added to its diagonal, for real inputs.
+     *
+     * The factor and its gradient with respect to the
+     * hyperparameters are computed on a single node, see
+     * gp_cholesky().
+     *
+     * @tparam T_sigma type of sigma, var or double
+     * @tparam T_l type of length scale, var or double
+     *
+     * @param x std::vector of real inputs
+     * @param sigma standard deviation
+     * @param l length scale
+     * @param delta nugget added to the diagonal
+     * @return lower triangular Cholesky factor
+     * @throw std::domain_error if sigma <= 0, l <= 0, delta < 0, x is
+     *   nan or infinite, or the covariance matrix is not positive
+     *   definite
+     */
+    template <typename T_sigma, typename T_l>
+    inline typename
+    boost::enable_if_c<is_var<typename return_type<T_sigma, T_l>::type>::value,
+                       Eigen::Matrix<var, -1, -1> >::type
+    gp_matern52_cholesky(const std::vector<double>& x,
+                         const T_sigma& sigma,
+                         const T_l& l,
+                         double delta) {
+      check_positive("gp_matern52_cholesky", "marginal variance", sigma);
+      check_positive("gp_matern52_cholesky", "length-scale", l);
+      check_nonnegative("gp_matern52_cholesky", "delta", delta);
+      for (size_t n = 0; n < x.size(); ++n)
+        check_finite("gp_matern52_cholesky", "x", x[n]);
+      return gp_cholesky(x, gp_matern52_kernel(sigma, l), delta);
+    }
+
+    /**
+     * Returns the Cholesky factor of a Matern 5/2 covariance matrix with
+     * <code>delta</code> added to its diagonal, for vector inputs.
+     *
+     * The factor and its gradient with respect to the
+     * hyperparameters are computed on a single node, see
+     * gp_cholesky().
+     *
+     * @tparam R number of rows, can be Eigen::Dynamic
+     * @tparam C number of columns, can be Eigen::Dynamic
+     * @tparam T_sigma type of sigma, var or double
+     * @tparam T_l type of length scale, var or double
+     *
+     * @param x std::vector of vector inputs
+     * @param sigma standard deviation
+     * @param l length scale
+     * @param delta nugget added to the diagonal
+     * @return lower triangular Cholesky factor
+     * @throw std::domain_error if sigma <= 0, l <= 0, delta < 0, x is
+     *   nan or infinite, or the covariance matrix is not positive
+     *   definite
+     */
+    template <int R, int C, typename T_sigma, typename T_l>
+    inline typename
+    boost::enable_if_c<is_var<typename return_type<T_sigma, T_l>::type>::value,
+                       Eigen::Matrix<var, -1, -1> >::type
+    gp_matern52_cholesky(const std::vector<Eigen::Matrix<double, R, C> >& x,
+                         const T_sigma& sigma,
+                         const T_l& l,
+                         double delta) {
+      check_positive("gp_matern52_cholesky", "marginal variance", sigma);
+      check_positive("gp_matern52_cholesky", "length-scale", l);
+      check_nonnegative("gp_matern52_cholesky", "delta", delta);
+      for (size_t n = 0; n < x.size(); ++n)
+        check_finite("gp_matern52_cholesky", "x", x[n]);
+      return gp_cholesky(x, gp_matern52_kernel(sigma, l), delta);
+    }
+
+  }
+}
+#endif
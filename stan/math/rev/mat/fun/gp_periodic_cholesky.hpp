@@ -0,0 +1,106 @@
+#ifndef STAN_MATH_REV_MAT_FUN_GP_PERIODIC_CHOLESKY_HPP
+#define STAN_MATH_REV_MAT_FUN_GP_PERIODIC_CHOLESKY_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/meta/is_var.hpp>
+#include <stan/math/rev/mat/fun/gp_cholesky.hpp>
+#include <stan/math/rev/mat/fun/gp_kernels.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/gp_periodic_cholesky.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_nonnegative.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns the Cholesky factor of a periodic covariance matrix with
+     * <code>delta</code> added to its diagonal, for real inputs.
+     *
+     * The factor and its gradient with respect to the
+     * hyperparameters are computed on a single node, see
+     * gp_cholesky().
+     *
+     * @tparam T_sigma type of sigma, var or double
+     * @tparam T_l type of length scale, var or double
+     * @tparam T_p type of period, var or double
+     *
+     * @param x std::vector of real inputs
+     * @param sigma standard deviation
+     * @param l length scale
+     * @param p period
+     * @param delta nugget added to the diagonal
+     * @return lower triangular Cholesky factor
+     * @throw std::domain_error if sigma <= 0, l <= 0, p <= 0, delta
+     *   < 0, x is nan or infinite, or the covariance matrix is not
+     *   positive definite
+     */
+    template <typename T_sigma, typename T_l, typename T_p>
+    inline typename
+    boost::enable_if_c<is_var<typename return_type<T_sigma, T_l,
+                                                   T_p>::type>::value,
+                       Eigen::Matrix<var, -1, -1> >::type
+    gp_periodic_cholesky(const std::vector<double>& x,
+                         const T_sigma& sigma,
+                         const T_l& l,
+                         const T_p& p,
+                         double delta) {
+      check_positive("gp_periodic_cholesky", "marginal variance", sigma);
+      check_positive("gp_periodic_cholesky", "length-scale", l);
+      check_positive("gp_periodic_cholesky", "period", p);
+      check_nonnegative("gp_periodic_cholesky", "delta", delta);
+      for (size_t n = 0; n < x.size(); ++n)
+        check_finite("gp_periodic_cholesky", "x", x[n]);
+      return gp_cholesky(x, gp_periodic_kernel(sigma, l, p), delta);
+    }
+
+    /**
+     * Returns the Cholesky factor of a periodic covariance matrix with
+     * <code>delta</code> added to its diagonal, for vector inputs.
+     *
+     * The factor and its gradient with respect to the
+     * hyperparameters are computed on a single node, see
+     * gp_cholesky().
+     *
+     * @tparam R number of rows, can be Eigen::Dynamic
+     * @tparam C number of columns, can be Eigen::Dynamic
+     * @tparam T_sigma type of sigma, var or double
+     * @tparam T_l type of length scale, var or double
+     * @tparam T_p type of period, var or double
+     *
+     * @param x std::vector of vector inputs
+     * @param sigma standard deviation
+     * @param l length scale
+     * @param p period
+     * @param delta nugget added to the diagonal
+     * @return lower triangular Cholesky factor
+     * @throw std::domain_error if sigma <= 0, l <= 0, p <= 0, delta
+     *   < 0, x is nan or infinite, or the covariance matrix is not
+     *   positive definite
+     */
+    template <int R, int C, typename T_sigma, typename T_l, typename T_p>
+    inline typename
+    boost::enable_if_c<is_var<typename return_type<T_sigma, T_l,
+                                                   T_p>::type>::value,
+                       Eigen::Matrix<var, -1, -1> >::type
+    gp_periodic_cholesky(const std::vector<Eigen::Matrix<double, R, C> >& x,
+                         const T_sigma& sigma,
+                         const T_l& l,
+                         const T_p& p,
+                         double delta) {
+      check_positive("gp_periodic_cholesky", "marginal variance", sigma);
+      check_positive("gp_periodic_cholesky", "length-scale", l);
+      check_positive("gp_periodic_cholesky", "period", p);
+      check_nonnegative("gp_periodic_cholesky", "delta", delta);
+      for (size_t n = 0; n < x.size(); ++n)
+        check_finite("gp_periodic_cholesky", "x", x[n]);
+      return gp_cholesky(x, gp_periodic_kernel(sigma, l, p), delta);
+    }
+
+  }
+}
+#endif
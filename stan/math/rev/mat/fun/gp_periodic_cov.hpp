@@ -0,0 +1,93 @@
+#ifndef STAN_MATH_REV_MAT_FUN_GP_PERIODIC_COV_HPP
+#define STAN_MATH_REV_MAT_FUN_GP_PERIODIC_COV_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/meta/is_var.hpp>
+#include <stan/math/rev/mat/fun/gp_cov.hpp>
+#include <stan/math/rev/mat/fun/gp_kernels.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/fun/gp_periodic_cov.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_positive.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <boost/utility/enable_if.hpp>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Returns a periodic covariance matrix, for real inputs.
+     *
+     * The gradient with respect to the hyperparameters is
+     * computed on a single node, see gp_cov().
+     *
+     * @tparam T_sigma type of sigma, var or double
+     * @tparam T_l type of length scale, var or double
+     * @tparam T_p type of period, var or double
+     *
+     * @param x std::vector of real inputs
+     * @param sigma standard deviation
+     * @param l length scale
+     * @param p period
+     * @return covariance matrix
+     * @throw std::domain_error if sigma <= 0, l <= 0, p <= 0, or x is
+     *   nan or infinite
+     */
+    template <typename T_sigma, typename T_l, typename T_p>
+    inline typename
+    boost::enable_if_c<is_var<typename return_type<T_sigma, T_l,
+                                                   T_p>::type>::value,
+                       Eigen::Matrix<var, -1, -1> >::type
+    gp_periodic_cov(const std::vector<double>& x,
+                    const T_sigma& sigma,
+                    const T_l& l,
+                    const T_p& p) {
+      check_positive("gp_periodic_cov", "marginal variance", sigma);
+      check_positive("gp_periodic_cov", "length-scale", l);
+      check_positive("gp_periodic_cov", "period", p);
+      for (size_t n = 0; n < x.size(); ++n)
+        check_finite("gp_periodic_cov", "x", x[n]);
+      return gp_cov(x, gp_periodic_kernel(sigma, l, p));
+    }
+
+    /**
+     * Returns a periodic covariance matrix, for vector inputs.
+     *
+     * The gradient with respect to the hyperparameters is
+     * computed on a single node, see gp_cov().
+     *
+     * @tparam R number of rows, can be Eigen::Dynamic
+     * @tparam C number of columns, can be Eigen::Dynamic
+     * @tparam T_sigma type of sigma, var or double
+     * @tparam T_l type of length scale, var or double
+     * @tparam T_p type of period, var or double
+     *
+     * @param x std::vector of vector inputs
+     * @param sigma standard deviation
+     * @param l length scale
+     * @param p period
+     * @return covariance matrix
+     * @throw std::domain_error if sigma <= 0, l <= 0, p <= 0, or x is
+     *   nan or infinite
+     */
+    template <int R, int C, typename T_sigma, typename T_l, typename T_p>
+    inline typename
+    boost::enable_if_c<is_var<typename return_type<T_sigma, T_l,
+                                                   T_p>::type>::value,
+                       Eigen::Matrix<var, -1, -1> >::type
+    gp_periodic_cov(const std::vector<Eigen::Matrix<double, R, C> >& x,
+                    const T_sigma& sigma,
+                    const T_l& l,
+                    const T_p& p) {
+      check_positive("gp_periodic_cov", "marginal variance", sigma);
+      check_positive("gp_periodic_cov", "length-scale", l);
+      check_positive("gp_periodic_cov", "period", p);
+      for (size_t n = 0; n < x.size(); ++n)
+        check_finite("gp_periodic_cov", "x", x[n]);
+      return gp_cov(x, gp_periodic_kernel(sigma, l, p));
+    }
+
+  }
+}
+#endif
@@ -3,6 +3,7 @@
 
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/rev/core.hpp>
 
 namespace stan {
@@ -24,13 +25,13 @@ namespace stan {
       double val = hh.logAbsDeterminant();
 
       vari** varis
-        = ChainableStack::memalloc_.alloc_array<vari*>(m.size());
+        = ChainableStack::instance().memalloc_.alloc_array<vari*>(m.size());
       for (int i = 0; i < m.size(); ++i)
         varis[i] = m(i).vi_;
 
       Matrix<double, R, C> m_inv_transpose = hh.inverse().transpose();
       double* gradients
-        = ChainableStack::memalloc_.alloc_array<double>(m.size());
+        = ChainableStack::instance().memalloc_.alloc_array<double>(m.size());
       for (int i = 0; i < m.size(); ++i)
         gradients[i] = m_inv_transpose(i);
 
@@ -38,6 +39,44 @@ namespace stan {
                                                 varis, gradients));
     }
 
+    namespace {
+      class log_determinant_mv_vari : public vari {
+      public:
+        matrix_var_vari* A_;
+        Eigen::Map<Eigen::MatrixXd> A_inv_transpose_;
+
+        log_determinant_mv_vari(
+          matrix_var_vari* A,
+          const Eigen::FullPivHouseholderQR<Eigen::MatrixXd>& hh)
+          : vari(hh.logAbsDeterminant()), A_(A),
+            A_inv_transpose_(ChainableStack::instance().memalloc_
+                             .alloc_array<double>(A->values_.size()),
+                             A->values_.rows(), A->values_.cols()) {
+          A_inv_transpose_ = hh.inverse().transpose();
+        }
+
+        virtual void chain() {
+          A_->adjoints_ += adj_ * A_inv_transpose_;
+        }
+      };
+    }
+
+    /**
+     * Return the log of the absolute value of the determinant of a
+     * square matrix variable.
+     *
+     * @param m matrix
+     * @return log absolute determinant of m
+     * @throw std::invalid_argument if m is not square
+     */
+    inline var log_determinant(const matrix_var& m) {
+      check_size_match("log_determinant", "Rows of m", m.rows(),
+                       "columns of m", m.cols());
+      Eigen::FullPivHouseholderQR<Eigen::MatrixXd> hh
+        = m.val().fullPivHouseholderQr();
+      return var(new log_determinant_mv_vari(m.vi_, hh));
+    }
+
   }
 }
 #endif
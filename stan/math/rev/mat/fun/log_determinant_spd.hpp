@@ -44,12 +44,12 @@ namespace stan {
       check_finite("log_determinant_spd",
                    "log determininant of the matrix argument", val);
 
-      vari** operands = ChainableStack::memalloc_
+      vari** operands = ChainableStack::instance().memalloc_
         .alloc_array<vari*>(m.size());
       for (int i = 0; i < m.size(); ++i)
         operands[i] = m(i).vi_;
 
-      double* gradients = ChainableStack::memalloc_
+      double* gradients = ChainableStack::instance().memalloc_
         .alloc_array<double>(m.size());
       for (int i = 0; i < m.size(); ++i)
         gradients[i] = m_d(i);
@@ -7,6 +7,7 @@
 #include <stan/math/rev/core.hpp>
 #include <stan/math/rev/mat/fun/typedefs.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <vector>
 
 namespace stan {
@@ -30,19 +31,19 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             A_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * A.rows() * A.cols()))),
             C_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * B.rows() * B.cols()))),
             variRefA_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * A.rows() * A.cols()))),
             variRefB_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))) {
           using Eigen::Matrix;
           using Eigen::Map;
@@ -124,16 +125,16 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             A_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * A.rows() * A.cols()))),
             C_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * B.rows() * B.cols()))),
             variRefB_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))) {
           using Eigen::Matrix;
           using Eigen::Map;
@@ -206,16 +207,16 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             A_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * A.rows() * A.cols()))),
             C_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * B.rows() * B.cols()))),
             variRefA_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * A.rows() * A.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))) {
           using Eigen::Matrix;
           using Eigen::Map;
@@ -348,6 +349,66 @@ namespace stan {
       return res;
     }
 
+    namespace {
+      class mdivide_left_mv_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* A_;
+        matrix_var_vari* B_;
+        Eigen::Map<Eigen::MatrixXd> LU_;
+        int* perm_;
+
+        mdivide_left_mv_vari(matrix_var_vari* A, matrix_var_vari* B,
+                             const Eigen::PartialPivLU<Eigen::MatrixXd>& lu)
+          : matrix_var_vari(lu.solve(B->values_)), A_(A), B_(B),
+            LU_(ChainableStack::instance().memalloc_
+                .alloc_array<double>(lu.matrixLU().size()),
+                lu.rows(), lu.cols()),
+            perm_(ChainableStack::instance().memalloc_
+                  .alloc_array<int>(lu.rows())) {
+          LU_ = lu.matrixLU();
+          for (int i = 0; i < lu.rows(); ++i)
+            perm_[i] = lu.permutationP().indices()(i);
+        }
+
+        virtual void chain() {
+          using Eigen::MatrixXd;
+          Eigen::PermutationMatrix<Eigen::Dynamic> P
+            = Eigen::PermutationMatrix<Eigen::Dynamic>(
+                Eigen::Map<Eigen::VectorXi>(perm_, LU_.rows()));
+          // solve A' adjB = adjC with the factors of P A = L U
+          MatrixXd adjB
+            = LU_.triangularView<Eigen::Upper>().transpose().solve(adjoints_);
+          LU_.triangularView<Eigen::UnitLower>().transpose()
+            .solveInPlace(adjB);
+          adjB = P.transpose() * adjB;
+          B_->adjoints_ += adjB;
+          A_->adjoints_.noalias() -= adjB * values_.transpose();
+        }
+      };
+    }
+
+    /**
+     * Return the solution C of A * C = B for matrix variables A and
+     * B.
+     *
+     * A is factored once, with partial pivoting, and the factors are
+     * kept for the gradient, which takes two triangular solves and
+     * one matrix product.
+     *
+     * @param A square matrix
+     * @param B right hand side
+     * @return solution of the system
+     * @throw std::invalid_argument if A is not square or the columns
+     * of A do not match the rows of B
+     */
+    inline matrix_var mdivide_left(const matrix_var& A, const matrix_var& B) {
+      check_size_match("mdivide_left", "Rows of A", A.rows(),
+                       "columns of A", A.cols());
+      check_multiplicable("mdivide_left", "A", A, "B", B);
+      Eigen::PartialPivLU<Eigen::MatrixXd> lu(A.val());
+      return matrix_var(new mdivide_left_mv_vari(A.vi_, B.vi_, lu));
+    }
+
   }
 }
 #endif
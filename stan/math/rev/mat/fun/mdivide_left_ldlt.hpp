@@ -50,10 +50,10 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             variRefB_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             alloc_(new mdivide_left_ldlt_alloc<R1, C1, R2, C2>()),
             alloc_ldlt_(A.alloc_) {
@@ -127,10 +127,10 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             variRefB_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             alloc_(new mdivide_left_ldlt_alloc<R1, C1, R2, C2>()) {
           using Eigen::Matrix;
@@ -200,7 +200,7 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             alloc_(new mdivide_left_ldlt_alloc<R1, C1, R2, C2>()),
             alloc_ldlt_(A.alloc_) {
@@ -38,13 +38,13 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             variRefA_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * A.rows() * A.cols()))),
             variRefB_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             alloc_(new mdivide_left_spd_alloc<R1, C1, R2, C2>()) {
           using Eigen::Matrix;
@@ -124,10 +124,10 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             variRefB_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             alloc_(new mdivide_left_spd_alloc<R1, C1, R2, C2>()) {
           using Eigen::Matrix;
@@ -189,10 +189,10 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             variRefA_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * A.rows() * A.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             alloc_(new mdivide_left_spd_alloc<R1, C1, R2, C2>()) {
           using Eigen::Matrix;
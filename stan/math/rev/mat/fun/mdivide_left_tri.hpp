@@ -5,6 +5,7 @@
 #include <stan/math/prim/mat/fun/typedefs.hpp>
 #include <stan/math/prim/mat/err/check_multiplicable.hpp>
 #include <stan/math/prim/mat/err/check_square.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
 #include <stan/math/rev/core.hpp>
 #include <stan/math/rev/mat/fun/typedefs.hpp>
 #include <vector>
@@ -30,19 +31,19 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             A_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * A.rows() * A.cols()))),
             C_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * B.rows() * B.cols()))),
             variRefA_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * A.rows() * (A.rows() + 1) / 2))),
             variRefB_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))) {
           using Eigen::Matrix;
           using Eigen::Map;
@@ -140,16 +141,16 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             A_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * A.rows() * A.cols()))),
             C_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * B.rows() * B.cols()))),
             variRefB_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))) {
           using Eigen::Matrix;
           using Eigen::Map;
@@ -222,16 +223,16 @@ namespace stan {
             M_(A.rows()),
             N_(B.cols()),
             A_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * A.rows() * A.cols()))),
             C_(reinterpret_cast<double*>
-               (ChainableStack::memalloc_
+               (ChainableStack::instance().memalloc_
                 .alloc(sizeof(double) * B.rows() * B.cols()))),
             variRefA_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * A.rows() * (A.rows() + 1) / 2))),
             variRefC_(reinterpret_cast<vari**>
-                      (ChainableStack::memalloc_
+                      (ChainableStack::instance().memalloc_
                        .alloc(sizeof(vari*) * B.rows() * B.cols()))) {
           using Eigen::Matrix;
           using Eigen::Map;
@@ -377,6 +378,50 @@ namespace stan {
       return res;
     }
 
+    namespace {
+      template <int TriView>
+      class mdivide_left_tri_mv_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* A_;
+        matrix_var_vari* B_;
+
+        mdivide_left_tri_mv_vari(matrix_var_vari* A, matrix_var_vari* B)
+          : matrix_var_vari(A->values_.template triangularView<TriView>()
+                            .solve(B->values_)),
+            A_(A), B_(B) { }
+
+        virtual void chain() {
+          Eigen::MatrixXd adjB = A_->values_
+            .template triangularView<TriView>().transpose().solve(adjoints_);
+          B_->adjoints_ += adjB;
+          A_->adjoints_.template triangularView<TriView>()
+            -= adjB * values_.transpose();
+        }
+      };
+    }
+
+    /**
+     * Return the solution C of A * C = B for a triangular matrix
+     * variable A and a matrix variable B.  Only the triangular part
+     * of A given by TriView is used, and only that part receives a
+     * gradient.
+     *
+     * @tparam TriView Eigen::Lower or Eigen::Upper
+     * @param A triangular matrix
+     * @param B right hand side
+     * @return solution of the system
+     * @throw std::invalid_argument if A is not square or the columns
+     * of A do not match the rows of B
+     */
+    template <int TriView>
+    inline matrix_var mdivide_left_tri(const matrix_var& A,
+                                       const matrix_var& B) {
+      check_size_match("mdivide_left_tri", "Rows of A", A.rows(),
+                       "columns of A", A.cols());
+      check_multiplicable("mdivide_left_tri", "A", A, "B", B);
+      return matrix_var(new mdivide_left_tri_mv_vari<TriView>(A.vi_, B.vi_));
+    }
+
   }
 }
 #endif
@@ -65,11 +65,16 @@ namespace stan {
         : vari(0.0),
           A_rows_(A.rows()), A_cols_(A.cols()),
           B_cols_(B.cols()), A_size_(A.size()), B_size_(B.size()),
-          Ad_(ChainableStack::memalloc_.alloc_array<double>(A_size_)),
-          Bd_(ChainableStack::memalloc_.alloc_array<double>(B_size_)),
-          variRefA_(ChainableStack::memalloc_.alloc_array<vari*>(A_size_)),
-          variRefB_(ChainableStack::memalloc_.alloc_array<vari*>(B_size_)),
-          variRefAB_(ChainableStack::memalloc_.alloc_array<vari*>(A_rows_
+          Ad_(ChainableStack::instance().memalloc_.alloc_array<double>(
+              A_size_)),
+          Bd_(ChainableStack::instance().memalloc_.alloc_array<double>(
+              B_size_)),
+          variRefA_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              A_size_)),
+          variRefB_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              B_size_)),
+          variRefAB_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              A_rows_
                                                                   * B_cols_)) {
         using Eigen::Map;
         using Eigen::MatrixXd;
@@ -153,10 +158,12 @@ namespace stan {
                         const Eigen::Matrix<TB, CA, 1>& B)
         : vari(0.0),
           size_(A.cols()),
-          Ad_(ChainableStack::memalloc_.alloc_array<double>(size_)),
-          Bd_(ChainableStack::memalloc_.alloc_array<double>(size_)),
-          variRefA_(ChainableStack::memalloc_.alloc_array<vari*>(size_)),
-          variRefB_(ChainableStack::memalloc_.alloc_array<vari*>(size_)) {
+          Ad_(ChainableStack::instance().memalloc_.alloc_array<double>(size_)),
+          Bd_(ChainableStack::instance().memalloc_.alloc_array<double>(size_)),
+          variRefA_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_)),
+          variRefB_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_)) {
         using Eigen::Map;
         using Eigen::VectorXd;
         using Eigen::RowVectorXd;
@@ -239,10 +246,14 @@ namespace stan {
         : vari(0.0),
           A_rows_(A.rows()), A_cols_(A.cols()),
           B_cols_(B.cols()), A_size_(A.size()), B_size_(B.size()),
-          Ad_(ChainableStack::memalloc_.alloc_array<double>(A_size_)),
-          Bd_(ChainableStack::memalloc_.alloc_array<double>(B_size_)),
-          variRefB_(ChainableStack::memalloc_.alloc_array<vari*>(B_size_)),
-          variRefAB_(ChainableStack::memalloc_.alloc_array<vari*>(A_rows_
+          Ad_(ChainableStack::instance().memalloc_.alloc_array<double>(
+              A_size_)),
+          Bd_(ChainableStack::instance().memalloc_.alloc_array<double>(
+              B_size_)),
+          variRefB_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              B_size_)),
+          variRefAB_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              A_rows_
                                                                   * B_cols_)) {
         using Eigen::MatrixXd;
         using Eigen::Map;
@@ -318,9 +329,10 @@ namespace stan {
                         const Eigen::Matrix<TB, CA, 1>& B)
         : vari(0.0),
           size_(A.cols()),
-          Ad_(ChainableStack::memalloc_.alloc_array<double>(size_)),
-          Bd_(ChainableStack::memalloc_.alloc_array<double>(size_)),
-          variRefB_(ChainableStack::memalloc_.alloc_array<vari*>(size_)) {
+          Ad_(ChainableStack::instance().memalloc_.alloc_array<double>(size_)),
+          Bd_(ChainableStack::instance().memalloc_.alloc_array<double>(size_)),
+          variRefB_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_)) {
         using Eigen::Map;
         using Eigen::VectorXd;
         using Eigen::RowVectorXd;
@@ -397,10 +409,14 @@ namespace stan {
         : vari(0.0),
           A_rows_(A.rows()), A_cols_(A.cols()),
           B_cols_(B.cols()), A_size_(A.size()), B_size_(B.size()),
-          Ad_(ChainableStack::memalloc_.alloc_array<double>(A_size_)),
-          Bd_(ChainableStack::memalloc_.alloc_array<double>(B_size_)),
-          variRefA_(ChainableStack::memalloc_.alloc_array<vari*>(A_size_)),
-          variRefAB_(ChainableStack::memalloc_.alloc_array<vari*>(A_rows_
+          Ad_(ChainableStack::instance().memalloc_.alloc_array<double>(
+              A_size_)),
+          Bd_(ChainableStack::instance().memalloc_.alloc_array<double>(
+              B_size_)),
+          variRefA_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              A_size_)),
+          variRefAB_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              A_rows_
                                                                   * B_cols_)) {
         using Eigen::Map;
         using Eigen::MatrixXd;
@@ -479,9 +495,10 @@ namespace stan {
                         const Eigen::Matrix<double, CA, 1>& B)
         : vari(0.0),
           size_(A.cols()),
-          Ad_(ChainableStack::memalloc_.alloc_array<double>(size_)),
-          Bd_(ChainableStack::memalloc_.alloc_array<double>(size_)),
-          variRefA_(ChainableStack::memalloc_.alloc_array<vari*>(size_)) {
+          Ad_(ChainableStack::instance().memalloc_.alloc_array<double>(size_)),
+          Bd_(ChainableStack::instance().memalloc_.alloc_array<double>(size_)),
+          variRefA_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              size_)) {
         using Eigen::Map;
         using Eigen::VectorXd;
         using Eigen::RowVectorXd;
@@ -626,6 +643,184 @@ namespace stan {
       AB_v.vi_ = baseVari->variRefAB_;
       return AB_v;
     }
+
+    namespace {
+      class multiply_mv_mv_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* A_;
+        matrix_var_vari* B_;
+
+        multiply_mv_mv_vari(matrix_var_vari* A, matrix_var_vari* B)
+          : matrix_var_vari(A->values_ * B->values_), A_(A), B_(B) { }
+
+        virtual void chain() {
+          A_->adjoints_.noalias() += adjoints_ * B_->values_.transpose();
+          B_->adjoints_.noalias() += A_->values_.transpose() * adjoints_;
+        }
+      };
+
+      class multiply_mv_md_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* A_;
+        Eigen::Map<Eigen::MatrixXd> B_;
+
+        template <int R, int C>
+        multiply_mv_md_vari(matrix_var_vari* A,
+                            const Eigen::Matrix<double, R, C>& B)
+          : matrix_var_vari(A->values_ * B), A_(A),
+            B_(ChainableStack::instance().memalloc_
+               .alloc_array<double>(B.size()), B.rows(), B.cols()) {
+          B_ = B;
+        }
+
+        virtual void chain() {
+          A_->adjoints_.noalias() += adjoints_ * B_.transpose();
+        }
+      };
+
+      class multiply_md_mv_vari : public matrix_var_vari {
+      public:
+        Eigen::Map<Eigen::MatrixXd> A_;
+        matrix_var_vari* B_;
+
+        template <int R, int C>
+        multiply_md_mv_vari(const Eigen::Matrix<double, R, C>& A,
+                            matrix_var_vari* B)
+          : matrix_var_vari(A * B->values_),
+            A_(ChainableStack::instance().memalloc_
+               .alloc_array<double>(A.size()), A.rows(), A.cols()),
+            B_(B) {
+          A_ = A;
+        }
+
+        virtual void chain() {
+          B_->adjoints_.noalias() += A_.transpose() * adjoints_;
+        }
+      };
+
+      class multiply_dv_mv_vari : public matrix_var_vari {
+      public:
+        vari* c_;
+        matrix_var_vari* A_;
+
+        multiply_dv_mv_vari(vari* c, matrix_var_vari* A)
+          : matrix_var_vari(c->val_ * A->values_), c_(c), A_(A) { }
+
+        virtual void chain() {
+          A_->adjoints_ += c_->val_ * adjoints_;
+          c_->adj_ += adjoints_.cwiseProduct(A_->values_).sum();
+        }
+      };
+
+      class multiply_d_mv_vari : public matrix_var_vari {
+      public:
+        double c_;
+        matrix_var_vari* A_;
+
+        multiply_d_mv_vari(double c, matrix_var_vari* A)
+          : matrix_var_vari(c * A->values_), c_(c), A_(A) { }
+
+        virtual void chain() {
+          A_->adjoints_ += c_ * adjoints_;
+        }
+      };
+    }
+
+    /**
+     * Return the product of two matrix variables.  The product is
+     * computed with a single matrix product and its gradient with
+     * two, and one node is added to the expression graph.
+     *
+     * @param[in] A first matrix
+     * @param[in] B second matrix
+     * @return product of matrices
+     * @throw std::invalid_argument if the columns of A do not match
+     * the rows of B
+     */
+    inline matrix_var multiply(const matrix_var& A, const matrix_var& B) {
+      check_multiplicable("multiply", "A", A, "B", B);
+      return matrix_var(new multiply_mv_mv_vari(A.vi_, B.vi_));
+    }
+
+    /**
+     * Return the product of a matrix variable and a matrix.
+     *
+     * @tparam R rows of B
+     * @tparam C columns of B
+     * @param[in] A first matrix
+     * @param[in] B second matrix
+     * @return product of matrices
+     * @throw std::invalid_argument if the columns of A do not match
+     * the rows of B
+     */
+    template <int R, int C>
+    inline matrix_var multiply(const matrix_var& A,
+                               const Eigen::Matrix<double, R, C>& B) {
+      check_multiplicable("multiply", "A", A, "B", B);
+      return matrix_var(new multiply_mv_md_vari(A.vi_, B));
+    }
+
+    /**
+     * Return the product of a matrix and a matrix variable.
+     *
+     * @tparam R rows of A
+     * @tparam C columns of A
+     * @param[in] A first matrix
+     * @param[in] B second matrix
+     * @return product of matrices
+     * @throw std::invalid_argument if the columns of A do not match
+     * the rows of B
+     */
+    template <int R, int C>
+    inline matrix_var multiply(const Eigen::Matrix<double, R, C>& A,
+                               const matrix_var& B) {
+      check_multiplicable("multiply", "A", A, "B", B);
+      return matrix_var(new multiply_md_mv_vari(A, B.vi_));
+    }
+
+    /**
+     * Return the product of a scalar variable and a matrix variable.
+     *
+     * @param[in] c scalar
+     * @param[in] A matrix
+     * @return product of scalar and matrix
+     */
+    inline matrix_var multiply(const var& c, const matrix_var& A) {
+      return matrix_var(new multiply_dv_mv_vari(c.vi_, A.vi_));
+    }
+
+    /**
+     * Return the product of a matrix variable and a scalar variable.
+     *
+     * @param[in] A matrix
+     * @param[in] c scalar
+     * @return product of matrix and scalar
+     */
+    inline matrix_var multiply(const matrix_var& A, const var& c) {
+      return matrix_var(new multiply_dv_mv_vari(c.vi_, A.vi_));
+    }
+
+    /**
+     * Return the product of a scalar and a matrix variable.
+     *
+     * @param[in] c scalar
+     * @param[in] A matrix
+     * @return product of scalar and matrix
+     */
+    inline matrix_var multiply(double c, const matrix_var& A) {
+      return matrix_var(new multiply_d_mv_vari(c, A.vi_));
+    }
+
+    /**
+     * Return the product of a matrix variable and a scalar.
+     *
+     * @param[in] A matrix
+     * @param[in] c scalar
+     * @return product of matrix and scalar
+     */
+    inline matrix_var multiply(const matrix_var& A, double c) {
+      return matrix_var(new multiply_d_mv_vari(c, A.vi_));
+    }
   }
 }
 #endif
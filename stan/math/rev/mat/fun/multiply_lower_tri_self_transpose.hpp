@@ -34,7 +34,7 @@ namespace stan {
       else  // if (K < J)
         Knz = (K * (K + 1)) / 2;
       vari** vs
-        = reinterpret_cast<vari**>(ChainableStack::memalloc_
+        = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                    .alloc(Knz * sizeof(vari*)));
       int pos = 0;
       for (int m = 0; m < K; ++m)
@@ -21,7 +21,7 @@ namespace stan {
                   const var* dtrs) {
         using std::sqrt;
         vari** varis
-          = reinterpret_cast<vari**>(ChainableStack::memalloc_
+          = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                      .alloc(size * sizeof(vari*)));
         for (size_t i = 0; i < size; ++i)
           varis[i] = dtrs[i].vi_;
@@ -37,7 +37,7 @@ namespace stan {
         double variance = sum_of_squares / (size - 1);
         double sd = sqrt(variance);
         double* partials
-          = reinterpret_cast<double*>(ChainableStack::memalloc_
+          = reinterpret_cast<double*>(ChainableStack::instance().memalloc_
                                       .alloc(size * sizeof(double)));
         if (sum_of_squares < 1e-20) {
           double grad_limit = 1 / std::sqrt(static_cast<double>(size));
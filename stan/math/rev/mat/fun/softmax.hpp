@@ -62,7 +62,7 @@ namespace stan {
       check_nonzero_size("softmax", "alpha", alpha);
 
       vari** alpha_vi_array
-        = reinterpret_cast<vari**>(ChainableStack::memalloc_
+        = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                    .alloc(sizeof(vari*) * alpha.size()));
       for (int i = 0; i < alpha.size(); ++i)
         alpha_vi_array[i] = alpha(i).vi_;
@@ -75,7 +75,7 @@ namespace stan {
         = softmax(alpha_d);
 
       double* softmax_alpha_d_array
-        = reinterpret_cast<double*>(ChainableStack::memalloc_
+        = reinterpret_cast<double*>(ChainableStack::instance().memalloc_
                                     .alloc(sizeof(double) * alpha_d.size()));
       for (int i = 0; i < alpha_d.size(); ++i)
         softmax_alpha_d_array[i] = softmax_alpha_d(i);
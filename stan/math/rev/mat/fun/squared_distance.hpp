@@ -43,12 +43,12 @@ namespace stan {
         squared_distance_vv_vari(const Eigen::Matrix<var, R1, C1> &v1,
                                  const Eigen::Matrix<var, R2, C2> &v2)
           : vari(var_squared_distance(v1, v2)), length_(v1.size()) {
-          v1_ = reinterpret_cast<vari**>(ChainableStack::memalloc_
+          v1_ = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                          .alloc(length_*sizeof(vari*)));
           for (size_t i = 0; i < length_; i++)
             v1_[i] = v1(i).vi_;
 
-          v2_ = reinterpret_cast<vari**>(ChainableStack::memalloc_
+          v2_ = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                          .alloc(length_*sizeof(vari*)));
           for (size_t i = 0; i < length_; i++)
             v2_[i] = v2(i).vi_;
@@ -87,12 +87,12 @@ namespace stan {
         squared_distance_vd_vari(const Eigen::Matrix<var, R1, C1> &v1,
                                  const Eigen::Matrix<double, R2, C2> &v2)
           : vari(var_squared_distance(v1, v2)), length_(v1.size()) {
-          v1_ = reinterpret_cast<vari**>(ChainableStack::memalloc_
+          v1_ = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                          .alloc(length_*sizeof(vari*)));
           for (size_t i = 0; i < length_; i++)
             v1_[i] = v1(i).vi_;
 
-          v2_ = reinterpret_cast<double*>(ChainableStack::memalloc_
+          v2_ = reinterpret_cast<double*>(ChainableStack::instance().memalloc_
                                           .alloc(length_*sizeof(double)));
           for (size_t i = 0; i < length_; i++)
             v2_[i] = v2(i);
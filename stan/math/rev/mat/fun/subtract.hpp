@@ -0,0 +1,116 @@
+#ifndef STAN_MATH_REV_MAT_FUN_SUBTRACT_HPP
+#define STAN_MATH_REV_MAT_FUN_SUBTRACT_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/rev/core.hpp>
+
+namespace stan {
+  namespace math {
+
+    namespace {
+      class subtract_mv_mv_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* A_;
+        matrix_var_vari* B_;
+
+        subtract_mv_mv_vari(matrix_var_vari* A, matrix_var_vari* B)
+          : matrix_var_vari(A->values_ - B->values_), A_(A), B_(B) { }
+
+        virtual void chain() {
+          A_->adjoints_ += adjoints_;
+          B_->adjoints_ -= adjoints_;
+        }
+      };
+
+      class subtract_mv_md_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* A_;
+
+        template <typename Derived>
+        subtract_mv_md_vari(matrix_var_vari* A,
+                            const Eigen::MatrixBase<Derived>& B)
+          : matrix_var_vari(A->values_ - B), A_(A) { }
+
+        virtual void chain() {
+          A_->adjoints_ += adjoints_;
+        }
+      };
+
+      class subtract_md_mv_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* B_;
+
+        template <typename Derived>
+        subtract_md_mv_vari(const Eigen::MatrixBase<Derived>& A,
+                            matrix_var_vari* B)
+          : matrix_var_vari(A - B->values_), B_(B) { }
+
+        virtual void chain() {
+          B_->adjoints_ -= adjoints_;
+        }
+      };
+    }
+
+    /**
+     * Return the difference of two matrix variables with the same
+     * dimensions.
+     *
+     * @param[in] A first matrix
+     * @param[in] B second matrix
+     * @return difference of the matrices
+     * @throw std::invalid_argument if the dimensions do not match
+     */
+    inline matrix_var subtract(const matrix_var& A, const matrix_var& B) {
+      check_size_match("subtract", "Rows of A", A.rows(),
+                       "rows of B", B.rows());
+      check_size_match("subtract", "Columns of A", A.cols(),
+                       "columns of B", B.cols());
+      return matrix_var(new subtract_mv_mv_vari(A.vi_, B.vi_));
+    }
+
+    /**
+     * Return the difference of a matrix variable and a matrix with the
+     * same dimensions.
+     *
+     * @tparam R rows of B
+     * @tparam C columns of B
+     * @param[in] A first matrix
+     * @param[in] B second matrix
+     * @return difference of the matrices
+     * @throw std::invalid_argument if the dimensions do not match
+     */
+    template <int R, int C>
+    inline matrix_var subtract(const matrix_var& A,
+                               const Eigen::Matrix<double, R, C>& B) {
+      check_size_match("subtract", "Rows of A", A.rows(),
+                       "rows of B", B.rows());
+      check_size_match("subtract", "Columns of A", A.cols(),
+                       "columns of B", B.cols());
+      return matrix_var(new subtract_mv_md_vari(A.vi_, B));
+    }
+
+    /**
+     * Return the difference of a matrix and a matrix variable with the
+     * same dimensions.
+     *
+     * @tparam R rows of A
+     * @tparam C columns of A
+     * @param[in] A first matrix
+     * @param[in] B second matrix
+     * @return difference of the matrices
+     * @throw std::invalid_argument if the dimensions do not match
+     */
+    template <int R, int C>
+    inline matrix_var subtract(const Eigen::Matrix<double, R, C>& A,
+                               const matrix_var& B) {
+      check_size_match("subtract", "Rows of A", A.rows(),
+                       "rows of B", B.rows());
+      check_size_match("subtract", "Columns of A", A.cols(),
+                       "columns of B", B.cols());
+      return matrix_var(new subtract_md_mv_vari(A, B.vi_));
+    }
+
+  }
+}
+#endif
@@ -28,7 +28,8 @@ namespace stan {
       template <int R1, int C1>
       explicit sum_eigen_v_vari(const Eigen::Matrix<var, R1, C1> &v1)
         : sum_v_vari(sum_of_val(v1),
-                     reinterpret_cast<vari**>(ChainableStack::memalloc_
+                     reinterpret_cast<vari**>(ChainableStack::instance()
+                         .memalloc_
                                               .alloc(v1.size()
                                                      * sizeof(vari*))),
                      v1.size()) {
@@ -53,6 +54,33 @@ namespace stan {
       return var(new sum_eigen_v_vari(m));
     }
 
+    namespace {
+      class sum_mv_vari : public vari {
+      public:
+        matrix_var_vari* m_;
+
+        explicit sum_mv_vari(matrix_var_vari* m)
+          : vari(m->values_.sum()), m_(m) { }
+
+        virtual void chain() {
+          m_->adjoints_.array() += adj_;
+        }
+      };
+    }
+
+    /**
+     * Returns the sum of the coefficients of the specified matrix
+     * variable.
+     *
+     * @param m Specified matrix.
+     * @return Sum of coefficients of matrix.
+     */
+    inline var sum(const matrix_var& m) {
+      if (m.size() == 0)
+        return 0.0;
+      return var(new sum_mv_vari(m.vi_));
+    }
+
   }
 }
 #endif
@@ -35,7 +35,7 @@ namespace stan {
       matrix_v MMt(M.rows(), M.rows());
 
       vari** vs
-        = reinterpret_cast<vari**>(ChainableStack::memalloc_
+        = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                    .alloc((M.rows() * M.cols())
                                           * sizeof(vari*)));
       int pos = 0;
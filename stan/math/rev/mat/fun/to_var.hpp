@@ -91,6 +91,21 @@ namespace stan {
       return rv;
     }
 
+    /**
+     * Converts a matrix variable to a matrix of scalar variables, one
+     * for each element, whose adjoints are propagated to the matrix
+     * variable.
+     *
+     * @param[in] m A matrix variable
+     * @return A Matrix with automatic differentiation variables
+     */
+    inline matrix_v to_var(const matrix_var& m) {
+      matrix_v m_v(m.rows(), m.cols());
+      for (int i = 0; i < m.size(); ++i)
+        m_v(i) = m(i);
+      return m_v;
+    }
+
   }
 }
 #endif
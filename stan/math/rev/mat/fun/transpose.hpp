@@ -0,0 +1,36 @@
+#ifndef STAN_MATH_REV_MAT_FUN_TRANSPOSE_HPP
+#define STAN_MATH_REV_MAT_FUN_TRANSPOSE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/rev/core.hpp>
+
+namespace stan {
+  namespace math {
+
+    namespace {
+      class transpose_mv_vari : public matrix_var_vari {
+      public:
+        matrix_var_vari* A_;
+
+        explicit transpose_mv_vari(matrix_var_vari* A)
+          : matrix_var_vari(A->values_.transpose()), A_(A) { }
+
+        virtual void chain() {
+          A_->adjoints_ += adjoints_.transpose();
+        }
+      };
+    }
+
+    /**
+     * Return the transpose of a matrix variable.
+     *
+     * @param[in] A matrix
+     * @return transpose of A
+     */
+    inline matrix_var transpose(const matrix_var& A) {
+      return matrix_var(new transpose_mv_vari(A.vi_));
+    }
+
+  }
+}
+#endif
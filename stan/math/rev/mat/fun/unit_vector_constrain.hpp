@@ -63,7 +63,7 @@ namespace stan {
       check_nonzero_size("unit_vector", "y", y);
 
       vari** y_vi_array
-        = reinterpret_cast<vari**>(ChainableStack::memalloc_
+        = reinterpret_cast<vari**>(ChainableStack::instance().memalloc_
                                    .alloc(sizeof(vari*) * y.size()));
       for (int i = 0; i < y.size(); ++i)
         y_vi_array[i] = y.coeff(i).vi_;
@@ -77,7 +77,7 @@ namespace stan {
       Eigen::VectorXd unit_vector_d = y_d / norm;
 
       double* unit_vector_y_d_array
-        = reinterpret_cast<double*>(ChainableStack::memalloc_
+        = reinterpret_cast<double*>(ChainableStack::instance().memalloc_
                                     .alloc(sizeof(double) * y_d.size()));
       for (int i = 0; i < y_d.size(); ++i)
         unit_vector_y_d_array[i] = unit_vector_d.coeff(i);
@@ -15,7 +15,8 @@ namespace stan {
 
       inline var calc_variance(size_t size,
                                const var* dtrs) {
-        vari** varis = reinterpret_cast<vari**>(ChainableStack::memalloc_
+        vari** varis = reinterpret_cast<vari**>(ChainableStack::instance()
+            .memalloc_
                                                 .alloc(size * sizeof(vari*)));
         for (size_t i = 0; i < size; ++i)
           varis[i] = dtrs[i].vi_;
@@ -30,7 +31,7 @@ namespace stan {
         }
         double variance = sum_of_squares / (size - 1);
         double* partials
-          = reinterpret_cast<double*>(ChainableStack::memalloc_
+          = reinterpret_cast<double*>(ChainableStack::instance().memalloc_
                                       .alloc(size * sizeof(double)));
         double two_over_size_m1 = 2 / (size - 1);
         for (size_t i = 0; i < size; ++i)
@@ -46,11 +46,12 @@ namespace stan {
                           FX& fx,
                           std::ostream* msgs)
         : vari(theta_dbl(0)),
-          y_(ChainableStack::memalloc_.alloc_array<vari*>(y.size())),
+          y_(ChainableStack::instance().memalloc_.alloc_array<vari*>(y.size())),
           y_size_(y.size()),
           x_size_(x.size()),
-          theta_(ChainableStack::memalloc_.alloc_array<vari*>(x_size_)),
-          Jx_y_(ChainableStack::memalloc_.alloc_array<double>
+          theta_(ChainableStack::instance().memalloc_.alloc_array<vari*>(
+              x_size_)),
+          Jx_y_(ChainableStack::instance().memalloc_.alloc_array<double>
                   (x_size_ * y_size_)) {
         using Eigen::MatrixXd;
         using Eigen::Map;
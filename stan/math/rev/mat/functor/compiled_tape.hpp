@@ -0,0 +1,418 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_COMPILED_TAPE_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_COMPILED_TAPE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/scal/fun/expm1.hpp>
+#include <stan/math/prim/scal/fun/inv_logit.hpp>
+#include <stan/math/prim/scal/fun/is_nan.hpp>
+#include <stan/math/prim/scal/fun/log1m_inv_logit.hpp>
+#include <stan/math/prim/scal/fun/log1p.hpp>
+#include <stan/math/prim/scal/fun/log1p_exp.hpp>
+#include <stan/math/prim/scal/fun/log_inv_logit.hpp>
+#include <stan/math/prim/scal/fun/constants.hpp>
+#include <stan/math/rev/core.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * A <code>compiled_tape</code> records the expression graph of a
+     * function once and then evaluates its value and gradient for new
+     * arguments from a flat program, without running the function or
+     * allocating variables.
+     *
+     * <p>The function must have static control flow: the graph may
+     * only depend on the argument through comparisons of
+     * <code>var</code>, which are recorded with their outcome, and
+     * it may only be built from operations tagged with a
+     * <code>replay_op</code> (the arithmetic operators,
+     * <code>sum()</code> of a standard vector and a set of scalar
+     * functions such as <code>exp()</code> and <code>log()</code>).
+     * <code>record()</code> reports whether the graph could be
+     * compiled.  <code>replay()</code> reports failure if any
+     * recorded comparison changes its outcome, if evaluating an
+     * operation throws, or if the value or gradient is not finite;
+     * the caller should then record the function again at the new
+     * argument, which also raises any errors the function throws.
+     *
+     * <p>Values that are computed with <code>double</code>, for
+     * example by branching on <code>value_of()</code>, cannot be seen
+     * by the recording.  Functions doing so must not be compiled.
+     */
+    class compiled_tape {
+    public:
+      compiled_tape()
+        : compiled_(false), num_independents_(0), result_(0) {
+      }
+
+      /**
+       * Calculate the value and the gradient of the specified
+       * function at the specified argument, as
+       * <code>gradient()</code> does, and compile its expression graph.
+       *
+       * @tparam F Type of function
+       * @param[in] f Function
+       * @param[in] x Argument to function
+       * @param[out] fx Function applied to argument
+       * @param[out] grad_fx Gradient of function at argument
+       * @return true if the graph was compiled
+       */
+      template <typename F>
+      bool record(const F& f,
+                  const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                  double& fx,
+                  Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+        compiled_ = false;
+        ChainableStack::AutodiffStackStorage& stack
+          = ChainableStack::instance();
+        tape_recording recording;
+        tape_recording* enclosing = stack.recording_;
+        start_nested();
+        try {
+          Eigen::Matrix<var, Eigen::Dynamic, 1> x_var(x.size());
+          for (int i = 0; i < x.size(); ++i)
+            x_var(i) = x(i);
+          stack.recording_ = &recording;
+          ++num_tape_recordings();
+          var fx_var = f(x_var);
+          --num_tape_recordings();
+          stack.recording_ = enclosing;
+          fx = fx_var.val();
+          grad_fx.resize(x.size());
+          grad(fx_var.vi_);
+          for (int i = 0; i < x.size(); ++i)
+            grad_fx(i) = x_var(i).adj();
+          compiled_ = compile(x_var, fx_var.vi_, recording);
+        } catch (const std::exception& /*e*/) {
+          if (stack.recording_ == &recording)
+            --num_tape_recordings();
+          stack.recording_ = enclosing;
+          recover_memory_nested();
+          throw;
+        }
+        recover_memory_nested();
+        return compiled_;
+      }
+
+      /**
+       * Calculate the value and the gradient of the compiled function
+       * at the specified argument.
+       *
+       * @param[in] x Argument to function
+       * @param[out] fx Function applied to argument
+       * @param[out] grad_fx Gradient of function at argument
+       * @return true if the value and gradient were calculated; false
+       * if nothing is compiled, the argument has the wrong size, the
+       * control flow diverges from the recording, an operation
+       * throws or the value or gradient is not finite
+       */
+      bool replay(const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                  double& fx,
+                  Eigen::Matrix<double, Eigen::Dynamic, 1>& grad_fx) {
+        if (!compiled_ || static_cast<size_t>(x.size()) != num_independents_)
+          return false;
+        for (size_t i = 0; i < num_independents_; ++i)
+          values_[i] = x(i);
+        try {
+          forward();
+        } catch (const std::exception& /*e*/) {
+          return false;
+        }
+        if (!same_comparisons())
+          return false;
+        fx = values_[result_];
+        if (!(boost::math::isfinite)(fx))
+          return false;
+        reverse();
+        grad_fx.resize(x.size());
+        for (size_t i = 0; i < num_independents_; ++i) {
+          if (!(boost::math::isfinite)(adjoints_[i]))
+            return false;
+          grad_fx(i) = adjoints_[i];
+        }
+        return true;
+      }
+
+      /**
+       * Return true if a graph is compiled.
+       *
+       * @return true if a graph is compiled
+       */
+      bool compiled() const {
+        return compiled_;
+      }
+
+      /**
+       * Return the number of operations of the compiled graph.
+       *
+       * @return number of operations
+       */
+      size_t num_ops() const {
+        return ops_.size();
+      }
+
+    private:
+      bool compiled_;
+      size_t num_independents_;
+      size_t result_;
+
+      // values of the independents, the constants and the results
+      std::vector<double> values_;
+      std::vector<double> adjoints_;
+
+      // program, one entry per operation
+      std::vector<int> ops_;
+      std::vector<double> constants_;
+      std::vector<size_t> arities_;
+      std::vector<size_t> results_;
+
+      // one entry per operand of each operation
+      std::vector<size_t> operands_;
+      std::vector<double> partials_;
+
+      // two operands per comparison
+      std::vector<int> comparisons_;
+      std::vector<size_t> comparison_operands_;
+      std::vector<char> comparison_results_;
+
+      typedef std::unordered_map<const vari*, size_t> slot_map;
+
+      size_t constant_slot(double value) {
+        values_.push_back(value);
+        return values_.size() - 1;
+      }
+
+      size_t slot(const vari* vi, slot_map& slots) {
+        slot_map::const_iterator it = slots.find(vi);
+        if (it != slots.end())
+          return it->second;
+        // neither independent nor result of an operation
+        size_t s = constant_slot(vi->val_);
+        slots[vi] = s;
+        return s;
+      }
+
+      bool compile(const Eigen::Matrix<var, Eigen::Dynamic, 1>& x,
+                   const vari* fx, const tape_recording& recording) {
+        ChainableStack::AutodiffStackStorage& stack
+          = ChainableStack::instance();
+        values_.clear();
+        ops_.clear();
+        constants_.clear();
+        arities_.clear();
+        results_.clear();
+        operands_.clear();
+        comparisons_.clear();
+        comparison_operands_.clear();
+        comparison_results_.clear();
+
+        // only constants and independents may remain on the stack
+        for (size_t i = stack.nested_var_stack_sizes_.back();
+             i < stack.var_stack_.size(); ++i)
+          if (typeid(*stack.var_stack_[i]) != typeid(vari))
+            return false;
+
+        slot_map slots;
+        num_independents_ = x.size();
+        for (size_t i = 0; i < num_independents_; ++i) {
+          values_.push_back(x(i).val());
+          slots[x(i).vi_] = i;
+        }
+
+        size_t r = 0;
+        size_t j = stack.nested_op_operand_sizes_.back();
+        for (size_t k = stack.nested_op_sizes_.back();
+             k < stack.op_results_.size(); ++k) {
+          if (r == recording.nodes_.size() || recording.nodes_[r] != k)
+            return false;
+          ops_.push_back(recording.ops_[r]);
+          constants_.push_back(recording.constants_[r]);
+          ++r;
+          size_t arity = stack.op_arities_[k];
+          arities_.push_back(arity);
+          for (size_t n = 0; n < arity; ++n)
+            operands_.push_back(slot(stack.op_operands_[j + n], slots));
+          j += arity;
+          size_t s = constant_slot(stack.op_results_[k]->val_);
+          slots[stack.op_results_[k]] = s;
+          results_.push_back(s);
+        }
+        result_ = slot(fx, slots);
+
+        for (size_t c = 0; c < recording.comparisons_.size(); ++c) {
+          comparisons_.push_back(recording.comparisons_[c]);
+          for (size_t n = 2 * c; n < 2 * c + 2; ++n) {
+            const vari* vi = recording.comparison_operands_[n];
+            comparison_operands_.push_back(
+                vi ? slot(vi, slots)
+                : constant_slot(recording.comparison_constants_[n]));
+          }
+          comparison_results_.push_back(recording.comparison_results_[c]);
+        }
+
+        partials_.resize(operands_.size());
+        adjoints_.resize(values_.size());
+        return true;
+      }
+
+      void forward() {
+        size_t j = 0;
+        for (size_t k = 0; k < ops_.size(); ++k) {
+          const size_t* operand = &operands_[j];
+          double* partial = &partials_[j];
+          double a = values_[operand[0]];
+          double b = arities_[k] > 1 ? values_[operand[1]] : 0;
+          double c = constants_[k];
+          double& f = values_[results_[k]];
+          switch (ops_[k]) {
+            case REPLAY_ADD_VV:
+              f = a + b;
+              partial[0] = 1;
+              partial[1] = 1;
+              break;
+            case REPLAY_ADD_VD:
+              f = a + c;
+              partial[0] = 1;
+              break;
+            case REPLAY_SUBTRACT_VV:
+              f = a - b;
+              partial[0] = 1;
+              partial[1] = -1;
+              break;
+            case REPLAY_SUBTRACT_VD:
+              f = a - c;
+              partial[0] = 1;
+              break;
+            case REPLAY_SUBTRACT_DV:
+              f = c - a;
+              partial[0] = -1;
+              break;
+            case REPLAY_MULTIPLY_VV:
+              f = a * b;
+              partial[0] = b;
+              partial[1] = a;
+              break;
+            case REPLAY_MULTIPLY_VD:
+              f = a * c;
+              partial[0] = c;
+              break;
+            case REPLAY_DIVIDE_VV:
+              f = a / b;
+              partial[0] = 1.0 / b;
+              partial[1] = -a / (b * b);
+              break;
+            case REPLAY_DIVIDE_VD:
+              f = a / c;
+              partial[0] = 1.0 / c;
+              break;
+            case REPLAY_DIVIDE_DV:
+              f = c / a;
+              partial[0] = -c / (a * a);
+              break;
+            case REPLAY_NEGATE:
+              f = -a;
+              partial[0] = -1;
+              break;
+            case REPLAY_SUM:
+              f = 0;
+              for (size_t n = 0; n < arities_[k]; ++n) {
+                f += values_[operand[n]];
+                partial[n] = 1;
+              }
+              break;
+            case REPLAY_EXP:
+              f = std::exp(a);
+              partial[0] = f;
+              break;
+            case REPLAY_EXPM1:
+              f = expm1(a);
+              partial[0] = f + 1;
+              break;
+            case REPLAY_LOG:
+              f = std::log(a);
+              partial[0] = 1.0 / a;
+              break;
+            case REPLAY_LOG1P:
+              f = log1p(a);
+              partial[0] = 1.0 / (1 + a);
+              break;
+            case REPLAY_SQRT:
+              f = std::sqrt(a);
+              partial[0] = 1.0 / (2.0 * f);
+              break;
+            case REPLAY_SQUARE:
+              f = a * a;
+              partial[0] = 2.0 * a;
+              break;
+            case REPLAY_INV_LOGIT:
+              f = inv_logit(a);
+              partial[0] = f * (1.0 - f);
+              break;
+            case REPLAY_LOG1P_EXP:
+              f = log1p_exp(a);
+              partial[0] = std::exp(a - f);
+              break;
+            case REPLAY_LOG_INV_LOGIT:
+              f = log_inv_logit(a);
+              partial[0] = inv_logit(-a);
+              break;
+            case REPLAY_LOG1M_INV_LOGIT:
+              f = log1m_inv_logit(a);
+              partial[0] = -inv_logit(a);
+              break;
+          }
+          // NaN operands propagate NaN partials, as the varis other
+          // than sum's do
+          if (ops_[k] != REPLAY_SUM) {
+            bool nan_operand = is_nan(c);
+            for (size_t n = 0; n < arities_[k]; ++n)
+              nan_operand = nan_operand || is_nan(values_[operand[n]]);
+            if (unlikely(nan_operand))
+              std::fill(partial, partial + arities_[k], NOT_A_NUMBER);
+          }
+          j += arities_[k];
+        }
+      }
+
+      bool same_comparisons() const {
+        for (size_t c = 0; c < comparisons_.size(); ++c) {
+          double a = values_[comparison_operands_[2 * c]];
+          double b = values_[comparison_operands_[2 * c + 1]];
+          bool result = false;
+          switch (comparisons_[c]) {
+            case COMPARE_LT: result = a < b; break;
+            case COMPARE_LE: result = a <= b; break;
+            case COMPARE_GT: result = a > b; break;
+            case COMPARE_GE: result = a >= b; break;
+            case COMPARE_EQ: result = a == b; break;
+            case COMPARE_NE: result = a != b; break;
+          }
+          if (result != static_cast<bool>(comparison_results_[c]))
+            return false;
+        }
+        return true;
+      }
+
+      void reverse() {
+        std::fill(adjoints_.begin(), adjoints_.end(), 0.0);
+        adjoints_[result_] = 1;
+        size_t j = operands_.size();
+        for (size_t k = ops_.size(); k-- > 0; ) {
+          j -= arities_[k];
+          double adj = adjoints_[results_[k]];
+          for (size_t n = 0; n < arities_[k]; ++n)
+            adjoints_[operands_[j + n]] += adj * partials_[j + n];
+        }
+      }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,369 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_CVODES_ADJOINT_DATA_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_CVODES_ADJOINT_DATA_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/mat/functor/ode_system.hpp>
+#include <stan/math/rev/mat/functor/cvodes_utils.hpp>
+#include <cvodes/cvodes.h>
+#include <cvodes/cvodes_band.h>
+#include <cvodes/cvodes_dense.h>
+#include <nvector/nvector_serial.h>
+#include <algorithm>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * CVODES adjoint ode data holder object, which owns the CVODES
+     * memory of a forward solve with checkpointing and integrates
+     * the adjoint system backward in time when the gradient is
+     * requested.
+     *
+     * Only the N states are integrated forward.  Given the adjoints
+     * lambda of the states at the solution times, the backward
+     * problem integrates
+     *
+     * <code>d lambda / dt = -Jy^T lambda</code>
+     *
+     * from the last solution time to the initial time together with
+     * the quadrature
+     *
+     * <code>d mu / dt = -Jtheta^T lambda</code>,
+     *
+     * so that lambda and mu at the initial time are the adjoints of
+     * the initial state and of the parameters.  Both right hand sides
+     * are vector-Jacobian products computed with a single nested
+     * reverse pass, so the cost scales with the number of states
+     * rather than with states times parameters.
+     *
+     * The object is a chainable_alloc, so the CVODES memory is freed
+     * along with the autodiff stack.
+     *
+     * @tparam F type of functor for the base ode system.
+     */
+    template <typename F>
+    class cvodes_adjoint_data : public chainable_alloc {
+      const F f_;
+      const std::vector<double> x_;
+      const std::vector<int> x_int_;
+      const ode_system<F> ode_system_;
+      const size_t N_;
+      const size_t M_;
+      const double t0_;
+      const std::vector<double> ts_;
+      const double relative_tolerance_;
+      const double absolute_tolerance_;
+      const long int max_num_steps_;  // NOLINT(runtime/int)
+      const bool param_var_;
+      std::vector<double> state_;
+      N_Vector cvodes_state_;
+      N_Vector cvodes_state_adj_;
+      N_Vector cvodes_quad_adj_;
+      void* cvodes_mem_;
+      int index_backward_;
+
+      typedef cvodes_adjoint_data<F> adjoint_data;
+
+    public:
+      /**
+       * Construct CVODES adjoint ode data object.  The functor and
+       * the data are copied, as the backward solve takes place in the
+       * reverse pass, after the arguments went out of scope.
+       *
+       * @param[in] f ode functor.
+       * @param[in] y0 values of the initial state.
+       * @param[in] t0 initial time.
+       * @param[in] ts times of the desired solutions.
+       * @param[in] theta values of the parameters.
+       * @param[in] x continuous data vector for the ODE.
+       * @param[in] x_int integer data vector for the ODE.
+       * @param[in] msgs stream to which messages are printed.
+       * @param[in] relative_tolerance relative tolerance passed to
+       * CVODE.
+       * @param[in] absolute_tolerance absolute tolerance passed to
+       * CVODE.
+       * @param[in] max_num_steps maximal number of admissable steps
+       * between time-points
+       * @param[in] param_var true if the gradient with respect to the
+       * parameters is required.
+       */
+      cvodes_adjoint_data(const F& f,
+                          const std::vector<double>& y0,
+                          double t0,
+                          const std::vector<double>& ts,
+                          const std::vector<double>& theta,
+                          const std::vector<double>& x,
+                          const std::vector<int>& x_int,
+                          std::ostream* msgs,
+                          double relative_tolerance,
+                          double absolute_tolerance,
+                          long int max_num_steps,  // NOLINT(runtime/int)
+                          bool param_var)
+        : f_(f),
+          x_(x),
+          x_int_(x_int),
+          ode_system_(f_, theta, x_, x_int_, msgs),
+          N_(y0.size()),
+          M_(theta.size()),
+          t0_(t0),
+          ts_(ts),
+          relative_tolerance_(relative_tolerance),
+          absolute_tolerance_(absolute_tolerance),
+          max_num_steps_(max_num_steps),
+          param_var_(param_var),
+          state_(y0),
+          cvodes_state_(N_VMake_Serial(N_, &state_[0])),
+          cvodes_state_adj_(N_VNew_Serial(N_)),
+          cvodes_quad_adj_(param_var ? N_VNew_Serial(M_) : NULL),
+          cvodes_mem_(NULL),
+          index_backward_(-1) { }
+
+      ~cvodes_adjoint_data() {
+        N_VDestroy_Serial(cvodes_state_);
+        N_VDestroy_Serial(cvodes_state_adj_);
+        if (cvodes_quad_adj_ != NULL)
+          N_VDestroy_Serial(cvodes_quad_adj_);
+        if (cvodes_mem_ != NULL)
+          CVodeFree(&cvodes_mem_);
+      }
+
+      /**
+       * Integrate the ODE forward in time, storing checkpoints for the
+       * backward solve, and write the states at the solution times to
+       * the specified array, one time after the other.
+       *
+       * @param[out] y array of size N times number of solution times.
+       */
+      void forward(double* y) {
+        cvodes_mem_ = CVodeCreate(CV_BDF, CV_NEWTON);
+        if (cvodes_mem_ == NULL)
+          throw std::runtime_error("CVodeCreate failed to allocate memory");
+
+        cvodes_check_flag(CVodeInit(cvodes_mem_, &adjoint_data::ode_rhs,
+                                    t0_, cvodes_state_),
+                          "CVodeInit");
+        cvodes_check_flag(CVodeSetUserData(cvodes_mem_,
+                            reinterpret_cast<void*>(this)),
+                          "CVodeSetUserData");
+        cvodes_set_options(cvodes_mem_,
+                           relative_tolerance_, absolute_tolerance_,
+                           max_num_steps_);
+        cvodes_check_flag(CVDense(cvodes_mem_, N_), "CVDense");
+        cvodes_check_flag(CVDlsSetDenseJacFn(cvodes_mem_,
+                                             &adjoint_data::dense_jacobian),
+                          "CVDlsSetDenseJacFn");
+
+        // number of steps between checkpoints, each holding the
+        // Hermite interpolation data for the backward solve
+        long int steps_checkpoint = 150;  // NOLINT(runtime/int)
+        cvodes_check_flag(CVodeAdjInit(cvodes_mem_, steps_checkpoint,
+                                       CV_HERMITE),
+                          "CVodeAdjInit");
+
+        // CVodeF steps internally until the solution time is reached,
+        // so the maximal number of steps is enforced here
+        double t_init = t0_;
+        for (size_t n = 0; n < ts_.size(); ++n) {
+          long int num_steps = 0;  // NOLINT(runtime/int)
+          int num_checkpoints;
+          do {
+            if (++num_steps > max_num_steps_)
+              cvodes_check_flag(CV_TOO_MUCH_WORK, "CVodeF");
+            cvodes_check_flag(CVodeF(cvodes_mem_, ts_[n], cvodes_state_,
+                                     &t_init, CV_ONE_STEP, &num_checkpoints),
+                              "CVodeF");
+          } while (t_init < ts_[n]);
+          cvodes_check_flag(CVodeGetDky(cvodes_mem_, ts_[n], 0,
+                                        cvodes_state_),
+                            "CVodeGetDky");
+          std::copy(state_.begin(), state_.end(), y + n * N_);
+        }
+      }
+
+      /**
+       * Integrate the adjoint system backward in time, from the last
+       * solution time to the initial time, adding the adjoints of the
+       * states at each solution time as they are passed.
+       *
+       * @param[in] y_adj adjoints of the states at the solution times,
+       * array of size N times number of solution times.
+       * @param[out] y0_adj adjoints of the initial state, length N.
+       * @param[out] theta_adj adjoints of the parameters, length M,
+       * only written if the parameters are autodiff variables.
+       */
+      void backward(const double* y_adj, double* y0_adj, double* theta_adj) {
+        size_t T = ts_.size();
+        double t_init = ts_[T - 1];
+        std::copy(y_adj + (T - 1) * N_, y_adj + T * N_,
+                  NV_DATA_S(cvodes_state_adj_));
+        if (param_var_)
+          N_VConst(RCONST(0.0), cvodes_quad_adj_);
+        init_backward(t_init);
+
+        for (size_t n = T; n-- > 0; ) {
+          double t_final = n > 0 ? ts_[n - 1] : t0_;
+          cvodes_check_flag(CVodeB(cvodes_mem_, t_final, CV_NORMAL),
+                            "CVodeB");
+          cvodes_check_flag(CVodeGetB(cvodes_mem_, index_backward_,
+                                      &t_init, cvodes_state_adj_),
+                            "CVodeGetB");
+          if (param_var_)
+            cvodes_check_flag(CVodeGetQuadB(cvodes_mem_, index_backward_,
+                                            &t_init, cvodes_quad_adj_),
+                              "CVodeGetQuadB");
+          if (n > 0) {
+            for (size_t i = 0; i < N_; ++i)
+              NV_Ith_S(cvodes_state_adj_, i) += y_adj[(n - 1) * N_ + i];
+            reinit_backward(t_final);
+          }
+        }
+
+        std::copy(NV_DATA_S(cvodes_state_adj_),
+                  NV_DATA_S(cvodes_state_adj_) + N_, y0_adj);
+        if (param_var_)
+          std::copy(NV_DATA_S(cvodes_quad_adj_),
+                    NV_DATA_S(cvodes_quad_adj_) + M_, theta_adj);
+      }
+
+      static int ode_rhs(double t, N_Vector y, N_Vector ydot,
+                         void* user_data) {
+        const adjoint_data* explicit_ode
+          = static_cast<const adjoint_data*>(user_data);
+        const std::vector<double> y_vec(NV_DATA_S(y),
+                                        NV_DATA_S(y) + explicit_ode->N_);
+        Eigen::Map<Eigen::VectorXd> dy_dt(NV_DATA_S(ydot), explicit_ode->N_);
+        explicit_ode->ode_system_(t, y_vec, dy_dt);
+        return 0;
+      }
+
+      static int dense_jacobian(long int N,  // NOLINT(runtime/int)
+                                realtype t, N_Vector y, N_Vector fy,
+                                DlsMat J, void* user_data,
+                                N_Vector tmp1, N_Vector tmp2, N_Vector tmp3) {
+        const adjoint_data* explicit_ode
+          = static_cast<const adjoint_data*>(user_data);
+        const std::vector<double> y_vec(NV_DATA_S(y), NV_DATA_S(y) + N);
+        Eigen::VectorXd dy_dt(N);
+        Eigen::Map<Eigen::MatrixXd> Jy(J->data, N, N);
+        explicit_ode->ode_system_.jacobian(t, y_vec, dy_dt, Jy);
+        return 0;
+      }
+
+      static int adjoint_rhs(double t, N_Vector y, N_Vector yB,
+                             N_Vector yBdot, void* user_data) {
+        const adjoint_data* explicit_ode
+          = static_cast<const adjoint_data*>(user_data);
+        size_t N = explicit_ode->N_;
+        const std::vector<double> y_vec(NV_DATA_S(y), NV_DATA_S(y) + N);
+        Eigen::Map<const Eigen::VectorXd> lambda(NV_DATA_S(yB), N);
+        Eigen::Map<Eigen::VectorXd> lambda_dot(NV_DATA_S(yBdot), N);
+        explicit_ode->ode_system_.vector_jacobian(t, y_vec, lambda,
+                                                  lambda_dot);
+        lambda_dot = -lambda_dot;
+        return 0;
+      }
+
+      static int adjoint_quad_rhs(double t, N_Vector y, N_Vector yB,
+                                  N_Vector qBdot, void* user_data) {
+        const adjoint_data* explicit_ode
+          = static_cast<const adjoint_data*>(user_data);
+        size_t N = explicit_ode->N_;
+        const std::vector<double> y_vec(NV_DATA_S(y), NV_DATA_S(y) + N);
+        Eigen::Map<const Eigen::VectorXd> lambda(NV_DATA_S(yB), N);
+        Eigen::VectorXd lambda_Jy(N);
+        Eigen::Map<Eigen::VectorXd> mu_dot(NV_DATA_S(qBdot),
+                                           explicit_ode->M_);
+        explicit_ode->ode_system_.vector_jacobian(t, y_vec, lambda,
+                                                  lambda_Jy, mu_dot);
+        mu_dot = -mu_dot;
+        return 0;
+      }
+
+      static int adjoint_dense_jacobian(long int N,  // NOLINT(runtime/int)
+                                        realtype t, N_Vector y,
+                                        N_Vector yB, N_Vector fyB,
+                                        DlsMat JB, void* user_data,
+                                        N_Vector tmp1, N_Vector tmp2,
+                                        N_Vector tmp3) {
+        const adjoint_data* explicit_ode
+          = static_cast<const adjoint_data*>(user_data);
+        const std::vector<double> y_vec(NV_DATA_S(y), NV_DATA_S(y) + N);
+        Eigen::VectorXd dy_dt(N);
+        Eigen::MatrixXd Jy(N, N);
+        explicit_ode->ode_system_.jacobian(t, y_vec, dy_dt, Jy);
+        Eigen::Map<Eigen::MatrixXd>(JB->data, N, N) = -Jy.transpose();
+        return 0;
+      }
+
+    private:
+      /**
+       * Create the backward problem on the first reverse pass, or
+       * reinitialize it for later ones.
+       *
+       * @param[in] t_init time at which the backward solve starts.
+       */
+      void init_backward(double t_init) {
+        if (index_backward_ >= 0) {
+          reinit_backward(t_init);
+          return;
+        }
+        cvodes_check_flag(CVodeCreateB(cvodes_mem_, CV_BDF, CV_NEWTON,
+                                       &index_backward_),
+                          "CVodeCreateB");
+        cvodes_check_flag(CVodeInitB(cvodes_mem_, index_backward_,
+                                     &adjoint_data::adjoint_rhs,
+                                     t_init, cvodes_state_adj_),
+                          "CVodeInitB");
+        cvodes_check_flag(CVodeSStolerancesB(cvodes_mem_, index_backward_,
+                                             relative_tolerance_,
+                                             absolute_tolerance_),
+                          "CVodeSStolerancesB");
+        cvodes_check_flag(CVodeSetUserDataB(cvodes_mem_, index_backward_,
+                            reinterpret_cast<void*>(this)),
+                          "CVodeSetUserDataB");
+        cvodes_check_flag(CVodeSetMaxNumStepsB(cvodes_mem_, index_backward_,
+                                               max_num_steps_),
+                          "CVodeSetMaxNumStepsB");
+        cvodes_check_flag(CVDenseB(cvodes_mem_, index_backward_, N_),
+                          "CVDenseB");
+        cvodes_check_flag(CVDlsSetDenseJacFnB(cvodes_mem_, index_backward_,
+                            &adjoint_data::adjoint_dense_jacobian),
+                          "CVDlsSetDenseJacFnB");
+        if (param_var_) {
+          cvodes_check_flag(CVodeQuadInitB(cvodes_mem_, index_backward_,
+                              &adjoint_data::adjoint_quad_rhs,
+                              cvodes_quad_adj_),
+                            "CVodeQuadInitB");
+          cvodes_check_flag(CVodeQuadSStolerancesB(cvodes_mem_,
+                                                   index_backward_,
+                                                   relative_tolerance_,
+                                                   absolute_tolerance_),
+                            "CVodeQuadSStolerancesB");
+          cvodes_check_flag(CVodeSetQuadErrConB(cvodes_mem_, index_backward_,
+                                                TRUE),
+                            "CVodeSetQuadErrConB");
+        }
+      }
+
+      /**
+       * Restart the backward problem from the current adjoints.
+       *
+       * @param[in] t_init time at which the backward solve restarts.
+       */
+      void reinit_backward(double t_init) {
+        cvodes_check_flag(CVodeReInitB(cvodes_mem_, index_backward_,
+                                       t_init, cvodes_state_adj_),
+                          "CVodeReInitB");
+        if (param_var_)
+          cvodes_check_flag(CVodeQuadReInitB(cvodes_mem_, index_backward_,
+                                             cvodes_quad_adj_),
+                            "CVodeQuadReInitB");
+      }
+    };
+
+  }
+}
+#endif
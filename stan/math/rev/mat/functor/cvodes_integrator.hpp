@@ -0,0 +1,213 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_CVODES_INTEGRATOR_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_CVODES_INTEGRATOR_HPP
+
+#include <stan/math/rev/scal/meta/is_var.hpp>
+#include <stan/math/rev/mat/functor/cvodes_utils.hpp>
+#include <stan/math/rev/mat/functor/cvodes_ode_data.hpp>
+#include <cvodes/cvodes.h>
+#include <cvodes/cvodes_band.h>
+#include <cvodes/cvodes_dense.h>
+#include <nvector/nvector_serial.h>
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Free memory allocated for CVODES state, sensitivity, and
+     * general memory.
+     *
+     * @param[in] cvodes_state State vector.
+     * @param[in] cvodes_state_sens Sensitivity vector.
+     * @param[in] cvodes_mem Memory held for CVODES.
+     * @param[in] S Number of sensitivities being calculated.
+     */
+    inline void free_cvodes_memory(N_Vector& cvodes_state,
+                                   N_Vector* cvodes_state_sens,
+                                   void* cvodes_mem, size_t S) {
+      N_VDestroy_Serial(cvodes_state);
+      if (cvodes_state_sens != NULL)
+        N_VDestroyVectorArray_Serial(cvodes_state_sens, S);
+      CVodeFree(&cvodes_mem);
+    }
+
+    /**
+     * CVODES backward differentiation formula solver with forward
+     * sensitivities, whose memory is kept across solves.
+     *
+     * The solver memory, the dense linear solver and the
+     * sensitivity vectors are allocated on the first call to
+     * integrate() and are re-initialized with
+     * <code>CVodeReInit</code> and <code>CVodeSensReInit</code> on
+     * later calls, so that a sequence of ODE problems of the same
+     * size, such as one per subject of a population model, does not
+     * allocate and free the CVODES memory for each problem.
+     *
+     * @tparam F type of ODE system function.
+     * @tparam T_initial type of scalars for initial values.
+     * @tparam T_param type of scalars for parameters.
+     */
+    template <typename F, typename T_initial, typename T_param>
+    class cvodes_integrator {
+      typedef cvodes_ode_data<F, T_initial, T_param> ode_data;
+      typedef stan::is_var<T_initial> initial_var;
+      typedef stan::is_var<T_param> param_var;
+
+      const size_t N_;
+      const size_t S_;
+      std::vector<double> state_;
+      N_Vector cvodes_state_;
+      N_Vector* cvodes_state_sens_;
+      void* cvodes_mem_;
+      bool initialized_;
+
+      cvodes_integrator(const cvodes_integrator&);
+      cvodes_integrator& operator=(const cvodes_integrator&);
+
+    public:
+      /**
+       * Construct a solver for ODE systems with the specified number
+       * of states and parameters.
+       *
+       * @param[in] N number of states.
+       * @param[in] M number of parameters.
+       * @throw std::runtime_error if CVODES fails to allocate memory.
+       */
+      cvodes_integrator(size_t N, size_t M)
+        : N_(N),
+          S_((initial_var::value ? N : 0) + (param_var::value ? M : 0)),
+          state_(N),
+          cvodes_state_(N_VMake_Serial(N, &state_[0])),
+          cvodes_state_sens_(NULL),
+          cvodes_mem_(CVodeCreate(CV_BDF, CV_NEWTON)),
+          initialized_(false) {
+        if (cvodes_mem_ == NULL) {
+          N_VDestroy_Serial(cvodes_state_);
+          throw std::runtime_error("CVodeCreate failed to allocate memory");
+        }
+      }
+
+      ~cvodes_integrator() {
+        free_cvodes_memory(cvodes_state_, cvodes_state_sens_, cvodes_mem_,
+                           S_);
+      }
+
+      /**
+       * Solve the ODE system of the specified CVODES data and return
+       * the states and their sensitivities at the specified times.
+       *
+       * Each returned vector holds the N states followed by the
+       * sensitivities of the states to the initial values, if they
+       * are autodiff variables, and to the parameters, if they are
+       * autodiff variables, N per variable.
+       *
+       * @param[in] cvodes_data CVODES data of the ODE system.
+       * @param[in] y0 initial state.
+       * @param[in] t0 initial time.
+       * @param[in] ts times of the desired solutions.
+       * @param[in] relative_tolerance relative tolerance passed to
+       * CVODE.
+       * @param[in] absolute_tolerance absolute tolerance passed to
+       * CVODE.
+       * @param[in] max_num_steps maximal number of admissable steps
+       * between time-points
+       * @return coupled states, one vector per time.
+       * @throw std::runtime_error if CVODES fails.
+       */
+      std::vector<std::vector<double> >
+      integrate(ode_data& cvodes_data,
+                const std::vector<double>& y0,
+                double t0,
+                const std::vector<double>& ts,
+                double relative_tolerance,
+                double absolute_tolerance,
+                long int max_num_steps) {  // NOLINT(runtime/int)
+        std::vector<std::vector<double> >
+          y_coupled(ts.size(), std::vector<double>(N_ * (S_ + 1), 0));
+
+        std::copy(y0.begin(), y0.end(), state_.begin());
+        if (!initialized_) {
+          cvodes_check_flag(CVodeInit(cvodes_mem_, &ode_data::ode_rhs,
+                                      t0, cvodes_state_),
+                            "CVodeInit");
+        } else {
+          cvodes_check_flag(CVodeReInit(cvodes_mem_, t0, cvodes_state_),
+                            "CVodeReInit");
+        }
+
+        // Assign pointer to the data as user data
+        cvodes_check_flag(CVodeSetUserData(cvodes_mem_,
+                            reinterpret_cast<void*>(&cvodes_data)),
+                          "CVodeSetUserData");
+
+        cvodes_set_options(cvodes_mem_,
+                           relative_tolerance, absolute_tolerance,
+                           max_num_steps);
+
+        if (!initialized_) {
+          // for the stiff solvers we need to reserve additional
+          // memory and provide a Jacobian function call
+          cvodes_check_flag(CVDense(cvodes_mem_, N_), "CVDense");
+          cvodes_check_flag(CVDlsSetDenseJacFn(cvodes_mem_,
+                                               &ode_data::dense_jacobian),
+                            "CVDlsSetDenseJacFn");
+        }
+
+        // initialize forward sensitivity system of CVODES as needed
+        if (S_ > 0) {
+          if (cvodes_state_sens_ == NULL)
+            cvodes_state_sens_ = N_VCloneVectorArray_Serial(S_, cvodes_state_);
+          for (size_t s = 0; s < S_; s++)
+            N_VConst(RCONST(0.0), cvodes_state_sens_[s]);
+
+          // for varying initials, first N sensitivity systems
+          // are for initials which have as initial the identity matrix
+          if (initial_var::value) {
+            for (size_t n = 0; n < N_; n++)
+              NV_Ith_S(cvodes_state_sens_[n], n) = 1.0;
+          }
+          if (!initialized_) {
+            cvodes_check_flag(CVodeSensInit(cvodes_mem_, static_cast<int>(S_),
+                                            CV_STAGGERED,
+                                            &ode_data::ode_rhs_sens,
+                                            cvodes_state_sens_),
+                              "CVodeSensInit");
+          } else {
+            cvodes_check_flag(CVodeSensReInit(cvodes_mem_, CV_STAGGERED,
+                                              cvodes_state_sens_),
+                              "CVodeSensReInit");
+          }
+
+          cvodes_check_flag(CVodeSensEEtolerances(cvodes_mem_),
+                            "CVodeSensEEtolerances");
+        }
+        initialized_ = true;
+
+        double t_init = t0;
+        for (size_t n = 0; n < ts.size(); ++n) {
+          double t_final = ts[n];
+          if (t_final != t_init)
+            cvodes_check_flag(CVode(cvodes_mem_, t_final, cvodes_state_,
+                                    &t_init, CV_NORMAL),
+                              "CVode");
+          std::copy(state_.begin(), state_.end(), y_coupled[n].begin());
+          if (S_ > 0) {
+            cvodes_check_flag(CVodeGetSens(cvodes_mem_, &t_init,
+                                           cvodes_state_sens_),
+                              "CVodeGetSens");
+            for (size_t s = 0; s < S_; s++)
+              std::copy(NV_DATA_S(cvodes_state_sens_[s]),
+                        NV_DATA_S(cvodes_state_sens_[s]) + N_,
+                        y_coupled[n].begin() + N_ + s * N_);
+          }
+          t_init = t_final;
+        }
+        return y_coupled;
+      }
+    };
+
+  }
+}
+#endif
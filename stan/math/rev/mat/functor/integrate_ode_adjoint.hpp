@@ -0,0 +1,256 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_INTEGRATE_ODE_ADJOINT_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_INTEGRATE_ODE_ADJOINT_HPP
+
+#include <stan/math/rev/core.hpp>
+#include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/prim/scal/err/check_less.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/invalid_argument.hpp>
+#include <stan/math/prim/arr/err/check_nonzero_size.hpp>
+#include <stan/math/prim/arr/err/check_ordered.hpp>
+#include <stan/math/rev/scal/meta/is_var.hpp>
+#include <stan/math/rev/mat/functor/cvodes_adjoint_data.hpp>
+#include <stan/math/rev/mat/functor/integrate_ode_bdf.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * This is a subclass of the vari class for the solutions of an
+     * ODE with the adjoint method.
+     *
+     * The class holds pointers to the varis of the solutions, which
+     * are on the var_nochain_stack_, and to the varis of the initial
+     * state and parameters which are autodiff variables.  In the
+     * reverse pass the adjoints of all the solutions are propagated
+     * at once with a single backward solve.
+     *
+     * @tparam F type of ODE system function.
+     */
+    template <typename F>
+    class integrate_ode_adjoint_vari : public vari {
+    public:
+      const size_t size_;
+      const size_t y0_size_;
+      const size_t theta_size_;
+      cvodes_adjoint_data<F>* data_;
+      vari** y0_;
+      vari** theta_;
+      vari** y_;
+
+      /**
+       * Constructor for integrate_ode_adjoint.
+       *
+       * All memory allocated in
+       * ChainableStack's stack_alloc arena.
+       *
+       * @param data CVODES data of the forward solve.
+       * @param y solutions of the ODE, one time after the other.
+       * @param size number of solutions.
+       * @param y0 varis of the initial state, or NULL if it is data.
+       * @param y0_size number of states.
+       * @param theta varis of the parameters, or NULL if they are
+       * data.
+       * @param theta_size number of parameters.
+       */
+      integrate_ode_adjoint_vari(cvodes_adjoint_data<F>* data,
+                                 const double* y, size_t size,
+                                 vari** y0, size_t y0_size,
+                                 vari** theta, size_t theta_size)
+        : vari(0.0),
+          size_(size),
+          y0_size_(y0_size),
+          theta_size_(theta_size),
+          data_(data),
+          y0_(y0),
+          theta_(theta),
+          y_(ChainableStack::instance().memalloc_.alloc_array<vari*>(size)) {
+        for (size_t n = 0; n < size_; ++n)
+          y_[n] = new vari(y[n], false);
+      }
+
+      virtual void chain() {
+        std::vector<double> y_adj(size_);
+        for (size_t n = 0; n < size_; ++n)
+          y_adj[n] = y_[n]->adj_;
+        std::vector<double> y0_adj(y0_size_);
+        std::vector<double> theta_adj(theta_size_);
+        data_->backward(&y_adj[0], &y0_adj[0],
+                        theta_ ? &theta_adj[0] : 0);
+        if (y0_)
+          for (size_t i = 0; i < y0_size_; ++i)
+            y0_[i]->adj_ += y0_adj[i];
+        if (theta_)
+          for (size_t m = 0; m < theta_size_; ++m)
+            theta_[m]->adj_ += theta_adj[m];
+      }
+    };
+
+    /**
+     * Return the varis of the specified autodiff variables, allocated
+     * in the arena.
+     *
+     * @param x autodiff variables.
+     * @return array of varis.
+     */
+    inline vari** integrate_ode_adjoint_varis(const std::vector<var>& x) {
+      vari** varis
+        = ChainableStack::instance().memalloc_.alloc_array<vari*>(x.size());
+      for (size_t i = 0; i < x.size(); ++i)
+        varis[i] = x[i].vi_;
+      return varis;
+    }
+
+    /**
+     * No varis for data.
+     *
+     * @param x data.
+     * @return NULL
+     */
+    inline vari**
+    integrate_ode_adjoint_varis(const std::vector<double>& x) {
+      return 0;
+    }
+
+    /**
+     * Return the solutions for the specified system of ordinary
+     * differential equations given the specified initial state,
+     * initial times, times of desired solution, and parameters and
+     * data, writing error and warning messages to the specified
+     * stream.
+     *
+     * The solver is the same backward differentiation formula as for
+     * integrate_ode_bdf(), but the gradients are computed with the
+     * adjoint method rather than with forward sensitivities.  Only
+     * the N states are integrated forward, with checkpoints, and a
+     * single backward solve of N states and a quadrature of M
+     * parameters yields the gradients of all the solutions in the
+     * reverse pass, where integrate_ode_bdf() integrates N + N * (N +
+     * M) states.  This pays off for systems with many parameters.
+     *
+     * @tparam F type of ODE system function.
+     * @tparam T_initial type of scalars for initial values.
+     * @tparam T_param type of scalars for parameters.
+     * @param[in] f functor for the base ordinary differential equation.
+     * @param[in] y0 initial state.
+     * @param[in] t0 initial time.
+     * @param[in] ts times of the desired solutions, in strictly
+     * increasing order, all greater than the initial time.
+     * @param[in] theta parameter vector for the ODE.
+     * @param[in] x continuous data vector for the ODE.
+     * @param[in] x_int integer data vector for the ODE.
+     * @param[in, out] msgs the print stream for warning messages.
+     * @param[in] relative_tolerance relative tolerance passed to CVODE.
+     * @param[in] absolute_tolerance absolute tolerance passed to CVODE.
+     * @param[in] max_num_steps maximal number of admissable steps
+     * between time-points
+     * @return a vector of states, each state being a vector of the
+     * same size as the state variable, corresponding to a time in ts.
+     */
+    template <typename F, typename T_initial, typename T_param>
+    std::vector<std::vector<var> >
+    integrate_ode_adjoint(const F& f,
+                          const std::vector<T_initial>& y0,
+                          double t0,
+                          const std::vector<double>& ts,
+                          const std::vector<T_param>& theta,
+                          const std::vector<double>& x,
+                          const std::vector<int>& x_int,
+                          std::ostream* msgs = 0,
+                          double relative_tolerance = 1e-10,
+                          double absolute_tolerance = 1e-10,
+                          // NOLINTNEXTLINE(runtime/int)
+                          long int max_num_steps = 1e8) {
+      check_finite("integrate_ode_adjoint", "initial state", y0);
+      check_finite("integrate_ode_adjoint", "initial time", t0);
+      check_finite("integrate_ode_adjoint", "times", ts);
+      check_finite("integrate_ode_adjoint", "parameter vector", theta);
+      check_finite("integrate_ode_adjoint", "continuous data", x);
+      check_nonzero_size("integrate_ode_adjoint", "times", ts);
+      check_nonzero_size("integrate_ode_adjoint", "initial state", y0);
+      check_ordered("integrate_ode_adjoint", "times", ts);
+      check_less("integrate_ode_adjoint", "initial time", t0, ts[0]);
+      if (relative_tolerance <= 0)
+        invalid_argument("integrate_ode_adjoint",
+                         "relative_tolerance,", relative_tolerance,
+                         "", ", must be greater than 0");
+      if (absolute_tolerance <= 0)
+        invalid_argument("integrate_ode_adjoint",
+                         "absolute_tolerance,", absolute_tolerance,
+                         "", ", must be greater than 0");
+      if (max_num_steps <= 0)
+        invalid_argument("integrate_ode_adjoint",
+                         "max_num_steps,", max_num_steps,
+                         "", ", must be greater than 0");
+
+      const size_t N = y0.size();
+      const size_t M = theta.size();
+      const size_t T = ts.size();
+      vari** y0_varis = integrate_ode_adjoint_varis(y0);
+      vari** theta_varis = M > 0 ? integrate_ode_adjoint_varis(theta) : 0;
+
+      cvodes_adjoint_data<F>* data
+        = new cvodes_adjoint_data<F>(f, value_of(y0), t0, ts,
+                                     value_of(theta), x, x_int, msgs,
+                                     relative_tolerance, absolute_tolerance,
+                                     max_num_steps, theta_varis != 0);
+      std::vector<double> y(N * T);
+      data->forward(&y[0]);
+
+      integrate_ode_adjoint_vari<F>* baseVari
+        = new integrate_ode_adjoint_vari<F>(data, &y[0], N * T,
+                                            y0_varis, N, theta_varis, M);
+      std::vector<std::vector<var> > y_return(T, std::vector<var>(N));
+      for (size_t n = 0; n < T; ++n)
+        for (size_t i = 0; i < N; ++i)
+          y_return[n][i].vi_ = baseVari->y_[n * N + i];
+      return y_return;
+    }
+
+    /**
+     * Return the solutions for the specified system of ordinary
+     * differential equations with data initial state and
+     * parameters, for which no gradients are needed, as computed by
+     * integrate_ode_bdf().
+     *
+     * @tparam F type of ODE system function.
+     * @param[in] f functor for the base ordinary differential equation.
+     * @param[in] y0 initial state.
+     * @param[in] t0 initial time.
+     * @param[in] ts times of the desired solutions, in strictly
+     * increasing order, all greater than the initial time.
+     * @param[in] theta parameter vector for the ODE.
+     * @param[in] x continuous data vector for the ODE.
+     * @param[in] x_int integer data vector for the ODE.
+     * @param[in, out] msgs the print stream for warning messages.
+     * @param[in] relative_tolerance relative tolerance passed to CVODE.
+     * @param[in] absolute_tolerance absolute tolerance passed to CVODE.
+     * @param[in] max_num_steps maximal number of admissable steps
+     * between time-points
+     * @return a vector of states, each state being a vector of the
+     * same size as the state variable, corresponding to a time in ts.
+     */
+    template <typename F>
+    std::vector<std::vector<double> >
+    integrate_ode_adjoint(const F& f,
+                          const std::vector<double>& y0,
+                          double t0,
+                          const std::vector<double>& ts,
+                          const std::vector<double>& theta,
+                          const std::vector<double>& x,
+                          const std::vector<int>& x_int,
+                          std::ostream* msgs = 0,
+                          double relative_tolerance = 1e-10,
+                          double absolute_tolerance = 1e-10,
+                          // NOLINTNEXTLINE(runtime/int)
+                          long int max_num_steps = 1e8) {
+      return integrate_ode_bdf(f, y0, t0, ts, theta, x, x_int, msgs,
+                               relative_tolerance, absolute_tolerance,
+                               max_num_steps);
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,159 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_INTEGRATE_ODE_BDF_BATCH_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_INTEGRATE_ODE_BDF_BATCH_HPP
+
+#include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/prim/arr/err/check_matching_sizes.hpp>
+#include <stan/math/prim/arr/err/check_nonzero_size.hpp>
+#include <stan/math/prim/arr/err/check_ordered.hpp>
+#include <stan/math/prim/arr/functor/run_chunks_concurrent.hpp>
+#include <stan/math/prim/scal/err/check_finite.hpp>
+#include <stan/math/prim/scal/err/check_less.hpp>
+#include <stan/math/prim/scal/err/check_size_match.hpp>
+#include <stan/math/prim/scal/err/invalid_argument.hpp>
+#include <stan/math/prim/scal/meta/return_type.hpp>
+#include <stan/math/rev/mat/functor/cvodes_ode_data.hpp>
+#include <stan/math/rev/mat/functor/cvodes_integrator.hpp>
+#include <stan/math/rev/arr/fun/decouple_ode_states.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace math {
+
+    /**
+     * Return the solutions of the specified system of ordinary
+     * differential equations for a batch of independent subjects,
+     * given each subject's initial state, times of desired solution,
+     * parameters and data, writing error and warning messages to the
+     * specified stream.
+     *
+     * Subject <code>j</code> is solved as
+     *
+     * <code>integrate_ode_bdf(f, y0[j], t0, ts[j], theta[j], x[j],
+     * x_int[j], msgs, ...)</code>
+     *
+     * would solve it, and the result for subject <code>j</code> is
+     * element <code>j</code> of the returned array.  All subjects
+     * must have the same number of states and parameters.
+     *
+     * The subjects are split into consecutive chunks which are solved
+     * on up to <code>STAN_NUM_THREADS</code> threads when Stan is
+     * compiled with <code>STAN_THREADS</code>.  Each chunk allocates
+     * the CVODES memory once and re-initializes it for each of its
+     * subjects.  The solver only computes values and forward
+     * sensitivities; the autodiff variables of the solutions are
+     * created on the calling thread once all subjects are solved.
+     *
+     * @tparam F type of ODE system function.
+     * @tparam T_initial type of scalars for initial values.
+     * @tparam T_param type of scalars for parameters.
+     * @param[in] f functor for the base ordinary differential equation.
+     * @param[in] y0 initial state, one per subject.
+     * @param[in] t0 initial time, shared by all subjects.
+     * @param[in] ts times of the desired solutions, in strictly
+     * increasing order, all greater than the initial time, one array
+     * per subject.
+     * @param[in] theta parameter vector for the ODE, one per subject.
+     * @param[in] x continuous data vector for the ODE, one per subject.
+     * @param[in] x_int integer data vector for the ODE, one per subject.
+     * @param[in, out] msgs the print stream for warning messages.
+     * @param[in] relative_tolerance relative tolerance passed to CVODE.
+     * @param[in] absolute_tolerance absolute tolerance passed to CVODE.
+     * @param[in] max_num_steps maximal number of admissable steps
+     * between time-points
+     * @return for each subject, a vector of states, each state being
+     * a vector of the same size as the state variable, corresponding
+     * to a time in the subject's ts.
+     */
+    template <typename F, typename T_initial, typename T_param>
+    std::vector<std::vector<std::vector<
+      typename stan::return_type<T_initial, T_param>::type> > >
+    integrate_ode_bdf_batch(const F& f,
+                            const std::vector<std::vector<T_initial> >& y0,
+                            double t0,
+                            const std::vector<std::vector<double> >& ts,
+                            const std::vector<std::vector<T_param> >& theta,
+                            const std::vector<std::vector<double> >& x,
+                            const std::vector<std::vector<int> >& x_int,
+                            std::ostream* msgs = 0,
+                            double relative_tolerance = 1e-10,
+                            double absolute_tolerance = 1e-10,
+                            // NOLINTNEXTLINE(runtime/int)
+                            long int max_num_steps = 1e8) {
+      static const char* function = "integrate_ode_bdf_batch";
+      typedef typename stan::return_type<T_initial, T_param>::type T_return;
+
+      check_matching_sizes(function, "initial states", y0, "times", ts);
+      check_matching_sizes(function, "initial states", y0,
+                           "parameter vectors", theta);
+      check_matching_sizes(function, "initial states", y0,
+                           "continuous data", x);
+      check_matching_sizes(function, "initial states", y0,
+                           "integer data", x_int);
+      check_finite(function, "initial time", t0);
+      if (relative_tolerance <= 0)
+        invalid_argument(function,
+                         "relative_tolerance,", relative_tolerance,
+                         "", ", must be greater than 0");
+      if (absolute_tolerance <= 0)
+        invalid_argument(function,
+                         "absolute_tolerance,", absolute_tolerance,
+                         "", ", must be greater than 0");
+      if (max_num_steps <= 0)
+        invalid_argument(function,
+                         "max_num_steps,", max_num_steps,
+                         "", ", must be greater than 0");
+
+      const int num_subjects = y0.size();
+      std::vector<std::vector<std::vector<T_return> > >
+        y_return(num_subjects);
+      if (num_subjects == 0)
+        return y_return;
+
+      const size_t N = y0[0].size();
+      const size_t M = theta[0].size();
+      for (int j = 0; j < num_subjects; ++j) {
+        check_finite(function, "initial state", y0[j]);
+        check_finite(function, "times", ts[j]);
+        check_finite(function, "parameter vector", theta[j]);
+        check_finite(function, "continuous data", x[j]);
+        check_nonzero_size(function, "times", ts[j]);
+        check_nonzero_size(function, "initial state", y0[j]);
+        check_size_match(function, "size of initial state", y0[j].size(),
+                         "size of first initial state", N);
+        check_size_match(function, "size of parameter vector",
+                         theta[j].size(),
+                         "size of first parameter vector", M);
+        check_ordered(function, "times", ts[j]);
+        check_less(function, "initial time", t0, ts[j][0]);
+      }
+
+      std::vector<std::vector<std::vector<double> > >
+        y_coupled(num_subjects);
+
+      auto execute_chunk = [&](int start, int size, std::ostream* out) {
+        if (size == 0)
+          return;
+        cvodes_integrator<F, T_initial, T_param> integrator(N, M);
+        const int end = start + size;
+        for (int j = start; j != end; ++j) {
+          cvodes_ode_data<F, T_initial, T_param>
+            cvodes_data(f, y0[j], theta[j], x[j], x_int[j], out);
+          y_coupled[j] = integrator.integrate(cvodes_data, value_of(y0[j]),
+                                              t0, ts[j],
+                                              relative_tolerance,
+                                              absolute_tolerance,
+                                              max_num_steps);
+        }
+      };
+
+      internal::run_chunks_concurrent(num_subjects, execute_chunk, msgs);
+
+      for (int j = 0; j < num_subjects; ++j)
+        y_return[j] = decouple_ode_states(y_coupled[j], y0[j], theta[j]);
+      return y_return;
+    }
+
+  }
+}
+#endif
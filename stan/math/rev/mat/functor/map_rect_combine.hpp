@@ -0,0 +1,118 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_MAP_RECT_COMBINE_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_MAP_RECT_COMBINE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/functor/map_rect_combine.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/meta/is_var.hpp>
+#include <vector>
+
+namespace stan {
+  namespace math {
+    namespace internal {
+
+      /**
+       * Combines the outputs of the <code>map_rect</code> jobs into
+       * autodiff variables on the calling thread's stack.
+       *
+       * Every output becomes a single <code>precomputed_gradients</code>
+       * vari whose operands are the shared parameters and the
+       * parameters of its job, so the expression graph of the user
+       * functor never appears on the calling stack.
+       *
+       * @tparam T_shared_param type of shared parameters
+       * @tparam T_job_param type of job-specific parameters
+       */
+      template <typename T_shared_param, typename T_job_param>
+      class map_rect_combine_rev {
+      public:
+        typedef Eigen::Matrix<var, Eigen::Dynamic, 1> result_t;
+
+        map_rect_combine_rev(const Eigen::Matrix<T_shared_param,
+                                                 Eigen::Dynamic, 1>&
+                             shared_params,
+                             const std::vector<Eigen::Matrix<T_job_param,
+                                                             Eigen::Dynamic,
+                                                             1> >&
+                             job_params)
+          : shared_params_(shared_params), job_params_(job_params) { }
+
+        /**
+         * Link the function values and partial derivatives of the jobs
+         * to the parameters.
+         *
+         * @param job_output outputs of <code>map_rect_reduce</code>
+         * @param world_f_out number of outputs of each job
+         * @return outputs of all jobs
+         */
+        result_t operator()(const std::vector<Eigen::MatrixXd>& job_output,
+                            const std::vector<int>& world_f_out) const {
+          int num_outputs = 0;
+          for (size_t i = 0; i < world_f_out.size(); ++i)
+            num_outputs += world_f_out[i];
+          result_t out(num_outputs);
+
+          std::vector<var> operands;
+          if (is_var<T_shared_param>::value)
+            append_vars(shared_params_, operands);
+          const size_t num_shared_operands = operands.size();
+
+          int offset = 0;
+          for (size_t i = 0; i < job_output.size(); ++i) {
+            operands.resize(num_shared_operands);
+            if (is_var<T_job_param>::value)
+              append_vars(job_params_[i], operands);
+            std::vector<double> gradients(operands.size());
+            for (int k = 0; k < world_f_out[i]; ++k) {
+              for (size_t j = 0; j < gradients.size(); ++j)
+                gradients[j] = job_output[i](1 + j, k);
+              out(offset + k) = precomputed_gradients(job_output[i](0, k),
+                                                      operands, gradients);
+            }
+            offset += world_f_out[i];
+          }
+          return out;
+        }
+
+      private:
+        const Eigen::Matrix<T_shared_param, Eigen::Dynamic, 1>&
+        shared_params_;
+        const std::vector<Eigen::Matrix<T_job_param, Eigen::Dynamic, 1> >&
+        job_params_;
+
+        static void append_vars(const Eigen::Matrix<var, Eigen::Dynamic, 1>& x,
+                                std::vector<var>& operands) {
+          for (int j = 0; j < x.size(); ++j)
+            operands.push_back(x(j));
+        }
+
+        static void append_vars(const Eigen::Matrix<double, Eigen::Dynamic,
+                                                    1>&,
+                                std::vector<var>&) { }
+      };
+
+      template <>
+      class map_rect_combine<var, var>
+        : public map_rect_combine_rev<var, var> {
+      public:
+        using map_rect_combine_rev<var, var>::map_rect_combine_rev;
+      };
+
+      template <>
+      class map_rect_combine<double, var>
+        : public map_rect_combine_rev<double, var> {
+      public:
+        using map_rect_combine_rev<double, var>::map_rect_combine_rev;
+      };
+
+      template <>
+      class map_rect_combine<var, double>
+        : public map_rect_combine_rev<var, double> {
+      public:
+        using map_rect_combine_rev<var, double>::map_rect_combine_rev;
+      };
+
+    }
+  }
+}
+#endif
@@ -0,0 +1,100 @@
+#ifndef STAN_MATH_REV_MAT_FUNCTOR_MAP_RECT_REDUCE_HPP
+#define STAN_MATH_REV_MAT_FUNCTOR_MAP_RECT_REDUCE_HPP
+
+#include <stan/math/prim/mat/fun/Eigen.hpp>
+#include <stan/math/prim/mat/functor/map_rect_reduce.hpp>
+#include <stan/math/rev/core.hpp>
+#include <stan/math/rev/scal/meta/is_var.hpp>
+#include <stan/math/rev/mat/fun/to_var.hpp>
+#include <ostream>
+#include <vector>
+
+namespace stan {
+  namespace math {
+    namespace internal {
+
+      /**
+       * Evaluates a single job of <code>map_rect</code> and its
+       * partial derivatives with respect to those parameters which are
+       * autodiff variables.
+       *
+       * The job is run on a nested autodiff stack of the calling
+       * thread, which is recovered before returning, so that only
+       * <code>double</code> values leave this function.
+       *
+       * @tparam F type of user functor
+       * @tparam T_shared_param type of shared parameters
+       * @tparam T_job_param type of job-specific parameters
+       */
+      template <typename F, typename T_shared_param, typename T_job_param>
+      struct map_rect_reduce_rev {
+        Eigen::MatrixXd
+        operator()(const Eigen::VectorXd& shared_params,
+                   const Eigen::VectorXd& job_specific_params,
+                   const std::vector<double>& x_r,
+                   const std::vector<int>& x_i,
+                   std::ostream* msgs = 0) const {
+          const int num_shared_params
+            = is_var<T_shared_param>::value ? shared_params.rows() : 0;
+          const int num_job_specific_params
+            = is_var<T_job_param>::value ? job_specific_params.rows() : 0;
+          Eigen::MatrixXd out;
+
+          start_nested();
+          try {
+            const Eigen::Matrix<T_shared_param, Eigen::Dynamic, 1>
+              shared_params_v = shared_params.cast<T_shared_param>();
+            const Eigen::Matrix<T_job_param, Eigen::Dynamic, 1>
+              job_specific_params_v
+              = job_specific_params.cast<T_job_param>();
+
+            const Eigen::Matrix<var, Eigen::Dynamic, 1> fx_v
+              = F()(shared_params_v, job_specific_params_v, x_r, x_i,
+                    msgs);
+
+            out.resize(1 + num_shared_params + num_job_specific_params,
+                       fx_v.size());
+            for (int i = 0; i < fx_v.size(); ++i) {
+              out(0, i) = fx_v(i).val();
+              set_zero_all_adjoints_nested();
+              grad(fx_v(i).vi_);
+              for (int j = 0; j < num_shared_params; ++j)
+                out(1 + j, i) = adjoint_of(shared_params_v(j));
+              for (int j = 0; j < num_job_specific_params; ++j)
+                out(1 + num_shared_params + j, i)
+                  = adjoint_of(job_specific_params_v(j));
+            }
+          } catch (...) {
+            recover_memory_nested();
+            throw;
+          }
+          recover_memory_nested();
+          return out;
+        }
+
+      private:
+        static double adjoint_of(const var& x) {
+          return x.adj();
+        }
+
+        static double adjoint_of(double) {
+          return 0;
+        }
+      };
+
+      template <typename F>
+      struct map_rect_reduce<F, var, var>
+        : public map_rect_reduce_rev<F, var, var> { };
+
+      template <typename F>
+      struct map_rect_reduce<F, double, var>
+        : public map_rect_reduce_rev<F, double, var> { };
+
+      template <typename F>
+      struct map_rect_reduce<F, var, double>
+        : public map_rect_reduce_rev<F, var, double> { };
+
+    }
+  }
+}
+#endif
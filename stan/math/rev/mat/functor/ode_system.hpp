@@ -3,6 +3,8 @@
 
 #include <stan/math/rev/core.hpp>
 #include <stan/math/prim/arr/fun/value_of.hpp>
+#include <stan/math/prim/arr/functor/ode_with_jacobian.hpp>
+#include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <iostream>
 #include <sstream>
 #include <string>
@@ -156,6 +158,265 @@ namespace stan {
         }
         recover_memory_nested();
       }
+
+      /**
+       * Calculate the product of the vector lambda with the Jacobian
+       * of the ODE RHS wrt to states y, that is lambda^T Jy, in a
+       * single reverse pass. The function expects the output object
+       * to have the correct size, i.e. lambda_Jy must be length N (N
+       * states).
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[in] lambda vector of length N.
+       * @param[out] lambda_Jy product of lambda with Jacobian of ODE
+       * RHS wrt to y.
+       */
+      template <typename Derived1, typename Derived2>
+      inline void
+      vector_jacobian(double t, const std::vector<double>& y,
+                      const Eigen::MatrixBase<Derived1>& lambda,
+                      Eigen::MatrixBase<Derived2>& lambda_Jy) const {
+        using std::vector;
+        try {
+          start_nested();
+          vector<var> y_var(y.begin(), y.end());
+          vector<var> dy_dt_var = f_(t, y_var, theta_, x_, x_int_, msgs_);
+          if (unlikely(y.size() != dy_dt_var.size()))
+            throw std::runtime_error(error_msg(y.size(), dy_dt_var.size()));
+          var lambda_dy_dt = 0;
+          for (size_t i = 0; i < dy_dt_var.size(); ++i)
+            lambda_dy_dt += lambda(i) * dy_dt_var[i];
+          grad(lambda_dy_dt.vi_);
+          for (size_t i = 0; i < y.size(); ++i)
+            lambda_Jy(i) = y_var[i].adj();
+        } catch (const std::exception& e) {
+          recover_memory_nested();
+          throw;
+        }
+        recover_memory_nested();
+      }
+
+      /**
+       * Calculate the product of the vector lambda with the Jacobians
+       * of the ODE RHS wrt to states y and parameters theta, that is
+       * lambda^T Jy and lambda^T Jtheta, in a single reverse pass.
+       * The function expects the output objects to have correct
+       * sizes, i.e. lambda_Jy must be length N and lambda_Jtheta
+       * length M (N states, M parameters).
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[in] lambda vector of length N.
+       * @param[out] lambda_Jy product of lambda with Jacobian of ODE
+       * RHS wrt to y.
+       * @param[out] lambda_Jtheta product of lambda with Jacobian of
+       * ODE RHS wrt to theta.
+       */
+      template <typename Derived1, typename Derived2, typename Derived3>
+      inline void
+      vector_jacobian(double t, const std::vector<double>& y,
+                      const Eigen::MatrixBase<Derived1>& lambda,
+                      Eigen::MatrixBase<Derived2>& lambda_Jy,
+                      Eigen::MatrixBase<Derived3>& lambda_Jtheta) const {
+        using std::vector;
+        try {
+          start_nested();
+          vector<var> y_var(y.begin(), y.end());
+          vector<var> theta_var(theta_.begin(), theta_.end());
+          vector<var> dy_dt_var = f_(t, y_var, theta_var, x_, x_int_, msgs_);
+          if (unlikely(y.size() != dy_dt_var.size()))
+            throw std::runtime_error(error_msg(y.size(), dy_dt_var.size()));
+          var lambda_dy_dt = 0;
+          for (size_t i = 0; i < dy_dt_var.size(); ++i)
+            lambda_dy_dt += lambda(i) * dy_dt_var[i];
+          grad(lambda_dy_dt.vi_);
+          for (size_t i = 0; i < y.size(); ++i)
+            lambda_Jy(i) = y_var[i].adj();
+          for (size_t m = 0; m < theta_.size(); ++m)
+            lambda_Jtheta(m) = theta_var[m].adj();
+        } catch (const std::exception& e) {
+          recover_memory_nested();
+          throw;
+        }
+        recover_memory_nested();
+      }
+    };
+
+
+    /**
+     * Internal representation of an ODE model object whose
+     * Jacobians are supplied by the Jacobian functor of the system
+     * rather than by nested reverse mode autodiff.
+     *
+     * @tparam F type of functor for the base ode system.
+     * @tparam F_jac type of functor for the Jacobian.
+     */
+    template <typename F, typename F_jac>
+    class ode_system<ode_with_jacobian<F, F_jac> > {
+    private:
+      const ode_with_jacobian<F, F_jac>& f_;
+      const std::vector<double> theta_;
+      const std::vector<double>& x_;
+      const std::vector<int>& x_int_;
+      std::ostream* msgs_;
+
+      std::string error_msg(size_t y_size, size_t dy_dt_size) const {
+        std::stringstream msg;
+        msg << "ode_system: size of state vector y (" << y_size << ")"
+            << " and derivative vector dy_dt (" << dy_dt_size << ")"
+            << " in the ODE functor do not match in size.";
+        return msg.str();
+      }
+
+      /**
+       * Calculate the Jacobians of the ODE RHS wrt to states y and
+       * parameters theta with the Jacobian functor.
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[out] Jy Jacobian of ODE RHS wrt to y.
+       * @param[out] Jtheta Jacobian of ODE RHS wrt to theta.
+       */
+      inline void jacobians(double t, const std::vector<double>& y,
+                            Eigen::MatrixXd& Jy,
+                            Eigen::MatrixXd& Jtheta) const {
+        Jy.resize(y.size(), y.size());
+        Jtheta.resize(y.size(), theta_.size());
+        f_.jac_(t, y, theta_, x_, x_int_, msgs_, Jy, Jtheta);
+      }
+
+    public:
+      /**
+       * Construct an ODE model with the specified base ODE system
+       * with its Jacobian functor, parameters, data, and a message
+       * stream.
+       *
+       * @param[in] f the base ODE system with its Jacobian functor.
+       * @param[in] theta parameters of the ode.
+       * @param[in] x real data.
+       * @param[in] x_int integer data.
+       * @param[in] msgs stream to which messages are printed.
+       */
+      ode_system(const ode_with_jacobian<F, F_jac>& f,
+                 const std::vector<double> theta,
+                 const std::vector<double>& x, const std::vector<int>& x_int,
+                 std::ostream* msgs)
+        : f_(f), theta_(theta), x_(x), x_int_(x_int), msgs_(msgs) { }
+
+      /**
+       * Calculate the RHS of the ODE
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[out] dy_dt ODE RHS
+       */
+      template <typename Derived1>
+      inline void operator()(double t, const std::vector<double>& y,
+                             Eigen::MatrixBase<Derived1>& dy_dt) const {
+        const std::vector<double> dy_dt_vec = f_.f_(t, y, theta_, x_, x_int_,
+                                                    msgs_);
+        if (unlikely(y.size() != dy_dt_vec.size()))
+          throw std::runtime_error(error_msg(y.size(), dy_dt_vec.size()));
+        dy_dt = Eigen::Map<const Eigen::VectorXd>(&dy_dt_vec[0], y.size());
+      }
+
+      /**
+       * Calculate the Jacobian of the ODE RHS wrt to states y. The
+       * function expects the output objects to have correct sizes,
+       * i.e. dy_dt must be length N and Jy a NxN matrix (N states).
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[out] dy_dt ODE RHS
+       * @param[out] Jy Jacobian of ODE RHS wrt to y.
+       */
+      template <typename Derived1, typename Derived2>
+      inline void jacobian(double t, const std::vector<double>& y,
+                           Eigen::MatrixBase<Derived1>& dy_dt,
+                           Eigen::MatrixBase<Derived2>& Jy) const {
+        (*this)(t, y, dy_dt);
+        Eigen::MatrixXd Jy_dbl;
+        Eigen::MatrixXd Jtheta_dbl;
+        jacobians(t, y, Jy_dbl, Jtheta_dbl);
+        Jy = Jy_dbl;
+      }
+
+      /**
+       * Calculate the Jacobian of the ODE RHS wrt to states y and
+       * parameters theta. The function expects the output objects to
+       * have correct sizes, i.e. dy_dt must be length N, Jy a NxN
+       * matrix and Jtheta a NxM matrix (N states, M parameters).
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[out] dy_dt ODE RHS
+       * @param[out] Jy Jacobian of ODE RHS wrt to y.
+       * @param[out] Jtheta Jacobian of ODE RHS wrt to theta.
+       */
+      template <typename Derived1, typename Derived2>
+      inline void jacobian(double t, const std::vector<double>& y,
+                           Eigen::MatrixBase<Derived1>& dy_dt,
+                           Eigen::MatrixBase<Derived2>& Jy,
+                           Eigen::MatrixBase<Derived2>& Jtheta) const {
+        (*this)(t, y, dy_dt);
+        Eigen::MatrixXd Jy_dbl;
+        Eigen::MatrixXd Jtheta_dbl;
+        jacobians(t, y, Jy_dbl, Jtheta_dbl);
+        Jy = Jy_dbl;
+        Jtheta = Jtheta_dbl;
+      }
+
+      /**
+       * Calculate the product of the vector lambda with the Jacobian
+       * of the ODE RHS wrt to states y, that is lambda^T Jy. The
+       * function expects the output object to have the correct size,
+       * i.e. lambda_Jy must be length N (N states).
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[in] lambda vector of length N.
+       * @param[out] lambda_Jy product of lambda with Jacobian of ODE
+       * RHS wrt to y.
+       */
+      template <typename Derived1, typename Derived2>
+      inline void
+      vector_jacobian(double t, const std::vector<double>& y,
+                      const Eigen::MatrixBase<Derived1>& lambda,
+                      Eigen::MatrixBase<Derived2>& lambda_Jy) const {
+        Eigen::MatrixXd Jy_dbl;
+        Eigen::MatrixXd Jtheta_dbl;
+        jacobians(t, y, Jy_dbl, Jtheta_dbl);
+        lambda_Jy = Jy_dbl.transpose() * lambda;
+      }
+
+      /**
+       * Calculate the product of the vector lambda with the Jacobians
+       * of the ODE RHS wrt to states y and parameters theta, that is
+       * lambda^T Jy and lambda^T Jtheta. The function expects the
+       * output objects to have correct sizes, i.e. lambda_Jy must be
+       * length N and lambda_Jtheta length M (N states, M parameters).
+       *
+       * @param[in] t time.
+       * @param[in] y state of the ode system at time t.
+       * @param[in] lambda vector of length N.
+       * @param[out] lambda_Jy product of lambda with Jacobian of ODE
+       * RHS wrt to y.
+       * @param[out] lambda_Jtheta product of lambda with Jacobian of
+       * ODE RHS wrt to theta.
+       */
+      template <typename Derived1, typename Derived2, typename Derived3>
+      inline void
+      vector_jacobian(double t, const std::vector<double>& y,
+                      const Eigen::MatrixBase<Derived1>& lambda,
+                      Eigen::MatrixBase<Derived2>& lambda_Jy,
+                      Eigen::MatrixBase<Derived3>& lambda_Jtheta) const {
+        Eigen::MatrixXd Jy_dbl;
+        Eigen::MatrixXd Jtheta_dbl;
+        jacobians(t, y, Jy_dbl, Jtheta_dbl);
+        lambda_Jy = Jy_dbl.transpose() * lambda;
+        lambda_Jtheta = Jtheta_dbl.transpose() * lambda;
+      }
     };
 
   }
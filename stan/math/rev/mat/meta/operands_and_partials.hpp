@@ -23,7 +23,8 @@ namespace stan {
             partials_vec_(partials_), operands_(op) {}
 
       private:
-        template<typename, typename, typename, typename, typename>
+        template<typename, typename, typename, typename, typename,
+                 typename>
         friend class stan::math::operands_and_partials;
         const Op& operands_;
 
@@ -52,7 +53,8 @@ namespace stan {
             partials_vec_(partials_), operands_(ops) {}
 
       private:
-        template<typename, typename, typename, typename, typename>
+        template<typename, typename, typename, typename, typename,
+                 typename>
         friend class stan::math::operands_and_partials;
         const Op& operands_;
 
@@ -85,7 +87,8 @@ namespace stan {
         }
 
       private:
-        template<typename, typename, typename, typename, typename>
+        template<typename, typename, typename, typename, typename,
+                 typename>
         friend class stan::math::operands_and_partials;
         const Op& operands_;
 
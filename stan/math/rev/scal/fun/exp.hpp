@@ -8,13 +8,13 @@ namespace stan {
   namespace math {
 
     namespace {
-      class exp_vari : public op_v_vari {
+      class exp_vari : public vari {
       public:
         explicit exp_vari(vari* avi) :
-          op_v_vari(std::exp(avi->val_), avi) {
-        }
-        void chain() {
-          avi_->adj_ += adj_ * val_;
+          vari(std::exp(avi->val_), false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = push_linear_node(this, avi, val_);
+          record_replay_op(stack, REPLAY_EXP);
         }
       };
     }
@@ -8,13 +8,13 @@ namespace stan {
   namespace math {
 
     namespace {
-      class expm1_vari : public op_v_vari {
+      class expm1_vari : public vari {
       public:
         explicit expm1_vari(vari* avi) :
-          op_v_vari(expm1(avi->val_), avi) {
-        }
-        void chain() {
-          avi_->adj_ += adj_ * (val_ + 1);
+          vari(expm1(avi->val_), false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = push_linear_node(this, avi, val_ + 1);
+          record_replay_op(stack, REPLAY_EXPM1);
         }
       };
     }
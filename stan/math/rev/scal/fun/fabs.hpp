@@ -47,11 +47,12 @@ namespace stan {
      * @return Absolute value of variable.
      */
     inline var fabs(const var& a) {
-      if (a.val() > 0.0)
+      // compare vars, so that a compiled_tape sees the branch
+      if (a > 0.0)
         return a;
-      else if (a.val() < 0.0)
+      else if (a < 0.0)
         return var(new neg_vari(a.vi_));
-      else if (a.val() == 0)
+      else if (a == 0)
         return var(new vari(0));
       else
         return var(new precomp_v_vari(NOT_A_NUMBER, a.vi_, NOT_A_NUMBER));
@@ -8,13 +8,13 @@ namespace stan {
   namespace math {
 
     namespace {
-      class inv_logit_vari : public op_v_vari {
+      class inv_logit_vari : public vari {
       public:
         explicit inv_logit_vari(vari* avi) :
-          op_v_vari(inv_logit(avi->val_), avi) {
-        }
-        void chain() {
-          avi_->adj_ +=  adj_ * val_ * (1.0 - val_);
+          vari(inv_logit(avi->val_), false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = push_linear_node(this, avi, val_ * (1.0 - val_));
+          record_replay_op(stack, REPLAY_INV_LOGIT);
         }
       };
     }
@@ -8,13 +8,13 @@ namespace stan {
   namespace math {
 
     namespace {
-      class log_vari : public op_v_vari {
+      class log_vari : public vari {
       public:
         explicit log_vari(vari* avi) :
-          op_v_vari(std::log(avi->val_), avi) {
-        }
-        void chain() {
-          avi_->adj_ += adj_ / avi_->val_;
+          vari(std::log(avi->val_), false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = push_linear_node(this, avi, 1.0 / avi->val_);
+          record_replay_op(stack, REPLAY_LOG);
         }
       };
     }
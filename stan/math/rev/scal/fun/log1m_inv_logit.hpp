@@ -4,7 +4,6 @@
 #include <stan/math/prim/scal/fun/log1m_inv_logit.hpp>
 #include <stan/math/prim/scal/fun/inv_logit.hpp>
 #include <stan/math/rev/core.hpp>
-#include <stan/math/rev/core/precomp_v_vari.hpp>
 
 namespace stan {
   namespace math {
@@ -17,8 +16,11 @@ namespace stan {
      * @return log of one minus the inverse logit of the argument
      */
     inline var log1m_inv_logit(const var& u) {
-      return var(new precomp_v_vari(log1m_inv_logit(u.val()),
-                                    u.vi_, -inv_logit(u.val())));
+      vari* result = new vari(log1m_inv_logit(u.val()), false);
+      ChainableStack::AutodiffStackStorage& stack
+        = push_linear_node(result, u.vi_, -inv_logit(u.val()));
+      record_replay_op(stack, REPLAY_LOG1M_INV_LOGIT);
+      return var(result);
     }
 
   }
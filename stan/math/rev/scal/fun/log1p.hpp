@@ -8,13 +8,13 @@ namespace stan {
   namespace math {
 
     namespace {
-      class log1p_vari : public op_v_vari {
+      class log1p_vari : public vari {
       public:
         explicit log1p_vari(vari* avi) :
-          op_v_vari(log1p(avi->val_), avi) {
-        }
-        void chain() {
-          avi_->adj_ += adj_ / (1 + avi_->val_);
+          vari(log1p(avi->val_), false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = push_linear_node(this, avi, 1.0 / (1 + avi->val_));
+          record_replay_op(stack, REPLAY_LOG1P);
         }
       };
     }
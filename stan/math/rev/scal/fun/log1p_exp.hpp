@@ -9,14 +9,13 @@ namespace stan {
   namespace math {
 
     namespace {
-      class log1p_exp_v_vari : public op_v_vari {
+      class log1p_exp_v_vari : public vari {
       public:
         explicit log1p_exp_v_vari(vari* avi) :
-          op_v_vari(log1p_exp(avi->val_),
-                    avi) {
-        }
-        void chain() {
-          avi_->adj_ += adj_ * calculate_chain(avi_->val_, val_);
+          vari(log1p_exp(avi->val_), false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = push_linear_node(this, avi, calculate_chain(avi->val_, val_));
+          record_replay_op(stack, REPLAY_LOG1P_EXP);
         }
       };
     }
@@ -8,13 +8,13 @@ namespace stan {
   namespace math {
 
     namespace {
-      class sqrt_vari : public op_v_vari {
+      class sqrt_vari : public vari {
       public:
         explicit sqrt_vari(vari* avi) :
-          op_v_vari(std::sqrt(avi->val_), avi) {
-        }
-        void chain() {
-          avi_->adj_ += adj_ / (2.0 * val_);
+          vari(std::sqrt(avi->val_), false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = push_linear_node(this, avi, 1.0 / (2.0 * val_));
+          record_replay_op(stack, REPLAY_SQRT);
         }
       };
     }
@@ -7,13 +7,13 @@ namespace stan {
   namespace math {
 
     namespace {
-      class square_vari : public op_v_vari {
+      class square_vari : public vari {
       public:
         explicit square_vari(vari* avi) :
-          op_v_vari(avi->val_ * avi->val_, avi) {
-        }
-        void chain() {
-          avi_->adj_ += adj_ * 2.0 * avi_->val_;
+          vari(avi->val_ * avi->val_, false) {
+          ChainableStack::AutodiffStackStorage& stack
+            = push_linear_node(this, avi, 2.0 * avi->val_);
+          record_replay_op(stack, REPLAY_SQUARE);
         }
       };
     }
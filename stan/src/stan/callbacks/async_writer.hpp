@@ -0,0 +1,246 @@
+#ifndef STAN_CALLBACKS_ASYNC_WRITER_HPP
+#define STAN_CALLBACKS_ASYNC_WRITER_HPP
+
+#include <stan/callbacks/writer.hpp>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace stan {
+  namespace callbacks {
+
+    /**
+     * <code>async_writer</code> is an implementation of
+     * <code>writer</code> that forwards every call to another writer
+     * from a background thread, so that formatting and writing output
+     * overlap with the work of the calling thread.
+     *
+     * Calls are copied into a bounded ring buffer of
+     * <code>capacity</code> slots, which the calling thread fills and
+     * the background thread empties without locks.  The slots keep
+     * their storage, so that copying a draw does not allocate once the
+     * buffer has gone around, at the price of holding up to
+     * <code>capacity</code> draws in memory.  If the buffer is full,
+     * the calling thread waits for the background thread, so that a
+     * slow writer slows down the sampler rather than exhausting
+     * memory.
+     *
+     * <code>flush()</code> waits until all calls have been forwarded
+     * and then flushes the other writer; the destructor forwards the
+     * waiting calls and stops the background thread, also if sampling
+     * is interrupted by an exception.  An exception thrown by
+     * the other writer is rethrown by the next call or
+     * <code>flush()</code>, and later calls are dropped.
+     *
+     * Only one thread may call an <code>async_writer</code>, as is the
+     * case for the writers of a single chain.
+     */
+    class async_writer : public writer {
+    public:
+      /**
+       * Construct an asynchronous writer around the specified writer
+       * and start the background thread.
+       *
+       * @param[in,out] writer writer to forward calls to
+       * @param[in] capacity maximum number of calls waiting to be
+       *   forwarded, at least one
+       */
+      explicit async_writer(writer& writer, size_t capacity = 64)
+        : writer_(writer), slots_(capacity + 1), head_(0), tail_(0),
+          stop_(false), failed_(false), waiting_(0) {
+        thread_ = std::thread(&async_writer::run, this);
+      }
+
+      /**
+       * Destructor, which forwards the calls waiting in the buffer and
+       * stops the background thread.  Exceptions of the other writer
+       * are dropped.
+       */
+      ~async_writer() {
+        wait_until_empty();
+        stop_ = true;
+        notify();
+        thread_.join();
+      }
+
+      void operator()(const std::vector<std::string>& names) {
+        slot& s = reserve();
+        s.kind_ = NAMES;
+        s.names_ = names;
+        commit();
+      }
+
+      void operator()(const std::vector<double>& state) {
+        slot& s = reserve();
+        s.kind_ = STATE;
+        s.state_ = state;
+        commit();
+      }
+
+      void operator()() {
+        slot& s = reserve();
+        s.kind_ = BLANK;
+        commit();
+      }
+
+      void operator()(const std::string& message) {
+        slot& s = reserve();
+        s.kind_ = MESSAGE;
+        s.message_ = message;
+        commit();
+      }
+
+      /**
+       * Wait until all calls have been forwarded to the other writer,
+       * then flush it.
+       *
+       * @throw exception thrown by the other writer, if any
+       */
+      void flush() {
+        wait_until_empty();
+        rethrow();
+        writer_.flush();
+      }
+
+    private:
+      enum call_kind { NAMES, STATE, BLANK, MESSAGE };
+
+      struct slot {
+        call_kind kind_;
+        std::vector<std::string> names_;
+        std::vector<double> state_;
+        std::string message_;
+      };
+
+      writer& writer_;
+      std::vector<slot> slots_;
+
+      /**
+       * Index of the next slot to forward, advanced by the background
+       * thread once the call has been forwarded
+       */
+      std::atomic<size_t> head_;
+
+      /**
+       * Index of the next slot to fill, advanced by the calling thread
+       */
+      std::atomic<size_t> tail_;
+
+      std::atomic<bool> stop_;
+      std::atomic<bool> failed_;
+
+      /**
+       * Number of threads waiting for the other one
+       */
+      std::atomic<int> waiting_;
+
+      std::mutex mutex_;
+      std::condition_variable cv_;
+      std::exception_ptr exception_;
+      std::thread thread_;
+
+      size_t next(size_t i) const {
+        return i + 1 == slots_.size() ? 0 : i + 1;
+      }
+
+      /**
+       * Wake the other thread if it waits.  The count is checked after
+       * the index has been published, and a waiting thread checks the
+       * index after raising the count, so no wake-up is lost.
+       */
+      void notify() {
+        if (waiting_.load() > 0) {
+          std::lock_guard<std::mutex> lock(mutex_);
+          cv_.notify_all();
+        }
+      }
+
+      template <typename P>
+      void wait(P ready) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        ++waiting_;
+        cv_.wait(lock, ready);
+        --waiting_;
+      }
+
+      slot& reserve() {
+        rethrow();
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        if (next(tail) == head_.load(std::memory_order_acquire))
+          wait([this, tail]() { return next(tail) != head_.load(); });
+        return slots_[tail];
+      }
+
+      void commit() {
+        tail_.store(next(tail_.load(std::memory_order_relaxed)));
+        notify();
+      }
+
+      void wait_until_empty() {
+        if (head_.load(std::memory_order_acquire)
+            != tail_.load(std::memory_order_relaxed))
+          wait([this]() { return head_.load() == tail_.load(); });
+      }
+
+      void rethrow() {
+        if (!failed_.load())
+          return;
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!exception_)
+          return;
+        std::exception_ptr e = exception_;
+        exception_ = std::exception_ptr();
+        lock.unlock();
+        std::rethrow_exception(e);
+      }
+
+      void run() {
+        for (;;) {
+          size_t head = head_.load(std::memory_order_relaxed);
+          if (head == tail_.load(std::memory_order_acquire)) {
+            wait([this, head]() {
+                return head != tail_.load() || stop_.load();
+              });
+            if (head == tail_.load())
+              return;
+          }
+          slot& s = slots_[head];
+          if (!failed_.load()) {
+            try {
+              forward(s);
+            } catch (...) {
+              std::lock_guard<std::mutex> lock(mutex_);
+              exception_ = std::current_exception();
+              failed_.store(true);
+            }
+          }
+          head_.store(next(head));
+          notify();
+        }
+      }
+
+      void forward(const slot& s) {
+        switch (s.kind_) {
+        case NAMES:
+          writer_(s.names_);
+          break;
+        case STATE:
+          writer_(s.state_);
+          break;
+        case BLANK:
+          writer_();
+          break;
+        case MESSAGE:
+          writer_(s.message_);
+          break;
+        }
+      }
+    };
+
+  }
+}
+#endif
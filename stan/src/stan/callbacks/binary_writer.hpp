@@ -0,0 +1,309 @@
+#ifndef STAN_CALLBACKS_BINARY_WRITER_HPP
+#define STAN_CALLBACKS_BINARY_WRITER_HPP
+
+#include <stan/callbacks/writer.hpp>
+#include <boost/cstdint.hpp>
+#include <cstdlib>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace callbacks {
+
+    /**
+     * <code>binary_writer</code> is an implementation of
+     * <code>writer</code> that writes draws to a stream in a binary,
+     * columnar format rather than as text.
+     *
+     * The stream starts with the 8 bytes of
+     * <code>binary_writer::magic()</code> followed by the
+     * <code>uint32</code> format version and the <code>uint32</code>
+     * byte order mark <code>0x01020304</code>.  Then follows a record
+     * for each call to the writer, which starts with a one byte tag.
+     * Integers are <code>uint64</code> and values are
+     * <code>float64</code>, both in the byte order of the machine
+     * which wrote the stream, and strings are their length followed by
+     * their characters.
+     *
+     * <ul>
+     * <li><code>'C'</code>: comment, a string.  Blank lines are empty
+     * comments.</li>
+     * <li><code>'H'</code>: header, the number of columns and the
+     * name of each column, then the number of variables and for each
+     * variable its name, first column, number of dimensions and
+     * dimensions.  Columns named <code>a.i.j</code> make up variable
+     * <code>a</code>.</li>
+     * <li><code>'D'</code>: block of draws, the number of rows and
+     * columns followed by the values column by column.</li>
+     * </ul>
+     *
+     * Draws are buffered and written in blocks of about
+     * <code>block_size</code> bytes; a comment, a header, a draw of
+     * another width or <code>flush()</code> first writes the draws
+     * buffered so far, so records appear in the order of the calls.
+     * The destructor flushes, and the output stream must be opened in
+     * binary mode.
+     */
+    class binary_writer : public writer {
+    public:
+      /**
+       * Construct a binary writer and write the file header.
+       *
+       * @param[in, out] output stream to write
+       * @param[in] block_size approximate number of bytes of draws in
+       *   each block
+       */
+      explicit binary_writer(std::ostream& output,
+                             size_t block_size = 1 << 22)
+        : output_(output), block_size_(block_size), num_cols_(0),
+          num_rows_(0), max_rows_(0) {
+        output_.write(magic(), 8);
+        write_uint32(version());
+        write_uint32(0x01020304);
+      }
+
+      /**
+       * Destructor, which writes any buffered draws.
+       */
+      virtual ~binary_writer() {
+        flush();
+      }
+
+      /**
+       * Write a header with the names of the columns and the
+       * dimensions of the variables they make up.
+       *
+       * @param[in] names Names in a std::vector
+       */
+      void operator()(const std::vector<std::string>& names) {
+        flush();
+        output_.put('H');
+        write_uint64(names.size());
+        for (size_t n = 0; n < names.size(); ++n)
+          write_string(names[n]);
+
+        std::vector<std::string> var_names;
+        std::vector<size_t> first_cols;
+        std::vector<std::vector<size_t> > var_dims;
+        variable_dims(names, var_names, first_cols, var_dims);
+        write_uint64(var_names.size());
+        for (size_t v = 0; v < var_names.size(); ++v) {
+          write_string(var_names[v]);
+          write_uint64(first_cols[v]);
+          write_uint64(var_dims[v].size());
+          for (size_t d = 0; d < var_dims[v].size(); ++d)
+            write_uint64(var_dims[v][d]);
+        }
+      }
+
+      /**
+       * Buffer a draw, which is written with the block it belongs
+       * to.
+       *
+       * @param[in] state Values in a std::vector
+       */
+      void operator()(const std::vector<double>& state) {
+        if (state.empty())
+          return;
+        if (state.size() != num_cols_) {
+          flush();
+          num_cols_ = state.size();
+          max_rows_ = block_size_ / (sizeof(double) * num_cols_);
+          if (max_rows_ == 0)
+            max_rows_ = 1;
+          buffer_.resize(max_rows_ * num_cols_);
+        }
+        for (size_t c = 0; c < num_cols_; ++c)
+          buffer_[c * max_rows_ + num_rows_] = state[c];
+        if (++num_rows_ == max_rows_)
+          flush();
+      }
+
+      /**
+       * Write a blank comment.
+       */
+      void operator()() {
+        flush();
+        output_.put('C');
+        write_uint64(0);
+      }
+
+      /**
+       * Write a comment.
+       *
+       * @param[in] message A string
+       */
+      void operator()(const std::string& message) {
+        flush();
+        output_.put('C');
+        write_string(message);
+      }
+
+      /**
+       * Write the buffered draws as a block and flush the stream.
+       */
+      void flush() {
+        if (num_rows_ > 0) {
+          output_.put('D');
+          write_uint64(num_rows_);
+          write_uint64(num_cols_);
+          for (size_t c = 0; c < num_cols_; ++c)
+            output_.write(reinterpret_cast<const char*>(&buffer_[c
+                                                                * max_rows_]),
+                          num_rows_ * sizeof(double));
+          num_rows_ = 0;
+        }
+        output_.flush();
+      }
+
+      /**
+       * Return the 8 bytes which start the stream.
+       *
+       * @return magic bytes
+       */
+      static const char* magic() {
+        return "\223STANBIN";
+      }
+
+      /**
+       * Return the version of the format.
+       *
+       * @return format version
+       */
+      static boost::uint32_t version() {
+        return 1;
+      }
+
+      /**
+       * Find the variables which the specified columns make up.
+       * Consecutive columns <code>a.i.j</code> with the same name
+       * <code>a</code> and integer indexes make up a variable whose
+       * dimensions are the largest indexes, if their number is the
+       * product of the dimensions.  Any other column is a variable of
+       * its own without dimensions.
+       *
+       * @param[in] names names of columns
+       * @param[out] var_names names of variables
+       * @param[out] first_cols first column of each variable
+       * @param[out] var_dims dimensions of each variable
+       */
+      static void variable_dims(const std::vector<std::string>& names,
+                                std::vector<std::string>& var_names,
+                                std::vector<size_t>& first_cols,
+                                std::vector<std::vector<size_t> >& var_dims) {
+        size_t n = 0;
+        while (n < names.size()) {
+          std::string base;
+          std::vector<size_t> dims;
+          size_t end = n;
+          if (split_name(names[n], base, dims)) {
+            std::string next_base;
+            std::vector<size_t> next_idxs;
+            for (end = n + 1; end < names.size(); ++end) {
+              if (!split_name(names[end], next_base, next_idxs)
+                  || next_base != base || next_idxs.size() != dims.size())
+                break;
+              for (size_t d = 0; d < dims.size(); ++d)
+                if (next_idxs[d] > dims[d])
+                  dims[d] = next_idxs[d];
+            }
+            size_t size = 1;
+            for (size_t d = 0; d < dims.size(); ++d)
+              size *= dims[d];
+            if (size != end - n)
+              end = n;
+          }
+          if (end == n) {
+            base = names[n];
+            dims.clear();
+            end = n + 1;
+          }
+          var_names.push_back(base);
+          first_cols.push_back(n);
+          var_dims.push_back(dims);
+          n = end;
+        }
+      }
+
+    private:
+      /**
+       * Output stream
+       */
+      std::ostream& output_;
+
+      /**
+       * Approximate number of bytes of draws in a block
+       */
+      size_t block_size_;
+
+      /**
+       * Number of columns of the buffered draws
+       */
+      size_t num_cols_;
+
+      /**
+       * Number of buffered draws
+       */
+      size_t num_rows_;
+
+      /**
+       * Number of draws in a full block
+       */
+      size_t max_rows_;
+
+      /**
+       * Buffered draws, column by column
+       */
+      std::vector<double> buffer_;
+
+      /**
+       * Split a column name <code>a.i.j</code> into its variable name
+       * and indexes.
+       *
+       * @param[in] name column name
+       * @param[out] base variable name
+       * @param[out] idxs indexes
+       * @return true if the name has indexes, all positive integers
+       */
+      static bool split_name(const std::string& name, std::string& base,
+                             std::vector<size_t>& idxs) {
+        size_t pos = name.find('.');
+        if (pos == std::string::npos || pos == 0)
+          return false;
+        base = name.substr(0, pos);
+        idxs.clear();
+        while (pos != std::string::npos) {
+          size_t next = name.find('.', pos + 1);
+          std::string idx = name.substr(pos + 1, next == std::string::npos
+                                        ? std::string::npos
+                                        : next - pos - 1);
+          if (idx.empty()
+              || idx.find_first_not_of("0123456789") != std::string::npos)
+            return false;
+          size_t i = std::strtoul(idx.c_str(), 0, 10);
+          if (i == 0)
+            return false;
+          idxs.push_back(i);
+          pos = next;
+        }
+        return true;
+      }
+
+      void write_uint32(boost::uint32_t x) {
+        output_.write(reinterpret_cast<const char*>(&x), sizeof(x));
+      }
+
+      void write_uint64(boost::uint64_t x) {
+        output_.write(reinterpret_cast<const char*>(&x), sizeof(x));
+      }
+
+      void write_string(const std::string& s) {
+        write_uint64(s.size());
+        output_.write(s.data(), s.size());
+      }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,41 @@
+#ifndef STAN_CALLBACKS_SYNCHRONIZED_INTERRUPT_HPP
+#define STAN_CALLBACKS_SYNCHRONIZED_INTERRUPT_HPP
+
+#include <stan/callbacks/interrupt.hpp>
+#include <mutex>
+
+namespace stan {
+  namespace callbacks {
+
+    /**
+     * <code>synchronized_interrupt</code> is an implementation of
+     * <code>interrupt</code> that forwards every call to another
+     * interrupt while holding a mutex.
+     *
+     * It allows chains running in separate threads to share a single
+     * interrupt callback.
+     */
+    class synchronized_interrupt : public interrupt {
+    public:
+      /**
+       * Constructs a <code>synchronized_interrupt</code> around the
+       * specified interrupt.
+       *
+       * @param[in,out] interrupt interrupt to forward calls to
+       */
+      explicit synchronized_interrupt(interrupt& interrupt)
+        : interrupt_(interrupt) { }
+
+      void operator()() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        interrupt_();
+      }
+
+    private:
+      interrupt& interrupt_;
+      std::mutex mutex_;
+    };
+
+  }
+}
+#endif
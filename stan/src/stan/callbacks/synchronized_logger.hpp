@@ -0,0 +1,88 @@
+#ifndef STAN_CALLBACKS_SYNCHRONIZED_LOGGER_HPP
+#define STAN_CALLBACKS_SYNCHRONIZED_LOGGER_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <mutex>
+#include <string>
+#include <sstream>
+
+namespace stan {
+  namespace callbacks {
+
+    /**
+     * <code>synchronized_logger</code> is an implementation of
+     * <code>logger</code> that forwards every message to another
+     * logger while holding a mutex.
+     *
+     * It allows chains running in separate threads to share a single
+     * logger.
+     */
+    class synchronized_logger : public logger {
+    private:
+      logger& logger_;
+      std::mutex mutex_;
+
+    public:
+      /**
+       * Constructs a <code>synchronized_logger</code> around the
+       * specified logger.
+       *
+       * @param[in,out] logger logger to forward messages to
+       */
+      explicit synchronized_logger(logger& logger)
+        : logger_(logger) { }
+
+      void debug(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.debug(message);
+      }
+
+      void debug(const std::stringstream& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.debug(message);
+      }
+
+      void info(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.info(message);
+      }
+
+      void info(const std::stringstream& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.info(message);
+      }
+
+      void warn(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.warn(message);
+      }
+
+      void warn(const std::stringstream& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.warn(message);
+      }
+
+      void error(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.error(message);
+      }
+
+      void error(const std::stringstream& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.error(message);
+      }
+
+      void fatal(const std::string& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.fatal(message);
+      }
+
+      void fatal(const std::stringstream& message) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        logger_.fatal(message);
+      }
+    };
+
+  }
+}
+#endif
@@ -51,6 +51,11 @@ namespace stan {
         writer2_(message);
       }
 
+      void flush() {
+        writer1_.flush();
+        writer2_.flush();
+      }
+
     private:
       /**
        * The first writer
@@ -49,6 +49,13 @@ namespace stan {
        */
       virtual void operator()(const std::string& message) {
       }
+
+      /**
+       * Writes any output held back by the writer.  Called before
+       * the underlying stream is closed.
+       */
+      virtual void flush() {
+      }
     };
 
   }
@@ -77,6 +77,20 @@ namespace stan {
         stan::json::parse(in, handler);
       }
 
+      /**
+       * Construct a json_data object from the specified characters,
+       * such as the contents of a <code>stan::io::mapped_file</code>,
+       * which are parsed in place.
+       *
+       * @param begin first character of JSON text
+       * @param end end of JSON text
+       * @throws json_exception if data is not well-formed stan data declaration
+       */
+      json_data(const char* begin, const char* end) : vars_r_(), vars_i_() {
+        json_data_handler handler(vars_r_, vars_i_);
+        stan::json::parse(begin, end, handler);
+      }
+
       /**
        * Return <code>true</code> if this json_data contains the specified
        * variable name. This method returns <code>true</code>
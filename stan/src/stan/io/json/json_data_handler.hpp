@@ -254,30 +254,28 @@ namespace stan {
             throw json_error(errorMsg.str());
         }
 
-        // transpose order of array values to column-major
+        // transpose order of array values to column-major, moving
+        // the values into the variable's entry without copying
         if (is_int_) {
           std::pair<std::vector<int>,
-                    std::vector<size_t> > pair;
+                    std::vector<size_t> >& pair = vars_i_[key_];
           if (dims_.size() > 1) {
-            std::vector<int> cm_values_i(values_i_.size());
-            to_column_major(cm_values_i, values_i_, dims_);
-            pair = make_pair(cm_values_i, dims_);
-
+            pair.first.resize(values_i_.size());
+            to_column_major(pair.first, values_i_, dims_);
           } else {
-            pair = make_pair(values_i_, dims_);
+            pair.first.swap(values_i_);
           }
-          vars_i_[key_] = pair;
+          pair.second.swap(dims_);
         } else {
           std::pair<std::vector<double>,
-                    std::vector<size_t> > pair;
+                    std::vector<size_t> >& pair = vars_r_[key_];
           if (dims_.size() > 1) {
-            std::vector<double> cm_values_r(values_r_.size());
-            to_column_major(cm_values_r, values_r_, dims_);
-            pair = make_pair(cm_values_r, dims_);
+            pair.first.resize(values_r_.size());
+            to_column_major(pair.first, values_r_, dims_);
           } else {
-            pair = make_pair(values_r_, dims_);
+            pair.first.swap(values_r_);
           }
-          vars_r_[key_] = pair;
+          pair.second.swap(dims_);
         }
       }
 
@@ -290,13 +288,45 @@ namespace stan {
         }
       }
 
+      /**
+       * Copy the specified values in row-major order to column-major
+       * order.  The array index of the row-major values is
+       * incremented along with the column-major offset, so that the
+       * cost is constant per value.
+       *
+       * @tparam T type of values
+       * @param[out] cm_vals values in column-major order
+       * @param[in] rm_vals values in row-major order
+       * @param[in] dims dimensions of array
+       */
       template <typename T>
       void to_column_major(std::vector<T>& cm_vals,
                            const std::vector<T>& rm_vals,
                            const std::vector<size_t>& dims) {
-        for (size_t i = 0; i< rm_vals.size(); i++) {
-          size_t idx = convert_offset_rtl_2_ltr(i, dims);
-          cm_vals[idx] = rm_vals[i];
+        std::vector<size_t> idx(dims.size(), 0);
+        std::vector<size_t> stride(dims.size());
+        size_t size = 1;
+        for (size_t d = 0; d < dims.size(); d++) {
+          stride[d] = size;
+          size *= dims[d];
+        }
+        // array index should be valid, but check just in case
+        if (rm_vals.size() != size || cm_vals.size() != size) {
+          std::stringstream errorMsg;
+          errorMsg << "variable: " << key_ << ", unexpected error";
+          throw json_error(errorMsg.str());
+        }
+
+        size_t offset = 0;
+        for (size_t i = 0; i < rm_vals.size(); i++) {
+          cm_vals[offset] = rm_vals[i];
+          for (size_t d = dims.size(); d-- > 0; ) {
+            offset += stride[d];
+            if (++idx[d] < dims[d])
+              break;
+            offset -= stride[d] * dims[d];
+            idx[d] = 0;
+          }
         }
       }
 
@@ -308,38 +338,6 @@ namespace stan {
         }
         dim_last_ = dim_idx_;
       }
-
-      // convert row-major offset to column-major offset
-      size_t convert_offset_rtl_2_ltr(size_t rtl_offset,
-                                      const std::vector<size_t>& dims) {
-        size_t rtl_dsize = 1;
-        for (size_t i = 1; i < dims.size(); i++)
-          rtl_dsize *= dims[i];
-
-        // array index should be valid, but check just in case
-        if (rtl_offset >= rtl_dsize*dims[0]) {
-          std::stringstream errorMsg;
-          errorMsg << "variable: " << key_ << ", unexpected error";
-          throw json_error(errorMsg.str());
-        }
-
-        // calculate offset by working left-to-right to get array indices
-        // for row-major offset left-most dimensions are divided out
-        // for column-major offset successive dimensions are multiplied in
-        size_t rem = rtl_offset;
-        size_t ltr_offset = 0;
-        size_t ltr_dsize = 1;
-        for (size_t i = 0; i < dims.size()-1; i++) {
-          size_t idx = rem / rtl_dsize;
-          ltr_offset +=  idx * ltr_dsize;
-          rem = rem - idx * rtl_dsize;
-          rtl_dsize = rtl_dsize / dims[i+1];
-          ltr_dsize *= dims[i];
-        }
-        ltr_offset +=  rem * ltr_dsize;  // for loop stops 1 early
-
-        return ltr_offset;
-      }
     };
 
   }
@@ -3,14 +3,22 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <stan/math/prim/arr/functor/run_chunks_concurrent.hpp>
+#include <stan/io/parse_double.hpp>
 #include <stan/io/validate_zero_buf.hpp>
 #include <stan/io/json/json_error.hpp>
+#include <stan/io/json/json_handler.hpp>
 
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
 #include <iostream>
 #include <istream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 namespace stan {
 
@@ -34,11 +42,98 @@ namespace stan {
       return c == ' ' || c == '\n' || c == '\t' || c == '\r';
     }
 
+    /**
+     * A <code>number_collector</code> is a <code>json_handler</code>
+     * which records a list of numbers so that they can be sent to
+     * another handler later.  It is used to parse chunks of a large
+     * array of numbers concurrently, and throws for any other value.
+     */
+    class number_collector : public json_handler {
+    public:
+      void number_double(double x) {
+        number y;
+        y.type = DOUBLE;
+        y.x = x;
+        numbers_.push_back(y);
+      }
+
+      // NOLINTNEXTLINE(runtime/int)
+      void number_long(long n) {
+        number y;
+        y.type = LONG;
+        y.n = n;
+        numbers_.push_back(y);
+      }
+
+      // NOLINTNEXTLINE(runtime/int)
+      void number_unsigned_long(unsigned long n) {
+        number y;
+        y.type = UNSIGNED_LONG;
+        y.u = n;
+        numbers_.push_back(y);
+      }
+
+      void null() {
+        throw json_error("expecting number");
+      }
+
+      void boolean(bool p) {
+        throw json_error("expecting number");
+      }
+
+      void string(const std::string& s) {
+        throw json_error("expecting number");
+      }
+
+      void clear() {
+        numbers_.clear();
+      }
+
+      /**
+       * Send the recorded numbers to the specified handler in order.
+       *
+       * @tparam Handler type of handler
+       * @param h handler
+       */
+      template <typename Handler>
+      void send(Handler& h) const {
+        for (size_t i = 0; i < numbers_.size(); ++i) {
+          const number& y = numbers_[i];
+          if (y.type == DOUBLE)
+            h.number_double(y.x);
+          else if (y.type == LONG)
+            h.number_long(y.n);
+          else
+            h.number_unsigned_long(y.u);
+        }
+      }
+
+    private:
+      enum number_type { DOUBLE, LONG, UNSIGNED_LONG };
+
+      struct number {
+        number_type type;
+        union {
+          double x;
+          long n;  // NOLINT(runtime/int)
+          unsigned long u;  // NOLINT(runtime/int)
+        };
+      };
+
+      std::vector<number> numbers_;
+    };
+
     /**
      * A <code>json_parser</code> is a SAX-style streaming parser
      * that enforces JSON syntax and parses JSON elements
-     * from an input stream, sending callbacks to a user-supplied
+     * from a range of characters, sending callbacks to a user-supplied
      * <code>json_handler</code>.
+     *
+     * <p>An input stream is read into memory before it is parsed.
+     * Numbers are converted in place without allocating, and with
+     * more than one thread (see <code>STAN_NUM_THREADS</code>) large
+     * arrays of numbers are split into chunks which are parsed
+     * concurrently.
      */
     template <typename Handler, bool Validate_UTF_8>
     class parser {
@@ -46,10 +141,28 @@ namespace stan {
       parser(Handler& h,
              std::istream& in)
         : h_(h),
-          in_(in),
-          next_char_(0),
-          line_(0),
-          column_(0)
+          buffer_(read_stream(in)),
+          begin_(buffer_.data()),
+          end_(begin_ + buffer_.size()),
+          p_(begin_)
+      {  }
+
+      /**
+       * Construct a parser for the specified characters, which must
+       * outlive the parser.
+       *
+       * @param h handler for events from parser
+       * @param begin first character of JSON text
+       * @param end end of JSON text
+       */
+      parser(Handler& h,
+             const char* begin,
+             const char* end)
+        : h_(h),
+          buffer_(),
+          begin_(begin),
+          end_(end),
+          p_(begin)
       {  }
 
       ~parser() {
@@ -62,10 +175,48 @@ namespace stan {
       }
 
     private:
+      template <typename H, bool V> friend class parser;
+
+      /**
+       * Return the rest of the specified stream.  The text is read
+       * straight into the string, which is sized up front if the
+       * stream is seekable.
+       *
+       * @param in input stream
+       * @return rest of the stream
+       */
+      static std::string read_stream(std::istream& in) {
+        typedef std::char_traits<char> traits;
+        std::streambuf* buf = in.rdbuf();
+        std::string text;
+        std::streampos begin = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+        if (begin != std::streampos(-1)) {
+          std::streampos end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+          buf->pubseekpos(begin, std::ios::in);
+          if (end != std::streampos(-1))
+            text.resize(static_cast<size_t>(end - begin));
+        }
+        size_t size = 0;
+        while (true) {
+          size += buf->sgetn(&text[0] + size, text.size() - size);
+          if (size < text.size()
+              || traits::eq_int_type(buf->sgetc(), traits::eof()))
+            break;
+          text.resize(std::max<size_t>(2 * text.size(), 4096));
+        }
+        text.resize(size);
+        return text;
+      }
+
       json_error json_exception(const std::string& msg) const {
+        size_t line = std::count(begin_, p_, '\n');
+        const char* line_begin = p_;
+        while (line_begin > begin_ && line_begin[-1] != '\n')
+          --line_begin;
+        size_t column = p_ - line_begin + (line > 0 ? 1 : 0);
         std::stringstream ss;
         ss << "Error in JSON parsing at"
-           << " line=" << line_ << " column=" << column_
+           << " line=" << line << " column=" << column
            << std::endl
            << msg
            << std::endl;
@@ -122,12 +273,11 @@ namespace stan {
       void parse_number() {
         bool is_positive = true;
 
-        std::stringstream ss;
         char c = get_non_ws_char();
+        const char* number_begin = p_ - 1;
         // minus
         if (c == '-') {
           is_positive = false;
-          ss << c;
           c = get_char();
         }
 
@@ -135,15 +285,22 @@ namespace stan {
         //   zero / digit1-9
         if (c < '0' || c > '9')
           throw json_exception("expecting int part of number");
-        ss << c;
 
         //   *DIGIT
+        // NOLINTNEXTLINE(runtime/int)
+        const unsigned long max_n = std::numeric_limits<unsigned long>::max();
+        unsigned long n = c - '0';  // NOLINT(runtime/int)
+        bool n_overflow = false;
         bool leading_zero = (c == '0');
         c = get_char();
         if (leading_zero && (c == '0'))
           throw json_exception("zero padded numbers not allowed");
         while (c >= '0' && c <= '9') {
-          ss << c;
+          unsigned int digit = c - '0';
+          if (n > (max_n - digit) / 10)
+            n_overflow = true;
+          else
+            n = 10 * n + digit;
           c = get_char();
         }
 
@@ -151,95 +308,111 @@ namespace stan {
         bool is_integer = true;
         if (c == '.') {
           is_integer = false;
-          ss << '.';
           c = get_char();
           if (c < '0' || c > '9')
             throw json_exception("expected digit after decimal");
-          ss << c;
           c = get_char();
-          while (c >= '0' && c <= '9') {
-            ss << c;
+          while (c >= '0' && c <= '9')
             c = get_char();
-          }
         }
 
         // exp
         if (c == 'e' || c == 'E') {
           is_integer = false;
-          ss << c;
           c = get_char();
           // minus / plus
-          if (c == '+' || c == '-') {
-            ss << c;
+          if (c == '+' || c == '-')
             c = get_char();
-          }
           // 1*DIGIT
           if (c < '0' || c > '9')
             throw json_exception("expected digit after e/E");
-          while (c >= '0' && c <= '9') {
-            ss << c;
+          while (c >= '0' && c <= '9')
             c = get_char();
-          }
         }
         unget_char();
 
         if (is_integer) {
           if (is_positive) {
-            unsigned long n;  // NOLINT(runtime/int)
-            try {
-              // NOLINTNEXTLINE(runtime/int)
-              n = boost::lexical_cast<unsigned long>(ss.str());
-            } catch (const boost::bad_lexical_cast & ) {
+            if (n_overflow)
               throw json_exception("number exceeds integer range");
-            }
-            ss >> n;
             h_.number_unsigned_long(n);
           } else {
-            long n;  // NOLINT(runtime/int)
-            try {
-              // NOLINTNEXTLINE(runtime/int)
-              n = boost::lexical_cast<unsigned long>(ss.str());
-            } catch (const boost::bad_lexical_cast & ) {
+            // NOLINTNEXTLINE(runtime/int)
+            const unsigned long max_magnitude
+              = std::numeric_limits<long>::max() + 1UL;  // NOLINT
+            if (n_overflow || n > max_magnitude)
               throw json_exception("number exceeds integer range");
-            }
-            ss >> n;
-            h_.number_long(n);
+            // NOLINTNEXTLINE(runtime/int)
+            h_.number_long(n == max_magnitude
+                           ? std::numeric_limits<long>::min()  // NOLINT
+                           : -static_cast<long>(n));  // NOLINT
           }
         } else {
-          double x;
-          try {
-            std::string ss_str = ss.str();
-            x = boost::lexical_cast<double>(ss_str);
-            if (x == 0)
-              io::validate_zero_buf(ss_str);
-          } catch (const boost::bad_lexical_cast & ) {
-            throw json_exception("number exceeds double range");
-          }
-          ss >> x;
-          h_.number_double(x);
+          h_.number_double(convert_double(number_begin, p_));
         }
       }
 
+      /**
+       * Return the value of the JSON number held in the specified
+       * characters.  Numbers which cannot be converted exactly by
+       * <code>stan::io::parse_double</code> are converted with
+       * <code>strtod</code>.
+       *
+       * @param begin first character of number
+       * @param end end of number
+       * @return value
+       * @throw json_error if the number exceeds the range of double
+       */
+      double convert_double(const char* begin, const char* end) const {
+        double x;
+        const char* p = begin;
+        if (io::parse_double(p, end, x) && p == end)
+          return x;
+
+        const size_t size = end - begin;
+        char buf[64];
+        std::string long_buf;
+        const char* s = buf;
+        if (size < sizeof(buf)) {
+          std::memcpy(buf, begin, size);
+          buf[size] = 0;
+        } else {
+          long_buf.assign(begin, end);
+          s = long_buf.c_str();
+        }
+        x = std::strtod(s, 0);
+        try {
+          if (x == std::numeric_limits<double>::infinity()
+              || x == -std::numeric_limits<double>::infinity())
+            throw boost::bad_lexical_cast();
+          if (x == 0)
+            io::validate_zero_buf(std::string(begin, end));
+        } catch (const boost::bad_lexical_cast & ) {
+          throw json_exception("number exceeds double range");
+        }
+        return x;
+      }
+
       std::string parse_string_chars_quotation_mark() {
-        std::stringstream s;
+        std::string s;
         while (true) {
           char c = get_char();
           if (c == '"') {
-            return s.str();
+            return s;
           } else if (c == '\\') {
             c = get_char();
             if (c == '\\'  || c == '/' || c == '"') {
-              s << c;
+              s += c;
             } else if (c == 'b') {
-              s << '\b';
+              s += '\b';
             } else if (c == 'f') {
-              s << '\f';
+              s += '\f';
             } else if (c == 'n') {
-              s << '\n';
+              s += '\n';
             } else if (c == 'r') {
-              s << '\r';
+              s += '\r';
             } else if (c == 't') {
-              s << '\t';
+              s += '\t';
             } else if (c == 'u') {
               get_escaped_unicode(s);
             } else {
@@ -250,7 +423,7 @@ namespace stan {
             throw json_exception("found control character, char values less "
                                  "than U+0020 must be \\u escaped");
           }
-          s << c;
+          s += c;
         }
       }
 
@@ -269,7 +442,7 @@ namespace stan {
         h_.null();
       }
 
-      void get_escaped_unicode(std::stringstream& s) {
+      void get_escaped_unicode(std::string& s) {
         unsigned int codepoint = get_int_as_hex_chars();
         if (!(is_high_surrogate(codepoint) || is_low_surrogate(codepoint))) {
           putCodepoint(s, codepoint);
@@ -295,36 +468,36 @@ namespace stan {
       }
 
       unsigned int get_int_as_hex_chars() {
-        std::stringstream s;
-        s << std::hex;
+        unsigned int hex = 0;
         for (int i = 0; i < 4; i++) {
           char c = get_char();
-          if (!((c >= 'a' && c<= 'f')
-                || (c >= 'A' && c<= 'F')
-                || (c >= '0' && c<= '9')))
+          if (c >= 'a' && c<= 'f')
+            hex = 16 * hex + (c - 'a' + 10);
+          else if (c >= 'A' && c<= 'F')
+            hex = 16 * hex + (c - 'A' + 10);
+          else if (c >= '0' && c<= '9')
+            hex = 16 * hex + (c - '0');
+          else
             throw json_exception("illegal unicode code point");
-          s << c;
         }
-        unsigned int hex;
-        s >> hex;
         return hex;
       }
 
-      void putCodepoint(std::stringstream& s, unsigned int codepoint) {
+      void putCodepoint(std::string& s, unsigned int codepoint) {
         if (codepoint <= 0x7f) {
-          s.put(codepoint);
+          s += static_cast<char>(codepoint);
         } else if (codepoint <= 0x7ff) {
-          s.put(0xc0 | ((codepoint >> 6) & 0x1f));
-          s.put(0x80 | (codepoint & 0x3f));
+          s += static_cast<char>(0xc0 | ((codepoint >> 6) & 0x1f));
+          s += static_cast<char>(0x80 | (codepoint & 0x3f));
         } else if (codepoint <= 0xffff) {
-          s.put(0xe0 | ((codepoint >> 12) & 0x0f));
-          s.put(0x80 | ((codepoint >> 6) & 0x3f));
-          s.put(0x80 | (codepoint & 0x3f));
+          s += static_cast<char>(0xe0 | ((codepoint >> 12) & 0x0f));
+          s += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+          s += static_cast<char>(0x80 | (codepoint & 0x3f));
         } else {
-          s.put(0xf0 | ((codepoint >> 18) & 0x07));
-          s.put(0x80 | ((codepoint >> 12) & 0x3f));
-          s.put(0x80 | ((codepoint >> 6) & 0x3f));
-          s.put(0x80 | (codepoint & 0x3f));
+          s += static_cast<char>(0xf0 | ((codepoint >> 18) & 0x07));
+          s += static_cast<char>(0x80 | ((codepoint >> 12) & 0x3f));
+          s += static_cast<char>(0x80 | ((codepoint >> 6) & 0x3f));
+          s += static_cast<char>(0x80 | (codepoint & 0x3f));
         }
       }
 
@@ -341,6 +514,12 @@ namespace stan {
         char c = get_non_ws_char();
         if (c == ']') return;
         unget_char();
+        if (parse_numbers_concurrent()) {
+          c = get_non_ws_char();
+          if (c == ']')
+            throw json_exception("in array, expecting value");
+          unget_char();
+        }
         while (true) {
           parse_value();
           char c = get_non_ws_char();
@@ -355,6 +534,99 @@ namespace stan {
         }
       }
 
+      /**
+       * Parse the leading values of the array at the current position
+       * concurrently, if it is a large array of numbers and more than
+       * one thread is available.
+       *
+       * <p>The array is split after commas into chunks of about
+       * <code>chunk_size</code> characters.  Up to one chunk per
+       * thread is parsed at a time, and the numbers of each chunk are
+       * then sent to the handler in order.  The last value and the
+       * end of the array are left to the sequential parser.  If a
+       * chunk is not a list of numbers, its values are left to the
+       * sequential parser as well, which then reports the error.
+       *
+       * @return true if any values were parsed
+       */
+      bool parse_numbers_concurrent() {
+        const size_t chunk_size = 1 << 22;
+        if (static_cast<size_t>(end_ - p_) < 2 * chunk_size)
+          return false;
+        const int num_threads = stan::math::internal::get_num_threads(
+          std::numeric_limits<int>::max());
+        if (num_threads <= 1)
+          return false;
+
+        // only arrays of numbers, without nested values, are split
+        const char* close = p_;
+        while (close < end_ && *close != ']' && *close != '['
+               && *close != '{' && *close != '"')
+          ++close;
+        if (close == end_ || *close != ']'
+            || static_cast<size_t>(close - p_) < 2 * chunk_size)
+          return false;
+
+        std::vector<number_collector> collectors(num_threads);
+        std::vector<char> failed(num_threads);
+        std::vector<const char*> chunk_begin;
+        bool parsed = false;
+        while (true) {
+          chunk_begin.assign(1, p_);
+          for (int k = 0; k < num_threads; ++k) {
+            const char* cut = chunk_begin.back() + chunk_size;
+            if (cut >= close)
+              break;
+            const char* comma = static_cast<const char*>(
+              std::memchr(cut, ',', close - cut));
+            if (!comma)
+              break;
+            chunk_begin.push_back(comma + 1);
+          }
+          const int num_chunks = chunk_begin.size() - 1;
+          if (num_chunks == 0)
+            return parsed;
+
+          auto execute_chunk = [&](int start, int size, std::ostream* out) {
+            for (int k = start; k < start + size; ++k) {
+              collectors[k].clear();
+              parser<number_collector, Validate_UTF_8>
+                chunk_parser(collectors[k], chunk_begin[k],
+                             chunk_begin[k + 1]);
+              try {
+                chunk_parser.parse_number_list();
+                failed[k] = 0;
+              } catch (const std::exception& e) {
+                failed[k] = 1;
+              }
+            }
+          };
+          stan::math::internal::run_chunks_concurrent(num_chunks,
+                                                      execute_chunk, 0);
+
+          for (int k = 0; k < num_chunks; ++k) {
+            if (failed[k])
+              return parsed;
+            collectors[k].send(h_);
+            p_ = chunk_begin[k + 1];
+            parsed = true;
+          }
+        }
+      }
+
+      // *( number value-separator ), up to the end of input
+      void parse_number_list() {
+        while (p_ != end_) {
+          char c = get_non_ws_char();
+          if (c != '-' && (c < '0' || c > '9'))
+            throw json_exception("expecting number");
+          unget_char();
+          parse_number();
+          if (get_non_ws_char() != ',')
+            throw json_exception("in array, expecting ] or ,");
+        }
+      }
+
       void parse_object_members_end_object() {
         char c = get_non_ws_char();
         if (c == '}') return;
@@ -383,16 +655,9 @@ namespace stan {
       }
 
       char get_char() {
-        char c = in_.get();
-        if (!in_.good())
+        if (p_ == end_)
           throw json_exception("unexpected end of stream");
-        if (c == '\n') {
-          ++line_;
-          column_ = 1;
-        } else {
-          ++column_;
-        }
-        return c;
+        return *p_++;
       }
 
       char get_non_ws_char() {
@@ -404,15 +669,14 @@ namespace stan {
       }
 
       void unget_char() {
-        in_.unget();
-        --column_;
+        --p_;
       }
 
       Handler& h_;
-      std::istream& in_;
-      char next_char_;
-      size_t line_;
-      size_t column_;
+      std::string buffer_;
+      const char* begin_;
+      const char* end_;
+      const char* p_;
     };
 
 
@@ -447,6 +711,39 @@ namespace stan {
       parse<false>(in, handler);
     }
 
+    /**
+     * Parse the JSON text held in the specified characters, such as
+     * the contents of a <code>stan::io::mapped_file</code>, sending
+     * events to the specified handler, and optionally validating the
+     * UTF-8 encoding.
+     *
+     * @tparam Validate_UTF_8
+     * @tparam Handler
+     * @param begin first character of JSON text
+     * @param end end of JSON text
+     * @param handler Handler for events from parser
+     */
+    template <bool Validate_UTF_8, typename Handler>
+    void parse(const char* begin, const char* end,
+               Handler& handler) {
+      parser<Handler, Validate_UTF_8>(handler, begin, end).parse();
+    }
+
+    /**
+     * Parse the JSON text held in the specified characters, sending
+     * events to the specified handler.
+     *
+     * @tparam Handler
+     * @param begin first character of JSON text
+     * @param end end of JSON text
+     * @param handler Handler for events from parser
+     */
+    template <typename Handler>
+    void parse(const char* begin, const char* end,
+               Handler& handler) {
+      parse<false>(begin, end, handler);
+    }
+
   }
 }
 #endif
@@ -0,0 +1,117 @@
+#ifndef STAN_IO_MAPPED_FILE_HPP
+#define STAN_IO_MAPPED_FILE_HPP
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace stan {
+  namespace io {
+
+    /**
+     * <code>mapped_file</code> gives read-only access to the contents
+     * of a file as a range of characters.
+     *
+     * On POSIX systems the file is memory mapped, so that pages are
+     * read on demand and never copied; elsewhere it is read into
+     * memory.  The contents are not null terminated.
+     */
+    class mapped_file {
+    public:
+      /**
+       * Map the file with the specified name.
+       *
+       * @param[in] filename name of file
+       * @throw std::invalid_argument if the file cannot be read
+       */
+      explicit mapped_file(const std::string& filename)
+        : data_(0), size_(0), mapped_(false) {
+#ifndef _WIN32
+        int fd = open(filename.c_str(), O_RDONLY);
+        if (fd >= 0) {
+          struct stat st;
+          if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            size_ = st.st_size;
+            if (size_ == 0) {
+              close(fd);
+              return;
+            }
+            void* p = mmap(0, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+              data_ = static_cast<const char*>(p);
+              mapped_ = true;
+              madvise(p, size_, MADV_SEQUENTIAL);
+            }
+          }
+          close(fd);
+          if (mapped_)
+            return;
+        }
+#endif
+        std::ifstream in(filename.c_str(), std::ios::in | std::ios::binary);
+        if (!in.good()) {
+          std::stringstream msg;
+          msg << "Can't open file \"" << filename << "\"";
+          throw std::invalid_argument(msg.str());
+        }
+        std::stringstream ss;
+        ss << in.rdbuf();
+        contents_ = ss.str();
+        data_ = contents_.data();
+        size_ = contents_.size();
+      }
+
+      ~mapped_file() {
+#ifndef _WIN32
+        if (mapped_)
+          munmap(const_cast<char*>(data_), size_);
+#endif
+      }
+
+      /**
+       * Return a pointer to the first character of the file.
+       *
+       * @return first character
+       */
+      const char* begin() const {
+        return data_;
+      }
+
+      /**
+       * Return a pointer past the last character of the file.
+       *
+       * @return end of contents
+       */
+      const char* end() const {
+        return data_ + size_;
+      }
+
+      /**
+       * Return the size of the file.
+       *
+       * @return number of characters
+       */
+      size_t size() const {
+        return size_;
+      }
+
+    private:
+      const char* data_;
+      size_t size_;
+      bool mapped_;
+      std::string contents_;
+
+      mapped_file(const mapped_file&);
+      mapped_file& operator=(const mapped_file&);
+    };
+
+  }
+}
+#endif
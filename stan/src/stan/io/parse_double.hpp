@@ -0,0 +1,82 @@
+#ifndef STAN_IO_PARSE_DOUBLE_HPP
+#define STAN_IO_PARSE_DOUBLE_HPP
+
+#include <boost/cstdint.hpp>
+
+namespace stan {
+  namespace io {
+
+    /**
+     * Parse the decimal number which starts at the specified
+     * position, if it can be converted exactly by the fast path.
+     *
+     * Numbers with at most 19 significant digits and a decimal
+     * exponent of at most 22 are converted exactly with a single
+     * multiplication or division, which covers the output of Stan.
+     *
+     * @param[in,out] p first character of number, set past the
+     *   number on success
+     * @param[in] end end of characters
+     * @param[out] x value
+     * @return true if a number was converted
+     */
+    inline bool parse_double(const char*& p, const char* end, double& x) {
+      static const double powers_of_10[] = {
+        1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+        1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+      };
+      const char* q = p;
+      bool negative = false;
+      if (q < end && (*q == '-' || *q == '+'))
+        negative = *q++ == '-';
+      boost::uint64_t mantissa = 0;
+      int num_digits = 0;
+      int significant = 0;
+      int exponent = 0;
+      for (; q < end && *q >= '0' && *q <= '9'; ++q, ++num_digits) {
+        if (significant > 0 || *q != '0') {
+          mantissa = 10 * mantissa + (*q - '0');
+          ++significant;
+        }
+      }
+      if (q < end && *q == '.') {
+        for (++q; q < end && *q >= '0' && *q <= '9'; ++q, ++num_digits) {
+          if (significant > 0 || *q != '0') {
+            mantissa = 10 * mantissa + (*q - '0');
+            ++significant;
+          }
+          --exponent;
+        }
+      }
+      if (num_digits == 0)
+        return false;
+      if (q < end && (*q == 'e' || *q == 'E')) {
+        ++q;
+        bool negative_exponent = false;
+        if (q < end && (*q == '-' || *q == '+'))
+          negative_exponent = *q++ == '-';
+        const char* exponent_begin = q;
+        int e = 0;
+        for (; q < end && *q >= '0' && *q <= '9' && e < 1000; ++q)
+          e = 10 * e + (*q - '0');
+        if (q == exponent_begin)
+          return false;
+        exponent += negative_exponent ? -e : e;
+      }
+      if (significant > 19 || mantissa > (boost::uint64_t(1) << 53)
+          || exponent < -22 || exponent > 22)
+        return false;
+      x = static_cast<double>(mantissa);
+      if (exponent < 0)
+        x /= powers_of_10[-exponent];
+      else
+        x *= powers_of_10[exponent];
+      if (negative)
+        x = -x;
+      p = q;
+      return true;
+    }
+
+  }
+}
+#endif
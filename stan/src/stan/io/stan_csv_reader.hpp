@@ -1,13 +1,26 @@
 #ifndef STAN_IO_STAN_CSV_READER_HPP
 #define STAN_IO_STAN_CSV_READER_HPP
 
+#include <stan/callbacks/binary_writer.hpp>
+#include <stan/io/mapped_file.hpp>
+#include <stan/io/parse_double.hpp>
 #include <boost/algorithm/string.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/lexical_cast.hpp>
 #include <Eigen/Dense>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
 #include <istream>
 #include <iostream>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <thread>
+#include <typeinfo>
+#include <vector>
 
 namespace stan {
   namespace io {
@@ -67,7 +80,8 @@ namespace stan {
     };
 
     /**
-     * Reads from a Stan output csv file.
+     * Reads from a Stan output csv file, or from the binary output of
+     * <code>stan::callbacks::binary_writer</code>.
      */
     class stan_csv_reader {
     public:
@@ -180,18 +194,29 @@ namespace stan {
           std::string token;
           std::getline(ss, token, ',');
           boost::trim(token);
-
-          int pos = token.find('.');
-          if (pos > 0) {
-            token.replace(pos, 1, "[");
-            std::replace(token.begin(), token.end(), '.', ',');
-            token += "]";
-          }
-          header(idx++) = token;
+          header(idx++) = header_name(token);
         }
         return true;
       }
 
+      /**
+       * Return the name of a column as in the header of a
+       * <code>stan_csv</code>, with <code>a.1.2</code> written as
+       * <code>a[1,2]</code>.
+       *
+       * @param[in] token column name in the output file
+       * @return column name
+       */
+      static std::string header_name(std::string token) {
+        int pos = token.find('.');
+        if (pos > 0) {
+          token.replace(pos, 1, "[");
+          std::replace(token.begin(), token.end(), '.', ',');
+          token += "]";
+        }
+        return token;
+      }
+
       static bool read_adaptation(std::istream& in,
                                   stan_csv_adaptation& adaptation,
                                   std::ostream* out) {
@@ -251,82 +276,351 @@ namespace stan {
           return true;
       }
 
+      /**
+       * Reads the samples and the elapsed times which follow them
+       * from the rest of the stream.
+       *
+       * @param[in] in input stream, positioned after the adaptation
+       * @param[out] samples samples, unchanged if there are none
+       * @param[in,out] timing elapsed times
+       * @param[out] out output stream to send messages
+       * @return false if there are no samples or the rows have
+       *   different numbers of columns
+       * @throw boost::bad_lexical_cast if a value is not a number
+       */
       static bool read_samples(std::istream& in, Eigen::MatrixXd& samples,
                                stan_csv_timing& timing, std::ostream* out) {
+        if (in.peek() == '#' || in.good() == false)
+          return false;
+
         std::stringstream ss;
-        std::string line;
+        ss << in.rdbuf();
+        std::string contents = ss.str();
+        return read_samples(contents.data(),
+                            contents.data() + contents.size(),
+                            samples, timing, out);
+      }
 
-        int rows = 0;
-        int cols = -1;
+      /**
+       * Reads the samples and the elapsed times which follow them
+       * from the specified characters.
+       *
+       * The lines are found in a single pass, then the rows are
+       * parsed in place on several threads if there are many values,
+       * each thread filling its own rows of the samples.
+       *
+       * @param[in] begin first character after the adaptation
+       * @param[in] end end of the characters
+       * @param[out] samples samples, unchanged if there are none
+       * @param[in,out] timing elapsed times
+       * @param[out] out output stream to send messages
+       * @param[in] num_threads maximum number of threads; zero means
+       *   <code>std::thread::hardware_concurrency()</code>
+       * @return false if the rows have different numbers of columns
+       * @throw boost::bad_lexical_cast if a value is not a number
+       */
+      static bool read_samples(const char* begin, const char* end,
+                               Eigen::MatrixXd& samples,
+                               stan_csv_timing& timing, std::ostream* out,
+                               size_t num_threads = 0) {
+        std::vector<const char*> rows;
+        std::vector<const char*> row_ends;
+        const char* p = begin;
+        while (p < end) {
+          const char* eol
+            = static_cast<const char*>(std::memchr(p, '\n', end - p));
+          if (eol == 0)
+            eol = end;
+          // a blank line of a file with CRLF line endings holds "\r"
+          const char* line_end = eol;
+          if (line_end > p && line_end[-1] == '\r')
+            --line_end;
+          if (*p == '#')
+            read_timing(std::string(p, line_end), timing);
+          else if (line_end > p) {
+            rows.push_back(p);
+            row_ends.push_back(line_end);
+          }
+          p = eol + 1;
+        }
+        if (rows.empty())
+          return true;
 
-        if (in.peek() == '#' || in.good() == false)
+        int cols = std::count(rows[0], row_ends[0], ',') + 1;
+        int num_rows = rows.size();
+
+        Eigen::MatrixXd parsed(num_rows, cols);
+        if (num_threads == 0)
+          num_threads = std::max(1U, std::thread::hardware_concurrency());
+        if (static_cast<double>(num_rows) * cols <= (1 << 16))
+          num_threads = 1;
+        num_threads = std::min<size_t>(num_threads, num_rows);
+        std::vector<int> bad_rows(num_threads, -1);
+        std::vector<char> bad_values(num_threads, 0);
+
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < num_threads; ++t) {
+          int row_begin = num_rows * t / num_threads;
+          int row_end = num_rows * (t + 1) / num_threads;
+          std::function<void()> parse_rows
+            = [&, t, row_begin, row_end]() {
+            // rows are parsed into a row major buffer and copied in
+            // blocks, so that the column major samples are written
+            // contiguously
+            const int block_rows = 64;
+            Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic,
+                          Eigen::RowMajor> buffer(block_rows, cols);
+            for (int row = row_begin; row < row_end; row += block_rows) {
+              int n = std::min(block_rows, row_end - row);
+              for (int i = 0; i < n; ++i) {
+                int status = read_row(rows[row + i], row_ends[row + i],
+                                      &buffer(i, 0), cols);
+                if (status != 0) {
+                  bad_rows[t] = row + i;
+                  bad_values[t] = status == 2;
+                  return;
+                }
+              }
+              parsed.block(row, 0, n, cols) = buffer.topRows(n);
+            }
+          };
+          if (t + 1 < num_threads)
+            threads.push_back(std::thread(parse_rows));
+          else
+            parse_rows();
+        }
+        for (size_t t = 0; t < threads.size(); ++t)
+          threads[t].join();
+
+        for (size_t t = 0; t < num_threads; ++t) {
+          if (bad_rows[t] < 0)
+            continue;
+          if (bad_values[t])
+            throw boost::bad_lexical_cast(typeid(std::string),
+                                          typeid(double));
+          int row = bad_rows[t];
+          if (out)
+            *out << "Error: expected " << cols << " columns, but found "
+                 << std::count(rows[row], row_ends[row], ',') + 1
+                 << " instead for row " << row + 1 << std::endl;
           return false;
+        }
+        samples.swap(parsed);
+        return true;
+      }
 
-        while (in.good()) {
-          bool comment_line = (in.peek() == '#');
-          bool empty_line   = (in.peek() == '\n');
+      /**
+       * Add the time in the specified comment line to the warmup or
+       * sampling time, if it is a line of elapsed time.
+       *
+       * @param[in] line comment line
+       * @param[in,out] timing times
+       */
+      static void read_timing(const std::string& line,
+                              stan_csv_timing& timing) {
+        if (line.find("(Warm-up)") != std::string::npos) {
+          int left = 17;
+          int right = line.find(" seconds");
+          timing.warmup
+            += boost::lexical_cast<double>(line.substr(left, right - left));
+        } else if (line.find("(Sampling)") != std::string::npos) {
+          int left = 17;
+          int right = line.find(" seconds");
+          timing.sampling
+            += boost::lexical_cast<double>(line.substr(left, right - left));
+        }
+      }
 
-          std::getline(in, line);
+      /**
+       * Parses the binary output of
+       * <code>stan::callbacks::binary_writer</code>.
+       *
+       * Comments before the header are read as metadata, comments
+       * between the header and the first draws as adaptation, and
+       * comments of elapsed time as timing, as if the output had been
+       * written as csv with comment prefix <code>"# "</code>.
+       *
+       * @param[in] in input stream to parse, opened in binary mode
+       * @param[out] out output stream to send messages
+       * @throw std::invalid_argument if the stream is not binary
+       *   output of a compatible version, is truncated or has no header
+       */
+      static stan_csv parse_binary(std::istream& in, std::ostream* out) {
+        stan_csv data;
+        data.timing.warmup = 0;
+        data.timing.sampling = 0;
 
-          if (empty_line)
-            continue;
-          if (!line.length())
-            break;
-
-          if (comment_line) {
-            if (line.find("(Warm-up)") != std::string::npos) {
-              int left = 17;
-              int right = line.find(" seconds");
-              timing.warmup
-                += boost::lexical_cast<double>(line.substr(left, right - left));
-            } else if (line.find("(Sampling)") != std::string::npos) {
-              int left = 17;
-              int right = line.find(" seconds");
-              timing.sampling
-                += boost::lexical_cast<double>(line.substr(left, right - left));
+        char magic[8];
+        in.read(magic, 8);
+        if (!in || std::memcmp(magic, callbacks::binary_writer::magic(), 8))
+          throw std::invalid_argument
+            ("Input file is not binary Stan output in parse_binary");
+        if (read_binary<boost::uint32_t>(in)
+            != callbacks::binary_writer::version())
+          throw std::invalid_argument
+            ("Unsupported version of binary Stan output in parse_binary");
+        if (read_binary<boost::uint32_t>(in) != 0x01020304)
+          throw std::invalid_argument
+            ("Binary Stan output has the wrong byte order in parse_binary");
+
+        std::stringstream metadata_ss;
+        std::stringstream adaptation_ss;
+        bool header_read = false;
+        bool samples_read = false;
+        bool samples_ok = true;
+        std::vector<std::vector<double> > blocks;
+        size_t rows = 0;
+
+        for (int tag = in.get(); tag != std::char_traits<char>::eof();
+             tag = in.get()) {
+          if (tag == 'C') {
+            std::string line = "# " + read_binary_string(in);
+            if (!header_read)
+              metadata_ss << line << '\n';
+            else if (!samples_read)
+              adaptation_ss << line << '\n';
+            else
+              read_timing(line, data.timing);
+          } else if (tag == 'H') {
+            if (header_read)
+              throw std::invalid_argument
+                ("Binary Stan output has two headers in parse_binary");
+            data.header.resize(read_binary<boost::uint64_t>(in));
+            for (int n = 0; n < data.header.size(); ++n)
+              data.header(n) = header_name(read_binary_string(in));
+            size_t num_vars = read_binary<boost::uint64_t>(in);
+            for (size_t v = 0; v < num_vars; ++v) {
+              read_binary_string(in);
+              read_binary<boost::uint64_t>(in);
+              size_t num_dims = read_binary<boost::uint64_t>(in);
+              for (size_t d = 0; d < num_dims; ++d)
+                read_binary<boost::uint64_t>(in);
             }
-          } else {
-            ss << line << '\n';
-            int current_cols = std::count(line.begin(), line.end(), ',') + 1;
-            if (cols == -1) {
-              cols = current_cols;
-            } else if (cols != current_cols) {
-              if (out)
-              *out << "Error: expected " << cols << " columns, but found "
-                   << current_cols << " instead for row " << rows + 1
-                   << std::endl;
-              return false;
+            header_read = true;
+          } else if (tag == 'D') {
+            if (!header_read)
+              break;
+            samples_read = true;
+            size_t block_rows = read_binary<boost::uint64_t>(in);
+            size_t block_cols = read_binary<boost::uint64_t>(in);
+            std::vector<double> block(block_rows * block_cols);
+            in.read(reinterpret_cast<char*>(block.data()),
+                    block.size() * sizeof(double));
+            if (!in)
+              throw std::invalid_argument
+                ("Binary Stan output is truncated in parse_binary");
+            if (static_cast<int>(block_cols) != data.header.size()) {
+              if (out && samples_ok)
+                *out << "Error: expected " << data.header.size()
+                     << " columns, but found " << block_cols
+                     << " instead for row " << rows + 1 << std::endl;
+              samples_ok = false;
             }
-            rows++;
+            if (samples_ok) {
+              blocks.push_back(std::vector<double>());
+              blocks.back().swap(block);
+              rows += block_rows;
+            }
+          } else {
+            throw std::invalid_argument
+              ("Unknown record in binary Stan output in parse_binary");
           }
-
-          in.peek();
         }
 
-        ss.seekg(std::ios_base::beg);
+        if (!header_read) {
+          if (out)
+            *out << "Error: error reading header" << std::endl;
+          throw std::invalid_argument
+            ("Error with header of input file in parse_binary");
+        }
+        if (!read_metadata(metadata_ss, data.metadata, out)) {
+          if (out)
+            *out << "Warning: non-fatal error reading metadata" << std::endl;
+        }
+        if (!read_adaptation(adaptation_ss, data.adaptation, out)) {
+          if (out)
+            *out << "Warning: non-fatal error reading adapation data"
+                 << std::endl;
+        }
+        if (!samples_ok) {
+          if (out)
+            *out << "Warning: non-fatal error reading samples" << std::endl;
+          return data;
+        }
 
-        if (rows > 0) {
-          samples.resize(rows, cols);
-          for (int row = 0; row < rows; row++) {
-            std::getline(ss, line);
-            std::stringstream ls(line);
-            for (int col = 0; col < cols; col++) {
-              std::getline(ls, line, ',');
-              boost::trim(line);
-              samples(row, col) = boost::lexical_cast<double>(line);
-            }
-          }
+        int cols = data.header.size();
+        data.samples.resize(rows, cols);
+        size_t row = 0;
+        for (size_t b = 0; b < blocks.size(); ++b) {
+          size_t block_rows = blocks[b].size() / cols;
+          data.samples.block(row, 0, block_rows, cols)
+            = Eigen::Map<Eigen::MatrixXd>(blocks[b].data(), block_rows, cols);
+          row += block_rows;
         }
-        return true;
+        return data;
       }
 
       /**
-       * Parses the file.
+       * Parses the file, which is either csv or the binary output of
+       * <code>stan::callbacks::binary_writer</code>.
        *
        * @param[in] in input stream to parse
        * @param[out] out output stream to send messages
        */
       static stan_csv parse(std::istream& in, std::ostream* out) {
+        if (in.peek()
+            == static_cast<unsigned char>(callbacks::binary_writer::magic()[0]))
+          return parse_binary(in, out);
+
+        std::stringstream ss;
+        ss << in.rdbuf();
+        std::string contents = ss.str();
+        return parse(contents.data(), contents.data() + contents.size(), out);
+      }
+
+      /**
+       * Parses the file with the specified name, which is either csv
+       * or the binary output of
+       * <code>stan::callbacks::binary_writer</code>.  A csv file is
+       * memory mapped and parsed in place.
+       *
+       * @param[in] filename name of file to parse
+       * @param[out] out output stream to send messages
+       * @throw std::invalid_argument if the file cannot be read
+       */
+      static stan_csv parse_file(const std::string& filename,
+                                 std::ostream* out) {
+        mapped_file file(filename);
+        if (file.size() > 0
+            && *file.begin() == callbacks::binary_writer::magic()[0]) {
+          std::ifstream in(filename.c_str(),
+                           std::ios::in | std::ios::binary);
+          return parse_binary(in, out);
+        }
+        return parse(file.begin(), file.end(), out);
+      }
+
+      /**
+       * Parses the csv file held in the specified characters.
+       *
+       * The metadata, header and adaptation are read from a stream
+       * over the lines before the samples, and the samples in place.
+       *
+       * @param[in] begin first character of file
+       * @param[in] end end of file
+       * @param[out] out output stream to send messages
+       */
+      static stan_csv parse(const char* begin, const char* end,
+                            std::ostream* out) {
+        // metadata, header line, adaptation
+        const char* samples_begin = skip_comments(begin, end);
+        if (samples_begin < end && *samples_begin == 'l') {
+          const char* eol = static_cast<const char*>(
+            std::memchr(samples_begin, '\n', end - samples_begin));
+          samples_begin = eol ? skip_comments(eol + 1, end) : end;
+        }
+        std::stringstream in(std::string(begin, samples_begin));
+
         stan_csv data;
 
         if (!read_metadata(in, data.metadata, out)) {
@@ -350,13 +644,121 @@ namespace stan {
         data.timing.warmup = 0;
         data.timing.sampling = 0;
 
-        if (!read_samples(in, data.samples, data.timing, out)) {
+        if (samples_begin == end
+            || !read_samples(samples_begin, end, data.samples, data.timing,
+                             out)) {
           if (out)
             *out << "Warning: non-fatal error reading samples" << std::endl;
         }
 
         return data;
       }
+
+    private:
+      /**
+       * Return the first character after the lines starting with
+       * <code>'#'</code> at the specified position.
+       *
+       * @param[in] p first character of a line
+       * @param[in] end end of characters
+       * @return first character of the next line which is not a
+       *   comment, or end
+       */
+      static const char* skip_comments(const char* p, const char* end) {
+        while (p < end && *p == '#') {
+          const char* eol
+            = static_cast<const char*>(std::memchr(p, '\n', end - p));
+          p = eol ? eol + 1 : end;
+        }
+        return p;
+      }
+
+      /**
+       * Parse the comma separated values of a line.
+       *
+       * @param[in] p first character of line
+       * @param[in] end end of line
+       * @param[out] values values
+       * @param[in] cols number of values
+       * @return 0 on success, 1 if the number of values differs from
+       *   the number of columns, 2 if a value is not a number
+       */
+      static int read_row(const char* p, const char* end, double* values,
+                          int cols) {
+        for (int col = 0; col < cols; ++col) {
+          while (p < end && is_space(*p))
+            ++p;
+          const char* value_end = p;
+          if (!parse_double(value_end, end, values[col])
+              || (value_end < end && *value_end != ','
+                  && !is_space(*value_end))) {
+            value_end = p;
+            while (value_end < end && *value_end != ',')
+              ++value_end;
+            const char* token_end = value_end;
+            while (token_end > p && is_space(token_end[-1]))
+              --token_end;
+            if (!parse_token(p, token_end, values[col]))
+              return 2;
+          }
+          while (value_end < end && is_space(*value_end))
+            ++value_end;
+          if (value_end < end && *value_end != ',')
+            return 2;
+          if (col + 1 < cols) {
+            if (value_end == end)
+              return 1;
+            p = value_end + 1;
+          } else if (value_end != end) {
+            return 1;
+          }
+        }
+        return 0;
+      }
+
+      static bool is_space(char c) {
+        return c == ' ' || c == '\t' || c == '\r';
+      }
+
+      /**
+       * Convert the specified characters with <code>strtod</code>,
+       * for numbers outside the fast path and tokens such as
+       * <code>nan</code> or <code>inf</code>.
+       *
+       * @param[in] begin first character of token
+       * @param[in] end end of token
+       * @param[out] x value
+       * @return true if the whole token is a number
+       */
+      static bool parse_token(const char* begin, const char* end,
+                              double& x) {
+        if (begin == end)
+          return false;
+        std::string token(begin, end);
+        char* token_end;
+        x = std::strtod(token.c_str(), &token_end);
+        return token_end == token.c_str() + token.size();
+      }
+
+      template <typename T>
+      static T read_binary(std::istream& in) {
+        T x;
+        in.read(reinterpret_cast<char*>(&x), sizeof(x));
+        if (!in)
+          throw std::invalid_argument
+            ("Binary Stan output is truncated in parse_binary");
+        return x;
+      }
+
+      static std::string read_binary_string(std::istream& in) {
+        std::string s(read_binary<boost::uint64_t>(in), ' ');
+        if (!s.empty())
+          in.read(&s[0], s.size());
+        if (!in)
+          throw std::invalid_argument
+            ("Binary Stan output is truncated in parse_binary");
+        return s;
+      }
     };
 
   }  // io
@@ -17,6 +17,7 @@
 
 #include <stan/lang/ast/fun/has_non_param_var_vis.hpp>
 #include <stan/lang/ast/fun/has_prob_fun_suffix.hpp>
+#include <stan/lang/ast/fun/has_higher_order_fun_vis.hpp>
 #include <stan/lang/ast/fun/has_var_vis.hpp>
 #include <stan/lang/ast/fun/is_multi_index_vis.hpp>
 #include <stan/lang/ast/fun/is_no_op_statement_vis.hpp>
@@ -40,6 +41,7 @@
 #include <stan/lang/ast/fun/get_prob_fun.hpp>
 #include <stan/lang/ast/fun/has_ccdf_suffix.hpp>
 #include <stan/lang/ast/fun/has_cdf_suffix.hpp>
+#include <stan/lang/ast/fun/has_higher_order_fun.hpp>
 #include <stan/lang/ast/fun/has_lp_suffix.hpp>
 #include <stan/lang/ast/fun/has_non_param_var.hpp>
 #include <stan/lang/ast/fun/has_rng_suffix.hpp>
@@ -67,6 +69,7 @@
 
 #include <stan/lang/ast/node/algebra_solver.hpp>
 #include <stan/lang/ast/node/algebra_solver_control.hpp>
+#include <stan/lang/ast/node/map_rect.hpp>
 #include <stan/lang/ast/node/arg_decl.hpp>
 #include <stan/lang/ast/node/array_expr.hpp>
 #include <stan/lang/ast/node/assgn.hpp>
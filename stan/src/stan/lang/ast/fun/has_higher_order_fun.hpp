@@ -0,0 +1,33 @@
+#ifndef STAN_LANG_AST_FUN_HAS_HIGHER_ORDER_FUN_HPP
+#define STAN_LANG_AST_FUN_HAS_HIGHER_ORDER_FUN_HPP
+
+namespace stan {
+  namespace lang {
+
+    struct program;
+    struct statement;
+
+    /**
+     * Return true if the specified statement calls one of the
+     * higher-order functions, the ODE integrators, the algebraic
+     * solver or <code>map_rect</code>.
+     *
+     * @param st statement to test
+     * @return true if the statement calls a higher-order function
+     */
+    bool has_higher_order_fun(const statement& st);
+
+    /**
+     * Return true if the log density of the specified program calls
+     * one of the higher-order functions, which are not implemented
+     * for second-order autodiff types.  The functions, transformed
+     * parameters and model blocks are searched.
+     *
+     * @param prog program to test
+     * @return true if the log density calls a higher-order function
+     */
+    bool has_higher_order_fun(const program& prog);
+
+  }
+}
+#endif
@@ -0,0 +1,39 @@
+#ifndef STAN_LANG_AST_FUN_HAS_HIGHER_ORDER_FUN_DEF_HPP
+#define STAN_LANG_AST_FUN_HAS_HIGHER_ORDER_FUN_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    bool has_higher_order_fun(const statement& st) {
+      has_higher_order_fun_vis vis;
+      return boost::apply_visitor(vis, st.statement_);
+    }
+
+    bool has_higher_order_fun(const program& prog) {
+      for (size_t i = 0; i < prog.function_decl_defs_.size(); ++i)
+        if (has_higher_order_fun(prog.function_decl_defs_[i].body_))
+          return true;
+      has_higher_order_fun_vis vis;
+      const std::vector<var_decl>& tpar_decls = prog.derived_decl_.first;
+      for (size_t i = 0; i < tpar_decls.size(); ++i) {
+        if (!tpar_decls[i].has_def())
+          continue;
+        expression def = tpar_decls[i].def();
+        if (boost::apply_visitor(vis, def.expr_))
+          return true;
+      }
+      const std::vector<statement>& tpar_statements
+        = prog.derived_decl_.second;
+      for (size_t i = 0; i < tpar_statements.size(); ++i)
+        if (has_higher_order_fun(tpar_statements[i]))
+          return true;
+      return has_higher_order_fun(prog.statement_);
+    }
+
+  }
+}
+#endif
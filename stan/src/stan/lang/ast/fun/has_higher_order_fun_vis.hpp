@@ -0,0 +1,132 @@
+#ifndef STAN_LANG_AST_FUN_HAS_HIGHER_ORDER_FUN_VIS_HPP
+#define STAN_LANG_AST_FUN_HAS_HIGHER_ORDER_FUN_VIS_HPP
+
+#include <boost/variant/static_visitor.hpp>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    struct nil;
+    struct int_literal;
+    struct double_literal;
+    struct array_expr;
+    struct matrix_expr;
+    struct row_vector_expr;
+    struct variable;
+    struct fun;
+    struct integrate_ode;
+    struct integrate_ode_control;
+    struct algebra_solver;
+    struct algebra_solver_control;
+    struct map_rect;
+    struct index_op;
+    struct index_op_sliced;
+    struct conditional_op;
+    struct binary_op;
+    struct unary_op;
+    struct uni_idx;
+    struct multi_idx;
+    struct omni_idx;
+    struct lb_idx;
+    struct ub_idx;
+    struct lub_idx;
+    struct assignment;
+    struct assgn;
+    struct compound_assignment;
+    struct sample;
+    struct increment_log_prob_statement;
+    struct expression;
+    struct statements;
+    struct for_statement;
+    struct conditional_statement;
+    struct while_statement;
+    struct break_continue_statement;
+    struct print_statement;
+    struct reject_statement;
+    struct return_statement;
+    struct no_op_statement;
+    struct idx;
+    struct statement;
+    struct printable;
+
+    /**
+     * Visitor to detect whether a statement or expression calls one
+     * of the higher-order functions, the ODE integrators, the
+     * algebraic solver or <code>map_rect</code>, which are not
+     * implemented for second-order autodiff types.  Statements and
+     * indexes are visited recursively.
+     */
+    struct has_higher_order_fun_vis : public boost::static_visitor<bool> {
+      has_higher_order_fun_vis();
+
+      bool operator()(const nil& e) const;
+      bool operator()(const int_literal& e) const;
+      bool operator()(const double_literal& e) const;
+      bool operator()(const array_expr& e) const;
+      bool operator()(const matrix_expr& e) const;
+      bool operator()(const row_vector_expr& e) const;
+      bool operator()(const variable& e) const;
+      bool operator()(const fun& e) const;
+      bool operator()(const index_op& e) const;
+      bool operator()(const index_op_sliced& e) const;
+      bool operator()(const conditional_op& e) const;
+      bool operator()(const binary_op& e) const;
+      bool operator()(const unary_op& e) const;
+
+      /**
+       * Return true, as the specified expression is a higher-order
+       * function.
+       *
+       * @param e expression
+       * @return true
+       */
+      bool operator()(const integrate_ode& e) const;
+      bool operator()(const integrate_ode_control& e) const;
+      bool operator()(const algebra_solver& e) const;
+      bool operator()(const algebra_solver_control& e) const;
+      bool operator()(const map_rect& e) const;
+
+      bool operator()(const uni_idx& i) const;
+      bool operator()(const multi_idx& i) const;
+      bool operator()(const omni_idx& i) const;
+      bool operator()(const lb_idx& i) const;
+      bool operator()(const ub_idx& i) const;
+      bool operator()(const lub_idx& i) const;
+
+      bool operator()(const assignment& st) const;
+      bool operator()(const assgn& st) const;
+      bool operator()(const compound_assignment& st) const;
+      bool operator()(const sample& st) const;
+      bool operator()(const increment_log_prob_statement& st) const;
+      bool operator()(const expression& st) const;
+      bool operator()(const statements& st) const;
+      bool operator()(const for_statement& st) const;
+      bool operator()(const conditional_statement& st) const;
+      bool operator()(const while_statement& st) const;
+      bool operator()(const break_continue_statement& st) const;
+      bool operator()(const print_statement& st) const;
+      bool operator()(const reject_statement& st) const;
+      bool operator()(const return_statement& st) const;
+      bool operator()(const no_op_statement& st) const;
+
+      /**
+       * Return false, as a string in a print or reject statement
+       * does not call a function.
+       *
+       * @param s string
+       * @return false
+       */
+      bool operator()(const std::string& s) const;
+
+    private:
+      bool any(const std::vector<expression>& es) const;
+      bool any(const std::vector<idx>& idxs) const;
+      bool any(const std::vector<statement>& sts) const;
+      bool any(const std::vector<printable>& ps) const;
+    };
+
+  }
+}
+#endif
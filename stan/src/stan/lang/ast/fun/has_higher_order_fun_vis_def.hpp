@@ -0,0 +1,250 @@
+#ifndef STAN_LANG_AST_FUN_HAS_HIGHER_ORDER_FUN_VIS_DEF_HPP
+#define STAN_LANG_AST_FUN_HAS_HIGHER_ORDER_FUN_VIS_DEF_HPP
+
+#include <stan/lang/ast.hpp>
+#include <boost/variant/apply_visitor.hpp>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace lang {
+
+    has_higher_order_fun_vis::has_higher_order_fun_vis() { }
+
+    bool has_higher_order_fun_vis::operator()(const nil& e) const {
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const int_literal& e) const {
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const double_literal& e)
+      const {
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const array_expr& e) const {
+      return any(e.args_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const matrix_expr& e) const {
+      return any(e.args_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const row_vector_expr& e)
+      const {
+      return any(e.args_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const variable& e) const {
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const fun& e) const {
+      return any(e.args_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const index_op& e) const {
+      if (boost::apply_visitor(*this, e.expr_.expr_))
+        return true;
+      for (size_t i = 0; i < e.dimss_.size(); ++i)
+        if (any(e.dimss_[i]))
+          return true;
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const index_op_sliced& e)
+      const {
+      return boost::apply_visitor(*this, e.expr_.expr_)
+        || any(e.idxs_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const conditional_op& e)
+      const {
+      return boost::apply_visitor(*this, e.cond_.expr_)
+        || boost::apply_visitor(*this, e.true_val_.expr_)
+        || boost::apply_visitor(*this, e.false_val_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const binary_op& e) const {
+      return boost::apply_visitor(*this, e.left.expr_)
+        || boost::apply_visitor(*this, e.right.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const unary_op& e) const {
+      return boost::apply_visitor(*this, e.subject.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const integrate_ode& e) const {
+      return true;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const integrate_ode_control& e)
+      const {
+      return true;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const algebra_solver& e)
+      const {
+      return true;
+    }
+
+    bool has_higher_order_fun_vis::operator()(
+                                       const algebra_solver_control& e) const {
+      return true;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const map_rect& e) const {
+      return true;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const uni_idx& i) const {
+      return boost::apply_visitor(*this, i.idx_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const multi_idx& i) const {
+      return boost::apply_visitor(*this, i.idxs_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const omni_idx& i) const {
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const lb_idx& i) const {
+      return boost::apply_visitor(*this, i.lb_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const ub_idx& i) const {
+      return boost::apply_visitor(*this, i.ub_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const lub_idx& i) const {
+      return boost::apply_visitor(*this, i.lb_.expr_)
+        || boost::apply_visitor(*this, i.ub_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const assignment& st) const {
+      return any(st.var_dims_.dims_)
+        || boost::apply_visitor(*this, st.expr_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const assgn& st) const {
+      return any(st.idxs_)
+        || boost::apply_visitor(*this, st.rhs_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const compound_assignment& st)
+      const {
+      return any(st.var_dims_.dims_)
+        || boost::apply_visitor(*this, st.expr_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const sample& st) const {
+      return boost::apply_visitor(*this, st.expr_.expr_)
+        || any(st.dist_.args_)
+        || boost::apply_visitor(*this, st.truncation_.low_.expr_)
+        || boost::apply_visitor(*this, st.truncation_.high_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(
+                         const increment_log_prob_statement& st) const {
+      return boost::apply_visitor(*this, st.log_prob_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const expression& st) const {
+      return boost::apply_visitor(*this, st.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const statements& st) const {
+      for (size_t i = 0; i < st.local_decl_.size(); ++i) {
+        if (!st.local_decl_[i].has_def())
+          continue;
+        expression def = st.local_decl_[i].def();
+        if (boost::apply_visitor(*this, def.expr_))
+          return true;
+      }
+      return any(st.statements_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const for_statement& st) const {
+      return boost::apply_visitor(*this, st.range_.low_.expr_)
+        || boost::apply_visitor(*this, st.range_.high_.expr_)
+        || boost::apply_visitor(*this, st.statement_.statement_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(
+                         const conditional_statement& st) const {
+      return any(st.conditions_)
+        || any(st.bodies_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const while_statement& st)
+      const {
+      return boost::apply_visitor(*this, st.condition_.expr_)
+        || boost::apply_visitor(*this, st.body_.statement_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(
+                         const break_continue_statement& st) const {
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const print_statement& st)
+      const {
+      return any(st.printables_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const reject_statement& st)
+      const {
+      return any(st.printables_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const return_statement& st)
+      const {
+      return boost::apply_visitor(*this, st.return_value_.expr_);
+    }
+
+    bool has_higher_order_fun_vis::operator()(const no_op_statement& st)
+      const {
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::operator()(const std::string& s) const {
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::any(const std::vector<expression>& es)
+      const {
+      for (size_t i = 0; i < es.size(); ++i)
+        if (boost::apply_visitor(*this, es[i].expr_))
+          return true;
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::any(const std::vector<idx>& idxs) const {
+      for (size_t i = 0; i < idxs.size(); ++i)
+        if (boost::apply_visitor(*this, idxs[i].idx_))
+          return true;
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::any(const std::vector<statement>& sts)
+      const {
+      for (size_t i = 0; i < sts.size(); ++i)
+        if (boost::apply_visitor(*this, sts[i].statement_))
+          return true;
+      return false;
+    }
+
+    bool has_higher_order_fun_vis::any(const std::vector<printable>& ps)
+      const {
+      for (size_t i = 0; i < ps.size(); ++i)
+        if (boost::apply_visitor(*this, ps[i].printable_))
+          return true;
+      return false;
+    }
+
+  }
+}
+#endif
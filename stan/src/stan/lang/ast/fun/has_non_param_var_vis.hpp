@@ -120,6 +120,15 @@ namespace stan {
        */
        bool operator()(const algebra_solver_control& e) const;
 
+      /**
+       * Return true if the specified expression contains a variable
+       * not declared as a parameter.
+       *
+       * @param[in] e expression
+       * @return true if contains a variable not declared as a parameter
+       */
+       bool operator()(const map_rect& e) const;
+
       /**
        * Return true if the specified expression contains a variable
        * not declared as a parameter.
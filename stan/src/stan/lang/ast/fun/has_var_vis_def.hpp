@@ -79,6 +79,12 @@ namespace stan {
       return boost::apply_visitor(*this, e.theta_.expr_);
     }
 
+    bool has_var_vis::operator()(const map_rect& e) const {
+      // only shared and job params may contain vars
+      return boost::apply_visitor(*this, e.shared_params_.expr_)
+        || boost::apply_visitor(*this, e.job_params_.expr_);
+    }
+
     bool has_var_vis::operator()(const index_op& e) const {
       return boost::apply_visitor(*this, e.expr_.expr_);
     }
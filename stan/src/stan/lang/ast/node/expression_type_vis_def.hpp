@@ -35,12 +35,16 @@ namespace stan {
     }
 
     expr_type expression_type_vis::operator()(const integrate_ode& e) const {
-      return expr_type(double_type(), 2);
+      return expr_type(double_type(),
+                       e.integration_function_name_
+                       == "integrate_ode_bdf_batch" ? 3 : 2);
     }
 
     expr_type
     expression_type_vis::operator()(const integrate_ode_control& e) const {
-      return expr_type(double_type(), 2);
+      return expr_type(double_type(),
+                       e.integration_function_name_
+                       == "integrate_ode_bdf_batch" ? 3 : 2);
     }
 
     expr_type
@@ -53,6 +57,10 @@ namespace stan {
       return expr_type(vector_type(), 0);
     }
 
+    expr_type expression_type_vis::operator()(const map_rect& e) const {
+      return expr_type(vector_type(), 0);
+    }
+
     expr_type expression_type_vis::operator()(const fun& e) const {
       return e.type_;
     }
@@ -0,0 +1,85 @@
+#ifndef STAN_LANG_AST_NODE_MAP_RECT_HPP
+#define STAN_LANG_AST_NODE_MAP_RECT_HPP
+
+#include <stan/lang/ast/node/expression.hpp>
+#include <string>
+
+namespace stan {
+  namespace lang {
+
+    struct expression;
+
+    /**
+     * Structure for map_rect expression, which applies a function to
+     * shared parameters and to each of a sequence of job-specific
+     * parameters and data, concatenating the results.
+     */
+    struct map_rect {
+      /**
+       * Number of <code>map_rect</code> calls assigned an identifier
+       * so far.
+       */
+      static int CALL_ID_;
+
+      /**
+       * Identifier of this call, unique within a program.
+       */
+      int call_id_;
+
+      /**
+       * Name of the mapped function.
+       */
+      std::string fun_name_;
+
+      /**
+       * Parameters shared by all jobs.
+       */
+      expression shared_params_;
+
+      /**
+       * Job-specific parameters.
+       */
+      expression job_params_;
+
+      /**
+       * Job-specific real-valued data.
+       */
+      expression job_data_r_;
+
+      /**
+       * Job-specific integer-valued data.
+       */
+      expression job_data_i_;
+
+      /**
+       * Construct a default map_rect node.
+       */
+      map_rect();
+
+      /**
+       * Construct a map_rect node with the specified function name
+       * and arguments.
+       *
+       * @param call_id identifier of the call
+       * @param fun_name name of the mapped function
+       * @param shared_params parameters shared by all jobs
+       * @param job_params job-specific parameters
+       * @param job_data_r job-specific real-valued data
+       * @param job_data_i job-specific integer-valued data
+       */
+      map_rect(int call_id,
+               const std::string& fun_name,
+               const expression& shared_params,
+               const expression& job_params,
+               const expression& job_data_r,
+               const expression& job_data_i);
+
+      /**
+       * Assign this call the next unused call identifier.
+       */
+      void register_id();
+    };
+
+  }
+}
+#endif
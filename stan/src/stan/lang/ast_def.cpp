@@ -18,6 +18,8 @@
 #include <stan/lang/ast/fun/get_prob_fun_def.hpp>
 #include <stan/lang/ast/fun/has_ccdf_suffix_def.hpp>
 #include <stan/lang/ast/fun/has_cdf_suffix_def.hpp>
+#include <stan/lang/ast/fun/has_higher_order_fun_def.hpp>
+#include <stan/lang/ast/fun/has_higher_order_fun_vis_def.hpp>
 #include <stan/lang/ast/fun/has_lp_suffix_def.hpp>
 #include <stan/lang/ast/fun/has_non_param_var_def.hpp>
 #include <stan/lang/ast/fun/has_non_param_var_vis_def.hpp>
@@ -55,6 +57,7 @@
 
 #include <stan/lang/ast/node/algebra_solver_def.hpp>
 #include <stan/lang/ast/node/algebra_solver_control_def.hpp>
+#include <stan/lang/ast/node/map_rect_def.hpp>
 #include <stan/lang/ast/node/arg_decl_def.hpp>
 #include <stan/lang/ast/node/array_expr_def.hpp>
 #include <stan/lang/ast/node/assignment_def.hpp>
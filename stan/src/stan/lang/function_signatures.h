@@ -75,6 +75,14 @@ for (size_t i = 0; i < int_vector_types.size(); ++i)
     add("bernoulli_logit_lpmf", expr_type(double_type()), int_vector_types[i], 
 	vector_types[j]);
   }
+std::vector<expr_type> glm_intercept_types;
+glm_intercept_types.push_back(expr_type(double_type()));
+glm_intercept_types.push_back(expr_type(vector_type()));
+for (size_t i = 0; i < int_vector_types.size(); ++i)
+  for (size_t j = 0; j < glm_intercept_types.size(); ++j)
+    add("bernoulli_logit_glm_lpmf", expr_type(double_type()),
+        int_vector_types[i], expr_type(matrix_type()),
+        glm_intercept_types[j], expr_type(vector_type()));
 add("bessel_first_kind", expr_type(double_type()), expr_type(int_type()), expr_type(double_type()));
 add("bessel_second_kind", expr_type(double_type()), expr_type(int_type()), expr_type(double_type()));
 for (size_t i = 0; i < int_vector_types.size(); i++)
@@ -424,6 +432,42 @@ add("gaussian_dlm_obs_lpdf", expr_type(double_type()), expr_type(matrix_type()),
 add("gaussian_dlm_obs_lpdf", expr_type(double_type()), expr_type(matrix_type()), expr_type(matrix_type()), expr_type(matrix_type()),
     expr_type(vector_type()), expr_type(matrix_type()), expr_type(vector_type()), expr_type(matrix_type()));
 add_nullary("get_lp");  // special handling in term_grammar_def
+std::vector<expr_type> gp_input_types;
+gp_input_types.push_back(expr_type(double_type(), 1U));
+gp_input_types.push_back(expr_type(vector_type(), 1U));
+gp_input_types.push_back(expr_type(row_vector_type(), 1U));
+for (size_t i = 0; i < gp_input_types.size(); ++i) {
+  add("gp_dot_prod_cov", expr_type(matrix_type()), gp_input_types[i],
+      expr_type(double_type()));
+  add("gp_dot_prod_cov", expr_type(matrix_type()), gp_input_types[i],
+      gp_input_types[i], expr_type(double_type()));
+  add("gp_exp_quad_cholesky", expr_type(matrix_type()), gp_input_types[i],
+      expr_type(double_type()), expr_type(double_type()),
+      expr_type(double_type()));
+  add("gp_matern32_cholesky", expr_type(matrix_type()), gp_input_types[i],
+      expr_type(double_type()), expr_type(double_type()),
+      expr_type(double_type()));
+  add("gp_matern32_cov", expr_type(matrix_type()), gp_input_types[i],
+      expr_type(double_type()), expr_type(double_type()));
+  add("gp_matern32_cov", expr_type(matrix_type()), gp_input_types[i],
+      gp_input_types[i], expr_type(double_type()), expr_type(double_type()));
+  add("gp_matern52_cholesky", expr_type(matrix_type()), gp_input_types[i],
+      expr_type(double_type()), expr_type(double_type()),
+      expr_type(double_type()));
+  add("gp_matern52_cov", expr_type(matrix_type()), gp_input_types[i],
+      expr_type(double_type()), expr_type(double_type()));
+  add("gp_matern52_cov", expr_type(matrix_type()), gp_input_types[i],
+      gp_input_types[i], expr_type(double_type()), expr_type(double_type()));
+  add("gp_periodic_cholesky", expr_type(matrix_type()), gp_input_types[i],
+      expr_type(double_type()), expr_type(double_type()),
+      expr_type(double_type()), expr_type(double_type()));
+  add("gp_periodic_cov", expr_type(matrix_type()), gp_input_types[i],
+      expr_type(double_type()), expr_type(double_type()),
+      expr_type(double_type()));
+  add("gp_periodic_cov", expr_type(matrix_type()), gp_input_types[i],
+      gp_input_types[i], expr_type(double_type()), expr_type(double_type()),
+      expr_type(double_type()));
+}
 for (size_t i = 0; i < vector_types.size(); ++i) {
   for (size_t j = 0; j < vector_types.size(); ++j) {
     for (size_t k = 0; k < vector_types.size(); ++k) {
@@ -772,6 +816,12 @@ for (size_t i = 0; i < vector_types.size(); ++i) {
     }
   }
 }
+for (size_t i = 0; i < vector_types.size(); ++i)
+  for (size_t j = 0; j < glm_intercept_types.size(); ++j)
+    for (size_t k = 0; k < glm_intercept_types.size(); ++k)
+      add("normal_id_glm_lpdf", expr_type(double_type()), vector_types[i],
+          expr_type(matrix_type()), glm_intercept_types[j],
+          expr_type(vector_type()), glm_intercept_types[k]);
 add_binary("normal_rng");
 add_nullary("not_a_number");
 add("num_elements", expr_type(int_type()), expr_type(matrix_type()));
@@ -862,6 +912,11 @@ for (size_t i = 0; i < int_vector_types.size(); ++i) {
 	vector_types[j]);
   }
 }
+for (size_t i = 0; i < int_vector_types.size(); ++i)
+  for (size_t j = 0; j < glm_intercept_types.size(); ++j)
+    add("poisson_log_glm_lpmf", expr_type(double_type()),
+        int_vector_types[i], expr_type(matrix_type()),
+        glm_intercept_types[j], expr_type(vector_type()));
 add("poisson_log_rng", expr_type(int_type()), expr_type(double_type()));
 add_nullary("positive_infinity");
 add_binary("pow");
@@ -67,6 +67,7 @@
 #include <stan/lang/generator/generate_function_inline_return_type.hpp>
 #include <stan/lang/generator/generate_function_template_parameters.hpp>
 #include <stan/lang/generator/generate_functor_arguments.hpp>
+#include <stan/lang/generator/generate_fvar_var_log_prob_flag.hpp>
 #include <stan/lang/generator/generate_globals.hpp>
 #include <stan/lang/generator/generate_idx.hpp>
 #include <stan/lang/generator/generate_idxs.hpp>
@@ -10,6 +10,7 @@
 #include <stan/lang/generator/generate_destructor.hpp>
 #include <stan/lang/generator/generate_dims_method.hpp>
 #include <stan/lang/generator/generate_functions.hpp>
+#include <stan/lang/generator/generate_fvar_var_log_prob_flag.hpp>
 #include <stan/lang/generator/generate_globals.hpp>
 #include <stan/lang/generator/generate_includes.hpp>
 #include <stan/lang/generator/generate_init_method.hpp>
@@ -64,6 +65,7 @@ namespace stan {
       generate_public_decl(o);
       generate_constructor(prog, model_name, o);
       generate_destructor(model_name, o);
+      generate_fvar_var_log_prob_flag(prog, o);
       // put back if ever need integer params
       // generate_set_param_ranges(prog.parameter_decl_, o);
       generate_init_method(prog.parameter_decl_, o);
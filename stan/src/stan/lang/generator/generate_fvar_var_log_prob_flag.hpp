@@ -0,0 +1,32 @@
+#ifndef STAN_LANG_GENERATOR_GENERATE_FVAR_VAR_LOG_PROB_FLAG_HPP
+#define STAN_LANG_GENERATOR_GENERATE_FVAR_VAR_LOG_PROB_FLAG_HPP
+
+#include <stan/lang/ast.hpp>
+#include <stan/lang/generator/constants.hpp>
+#include <ostream>
+
+namespace stan {
+  namespace lang {
+
+    /**
+     * Generate the static member which declares that the
+     * <code>log_prob</code> method cannot be instantiated with
+     * <code>fvar&lt;var&gt;</code> arguments, if the specified program
+     * calls a higher-order function in its log density, so that
+     * Hessians are computed by finite differences.
+     *
+     * @param[in] prog program from which to generate
+     * @param[in,out] o stream for generating
+     */
+    void generate_fvar_var_log_prob_flag(const program& prog,
+                                         std::ostream& o) {
+      if (!has_higher_order_fun(prog))
+        return;
+      o << INDENT << "// higher-order functions are not implemented for"
+        << " fvar<var>" << EOL
+        << INDENT << "static const bool fvar_var_log_prob = false;" << EOL2;
+    }
+
+  }
+}
+#endif
@@ -591,6 +591,13 @@ namespace stan {
     extern boost::phoenix::function<validate_algebra_solver_control>
     validate_algebra_solver_control_f;
 
+    // called from: term_grammar
+    struct validate_map_rect : public phoenix_functor_quaternary {
+      void operator()(map_rect& mr, const variable_map& var_map,
+                      bool& pass, std::ostream& error_msgs) const;
+    };
+    extern boost::phoenix::function<validate_map_rect> validate_map_rect_f;
+
     // called from: term_grammar
     struct set_fun_type_named : public phoenix_functor_senary {
       void operator()(expression& fun_result, fun& fun,
@@ -759,6 +766,7 @@ namespace stan {
       bool operator()(const integrate_ode_control& x) const;
       bool operator()(const algebra_solver& x) const;
       bool operator()(const algebra_solver_control& x) const;
+      bool operator()(const map_rect& x) const;
       bool operator()(const fun& x) const;
       bool operator()(const index_op& x) const;
       bool operator()(const index_op_sliced& x) const;
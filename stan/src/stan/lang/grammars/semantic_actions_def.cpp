@@ -251,6 +251,7 @@ namespace stan {
     template void assign_lhs::operator()(expression&,
                                          const algebra_solver_control&)
       const;
+    template void assign_lhs::operator()(expression&, const map_rect&) const;
     template void assign_lhs::operator()(array_expr&,
                                          const array_expr&) const;
     template void assign_lhs::operator()(matrix_expr&,
@@ -1567,6 +1568,11 @@ namespace stan {
                                                  bool& pass,
                                                  std::ostream& error_msgs) {
       pass = true;
+      // the batched solver takes one array of arguments per subject
+      const bool batch
+        = ode_fun.integration_function_name_ == "integrate_ode_bdf_batch";
+      const size_t dims = batch ? 2 : 1;
+      const char* arr = batch ? "[,]" : "[]";
       // test function argument type
       expr_type sys_result_type(double_type(), 1);
       std::vector<function_arg_type> sys_arg_types;
@@ -1585,10 +1591,11 @@ namespace stan {
         pass = false;
       }
       // test regular argument types
-      if (ode_fun.y0_.expression_type() != expr_type(double_type(), 1)) {
+      if (ode_fun.y0_.expression_type() != expr_type(double_type(), dims)) {
         error_msgs << "second argument to "
                    << ode_fun.integration_function_name_
-                   << " must have type real[] for intial system state;"
+                   << " must have type real" << arr
+                   << " for intial system state;"
                    << " found type="
                    << ode_fun.y0_.expression_type()
                    << ". ";
@@ -1603,35 +1610,38 @@ namespace stan {
                    << ". ";
         pass = false;
       }
-      if (ode_fun.ts_.expression_type() != expr_type(double_type(), 1)) {
+      if (ode_fun.ts_.expression_type() != expr_type(double_type(), dims)) {
         error_msgs << "fourth argument to "
                    << ode_fun.integration_function_name_
-                   << " must have type real[]"
+                   << " must have type real" << arr
                    << " for requested solution times; found type="
                    << ode_fun.ts_.expression_type()
                    << ". ";
         pass = false;
       }
-      if (ode_fun.theta_.expression_type() != expr_type(double_type(), 1)) {
+      if (ode_fun.theta_.expression_type() != expr_type(double_type(), dims)) {
         error_msgs << "fifth argument to "
                    << ode_fun.integration_function_name_
-                   << " must have type real[] for parameters; found type="
+                   << " must have type real" << arr
+                   << " for parameters; found type="
                    << ode_fun.theta_.expression_type()
                    << ". ";
         pass = false;
       }
-      if (ode_fun.x_.expression_type() != expr_type(double_type(), 1)) {
+      if (ode_fun.x_.expression_type() != expr_type(double_type(), dims)) {
         error_msgs << "sixth argument to "
                    << ode_fun.integration_function_name_
-                   << " must have type real[] for real data; found type="
+                   << " must have type real" << arr
+                   << " for real data; found type="
                    << ode_fun.x_.expression_type()
                    << ". ";
         pass = false;
       }
-      if (ode_fun.x_int_.expression_type() != expr_type(int_type(), 1)) {
+      if (ode_fun.x_int_.expression_type() != expr_type(int_type(), dims)) {
         error_msgs << "seventh argument to "
                    << ode_fun.integration_function_name_
-                   << " must have type int[] for integer data; found type="
+                   << " must have type int" << arr
+                   << " for integer data; found type="
                    << ode_fun.x_int_.expression_type()
                    << ". ";
         pass = false;
@@ -1875,6 +1885,81 @@ namespace stan {
     boost::phoenix::function<validate_algebra_solver_control>
     validate_algebra_solver_control_f;
 
+    void validate_map_rect::operator()(map_rect& mr,
+                                       const variable_map& var_map,
+                                       bool& pass,
+                                       std::ostream& error_msgs) const {
+      pass = true;
+
+      // mapped function must be vector f(vector, vector, real[], int[])
+      expr_type shard_result_type(vector_type(), 0);
+      std::vector<function_arg_type> shard_arg_types;
+      shard_arg_types.push_back(function_arg_type(expr_type(vector_type(),
+                                                            0)));  // phi
+      shard_arg_types.push_back(function_arg_type(expr_type(vector_type(),
+                                                            0)));  // theta
+      shard_arg_types.push_back(function_arg_type(expr_type(double_type(),
+                                                            1), true));  // x_r
+      shard_arg_types.push_back(function_arg_type(expr_type(int_type(),
+                                                            1), true));  // x_i
+      function_signature_t shard_signature(shard_result_type,
+                                           shard_arg_types);
+      if (!function_signatures::instance()
+          .is_defined(mr.fun_name_, shard_signature)) {
+        error_msgs << "first argument to map_rect"
+                   << " must be the name of a function with signature"
+                   << " (vector, vector, real[], int[]) : vector"
+                   << std::endl;
+        pass = false;
+      }
+
+      // test regular argument types
+      if (mr.shared_params_.expression_type() != expr_type(vector_type(), 0)) {
+        error_msgs << "second argument to map_rect"
+                   << " must have type vector for shared parameters;"
+                   << " found type = "
+                   << mr.shared_params_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+      if (mr.job_params_.expression_type() != expr_type(vector_type(), 1)) {
+        error_msgs << "third argument to map_rect"
+                   << " must have type vector[] for job-specific parameters;"
+                   << " found type = "
+                   << mr.job_params_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+      if (mr.job_data_r_.expression_type() != expr_type(double_type(), 2)) {
+        error_msgs << "fourth argument to map_rect"
+                   << " must have type real[ , ] for real data;"
+                   << " found type = "
+                   << mr.job_data_r_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+      if (mr.job_data_i_.expression_type() != expr_type(int_type(), 2)) {
+        error_msgs << "fifth argument to map_rect"
+                   << " must have type int[ , ] for integer data;"
+                   << " found type = "
+                   << mr.job_data_i_.expression_type()
+                   << ". " << std::endl;
+        pass = false;
+      }
+
+      // test data-only variables do not have parameters (int locals OK)
+      if (has_var(mr.job_data_r_, var_map)) {
+        error_msgs << "fourth argument to map_rect"
+                   << " (real data)"
+                   << " must be data only and not reference parameters"
+                   << std::endl;
+        pass = false;
+      }
+
+      if (pass)
+        mr.register_id();
+    }
+    boost::phoenix::function<validate_map_rect> validate_map_rect_f;
 
     void set_fun_type_named::operator()(expression& fun_result, fun& fun,
                                         const scope& var_scope,
@@ -2587,6 +2672,10 @@ namespace stan {
       const {
       return boost::apply_visitor(*this, x.theta_.expr_);
     }
+    bool data_only_expression::operator()(const map_rect& x) const {
+      return boost::apply_visitor(*this, x.shared_params_.expr_)
+        && boost::apply_visitor(*this, x.job_params_.expr_);
+    }
     bool data_only_expression::operator()(const fun& x) const {
       for (size_t i = 0; i < x.args_.size(); ++i)
         if (!boost::apply_visitor(*this, x.args_[i].expr_))
@@ -105,6 +105,11 @@ namespace stan {
                               whitespace_grammar<Iterator> >
       algebra_solver_control_r;
 
+      boost::spirit::qi::rule<Iterator,
+                              map_rect(scope),
+                              whitespace_grammar<Iterator> >
+      map_rect_r;
+
       boost::spirit::qi::rule<Iterator,
                               std::string(),
                               whitespace_grammar<Iterator> >
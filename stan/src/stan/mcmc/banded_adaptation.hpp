@@ -0,0 +1,132 @@
+#ifndef STAN_MCMC_BANDED_ADAPTATION_HPP
+#define STAN_MCMC_BANDED_ADAPTATION_HPP
+
+#include <stan/math/prim/mat.hpp>
+#include <stan/mcmc/windowed_adaptation.hpp>
+#include <algorithm>
+
+namespace stan {
+
+  namespace mcmc {
+
+    /**
+     * Windowed adaptation of a banded metric (mass matrix).
+     *
+     * <p>The band of the sample covariance is accumulated with
+     * Welford's algorithm.  At the end of each window it is
+     * regularized as in <code>covar_adaptation</code>, and the mass
+     * matrix is estimated by the modified Cholesky decomposition of
+     * the precision: each coordinate is regressed on the preceding
+     * coordinates within the bandwidth, which gives a precision
+     * matrix with the same bandwidth.  The cost is linear in the
+     * number of dimensions for a fixed bandwidth.
+     */
+    class banded_adaptation: public windowed_adaptation {
+    public:
+      /**
+       * Construct a banded adaptation.
+       *
+       * @param n number of dimensions
+       * @param bandwidth number of nonzero diagonals of the mass
+       *   matrix below the main diagonal
+       */
+      banded_adaptation(int n, int bandwidth)
+        : windowed_adaptation("banded precision"), n_(n),
+          bandwidth_(std::max(0, std::min(bandwidth, n - 1))),
+          num_samples_(0), m_(Eigen::VectorXd::Zero(n)),
+          m2_(Eigen::MatrixXd::Zero(bandwidth_ + 1, n)) {}
+
+      /**
+       * Add a draw of an adaptation window, and at the end of a
+       * window update the lower band of the mass matrix.
+       *
+       * @param[in,out] e_metric_band lower band of mass matrix by
+       *   diagonals, as stored by <code>banded_e_point</code>
+       * @param[in] q draw
+       * @return true if the mass matrix was updated
+       */
+      bool learn_band(Eigen::MatrixXd& e_metric_band,
+                      const Eigen::VectorXd& q) {
+        if (adaptation_window())
+          add_sample(q);
+
+        if (end_adaptation_window()) {
+          compute_next_window();
+
+          estimate(e_metric_band);
+          num_samples_ = 0;
+          m_.setZero();
+          m2_.setZero();
+
+          ++adapt_window_counter_;
+          return true;
+        }
+
+        ++adapt_window_counter_;
+        return false;
+      }
+
+    protected:
+      // element (i, j) of a symmetric matrix with |i - j| <= bandwidth
+      static double band_element(const Eigen::MatrixXd& band, int i, int j) {
+        return i >= j ? band(i - j, j) : band(j - i, i);
+      }
+
+      void add_sample(const Eigen::VectorXd& q) {
+        ++num_samples_;
+        Eigen::VectorXd delta(q - m_);
+        m_ += delta / num_samples_;
+        Eigen::VectorXd delta_new(q - m_);
+        for (int j = 0; j < n_; ++j)
+          for (int k = 0; k <= bandwidth_ && j + k < n_; ++k)
+            m2_(k, j) += delta(j + k) * delta_new(j);
+      }
+
+      void estimate(Eigen::MatrixXd& e_metric_band) const {
+        const int b = bandwidth_;
+        double n = static_cast<double>(num_samples_);
+        Eigen::MatrixXd covar_band = Eigen::MatrixXd::Zero(b + 1, n_);
+        if (num_samples_ > 1)
+          covar_band = (n / (n + 5.0)) * m2_ / (n - 1.0);
+        covar_band.row(0).array() += 1e-3 * (5.0 / (n + 5.0));
+
+        // x_j = sum_m phi_jm x_m + e_j with var(e_j) = sigma2_j, so
+        // precision = T^T diag(1 / sigma2) T with T = I - phi
+        e_metric_band = Eigen::MatrixXd::Zero(b + 1, n_);
+        for (int j = 0; j < n_; ++j) {
+          const int p = std::min(j, b);
+          const int start = j - p;
+          Eigen::VectorXd t(p + 1);
+          double sigma2 = band_element(covar_band, j, j);
+          if (p > 0) {
+            Eigen::MatrixXd S(p, p);
+            Eigen::VectorXd s(p);
+            for (int a = 0; a < p; ++a) {
+              s(a) = band_element(covar_band, start + a, j);
+              for (int c = 0; c < p; ++c)
+                S(a, c) = band_element(covar_band,
+                                       start + a, start + c);
+            }
+            Eigen::VectorXd phi = S.llt().solve(s);
+            sigma2 -= phi.dot(s);
+            t.head(p) = -phi;
+          }
+          t(p) = 1;
+          for (int a = 0; a <= p; ++a)
+            for (int c = a; c <= p; ++c)
+              e_metric_band(c - a, start + a) += t(a) * t(c) / sigma2;
+        }
+      }
+
+      int n_;
+      int bandwidth_;
+      int num_samples_;
+      Eigen::VectorXd m_;
+      Eigen::MatrixXd m2_;
+    };
+
+  }  // mcmc
+
+}  // stan
+
+#endif
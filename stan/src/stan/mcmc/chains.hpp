@@ -3,11 +3,10 @@
 
 #include <stan/io/stan_csv_reader.hpp>
 #include <stan/math/prim/mat.hpp>
+#include <stan/math/prim/arr/functor/run_chunks_concurrent.hpp>
 #include <boost/accumulators/accumulators.hpp>
 #include <boost/accumulators/statistics/stats.hpp>
 #include <boost/accumulators/statistics/mean.hpp>
-#include <boost/accumulators/statistics/tail_quantile.hpp>
-#include <boost/accumulators/statistics/p_square_quantile.hpp>
 #include <boost/accumulators/statistics/variance.hpp>
 #include <boost/accumulators/statistics/covariance.hpp>
 #include <boost/accumulators/statistics/variates/covariate.hpp>
@@ -15,7 +14,9 @@
 #include <boost/random/additive_combine.hpp>
 #include <algorithm>
 #include <cmath>
+#include <complex>
 #include <iostream>
+#include <limits>
 #include <map>
 #include <stdexcept>
 #include <string>
@@ -49,16 +50,21 @@ namespace stan {
       Eigen::Matrix<Eigen::MatrixXd, Dynamic, 1> samples_;
       Eigen::VectorXi warmup_;
 
-      static double mean(const Eigen::VectorXd& x) {
+      typedef Eigen::Map<const Eigen::VectorXd> column_t;
+
+      template <typename Derived>
+      static double mean(const Eigen::MatrixBase<Derived>& x) {
         return (x.array() / x.size()).sum();
       }
 
-      static double variance(const Eigen::VectorXd& x) {
+      template <typename Derived>
+      static double variance(const Eigen::MatrixBase<Derived>& x) {
         double m = mean(x);
         return ((x.array() - m) / std::sqrt((x.size() - 1.0))).square().sum();
       }
 
-      static double sd(const Eigen::VectorXd& x) {
+      template <typename Derived>
+      static double sd(const Eigen::MatrixBase<Derived>& x) {
         return std::sqrt(variance(x));
       }
 
@@ -111,102 +117,150 @@ namespace stan {
                                * boost::accumulators::variance(acc_y));
       }
 
-      static double quantile(const Eigen::VectorXd& x, const double prob) {
-        using boost::accumulators::accumulator_set;
-        using boost::accumulators::left;
-        using boost::accumulators::quantile;
-        using boost::accumulators::quantile_probability;
-        using boost::accumulators::right;
-        using boost::accumulators::stats;
-        using boost::accumulators::tag::tail;
-        using boost::accumulators::tag::tail_quantile;
-        double M = x.rows();
-        // size_t cache_size = std::min(prob, 1-prob)*M + 2;
-        size_t cache_size = M;
-
-        if (prob < 0.5) {
-          accumulator_set<double, stats<tail_quantile<left> > >
-            acc(tail<left>::cache_size = cache_size);
-          for (int i = 0; i < M; i++)
-            acc(x(i));
-          return quantile(acc, quantile_probability = prob);
-        }
-        accumulator_set<double, stats<tail_quantile<right> > >
-          acc(tail<right>::cache_size = cache_size);
-        for (int i = 0; i < M; i++)
-          acc(x(i));
-        return quantile(acc, quantile_probability = prob);
+      /**
+       * Return the index of the specified quantile in the sorted
+       * values of a sample of the specified size, or -1 if it is not
+       * defined.  The quantiles are those of the tail quantile
+       * accumulators of Boost.Accumulators holding the whole sample.
+       *
+       * @param M sample size
+       * @param prob probability
+       * @return index of the quantile
+       */
+      static int quantile_index(int M, double prob) {
+        bool left = prob < 0.5;
+        int n = static_cast<int>(std::ceil(M * (left ? prob : 1. - prob)));
+        if (n >= M)
+          return -1;
+        if (n == 0)
+          return left ? 0 : M - 1;
+        return left ? n - 1 : M - n;
       }
 
-      static Eigen::VectorXd
-      quantiles(const Eigen::VectorXd& x, const Eigen::VectorXd& probs) {
-        using boost::accumulators::accumulator_set;
-        using boost::accumulators::left;
-        using boost::accumulators::quantile_probability;
-        using boost::accumulators::quantile;
-        using boost::accumulators::right;
-        using boost::accumulators::stats;
-        using boost::accumulators::tag::tail;
-        using boost::accumulators::tag::tail_quantile;
-        double M = x.rows();
-
-        // size_t cache_size = M/2 + 2;
-        size_t cache_size = M;  // 2 + 2;
-
-        accumulator_set<double, stats<tail_quantile<left> > >
-          acc_left(tail<left>::cache_size = cache_size);
-        accumulator_set<double, stats<tail_quantile<right> > >
-          acc_right(tail<right>::cache_size = cache_size);
-
-        for (int i = 0; i < M; i++) {
-          acc_left(x(i));
-          acc_right(x(i));
-        }
-
-        Eigen::VectorXd q(probs.size());
+      /**
+       * Write the specified quantiles of the values into the result.
+       * The quantiles are found by selection rather than sorting, and
+       * the values are reordered in the process.
+       *
+       * @param[in,out] x values, reordered on return
+       * @param[in] probs probabilities
+       * @param[out] q quantiles
+       */
+      static void select_quantiles(Eigen::VectorXd& x,
+                                   const Eigen::VectorXd& probs,
+                                   Eigen::VectorXd& q) {
+        const int M = x.size();
+        q.resize(probs.size());
+        std::vector<std::pair<int, int> > order;
         for (int i = 0; i < probs.size(); i++) {
-          if (probs(i) < 0.5)
-            q(i) = quantile(acc_left,
-                            quantile_probability = probs(i));
+          int k = quantile_index(M, probs(i));
+          if (k < 0)
+            q(i) = std::numeric_limits<double>::quiet_NaN();
           else
-            q(i) = quantile(acc_right,
-                            quantile_probability = probs(i));
+            order.push_back(std::make_pair(k, i));
+        }
+        std::sort(order.begin(), order.end());
+        double* begin = x.data();
+        for (size_t j = 0; j < order.size(); j++) {
+          double* nth = x.data() + order[j].first;
+          if (j == 0 || order[j].first != order[j-1].first)
+            std::nth_element(begin, nth, x.data() + M);
+          q(order[j].second) = *nth;
+          begin = nth;
         }
-        return q;
       }
 
-      static Eigen::VectorXd autocorrelation(const Eigen::VectorXd& x) {
-        using std::vector;
-        using stan::math::index_type;
-        typedef typename index_type<vector<double> >::type idx_t;
+      static double quantile(const Eigen::VectorXd& x, const double prob) {
+        Eigen::VectorXd sorted = x;
+        Eigen::VectorXd probs(1);
+        probs << prob;
+        Eigen::VectorXd q;
+        select_quantiles(sorted, probs, q);
+        return q(0);
+      }
+
+      static Eigen::VectorXd
+      quantiles(const Eigen::VectorXd& x, const Eigen::VectorXd& probs) {
+        Eigen::VectorXd sorted = x;
+        Eigen::VectorXd q;
+        select_quantiles(sorted, probs, q);
+        return q;
+      }
 
-        std::vector<double> ac;
-        std::vector<double> sample(x.size());
-        for (int i = 0; i < x.size(); i++)
-          sample[i] = x(i);
-        stan::math::autocorrelation(sample, ac);
+      template <typename Derived>
+      static Eigen::VectorXd
+      autocorrelation(const Eigen::MatrixBase<Derived>& x) {
+        Eigen::FFT<double> fft;
+        Eigen::VectorXd ac;
+        stan::math::autocorrelation(x, ac, fft);
+        return ac;
+      }
 
-        Eigen::VectorXd ac2(ac.size());
-        for (idx_t i = 0; i < ac.size(); i++)
-          ac2(i) = ac[i];
-        return ac2;
+      template <typename Derived>
+      static Eigen::VectorXd
+      autocovariance(const Eigen::MatrixBase<Derived>& x) {
+        Eigen::FFT<double> fft;
+        Eigen::VectorXd acov;
+        stan::math::autocovariance(x, acov, fft);
+        return acov;
       }
 
-      static Eigen::VectorXd autocovariance(const Eigen::VectorXd& x) {
-        using std::vector;
-        using stan::math::index_type;
-        typedef typename index_type<vector<double> >::type idx_t;
+      /**
+       * Write the mean over chains of the autocovariances of the
+       * samples for the specified number of lags.
+       *
+       * If every chain has the same number of samples, the power
+       * spectra of the chains are summed so that a single inverse FFT
+       * is needed.  Otherwise the autocovariances of the chains are
+       * computed one at a time.
+       *
+       * @param samples kept samples of each chain
+       * @param n_lags number of lags, at most the smallest number of
+       *   samples of a chain
+       * @param fft FFT engine
+       * @param mean_acov mean autocovariances
+       */
+      static void
+      mean_autocovariance(const std::vector<column_t>& samples, int n_lags,
+                          Eigen::FFT<double>& fft,
+                          Eigen::VectorXd& mean_acov) {
+        int chains = samples.size();
+        int N = samples[0].size();
+        bool same_size = true;
+        for (int chain = 1; chain < chains; chain++)
+          same_size = same_size && samples[chain].size() == N;
+
+        mean_acov.setZero(n_lags);
+        if (!same_size) {
+          Eigen::VectorXd acov;
+          for (int chain = 0; chain < chains; chain++) {
+            stan::math::autocovariance(samples[chain], acov, fft);
+            mean_acov += acov.head(n_lags) / chains;
+          }
+          return;
+        }
 
-        std::vector<double> ac;
-        std::vector<double> sample(x.size());
-        for (int i = 0; i < x.size(); i++)
-          sample[i] = x(i);
-        stan::math::autocovariance(sample, ac);
+        int Mt2 = 2 * stan::math::fft_next_good_size(N);
+        Eigen::VectorXd centered_signal = Eigen::VectorXd::Zero(Mt2);
+        Eigen::VectorXcd freqvec;
+        Eigen::VectorXd power;
+        fft.SetFlag(Eigen::FFT<double>::HalfSpectrum);
+        for (int chain = 0; chain < chains; chain++) {
+          centered_signal.head(N)
+            = samples[chain].array() - mean(samples[chain]);
+          fft.fwd(freqvec, centered_signal);
+          if (chain == 0)
+            power = freqvec.cwiseAbs2();
+          else
+            power += freqvec.cwiseAbs2();
+        }
+        freqvec = power.cast<std::complex<double> >();
+        Eigen::VectorXd acov_sum;
+        fft.inv(acov_sum, freqvec, Mt2);
+        fft.ClearFlag(Eigen::FFT<double>::HalfSpectrum);
 
-        Eigen::VectorXd ac2(ac.size());
-        for (idx_t i = 0; i < ac.size(); i++)
-          ac2(i) = ac[i];
-        return ac2;
+        for (int t = 0; t < n_lags; t++)
+          mean_acov(t) = acov_sum(t) / (static_cast<double>(N - t) * chains);
       }
 
       /**
@@ -218,57 +272,49 @@ namespace stan {
        * Current implementation takes the minimum number of samples
        * across chains as the number of samples per chain.
        *
-       * @param VectorXd
-       * @param Dynamic
-       * @param samples
+       * @param samples kept samples of each chain
+       * @param fft FFT engine for the autocovariances
        *
-       * @return
+       * @return effective sample size
        */
-      double effective_sample_size(const Eigen::Matrix<Eigen::VectorXd,
-                                   Dynamic, 1> &samples) const {
+      static double
+      effective_sample_size(const std::vector<column_t>& samples,
+                            Eigen::FFT<double>& fft) {
         int chains = samples.size();
 
         // need to generalize to each jagged samples per chain
-        int n_samples = samples(0).size();
+        int n_samples = samples[0].size();
         for (int chain = 1; chain < chains; chain++) {
           n_samples = std::min(n_samples,
-                               static_cast<int>(samples(chain).size()));
+                               static_cast<int>(samples[chain].size()));
         }
 
-        Eigen::Matrix<Eigen::VectorXd, Dynamic, 1> acov(chains);
-        for (int chain = 0; chain < chains; chain++) {
-          acov(chain) = autocovariance(samples(chain));
-        }
+        Eigen::VectorXd mean_acov;
+        mean_autocovariance(samples, n_samples, fft, mean_acov);
 
         Eigen::VectorXd chain_mean(chains);
         Eigen::VectorXd chain_var(chains);
         for (int chain = 0; chain < chains; chain++) {
-          double n_kept_samples = num_kept_samples(chain);
-          chain_mean(chain) = mean(samples(chain));
-          chain_var(chain) = acov(chain)(0)*n_kept_samples/(n_kept_samples-1);
+          chain_mean(chain) = mean(samples[chain]);
+          chain_var(chain) = variance(samples[chain]);
         }
 
         double mean_var = mean(chain_var);
         double var_plus = mean_var*(n_samples-1)/n_samples;
         if (chains > 1)
           var_plus += variance(chain_mean);
-        Eigen::VectorXd rho_hat_t(n_samples);
-        rho_hat_t.setZero();
+        double rho_hat_sum = 0;
         double rho_hat = 0;
         int max_t = 0;
         for (int t = 1; (t < n_samples && rho_hat >= 0); t++) {
-          Eigen::VectorXd acov_t(chains);
-          for (int chain = 0; chain < chains; chain++) {
-            acov_t(chain) = acov(chain)(t);
-          }
-          rho_hat = 1 - (mean_var - mean(acov_t)) / var_plus;
+          rho_hat = 1 - (mean_var - mean_acov(t)) / var_plus;
           if (rho_hat >= 0)
-            rho_hat_t(t) = rho_hat;
+            rho_hat_sum += rho_hat;
           max_t = t;
         }
         double ess = chains * n_samples;
         if (max_t > 1) {
-          ess /= 1 + 2 * rho_hat_t.sum();
+          ess /= 1 + 2 * rho_hat_sum;
         }
         return ess;
       }
@@ -280,21 +326,17 @@ namespace stan {
        * Current implementation takes the minimum number of samples
        * across chains as the number of samples per chain.
        *
-       * @param VectorXd
-       * @param Dynamic
-       * @param samples
+       * @param samples kept samples of each chain
        *
-       * @return
+       * @return split R hat
        */
-      double
-      split_potential_scale_reduction(
-                                      const Eigen::Matrix<Eigen::VectorXd,
-                                      Dynamic, 1> &samples) const {
+      static double
+      split_potential_scale_reduction(const std::vector<column_t>& samples) {
         int chains = samples.size();
-        int n_samples = samples(0).size();
+        int n_samples = samples[0].size();
         for (int chain = 1; chain < chains; chain++) {
           n_samples = std::min(n_samples,
-                               static_cast<int>(samples(chain).size()));
+                               static_cast<int>(samples[chain].size()));
         }
         if (n_samples % 2 == 1)
           n_samples--;
@@ -304,11 +346,11 @@ namespace stan {
         Eigen::VectorXd split_chain_var(2*chains);
 
         for (int chain = 0; chain < chains; chain++) {
-          split_chain_mean(2*chain) = mean(samples(chain).topRows(n));
-          split_chain_mean(2*chain+1) = mean(samples(chain).bottomRows(n));
+          split_chain_mean(2*chain) = mean(samples[chain].head(n));
+          split_chain_mean(2*chain+1) = mean(samples[chain].tail(n));
 
-          split_chain_var(2*chain) = variance(samples(chain).topRows(n));
-          split_chain_var(2*chain+1) = variance(samples(chain).bottomRows(n));
+          split_chain_var(2*chain) = variance(samples[chain].head(n));
+          split_chain_var(2*chain+1) = variance(samples[chain].tail(n));
         }
 
         double var_between = n * variance(split_chain_mean);
@@ -318,6 +360,27 @@ namespace stan {
         return sqrt((var_between/var_within + n-1)/n);
       }
 
+      /**
+       * Return the kept samples of the specified chain and parameter
+       * without copying them.
+       *
+       * @param chain chain index
+       * @param index parameter index
+       *
+       * @return kept samples
+       */
+      column_t kept_samples(const int chain, const int index) const {
+        return column_t(samples_(chain).col(index).data() + warmup(chain),
+                        num_kept_samples(chain));
+      }
+
+      std::vector<column_t> kept_samples(const int index) const {
+        std::vector<column_t> samples;
+        for (int chain = 0; chain < num_chains(); chain++)
+          samples.push_back(kept_samples(chain, index));
+        return samples;
+      }
+
     public:
       explicit chains(const Eigen::Matrix<std::string, Dynamic, 1>& param_names)
         : param_names_(param_names) { }
@@ -652,7 +715,7 @@ namespace stan {
       }
 
       Eigen::VectorXd autocorrelation(const int chain, const int index) const {
-        return autocorrelation(samples(chain, index));
+        return autocorrelation(kept_samples(chain, index));
       }
 
       Eigen::VectorXd autocorrelation(int chain,
@@ -661,21 +724,16 @@ namespace stan {
       }
 
       Eigen::VectorXd autocovariance(const int chain, const int index) const {
-        return autocovariance(samples(chain, index));
+        return autocovariance(kept_samples(chain, index));
       }
 
       Eigen::VectorXd autocovariance(int chain, const std::string& name) const {
         return autocovariance(chain, index(name));
       }
 
-      // FIXME: reimplement using autocorrelation.
       double effective_sample_size(const int index) const {
-        Eigen::Matrix<Eigen::VectorXd, Dynamic, 1>
-          samples(num_chains());
-        for (int chain = 0; chain < num_chains(); chain++) {
-          samples(chain) = this->samples(chain, index);
-        }
-        return effective_sample_size(samples);
+        Eigen::FFT<double> fft;
+        return effective_sample_size(kept_samples(index), fft);
       }
 
       double effective_sample_size(const std::string& name) const {
@@ -683,17 +741,63 @@ namespace stan {
       }
 
       double split_potential_scale_reduction(const int index) const {
-        Eigen::Matrix<Eigen::VectorXd, Dynamic, 1>
-          samples(num_chains());
-        for (int chain = 0; chain < num_chains(); chain++) {
-          samples(chain) = this->samples(chain, index);
-        }
-        return split_potential_scale_reduction(samples);
+        return split_potential_scale_reduction(kept_samples(index));
       }
 
       double split_potential_scale_reduction(const std::string& name) const {
         return split_potential_scale_reduction(index(name));
       }
+
+      /**
+       * Return the summary statistics of every parameter, one row per
+       * parameter.  The columns are the mean, the standard deviation,
+       * the quantiles for the specified probabilities, the effective
+       * sample size and the split R hat, with the values of
+       * <code>mean()</code>, <code>sd()</code>,
+       * <code>quantiles()</code>, <code>effective_sample_size()</code>
+       * and <code>split_potential_scale_reduction()</code>.
+       *
+       * The parameters are split into blocks of consecutive columns
+       * which are summarized on up to <code>STAN_NUM_THREADS</code>
+       * threads when Stan is compiled with <code>STAN_THREADS</code>.
+       * The draws of each chain are read in place, and every block
+       * reuses one FFT engine and one buffer for the pooled draws.
+       *
+       * @param probs probabilities of the quantiles
+       *
+       * @return summary statistics
+       */
+      Eigen::MatrixXd summary(const Eigen::VectorXd& probs) const {
+        const int n_probs = probs.size();
+        Eigen::MatrixXd values(num_params(), 4 + n_probs);
+        if (num_chains() == 0) {
+          values.setConstant(std::numeric_limits<double>::quiet_NaN());
+          return values;
+        }
+
+        auto execute_chunk = [&](int start, int size, std::ostream* out) {
+          Eigen::FFT<double> fft;
+          Eigen::VectorXd pooled(num_kept_samples());
+          Eigen::VectorXd q(n_probs);
+          for (int i = start; i < start + size; i++) {
+            std::vector<column_t> samples = kept_samples(i);
+            int pos = 0;
+            for (size_t chain = 0; chain < samples.size(); chain++) {
+              pooled.segment(pos, samples[chain].size()) = samples[chain];
+              pos += samples[chain].size();
+            }
+            values(i, 0) = mean(pooled);
+            values(i, 1) = sd(pooled);
+            select_quantiles(pooled, probs, q);
+            values.row(i).segment(2, n_probs) = q.transpose();
+            values(i, 2 + n_probs) = effective_sample_size(samples, fft);
+            values(i, 3 + n_probs) = split_potential_scale_reduction(samples);
+          }
+        };
+        stan::math::internal::run_chunks_concurrent(num_params(),
+                                                    execute_chunk, 0);
+        return values;
+      }
     };
 
   }
@@ -0,0 +1,395 @@
+#ifndef STAN_MCMC_CONVERGENCE_MONITOR_HPP
+#define STAN_MCMC_CONVERGENCE_MONITOR_HPP
+
+#include <stan/math/prim/mat.hpp>
+#include <unsupported/Eigen/FFT>
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * A <code>convergence_monitor</code> estimates the effective
+     * sample size and the split potential scale reduction (split R
+     * hat) of every parameter while chains are running, and records
+     * when every parameter has reached a target effective sample
+     * size.
+     *
+     * Draws are added one at a time per chain with
+     * <code>add_draw()</code>.  Running means and variances are kept
+     * for every chain and parameter.  Every <code>check_interval</code>
+     * draws, once every chain has that many draws, the estimates are
+     * recomputed from the first draws of each chain.  The estimators
+     * are those of <code>chains::effective_sample_size()</code> and
+     * <code>chains::split_potential_scale_reduction()</code>.  The
+     * autocovariances of a parameter are computed with one forward
+     * FFT per chain and a single inverse FFT of the summed power
+     * spectra, with one FFT engine reused for all parameters.
+     *
+     * Only <code>lp__</code> and the columns whose names do not end in
+     * <code>__</code> are monitored, so the sampler diagnostics are
+     * ignored.
+     *
+     * <p><b>Synchronization</b>: all methods may be called
+     * concurrently from the threads of different chains.  The chain
+     * completing an interval recomputes the estimates, outside the
+     * lock guarding the draws, from a copy of the draws it takes under
+     * the lock.  Chains completing an interval while the estimates are
+     * being recomputed leave it to that chain, which then recomputes
+     * them again for the latest interval, so no chain waits for an
+     * estimate.
+     */
+    class convergence_monitor {
+    public:
+      /**
+       * Construct a monitor for the specified number of chains.
+       *
+       * @param[in] num_chains number of chains
+       * @param[in] target_ess effective sample size every parameter
+       *   must reach
+       * @param[in] check_interval number of draws per chain between
+       *   estimates
+       * @throw std::domain_error if an argument is not positive
+       */
+      convergence_monitor(size_t num_chains, double target_ess,
+                          size_t check_interval = 100)
+        : num_chains_(num_chains), target_ess_(target_ess),
+          check_interval_(check_interval),
+          pending_(num_chains), count_(num_chains, 0),
+          mean_(num_chains), m2_(num_chains),
+          mean_snapshot_(num_chains), var_snapshot_(num_chains),
+          num_ready_(0), num_checked_(0), target_reached_(false),
+          estimating_(false), draws_(num_chains), num_copied_(0) {
+        static const char* function = "stan::mcmc::convergence_monitor";
+        math::check_positive(function, "Number of chains",
+                             static_cast<int>(num_chains));
+        math::check_positive(function, "Target effective sample size",
+                             target_ess);
+        math::check_positive(function, "Check interval",
+                             static_cast<int>(check_interval));
+      }
+
+      /**
+       * Set the column names of the draws and select the monitored
+       * columns.  Only the first call has an effect, so every chain
+       * may pass on its header.
+       *
+       * @param[in] names column names
+       */
+      void set_names(const std::vector<std::string>& names) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!columns_.empty() || names.empty())
+          return;
+        for (size_t i = 0; i < names.size(); ++i) {
+          const std::string& name = names[i];
+          bool is_diagnostic = name.size() >= 2
+            && name.compare(name.size() - 2, 2, "__") == 0;
+          if (name == "lp__" || !is_diagnostic) {
+            columns_.push_back(i);
+            names_.push_back(name);
+          }
+        }
+        const size_t P = columns_.size();
+        for (size_t c = 0; c < num_chains_; ++c) {
+          pending_[c].assign(P, std::vector<double>());
+          draws_[c].assign(P, std::vector<double>());
+          mean_[c].assign(P, 0.0);
+          m2_[c].assign(P, 0.0);
+        }
+        ess_.assign(P, 0.0);
+        rhat_.assign(P, std::numeric_limits<double>::quiet_NaN());
+      }
+
+      /**
+       * Add a draw of the specified chain and recompute the estimates
+       * if every chain has reached the next multiple of the check
+       * interval and no other chain is recomputing them.  Draws are
+       * ignored until the names are set.
+       *
+       * @param[in] chain index of the chain
+       * @param[in] draw values of all columns
+       */
+      void add_draw(size_t chain, const std::vector<double>& draw) {
+        {
+          std::lock_guard<std::mutex> lock(mutex_);
+          if (columns_.empty())
+            return;
+          const size_t n = ++count_[chain];
+          for (size_t p = 0; p < columns_.size(); ++p) {
+            double x = draw[columns_[p]];
+            pending_[chain][p].push_back(x);
+            double delta = x - mean_[chain][p];
+            mean_[chain][p] += delta / n;
+            m2_[chain][p] += delta * (x - mean_[chain][p]);
+          }
+          if (n % check_interval_ == 0) {
+            mean_snapshot_[chain].push_back(mean_[chain]);
+            var_snapshot_[chain].resize(mean_snapshot_[chain].size());
+            std::vector<double>& var = var_snapshot_[chain].back();
+            var.resize(columns_.size());
+            for (size_t p = 0; p < columns_.size(); ++p)
+              var[p] = m2_[chain][p] / (n - 1);
+          }
+          const size_t n_min
+            = *std::min_element(count_.begin(), count_.end());
+          if (n_min < num_ready_ + check_interval_)
+            return;
+          num_ready_ = n_min - n_min % check_interval_;
+          // split R hat needs two draws in each half of a chain
+          if (num_ready_ < 4 || estimating_)
+            return;
+          estimating_ = true;
+        }
+        estimate();
+      }
+
+      /**
+       * Return true if every monitored parameter reached the target
+       * effective sample size at the last estimate.
+       *
+       * @return true if the target was reached
+       */
+      bool target_reached() const {
+        return target_reached_;
+      }
+
+      /**
+       * Return the names of the monitored columns.
+       *
+       * @return names of the monitored columns
+       */
+      std::vector<std::string> names() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return names_;
+      }
+
+      /**
+       * Return the number of draws per chain used by the last
+       * estimate, or zero if there was none.
+       *
+       * @return number of draws per chain
+       */
+      size_t num_draws() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return num_checked_;
+      }
+
+      /**
+       * Return the effective sample sizes of the monitored columns at
+       * the last estimate.
+       *
+       * @return effective sample sizes
+       */
+      std::vector<double> ess() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ess_;
+      }
+
+      /**
+       * Return the split R hat of the monitored columns at the last
+       * estimate.
+       *
+       * @return split potential scale reductions
+       */
+      std::vector<double> rhat() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return rhat_;
+      }
+
+      /**
+       * Return the smallest effective sample size at the last
+       * estimate, or zero if there was none.
+       *
+       * @return minimum effective sample size
+       */
+      double min_ess() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (ess_.empty())
+          return 0;
+        return *std::min_element(ess_.begin(), ess_.end());
+      }
+
+      /**
+       * Return the largest split R hat at the last estimate, or NaN if
+       * there was none.
+       *
+       * @return maximum split potential scale reduction
+       */
+      double max_rhat() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (num_checked_ == 0)
+          return std::numeric_limits<double>::quiet_NaN();
+        return *std::max_element(rhat_.begin(), rhat_.end());
+      }
+
+    private:
+      /**
+       * Recompute the estimates from the first
+       * <code>num_ready_</code> draws of every chain, until they are
+       * up to date.  Only called by the chain which set
+       * <code>estimating_</code>, which is cleared on return.
+       */
+      void estimate() {
+        const size_t P = columns_.size();
+        std::vector<double> ess(P);
+        std::vector<double> rhat(P);
+        while (true) {
+          size_t n;
+          {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (num_ready_ == num_checked_) {
+              estimating_ = false;
+              return;
+            }
+            n = num_ready_;
+            copy_draws(n);
+          }
+          bool reached = true;
+          for (size_t p = 0; p < P; ++p) {
+            ess[p] = effective_sample_size(p, n);
+            rhat[p] = split_potential_scale_reduction(p, n);
+            if (!(ess[p] >= target_ess_))
+              reached = false;
+          }
+          std::lock_guard<std::mutex> lock(mutex_);
+          ess_.swap(ess);
+          rhat_.swap(rhat);
+          num_checked_ = n;
+          target_reached_ = reached;
+        }
+      }
+
+      /**
+       * Move the pending draws up to the first n of every chain to the
+       * draws used by the estimates, and copy the chain means and
+       * variances of the first n draws.  Called under the lock.
+       */
+      void copy_draws(size_t n) {
+        const size_t snapshot = n / check_interval_ - 1;
+        const size_t P = columns_.size();
+        const size_t num_new = n - num_copied_;
+        chain_mean_.resize(num_chains_, P);
+        chain_var_.resize(num_chains_, P);
+        for (size_t c = 0; c < num_chains_; ++c) {
+          for (size_t p = 0; p < P; ++p) {
+            std::vector<double>& pending = pending_[c][p];
+            draws_[c][p].insert(draws_[c][p].end(), pending.begin(),
+                                pending.begin() + num_new);
+            pending.erase(pending.begin(), pending.begin() + num_new);
+            chain_mean_(c, p) = mean_snapshot_[c][snapshot][p];
+            chain_var_(c, p) = var_snapshot_[c][snapshot][p];
+          }
+        }
+        num_copied_ = n;
+      }
+
+      /**
+       * Return the effective sample size of the specified column
+       * computed from the first n draws of every chain.
+       */
+      double effective_sample_size(size_t p, size_t n) {
+        const size_t M = math::fft_next_good_size(n);
+        const size_t Mt2 = 2 * M;
+        signal_.assign(Mt2, 0.0);
+        power_.assign(Mt2, 0.0);
+        Eigen::VectorXd chain_mean = chain_mean_.col(p);
+        Eigen::VectorXd chain_var = chain_var_.col(p);
+        for (size_t c = 0; c < num_chains_; ++c) {
+          const std::vector<double>& x = draws_[c][p];
+          for (size_t i = 0; i < n; ++i)
+            signal_[i] = x[i] - chain_mean(c);
+          fft_.fwd(freq_, signal_);
+          for (size_t i = 0; i < Mt2; ++i)
+            power_[i] += std::norm(freq_[i]);
+        }
+        for (size_t i = 0; i < Mt2; ++i)
+          freq_[i] = std::complex<double>(power_[i], 0.0);
+        fft_.inv(acov_sum_, freq_);
+
+        double mean_var = chain_var.mean();
+        double var_plus = mean_var * (n - 1) / n;
+        if (num_chains_ > 1)
+          var_plus += math::variance(chain_mean);
+        double rho_hat_sum = 0;
+        double rho_hat = 0;
+        size_t max_t = 0;
+        for (size_t t = 1; (t < n && rho_hat >= 0); ++t) {
+          double mean_acov_t = acov_sum_[t] / ((n - t) * num_chains_);
+          rho_hat = 1 - (mean_var - mean_acov_t) / var_plus;
+          if (rho_hat >= 0)
+            rho_hat_sum += rho_hat;
+          max_t = t;
+        }
+        double ess = num_chains_ * n;
+        if (max_t > 1)
+          ess /= 1 + 2 * rho_hat_sum;
+        return ess;
+      }
+
+      /**
+       * Return the split R hat of the specified column computed from
+       * the first n draws of every chain.
+       */
+      double split_potential_scale_reduction(size_t p, size_t n) const {
+        const size_t half = n / 2;
+        Eigen::VectorXd split_chain_mean(2 * num_chains_);
+        Eigen::VectorXd split_chain_var(2 * num_chains_);
+        for (size_t c = 0; c < num_chains_; ++c) {
+          const std::vector<double>& x = draws_[c][p];
+          for (size_t h = 0; h < 2; ++h) {
+            Eigen::Map<const Eigen::VectorXd> split(&x[h * (n - half)], half);
+            double split_mean = split.mean();
+            split_chain_mean(2 * c + h) = split_mean;
+            split_chain_var(2 * c + h)
+              = (split.array() - split_mean).square().sum() / (half - 1);
+          }
+        }
+        double var_between = half * math::variance(split_chain_mean);
+        double var_within = split_chain_var.mean();
+        return std::sqrt((var_between / var_within + half - 1) / half);
+      }
+
+      const size_t num_chains_;
+      const double target_ess_;
+      const size_t check_interval_;
+
+      // guarded by mutex_
+      std::vector<size_t> columns_;
+      std::vector<std::string> names_;
+      std::vector<std::vector<std::vector<double> > > pending_;
+      std::vector<size_t> count_;
+      std::vector<std::vector<double> > mean_;
+      std::vector<std::vector<double> > m2_;
+      std::vector<std::vector<std::vector<double> > > mean_snapshot_;
+      std::vector<std::vector<std::vector<double> > > var_snapshot_;
+      size_t num_ready_;
+      size_t num_checked_;
+      std::vector<double> ess_;
+      std::vector<double> rhat_;
+      std::atomic<bool> target_reached_;
+      bool estimating_;
+
+      // owned by the chain recomputing the estimates
+      std::vector<std::vector<std::vector<double> > > draws_;
+      size_t num_copied_;
+      Eigen::MatrixXd chain_mean_;
+      Eigen::MatrixXd chain_var_;
+      Eigen::FFT<double> fft_;
+      std::vector<double> signal_;
+      std::vector<double> power_;
+      std::vector<double> acov_sum_;
+      std::vector<std::complex<double> > freq_;
+
+      mutable std::mutex mutex_;
+    };
+
+  }
+}
+#endif
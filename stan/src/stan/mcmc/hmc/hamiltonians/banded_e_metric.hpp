@@ -0,0 +1,68 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_BANDED_E_METRIC_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_BANDED_E_METRIC_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/math/prim/mat.hpp>
+#include <stan/mcmc/hmc/hamiltonians/base_hamiltonian.hpp>
+#include <stan/mcmc/hmc/hamiltonians/banded_e_point.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/random/normal_distribution.hpp>
+
+namespace stan {
+  namespace mcmc {
+
+    // Euclidean manifold with banded metric; every operation is a
+    // banded triangular product or solve with the cached Cholesky
+    // factor L of the mass matrix
+    template <class Model, class BaseRNG>
+    class banded_e_metric
+      : public base_hamiltonian<Model, banded_e_point, BaseRNG> {
+    public:
+      explicit banded_e_metric(const Model& model)
+        : base_hamiltonian<Model, banded_e_point, BaseRNG>(model) {}
+
+      double T(banded_e_point& z) {
+        return 0.5 * z.chol_solve(z.p).squaredNorm();
+      }
+
+      double tau(banded_e_point& z) {
+        return T(z);
+      }
+
+      double phi(banded_e_point& z) {
+        return this->V(z);
+      }
+
+      double dG_dt(banded_e_point& z, callbacks::logger& logger) {
+        return 2 * T(z) - z.q.dot(z.g);
+      }
+
+      Eigen::VectorXd dtau_dq(banded_e_point& z, callbacks::logger& logger) {
+        return Eigen::VectorXd::Zero(this->model_.num_params_r());
+      }
+
+      Eigen::VectorXd dtau_dp(banded_e_point& z) {
+        return z.chol_transpose_solve(z.chol_solve(z.p));
+      }
+
+      Eigen::VectorXd dphi_dq(banded_e_point& z, callbacks::logger& logger) {
+        return z.g;
+      }
+
+      void sample_p(banded_e_point& z, BaseRNG& rng) {
+        typedef typename stan::math::index_type<Eigen::VectorXd>::type idx_t;
+        boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
+          rand_banded_gaus(rng, boost::normal_distribution<>());
+
+        Eigen::VectorXd u(z.p.size());
+
+        for (idx_t i = 0; i < u.size(); ++i)
+          u(i) = rand_banded_gaus();
+
+        z.p = z.chol_multiply(u);
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
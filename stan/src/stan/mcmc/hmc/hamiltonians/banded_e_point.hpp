@@ -0,0 +1,197 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_BANDED_E_POINT_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_BANDED_E_POINT_HPP
+
+#include <stan/callbacks/writer.hpp>
+#include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Point in a phase space with a base Euclidean manifold whose
+     * metric (mass matrix) is a symmetric band matrix, such as the
+     * precision matrix of a Markov random field.
+     *
+     * <p>The lower band of the mass matrix is stored by diagonals:
+     * element <code>(k, j)</code> of <code>e_metric_band_</code> is
+     * element <code>(j + k, j)</code> of the mass matrix, so the
+     * bandwidth is the number of rows less one.  The lower Cholesky
+     * factor of the mass matrix has the same band and is stored the
+     * same way in <code>e_metric_chol_</code>.
+     */
+    class banded_e_point: public ps_point {
+    public:
+      /**
+       * Lower band of mass matrix by diagonals.
+       */
+      Eigen::MatrixXd e_metric_band_;
+
+      /**
+       * Lower band of the Cholesky factor of the mass matrix by
+       * diagonals, recomputed by <code>update_metric()</code>.
+       */
+      Eigen::MatrixXd e_metric_chol_;
+
+      /**
+       * Construct a banded point in n-dimensional phase space
+       * with identity matrix as mass matrix.
+       *
+       * @param n number of dimensions
+       */
+      explicit banded_e_point(int n)
+        : ps_point(n), e_metric_band_(1, n), e_metric_chol_(1, n) {
+        e_metric_band_.setOnes();
+        e_metric_chol_.setOnes();
+      }
+
+      /**
+       * Copy constructor.
+       *
+       * @param z point to copy
+       */
+      banded_e_point(const banded_e_point& z)
+        : ps_point(z), e_metric_band_(z.e_metric_band_),
+          e_metric_chol_(z.e_metric_chol_) {
+      }
+
+      /**
+       * Return the bandwidth of the mass matrix.
+       *
+       * @return number of nonzero diagonals below the main diagonal
+       */
+      int bandwidth() const {
+        return e_metric_band_.rows() - 1;
+      }
+
+      /**
+       * Set the lower band of the mass matrix.
+       *
+       * @param e_metric_band lower band of mass matrix by diagonals
+       * @throw std::domain_error if the mass matrix is not positive
+       *   definite
+       */
+      void
+      set_metric(const Eigen::MatrixXd& e_metric_band) {
+        e_metric_band_ = e_metric_band;
+        update_metric();
+      }
+
+      /**
+       * Recompute the Cholesky factor of the mass matrix, in time
+       * linear in the number of dimensions.  Must be called whenever
+       * <code>e_metric_band_</code> is changed other than through
+       * <code>set_metric()</code>.
+       *
+       * @throw std::domain_error if the mass matrix is not positive
+       *   definite
+       */
+      void update_metric() {
+        const int n = e_metric_band_.cols();
+        const int b = bandwidth();
+        e_metric_chol_.resize(b + 1, n);
+        for (int j = 0; j < n; ++j) {
+          for (int i = j; i < std::min(n, j + b + 1); ++i) {
+            double sum = e_metric_band_(i - j, j);
+            for (int m = std::max(0, i - b); m < j; ++m)
+              sum -= e_metric_chol_(i - m, m) * e_metric_chol_(j - m, m);
+            if (i == j) {
+              if (!(sum > 0))
+                throw std::domain_error("banded_e_point: mass matrix is not"
+                                        " positive definite");
+              e_metric_chol_(0, j) = std::sqrt(sum);
+            } else {
+              e_metric_chol_(i - j, j) = sum / e_metric_chol_(0, j);
+            }
+          }
+          for (int k = n - j; k <= b; ++k)
+            e_metric_chol_(k, j) = 0;
+        }
+      }
+
+      /**
+       * Return the product of the lower Cholesky factor of the mass
+       * matrix and the specified vector.
+       *
+       * @param u vector
+       * @return <code>L u</code>
+       */
+      Eigen::VectorXd chol_multiply(const Eigen::VectorXd& u) const {
+        const int n = u.size();
+        const int b = bandwidth();
+        Eigen::VectorXd x(n);
+        for (int i = 0; i < n; ++i) {
+          double sum = 0;
+          for (int m = std::max(0, i - b); m <= i; ++m)
+            sum += e_metric_chol_(i - m, m) * u(m);
+          x(i) = sum;
+        }
+        return x;
+      }
+
+      /**
+       * Solve the lower triangular system of the Cholesky factor of
+       * the mass matrix.
+       *
+       * @param p right hand side
+       * @return <code>L^(-1) p</code>
+       */
+      Eigen::VectorXd chol_solve(const Eigen::VectorXd& p) const {
+        const int n = p.size();
+        const int b = bandwidth();
+        Eigen::VectorXd y(n);
+        for (int i = 0; i < n; ++i) {
+          double sum = p(i);
+          for (int m = std::max(0, i - b); m < i; ++m)
+            sum -= e_metric_chol_(i - m, m) * y(m);
+          y(i) = sum / e_metric_chol_(0, i);
+        }
+        return y;
+      }
+
+      /**
+       * Solve the upper triangular system of the transposed Cholesky
+       * factor of the mass matrix.
+       *
+       * @param y right hand side
+       * @return <code>L^(-T) y</code>
+       */
+      Eigen::VectorXd chol_transpose_solve(const Eigen::VectorXd& y) const {
+        const int n = y.size();
+        const int b = bandwidth();
+        Eigen::VectorXd x(n);
+        for (int i = n - 1; i >= 0; --i) {
+          double sum = y(i);
+          for (int k = 1; k <= b && i + k < n; ++k)
+            sum -= e_metric_chol_(k, i) * x(i + k);
+          x(i) = sum / e_metric_chol_(0, i);
+        }
+        return x;
+      }
+
+      /**
+       * Write elements of mass matrix to string and handoff to writer.
+       *
+       * @param writer Stan writer callback
+       */
+      inline
+      void
+      write_metric(stan::callbacks::writer& writer) {
+        writer("Diagonals of banded mass matrix:");
+        for (int k = 0; k < std::min(e_metric_band_.rows(),
+                                     e_metric_band_.cols()); ++k) {
+          std::stringstream e_metric_ss;
+          e_metric_ss << e_metric_band_(k, 0);
+          for (int j = 1; j < e_metric_band_.cols() - k; ++j)
+            e_metric_ss << ", " << e_metric_band_(k, j);
+          writer(e_metric_ss.str());
+        }
+      }
+    };
+
+  }  // mcmc
+}  // stan
+
+#endif
@@ -17,6 +17,12 @@ namespace stan {
        */
       Eigen::MatrixXd inv_e_metric_;
 
+      /**
+       * Lower Cholesky factor of the inverse mass matrix, recomputed
+       * by <code>update_metric()</code>.
+       */
+      Eigen::MatrixXd inv_e_metric_chol_;
+
       /**
        * Construct a dense point in n-dimensional phase space
        * with identity matrix as inverse mass matrix.
@@ -24,8 +30,9 @@ namespace stan {
        * @param n number of dimensions
        */
       explicit dense_e_point(int n)
-        : ps_point(n), inv_e_metric_(n, n) {
+        : ps_point(n), inv_e_metric_(n, n), inv_e_metric_chol_(n, n) {
         inv_e_metric_.setIdentity();
+        inv_e_metric_chol_.setIdentity();
       }
 
       /**
@@ -35,8 +42,11 @@ namespace stan {
        */
       dense_e_point(const dense_e_point& z)
         : ps_point(z), inv_e_metric_(z.inv_e_metric_.rows(),
-                                     z.inv_e_metric_.cols()) {
+                                     z.inv_e_metric_.cols()),
+          inv_e_metric_chol_(z.inv_e_metric_chol_.rows(),
+                             z.inv_e_metric_chol_.cols()) {
         fast_matrix_copy_<double>(inv_e_metric_, z.inv_e_metric_);
+        fast_matrix_copy_<double>(inv_e_metric_chol_, z.inv_e_metric_chol_);
       }
 
       /**
@@ -47,6 +57,16 @@ namespace stan {
       void
       set_metric(const Eigen::MatrixXd& inv_e_metric) {
         inv_e_metric_ = inv_e_metric;
+        update_metric();
+      }
+
+      /**
+       * Recompute the Cholesky factor of the inverse mass matrix.
+       * Must be called whenever <code>inv_e_metric_</code> is
+       * changed other than through <code>set_metric()</code>.
+       */
+      void update_metric() {
+        inv_e_metric_chol_ = inv_e_metric_.llt().matrixL();
       }
 
       /**
@@ -0,0 +1,82 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_LOW_RANK_E_METRIC_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_LOW_RANK_E_METRIC_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/math/prim/mat.hpp>
+#include <stan/mcmc/hmc/hamiltonians/base_hamiltonian.hpp>
+#include <stan/mcmc/hmc/hamiltonians/low_rank_e_point.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/random/normal_distribution.hpp>
+
+namespace stan {
+  namespace mcmc {
+
+    // Euclidean manifold with diagonal plus low rank metric; every
+    // operation is linear in the number of dimensions
+    template <class Model, class BaseRNG>
+    class low_rank_e_metric
+      : public base_hamiltonian<Model, low_rank_e_point, BaseRNG> {
+    public:
+      explicit low_rank_e_metric(const Model& model)
+        : base_hamiltonian<Model, low_rank_e_point, BaseRNG>(model) {}
+
+      double T(low_rank_e_point& z) {
+        return 0.5 * (z.p.dot(z.inv_e_metric_.cwiseProduct(z.p))
+                      + (z.inv_e_metric_low_rank_.transpose() * z.p)
+                        .squaredNorm());
+      }
+
+      double tau(low_rank_e_point& z) {
+        return T(z);
+      }
+
+      double phi(low_rank_e_point& z) {
+        return this->V(z);
+      }
+
+      double dG_dt(low_rank_e_point& z, callbacks::logger& logger) {
+        return 2 * T(z) - z.q.dot(z.g);
+      }
+
+      Eigen::VectorXd dtau_dq(low_rank_e_point& z,
+                              callbacks::logger& logger) {
+        return Eigen::VectorXd::Zero(this->model_.num_params_r());
+      }
+
+      Eigen::VectorXd dtau_dp(low_rank_e_point& z) {
+        return z.inv_e_metric_.cwiseProduct(z.p)
+          + z.inv_e_metric_low_rank_
+            * (z.inv_e_metric_low_rank_.transpose() * z.p);
+      }
+
+      Eigen::VectorXd dphi_dq(low_rank_e_point& z,
+                              callbacks::logger& logger) {
+        return z.g;
+      }
+
+      /**
+       * Draw the momentum from a normal distribution with the mass
+       * matrix as covariance.  With <code>D + U U^T = D^(1/2) (I + E
+       * Lambda E^T) D^(1/2)</code> the momentum is
+       * <code>D^(-1/2) (u + E ((1 + Lambda)^(-1/2) - I) E^T u)</code>
+       * for a standard normal <code>u</code>.
+       */
+      void sample_p(low_rank_e_point& z, BaseRNG& rng) {
+        typedef typename stan::math::index_type<Eigen::VectorXd>::type idx_t;
+        boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
+          rand_low_rank_gaus(rng, boost::normal_distribution<>());
+
+        Eigen::VectorXd u(z.p.size());
+
+        for (idx_t i = 0; i < u.size(); ++i)
+          u(i) = rand_low_rank_gaus();
+
+        u += z.low_rank_basis_
+          * z.low_rank_scale_.cwiseProduct(z.low_rank_basis_.transpose() * u);
+        z.p = u.cwiseQuotient(z.inv_e_metric_.cwiseSqrt());
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
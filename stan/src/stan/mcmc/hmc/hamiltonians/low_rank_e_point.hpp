@@ -0,0 +1,163 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_LOW_RANK_E_POINT_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_LOW_RANK_E_POINT_HPP
+
+#include <stan/callbacks/writer.hpp>
+#include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <Eigen/Eigenvalues>
+#include <cmath>
+#include <sstream>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Point in a phase space with a base Euclidean manifold whose
+     * inverse metric is a diagonal plus a low rank matrix,
+     * <code>diag(inv_e_metric_) + inv_e_metric_low_rank_
+     * * inv_e_metric_low_rank_^T</code>.
+     */
+    class low_rank_e_point: public ps_point {
+    public:
+      /**
+       * Vector of diagonal elements of inverse mass matrix.
+       */
+      Eigen::VectorXd inv_e_metric_;
+
+      /**
+       * Low rank factor of inverse mass matrix, one column per rank.
+       */
+      Eigen::MatrixXd inv_e_metric_low_rank_;
+
+      /**
+       * Orthonormal basis of the low rank part of the inverse mass
+       * matrix scaled by its diagonal, recomputed by
+       * <code>update_metric()</code>.
+       */
+      Eigen::MatrixXd low_rank_basis_;
+
+      /**
+       * Factors <code>1 / sqrt(1 + lambda) - 1</code> of the
+       * eigenvalues <code>lambda</code> of the scaled low rank part
+       * along <code>low_rank_basis_</code>, recomputed by
+       * <code>update_metric()</code>.
+       */
+      Eigen::VectorXd low_rank_scale_;
+
+      /**
+       * Construct a low rank point in n-dimensional phase space
+       * with identity matrix as inverse mass matrix.
+       *
+       * @param n number of dimensions
+       */
+      explicit low_rank_e_point(int n)
+        : ps_point(n), inv_e_metric_(n), inv_e_metric_low_rank_(n, 0),
+          low_rank_basis_(n, 0), low_rank_scale_(0) {
+        inv_e_metric_.setOnes();
+      }
+
+      /**
+       * Copy constructor.
+       *
+       * @param z point to copy
+       */
+      low_rank_e_point(const low_rank_e_point& z)
+        : ps_point(z), inv_e_metric_(z.inv_e_metric_),
+          inv_e_metric_low_rank_(z.inv_e_metric_low_rank_),
+          low_rank_basis_(z.low_rank_basis_),
+          low_rank_scale_(z.low_rank_scale_) {
+      }
+
+      /**
+       * Set the diagonal and the low rank factor of the inverse mass
+       * matrix.
+       *
+       * @param inv_e_metric diagonal of inverse mass matrix
+       * @param inv_e_metric_low_rank low rank factor of inverse mass
+       *   matrix, one column per rank
+       */
+      void
+      set_metric(const Eigen::VectorXd& inv_e_metric,
+                 const Eigen::MatrixXd& inv_e_metric_low_rank) {
+        inv_e_metric_ = inv_e_metric;
+        inv_e_metric_low_rank_ = inv_e_metric_low_rank;
+        update_metric();
+      }
+
+      /**
+       * Set the diagonal of the inverse mass matrix and drop its low
+       * rank part.
+       *
+       * @param inv_e_metric diagonal of inverse mass matrix
+       */
+      void
+      set_metric(const Eigen::VectorXd& inv_e_metric) {
+        set_metric(inv_e_metric,
+                   Eigen::MatrixXd(inv_e_metric.size(), 0));
+      }
+
+      /**
+       * Recompute the eigendecomposition of the scaled low rank part
+       * of the inverse mass matrix used to draw momenta.  Must be
+       * called whenever the inverse mass matrix is changed other than
+       * through <code>set_metric()</code>.
+       *
+       * <p>With <code>D = diag(inv_e_metric_)</code>,
+       * <code>U = inv_e_metric_low_rank_</code> and
+       * <code>V = D^(-1/2) U</code>, the eigenvectors of
+       * <code>V V^T</code> with nonzero eigenvalues are found from the
+       * small matrix <code>V^T V</code>, in time linear in the number
+       * of dimensions.
+       */
+      void update_metric() {
+        const int k = inv_e_metric_low_rank_.cols();
+        Eigen::MatrixXd V = inv_e_metric_.cwiseSqrt().cwiseInverse()
+          .asDiagonal() * inv_e_metric_low_rank_;
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd>
+          solver(V.transpose() * V);
+
+        // eigenvalues are in increasing order; drop the zero ones
+        double max_lambda = k > 0 ? solver.eigenvalues()(k - 1) : 0;
+        int rank = 0;
+        for (int i = 0; i < k; ++i)
+          if (solver.eigenvalues()(i) > 1e-12 * max_lambda)
+            ++rank;
+
+        low_rank_basis_.resize(inv_e_metric_.size(), rank);
+        low_rank_scale_.resize(rank);
+        for (int i = k - rank, j = 0; i < k; ++i, ++j) {
+          double lambda = solver.eigenvalues()(i);
+          low_rank_basis_.col(j)
+            = V * solver.eigenvectors().col(i) / std::sqrt(lambda);
+          low_rank_scale_(j) = 1 / std::sqrt(1 + lambda) - 1;
+        }
+      }
+
+      /**
+       * Write elements of mass matrix to string and handoff to writer.
+       *
+       * @param writer Stan writer callback
+       */
+      inline
+      void
+      write_metric(stan::callbacks::writer& writer) {
+        writer("Diagonal elements of inverse mass matrix:");
+        std::stringstream inv_e_metric_ss;
+        inv_e_metric_ss << inv_e_metric_(0);
+        for (int i = 1; i < inv_e_metric_.size(); ++i)
+          inv_e_metric_ss << ", " << inv_e_metric_(i);
+        writer(inv_e_metric_ss.str());
+
+        writer("Low rank factor columns of inverse mass matrix:");
+        for (int j = 0; j < inv_e_metric_low_rank_.cols(); ++j) {
+          std::stringstream low_rank_ss;
+          low_rank_ss << inv_e_metric_low_rank_(0, j);
+          for (int i = 1; i < inv_e_metric_low_rank_.rows(); ++i)
+            low_rank_ss << ", " << inv_e_metric_low_rank_(i, j);
+          writer(low_rank_ss.str());
+        }
+      }
+    };
+
+  }  // mcmc
+}  // stan
+
+#endif
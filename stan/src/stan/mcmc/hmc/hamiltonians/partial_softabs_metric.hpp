@@ -0,0 +1,416 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_PARTIAL_SOFTABS_METRIC_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_PARTIAL_SOFTABS_METRIC_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/math/mix/mat.hpp>
+#include <stan/mcmc/hmc/hamiltonians/base_hamiltonian.hpp>
+#include <stan/mcmc/hmc/hamiltonians/softabs_metric.hpp>
+#include <stan/mcmc/hmc/hamiltonians/partial_softabs_point.hpp>
+#include <boost/random/additive_combine.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+namespace stan {
+  namespace mcmc {
+
+    /**
+     * Riemannian manifold with a SoftAbs metric restricted to a fixed
+     * k-dimensional subspace with orthonormal basis U,
+     *
+     * <code>G(q) = c (I - U U^T) + U softabs(U^T H(q) U) U^T</code>,
+     *
+     * where H is the Hessian of the potential and c is a constant.
+     *
+     * <p>The projected Hessian is computed with k Hessian-vector
+     * products and only a k x k matrix is decomposed, so a metric
+     * update costs O(k) gradient evaluations rather than the full
+     * Hessian and O(d^3) eigendecomposition of
+     * <code>softabs_metric</code>.  The gradients of the projected
+     * Hessian, which take k (k + 1) / 2 third order sweeps, are
+     * computed once per position and reused by every fixed point
+     * iteration of the implicit leapfrog.  Everything else is
+     * O(d k^2).  With the identity as basis the metric is the
+     * SoftAbs metric.
+     *
+     * <p>The basis is found by <code>update_subspace()</code>, which
+     * runs the Lanczos algorithm with Hessian-vector products and
+     * keeps the Ritz vectors of largest magnitude eigenvalue.  After
+     * <code>set_subspace_rank()</code> it is recomputed at the next
+     * call to <code>init()</code>.  To preserve detailed balance it
+     * must only be updated during adaptation.
+     */
+    template <class Model, class BaseRNG>
+    class partial_softabs_metric
+      : public base_hamiltonian<Model, partial_softabs_point, BaseRNG> {
+    private:
+      typedef typename stan::math::index_type<Eigen::VectorXd>::type idx_t;
+      typedef softabs_metric<Model, BaseRNG> softabs_t;
+    public:
+      explicit partial_softabs_metric(const Model& model)
+        : base_hamiltonian<Model, partial_softabs_point, BaseRNG>(model),
+          subspace_rank_(-1) {}
+
+      double T(partial_softabs_point& z) {
+        return this->tau(z) + 0.5 * z.log_det_metric;
+      }
+
+      double tau(partial_softabs_point& z) {
+        Eigen::VectorXd Qp = z.eigenvectors.transpose() * z.p;
+        Eigen::VectorXd d = z.softabs_lambda_inv.array()
+          - 1.0 / z.complement_metric;
+        return 0.5 * (z.p.squaredNorm() / z.complement_metric
+                      + Qp.dot(d.cwiseProduct(Qp)));
+      }
+
+      double phi(partial_softabs_point& z) {
+        return this->V(z) + 0.5 * z.log_det_metric;
+      }
+
+      double dG_dt(partial_softabs_point& z, callbacks::logger& logger) {
+        return 2 * T(z)
+          - z.q.dot(dtau_dq(z, logger) + dphi_dq(z, logger));
+      }
+
+      Eigen::VectorXd dtau_dq(partial_softabs_point& z,
+                              callbacks::logger& logger) {
+        refresh(z, logger);
+        Eigen::VectorXd a = z.softabs_lambda_inv
+          .cwiseProduct(z.eigenvectors.transpose() * z.p);
+
+        const int k = a.size();
+        Eigen::VectorXd w(z.hessian_gradient.cols());
+        for (int l = 0, n = 0; l < k; ++l)
+          for (int j = 0; j <= l; ++j, ++n)
+            w(n) = (j == l ? 1 : 2) * a(j) * a(l) * z.pseudo_j(l, j);
+
+        return -0.5 * z.hessian_gradient * w;
+      }
+
+      Eigen::VectorXd dtau_dp(partial_softabs_point& z) {
+        Eigen::VectorXd d = z.softabs_lambda_inv.array()
+          - 1.0 / z.complement_metric;
+        return z.p / z.complement_metric
+          + z.eigenvectors
+            * d.cwiseProduct(z.eigenvectors.transpose() * z.p);
+      }
+
+      Eigen::VectorXd dphi_dq(partial_softabs_point& z,
+                              callbacks::logger& logger) {
+        refresh(z, logger);
+        const int k = z.softabs_lambda_inv.size();
+        Eigen::VectorXd w = Eigen::VectorXd::Zero(z.hessian_gradient.cols());
+        for (int l = 0; l < k; ++l)
+          w(l * (l + 1) / 2 + l) = z.softabs_lambda_inv(l) * z.pseudo_j(l, l);
+
+        return z.g + 0.5 * z.hessian_gradient * w;
+      }
+
+      void sample_p(partial_softabs_point& z, BaseRNG& rng) {
+        callbacks::logger logger;
+        update_pending_subspace(z, logger);
+        update_metric(z, logger);
+
+        boost::variate_generator<BaseRNG&, boost::normal_distribution<> >
+          rand_unit_gaus(rng, boost::normal_distribution<>());
+
+        Eigen::VectorXd u(z.p.size());
+
+        for (idx_t n = 0; n < z.p.size(); ++n)
+          u(n) = rand_unit_gaus();
+
+        double sqrt_c = std::sqrt(z.complement_metric);
+        Eigen::VectorXd d = z.softabs_lambda.cwiseSqrt().array() - sqrt_c;
+        z.p = sqrt_c * u
+          + z.eigenvectors * d.cwiseProduct(z.eigenvectors.transpose() * u);
+      }
+
+      void init(partial_softabs_point& z, callbacks::logger& logger) {
+        update_pending_subspace(z, logger);
+        update_metric(z, logger);
+        update_metric_gradient(z, logger);
+      }
+
+      void update_metric(partial_softabs_point& z,
+                         callbacks::logger& logger) {
+        if (z.metric_current())
+          return;
+        z.metric_gradient_valid = false;
+
+        this->update_potential_gradient(z, logger);
+
+        const int k = z.subspace.cols();
+        Eigen::MatrixXd HU = Eigen::MatrixXd::Zero(z.q.size(), k);
+        if (std::isfinite(z.V)) {
+          try {
+            double fx;
+            Eigen::VectorXd Hv;
+            for (int j = 0; j < k; ++j) {
+              math::hessian_times_vector(softabs_fun<Model>(this->model_, 0),
+                                         z.q,
+                                         Eigen::VectorXd(z.subspace.col(j)),
+                                         fx, Hv);
+              HU.col(j) = -Hv;
+            }
+          } catch (const std::exception& e) {
+            this->write_error_msg_(e, logger);
+            z.V = std::numeric_limits<double>::infinity();
+            HU.setZero();
+          }
+        }
+        Eigen::MatrixXd hessian = z.subspace.transpose() * HU;
+        z.hessian = 0.5 * (hessian + hessian.transpose());
+
+        // Eigendecompose the projected Hessian,
+        // then perform the SoftAbs transformation
+        z.softabs_lambda.resize(k);
+        z.softabs_lambda_inv.resize(k);
+        z.log_det_metric
+          = (z.q.size() - k) * std::log(z.complement_metric);
+        if (k > 0) {
+          z.eigen_deco.compute(z.hessian);
+          z.eigenvectors = z.subspace * z.eigen_deco.eigenvectors();
+          for (int i = 0; i < k; ++i) {
+            z.softabs_lambda(i)
+              = softabs(z.eigen_deco.eigenvalues()(i), z.alpha);
+            z.softabs_lambda_inv(i) = 1.0 / z.softabs_lambda(i);
+            z.log_det_metric += std::log(z.softabs_lambda(i));
+          }
+        } else {
+          z.eigenvectors.resize(z.q.size(), 0);
+        }
+
+        z.metric_q = z.q;
+      }
+
+      void update_metric_gradient(partial_softabs_point& z,
+                                  callbacks::logger& logger) {
+        if (z.metric_gradient_valid)
+          return;
+
+        const int k = z.softabs_lambda.size();
+
+        // Compute the pseudo-Jacobian of the SoftAbs transform
+        z.pseudo_j.resize(k, k);
+        for (int i = 0; i < k; ++i) {
+          for (int j = 0; j <= i; ++j) {
+            double delta =   z.eigen_deco.eigenvalues()(i)
+                           - z.eigen_deco.eigenvalues()(j);
+
+            if (std::fabs(delta) < softabs_t::jacobian_thresh) {
+              double lambda = z.eigen_deco.eigenvalues()(i);
+              double alpha_lambda = z.alpha * lambda;
+
+              if (std::fabs(alpha_lambda) < softabs_t::lower_softabs_thresh) {
+                z.pseudo_j(i, j) =   (2.0 / 3.0) * alpha_lambda
+                                   * (1.0 -   (2.0 / 15.0)
+                                            * alpha_lambda * alpha_lambda);
+              } else if (std::fabs(alpha_lambda)
+                         > softabs_t::upper_softabs_thresh) {
+                z.pseudo_j(i, j) = lambda > 0 ? 1 : -1;
+              } else {
+                double sdx = std::sinh(alpha_lambda) / lambda;
+                z.pseudo_j(i, j) = (z.softabs_lambda(i)
+                                    - z.alpha / (sdx * sdx) ) / lambda;
+              }
+            } else {
+              z.pseudo_j(i, j) = (z.softabs_lambda(i)
+                                  - z.softabs_lambda(j) ) / delta;
+            }
+          }
+        }
+
+        // Gradients of the projected Hessian in its eigenbasis
+        z.hessian_gradient.setZero(z.q.size(), k * (k + 1) / 2);
+        if (std::isfinite(z.V)) {
+          try {
+            for (int l = 0, n = 0; l < k; ++l)
+              for (int j = 0; j <= l; ++j, ++n)
+                z.hessian_gradient.col(n)
+                  = -grad_hessian_bilinear(z.q, z.eigenvectors.col(j),
+                                           z.eigenvectors.col(l));
+          } catch (const std::exception& e) {
+            this->write_error_msg_(e, logger);
+            z.V = std::numeric_limits<double>::infinity();
+            z.hessian_gradient.setZero();
+          }
+        }
+
+        z.metric_gradient_valid = true;
+      }
+
+      void update_gradients(partial_softabs_point& z,
+                            callbacks::logger& logger) {
+        update_metric_gradient(z, logger);
+      }
+
+      /**
+       * Request that the subspace be recomputed with the specified
+       * dimension at the next call to <code>init()</code>.
+       *
+       * @param rank dimension of the subspace
+       */
+      void set_subspace_rank(int rank) {
+        subspace_rank_ = rank;
+      }
+
+      /**
+       * Set the subspace to the span of the Ritz vectors of the
+       * Hessian at the current position with the largest magnitude
+       * Ritz values, found by the Lanczos algorithm with full
+       * reorthogonalization using <code>min(d, 2 k + 10)</code>
+       * Hessian-vector products, from a pseudo-random starting vector
+       * with a fixed seed.  The metric on the complement is set
+       * to the SoftAbs transform of the largest magnitude Ritz value
+       * that is not kept, so that the complement is no stiffer than
+       * its metric.
+       *
+       * <p>If the Hessian cannot be evaluated the subspace is left
+       * unchanged.
+       *
+       * @param z point
+       * @param rank dimension k of the subspace
+       * @param logger logger for messages
+       */
+      void update_subspace(partial_softabs_point& z, int rank,
+                           callbacks::logger& logger) {
+        const int n = z.q.size();
+        rank = std::max(0, std::min(rank, n));
+        const int m = std::min(n, 2 * rank + 10);
+
+        boost::ecuyer1988 rng(lanczos_seed);
+        boost::variate_generator<boost::ecuyer1988&,
+                                 boost::normal_distribution<> >
+          rand_unit_gaus(rng, boost::normal_distribution<>());
+
+        Eigen::MatrixXd Q(n, m);
+        Eigen::VectorXd alpha(m);
+        Eigen::VectorXd beta(m);
+        for (idx_t i = 0; i < n; ++i)
+          Q(i, 0) = rand_unit_gaus();
+        Q.col(0).normalize();
+
+        int steps = 0;
+        try {
+          double fx;
+          Eigen::VectorXd Hv;
+          for (int j = 0; j < m; ++j) {
+            math::hessian_times_vector(softabs_fun<Model>(this->model_, 0),
+                                       z.q, Eigen::VectorXd(Q.col(j)),
+                                       fx, Hv);
+            Eigen::VectorXd w = -Hv;
+            alpha(j) = Q.col(j).dot(w);
+            ++steps;
+            if (steps == m)
+              break;
+
+            for (int r = 0; r < 2; ++r)
+              w -= Q.leftCols(steps) * (Q.leftCols(steps).transpose() * w);
+            beta(j) = w.norm();
+            double scale
+              = std::max(1.0, alpha.head(steps).cwiseAbs().maxCoeff());
+            if (!(beta(j) > 1e-12 * scale))
+              break;
+            Q.col(j + 1) = w / beta(j);
+          }
+        } catch (const std::exception& e) {
+          this->write_error_msg_(e, logger);
+          return;
+        }
+
+        Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> ritz;
+        ritz.computeFromTridiagonal(alpha.head(steps),
+                                    beta.head(steps - 1));
+
+        std::vector<int> order(steps);
+        for (int i = 0; i < steps; ++i)
+          order[i] = i;
+        const Eigen::VectorXd& theta = ritz.eigenvalues();
+        std::sort(order.begin(), order.end(),
+                  [&theta](int i, int j) {
+                    return std::fabs(theta(i)) > std::fabs(theta(j));
+                  });
+
+        const int k = std::min(rank, steps);
+        Eigen::MatrixXd basis(n, k);
+        for (int j = 0; j < k; ++j)
+          basis.col(j) = Q.leftCols(steps) * ritz.eigenvectors().col(order[j]);
+
+        double complement = k < steps ? softabs(theta(order[k]), z.alpha)
+                                      : softabs(0, z.alpha);
+        z.set_subspace(basis, complement);
+      }
+
+      // Seed of the Lanczos starting vector
+      static unsigned int lanczos_seed;
+
+    private:
+      int subspace_rank_;
+
+      void update_pending_subspace(partial_softabs_point& z,
+                                   callbacks::logger& logger) {
+        if (subspace_rank_ < 0)
+          return;
+        update_subspace(z, subspace_rank_, logger);
+        subspace_rank_ = -1;
+      }
+
+      static double softabs(double lambda, double alpha) {
+        double alpha_lambda = alpha * lambda;
+
+        // Thresholds defined such that the approximation
+        // error is on the same order of double precision
+        if (std::fabs(alpha_lambda) < softabs_t::lower_softabs_thresh)
+          return (1.0 + (1.0 / 3.0) * alpha_lambda * alpha_lambda) / alpha;
+        else if (std::fabs(alpha_lambda) > softabs_t::upper_softabs_thresh)
+          return std::fabs(lambda);
+        else
+          return lambda / std::tanh(alpha_lambda);
+      }
+
+      void refresh(partial_softabs_point& z, callbacks::logger& logger) {
+        update_metric(z, logger);
+        update_metric_gradient(z, logger);
+      }
+
+      // Gradient of u^T * Hessian(log_prob) * v with respect to q
+      Eigen::VectorXd grad_hessian_bilinear(const Eigen::VectorXd& q,
+                                            const Eigen::VectorXd& u,
+                                            const Eigen::VectorXd& v) {
+        using stan::math::fvar;
+        using stan::math::var;
+        Eigen::VectorXd grad(q.size());
+        stan::math::start_nested();
+        try {
+          Eigen::Matrix<var, Eigen::Dynamic, 1> q_var(q.size());
+          Eigen::Matrix<fvar<var>, Eigen::Dynamic, 1> q_fvar(q.size());
+          for (idx_t i = 0; i < q.size(); ++i) {
+            q_var(i) = q(i);
+            q_fvar(i) = fvar<var>(q_var(i), u(i));
+          }
+          fvar<var> fx;
+          fvar<var> grad_fx_dot_v;
+          stan::math::gradient_dot_vector<fvar<var>, double>(
+            softabs_fun<Model>(this->model_, 0), q_fvar, v, fx,
+            grad_fx_dot_v);
+          stan::math::grad(grad_fx_dot_v.d_.vi_);
+          for (idx_t i = 0; i < q.size(); ++i)
+            grad(i) = q_var(i).adj();
+        } catch (const std::exception& e) {
+          stan::math::recover_memory_nested();
+          throw;
+        }
+        stan::math::recover_memory_nested();
+        return grad;
+      }
+    };
+
+    template <class Model, class BaseRNG>
+    unsigned int partial_softabs_metric<Model, BaseRNG>::lanczos_seed
+      = 20170725;
+  }  // mcmc
+}  // stan
+#endif
@@ -0,0 +1,125 @@
+#ifndef STAN_MCMC_HMC_HAMILTONIANS_PARTIAL_SOFTABS_POINT_HPP
+#define STAN_MCMC_HMC_HAMILTONIANS_PARTIAL_SOFTABS_POINT_HPP
+
+#include <stan/callbacks/writer.hpp>
+#include <stan/mcmc/hmc/hamiltonians/ps_point.hpp>
+#include <Eigen/Eigenvalues>
+#include <sstream>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * Point in a phase space with a base Riemannian manifold whose
+     * metric is the SoftAbs transform of the Hessian projected onto
+     * a fixed subspace, and a constant multiple of the identity on
+     * the complement of that subspace.
+     *
+     * <p>The metric and its gradient are cached along with the
+     * position they were computed at, so that they are only
+     * recomputed when the position changes.
+     */
+    class partial_softabs_point: public ps_point {
+    public:
+      explicit partial_softabs_point(int n):
+        ps_point(n),
+        alpha(1.0),
+        subspace(n, 0),
+        complement_metric(1.0),
+        hessian(0, 0),
+        eigen_deco(),
+        eigenvectors(n, 0),
+        log_det_metric(0),
+        softabs_lambda(0),
+        softabs_lambda_inv(0),
+        pseudo_j(0, 0),
+        hessian_gradient(n, 0),
+        metric_q(0),
+        metric_gradient_valid(false) {}
+
+      // SoftAbs regularization parameter
+      double alpha;
+
+      // Orthonormal basis of the subspace with SoftAbs metric
+      Eigen::MatrixXd subspace;
+
+      // Metric on the complement of the subspace
+      double complement_metric;
+
+      // Hessian projected onto the subspace
+      Eigen::MatrixXd hessian;
+
+      // Eigendecomposition of the projected Hessian
+      Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eigen_deco;
+
+      // Eigenvectors of the projected Hessian in the full space
+      Eigen::MatrixXd eigenvectors;
+
+      // Log determinant of metric
+      double log_det_metric;
+
+      // SoftAbs transformed eigenvalues of projected Hessian
+      Eigen::VectorXd softabs_lambda;
+      Eigen::VectorXd softabs_lambda_inv;
+
+      // Psuedo-Jacobian of the eigenvalues
+      Eigen::MatrixXd pseudo_j;
+
+      // Gradients of eigenvectors(j)^T * Hessian * eigenvectors(l),
+      // one column per pair j <= l in column major order
+      Eigen::MatrixXd hessian_gradient;
+
+      // Position at which the metric was computed
+      Eigen::VectorXd metric_q;
+
+      // True if the metric gradient is computed at metric_q
+      bool metric_gradient_valid;
+
+      /**
+       * Set the subspace with SoftAbs metric and the metric on its
+       * complement, and invalidate the cached metric.
+       *
+       * @param basis orthonormal basis of the subspace
+       * @param complement metric on the complement of the subspace
+       */
+      void set_subspace(const Eigen::MatrixXd& basis, double complement) {
+        subspace = basis;
+        complement_metric = complement;
+        invalidate_metric();
+      }
+
+      /**
+       * Return true if the cached metric was computed at the current
+       * position.
+       *
+       * @return true if the metric is current
+       */
+      bool metric_current() const {
+        return metric_q.size() == q.size() && metric_q == q;
+      }
+
+      void invalidate_metric() {
+        metric_q.resize(0);
+        metric_gradient_valid = false;
+      }
+
+      virtual inline void
+      write_metric(stan::callbacks::writer& writer) {
+        std::stringstream complement_ss;
+        complement_ss << "SoftAbs complement metric = " << complement_metric;
+        writer(complement_ss.str());
+
+        writer("SoftAbs subspace basis columns:");
+        for (int j = 0; j < subspace.cols(); ++j) {
+          std::stringstream subspace_ss;
+          subspace_ss << subspace(0, j);
+          for (int i = 1; i < subspace.rows(); ++i)
+            subspace_ss << ", " << subspace(i, j);
+          writer(subspace_ss.str());
+        }
+      }
+    };
+
+  }  // mcmc
+}  // stan
+
+#endif
@@ -0,0 +1,63 @@
+#ifndef STAN_MCMC_HMC_NUTS_ADAPT_BANDED_E_NUTS_HPP
+#define STAN_MCMC_HMC_NUTS_ADAPT_BANDED_E_NUTS_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/mcmc/stepsize_banded_adapter.hpp>
+#include <stan/mcmc/hmc/nuts/banded_e_nuts.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * The No-U-Turn sampler (NUTS) with multinomial sampling
+     * with a Gaussian-Euclidean disintegration and adaptive
+     * banded metric and adaptive step size
+     */
+    template <class Model, class BaseRNG>
+    class adapt_banded_e_nuts : public banded_e_nuts<Model, BaseRNG>,
+                                public stepsize_banded_adapter {
+    public:
+      /**
+       * @param model model
+       * @param rng random number generator
+       * @param bandwidth number of nonzero diagonals of the mass
+       *   matrix below the main diagonal
+       */
+      adapt_banded_e_nuts(const Model& model, BaseRNG& rng, int bandwidth)
+        : banded_e_nuts<Model, BaseRNG>(model, rng),
+        stepsize_banded_adapter(model.num_params_r(), bandwidth) {}
+
+      ~adapt_banded_e_nuts() {}
+
+      sample
+      transition(sample& init_sample, callbacks::logger& logger) {
+        sample s = banded_e_nuts<Model, BaseRNG>::transition(init_sample,
+                                                             logger);
+
+        if (this->adapt_flag_) {
+          this->stepsize_adaptation_.learn_stepsize(this->nom_epsilon_,
+                                                    s.accept_stat());
+
+          bool update = this->banded_adaptation_.learn_band(
+                                                this->z_.e_metric_band_,
+                                                this->z_.q);
+
+          if (update) {
+            this->z_.update_metric();
+            this->init_stepsize(logger);
+
+            this->stepsize_adaptation_.set_mu(log(10 * this->nom_epsilon_));
+            this->stepsize_adaptation_.restart();
+          }
+        }
+        return s;
+      }
+
+      void disengage_adaptation() {
+        base_adapter::disengage_adaptation();
+        this->stepsize_adaptation_.complete_adaptation(this->nom_epsilon_);
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -0,0 +1,63 @@
+#ifndef STAN_MCMC_HMC_NUTS_ADAPT_LOW_RANK_E_NUTS_HPP
+#define STAN_MCMC_HMC_NUTS_ADAPT_LOW_RANK_E_NUTS_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/mcmc/stepsize_low_rank_adapter.hpp>
+#include <stan/mcmc/hmc/nuts/low_rank_e_nuts.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * The No-U-Turn sampler (NUTS) with multinomial sampling
+     * with a Gaussian-Euclidean disintegration and adaptive
+     * diagonal plus low rank metric and adaptive step size
+     */
+    template <class Model, class BaseRNG>
+    class adapt_low_rank_e_nuts : public low_rank_e_nuts<Model, BaseRNG>,
+                                  public stepsize_low_rank_adapter {
+    public:
+      /**
+       * @param model model
+       * @param rng random number generator
+       * @param rank maximum rank of the low rank part of the metric
+       */
+      adapt_low_rank_e_nuts(const Model& model, BaseRNG& rng, int rank)
+        : low_rank_e_nuts<Model, BaseRNG>(model, rng),
+        stepsize_low_rank_adapter(model.num_params_r(), rank) {}
+
+      ~adapt_low_rank_e_nuts() {}
+
+      sample
+      transition(sample& init_sample, callbacks::logger& logger) {
+        sample s = low_rank_e_nuts<Model, BaseRNG>::transition(init_sample,
+                                                               logger);
+
+        if (this->adapt_flag_) {
+          this->stepsize_adaptation_.learn_stepsize(this->nom_epsilon_,
+                                                    s.accept_stat());
+
+          bool update = this->low_rank_adaptation_.learn_low_rank(
+                                          this->z_.inv_e_metric_,
+                                          this->z_.inv_e_metric_low_rank_,
+                                          this->z_.q);
+
+          if (update) {
+            this->z_.update_metric();
+            this->init_stepsize(logger);
+
+            this->stepsize_adaptation_.set_mu(log(10 * this->nom_epsilon_));
+            this->stepsize_adaptation_.restart();
+          }
+        }
+        return s;
+      }
+
+      void disengage_adaptation() {
+        base_adapter::disengage_adaptation();
+        this->stepsize_adaptation_.complete_adaptation(this->nom_epsilon_);
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
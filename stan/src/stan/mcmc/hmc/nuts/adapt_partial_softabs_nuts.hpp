@@ -0,0 +1,56 @@
+#ifndef STAN_MCMC_HMC_NUTS_ADAPT_PARTIAL_SOFTABS_NUTS_HPP
+#define STAN_MCMC_HMC_NUTS_ADAPT_PARTIAL_SOFTABS_NUTS_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/mcmc/hmc/nuts/partial_softabs_nuts.hpp>
+#include <stan/mcmc/stepsize_subspace_adapter.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * The No-U-Turn sampler (NUTS) with multinomial sampling
+     * with a Gaussian-Riemannian disintegration and SoftAbs metric
+     * on an adaptive subspace and adaptive step size
+     */
+    template <class Model, class BaseRNG>
+    class adapt_partial_softabs_nuts
+      : public partial_softabs_nuts<Model, BaseRNG>,
+        public stepsize_subspace_adapter {
+    public:
+      adapt_partial_softabs_nuts(const Model& model, BaseRNG& rng, int rank)
+        : partial_softabs_nuts<Model, BaseRNG>(model, rng, rank) {}
+
+      ~adapt_partial_softabs_nuts() {}
+
+      sample
+      transition(sample& init_sample, callbacks::logger& logger) {
+        sample s
+          = partial_softabs_nuts<Model, BaseRNG>::transition(init_sample,
+                                                             logger);
+
+        if (this->adapt_flag_) {
+          this->stepsize_adaptation_.learn_stepsize(this->nom_epsilon_,
+                                                    s.accept_stat());
+
+          bool update = this->subspace_adaptation_.learn_subspace();
+
+          if (update) {
+            this->hamiltonian_.set_subspace_rank(this->rank_);
+            this->init_stepsize(logger);
+
+            this->stepsize_adaptation_.set_mu(log(10 * this->nom_epsilon_));
+            this->stepsize_adaptation_.restart();
+          }
+        }
+        return s;
+      }
+
+      void disengage_adaptation() {
+        base_adapter::disengage_adaptation();
+        this->stepsize_adaptation_.complete_adaptation(this->nom_epsilon_);
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -0,0 +1,28 @@
+#ifndef STAN_MCMC_HMC_NUTS_BANDED_E_NUTS_HPP
+#define STAN_MCMC_HMC_NUTS_BANDED_E_NUTS_HPP
+
+#include <stan/mcmc/hmc/nuts/base_nuts.hpp>
+#include <stan/mcmc/hmc/hamiltonians/banded_e_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/banded_e_metric.hpp>
+#include <stan/mcmc/hmc/integrators/expl_leapfrog.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * The No-U-Turn sampler (NUTS) with multinomial sampling
+     * with a Gaussian-Euclidean disintegration and banded metric.
+     * The metric is set by the lower band of the mass matrix by
+     * diagonals, as stored by <code>banded_e_point</code>.
+     */
+    template <class Model, class BaseRNG>
+    class banded_e_nuts : public base_nuts<Model, banded_e_metric,
+                                           expl_leapfrog, BaseRNG> {
+    public:
+      banded_e_nuts(const Model& model, BaseRNG& rng)
+        : base_nuts<Model, banded_e_metric, expl_leapfrog,
+                    BaseRNG>(model, rng) { }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
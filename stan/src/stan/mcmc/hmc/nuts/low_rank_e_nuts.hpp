@@ -0,0 +1,32 @@
+#ifndef STAN_MCMC_HMC_NUTS_LOW_RANK_E_NUTS_HPP
+#define STAN_MCMC_HMC_NUTS_LOW_RANK_E_NUTS_HPP
+
+#include <stan/mcmc/hmc/nuts/base_nuts.hpp>
+#include <stan/mcmc/hmc/hamiltonians/low_rank_e_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/low_rank_e_metric.hpp>
+#include <stan/mcmc/hmc/integrators/expl_leapfrog.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * The No-U-Turn sampler (NUTS) with multinomial sampling
+     * with a Gaussian-Euclidean disintegration and diagonal plus
+     * low rank metric
+     */
+    template <class Model, class BaseRNG>
+    class low_rank_e_nuts : public base_nuts<Model, low_rank_e_metric,
+                                             expl_leapfrog, BaseRNG> {
+    public:
+      low_rank_e_nuts(const Model& model, BaseRNG& rng)
+        : base_nuts<Model, low_rank_e_metric, expl_leapfrog,
+                    BaseRNG>(model, rng) { }
+
+      void set_metric(const Eigen::VectorXd& inv_e_metric,
+                      const Eigen::MatrixXd& inv_e_metric_low_rank) {
+        this->z_.set_metric(inv_e_metric, inv_e_metric_low_rank);
+      }
+    };
+
+  }  // mcmc
+}  // stan
+#endif
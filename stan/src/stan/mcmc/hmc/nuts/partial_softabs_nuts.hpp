@@ -0,0 +1,42 @@
+#ifndef STAN_MCMC_HMC_NUTS_PARTIAL_SOFTABS_NUTS_HPP
+#define STAN_MCMC_HMC_NUTS_PARTIAL_SOFTABS_NUTS_HPP
+
+#include <stan/mcmc/hmc/nuts/base_nuts.hpp>
+#include <stan/mcmc/hmc/hamiltonians/partial_softabs_point.hpp>
+#include <stan/mcmc/hmc/hamiltonians/partial_softabs_metric.hpp>
+#include <stan/mcmc/hmc/integrators/impl_leapfrog.hpp>
+
+namespace stan {
+  namespace mcmc {
+    /**
+     * The No-U-Turn sampler (NUTS) with multinomial sampling
+     * with a Gaussian-Riemannian disintegration and SoftAbs metric
+     * on a subspace.  The subspace is computed at the initial
+     * position.
+     */
+    template <class Model, class BaseRNG>
+    class partial_softabs_nuts
+      : public base_nuts<Model, partial_softabs_metric,
+                         impl_leapfrog, BaseRNG> {
+    public:
+      /**
+       * @param model model
+       * @param rng random number generator
+       * @param rank dimension of the subspace with SoftAbs metric
+       */
+      partial_softabs_nuts(const Model& model, BaseRNG& rng, int rank)
+        : base_nuts<Model, partial_softabs_metric, impl_leapfrog,
+                    BaseRNG>(model, rng),
+          rank_(rank) {
+        this->hamiltonian_.set_subspace_rank(rank_);
+      }
+
+      int get_rank() { return rank_; }
+
+    protected:
+      int rank_;
+    };
+
+  }  // mcmc
+}  // stan
+#endif
@@ -38,6 +38,7 @@ namespace stan {
             (this->z_.inv_e_metric_, this->z_.q);
 
           if (update) {
+            this->z_.update_metric();
             this->init_stepsize(logger);
             this->update_L_();
 
@@ -0,0 +1,116 @@
+#ifndef STAN_MCMC_LOW_RANK_ADAPTATION_HPP
+#define STAN_MCMC_LOW_RANK_ADAPTATION_HPP
+
+#include <stan/math/prim/mat.hpp>
+#include <stan/mcmc/windowed_adaptation.hpp>
+#include <Eigen/SVD>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace stan {
+
+  namespace mcmc {
+
+    /**
+     * Windowed adaptation of a diagonal plus low rank inverse metric.
+     *
+     * <p>At the end of each window the diagonal is set to the sample
+     * variances.  The draws are then scaled by their standard
+     * deviations, and the principal directions of the scaled draws
+     * whose variance exceeds one contribute to the low rank part, up
+     * to the specified rank, so that the inverse metric has the
+     * sample covariance along them.  The result is regularized toward
+     * a small multiple of the identity as in
+     * <code>covar_adaptation</code>.  The cost is linear in the
+     * number of dimensions for a fixed window size and rank.
+     */
+    class low_rank_adaptation: public windowed_adaptation {
+    public:
+      /**
+       * Construct a low rank adaptation.
+       *
+       * @param n number of dimensions
+       * @param rank maximum rank of the low rank part
+       */
+      low_rank_adaptation(int n, int rank)
+        : windowed_adaptation("low rank covariance"), n_(n), rank_(rank) {}
+
+      /**
+       * Add a draw of an adaptation window, and at the end of a
+       * window update the diagonal and the low rank factor of the
+       * inverse metric.
+       *
+       * @param[in,out] inv_metric diagonal of inverse metric
+       * @param[in,out] inv_metric_low_rank low rank factor of inverse
+       *   metric, one column per rank
+       * @param[in] q draw
+       * @return true if the inverse metric was updated
+       */
+      bool learn_low_rank(Eigen::VectorXd& inv_metric,
+                          Eigen::MatrixXd& inv_metric_low_rank,
+                          const Eigen::VectorXd& q) {
+        if (adaptation_window())
+          draws_.push_back(q);
+
+        if (end_adaptation_window()) {
+          compute_next_window();
+
+          estimate(inv_metric, inv_metric_low_rank);
+          draws_.clear();
+
+          ++adapt_window_counter_;
+          return true;
+        }
+
+        ++adapt_window_counter_;
+        return false;
+      }
+
+    protected:
+      void estimate(Eigen::VectorXd& inv_metric,
+                    Eigen::MatrixXd& inv_metric_low_rank) const {
+        const int N = draws_.size();
+        Eigen::MatrixXd centered(n_, N);
+        for (int i = 0; i < N; ++i)
+          centered.col(i) = draws_[i];
+        Eigen::VectorXd mean = centered.rowwise().mean();
+        centered.colwise() -= mean;
+
+        Eigen::VectorXd var = Eigen::VectorXd::Zero(n_);
+        int rank = 0;
+        Eigen::MatrixXd low_rank(n_, 0);
+        if (N > 1) {
+          var = centered.rowwise().squaredNorm() / (N - 1.0);
+          Eigen::VectorXd sd = var.cwiseSqrt();
+          for (int d = 0; d < n_; ++d)
+            if (sd(d) > 0)
+              centered.row(d) /= sd(d);
+          centered /= std::sqrt(N - 1.0);
+
+          Eigen::BDCSVD<Eigen::MatrixXd> svd(centered, Eigen::ComputeThinU);
+          const Eigen::VectorXd& s = svd.singularValues();
+          while (rank < std::min(rank_, static_cast<int>(s.size()))
+                 && s(rank) > 1)
+            ++rank;
+          low_rank = sd.asDiagonal() * svd.matrixU().leftCols(rank);
+          for (int j = 0; j < rank; ++j)
+            low_rank.col(j) *= std::sqrt(s(j) * s(j) - 1);
+        }
+
+        double n = static_cast<double>(N);
+        inv_metric = (n / (n + 5.0)) * var
+          + 1e-3 * (5.0 / (n + 5.0)) * Eigen::VectorXd::Ones(n_);
+        inv_metric_low_rank = std::sqrt(n / (n + 5.0)) * low_rank;
+      }
+
+      int n_;
+      int rank_;
+      std::vector<Eigen::VectorXd> draws_;
+    };
+
+  }  // mcmc
+
+}  // stan
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef STAN_MCMC_STEPSIZE_BANDED_ADAPTER_HPP
+#define STAN_MCMC_STEPSIZE_BANDED_ADAPTER_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/mcmc/base_adapter.hpp>
+#include <stan/mcmc/stepsize_adaptation.hpp>
+#include <stan/mcmc/banded_adaptation.hpp>
+
+namespace stan {
+
+  namespace mcmc {
+
+    class stepsize_banded_adapter: public base_adapter {
+    public:
+      stepsize_banded_adapter(int n, int bandwidth)
+        : banded_adaptation_(n, bandwidth) {
+      }
+
+      stepsize_adaptation& get_stepsize_adaptation() {
+        return stepsize_adaptation_;
+      }
+
+      banded_adaptation& get_banded_adaptation() {
+        return banded_adaptation_;
+      }
+
+      void set_window_params(unsigned int num_warmup,
+                             unsigned int init_buffer,
+                             unsigned int term_buffer,
+                             unsigned int base_window,
+                             callbacks::logger& logger) {
+        banded_adaptation_.set_window_params(num_warmup,
+                                             init_buffer,
+                                             term_buffer,
+                                             base_window,
+                                             logger);
+      }
+
+    protected:
+      stepsize_adaptation stepsize_adaptation_;
+      banded_adaptation banded_adaptation_;
+    };
+
+  }  // mcmc
+
+}  // stan
+
+#endif
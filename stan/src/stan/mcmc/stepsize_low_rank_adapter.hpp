@@ -0,0 +1,48 @@
+#ifndef STAN_MCMC_STEPSIZE_LOW_RANK_ADAPTER_HPP
+#define STAN_MCMC_STEPSIZE_LOW_RANK_ADAPTER_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/mcmc/base_adapter.hpp>
+#include <stan/mcmc/stepsize_adaptation.hpp>
+#include <stan/mcmc/low_rank_adaptation.hpp>
+
+namespace stan {
+
+  namespace mcmc {
+
+    class stepsize_low_rank_adapter: public base_adapter {
+    public:
+      stepsize_low_rank_adapter(int n, int rank)
+        : low_rank_adaptation_(n, rank) {
+      }
+
+      stepsize_adaptation& get_stepsize_adaptation() {
+        return stepsize_adaptation_;
+      }
+
+      low_rank_adaptation& get_low_rank_adaptation() {
+        return low_rank_adaptation_;
+      }
+
+      void set_window_params(unsigned int num_warmup,
+                             unsigned int init_buffer,
+                             unsigned int term_buffer,
+                             unsigned int base_window,
+                             callbacks::logger& logger) {
+        low_rank_adaptation_.set_window_params(num_warmup,
+                                               init_buffer,
+                                               term_buffer,
+                                               base_window,
+                                               logger);
+      }
+
+    protected:
+      stepsize_adaptation stepsize_adaptation_;
+      low_rank_adaptation low_rank_adaptation_;
+    };
+
+  }  // mcmc
+
+}  // stan
+
+#endif
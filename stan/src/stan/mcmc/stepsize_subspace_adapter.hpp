@@ -0,0 +1,46 @@
+#ifndef STAN_MCMC_STEPSIZE_SUBSPACE_ADAPTER_HPP
+#define STAN_MCMC_STEPSIZE_SUBSPACE_ADAPTER_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/mcmc/base_adapter.hpp>
+#include <stan/mcmc/stepsize_adaptation.hpp>
+#include <stan/mcmc/subspace_adaptation.hpp>
+
+namespace stan {
+
+  namespace mcmc {
+
+    class stepsize_subspace_adapter: public base_adapter {
+    public:
+      stepsize_subspace_adapter() {}
+
+      stepsize_adaptation& get_stepsize_adaptation() {
+        return stepsize_adaptation_;
+      }
+
+      subspace_adaptation& get_subspace_adaptation() {
+        return subspace_adaptation_;
+      }
+
+      void set_window_params(unsigned int num_warmup,
+                             unsigned int init_buffer,
+                             unsigned int term_buffer,
+                             unsigned int base_window,
+                             callbacks::logger& logger) {
+        subspace_adaptation_.set_window_params(num_warmup,
+                                               init_buffer,
+                                               term_buffer,
+                                               base_window,
+                                               logger);
+      }
+
+    protected:
+      stepsize_adaptation stepsize_adaptation_;
+      subspace_adaptation subspace_adaptation_;
+    };
+
+  }  // mcmc
+
+}  // stan
+
+#endif
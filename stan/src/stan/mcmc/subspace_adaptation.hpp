@@ -0,0 +1,43 @@
+#ifndef STAN_MCMC_SUBSPACE_ADAPTATION_HPP
+#define STAN_MCMC_SUBSPACE_ADAPTATION_HPP
+
+#include <stan/mcmc/windowed_adaptation.hpp>
+
+namespace stan {
+
+  namespace mcmc {
+
+    /**
+     * Windowed adaptation of the subspace of a partial SoftAbs
+     * metric.  No statistics of the draws are accumulated; the
+     * subspace is recomputed from the Hessian at the position
+     * reached at the end of each adaptation window.
+     */
+    class subspace_adaptation: public windowed_adaptation {
+    public:
+      subspace_adaptation()
+        : windowed_adaptation("SoftAbs subspace") {}
+
+      /**
+       * Advance the adaptation schedule by one draw.
+       *
+       * @return true if an adaptation window has ended and the
+       *   subspace should be recomputed
+       */
+      bool learn_subspace() {
+        if (end_adaptation_window()) {
+          compute_next_window();
+          ++adapt_window_counter_;
+          return true;
+        }
+
+        ++adapt_window_counter_;
+        return false;
+      }
+    };
+
+  }  // mcmc
+
+}  // stan
+
+#endif
@@ -0,0 +1,276 @@
+#ifndef STAN_MODEL_COMPILED_TAPE_MODEL_HPP
+#define STAN_MODEL_COMPILED_TAPE_MODEL_HPP
+
+#include <stan/io/var_context.hpp>
+#include <stan/math/rev/mat.hpp>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace stan {
+  namespace model {
+
+    /**
+     * <code>compiled_tape_model</code> evaluates the gradient of a
+     * model's log density by replaying a compiled tape of
+     * <code>log_prob()</code> rather than running it again.
+     *
+     * The first gradient evaluation records <code>log_prob()</code>
+     * into a <code>stan::math::compiled_tape</code>.  Later
+     * evaluations, as in <code>log_prob_grad()</code>,
+     * <code>gradient()</code> and the samplers, replay the tape for
+     * the new parameters without running the model's code or
+     * allocating variables.  If the replay fails because a comparison
+     * of parameters changes its outcome, as when an <code>if</code>
+     * statement takes the other branch, or because the log density
+     * or its gradient is not finite, <code>log_prob()</code> is
+     * recorded again at the new parameters, which also raises any
+     * error it throws.
+     *
+     * Replay is switched off for good if the model uses operations
+     * which cannot be replayed, such as vectorized densities or
+     * matrix functions, and all evaluations then run
+     * <code>log_prob()</code> as the model does.  As a safety check
+     * against control flow which the recording cannot see, every
+     * <code>check_interval</code>-th replay is compared with a fresh
+     * recording at the same parameters, and replay is switched off if
+     * they disagree.
+     *
+     * Evaluations with <code>double</code> parameters and all other
+     * members are those of the model.  The compiled tapes are state
+     * of the object, so a <code>compiled_tape_model</code> must not
+     * be used by concurrent chains.
+     *
+     * @tparam M Class of model.
+     */
+    template <class M>
+    class compiled_tape_model : public M {
+    public:
+      /**
+       * Construct the model from the specified data.
+       *
+       * @param[in] context Data.
+       * @param[in,out] msgs Stream for messages from the model.
+       * @param[in] check_interval Number of replays between checks
+       * against a fresh recording, or 0 for no checks.
+       */
+      compiled_tape_model(stan::io::var_context& context,
+                          std::ostream* msgs = 0,
+                          int check_interval = 100)
+        : M(context, msgs), check_interval_(check_interval),
+          num_replays_(0), num_recordings_(0) {
+      }
+
+      /**
+       * Construct the model from the specified data and seed.
+       *
+       * @param[in] context Data.
+       * @param[in] random_seed Seed for the model's transformed data.
+       * @param[in,out] msgs Stream for messages from the model.
+       * @param[in] check_interval Number of replays between checks
+       * against a fresh recording, or 0 for no checks.
+       */
+      compiled_tape_model(stan::io::var_context& context,
+                          unsigned int random_seed,
+                          std::ostream* msgs = 0,
+                          int check_interval = 100)
+        : M(context, random_seed, msgs), check_interval_(check_interval),
+          num_replays_(0), num_recordings_(0) {
+      }
+
+      /**
+       * Return the log density.
+       *
+       * @tparam propto True if calculation is up to proportion
+       * (double-only terms dropped).
+       * @tparam jacobian_adjust_transform True if the log absolute
+       * Jacobian determinant of inverse parameter transforms is added
+       * to the log probability.
+       * @tparam T Type of parameters; only <code>stan::math::var</code>
+       * gradients are replayed, other types call the model's
+       * <code>log_prob()</code>.
+       * @param[in] params_r Real-valued parameters.
+       * @param[in] params_i Integer-valued parameters.
+       * @param[in,out] msgs Stream for messages from the model.
+       * @return log density
+       */
+      template <bool propto, bool jacobian_adjust_transform, typename T>
+      T log_prob(std::vector<T>& params_r, std::vector<int>& params_i,
+                 std::ostream* msgs = 0) const {
+        return log_prob_impl<propto, jacobian_adjust_transform>(params_r,
+                                                                params_i,
+                                                                msgs);
+      }
+
+      /**
+       * Return the log density.
+       *
+       * @tparam propto True if calculation is up to proportion
+       * (double-only terms dropped).
+       * @tparam jacobian_adjust_transform True if the log absolute
+       * Jacobian determinant of inverse parameter transforms is added
+       * to the log probability.
+       * @tparam T Type of parameters; only <code>stan::math::var</code>
+       * gradients are replayed, other types call the model's
+       * <code>log_prob()</code>.
+       * @param[in] params_r Real-valued parameters.
+       * @param[in,out] msgs Stream for messages from the model.
+       * @return log density
+       */
+      template <bool propto, bool jacobian_adjust_transform, typename T>
+      T log_prob(Eigen::Matrix<T, Eigen::Dynamic, 1>& params_r,
+                 std::ostream* msgs = 0) const {
+        std::vector<T> params_r_vec(params_r.data(),
+                                    params_r.data() + params_r.size());
+        std::vector<int> params_i;
+        return log_prob_impl<propto, jacobian_adjust_transform>(params_r_vec,
+                                                                params_i,
+                                                                msgs);
+      }
+
+      /**
+       * Return true if gradients of the log density with the
+       * specified template arguments are evaluated by replay.
+       *
+       * @tparam propto True if calculation is up to proportion.
+       * @tparam jacobian_adjust_transform True if the Jacobian is
+       * included.
+       * @return true unless replay has been switched off
+       */
+      template <bool propto, bool jacobian_adjust_transform>
+      bool replay_enabled() const {
+        return !tape<propto, jacobian_adjust_transform>().disabled_;
+      }
+
+      /**
+       * Return the number of gradients evaluated by replay.
+       *
+       * @return number of replays
+       */
+      size_t num_replays() const {
+        return num_replays_;
+      }
+
+      /**
+       * Return the number of gradients evaluated by running
+       * <code>log_prob()</code>, including recordings.
+       *
+       * @return number of recordings
+       */
+      size_t num_recordings() const {
+        return num_recordings_;
+      }
+
+    private:
+      struct tape_state {
+        tape_state() : disabled_(false), since_check_(0) { }
+        stan::math::compiled_tape tape_;
+        bool disabled_;
+        int since_check_;
+      };
+
+      template <bool propto, bool jacobian_adjust_transform>
+      struct log_prob_functor {
+        const M& model_;
+        std::vector<int>& params_i_;
+        std::ostream* msgs_;
+
+        log_prob_functor(const M& model, std::vector<int>& params_i,
+                         std::ostream* msgs)
+          : model_(model), params_i_(params_i), msgs_(msgs) { }
+
+        stan::math::var
+        operator()(const Eigen::Matrix<stan::math::var, Eigen::Dynamic, 1>&
+                   params_r) const {
+          std::vector<stan::math::var> params_r_vec(params_r.data(),
+                                                    params_r.data()
+                                                    + params_r.size());
+          return model_.template log_prob<propto,
+                                          jacobian_adjust_transform>(
+              params_r_vec, params_i_, msgs_);
+        }
+      };
+
+      int check_interval_;
+      mutable tape_state tapes_[4];
+      mutable size_t num_replays_;
+      mutable size_t num_recordings_;
+
+      template <bool propto, bool jacobian_adjust_transform>
+      tape_state& tape() const {
+        return tapes_[2 * propto + jacobian_adjust_transform];
+      }
+
+      template <bool propto, bool jacobian_adjust_transform, typename T>
+      T log_prob_impl(std::vector<T>& params_r, std::vector<int>& params_i,
+                      std::ostream* msgs) const {
+        return M::template log_prob<propto, jacobian_adjust_transform>(
+            params_r, params_i, msgs);
+      }
+
+      template <bool propto, bool jacobian_adjust_transform>
+      double log_prob_impl(std::vector<double>& params_r,
+                           std::vector<int>& params_i,
+                           std::ostream* msgs) const {
+        return M::template log_prob<propto, jacobian_adjust_transform>(
+            params_r, params_i, msgs);
+      }
+
+      template <bool propto, bool jacobian_adjust_transform>
+      stan::math::var log_prob_impl(std::vector<stan::math::var>& params_r,
+                                    std::vector<int>& params_i,
+                                    std::ostream* msgs) const {
+        Eigen::VectorXd x(params_r.size());
+        for (size_t n = 0; n < params_r.size(); ++n)
+          x(n) = params_r[n].val();
+        double lp;
+        Eigen::VectorXd grad;
+        log_prob_grad_impl<propto, jacobian_adjust_transform>(
+            x, params_i, lp, grad, msgs);
+        std::vector<double> gradient(grad.data(), grad.data() + grad.size());
+        return stan::math::precomputed_gradients(lp, params_r, gradient);
+      }
+
+      template <bool propto, bool jacobian_adjust_transform>
+      void log_prob_grad_impl(const Eigen::VectorXd& x,
+                              std::vector<int>& params_i,
+                              double& lp, Eigen::VectorXd& grad,
+                              std::ostream* msgs) const {
+        tape_state& s = tape<propto, jacobian_adjust_transform>();
+        log_prob_functor<propto, jacobian_adjust_transform>
+          f(*this, params_i, msgs);
+        if (s.disabled_) {
+          ++num_recordings_;
+          stan::math::gradient(f, x, lp, grad);
+          return;
+        }
+        if (s.tape_.replay(x, lp, grad)) {
+          ++num_replays_;
+          if (check_interval_ <= 0 || ++s.since_check_ < check_interval_)
+            return;
+          s.since_check_ = 0;
+          double lp_replay = lp;
+          Eigen::VectorXd grad_replay = grad;
+          ++num_recordings_;
+          s.tape_.record(f, x, lp, grad);
+          bool agree = same(lp, lp_replay);
+          for (int n = 0; n < grad.size(); ++n)
+            agree = agree && same(grad(n), grad_replay(n));
+          if (!agree || !s.tape_.compiled())
+            s.disabled_ = true;
+          return;
+        }
+        ++num_recordings_;
+        if (!s.tape_.record(f, x, lp, grad))
+          s.disabled_ = true;
+      }
+
+      static bool same(double a, double b) {
+        return std::fabs(a - b)
+          <= 1e-8 * (1 + std::fmax(std::fabs(a), std::fabs(b)));
+      }
+    };
+
+  }
+}
+#endif
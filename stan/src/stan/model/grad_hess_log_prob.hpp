@@ -1,18 +1,144 @@
 #ifndef STAN_MODEL_GRAD_HESS_LOG_PROB_HPP
 #define STAN_MODEL_GRAD_HESS_LOG_PROB_HPP
 
+#include <stan/math/mix/mat.hpp>
+#include <stan/math/prim/arr/functor/run_chunks_concurrent.hpp>
+#include <stan/model/has_fvar_var_log_prob.hpp>
 #include <stan/model/log_prob_grad.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 #include <iostream>
 #include <vector>
 
 namespace stan {
   namespace model {
 
+    namespace internal {
+
+      /**
+       * Compute the Hessian exactly with forward-over-reverse
+       * automatic differentiation: row d of the Hessian is the
+       * reverse-mode gradient of the directional derivative of the
+       * log-probability along the d-th unit vector.
+       */
+      template <bool propto, bool jacobian_adjust_transform, class M>
+      double grad_hess_log_prob(const M& model, std::vector<double>& params_r,
+                                std::vector<int>& params_i,
+                                std::vector<double>& gradient,
+                                std::vector<double>& hessian,
+                                std::ostream* msgs,
+                                boost::true_type /* fvar_var_log_prob */) {
+        using stan::math::fvar;
+        using stan::math::var;
+        const int D = params_r.size();
+        if (D == 0) {
+          hessian.clear();
+          return log_prob_grad<propto, jacobian_adjust_transform>(model,
+                                                                  params_r,
+                                                                  params_i,
+                                                                  gradient,
+                                                                  msgs);
+        }
+        gradient.assign(D, 0);
+        hessian.assign(D * D, 0);
+        double result = 0;
+
+        auto execute_block = [&](int start, int size, std::ostream* out) {
+          const int end = start + size;
+          for (int d = start; d != end; ++d) {
+            stan::math::start_nested();
+            try {
+              std::vector<fvar<var> > ad_params_r(D);
+              for (int i = 0; i < D; ++i)
+                ad_params_r[i] = fvar<var>(params_r[i], i == d);
+              fvar<var> lp
+                = model.template log_prob<propto, jacobian_adjust_transform>
+                (ad_params_r, params_i, d == 0 ? out : 0);
+              if (d == 0)
+                result = lp.val_.val();
+              gradient[d] = lp.d_.val();
+              stan::math::grad(lp.d_.vi_);
+              double* row = &hessian[d * D];
+              for (int i = 0; i < D; ++i)
+                row[i] = ad_params_r[i].val_.adj();
+            } catch (const std::exception& e) {
+              stan::math::recover_memory_nested();
+              throw;
+            }
+            stan::math::recover_memory_nested();
+          }
+        };
+
+        stan::math::internal::run_chunks_concurrent(D, execute_block, msgs);
+        return result;
+      }
+
+      /**
+       * Compute the Hessian numerically by finite-differencing the
+       * gradient, for models whose log-probability cannot be
+       * instantiated with fvar<var> arguments.
+       */
+      template <bool propto, bool jacobian_adjust_transform, class M>
+      double grad_hess_log_prob(const M& model, std::vector<double>& params_r,
+                                std::vector<int>& params_i,
+                                std::vector<double>& gradient,
+                                std::vector<double>& hessian,
+                                std::ostream* msgs,
+                                boost::false_type /* fvar_var_log_prob */) {
+        static const double epsilon = 1e-3;
+        static const double half_inv_epsilon = 0.5 / epsilon;
+        static const int order = 4;
+        static const double perturbations[order]
+          = {-2*epsilon, -1*epsilon, epsilon, 2*epsilon};
+        static const double coefficients[order]
+          = { 1.0 / 12.0, -2.0 / 3.0, 2.0 / 3.0, -1.0 / 12.0 };
+
+        double result
+          = log_prob_grad<propto, jacobian_adjust_transform>(model, params_r,
+                                                             params_i,
+                                                             gradient, msgs);
+        hessian.assign(params_r.size() * params_r.size(), 0);
+        std::vector<double> temp_grad(params_r.size());
+        std::vector<double> perturbed_params(params_r.begin(), params_r.end());
+        for (size_t d = 0; d < params_r.size(); ++d) {
+          double* row = &hessian[d*params_r.size()];
+          for (int i = 0; i < order; ++i) {
+            perturbed_params[d] = params_r[d] + perturbations[i];
+            log_prob_grad<propto, jacobian_adjust_transform>(model,
+                                                             perturbed_params,
+                                                             params_i,
+                                                             temp_grad);
+            for (size_t dd = 0; dd < params_r.size(); ++dd) {
+              double increment
+                = half_inv_epsilon * coefficients[i] * temp_grad[dd];
+              row[dd] += increment;
+              hessian[d + dd*params_r.size()] += increment;
+            }
+          }
+          perturbed_params[d] = params_r[d];
+        }
+        return result;
+      }
+
+    }
+
     /**
      * Evaluate the log-probability, its gradient, and its Hessian
-     * at params_r. This default version computes the Hessian
-     * numerically by finite-differencing the gradient, at a cost of
-     * O(params_r.size()^2).
+     * at params_r.
+     *
+     * If the model's log-probability can be instantiated with
+     * fvar<var> arguments (see <code>has_fvar_var_log_prob</code>),
+     * the Hessian is computed exactly with forward-over-reverse
+     * automatic differentiation, at a cost of params_r.size()
+     * evaluations of the log-probability with fvar<var> arguments.
+     * The rows are split into consecutive blocks which are evaluated
+     * on up to <code>STAN_NUM_THREADS</code> threads when Stan is
+     * compiled with <code>STAN_THREADS</code>. Print statements are
+     * only written for the evaluation of the first row.
+     *
+     * Otherwise, as for models calling the ODE integrators, the
+     * algebraic solver or <code>map_rect</code>, the Hessian is
+     * computed numerically by finite-differencing the gradient, at a
+     * cost of 4 * params_r.size() gradient evaluations.
      *
      * @tparam propto True if calculation is up to proportion
      * (double-only terms dropped).
@@ -36,37 +162,9 @@ namespace stan {
                               std::vector<double>& gradient,
                               std::vector<double>& hessian,
                               std::ostream* msgs = 0) {
-      static const double epsilon = 1e-3;
-      static const double half_epsilon = 0.5 * epsilon;
-      static const int order = 4;
-      static const double perturbations[order]
-        = {-2*epsilon, -1*epsilon, epsilon, 2*epsilon};
-      static const double coefficients[order]
-        = { 1.0 / 12.0, -2.0 / 3.0, 2.0 / 3.0, -1.0 / 12.0 };
-
-      double result
-        = log_prob_grad<propto, jacobian_adjust_transform>(model, params_r,
-                                                           params_i, gradient,
-                                                           msgs);
-      hessian.assign(params_r.size() * params_r.size(), 0);
-      std::vector<double> temp_grad(params_r.size());
-      std::vector<double> perturbed_params(params_r.begin(), params_r.end());
-      for (size_t d = 0; d < params_r.size(); ++d) {
-        double* row = &hessian[d*params_r.size()];
-        for (int i = 0; i < order; ++i) {
-          perturbed_params[d] = params_r[d] + perturbations[i];
-          log_prob_grad<propto, jacobian_adjust_transform>(model,
-                                                           perturbed_params,
-                                                           params_i, temp_grad);
-          for (size_t dd = 0; dd < params_r.size(); ++dd) {
-            double increment = half_epsilon * coefficients[i] * temp_grad[dd];
-            row[dd] += increment;
-            hessian[d + dd*params_r.size()] += increment;
-          }
-        }
-        perturbed_params[d] = params_r[d];
-      }
-      return result;
+      return internal::grad_hess_log_prob<propto, jacobian_adjust_transform>
+        (model, params_r, params_i, gradient, hessian, msgs,
+         boost::integral_constant<bool, has_fvar_var_log_prob<M>::value>());
     }
 
   }
@@ -0,0 +1,37 @@
+#ifndef STAN_MODEL_HAS_FVAR_VAR_LOG_PROB_HPP
+#define STAN_MODEL_HAS_FVAR_VAR_LOG_PROB_HPP
+
+#include <boost/utility/enable_if.hpp>
+
+namespace stan {
+  namespace model {
+
+    /**
+     * Metaprogram whose <code>value</code> is true if the
+     * <code>log_prob</code> method of the specified model can be
+     * instantiated with <code>fvar&lt;var&gt;</code> arguments, so
+     * that exact Hessians can be computed with forward-over-reverse
+     * autodiff.
+     *
+     * <p>This is the case unless the model declares the static
+     * member <code>fvar_var_log_prob</code> to be false, as models
+     * generated from programs which call a higher-order function
+     * (the ODE integrators, the algebraic solver or
+     * <code>map_rect</code>) in their log density do.
+     *
+     * @tparam M class of model
+     */
+    template <class M, typename Enable = void>
+    struct has_fvar_var_log_prob {
+      enum { value = true };
+    };
+
+    template <class M>
+    struct has_fvar_var_log_prob
+    <M, typename boost::disable_if_c<M::fvar_var_log_prob>::type> {
+      enum { value = false };
+    };
+
+  }
+}
+#endif
@@ -1,13 +1,68 @@
 #ifndef STAN_MODEL_HESSIAN_TIMES_VECTOR_HPP
 #define STAN_MODEL_HESSIAN_TIMES_VECTOR_HPP
 
+#include <stan/model/has_fvar_var_log_prob.hpp>
 #include <stan/model/model_functional.hpp>
 #include <stan/math/mix/mat.hpp>
+#include <boost/type_traits/integral_constant.hpp>
 #include <ostream>
 
 namespace stan {
   namespace model {
 
+    namespace internal {
+
+      template <class F>
+      void hessian_times_vector(const F& f,
+                                const Eigen::Matrix<double, Eigen::Dynamic, 1>&
+                                x,
+                                const Eigen::Matrix<double, Eigen::Dynamic, 1>&
+                                v,
+                                double& fx,
+                                Eigen::Matrix<double, Eigen::Dynamic, 1>&
+                                hess_f_dot_v,
+                                boost::true_type /* fvar_var_log_prob */) {
+        stan::math::hessian_times_vector(f, x, v, fx, hess_f_dot_v);
+      }
+
+      /**
+       * Approximate the product by finite-differencing the gradient
+       * along v, for models whose log density cannot be instantiated
+       * with fvar<var> arguments.  The stencil includes x itself, so
+       * the log density is taken from the gradient evaluated there.
+       */
+      template <class F>
+      void hessian_times_vector(const F& f,
+                                const Eigen::Matrix<double, Eigen::Dynamic, 1>&
+                                x,
+                                const Eigen::Matrix<double, Eigen::Dynamic, 1>&
+                                v,
+                                double& fx,
+                                Eigen::Matrix<double, Eigen::Dynamic, 1>&
+                                hess_f_dot_v,
+                                boost::false_type /* fvar_var_log_prob */) {
+        static const double epsilon = 1e-3;
+        static const int order = 4;
+        static const double perturbations[order]
+          = {-1*epsilon, 0, epsilon, 2*epsilon};
+        static const double coefficients[order]
+          = { -1.0 / 3.0, -1.0 / 2.0, 1.0, -1.0 / 6.0 };
+
+        Eigen::Matrix<double, Eigen::Dynamic, 1> grad_f;
+        hess_f_dot_v.setZero(x.size());
+        double f_perturbed;
+        for (int i = 0; i < order; ++i) {
+          Eigen::Matrix<double, Eigen::Dynamic, 1> x_perturbed
+            = x + perturbations[i] * v;
+          stan::math::gradient(f, x_perturbed, f_perturbed, grad_f);
+          if (perturbations[i] == 0)
+            fx = f_perturbed;
+          hess_f_dot_v += (coefficients[i] / epsilon) * grad_f;
+        }
+      }
+
+    }
+
     template <class M>
     void hessian_times_vector(const M& model,
                               const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
@@ -16,8 +71,46 @@ namespace stan {
                               Eigen::Matrix<double, Eigen::Dynamic, 1>&
                               hess_f_dot_v,
                               std::ostream* msgs = 0) {
-      stan::math::hessian_times_vector(model_functional<M>(model, msgs),
-                                       x, v, f, hess_f_dot_v);
+      internal::hessian_times_vector(model_functional<M>(model, msgs),
+                                     x, v, f, hess_f_dot_v,
+                                     boost::integral_constant
+                                     <bool, has_fvar_var_log_prob<M>::value>());
+    }
+
+    /**
+     * Compute the log density and the product of its Hessian with
+     * the specified vector in one forward-over-reverse sweep, or by
+     * finite-differencing the gradient along the vector if the
+     * model's log density cannot be instantiated with fvar<var>
+     * arguments (see <code>has_fvar_var_log_prob</code>).
+     *
+     * @tparam propto True if calculation is up to proportion
+     * (double-only terms dropped).
+     * @tparam jacobian_adjust_transform True if the log absolute
+     * Jacobian determinant of inverse parameter transforms is added to
+     * the log probability.
+     * @tparam M Class of model.
+     * @param[in] model Model.
+     * @param[in] x Unconstrained parameters.
+     * @param[in] v Vector to multiply the Hessian with.
+     * @param[out] f Log density at x.
+     * @param[out] hess_f_dot_v Hessian of the log density at x times v.
+     * @param[in, out] msgs Stream to which print statements in Stan
+     * programs are written, default is 0
+     */
+    template <bool propto, bool jacobian_adjust_transform, class M>
+    void hessian_times_vector(const M& model,
+                              const Eigen::Matrix<double, Eigen::Dynamic, 1>& x,
+                              const Eigen::Matrix<double, Eigen::Dynamic, 1>& v,
+                              double& f,
+                              Eigen::Matrix<double, Eigen::Dynamic, 1>&
+                              hess_f_dot_v,
+                              std::ostream* msgs = 0) {
+      internal::hessian_times_vector(model_functional<M, propto,
+                                     jacobian_adjust_transform>(model, msgs),
+                                     x, v, f, hess_f_dot_v,
+                                     boost::integral_constant
+                                     <bool, has_fvar_var_log_prob<M>::value>());
     }
 
   }
@@ -0,0 +1,75 @@
+#ifndef STAN_MODEL_MPI_COMMUNICATOR_HPP
+#define STAN_MODEL_MPI_COMMUNICATOR_HPP
+
+#ifdef STAN_MPI
+
+#include <stan/model/shard_communicator.hpp>
+#include <mpi.h>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+  namespace model {
+
+    /**
+     * <code>mpi_communicator</code> is a
+     * <code>shard_communicator</code> over an MPI communicator, by
+     * default <code>MPI_COMM_WORLD</code>.
+     *
+     * MPI must have been initialized before construction and must be
+     * finalized by the caller.  Only available when Stan is compiled
+     * with <code>STAN_MPI</code>.
+     */
+    class mpi_communicator : public shard_communicator {
+    public:
+      /**
+       * Construct a communicator over the specified MPI communicator.
+       *
+       * @param[in] comm MPI communicator
+       */
+      explicit mpi_communicator(MPI_Comm comm = MPI_COMM_WORLD)
+        : comm_(comm) {
+        MPI_Comm_rank(comm_, &rank_);
+        MPI_Comm_size(comm_, &size_);
+      }
+
+      int rank() const {
+        return rank_;
+      }
+
+      int size() const {
+        return size_;
+      }
+
+      void send(int to, const std::vector<double>& buf) {
+        double* data = const_cast<double*>(buf.empty() ? 0 : &buf[0]);
+        if (MPI_Send(data, static_cast<int>(buf.size()), MPI_DOUBLE, to,
+                     TAG, comm_) != MPI_SUCCESS)
+          throw std::runtime_error("mpi_communicator: MPI_Send failed");
+      }
+
+      bool recv(int from, std::vector<double>& buf) {
+        MPI_Status status;
+        int n = 0;
+        if (MPI_Probe(from, TAG, comm_, &status) != MPI_SUCCESS
+            || MPI_Get_count(&status, MPI_DOUBLE, &n) != MPI_SUCCESS)
+          throw std::runtime_error("mpi_communicator: MPI_Probe failed");
+        buf.resize(n);
+        if (MPI_Recv(buf.empty() ? 0 : &buf[0], n, MPI_DOUBLE, from, TAG,
+                     comm_, MPI_STATUS_IGNORE) != MPI_SUCCESS)
+          throw std::runtime_error("mpi_communicator: MPI_Recv failed");
+        return true;
+      }
+
+    private:
+      static const int TAG = 2017;
+      MPI_Comm comm_;
+      int rank_;
+      int size_;
+    };
+
+  }
+}
+
+#endif
+#endif
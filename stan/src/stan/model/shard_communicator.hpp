@@ -0,0 +1,62 @@
+#ifndef STAN_MODEL_SHARD_COMMUNICATOR_HPP
+#define STAN_MODEL_SHARD_COMMUNICATOR_HPP
+
+#include <vector>
+
+namespace stan {
+  namespace model {
+
+    /**
+     * <code>shard_communicator</code> is the base class for the
+     * transports connecting the processes evaluating the shards of a
+     * <code>sharded_model</code>.
+     *
+     * Processes are identified by their rank, with rank 0 driving
+     * the algorithm and ranks <code>1, ..., size() - 1</code> serving
+     * shards.  Only messages between rank 0 and the other ranks are
+     * required.  Messages are vectors of doubles, delivered in order
+     * between every pair of ranks.
+     */
+    class shard_communicator {
+    public:
+      virtual ~shard_communicator() { }
+
+      /**
+       * Return the rank of this process.
+       *
+       * @return rank of this process
+       */
+      virtual int rank() const = 0;
+
+      /**
+       * Return the number of processes.
+       *
+       * @return number of processes
+       */
+      virtual int size() const = 0;
+
+      /**
+       * Send the specified message to the process of the specified
+       * rank.
+       *
+       * @param[in] to rank of receiving process
+       * @param[in] buf message
+       * @throw std::runtime_error if the message could not be sent
+       */
+      virtual void send(int to, const std::vector<double>& buf) = 0;
+
+      /**
+       * Receive the next message from the process of the specified
+       * rank, blocking until it arrives.
+       *
+       * @param[in] from rank of sending process
+       * @param[out] buf message
+       * @return false if the sending process closed its connection
+       * @throw std::runtime_error if the message could not be received
+       */
+      virtual bool recv(int from, std::vector<double>& buf) = 0;
+    };
+
+  }
+}
+#endif
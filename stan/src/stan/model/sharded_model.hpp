@@ -0,0 +1,421 @@
+#ifndef STAN_MODEL_SHARDED_MODEL_HPP
+#define STAN_MODEL_SHARDED_MODEL_HPP
+
+#include <stan/io/var_context.hpp>
+#include <stan/math/rev/mat.hpp>
+#include <stan/model/log_prob_grad.hpp>
+#include <stan/model/shard_communicator.hpp>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace model {
+
+    /**
+     * Commands sent from rank 0 to the shards; the first element of
+     * every request.
+     */
+    enum shard_command {
+      SHARD_STOP = 0,
+      SHARD_LOG_PROB = 1,
+      SHARD_LOG_PROB_GRAD = 2
+    };
+
+    /**
+     * Status returned by the shards; the first element of every
+     * reply.
+     */
+    enum shard_status {
+      SHARD_OK = 0,
+      SHARD_DOMAIN_ERROR = 1,
+      SHARD_ERROR = 2
+    };
+
+    /**
+     * Return a shard reply carrying the specified status and message.
+     *
+     * @param[in] status shard status
+     * @param[in] msg error message
+     * @return reply
+     */
+    inline std::vector<double> shard_error_reply(shard_status status,
+                                                 const std::string& msg) {
+      std::vector<double> reply(1, status);
+      reply.insert(reply.end(), msg.begin(), msg.end());
+      return reply;
+    }
+
+    /**
+     * Serve log density evaluations of the specified shard to rank 0
+     * of the specified communicator until rank 0 sends
+     * <code>SHARD_STOP</code> or closes its connection.
+     *
+     * Every request carries the command, the <code>propto</code> flag
+     * and the unconstrained parameters; the reply carries the status,
+     * the log density and, for <code>SHARD_LOG_PROB_GRAD</code>, its
+     * gradient.  Shards never include the Jacobian of the parameter
+     * transforms, which is added on rank 0 only.  Exceptions are
+     * returned to rank 0 with their message rather than thrown.
+     *
+     * @tparam M Class of model.
+     * @param[in] model Model holding this rank's slice of the data.
+     * @param[in,out] comm Communicator, with rank other than 0.
+     * @param[in,out] msgs Stream for messages from the model.
+     */
+    template <class M>
+    void serve_shard(const M& model, shard_communicator& comm,
+                     std::ostream* msgs = 0) {
+      std::vector<double> request;
+      std::vector<double> reply;
+      std::vector<double> params_r;
+      std::vector<int> params_i;
+      std::vector<double> gradient;
+      while (comm.recv(0, request)) {
+        if (request.size() < 2 || request[0] == SHARD_STOP)
+          return;
+        bool with_gradient = request[0] == SHARD_LOG_PROB_GRAD;
+        bool propto = request[1] != 0;
+        params_r.assign(request.begin() + 2, request.end());
+        try {
+          double lp;
+          if (with_gradient)
+            lp = propto
+              ? log_prob_grad<true, false>(model, params_r, params_i,
+                                           gradient, msgs)
+              : log_prob_grad<false, false>(model, params_r, params_i,
+                                            gradient, msgs);
+          else
+            lp = propto
+              ? model.template log_prob<true, false>(params_r, params_i,
+                                                     msgs)
+              : model.template log_prob<false, false>(params_r, params_i,
+                                                      msgs);
+          reply.assign(1, SHARD_OK);
+          reply.push_back(lp);
+          if (with_gradient)
+            reply.insert(reply.end(), gradient.begin(), gradient.end());
+        } catch (const std::domain_error& e) {
+          reply = shard_error_reply(SHARD_DOMAIN_ERROR, e.what());
+        } catch (const std::exception& e) {
+          reply = shard_error_reply(SHARD_ERROR, e.what());
+        }
+        comm.send(0, reply);
+      }
+    }
+
+    /**
+     * <code>sharded_model</code> evaluates the log density of a model
+     * whose data is split into shards held by separate processes.
+     *
+     * Rank 0 constructs the <code>sharded_model</code> from its own
+     * slice of the data, while every other rank constructs the plain
+     * model from its slice and calls <code>serve_shard()</code>.
+     * Each log density evaluation then ships only the parameters to
+     * the shards and only the value and gradient back, and sums them
+     * with the value and gradient of rank 0's slice.
+     *
+     * The shards must partition the likelihood: terms which should
+     * be counted once, such as priors, have to be switched on by the
+     * data of exactly one shard.  The Jacobian of the parameter
+     * transforms is always added on rank 0 only.
+     *
+     * The model's <code>log_prob()</code> is replaced by the sum over
+     * the shards.  Evaluated with autodiff variables, as in
+     * <code>log_prob_grad()</code> and the samplers, it returns a
+     * single variable with the precomputed gradient, so that rank 0's
+     * autodiff stack records one node per evaluation regardless of
+     * the size of the model.
+     *
+     * All other members, such as the parameter transforms and
+     * <code>write_array()</code>, are those of rank 0's model.  The
+     * destructor stops the shards, so that only one
+     * <code>sharded_model</code> may use a communicator at a time.
+     *
+     * @tparam M Class of model.
+     */
+    template <class M>
+    class sharded_model : public M {
+    public:
+      /**
+       * Construct rank 0's shard from the specified data.
+       *
+       * @param[in,out] comm Communicator, with rank 0.
+       * @param[in] context Rank 0's slice of the data.
+       * @param[in,out] msgs Stream for messages from the model.
+       * @throw std::invalid_argument if the communicator's rank is
+       * not 0
+       */
+      sharded_model(shard_communicator& comm,
+                    stan::io::var_context& context,
+                    std::ostream* msgs = 0)
+        : M(context, msgs), comm_(comm) {
+        if (comm_.rank() != 0)
+          throw std::invalid_argument("sharded_model: must be constructed"
+                                      " on rank 0; other ranks serve"
+                                      " their shard with serve_shard()");
+      }
+
+      /**
+       * Stop the shards.
+       */
+      ~sharded_model() {
+        std::vector<double> stop(1, SHARD_STOP);
+        for (int r = 1; r < comm_.size(); ++r) {
+          try {
+            comm_.send(r, stop);
+          } catch (...) { }
+        }
+      }
+
+      /**
+       * Return the number of shards, including rank 0's.
+       *
+       * @return number of shards
+       */
+      int num_shards() const {
+        return comm_.size();
+      }
+
+      /**
+       * Return the log density summed over all shards.
+       *
+       * @tparam propto True if calculation is up to proportion
+       * (double-only terms dropped).
+       * @tparam jacobian_adjust_transform True if the log absolute
+       * Jacobian determinant of inverse parameter transforms is added
+       * to the log probability.
+       * @tparam T Type of parameters, <code>double</code> or
+       * <code>stan::math::var</code>.
+       * @param[in] params_r Real-valued parameters.
+       * @param[in] params_i Integer-valued parameters.
+       * @param[in,out] msgs Stream for messages from the model.
+       * @return log density
+       * @throw std::invalid_argument if T is neither
+       * <code>double</code> nor <code>stan::math::var</code>
+       */
+      template <bool propto, bool jacobian_adjust_transform, typename T>
+      T log_prob(std::vector<T>& params_r, std::vector<int>& params_i,
+                 std::ostream* msgs = 0) const {
+        return log_prob_impl<propto, jacobian_adjust_transform>(params_r,
+                                                                params_i,
+                                                                msgs);
+      }
+
+      /**
+       * Return the log density summed over all shards.
+       *
+       * @tparam propto True if calculation is up to proportion
+       * (double-only terms dropped).
+       * @tparam jacobian_adjust_transform True if the log absolute
+       * Jacobian determinant of inverse parameter transforms is added
+       * to the log probability.
+       * @tparam T Type of parameters, <code>double</code> or
+       * <code>stan::math::var</code>.
+       * @param[in] params_r Real-valued parameters.
+       * @param[in,out] msgs Stream for messages from the model.
+       * @return log density
+       * @throw std::invalid_argument if T is neither
+       * <code>double</code> nor <code>stan::math::var</code>
+       */
+      template <bool propto, bool jacobian_adjust_transform, typename T>
+      T log_prob(Eigen::Matrix<T, Eigen::Dynamic, 1>& params_r,
+                 std::ostream* msgs = 0) const {
+        std::vector<T> params_r_vec(params_r.data(),
+                                    params_r.data() + params_r.size());
+        std::vector<int> params_i;
+        return log_prob_impl<propto, jacobian_adjust_transform>(params_r_vec,
+                                                                params_i,
+                                                                msgs);
+      }
+
+      /**
+       * Return the log density summed over all shards and, if the
+       * gradient is not null, write its gradient.
+       *
+       * The request is sent to all shards before rank 0's slice is
+       * evaluated, so that all shards run concurrently.  Replies are
+       * collected from every shard the request was sent to even if a
+       * send or an evaluation fails, a connection is lost or a reply
+       * has the wrong size, so that the next request is not answered
+       * with a stale reply; the first failure is thrown once all
+       * replies have been read.  If a send fails, the request is not
+       * sent to the remaining shards nor evaluated on rank 0.
+       *
+       * @tparam propto True if calculation is up to proportion
+       * (double-only terms dropped).
+       * @tparam jacobian_adjust_transform True if the log absolute
+       * Jacobian determinant of inverse parameter transforms is added
+       * to the log probability.
+       * @param[in] params_r Real-valued parameters.
+       * @param[in] params_i Integer-valued parameters.
+       * @param[out] gradient Vector into which the gradient is
+       * written, or null if only the value is required.
+       * @param[in,out] msgs Stream for messages from the model.
+       * @return log density
+       * @throw std::domain_error if any shard throws
+       * <code>std::domain_error</code>
+       * @throw std::runtime_error if any shard throws another
+       * exception, its connection is lost, its reply has the wrong
+       * size or the request cannot be sent to it
+       */
+      template <bool propto, bool jacobian_adjust_transform>
+      double sharded_log_prob(std::vector<double>& params_r,
+                              std::vector<int>& params_i,
+                              std::vector<double>* gradient,
+                              std::ostream* msgs = 0) const {
+        std::vector<double> request;
+        request.reserve(2 + params_r.size());
+        request.push_back(gradient ? SHARD_LOG_PROB_GRAD : SHARD_LOG_PROB);
+        request.push_back(propto);
+        request.insert(request.end(), params_r.begin(), params_r.end());
+        shard_status status = SHARD_OK;
+        std::stringstream error_msg;
+        int num_sent = 1;
+        for (; num_sent < comm_.size(); ++num_sent) {
+          try {
+            comm_.send(num_sent, request);
+          } catch (const std::exception& e) {
+            status = SHARD_ERROR;
+            error_msg << "shard " << num_sent << ": " << e.what();
+            break;
+          }
+        }
+
+        double lp = 0;
+        std::exception_ptr local_exception;
+        if (status == SHARD_OK) {
+          try {
+            lp = gradient
+              ? local_log_prob_grad<propto, jacobian_adjust_transform>(
+                  params_r, params_i, *gradient, msgs)
+              : M::template log_prob<propto, jacobian_adjust_transform>(
+                  params_r, params_i, msgs);
+          } catch (...) {
+            local_exception = std::current_exception();
+          }
+        }
+
+        std::vector<double> reply;
+        for (int r = 1; r < num_sent; ++r) {
+          shard_status reply_status = SHARD_OK;
+          std::string reply_msg;
+          bool received = false;
+          try {
+            received = comm_.recv(r, reply);
+          } catch (const std::exception& e) {
+            reply_msg = e.what();
+          }
+          if (!received || reply.empty()) {
+            reply_status = SHARD_ERROR;
+            if (reply_msg.empty())
+              reply_msg = "lost connection";
+          } else if (reply[0] != SHARD_OK) {
+            reply_status
+              = static_cast<shard_status>(static_cast<int>(reply[0]));
+            reply_msg = std::string(reply.begin() + 1, reply.end());
+          } else if (reply.size() != 2 + (gradient ? params_r.size() : 0)) {
+            reply_status = SHARD_ERROR;
+            reply_msg = "shards disagree on the number of parameters";
+          }
+          if (reply_status != SHARD_OK) {
+            if (status == SHARD_OK) {
+              status = reply_status;
+              error_msg << "shard " << r << ": " << reply_msg;
+            }
+            continue;
+          }
+          lp += reply[1];
+          if (gradient)
+            for (size_t n = 0; n < gradient->size(); ++n)
+              (*gradient)[n] += reply[2 + n];
+        }
+
+        if (local_exception)
+          std::rethrow_exception(local_exception);
+        if (status == SHARD_DOMAIN_ERROR)
+          throw std::domain_error(error_msg.str());
+        if (status != SHARD_OK)
+          throw std::runtime_error(error_msg.str());
+        return lp;
+      }
+
+      /**
+       * The shards only return values and gradients, so the log
+       * density cannot be evaluated with <code>fvar</code> arguments
+       * and Hessians are computed by finite differences.
+       */
+      static const bool fvar_var_log_prob = false;
+
+    private:
+      shard_communicator& comm_;
+
+      template <bool propto, bool jacobian_adjust_transform, typename T>
+      T log_prob_impl(std::vector<T>& params_r, std::vector<int>& params_i,
+                      std::ostream* msgs) const {
+        throw std::invalid_argument("sharded_model: log_prob is only"
+                                    " available for double and var"
+                                    " parameters");
+      }
+
+      template <bool propto, bool jacobian_adjust_transform>
+      double log_prob_impl(std::vector<double>& params_r,
+                           std::vector<int>& params_i,
+                           std::ostream* msgs) const {
+        return sharded_log_prob<propto, jacobian_adjust_transform>(
+            params_r, params_i, 0, msgs);
+      }
+
+      template <bool propto, bool jacobian_adjust_transform>
+      stan::math::var log_prob_impl(std::vector<stan::math::var>& params_r,
+                                    std::vector<int>& params_i,
+                                    std::ostream* msgs) const {
+        std::vector<double> params_r_dbl(params_r.size());
+        for (size_t n = 0; n < params_r.size(); ++n)
+          params_r_dbl[n] = params_r[n].val();
+        std::vector<double> gradient;
+        double lp
+          = sharded_log_prob<propto, jacobian_adjust_transform>(
+              params_r_dbl, params_i, &gradient, msgs);
+        return stan::math::precomputed_gradients(lp, params_r, gradient);
+      }
+
+      /**
+       * Return the log density of rank 0's slice and write its
+       * gradient, using a nested autodiff stack so that an enclosing
+       * autodiff computation is left intact.
+       */
+      template <bool propto, bool jacobian_adjust_transform>
+      double local_log_prob_grad(std::vector<double>& params_r,
+                                 std::vector<int>& params_i,
+                                 std::vector<double>& gradient,
+                                 std::ostream* msgs) const {
+        using stan::math::var;
+        double lp;
+        stan::math::start_nested();
+        try {
+          std::vector<var> ad_params_r(params_r.begin(), params_r.end());
+          var lp_var
+            = M::template log_prob<propto, jacobian_adjust_transform>(
+                ad_params_r, params_i, msgs);
+          lp = lp_var.val();
+          stan::math::set_zero_all_adjoints_nested();
+          stan::math::grad(lp_var.vi_);
+          gradient.resize(ad_params_r.size());
+          for (size_t n = 0; n < ad_params_r.size(); ++n)
+            gradient[n] = ad_params_r[n].adj();
+        } catch (...) {
+          stan::math::recover_memory_nested();
+          throw;
+        }
+        stan::math::recover_memory_nested();
+        return lp;
+      }
+    };
+
+  }
+}
+#endif
@@ -0,0 +1,197 @@
+#ifndef STAN_MODEL_SOCKETPAIR_COMMUNICATOR_HPP
+#define STAN_MODEL_SOCKETPAIR_COMMUNICATOR_HPP
+
+#include <stan/model/shard_communicator.hpp>
+#include <boost/cstdint.hpp>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace model {
+
+    /**
+     * <code>socketpair_communicator</code> is a
+     * <code>shard_communicator</code> for a single machine, which
+     * forks the worker processes on construction and connects each of
+     * them to rank 0 with a Unix domain socket pair.
+     *
+     * It stands in for an MPI communicator when testing sharded
+     * models.  After construction, the code following it runs in
+     * every process; ranks other than 0 should serve their shard with
+     * <code>serve_shard()</code> and then leave through
+     * <code>_exit()</code>, so that the parent's state is not torn
+     * down twice:
+     *
+     * <pre>
+     * socketpair_communicator comm(4);
+     * if (comm.rank() != 0) {
+     *   M shard(data_for(comm.rank()), &amp;msgs);
+     *   serve_shard(shard, comm, &amp;msgs);
+     *   _exit(0);
+     * }
+     * sharded_model&lt;M&gt; model(comm, data_for(0), &amp;msgs);
+     * </pre>
+     *
+     * The destructor on rank 0 closes the connections and waits for
+     * the workers to exit.
+     */
+    class socketpair_communicator : public shard_communicator {
+    public:
+      /**
+       * Fork <code>size - 1</code> worker processes connected to this
+       * process, which becomes rank 0.
+       *
+       * @param[in] size number of processes including this one
+       * @throw std::invalid_argument if size is not positive
+       * @throw std::runtime_error if a socket pair or process could
+       * not be created
+       */
+      explicit socketpair_communicator(int size)
+        : rank_(0), size_(size) {
+        if (size < 1)
+          throw std::invalid_argument("socketpair_communicator:"
+                                      " size must be positive");
+        fds_.assign(size, -1);
+        pids_.assign(size, 0);
+        for (int r = 1; r < size; ++r) {
+          int sv[2];
+          if (socketpair(AF_UNIX, SOCK_STREAM, 0, sv) != 0) {
+            close_all();
+            throw_errno("socketpair");
+          }
+          pid_t pid = fork();
+          if (pid < 0) {
+            ::close(sv[0]);
+            ::close(sv[1]);
+            close_all();
+            throw_errno("fork");
+          }
+          if (pid == 0) {
+            ::close(sv[0]);
+            close_all();
+            rank_ = r;
+            fds_.assign(size, -1);
+            pids_.assign(size, 0);
+            fds_[0] = sv[1];
+            return;
+          }
+          ::close(sv[1]);
+          fds_[r] = sv[0];
+          pids_[r] = pid;
+        }
+      }
+
+      /**
+       * Close the connections and, on rank 0, wait for the worker
+       * processes to exit.
+       */
+      ~socketpair_communicator() {
+        close_all();
+        if (rank_ == 0) {
+          for (int r = 1; r < size_; ++r) {
+            if (pids_[r] <= 0)
+              continue;
+            while (waitpid(pids_[r], 0, 0) < 0 && errno == EINTR) { }
+          }
+        }
+      }
+
+      int rank() const {
+        return rank_;
+      }
+
+      int size() const {
+        return size_;
+      }
+
+      void send(int to, const std::vector<double>& buf) {
+        int fd = peer(to);
+        boost::uint64_t n = buf.size();
+        write_all(fd, &n, sizeof(n));
+        if (n > 0)
+          write_all(fd, &buf[0], n * sizeof(double));
+      }
+
+      bool recv(int from, std::vector<double>& buf) {
+        int fd = peer(from);
+        boost::uint64_t n;
+        if (!read_all(fd, &n, sizeof(n)))
+          return false;
+        buf.resize(n);
+        if (n > 0 && !read_all(fd, &buf[0], n * sizeof(double)))
+          throw std::runtime_error("socketpair_communicator:"
+                                   " connection closed within message");
+        return true;
+      }
+
+    private:
+      int rank_;
+      int size_;
+      std::vector<int> fds_;
+      std::vector<pid_t> pids_;
+
+      socketpair_communicator(const socketpair_communicator&);
+      socketpair_communicator& operator=(const socketpair_communicator&);
+
+      static void throw_errno(const std::string& what) {
+        throw std::runtime_error("socketpair_communicator: " + what
+                                 + " failed: " + std::strerror(errno));
+      }
+
+      int peer(int r) const {
+        if (r < 0 || r >= size_ || fds_[r] < 0)
+          throw std::invalid_argument("socketpair_communicator:"
+                                      " no connection to rank");
+        return fds_[r];
+      }
+
+      void close_all() {
+        for (size_t r = 0; r < fds_.size(); ++r) {
+          if (fds_[r] >= 0)
+            ::close(fds_[r]);
+          fds_[r] = -1;
+        }
+      }
+
+      static void write_all(int fd, const void* data, size_t n) {
+        const char* p = static_cast<const char*>(data);
+        while (n > 0) {
+          ssize_t k = ::send(fd, p, n, MSG_NOSIGNAL);
+          if (k < 0) {
+            if (errno == EINTR)
+              continue;
+            throw_errno("send");
+          }
+          p += k;
+          n -= k;
+        }
+      }
+
+      static bool read_all(int fd, void* data, size_t n) {
+        char* p = static_cast<char*>(data);
+        while (n > 0) {
+          ssize_t k = ::read(fd, p, n);
+          if (k < 0) {
+            if (errno == EINTR)
+              continue;
+            throw_errno("read");
+          }
+          if (k == 0)
+            return false;
+          p += k;
+          n -= k;
+        }
+        return true;
+      }
+    };
+
+  }
+}
+#endif
@@ -28,6 +28,24 @@ namespace stan {
       g = eigenvectors * eigenprojections;
     }
 
+    /**
+     * Take a damped Newton step from the specified parameters,
+     * halving the step size until the log probability does not
+     * decrease, and return the log probability at the new parameters.
+     *
+     * The Hessian is computed exactly with forward-over-reverse
+     * automatic differentiation by
+     * <code>stan::model::grad_hess_log_prob()</code>.
+     *
+     * @tparam M Class of model.
+     * @param[in] model Model.
+     * @param[in, out] params_r Real-valued parameters, replaced by
+     * the parameters after the step.
+     * @param[in] params_i Integer-valued parameters.
+     * @param[in, out] output_stream Stream to which print statements
+     * in Stan programs are written, default is 0
+     * @return log probability after the step.
+     */
     template <typename M>
     double newton_step(M& model,
                        std::vector<double>& params_r,
@@ -39,7 +57,8 @@ namespace stan {
         double f0
           = stan::model::grad_hess_log_prob<true, false>(model,
                                                          params_r, params_i,
-                                                         gradient, hessian);
+                                                         gradient, hessian,
+                                                         output_stream);
         matrix_d H(params_r.size(), params_r.size());
         for (size_t i = 0; i < hessian.size(); i++) {
           H(i) = hessian[i];
@@ -0,0 +1,367 @@
+#ifndef STAN_OPTIMIZATION_NEWTON_CG_HPP
+#define STAN_OPTIMIZATION_NEWTON_CG_HPP
+
+#include <stan/model/hessian_times_vector.hpp>
+#include <stan/model/log_prob_grad.hpp>
+#include <stan/optimization/bfgs.hpp>
+#include <boost/math/special_functions/fpclassify.hpp>
+#include <Eigen/Dense>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace optimization {
+
+    template<typename Scalar = double>
+    class TrustRegionOptions {
+    public:
+      TrustRegionOptions() {
+        radius0 = 1.0;
+        maxRadius = 1e10;
+        minRadius = 1e-12;
+        eta = 1e-4;
+        maxCGIts = 100;
+      }
+      Scalar radius0;
+      Scalar maxRadius;
+      Scalar minRadius;
+      Scalar eta;
+      size_t maxCGIts;
+    };
+
+    /**
+     * Truncated Newton (Newton-CG) trust-region minimizer of the
+     * negative log density of a model.
+     *
+     * Each step approximately minimizes the quadratic model
+     * <code>g' p + p' H p / 2</code> of the objective within the
+     * trust region <code>|p| <= radius</code> with the conjugate
+     * gradient method of Steihaug and Toint.  The Hessian is never
+     * formed; each conjugate gradient iteration computes one
+     * Hessian-vector product with
+     * <code>stan::model::hessian_times_vector()</code>.  The
+     * iterations stop when the residual is below
+     * <code>min(0.5, sqrt(|g|)) |g|</code>, when the step reaches the
+     * trust region boundary, or when a direction of negative
+     * curvature is found, which is followed to the boundary.
+     *
+     * A step is accepted if the ratio of the actual to the predicted
+     * decrease exceeds <code>eta</code>.  The trust region is shrunk
+     * if the ratio is below 1/4 and grown if it is above 3/4 and the
+     * step reached the boundary.
+     *
+     * @tparam M Class of model.
+     * @tparam jacobian_adjust_transform True if the log absolute
+     * Jacobian determinant of inverse parameter transforms is added to
+     * the log probability.
+     */
+    template <typename M, bool jacobian_adjust_transform = false>
+    class NewtonCG {
+    public:
+      typedef Eigen::Matrix<double, Eigen::Dynamic, 1> vector_t;
+
+    protected:
+      M& _model;
+      std::vector<int> _params_i;
+      std::ostream* _msgs;
+      vector_t _xk, _gk;
+      double _fk, _fk_1;
+      double _radius;
+      double _step_norm;
+      size_t _itNum;
+      size_t _fevals;
+      size_t _hvp_evals;
+      size_t _cg_its;
+      std::string _note;
+
+      /**
+       * Evaluate the negative log density and its gradient at the
+       * specified point, returning a non-zero value if the model
+       * throws or the result is not finite.
+       */
+      int evaluate(const vector_t& x, double& f, vector_t& g) {
+        std::vector<double> x_std(x.data(), x.data() + x.size());
+        std::vector<double> g_std;
+        _fevals++;
+        try {
+          f = -stan::model::log_prob_grad<true, jacobian_adjust_transform>
+            (_model, x_std, _params_i, g_std, _msgs);
+        } catch (const std::exception& e) {
+          if (_msgs)
+            (*_msgs) << e.what() << std::endl;
+          return 1;
+        }
+        g.resize(x.size());
+        for (int i = 0; i < g.size(); ++i) {
+          if (!boost::math::isfinite(g_std[i])) {
+            if (_msgs)
+              *_msgs << "Error evaluating model log probability: "
+                     << "Non-finite gradient." << std::endl;
+            return 3;
+          }
+          g(i) = -g_std[i];
+        }
+        if (!boost::math::isfinite(f)) {
+          if (_msgs)
+            *_msgs << "Error evaluating model log probability: "
+                   << "Non-finite function evaluation." << std::endl;
+          return 2;
+        }
+        return 0;
+      }
+
+      /**
+       * Evaluate the product of the Hessian of the negative log
+       * density at the current point with the specified vector,
+       * returning a non-zero value if the model throws or the product
+       * is not finite.
+       */
+      int hessian_times(const vector_t& v, vector_t& Hv) {
+        double lp;
+        _hvp_evals++;
+        try {
+          stan::model::hessian_times_vector<true, jacobian_adjust_transform>
+            (_model, _xk, v, lp, Hv);
+        } catch (const std::exception& e) {
+          if (_msgs)
+            (*_msgs) << e.what() << std::endl;
+          return 1;
+        }
+        if (!Hv.allFinite()) {
+          if (_msgs)
+            *_msgs << "Error evaluating model log probability: "
+                   << "Non-finite Hessian-vector product." << std::endl;
+          return 3;
+        }
+        Hv = -Hv;
+        return 0;
+      }
+
+      /**
+       * Return the non-negative tau for which |z + tau d| equals the
+       * trust region radius.
+       */
+      double to_boundary(const vector_t& z, const vector_t& d) const {
+        double dd = d.squaredNorm();
+        double zd = z.dot(d);
+        double zz = z.squaredNorm();
+        double disc = zd * zd + dd * (_radius * _radius - zz);
+        return (-zd + std::sqrt(std::max(disc, 0.0))) / dd;
+      }
+
+      /**
+       * Approximately minimize the quadratic model within the trust
+       * region, writing the step and the Hessian times the step.  If
+       * a Hessian-vector product cannot be evaluated, the step so far
+       * is kept; if that is the first product, the step is zero and
+       * is rejected.  A zero gradient also gives a zero step.
+       *
+       * @return true if the step reached the trust region boundary
+       */
+      bool steihaug_cg(vector_t& z, vector_t& Hz) {
+        const int N = _gk.size();
+        z.setZero(N);
+        Hz.setZero(N);
+        vector_t r = _gk;
+        vector_t d = -r;
+        double rr = r.squaredNorm();
+        if (rr == 0)
+          return false;
+        const double g_norm = std::sqrt(rr);
+        const double tol = std::min(0.5, std::sqrt(g_norm)) * g_norm;
+        const size_t max_its = std::min(_tr_opts.maxCGIts,
+                                        static_cast<size_t>(N));
+        for (size_t j = 0; j < max_its; ++j) {
+          _cg_its++;
+          vector_t Hd;
+          if (hessian_times(d, Hd))
+            return false;
+          double dHd = d.dot(Hd);
+          if (!(dHd > 0)) {
+            double tau = to_boundary(z, d);
+            z += tau * d;
+            Hz += tau * Hd;
+            return true;
+          }
+          double alpha = rr / dHd;
+          if ((z + alpha * d).norm() >= _radius) {
+            double tau = to_boundary(z, d);
+            z += tau * d;
+            Hz += tau * Hd;
+            return true;
+          }
+          z += alpha * d;
+          Hz += alpha * Hd;
+          r += alpha * Hd;
+          double rr_next = r.squaredNorm();
+          if (std::sqrt(rr_next) < tol)
+            return false;
+          d = -r + (rr_next / rr) * d;
+          rr = rr_next;
+        }
+        return false;
+      }
+
+    public:
+      TrustRegionOptions<double> _tr_opts;
+      ConvergenceOptions<double> _conv_opts;
+
+      NewtonCG(M& model,
+               const std::vector<double>& params_r,
+               const std::vector<int>& params_i,
+               std::ostream* msgs = 0)
+        : _model(model), _params_i(params_i), _msgs(msgs) {
+        initialize(params_r);
+      }
+
+      void initialize(const std::vector<double>& params_r) {
+        _xk.resize(params_r.size());
+        for (size_t i = 0; i < params_r.size(); i++)
+          _xk[i] = params_r[i];
+        _fevals = 0;
+        _hvp_evals = 0;
+        _cg_its = 0;
+        if (evaluate(_xk, _fk, _gk))
+          throw std::runtime_error("Error evaluating initial Newton-CG"
+                                   " point.");
+        _fk_1 = _fk;
+        _radius = 0;
+        _step_norm = 0;
+        _itNum = 0;
+        _note = "";
+      }
+
+      const double& curr_f() const { return _fk; }
+      const vector_t& curr_x() const { return _xk; }
+      const vector_t& curr_g() const { return _gk; }
+      double prev_step_size() const { return _step_norm; }
+      double radius() const { return _radius; }
+      size_t iter_num() const { return _itNum; }
+      size_t grad_evals() const { return _fevals; }
+      size_t hessian_vector_evals() const { return _hvp_evals; }
+      size_t cg_iter_num() const { return _cg_its; }
+      const std::string& note() const { return _note; }
+
+      double logp() const { return -_fk; }
+      double grad_norm() const { return _gk.norm(); }
+      void grad(std::vector<double>& g) const {
+        g.resize(_gk.size());
+        for (int i = 0; i < _gk.size(); i++)
+          g[i] = -_gk[i];
+      }
+      void params_r(std::vector<double>& x) const {
+        x.resize(_xk.size());
+        for (int i = 0; i < _xk.size(); i++)
+          x[i] = _xk[i];
+      }
+
+      double rel_obj_decrease() const {
+        return std::fabs(_fk_1 - _fk) / std::max(std::fabs(_fk_1),
+                                                 std::max(std::fabs(_fk),
+                                                          _conv_opts.fScale));
+      }
+
+      std::string get_code_string(int retCode) const {
+        switch (retCode) {
+          case TERM_SUCCESS:
+            return std::string("Successful step completed");
+          case TERM_ABSF:
+            return std::string("Convergence detected: absolute change "
+                               "in objective function was below tolerance");
+          case TERM_RELF:
+            return std::string("Convergence detected: relative change "
+                               "in objective function was below tolerance");
+          case TERM_ABSGRAD:
+            return std::string("Convergence detected: "
+                               "gradient norm is below tolerance");
+          case TERM_ABSX:
+            return std::string("Convergence detected: "
+                               "absolute parameter change was below tolerance");
+          case TERM_MAXIT:
+            return std::string("Maximum number of iterations hit, "
+                               "may not be at an optima");
+          case TERM_LSFAIL:
+            return std::string("Trust region shrank below its minimum radius,"
+                               " no more progress can be made");
+          default:
+            return std::string("Unknown termination code");
+        }
+      }
+
+      /**
+       * Take one accepted trust-region step, shrinking the trust
+       * region and solving again until a step is accepted.
+       *
+       * @return TERM_SUCCESS if more progress can be made, a positive
+       * termination code on convergence, or TERM_LSFAIL if the trust
+       * region became too small
+       */
+      int step() {
+        _itNum++;
+        _note = "";
+        if (_itNum == 1)
+          _radius = _tr_opts.radius0;
+        if (_gk.norm() < _conv_opts.tolAbsGrad)
+          return TERM_ABSGRAD;
+
+        vector_t p, Hp, g_new;
+        double f_new;
+        while (true) {
+          bool on_boundary = steihaug_cg(p, Hp);
+          double predicted = -(_gk.dot(p) + 0.5 * p.dot(Hp));
+          vector_t x_new = _xk + p;
+          double rho = -std::numeric_limits<double>::infinity();
+          if (predicted > 0 && !evaluate(x_new, f_new, g_new))
+            rho = (_fk - f_new) / predicted;
+
+          double p_norm = p.norm();
+          if (rho < 0.25) {
+            _radius = 0.25 * p_norm;
+          } else if (rho > 0.75 && on_boundary) {
+            _radius = std::min(2 * _radius, _tr_opts.maxRadius);
+          }
+
+          if (rho > _tr_opts.eta) {
+            _fk_1 = _fk;
+            _fk = f_new;
+            _xk.swap(x_new);
+            _gk.swap(g_new);
+            _step_norm = p_norm;
+            break;
+          }
+          _note = "Step rejected, trust region shrunk";
+          if (_radius < _tr_opts.minRadius)
+            return TERM_LSFAIL;
+        }
+
+        if (std::fabs(_fk_1 - _fk) < _conv_opts.tolAbsF)
+          return TERM_ABSF;
+        if (_gk.norm() < _conv_opts.tolAbsGrad)
+          return TERM_ABSGRAD;
+        if (_step_norm < _conv_opts.tolAbsX)
+          return TERM_ABSX;
+        if (_itNum >= _conv_opts.maxIts)
+          return TERM_MAXIT;
+        if (rel_obj_decrease()
+            < _conv_opts.tolRelF * std::numeric_limits<double>::epsilon())
+          return TERM_RELF;
+        return TERM_SUCCESS;
+      }
+
+      int minimize(std::vector<double>& params_r) {
+        int retcode;
+        while (!(retcode = step()))
+          continue;
+        this->params_r(params_r);
+        return retcode;
+      }
+    };
+
+  }
+}
+#endif
@@ -261,6 +261,42 @@ namespace stan {
         }
       };
 
+      /**
+       * Maximum number of conjugate gradient iterations per Newton-CG
+       * step.
+       */
+      struct cg_iter {
+        /**
+         * Return the string description of cg_iter.
+         *
+         * @return description
+         */
+        static std::string description() {
+          return "Maximum number of conjugate gradient iterations per"
+            " Newton-CG step.";
+        }
+
+        /**
+         * Validates cg_iter; cg_iter must be greater than 0.
+         *
+         * @param[in] cg_iter argument to validate
+         * @throw std::invalid_argument unless cg_iter is greater than zero
+         */
+        static void validate(int cg_iter) {
+          if (!(cg_iter > 0))
+            throw std::invalid_argument("cg_iter must be greater than 0.");
+        }
+
+        /**
+         * Return the default cg_iter value.
+         *
+         * @return 100
+         */
+        static int default_value() {
+          return 100;
+        }
+      };
+
       /**
        * Total number of iterations.
        */
@@ -5,12 +5,16 @@
 #include <stan/math/prim/mat.hpp>
 #include <stan/callbacks/interrupt.hpp>
 #include <stan/callbacks/logger.hpp>
+#include <stan/callbacks/synchronized_interrupt.hpp>
+#include <stan/callbacks/synchronized_logger.hpp>
 #include <stan/callbacks/writer.hpp>
 #include <stan/mcmc/fixed_param_sampler.hpp>
 #include <stan/services/error_codes.hpp>
 #include <stan/mcmc/hmc/nuts/adapt_diag_e_nuts.hpp>
 #include <stan/services/util/run_adaptive_sampler.hpp>
+#include <stan/services/util/convergence_monitor_writer.hpp>
 #include <stan/services/util/create_rng.hpp>
+#include <stan/services/util/run_chains.hpp>
 #include <stan/services/util/initialize.hpp>
 #include <stan/services/util/inv_metric.hpp>
 #include <vector>
@@ -51,6 +55,10 @@ namespace stan {
        * @param[in,out] init_writer Writer callback for unconstrained inits
        * @param[in,out] sample_writer Writer for draws
        * @param[in,out] diagnostic_writer Writer for diagnostic information
+       * @param[in,out] monitor convergence monitor; if not null, the
+       *   post-warmup draws are passed on to it and sampling stops once it
+       *   reached its target
+       * @param[in] monitor_chain index of the chain in the monitor
        * @return error_codes::OK if successful
        */
       template <class Model>
@@ -68,7 +76,9 @@ namespace stan {
                                 callbacks::logger& logger,
                                 callbacks::writer& init_writer,
                                 callbacks::writer& sample_writer,
-                                callbacks::writer& diagnostic_writer) {
+                                callbacks::writer& diagnostic_writer,
+                                stan::mcmc::convergence_monitor* monitor = 0,
+                                size_t monitor_chain = 0) {
         boost::ecuyer1988 rng = util::create_rng(random_seed, chain);
 
         std::vector<int> disc_vector;
@@ -103,10 +113,14 @@ namespace stan {
         sampler.set_window_params(num_warmup, init_buffer, term_buffer,
                                   window, logger);
 
+        util::convergence_monitor_writer
+          monitor_writer(sample_writer, monitor, monitor_chain,
+                         save_warmup ? (num_warmup + num_thin - 1) / num_thin
+                                     : 0);
         util::run_adaptive_sampler(sampler, model, cont_vector, num_warmup,
                                    num_samples, num_thin, refresh, save_warmup,
                                    rng, interrupt, logger,
-                                   sample_writer, diagnostic_writer);
+                                   monitor_writer, diagnostic_writer, monitor);
 
         return error_codes::OK;
       }
@@ -173,6 +187,106 @@ namespace stan {
                                      diagnostic_writer);
       }
 
+      /**
+       * Runs <code>num_chains</code> chains of HMC with NUTS with adaptation
+       * using diagonal Euclidean metric.
+       *
+       * All chains share the same model instance and therefore the
+       * same copy of the data.  Chain <code>n</code> is initialized
+       * from <code>init[n]</code> and <code>init_inv_metric[n]</code>,
+       * uses chain id <code>chain + n</code> for its random number
+       * generator and writes to the <code>n</code>-th writers.
+       * The chains are run on up to <code>num_threads</code> threads;
+       * see <code>util::run_chains</code>.  The interrupt and logger
+       * are shared by all chains and are called under a mutex.
+       *
+       * @tparam Model Model class
+       * @param[in] model Input model to test (with data already instantiated)
+       * @param[in] num_chains Number of chains
+       * @param[in] num_threads Maximum number of threads, zero for all cores
+       * @param[in] init var contexts for initialization, one per chain
+       * @param[in] init_inv_metric var contexts exposing an initial diagonal
+                    inverse Euclidean metric, one per chain
+       * @param[in] random_seed random seed for the random number generator
+       * @param[in] chain chain id of the first chain
+       * @param[in] init_radius radius to initialize
+       * @param[in] num_warmup Number of warmup samples
+       * @param[in] num_samples Number of samples
+       * @param[in] num_thin Number to thin the samples
+       * @param[in] save_warmup Indicates whether to save the warmup iterations
+       * @param[in] refresh Controls the output
+       * @param[in] stepsize initial stepsize for discrete evolution
+       * @param[in] stepsize_jitter uniform random jitter of stepsize
+       * @param[in] max_depth Maximum tree depth
+       * @param[in] delta adaptation target acceptance statistic
+       * @param[in] gamma adaptation regularization scale
+       * @param[in] kappa adaptation relaxation exponent
+       * @param[in] t0 adaptation iteration offset
+       * @param[in] init_buffer width of initial fast adaptation interval
+       * @param[in] term_buffer width of final fast adaptation interval
+       * @param[in] window initial width of slow adaptation interval
+       * @param[in,out] interrupt Callback for interrupts
+       * @param[in,out] logger Logger for messages
+       * @param[in,out] init_writer Writers for unconstrained inits, one per
+       *   chain
+       * @param[in,out] sample_writer Writers for draws, one per chain
+       * @param[in,out] diagnostic_writer Writers for diagnostic information,
+       *   one per chain
+       * @param[in,out] monitor convergence monitor for all chains; if not
+       *   null, the post-warmup draws are passed on to it and sampling
+       *   stops once it reached its target
+       * @throw std::invalid_argument if a per-chain vector does not have
+       *   <code>num_chains</code> elements
+       * @return error_codes::OK if all chains were successful, otherwise
+       *   the first error code returned by a chain
+       */
+      template <class Model>
+      int hmc_nuts_diag_e_adapt(
+          Model& model, size_t num_chains, size_t num_threads,
+          const std::vector<stan::io::var_context*>& init,
+          const std::vector<stan::io::var_context*>& init_inv_metric,
+          unsigned int random_seed, unsigned int chain, double init_radius,
+          int num_warmup, int num_samples, int num_thin, bool save_warmup,
+          int refresh, double stepsize, double stepsize_jitter, int max_depth,
+          double delta, double gamma, double kappa, double t0,
+          unsigned int init_buffer, unsigned int term_buffer,
+          unsigned int window,
+          callbacks::interrupt& interrupt, callbacks::logger& logger,
+          std::vector<callbacks::writer*>& init_writer,
+          std::vector<callbacks::writer*>& sample_writer,
+          std::vector<callbacks::writer*>& diagnostic_writer,
+          stan::mcmc::convergence_monitor* monitor = 0) {
+        util::check_num_chains("hmc_nuts_diag_e_adapt", "init",
+                               init, num_chains);
+        util::check_num_chains("hmc_nuts_diag_e_adapt", "init_inv_metric",
+                               init_inv_metric, num_chains);
+        util::check_num_chains("hmc_nuts_diag_e_adapt", "init_writer",
+                               init_writer, num_chains);
+        util::check_num_chains("hmc_nuts_diag_e_adapt", "sample_writer",
+                               sample_writer, num_chains);
+        util::check_num_chains("hmc_nuts_diag_e_adapt", "diagnostic_writer",
+                               diagnostic_writer, num_chains);
+        callbacks::synchronized_interrupt shared_interrupt(interrupt);
+        callbacks::synchronized_logger shared_logger(logger);
+
+        std::vector<int> return_codes
+          = util::run_chains(num_chains, num_threads, [&](size_t n) {
+              return hmc_nuts_diag_e_adapt(model, *init[n], *init_inv_metric[n],
+                                           random_seed, chain + n, init_radius,
+                                           num_warmup, num_samples, num_thin,
+                                           save_warmup, refresh, stepsize,
+                                           stepsize_jitter, max_depth, delta,
+                                           gamma, kappa, t0, init_buffer,
+                                           term_buffer, window,
+                                           shared_interrupt, shared_logger,
+                                           *init_writer[n], *sample_writer[n],
+                                           *diagnostic_writer[n], monitor, n);
+            });
+        if (monitor)
+          util::log_convergence_monitor(*monitor, logger);
+        return util::combine_return_codes(return_codes);
+      }
+
     }
   }
 }
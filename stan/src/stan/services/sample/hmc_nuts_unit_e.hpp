@@ -3,11 +3,14 @@
 
 #include <stan/callbacks/interrupt.hpp>
 #include <stan/callbacks/logger.hpp>
+#include <stan/callbacks/synchronized_interrupt.hpp>
+#include <stan/callbacks/synchronized_logger.hpp>
 #include <stan/callbacks/writer.hpp>
 #include <stan/math/prim/mat/fun/Eigen.hpp>
 #include <stan/mcmc/hmc/nuts/unit_e_nuts.hpp>
 #include <stan/services/error_codes.hpp>
 #include <stan/services/util/create_rng.hpp>
+#include <stan/services/util/run_chains.hpp>
 #include <stan/services/util/initialize.hpp>
 #include <stan/services/util/run_sampler.hpp>
 #include <vector>
@@ -73,6 +76,82 @@ namespace stan {
         return error_codes::OK;
       }
 
+      /**
+       * Runs <code>num_chains</code> chains of HMC with NUTS without adaptation
+       * using unit Euclidean metric.
+       *
+       * All chains share the same model instance and therefore the
+       * same copy of the data.  Chain <code>n</code> is initialized
+       * from <code>init[n]</code>, uses chain id <code>chain + n</code>
+       * for its random number generator and writes to the
+       * <code>n</code>-th writers.
+       * The chains are run on up to <code>num_threads</code> threads;
+       * see <code>util::run_chains</code>.  The interrupt and logger
+       * are shared by all chains and are called under a mutex.
+       *
+       * @tparam Model Model class
+       * @param[in] model Input model to test (with data already instantiated)
+       * @param[in] num_chains Number of chains
+       * @param[in] num_threads Maximum number of threads, zero for all cores
+       * @param[in] init var contexts for initialization, one per chain
+       * @param[in] random_seed random seed for the random number generator
+       * @param[in] chain chain id of the first chain
+       * @param[in] init_radius radius to initialize
+       * @param[in] num_warmup Number of warmup samples
+       * @param[in] num_samples Number of samples
+       * @param[in] num_thin Number to thin the samples
+       * @param[in] save_warmup Indicates whether to save the warmup iterations
+       * @param[in] refresh Controls the output
+       * @param[in] stepsize initial stepsize for discrete evolution
+       * @param[in] stepsize_jitter uniform random jitter of stepsize
+       * @param[in] max_depth Maximum tree depth
+       * @param[in,out] interrupt Callback for interrupts
+       * @param[in,out] logger Logger for messages
+       * @param[in,out] init_writer Writers for unconstrained inits, one per
+       *   chain
+       * @param[in,out] sample_writer Writers for draws, one per chain
+       * @param[in,out] diagnostic_writer Writers for diagnostic information,
+       *   one per chain
+       * @throw std::invalid_argument if a per-chain vector does not have
+       *   <code>num_chains</code> elements
+       * @return error_codes::OK if all chains were successful, otherwise
+       *   the first error code returned by a chain
+       */
+      template <class Model>
+      int hmc_nuts_unit_e(
+          Model& model, size_t num_chains, size_t num_threads,
+          const std::vector<stan::io::var_context*>& init,
+          unsigned int random_seed, unsigned int chain, double init_radius,
+          int num_warmup, int num_samples, int num_thin, bool save_warmup,
+          int refresh, double stepsize, double stepsize_jitter, int max_depth,
+          callbacks::interrupt& interrupt, callbacks::logger& logger,
+          std::vector<callbacks::writer*>& init_writer,
+          std::vector<callbacks::writer*>& sample_writer,
+          std::vector<callbacks::writer*>& diagnostic_writer) {
+        util::check_num_chains("hmc_nuts_unit_e", "init",
+                               init, num_chains);
+        util::check_num_chains("hmc_nuts_unit_e", "init_writer",
+                               init_writer, num_chains);
+        util::check_num_chains("hmc_nuts_unit_e", "sample_writer",
+                               sample_writer, num_chains);
+        util::check_num_chains("hmc_nuts_unit_e", "diagnostic_writer",
+                               diagnostic_writer, num_chains);
+        callbacks::synchronized_interrupt shared_interrupt(interrupt);
+        callbacks::synchronized_logger shared_logger(logger);
+
+        std::vector<int> return_codes
+          = util::run_chains(num_chains, num_threads, [&](size_t n) {
+              return hmc_nuts_unit_e(model, *init[n], random_seed, chain + n,
+                                     init_radius, num_warmup, num_samples,
+                                     num_thin, save_warmup, refresh, stepsize,
+                                     stepsize_jitter, max_depth,
+                                     shared_interrupt, shared_logger,
+                                     *init_writer[n], *sample_writer[n],
+                                     *diagnostic_writer[n]);
+            });
+        return util::combine_return_codes(return_codes);
+      }
+
     }
   }
 }
@@ -0,0 +1,99 @@
+#ifndef STAN_SERVICES_UTIL_CONVERGENCE_MONITOR_WRITER_HPP
+#define STAN_SERVICES_UTIL_CONVERGENCE_MONITOR_WRITER_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/callbacks/writer.hpp>
+#include <stan/mcmc/convergence_monitor.hpp>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace util {
+
+      /**
+       * <code>convergence_monitor_writer</code> is an implementation
+       * of <code>writer</code> that forwards every call to the sample
+       * writer of a chain and passes the names and the post-warmup
+       * draws on to a convergence monitor.  Without a monitor it only
+       * forwards.
+       */
+      class convergence_monitor_writer : public callbacks::writer {
+      public:
+        /**
+         * Constructor.
+         *
+         * @param[in,out] writer sample writer of the chain
+         * @param[in,out] monitor convergence monitor shared by the chains,
+         *   may be null
+         * @param[in] chain index of the chain in the monitor
+         * @param[in] num_warmup_draws number of warmup draws written
+         *   before the post-warmup draws
+         */
+        convergence_monitor_writer(callbacks::writer& writer,
+                                   stan::mcmc::convergence_monitor* monitor,
+                                   size_t chain, size_t num_warmup_draws)
+          : writer_(writer), monitor_(monitor), chain_(chain),
+            num_skip_(num_warmup_draws) {
+        }
+
+        void operator()(const std::vector<std::string>& names) {
+          writer_(names);
+          if (monitor_)
+            monitor_->set_names(names);
+        }
+
+        void operator()(const std::vector<double>& state) {
+          writer_(state);
+          if (!monitor_)
+            return;
+          if (num_skip_ > 0)
+            --num_skip_;
+          else
+            monitor_->add_draw(chain_, state);
+        }
+
+        void operator()() {
+          writer_();
+        }
+
+        void operator()(const std::string& message) {
+          writer_(message);
+        }
+
+      private:
+        callbacks::writer& writer_;
+        stan::mcmc::convergence_monitor* monitor_;
+        size_t chain_;
+        size_t num_skip_;
+      };
+
+      /**
+       * Log the smallest effective sample size and the largest split
+       * R hat of the last estimate of the convergence monitor.
+       *
+       * @param[in] monitor convergence monitor
+       * @param[in,out] logger logger for messages
+       */
+      inline void log_convergence_monitor(
+          const stan::mcmc::convergence_monitor& monitor,
+          callbacks::logger& logger) {
+        std::stringstream msg;
+        if (monitor.num_draws() == 0) {
+          msg << "Convergence monitor: too few draws for an estimate.";
+        } else {
+          msg << "Convergence monitor: after " << monitor.num_draws()
+              << " draws per chain, minimum effective sample size "
+              << monitor.min_ess() << ", maximum split R hat "
+              << monitor.max_rhat()
+              << (monitor.target_reached() ? ", target reached."
+                  : ", target not reached.");
+        }
+        logger.info(msg);
+      }
+
+    }
+  }
+}
+#endif
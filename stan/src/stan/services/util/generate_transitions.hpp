@@ -4,7 +4,9 @@
 #include <stan/callbacks/writer.hpp>
 #include <stan/callbacks/interrupt.hpp>
 #include <stan/mcmc/base_mcmc.hpp>
+#include <stan/mcmc/convergence_monitor.hpp>
 #include <stan/services/util/mcmc_writer.hpp>
+#include <sstream>
 #include <string>
 
 namespace stan {
@@ -36,6 +38,8 @@ namespace stan {
        * @param[in,out] base_rng random number generator
        * @param[in,out] callback interrupt callback called once an iteration
        * @param[in,out] logger logger for messages
+       * @param[in] monitor convergence monitor; if not null, post-warmup
+       *   transitions stop once it reached its target
        */
       template <class Model, class RNG>
       void generate_transitions(stan::mcmc::base_mcmc& sampler,
@@ -46,10 +50,20 @@ namespace stan {
                                 stan::mcmc::sample& init_s,
                                 Model& model, RNG& base_rng,
                                 callbacks::interrupt& callback,
-                                callbacks::logger& logger) {
+                                callbacks::logger& logger,
+                                const stan::mcmc::convergence_monitor*
+                                monitor = 0) {
         for (int m = 0; m < num_iterations; ++m) {
           callback();
 
+          if (monitor && !warmup && monitor->target_reached()) {
+            std::stringstream message;
+            message << "Target effective sample size reached at iteration "
+                    << start + m << " / " << finish << ", stopping sampling.";
+            logger.info(message);
+            break;
+          }
+
           if (refresh > 0
               && (start + m + 1 == finish
                   || m == 0
@@ -25,6 +25,8 @@ namespace stan {
         callbacks::writer& sample_writer_;
         callbacks::writer& diagnostic_writer_;
         callbacks::logger& logger_;
+        std::vector<double> values_;
+        Eigen::VectorXd model_values_;
 
       public:
         /**
@@ -89,18 +91,17 @@ namespace stan {
                                  stan::mcmc::sample& sample,
                                  stan::mcmc::base_mcmc& sampler,
                                  Model& model) {
-          std::vector<double> values;
-
-          sample.get_sample_params(values);
-          sampler.get_sampler_params(values);
+          // reuse the buffers of earlier draws
+          values_.clear();
 
-          Eigen::VectorXd model_values;
+          sample.get_sample_params(values_);
+          sampler.get_sampler_params(values_);
 
           std::stringstream ss;
           try {
             model.write_array(rng,
                         const_cast<Eigen::VectorXd&>(sample.cont_params()),
-                        model_values,
+                        model_values_,
                         true, true,
                         &ss);
           } catch (const std::exception& e) {
@@ -112,10 +113,10 @@ namespace stan {
           if (ss.str().length() > 0)
             logger_.info(ss);
 
-          for (int i = 0; i < model_values.size(); ++i)
-            values.push_back(model_values(i));
+          values_.insert(values_.end(), model_values_.data(),
+                         model_values_.data() + model_values_.size());
 
-          sample_writer_(values);
+          sample_writer_(values_);
         }
 
         /**
@@ -0,0 +1,126 @@
+#ifndef STAN_SERVICES_UTIL_RUN_CHAINS_HPP
+#define STAN_SERVICES_UTIL_RUN_CHAINS_HPP
+
+#include <stan/services/error_codes.hpp>
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace stan {
+  namespace services {
+    namespace util {
+
+      /**
+       * Runs <code>run_chain(n)</code> for every chain
+       * <code>n = 0, ..., num_chains - 1</code> on a pool of
+       * <code>num_threads</code> threads and returns the return codes
+       * of the chains.
+       *
+       * Chains are handed out to the threads in order, so that at
+       * most <code>num_threads</code> chains run at the same time.
+       * Each thread records gradients to its own autodiff tape, which
+       * requires Stan to be compiled with <code>STAN_THREADS</code>.
+       * Without it, the chains are run one after another in the
+       * calling thread.
+       *
+       * If a chain throws, the remaining chains are still run and the
+       * first exception is rethrown once all threads have finished.
+       *
+       * @tparam F Type of functor taking a chain index and returning
+       *   an error code
+       * @param[in] num_chains number of chains
+       * @param[in] num_threads maximum number of threads; zero means
+       *   <code>std::thread::hardware_concurrency()</code>
+       * @param[in] run_chain functor running a single chain
+       * @return vector of error codes, one per chain
+       */
+      template <typename F>
+      std::vector<int> run_chains(size_t num_chains, size_t num_threads,
+                                  const F& run_chain) {
+        std::vector<int> return_codes(num_chains, error_codes::SOFTWARE);
+#ifdef STAN_THREADS
+        if (num_threads == 0)
+          num_threads = std::max(1U, std::thread::hardware_concurrency());
+        num_threads = std::min(num_threads, num_chains);
+#else
+        num_threads = 1;
+#endif
+        std::atomic<size_t> next_chain(0);
+        std::exception_ptr first_exception;
+        std::mutex exception_mutex;
+
+        auto worker = [&]() {
+          for (size_t n = next_chain++; n < num_chains; n = next_chain++) {
+            try {
+              return_codes[n] = run_chain(n);
+            } catch (...) {
+              std::lock_guard<std::mutex> lock(exception_mutex);
+              if (!first_exception)
+                first_exception = std::current_exception();
+            }
+          }
+        };
+
+        if (num_threads <= 1) {
+          worker();
+        } else {
+          std::vector<std::thread> threads;
+          threads.reserve(num_threads - 1);
+          for (size_t i = 1; i < num_threads; ++i)
+            threads.emplace_back(worker);
+          worker();
+          for (size_t i = 0; i < threads.size(); ++i)
+            threads[i].join();
+        }
+
+        if (first_exception)
+          std::rethrow_exception(first_exception);
+        return return_codes;
+      }
+
+      /**
+       * Checks that a per-chain argument has one element per chain,
+       * so that the chains can index it without bounds checks.
+       *
+       * @tparam T Type of elements
+       * @param[in] function name of the calling function
+       * @param[in] name name of the argument
+       * @param[in] x per-chain argument
+       * @param[in] num_chains number of chains
+       * @throw std::invalid_argument if the size of x is not num_chains
+       */
+      template <typename T>
+      void check_num_chains(const char* function, const char* name,
+                            const std::vector<T>& x, size_t num_chains) {
+        if (x.size() == num_chains)
+          return;
+        std::stringstream msg;
+        msg << function << ": " << name << " has size " << x.size()
+            << ", but there are " << num_chains << " chains";
+        throw std::invalid_argument(msg.str());
+      }
+
+      /**
+       * Returns the first error code which is not
+       * <code>error_codes::OK</code>, or <code>error_codes::OK</code>
+       * if all chains succeeded.
+       *
+       * @param[in] return_codes error codes of the chains
+       * @return combined error code
+       */
+      inline int combine_return_codes(const std::vector<int>& return_codes) {
+        for (size_t n = 0; n < return_codes.size(); ++n)
+          if (return_codes[n] != error_codes::OK)
+            return return_codes[n];
+        return error_codes::OK;
+      }
+
+    }
+  }
+}
+#endif
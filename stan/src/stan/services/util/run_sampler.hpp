@@ -31,6 +31,8 @@ namespace stan {
        * @param[in,out] logger logger for messages
        * @param[in,out] sample_writer writer for draws
        * @param[in,out] diagnostic_writer writer for diagnostic information
+       * @param[in] monitor convergence monitor; if not null, sampling
+       *   stops once it reached its target
        */
       template <class Model, class RNG>
       void run_sampler(stan::mcmc::base_mcmc& sampler, Model& model,
@@ -40,7 +42,8 @@ namespace stan {
                        callbacks::interrupt& interrupt,
                        callbacks::logger& logger,
                        callbacks::writer& sample_writer,
-                       callbacks::writer& diagnostic_writer) {
+                       callbacks::writer& diagnostic_writer,
+                       const stan::mcmc::convergence_monitor* monitor = 0) {
         Eigen::Map<Eigen::VectorXd> cont_params(cont_vector.data(),
                                                 cont_vector.size());
         services::util::mcmc_writer
@@ -70,7 +73,7 @@ namespace stan {
                                    refresh, true, false,
                                    writer,
                                    s, model, rng,
-                                   interrupt, logger);
+                                   interrupt, logger, monitor);
         end = clock();
         double sample_delta_t
           = static_cast<double>(end - start) / CLOCKS_PER_SEC;
@@ -7,6 +7,7 @@
 #include <stan/callbacks/stream_writer.hpp>
 #include <stan/io/dump.hpp>
 #include <stan/services/error_codes.hpp>
+#include <stan/variational/monte_carlo_draws.hpp>
 #include <stan/variational/print_progress.hpp>
 #include <stan/variational/families/normal_fullrank.hpp>
 #include <stan/variational/families/normal_meanfield.hpp>
@@ -86,6 +87,9 @@ namespace stan {
        * Calculates the Evidence Lower BOund (ELBO) by sampling from
        * the variational distribution and then evaluating the log joint,
        * adjusted by the entropy term of the variational distribution.
+       * The log joint is evaluated at the draws on up to
+       * <code>STAN_NUM_THREADS</code> threads, with the same result for
+       * any number of threads.
        *
        * @param[in] variational variational approximation at which to evaluate
        * the ELBO.
@@ -102,33 +106,15 @@ namespace stan {
         static const char* function =
           "stan::variational::advi::calc_ELBO";
 
-        double elbo = 0.0;
-        int dim = variational.dimension();
-        Eigen::VectorXd zeta(dim);
+        Eigen::VectorXd log_prob;
+        log_prob_draws(variational, model_, n_monte_carlo_elbo_,
+                       n_monte_carlo_elbo_, rng_, logger, function,
+                       log_prob);
 
-        int n_dropped_evaluations = 0;
-        for (int i = 0; i < n_monte_carlo_elbo_;) {
-          variational.sample(rng_, zeta);
-          try {
-            std::stringstream ss;
-            double log_prob = model_.template log_prob<false, true>(zeta, &ss);
-            if (ss.str().length() > 0)
-              logger.info(ss);
-            stan::math::check_finite(function, "log_prob", log_prob);
-            elbo += log_prob;
-            ++i;
-          } catch (const std::domain_error& e) {
-            ++n_dropped_evaluations;
-            if (n_dropped_evaluations >= n_monte_carlo_elbo_) {
-              const char* name = "The number of dropped evaluations";
-              const char* msg1 = "has reached its maximum amount (";
-              const char* msg2 = "). Your model may be either severely "
-                "ill-conditioned or misspecified.";
-              stan::math::domain_error(function, name, n_monte_carlo_elbo_,
-                                       msg1, msg2);
-            }
-          }
-        }
+        // Sum in draw order so the result does not depend on threading
+        double elbo = 0.0;
+        for (int i = 0; i < n_monte_carlo_elbo_; ++i)
+          elbo += log_prob(i);
         elbo /= n_monte_carlo_elbo_;
         elbo += variational.entropy();
         return elbo;
@@ -5,6 +5,7 @@
 #include <stan/math/prim/mat.hpp>
 #include <stan/model/gradient.hpp>
 #include <stan/variational/base_family.hpp>
+#include <stan/variational/monte_carlo_draws.hpp>
 #include <algorithm>
 #include <ostream>
 #include <vector>
@@ -383,7 +384,10 @@ namespace stan {
        * Calculates the "blackbox" gradient with respect to BOTH the
        * location vector (mu) and the cholesky factor of the scale
        * matrix (L_chol) in parallel. It uses the same gradient
-       * computed from a set of Monte Carlo samples
+       * computed from a set of Monte Carlo samples.  The gradients
+       * at the samples are evaluated on up to
+       * <code>STAN_NUM_THREADS</code> threads, with the same result
+       * for any number of threads.
        *
        * @tparam M Model class.
        * @tparam BaseRNG Class of base random number generator.
@@ -413,44 +417,22 @@ namespace stan {
                         "Dimension of variational q", dimension_,
                         "Dimension of variables in model", cont_params.size());
 
-        Eigen::VectorXd mu_grad = Eigen::VectorXd::Zero(dimension_);
-        Eigen::MatrixXd L_grad  = Eigen::MatrixXd::Zero(dimension_, dimension_);
-        double tmp_lp = 0.0;
-        Eigen::VectorXd tmp_mu_grad = Eigen::VectorXd::Zero(dimension_);
-        Eigen::VectorXd eta = Eigen::VectorXd::Zero(dimension_);
-        Eigen::VectorXd zeta = Eigen::VectorXd::Zero(dimension_);
-
         // Naive Monte Carlo integration
         static const int n_retries = 10;
-        for (int i = 0, n_monte_carlo_drop = 0; i < n_monte_carlo_grad; ) {
-          // Draw from standard normal and transform to real-coordinate space
-          for (int d = 0; d < dimension_; ++d) {
-            eta(d) = stan::math::normal_rng(0, 1, rng);
-          }
-          zeta = transform(eta);
-          try {
-            std::stringstream ss;
-            stan::model::gradient(m, zeta, tmp_lp, tmp_mu_grad, &ss);
-            if (ss.str().length() > 0)
-              logger.info(ss);
-            stan::math::check_finite(function, "Gradient of mu", tmp_mu_grad);
-
-            mu_grad += tmp_mu_grad;
-            for (int ii = 0; ii < dimension_; ++ii) {
-              for (int jj = 0; jj <= ii; ++jj) {
-                L_grad(ii, jj) += tmp_mu_grad(ii) * eta(jj);
-              }
-            }
-            ++i;
-          } catch (const std::exception& e) {
-            ++n_monte_carlo_drop;
-            if (n_monte_carlo_drop >= n_retries * n_monte_carlo_grad) {
-              const char* name = "The number of dropped evaluations";
-              const char* msg1 = "has reached its maximum amount (";
-              int y = n_retries * n_monte_carlo_grad;
-              const char* msg2 = "). Your model may be either severely "
-                "ill-conditioned or misspecified.";
-              stan::math::domain_error(function, name, y, msg1, msg2);
+        Eigen::MatrixXd eta;
+        Eigen::MatrixXd grad;
+        gradient_draws(*this, m, n_monte_carlo_grad,
+                       n_retries * n_monte_carlo_grad, rng, logger,
+                       function, eta, grad);
+
+        // Sum in draw order so the result does not depend on threading
+        Eigen::VectorXd mu_grad = Eigen::VectorXd::Zero(dimension_);
+        Eigen::MatrixXd L_grad  = Eigen::MatrixXd::Zero(dimension_, dimension_);
+        for (int i = 0; i < n_monte_carlo_grad; ++i) {
+          mu_grad += grad.col(i);
+          for (int ii = 0; ii < dimension_; ++ii) {
+            for (int jj = 0; jj <= ii; ++jj) {
+              L_grad(ii, jj) += grad(ii, i) * eta(jj, i);
             }
           }
         }
@@ -0,0 +1,229 @@
+#ifndef STAN_VARIATIONAL_MONTE_CARLO_DRAWS_HPP
+#define STAN_VARIATIONAL_MONTE_CARLO_DRAWS_HPP
+
+#include <stan/callbacks/logger.hpp>
+#include <stan/math/prim/mat.hpp>
+#include <stan/math/prim/arr/functor/run_chunks_concurrent.hpp>
+#include <stan/model/gradient.hpp>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace stan {
+
+  namespace variational {
+
+    namespace internal {
+
+      /**
+       * Throw a domain error reporting that the maximum number of
+       * dropped evaluations was reached.
+       *
+       * @param[in] function name of the calling function
+       * @param[in] max_dropped maximum number of dropped evaluations
+       * @throw std::domain_error always
+       */
+      inline void throw_max_dropped(const char* function, int max_dropped) {
+        const char* name = "The number of dropped evaluations";
+        const char* msg1 = "has reached its maximum amount (";
+        const char* msg2 = "). Your model may be either severely "
+          "ill-conditioned or misspecified.";
+        stan::math::domain_error(function, name, max_dropped, msg1, msg2);
+      }
+
+      /**
+       * Log the messages and count the dropped draws of a batch in
+       * draw order, as if the draws had been evaluated one at a time,
+       * and return the indexes of the draws which were kept.
+       *
+       * The message of a draw is only logged if its evaluation
+       * returned, and no messages are logged after the maximum number
+       * of dropped draws is reached.
+       *
+       * @param[in] msgs messages of the draws
+       * @param[in] returned whether the evaluation of each draw returned
+       * @param[in] dropped whether each draw was dropped
+       * @param[in] max_dropped maximum number of dropped draws
+       * @param[in,out] n_dropped number of draws dropped so far
+       * @param[in,out] logger logger for messages
+       * @param[in] function name of the calling function for errors
+       * @return indexes of the kept draws, in draw order
+       * @throw std::domain_error if max_dropped draws have been dropped
+       */
+      inline std::vector<int>
+      keep_draws(const std::vector<std::stringstream>& msgs,
+                 const std::vector<char>& returned,
+                 const std::vector<char>& dropped, int max_dropped,
+                 int& n_dropped, callbacks::logger& logger,
+                 const char* function) {
+        std::vector<int> kept;
+        for (size_t j = 0; j < msgs.size(); ++j) {
+          if (returned[j] && msgs[j].str().length() > 0)
+            logger.info(msgs[j]);
+          if (!dropped[j])
+            kept.push_back(j);
+          else if (++n_dropped >= max_dropped)
+            throw_max_dropped(function, max_dropped);
+        }
+        return kept;
+      }
+
+    }
+
+    /**
+     * Evaluate the log density of the model at the specified number
+     * of draws from the variational approximation.
+     *
+     * A draw whose log density throws a domain error or is not finite
+     * is dropped, and the log densities are those of the first
+     * <code>n_draws</code> draws which are kept.  The draws are
+     * generated on the calling thread in batches of as many draws as
+     * are still missing, so the random number generator is advanced,
+     * and the same draws are kept and messages logged, exactly as by
+     * drawing and evaluating one draw at a time.  The log densities of
+     * a batch are evaluated on up to <code>STAN_NUM_THREADS</code>
+     * threads when Stan is compiled with <code>STAN_THREADS</code>.
+     *
+     * @tparam Q class of variational distribution
+     * @tparam M class of model
+     * @tparam BaseRNG class of random number generator
+     * @param[in] variational variational approximation to draw from
+     * @param[in] m model
+     * @param[in] n_draws number of draws
+     * @param[in] max_dropped maximum number of dropped draws
+     * @param[in,out] rng random number generator
+     * @param[in,out] logger logger for messages
+     * @param[in] function name of the calling function for errors
+     * @param[out] log_prob log densities of the draws
+     * @throw std::domain_error if max_dropped draws have been dropped
+     */
+    template <class Q, class M, class BaseRNG>
+    void log_prob_draws(const Q& variational, M& m, int n_draws,
+                        int max_dropped, BaseRNG& rng,
+                        callbacks::logger& logger, const char* function,
+                        Eigen::VectorXd& log_prob) {
+      const int dim = variational.dimension();
+      log_prob.resize(n_draws);
+      Eigen::VectorXd zeta_k(dim);
+
+      int n_kept = 0;
+      int n_dropped = 0;
+      while (n_kept < n_draws) {
+        const int n_batch = n_draws - n_kept;
+        Eigen::MatrixXd zeta(dim, n_batch);
+        for (int j = 0; j < n_batch; ++j) {
+          variational.sample(rng, zeta_k);
+          zeta.col(j) = zeta_k;
+        }
+        Eigen::VectorXd lp(n_batch);
+        std::vector<std::stringstream> msgs(n_batch);
+        std::vector<char> returned(n_batch, 0);
+        std::vector<char> dropped(n_batch, 0);
+
+        auto execute_chunk = [&](int start, int size, std::ostream* out) {
+          for (int j = start; j < start + size; ++j) {
+            try {
+              Eigen::VectorXd zeta_j = zeta.col(j);
+              lp(j) = m.template log_prob<false, true>(zeta_j, &msgs[j]);
+              returned[j] = 1;
+              stan::math::check_finite(function, "log_prob", lp(j));
+            } catch (const std::domain_error& e) {
+              dropped[j] = 1;
+            }
+          }
+        };
+        stan::math::internal::run_chunks_concurrent(n_batch, execute_chunk,
+                                                    0);
+
+        std::vector<int> kept
+          = internal::keep_draws(msgs, returned, dropped, max_dropped,
+                                 n_dropped, logger, function);
+        for (size_t j = 0; j < kept.size(); ++j)
+          log_prob(n_kept++) = lp(kept[j]);
+      }
+    }
+
+    /**
+     * Evaluate the gradient of the log density of the model at the
+     * specified number of draws from the variational approximation.
+     *
+     * Column k of <code>eta</code> is the k-th kept standard normal
+     * draw and column k of <code>grad</code> the gradient at its
+     * transform by the variational approximation.  A draw whose
+     * gradient throws or is not finite is dropped.  The draws are
+     * generated on the calling thread in batches of as many draws as
+     * are still missing, so the random number generator is advanced,
+     * and the same draws are kept and messages logged, exactly as by
+     * drawing and evaluating one draw at a time.  The gradients of a
+     * batch are evaluated on up to <code>STAN_NUM_THREADS</code>
+     * threads when Stan is compiled with <code>STAN_THREADS</code>,
+     * each on the autodiff stack of its thread.
+     *
+     * @tparam Q class of variational distribution
+     * @tparam M class of model
+     * @tparam BaseRNG class of random number generator
+     * @param[in] variational variational approximation to draw from
+     * @param[in] m model
+     * @param[in] n_draws number of draws
+     * @param[in] max_dropped maximum number of dropped draws
+     * @param[in,out] rng random number generator
+     * @param[in,out] logger logger for messages
+     * @param[in] function name of the calling function for errors
+     * @param[out] eta standard normal draws, one per column
+     * @param[out] grad gradients at the draws, one per column
+     * @throw std::domain_error if max_dropped draws have been dropped
+     */
+    template <class Q, class M, class BaseRNG>
+    void gradient_draws(const Q& variational, M& m, int n_draws,
+                        int max_dropped, BaseRNG& rng,
+                        callbacks::logger& logger, const char* function,
+                        Eigen::MatrixXd& eta, Eigen::MatrixXd& grad) {
+      const int dim = variational.dimension();
+      eta.resize(dim, n_draws);
+      grad.resize(dim, n_draws);
+
+      int n_kept = 0;
+      int n_dropped = 0;
+      while (n_kept < n_draws) {
+        const int n_batch = n_draws - n_kept;
+        Eigen::MatrixXd eta_batch(dim, n_batch);
+        for (int j = 0; j < n_batch; ++j)
+          for (int d = 0; d < dim; ++d)
+            eta_batch(d, j) = stan::math::normal_rng(0, 1, rng);
+        Eigen::MatrixXd grad_batch(dim, n_batch);
+        std::vector<std::stringstream> msgs(n_batch);
+        std::vector<char> returned(n_batch, 0);
+        std::vector<char> dropped(n_batch, 0);
+
+        auto execute_chunk = [&](int start, int size, std::ostream* out) {
+          double lp = 0.0;
+          Eigen::VectorXd grad_j(dim);
+          for (int j = start; j < start + size; ++j) {
+            Eigen::VectorXd zeta = variational.transform(eta_batch.col(j));
+            try {
+              stan::model::gradient(m, zeta, lp, grad_j, &msgs[j]);
+              returned[j] = 1;
+              stan::math::check_finite(function, "Gradient of mu", grad_j);
+              grad_batch.col(j) = grad_j;
+            } catch (const std::exception& e) {
+              dropped[j] = 1;
+            }
+          }
+        };
+        stan::math::internal::run_chunks_concurrent(n_batch, execute_chunk,
+                                                    0);
+
+        std::vector<int> kept
+          = internal::keep_draws(msgs, returned, dropped, max_dropped,
+                                 n_dropped, logger, function);
+        for (size_t j = 0; j < kept.size(); ++j) {
+          eta.col(n_kept) = eta_batch.col(kept[j]);
+          grad.col(n_kept) = grad_batch.col(kept[j]);
+          ++n_kept;
+        }
+      }
+    }
+
+  }
+}
+#endif
@@ -0,0 +1,94 @@
+#include <gtest/gtest.h>
+#include <stan/callbacks/async_writer.hpp>
+#include <stan/callbacks/stream_writer.hpp>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// writer which takes a millisecond per draw and counts them
+class slow_writer : public stan::callbacks::writer {
+public:
+  slow_writer() : count_(0) { }
+  void operator()(const std::vector<double>& state) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++count_;
+  }
+  std::atomic<int> count_;
+};
+
+class throwing_writer : public stan::callbacks::writer {
+public:
+  void operator()(const std::string& message) {
+    throw std::domain_error(message);
+  }
+};
+
+// writer which records whether the draws had arrived when flushed
+class flushed_writer : public stan::callbacks::writer {
+public:
+  flushed_writer() : count_(0), flushed_count_(-1) { }
+  void operator()(const std::vector<double>& state) {
+    ++count_;
+  }
+  void flush() {
+    flushed_count_ = count_;
+  }
+  int count_;
+  int flushed_count_;
+};
+
+TEST(StanInterfaceCallbacksAsyncWriter, forwards_in_order) {
+  std::stringstream ss;
+  stan::callbacks::stream_writer stream(ss, "# ");
+  {
+    stan::callbacks::async_writer writer(stream, 2);
+    std::vector<std::string> names;
+    names.push_back("a");
+    names.push_back("b");
+    writer(names);
+    for (int n = 0; n < 5; ++n)
+      writer(std::vector<double>(2, n));
+    writer("message");
+    writer();
+    writer.flush();
+    EXPECT_EQ("a,b\n0,0\n1,1\n2,2\n3,3\n4,4\n# message\n# \n", ss.str());
+    writer(std::vector<double>(1, 5));
+  }
+  // the destructor flushes
+  EXPECT_EQ("a,b\n0,0\n1,1\n2,2\n3,3\n4,4\n# message\n# \n5\n", ss.str());
+}
+
+TEST(StanInterfaceCallbacksAsyncWriter, back_pressure) {
+  slow_writer slow;
+  stan::callbacks::async_writer writer(slow, 4);
+  for (int n = 1; n <= 40; ++n) {
+    writer(std::vector<double>(3, n));
+    // at most 4 draws wait and one is being written
+    EXPECT_LE(n - slow.count_.load(), 5);
+  }
+  writer.flush();
+  EXPECT_EQ(40, slow.count_.load());
+}
+
+TEST(StanInterfaceCallbacksAsyncWriter, forwards_flush) {
+  flushed_writer flushed;
+  stan::callbacks::async_writer writer(flushed);
+  for (int n = 0; n < 10; ++n)
+    writer(std::vector<double>(1, n));
+  writer.flush();
+  EXPECT_EQ(10, flushed.flushed_count_);
+}
+
+TEST(StanInterfaceCallbacksAsyncWriter, exceptions) {
+  throwing_writer throwing;
+  stan::callbacks::async_writer writer(throwing);
+  writer(std::vector<double>(1, 0));
+  writer("error");
+  EXPECT_THROW(writer.flush(), std::domain_error);
+  EXPECT_NO_THROW(writer("dropped"));
+  EXPECT_NO_THROW(writer.flush());
+}
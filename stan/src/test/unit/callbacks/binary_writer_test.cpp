@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <stan/callbacks/binary_writer.hpp>
+#include <boost/cstdint.hpp>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+class StanInterfaceCallbacksBinaryWriter: public ::testing::Test {
+public:
+  void SetUp() {
+    ss.str(std::string());
+    ss.clear();
+  }
+
+  template <typename T>
+  T read() {
+    T x;
+    ss.read(reinterpret_cast<char*>(&x), sizeof(x));
+    return x;
+  }
+
+  std::string read_string() {
+    std::string s(read<boost::uint64_t>(), ' ');
+    ss.read(&s[0], s.size());
+    return s;
+  }
+
+  void read_file_header() {
+    char magic[8];
+    ss.read(magic, 8);
+    EXPECT_EQ(0, std::memcmp(magic, stan::callbacks::binary_writer::magic(),
+                             8));
+    EXPECT_EQ(1U, read<boost::uint32_t>());
+    EXPECT_EQ(0x01020304U, read<boost::uint32_t>());
+  }
+
+  std::stringstream ss;
+};
+
+TEST_F(StanInterfaceCallbacksBinaryWriter, comments) {
+  {
+    stan::callbacks::binary_writer writer(ss);
+    writer("message");
+    writer();
+  }
+  read_file_header();
+  EXPECT_EQ('C', ss.get());
+  EXPECT_EQ("message", read_string());
+  EXPECT_EQ('C', ss.get());
+  EXPECT_EQ(0U, read<boost::uint64_t>());
+  EXPECT_EQ(EOF, ss.get());
+}
+
+TEST_F(StanInterfaceCallbacksBinaryWriter, header) {
+  std::vector<std::string> names;
+  names.push_back("lp__");
+  names.push_back("a.1.1");
+  names.push_back("a.2.1");
+  names.push_back("a.1.2");
+  names.push_back("a.2.2");
+  names.push_back("a.1.3");
+  names.push_back("a.2.3");
+  names.push_back("b.1");
+  names.push_back("c.1");
+  names.push_back("c.3");
+  {
+    stan::callbacks::binary_writer writer(ss);
+    writer(names);
+  }
+  read_file_header();
+  EXPECT_EQ('H', ss.get());
+  ASSERT_EQ(names.size(), read<boost::uint64_t>());
+  for (size_t n = 0; n < names.size(); ++n)
+    EXPECT_EQ(names[n], read_string());
+
+  // c.1 and c.3 are not a complete array
+  ASSERT_EQ(5U, read<boost::uint64_t>());
+  EXPECT_EQ("lp__", read_string());
+  EXPECT_EQ(0U, read<boost::uint64_t>());
+  EXPECT_EQ(0U, read<boost::uint64_t>());
+  EXPECT_EQ("a", read_string());
+  EXPECT_EQ(1U, read<boost::uint64_t>());
+  ASSERT_EQ(2U, read<boost::uint64_t>());
+  EXPECT_EQ(2U, read<boost::uint64_t>());
+  EXPECT_EQ(3U, read<boost::uint64_t>());
+  EXPECT_EQ("b", read_string());
+  EXPECT_EQ(7U, read<boost::uint64_t>());
+  ASSERT_EQ(1U, read<boost::uint64_t>());
+  EXPECT_EQ(1U, read<boost::uint64_t>());
+  EXPECT_EQ("c.1", read_string());
+  EXPECT_EQ(8U, read<boost::uint64_t>());
+  EXPECT_EQ(0U, read<boost::uint64_t>());
+  EXPECT_EQ("c.3", read_string());
+  EXPECT_EQ(9U, read<boost::uint64_t>());
+  EXPECT_EQ(0U, read<boost::uint64_t>());
+  EXPECT_EQ(EOF, ss.get());
+}
+
+TEST_F(StanInterfaceCallbacksBinaryWriter, blocks) {
+  {
+    // blocks of two draws of three values
+    stan::callbacks::binary_writer writer(ss, 6 * sizeof(double));
+    for (int n = 0; n < 3; ++n) {
+      std::vector<double> x;
+      for (int c = 0; c < 3; ++c)
+        x.push_back(10 * n + c);
+      writer(x);
+    }
+    writer("done");
+    writer(std::vector<double>(1, 7.5));
+  }
+  read_file_header();
+  EXPECT_EQ('D', ss.get());
+  EXPECT_EQ(2U, read<boost::uint64_t>());
+  EXPECT_EQ(3U, read<boost::uint64_t>());
+  const double block1[] = { 0, 10, 1, 11, 2, 12 };
+  for (int i = 0; i < 6; ++i)
+    EXPECT_FLOAT_EQ(block1[i], read<double>());
+  EXPECT_EQ('D', ss.get());
+  EXPECT_EQ(1U, read<boost::uint64_t>());
+  EXPECT_EQ(3U, read<boost::uint64_t>());
+  for (int c = 0; c < 3; ++c)
+    EXPECT_FLOAT_EQ(20 + c, read<double>());
+  EXPECT_EQ('C', ss.get());
+  EXPECT_EQ("done", read_string());
+  EXPECT_EQ('D', ss.get());
+  EXPECT_EQ(1U, read<boost::uint64_t>());
+  EXPECT_EQ(1U, read<boost::uint64_t>());
+  EXPECT_FLOAT_EQ(7.5, read<double>());
+  EXPECT_EQ(EOF, ss.get());
+}
+
+TEST_F(StanInterfaceCallbacksBinaryWriter, flush_through_writer) {
+  stan::callbacks::binary_writer binary_writer(ss);
+  stan::callbacks::writer& writer = binary_writer;
+  writer(std::vector<double>(2, 1.5));
+  read_file_header();
+  EXPECT_EQ(EOF, ss.get());
+  ss.clear();
+
+  writer.flush();
+  EXPECT_EQ('D', ss.get());
+  EXPECT_EQ(1U, read<boost::uint64_t>());
+  EXPECT_EQ(2U, read<boost::uint64_t>());
+  EXPECT_FLOAT_EQ(1.5, read<double>());
+  EXPECT_FLOAT_EQ(1.5, read<double>());
+  EXPECT_EQ(EOF, ss.get());
+}
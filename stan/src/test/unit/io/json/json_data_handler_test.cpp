@@ -6,6 +6,13 @@
 #include <stan/io/json/json_handler.hpp>
 #include <stan/io/json/json_parser.hpp>
 
+size_t array_size(const std::vector<size_t>& dims) {
+  size_t size = 1;
+  for (size_t i = 0; i < dims.size(); ++i)
+    size *= dims[i];
+  return size;
+}
+
 void test_rtl_2_ltr(size_t idx_rtl,
                     size_t idx_ltr,
                     const std::vector<size_t>& dims) {
@@ -13,18 +20,24 @@ void test_rtl_2_ltr(size_t idx_rtl,
   stan::json::vars_map_i vars_i;
   stan::json::json_data_handler handler(vars_r, vars_i);
 
-  size_t idx = handler.convert_offset_rtl_2_ltr(idx_rtl,dims);
-  EXPECT_EQ(idx, idx_ltr);
+  std::vector<size_t> rm_vals(array_size(dims));
+  for (size_t i = 0; i < rm_vals.size(); ++i)
+    rm_vals[i] = i;
+  std::vector<size_t> cm_vals(rm_vals.size());
+  handler.to_column_major(cm_vals, rm_vals, dims);
+  EXPECT_EQ(idx_rtl, cm_vals[idx_ltr]);
 }
 
-void test_exception(size_t idx_rtl,
+void test_exception(size_t num_vals,
                     const std::string& exception_text,
                     const std::vector<size_t>& dims) {
   stan::json::vars_map_r vars_r;
   stan::json::vars_map_i vars_i;
   stan::json::json_data_handler handler(vars_r, vars_i);
+  std::vector<double> rm_vals(num_vals);
+  std::vector<double> cm_vals(array_size(dims));
   try {
-    handler.convert_offset_rtl_2_ltr(idx_rtl,dims);
+    handler.to_column_major(cm_vals, rm_vals, dims);
   } catch (const std::exception& e) {
     EXPECT_EQ(e.what(), exception_text);
     return;
@@ -67,19 +80,19 @@ TEST(ioJson,rtl_2_ltr_2) {
 TEST(ioJson,rtl_2_ltr_err_1) {
   std::vector<size_t> dims(1);
   dims[0] = 7;
-  test_exception(7,"variable: , unexpected error",dims);
+  test_exception(8,"variable: , unexpected error",dims);
 }
 
 TEST(ioJson,rtl_2_ltr_err_2) {
   std::vector<size_t> dims(2);
   dims[0] = 2;
   dims[1] = 4;
-  test_exception(8,"variable: , unexpected error",dims);
+  test_exception(9,"variable: , unexpected error",dims);
 }
 
 TEST(ioJson,rtl_2_ltr_err_3n) {
   std::vector<size_t> dims(2);
   dims[0] = 2;
   dims[1] = 4;
-  test_exception(11,"variable: , unexpected error",dims);
+  test_exception(7,"variable: , unexpected error",dims);
 }
@@ -401,3 +401,23 @@ TEST(ioJson,jsonData_parse_mult_objects) {
   EXPECT_EQ("foo",var_names[0]);
 }
 
+
+TEST(ioJson,jsonData_char_range) {
+  std::string txt = "{ \"foo\" : [[1, 2, 3], [4, 5, 6]], \"bar\" : 1.5 }";
+  stan::json::json_data jdata(txt.data(), txt.data() + txt.size());
+  std::vector<int> expected_vals_i;
+  expected_vals_i.push_back(1);
+  expected_vals_i.push_back(4);
+  expected_vals_i.push_back(2);
+  expected_vals_i.push_back(5);
+  expected_vals_i.push_back(3);
+  expected_vals_i.push_back(6);
+  std::vector<size_t> expected_dims_i;
+  expected_dims_i.push_back(2);
+  expected_dims_i.push_back(3);
+  test_int_var(jdata,txt,"foo",expected_vals_i,expected_dims_i);
+  std::vector<double> expected_vals_r;
+  expected_vals_r.push_back(1.5);
+  std::vector<size_t> expected_dims_r;
+  test_real_var(jdata,txt,"bar",expected_vals_r,expected_dims_r);
+}
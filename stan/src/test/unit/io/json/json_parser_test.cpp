@@ -591,3 +591,114 @@ TEST(ioJson,jsonParserErr19d) {
   test_exception("[ 9.19191919191919e1000000000000 ]",
                  "number exceeds double range\n");
 }
+
+TEST(ioJson,jsonParserErr19e) {
+  test_exception("[ -9223372036854775809 ]",
+                 "number exceeds integer range\n");
+}
+
+TEST(ioJson,jsonParserIntRange) {
+  test_parser("[ 18446744073709551615, -9223372036854775808 ]",
+              "S:textS:arrUL(INT):18446744073709551615"
+              "L(INT):-9223372036854775808E:arrE:text");
+}
+
+TEST(ioJson,jsonParserLongDouble) {
+  // too many digits for the fast conversion
+  recording_handler handler;
+  std::stringstream s("[ 0.1000000000000000000000000000000000000000000000"
+                      "000000000000000000000000000001, 1e-320, 1.5e300 ]");
+  stan::json::parse(s, handler);
+  EXPECT_EQ("S:textS:arrD(REAL):0.1D(REAL):9.99989e-321D(REAL):1.5e+300"
+            "E:arrE:text", handler.os_.str());
+}
+
+TEST(ioJson,jsonParserCharRange) {
+  std::string txt = "{ \"foo\" : [ 1, -2.5e1 ], \"bar\" : \"\\u00E9\" }";
+  recording_handler handler;
+  stan::json::parse(txt.data(), txt.data() + txt.size(), handler);
+  EXPECT_EQ("S:textS:objKEY:\"foo\"S:arrUL(INT):1D(REAL):-25E:arr"
+            "KEY:\"bar\"STR:\"\xC3\xA9\"E:objE:text", handler.os_.str());
+}
+
+TEST(ioJson,jsonParserLargeArray) {
+  // large enough to be split into chunks when STAN_NUM_THREADS > 1
+  setenv("STAN_NUM_THREADS", "4", 1);
+  std::stringstream txt;
+  std::stringstream expected;
+  txt << "{ \"foo\" : [";
+  expected << "S:textS:objKEY:\"foo\"S:arr";
+  for (int i = 0; i < 500000; ++i) {
+    txt << (i ? ",\n " : "") << i << ", -" << i << ".5";
+    expected << "UL(INT):" << i << "D(REAL):" << -i - 0.5;
+  }
+  txt << "] }";
+  expected << "E:arrE:objE:text";
+
+  recording_handler handler;
+  std::string input = txt.str();
+  stan::json::parse(input.data(), input.data() + input.size(), handler);
+  EXPECT_TRUE(expected.str() == handler.os_.str());
+
+  std::string bad = input.substr(0, input.size() / 2) + "true"
+    + input.substr(input.size() / 2);
+  EXPECT_THROW(stan::json::parse(bad.data(), bad.data() + bad.size(),
+                                 handler),
+               stan::json::json_error);
+  test_exception(bad, "in array, expecting ] or ,\n");
+  bad = input.substr(0, input.size() - 3) + ", ] }";
+  EXPECT_THROW(stan::json::parse(bad.data(), bad.data() + bad.size(),
+                                 handler),
+               stan::json::json_error);
+  test_exception(bad, "in array, expecting value\n");
+  unsetenv("STAN_NUM_THREADS");
+}
+
+// stream buffer which cannot seek, serving the text in small pieces
+class unseekable_buf : public std::streambuf {
+public:
+  explicit unseekable_buf(const std::string& text) : text_(text), pos_(0) {
+  }
+
+protected:
+  int_type underflow() {
+    if (pos_ == text_.size())
+      return traits_type::eof();
+    size_t n = std::min<size_t>(7, text_.size() - pos_);
+    char* p = &text_[pos_];
+    pos_ += n;
+    setg(p, p, p + n);
+    return traits_type::to_int_type(*p);
+  }
+
+private:
+  std::string text_;
+  size_t pos_;
+};
+
+TEST(ioJson,jsonParserStreams) {
+  std::stringstream txt;
+  std::stringstream expected;
+  txt << "[";
+  expected << "S:textS:arr";
+  for (int i = 0; i < 2000; ++i) {
+    txt << (i ? ", " : "") << i;
+    expected << "UL(INT):" << i;
+  }
+  txt << "]";
+  expected << "E:arrE:text";
+
+  recording_handler handler;
+  unseekable_buf buf(txt.str());
+  std::istream in(&buf);
+  stan::json::parse(in, handler);
+  EXPECT_EQ(expected.str(), handler.os_.str());
+
+  // only the rest of the stream is parsed
+  recording_handler rest_handler;
+  std::stringstream s("skipped [ 1 ]");
+  std::string skipped;
+  s >> skipped;
+  stan::json::parse(s, rest_handler);
+  EXPECT_EQ("S:textS:arrUL(INT):1E:arrE:text", rest_handler.os_.str());
+}
@@ -1,8 +1,13 @@
 #include <stan/io/stan_csv_reader.hpp>
+#include <stan/callbacks/binary_writer.hpp>
 #include <test/unit/util.hpp>
+#include <boost/lexical_cast.hpp>
 #include <gtest/gtest.h>
+#include <cmath>
 #include <fstream>
 #include <sstream>
+#include <string>
+#include <vector>
 
 class StanIoStanCsvReader : public testing::Test {
   
@@ -383,3 +388,190 @@ TEST_F(StanIoStanCsvReader,ParseBlocker) {
 
   EXPECT_EQ("", out.str());
 }
+
+// write a csv file through binary_writer, line by line
+void csv_to_binary(std::istream& in, stan::callbacks::binary_writer& writer) {
+  std::string line;
+  while (std::getline(in, line)) {
+    std::vector<std::string> tokens;
+    std::stringstream ss(line);
+    std::string token;
+    if (line.find('#') == 0) {
+      writer(line.substr(line.find_first_not_of("# ") == std::string::npos
+                         ? line.size() : 2));
+    } else if (line.find("lp__") == 0) {
+      while (std::getline(ss, token, ','))
+        tokens.push_back(token);
+      writer(tokens);
+    } else if (!line.empty()) {
+      std::vector<double> values;
+      while (std::getline(ss, token, ','))
+        values.push_back(boost::lexical_cast<double>(token));
+      writer(values);
+    }
+  }
+}
+
+TEST_F(StanIoStanCsvReader,ParseBinaryBlocker) {
+  std::stringstream out;
+  stan::io::stan_csv csv = stan::io::stan_csv_reader::parse(blocker0_stream,
+                                                            &out);
+  blocker0_stream.clear();
+  blocker0_stream.seekg(0);
+  std::stringstream binary;
+  {
+    // blocks of 5 draws of 55 columns
+    stan::callbacks::binary_writer writer(binary, 5 * 55 * sizeof(double));
+    csv_to_binary(blocker0_stream, writer);
+  }
+  stan::io::stan_csv parsed = stan::io::stan_csv_reader::parse(binary, &out);
+
+  EXPECT_EQ(csv.metadata.model, parsed.metadata.model);
+  EXPECT_EQ(csv.metadata.seed, parsed.metadata.seed);
+  EXPECT_EQ(csv.metadata.num_samples, parsed.metadata.num_samples);
+  EXPECT_EQ(csv.metadata.algorithm, parsed.metadata.algorithm);
+  ASSERT_EQ(csv.header.size(), parsed.header.size());
+  for (int n = 0; n < csv.header.size(); ++n)
+    EXPECT_EQ(csv.header(n), parsed.header(n));
+  EXPECT_FLOAT_EQ(csv.adaptation.step_size, parsed.adaptation.step_size);
+  ASSERT_EQ(csv.adaptation.metric.size(), parsed.adaptation.metric.size());
+  for (int n = 0; n < csv.adaptation.metric.size(); ++n)
+    EXPECT_FLOAT_EQ(csv.adaptation.metric(n), parsed.adaptation.metric(n));
+  ASSERT_EQ(csv.samples.rows(), parsed.samples.rows());
+  ASSERT_EQ(csv.samples.cols(), parsed.samples.cols());
+  for (int n = 0; n < csv.samples.size(); ++n)
+    EXPECT_FLOAT_EQ(csv.samples(n), parsed.samples(n));
+  EXPECT_FLOAT_EQ(csv.timing.warmup, parsed.timing.warmup);
+  EXPECT_FLOAT_EQ(csv.timing.sampling, parsed.timing.sampling);
+}
+
+TEST_F(StanIoStanCsvReader,ParseBinaryErrors) {
+  std::stringstream out;
+  std::stringstream truncated;
+  {
+    stan::callbacks::binary_writer writer(truncated);
+    writer(std::vector<std::string>(2, "x"));
+    writer(std::vector<double>(2, 1.0));
+  }
+  std::string bytes = truncated.str();
+  std::stringstream in1(bytes.substr(0, bytes.size() - 3));
+  EXPECT_THROW(stan::io::stan_csv_reader::parse(in1, &out),
+               std::invalid_argument);
+
+  std::stringstream no_header;
+  {
+    stan::callbacks::binary_writer writer(no_header);
+    writer("comment");
+  }
+  EXPECT_THROW(stan::io::stan_csv_reader::parse(no_header, &out),
+               std::invalid_argument);
+
+  std::string wrong_version = bytes;
+  wrong_version[8] = 9;
+  std::stringstream in2(wrong_version);
+  EXPECT_THROW(stan::io::stan_csv_reader::parse(in2, &out),
+               std::invalid_argument);
+}
+
+TEST_F(StanIoStanCsvReader,ParseFileBlocker) {
+  std::stringstream out;
+  stan::io::stan_csv csv = stan::io::stan_csv_reader::parse(blocker0_stream,
+                                                            &out);
+  stan::io::stan_csv mapped = stan::io::stan_csv_reader::parse_file(
+      "src/test/unit/io/test_csv_files/blocker.0.csv", &out);
+  EXPECT_EQ("", out.str());
+  EXPECT_EQ(csv.metadata.model, mapped.metadata.model);
+  ASSERT_EQ(csv.header.size(), mapped.header.size());
+  EXPECT_EQ(csv.header(54), mapped.header(54));
+  EXPECT_FLOAT_EQ(csv.adaptation.step_size, mapped.adaptation.step_size);
+  ASSERT_EQ(1000, mapped.samples.rows());
+  ASSERT_EQ(55, mapped.samples.cols());
+  for (int n = 0; n < csv.samples.size(); ++n)
+    EXPECT_FLOAT_EQ(csv.samples(n), mapped.samples(n));
+  EXPECT_FLOAT_EQ(0.391415, mapped.timing.warmup);
+  EXPECT_FLOAT_EQ(0.648336, mapped.timing.sampling);
+
+  EXPECT_THROW(stan::io::stan_csv_reader::parse_file("no_such_file.csv",
+                                                     &out),
+               std::invalid_argument);
+}
+
+TEST_F(StanIoStanCsvReader,read_samples_values) {
+  std::stringstream in("1, -2.5e3 ,+0.125\r\n"
+                       "\n"
+                       "# comment\n"
+                       "1.5E-300,12345678901234567890123,nan\n"
+                       "-inf,0.1,-0\n");
+  Eigen::MatrixXd samples;
+  stan::io::stan_csv_timing timing;
+  ASSERT_TRUE(stan::io::stan_csv_reader::read_samples(in, samples, timing,
+                                                      0));
+  ASSERT_EQ(3, samples.rows());
+  ASSERT_EQ(3, samples.cols());
+  EXPECT_EQ(1, samples(0, 0));
+  EXPECT_EQ(-2500, samples(0, 1));
+  EXPECT_EQ(0.125, samples(0, 2));
+  EXPECT_EQ(1.5e-300, samples(1, 0));
+  EXPECT_EQ(1.2345678901234567890123e22, samples(1, 1));
+  EXPECT_TRUE(std::isnan(samples(1, 2)));
+  EXPECT_TRUE(std::isinf(samples(2, 0)) && samples(2, 0) < 0);
+  EXPECT_EQ(0.1, samples(2, 1));
+  EXPECT_EQ(0, samples(2, 2));
+}
+
+TEST_F(StanIoStanCsvReader,read_samples_crlf) {
+  std::stringstream in("1,2,3\r\n"
+                       "\r\n"
+                       "4,5,6\r\n"
+                       "\r\n"
+                       "#  Elapsed Time: 0.25 seconds (Warm-up)\r\n"
+                       "#                0.5 seconds (Sampling)\r\n"
+                       "\r\n");
+  Eigen::MatrixXd samples;
+  stan::io::stan_csv_timing timing;
+  ASSERT_TRUE(stan::io::stan_csv_reader::read_samples(in, samples, timing,
+                                                      0));
+  ASSERT_EQ(2, samples.rows());
+  ASSERT_EQ(3, samples.cols());
+  for (int i = 0; i < 6; ++i)
+    EXPECT_EQ(i + 1, samples(i / 3, i % 3));
+  EXPECT_FLOAT_EQ(0.25, timing.warmup);
+  EXPECT_FLOAT_EQ(0.5, timing.sampling);
+}
+
+TEST_F(StanIoStanCsvReader,read_samples_errors) {
+  std::stringstream out;
+  std::stringstream columns("1,2,3\n4,5\n");
+  Eigen::MatrixXd samples;
+  stan::io::stan_csv_timing timing;
+  EXPECT_FALSE(stan::io::stan_csv_reader::read_samples(columns, samples,
+                                                       timing, &out));
+  EXPECT_EQ("Error: expected 3 columns, but found 2 instead for row 2\n",
+            out.str());
+  EXPECT_EQ(0, samples.size());
+
+  std::stringstream values("1,2,3\n4,x5,6\n");
+  EXPECT_THROW(stan::io::stan_csv_reader::read_samples(values, samples,
+                                                       timing, &out),
+               boost::bad_lexical_cast);
+}
+
+TEST_F(StanIoStanCsvReader,read_samples_threads) {
+  // enough values to be parsed on several threads
+  std::stringstream in;
+  for (int row = 0; row < 2000; ++row) {
+    for (int col = 0; col < 50; ++col)
+      in << (col ? "," : "") << row * 0.001 - col;
+    in << "\n";
+  }
+  std::string csv = in.str();
+  Eigen::MatrixXd samples;
+  stan::io::stan_csv_timing timing;
+  ASSERT_TRUE(stan::io::stan_csv_reader::read_samples(
+      csv.data(), csv.data() + csv.size(), samples, timing, 0, 4));
+  ASSERT_EQ(2000, samples.rows());
+  ASSERT_EQ(50, samples.cols());
+  for (int row = 0; row < 2000; ++row)
+    for (int col = 0; col < 50; ++col)
+      EXPECT_FLOAT_EQ(row * 0.001 - col, samples(row, col));
+}
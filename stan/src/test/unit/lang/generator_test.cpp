@@ -511,3 +511,15 @@ TEST(genArrayBuilderAdds, addScalars) {
   stan::lang::generate_array_builder_adds(elts, true, o2);
   EXPECT_EQ(3, count_matches(".add(", o2.str()));
 }
+
+TEST(langGenerator, fvarVarLogProbFlag) {
+  expect_match("integrate_ode_rk45",
+               "static const bool fvar_var_log_prob = false;");
+  expect_match("algebra_solver_good",
+               "static const bool fvar_var_log_prob = false;");
+  expect_match("map_rect",
+               "static const bool fvar_var_log_prob = false;");
+  expect_matches(0,
+                 "parameters { real y; } model { y ~ normal(0, 1); }",
+                 "fvar_var_log_prob");
+}
@@ -283,3 +283,9 @@ TEST(lang_parser, wishart_distribution_function_signatures) {
 TEST(lang_parser, rng_distribution_function_signatures) {
   test_parsable("function-signatures/distributions/rngs");
 }
+
+TEST(lang_parser, glm_distribution_function_signatures) {
+  test_parsable("function-signatures/distributions/glm/bernoulli_logit_glm");
+  test_parsable("function-signatures/distributions/glm/normal_id_glm");
+  test_parsable("function-signatures/distributions/glm/poisson_log_glm");
+}
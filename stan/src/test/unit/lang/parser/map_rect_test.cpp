@@ -0,0 +1,21 @@
+#include <gtest/gtest.h>
+#include <test/unit/lang/utility.hpp>
+
+TEST(lang_parser, map_rect_good) {
+  test_parsable("map_rect");
+}
+
+TEST(lang_parser, map_rect_bad) {
+  test_throws("map_rect/bad_fun_type",
+              "first argument to map_rect must be the name of a function with signature");
+  test_throws("map_rect/bad_shared_type",
+              "second argument to map_rect must have type vector");
+  test_throws("map_rect/bad_job_type",
+              "third argument to map_rect must have type vector[]");
+  test_throws("map_rect/bad_x_r_type",
+              "fourth argument to map_rect must have type real[ , ]");
+  test_throws("map_rect/bad_x_i_type",
+              "fifth argument to map_rect must have type int[ , ]");
+  test_throws("map_rect/bad_x_r_var_type",
+              "fourth argument to map_rect (real data) must be data only");
+}
@@ -123,6 +123,38 @@ TEST(lang_parser, exp_matrix_function_signatures) {
   test_parsable("function-signatures/math/matrix/exp");
 }
 
+TEST(lang_parser, gp_dot_prod_cov_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/gp_dot_prod_cov");
+}
+
+TEST(lang_parser, gp_exp_quad_cholesky_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/gp_exp_quad_cholesky");
+}
+
+TEST(lang_parser, gp_matern32_cholesky_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/gp_matern32_cholesky");
+}
+
+TEST(lang_parser, gp_matern32_cov_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/gp_matern32_cov");
+}
+
+TEST(lang_parser, gp_matern52_cholesky_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/gp_matern52_cholesky");
+}
+
+TEST(lang_parser, gp_matern52_cov_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/gp_matern52_cov");
+}
+
+TEST(lang_parser, gp_periodic_cholesky_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/gp_periodic_cholesky");
+}
+
+TEST(lang_parser, gp_periodic_cov_matrix_function_signatures) {
+  test_parsable("function-signatures/math/matrix/gp_periodic_cov");
+}
+
 TEST(lang_parser, head_matrix_function_signatures) {
   test_parsable("function-signatures/math/matrix/head");
 }
@@ -119,3 +119,23 @@ TEST(lang_parser, integrate_ode_bdf_control_bad) {
   test_throws("ode/bad_x_var_type_bdf_control",
       "sixth argument to integrate_ode_bdf (real data) must be data only");
 }
+TEST(lang_parser, integrate_ode_adjoint_good) {
+  test_parsable("integrate_ode_adjoint");
+}
+TEST(lang_parser, integrate_ode_adjoint_bad) {
+  test_throws("ode/bad_fun_type_adjoint",
+      "first argument to integrate_ode_adjoint must be the name of a function with signature");
+  test_throws("ode/bad_t0_var_type_adjoint",
+      "third argument to integrate_ode_adjoint (initial times) must be data only");
+  test_throws("ode/bad_x_var_type_adjoint",
+      "sixth argument to integrate_ode_adjoint (real data) must be data only");
+}
+TEST(lang_parser, integrate_ode_bdf_batch_good) {
+  test_parsable("integrate_ode_bdf_batch");
+}
+TEST(lang_parser, integrate_ode_bdf_batch_bad) {
+  test_throws("ode/bad_y_type_bdf_batch",
+      "second argument to integrate_ode_bdf_batch must have type real[,]");
+  test_throws("ode/bad_x_var_type_bdf_batch",
+      "sixth argument to integrate_ode_bdf_batch (real data) must be data only");
+}
@@ -73,3 +73,11 @@ TEST(unitLang, algebra_solverTest) {
   test_pg("algebra_solver", expected);
   test_pg_count("algebra_solver", expected, 1);
 }
+
+TEST(unitLang, map_rectTest) {
+  std::string expected;
+  expected = "stan::math::assign(y, "
+    "map_rect<1, mapped_functor__>(phi, theta, x_r, x_i, pstream__));";
+  test_pg("map_rect", expected);
+  test_pg_count("map_rect", expected, 2);
+}
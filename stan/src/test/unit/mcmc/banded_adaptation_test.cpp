@@ -0,0 +1,62 @@
+#include <stan/mcmc/banded_adaptation.hpp>
+#include <stan/mcmc/covar_adaptation.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+#include <gtest/gtest.h>
+
+TEST(McmcBandedAdaptation, learn_band) {
+  stan::test::unit::instrumented_logger logger;
+
+  const int n = 10;
+  Eigen::VectorXd q = Eigen::VectorXd::Zero(n);
+  Eigen::MatrixXd e_metric_band(Eigen::MatrixXd::Zero(3, n));
+
+  const int n_learn = 10;
+
+  double target_e_metric = 1 / (1e-3 * 5.0 / (n_learn + 5.0));
+
+  stan::mcmc::banded_adaptation adapter(n, 2);
+  adapter.set_window_params(50, 0, 0, n_learn, logger);
+
+  for (int i = 0; i < n_learn; ++i)
+    adapter.learn_band(e_metric_band, q);
+
+  ASSERT_EQ(3, e_metric_band.rows());
+  for (int j = 0; j < n; ++j) {
+    EXPECT_FLOAT_EQ(target_e_metric, e_metric_band(0, j));
+    for (int k = 1; k < 3; ++k)
+      EXPECT_EQ(0, e_metric_band(k, j));
+  }
+  EXPECT_EQ(0, logger.call_count());
+}
+
+TEST(McmcBandedAdaptation, full_bandwidth_matches_covar_adaptation) {
+  stan::test::unit::instrumented_logger logger;
+
+  const int n = 4;
+  const int n_learn = 30;
+
+  Eigen::MatrixXd e_metric_band(Eigen::MatrixXd::Zero(n, n));
+  Eigen::MatrixXd covar(Eigen::MatrixXd::Zero(n, n));
+
+  stan::mcmc::banded_adaptation banded_adapter(n, n + 5);
+  banded_adapter.set_window_params(100, 0, 0, n_learn, logger);
+  stan::mcmc::covar_adaptation covar_adapter(n);
+  covar_adapter.set_window_params(100, 0, 0, n_learn, logger);
+
+  for (int i = 0; i < n_learn; ++i) {
+    Eigen::VectorXd q(n);
+    q << std::sin(0.7 * i), std::sin(0.7 * i) + std::cos(1.9 * i),
+      std::cos(0.3 * i), std::sin(2.3 * i) - std::cos(1.9 * i);
+    banded_adapter.learn_band(e_metric_band, q);
+    covar_adapter.learn_covariance(covar, q);
+  }
+
+  // bandwidth is clamped to n - 1, which gives the full precision
+  ASSERT_EQ(n, e_metric_band.rows());
+  Eigen::MatrixXd e_metric = covar.inverse();
+  for (int k = 0; k < n; ++k)
+    for (int j = 0; j + k < n; ++j)
+      EXPECT_NEAR(e_metric(j + k, j), e_metric_band(k, j),
+                  1e-8 * e_metric.norm());
+  EXPECT_EQ(0, logger.call_count());
+}
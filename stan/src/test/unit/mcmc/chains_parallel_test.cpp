@@ -0,0 +1,55 @@
+#define STAN_THREADS
+#include <stan/mcmc/chains.hpp>
+#include <stan/io/stan_csv_reader.hpp>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+class McmcChainsParallel : public testing::Test {
+public:
+  void SetUp() {
+    std::stringstream out;
+    std::ifstream epil1_stream("src/test/unit/mcmc/test_csv_files/epil.1.csv");
+    std::ifstream epil2_stream("src/test/unit/mcmc/test_csv_files/epil.2.csv");
+    epil1 = stan::io::stan_csv_reader::parse(epil1_stream, &out);
+    epil2 = stan::io::stan_csv_reader::parse(epil2_stream, &out);
+    probs.resize(3);
+    probs << 0.05, 0.5, 0.95;
+  }
+
+  void TearDown() {
+    unsetenv("STAN_NUM_THREADS");
+  }
+
+  stan::io::stan_csv epil1, epil2;
+  Eigen::VectorXd probs;
+};
+
+TEST_F(McmcChainsParallel, summary_matches_serial) {
+  stan::mcmc::chains<> chains(epil1);
+  chains.add(epil2);
+
+  unsetenv("STAN_NUM_THREADS");
+  Eigen::MatrixXd expected = chains.summary(probs);
+
+  const char* num_threads[] = { "3", "-1", "1000" };
+  for (int k = 0; k < 3; k++) {
+    setenv("STAN_NUM_THREADS", num_threads[k], 1);
+    Eigen::MatrixXd values = chains.summary(probs);
+    ASSERT_EQ(expected.rows(), values.rows());
+    ASSERT_EQ(expected.cols(), values.cols());
+    for (int i = 0; i < values.rows(); i++)
+      for (int j = 0; j < values.cols(); j++)
+        EXPECT_EQ(expected(i, j), values(i, j))
+          << "STAN_NUM_THREADS=" << num_threads[k]
+          << ", parameter: " << chains.param_name(i);
+  }
+}
+
+TEST_F(McmcChainsParallel, bad_num_threads) {
+  stan::mcmc::chains<> chains(epil1);
+  setenv("STAN_NUM_THREADS", "0", 1);
+  EXPECT_THROW(chains.summary(probs), std::invalid_argument);
+}
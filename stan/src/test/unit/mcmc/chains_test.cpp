@@ -884,3 +884,30 @@ TEST_F(McmcChains,blocker_split_potential_scale_reduction) {
   }
 
 }
+
+TEST_F(McmcChains,blocker_summary) {
+  std::stringstream out;
+  stan::io::stan_csv blocker1 = stan::io::stan_csv_reader::parse(blocker1_stream, &out);
+  stan::io::stan_csv blocker2 = stan::io::stan_csv_reader::parse(blocker2_stream, &out);
+  EXPECT_EQ("", out.str());
+
+  stan::mcmc::chains<> chains(blocker1);
+  chains.add(blocker2);
+
+  Eigen::VectorXd probs(3);
+  probs << 0.05, 0.5, 0.95;
+  Eigen::MatrixXd values = chains.summary(probs);
+  ASSERT_EQ(chains.num_params(), values.rows());
+  ASSERT_EQ(7, values.cols());
+
+  for (int index = 0; index < chains.num_params(); index++) {
+    EXPECT_FLOAT_EQ(chains.mean(index), values(index, 0));
+    EXPECT_FLOAT_EQ(chains.sd(index), values(index, 1));
+    Eigen::VectorXd quantiles = chains.quantiles(index, probs);
+    for (int j = 0; j < 3; j++)
+      EXPECT_FLOAT_EQ(quantiles(j), values(index, 2 + j));
+    EXPECT_FLOAT_EQ(chains.effective_sample_size(index), values(index, 5));
+    EXPECT_FLOAT_EQ(chains.split_potential_scale_reduction(index),
+                    values(index, 6));
+  }
+}
@@ -0,0 +1,183 @@
+#include <stan/mcmc/convergence_monitor.hpp>
+#include <stan/mcmc/chains.hpp>
+#include <gtest/gtest.h>
+#include <boost/random/additive_combine.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class McmcConvergenceMonitor : public testing::Test {
+public:
+  void SetUp() {
+    names.push_back("lp__");
+    names.push_back("accept_stat__");
+    names.push_back("stepsize__");
+    names.push_back("mu");
+    names.push_back("tau");
+  }
+
+  // autoregressive draws with a different correlation per parameter
+  Eigen::MatrixXd ar_draws(int num_draws, unsigned int seed) {
+    boost::ecuyer1988 rng(seed);
+    boost::variate_generator<boost::ecuyer1988&,
+                             boost::normal_distribution<> >
+      normal(rng, boost::normal_distribution<>());
+    Eigen::MatrixXd draws(num_draws, names.size());
+    Eigen::VectorXd x = Eigen::VectorXd::Zero(names.size());
+    for (int i = 0; i < num_draws; ++i) {
+      for (size_t p = 0; p < names.size(); ++p) {
+        double rho = 0.1 + 0.2 * p;
+        x(p) = rho * x(p) + normal();
+        draws(i, p) = x(p);
+      }
+    }
+    return draws;
+  }
+
+  std::vector<double> row(const Eigen::MatrixXd& draws, int i) {
+    std::vector<double> draw(draws.cols());
+    for (int p = 0; p < draws.cols(); ++p)
+      draw[p] = draws(i, p);
+    return draw;
+  }
+
+  std::vector<std::string> names;
+};
+
+TEST_F(McmcConvergenceMonitor, constructor_throws) {
+  EXPECT_THROW(stan::mcmc::convergence_monitor(0, 100), std::domain_error);
+  EXPECT_THROW(stan::mcmc::convergence_monitor(4, 0), std::domain_error);
+  EXPECT_THROW(stan::mcmc::convergence_monitor(4, 100, 0), std::domain_error);
+}
+
+TEST_F(McmcConvergenceMonitor, names) {
+  stan::mcmc::convergence_monitor monitor(2, 100);
+  monitor.set_names(names);
+  std::vector<std::string> other;
+  other.push_back("x");
+  monitor.set_names(other);
+
+  std::vector<std::string> monitored = monitor.names();
+  ASSERT_EQ(3U, monitored.size());
+  EXPECT_EQ("lp__", monitored[0]);
+  EXPECT_EQ("mu", monitored[1]);
+  EXPECT_EQ("tau", monitored[2]);
+}
+
+TEST_F(McmcConvergenceMonitor, matches_chains) {
+  const int num_chains = 3;
+  const int num_draws = 500;
+  stan::mcmc::convergence_monitor monitor(num_chains, 1e10, 100);
+  monitor.set_names(names);
+  stan::mcmc::chains<> chains(names);
+
+  for (int c = 0; c < num_chains; ++c) {
+    Eigen::MatrixXd draws = ar_draws(num_draws, 1234 + c);
+    chains.add(c, draws);
+    for (int i = 0; i < num_draws; ++i)
+      monitor.add_draw(c, row(draws, i));
+    // not every chain has reached the interval yet
+    if (c < num_chains - 1) {
+      EXPECT_EQ(0U, monitor.num_draws());
+    }
+  }
+
+  EXPECT_EQ(500U, monitor.num_draws());
+  EXPECT_FALSE(monitor.target_reached());
+  std::vector<double> ess = monitor.ess();
+  std::vector<double> rhat = monitor.rhat();
+  std::vector<std::string> monitored = monitor.names();
+  ASSERT_EQ(3U, ess.size());
+  ASSERT_EQ(3U, rhat.size());
+  for (size_t p = 0; p < monitored.size(); ++p) {
+    EXPECT_FLOAT_EQ(chains.effective_sample_size(monitored[p]), ess[p])
+      << monitored[p];
+    EXPECT_FLOAT_EQ(chains.split_potential_scale_reduction(monitored[p]),
+                    rhat[p])
+      << monitored[p];
+  }
+  EXPECT_FLOAT_EQ(*std::min_element(ess.begin(), ess.end()),
+                  monitor.min_ess());
+  EXPECT_FLOAT_EQ(*std::max_element(rhat.begin(), rhat.end()),
+                  monitor.max_rhat());
+}
+
+TEST_F(McmcConvergenceMonitor, concurrent_chains) {
+  const int num_chains = 3;
+  const int num_draws = 500;
+  stan::mcmc::convergence_monitor monitor(num_chains, 1e10, 20);
+  monitor.set_names(names);
+  stan::mcmc::chains<> chains(names);
+
+  std::vector<Eigen::MatrixXd> draws;
+  for (int c = 0; c < num_chains; ++c) {
+    draws.push_back(ar_draws(num_draws, 1234 + c));
+    chains.add(c, draws.back());
+  }
+  std::vector<std::thread> threads;
+  for (int c = 0; c < num_chains; ++c)
+    threads.push_back(std::thread([&, c]() {
+          for (int i = 0; i < num_draws; ++i)
+            monitor.add_draw(c, row(draws[c], i));
+        }));
+  for (size_t c = 0; c < threads.size(); ++c)
+    threads[c].join();
+
+  // the last interval is estimated before the last draw returns
+  EXPECT_EQ(500U, monitor.num_draws());
+  std::vector<double> ess = monitor.ess();
+  std::vector<double> rhat = monitor.rhat();
+  std::vector<std::string> monitored = monitor.names();
+  for (size_t p = 0; p < monitored.size(); ++p) {
+    EXPECT_FLOAT_EQ(chains.effective_sample_size(monitored[p]), ess[p])
+      << monitored[p];
+    EXPECT_FLOAT_EQ(chains.split_potential_scale_reduction(monitored[p]),
+                    rhat[p])
+      << monitored[p];
+  }
+}
+
+TEST_F(McmcConvergenceMonitor, uses_complete_intervals) {
+  stan::mcmc::convergence_monitor monitor(2, 1e10, 100);
+  monitor.set_names(names);
+  stan::mcmc::chains<> chains(names);
+
+  Eigen::MatrixXd draws0 = ar_draws(250, 1);
+  Eigen::MatrixXd draws1 = ar_draws(230, 2);
+  for (int i = 0; i < draws0.rows(); ++i)
+    monitor.add_draw(0, row(draws0, i));
+  for (int i = 0; i < draws1.rows(); ++i)
+    monitor.add_draw(1, row(draws1, i));
+  chains.add(0, draws0.topRows(200));
+  chains.add(1, draws1.topRows(200));
+
+  EXPECT_EQ(200U, monitor.num_draws());
+  std::vector<double> ess = monitor.ess();
+  std::vector<std::string> monitored = monitor.names();
+  for (size_t p = 0; p < monitored.size(); ++p)
+    EXPECT_FLOAT_EQ(chains.effective_sample_size(monitored[p]), ess[p])
+      << monitored[p];
+}
+
+TEST_F(McmcConvergenceMonitor, target_reached) {
+  stan::mcmc::convergence_monitor monitor(2, 50, 50);
+  monitor.set_names(names);
+  EXPECT_FALSE(monitor.target_reached());
+  EXPECT_EQ(0, monitor.min_ess());
+  EXPECT_TRUE(std::isnan(monitor.max_rhat()));
+
+  Eigen::MatrixXd draws0 = ar_draws(1000, 3);
+  Eigen::MatrixXd draws1 = ar_draws(1000, 4);
+  int i = 0;
+  for (; i < 1000 && !monitor.target_reached(); ++i) {
+    monitor.add_draw(0, row(draws0, i));
+    monitor.add_draw(1, row(draws1, i));
+  }
+  EXPECT_TRUE(monitor.target_reached());
+  EXPECT_LT(i, 1000);
+  EXPECT_EQ(0, i % 50);
+  EXPECT_GE(monitor.min_ess(), 50);
+}
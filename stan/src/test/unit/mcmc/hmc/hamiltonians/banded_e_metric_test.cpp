@@ -0,0 +1,241 @@
+#include <string>
+#include <boost/random/additive_combine.hpp>
+#include <stan/io/dump.hpp>
+#include <test/unit/mcmc/hmc/mock_hmc.hpp>
+#include <stan/mcmc/hmc/hamiltonians/banded_e_metric.hpp>
+#include <stan/mcmc/hmc/hamiltonians/dense_e_metric.hpp>
+#include <test/test-models/good/mcmc/hmc/hamiltonians/funnel.hpp>
+#include <stan/callbacks/stream_logger.hpp>
+#include <test/unit/util.hpp>
+#include <gtest/gtest.h>
+
+typedef boost::ecuyer1988 rng_t;
+
+namespace {
+  void set_test_metric(stan::mcmc::banded_e_point& z) {
+    int n = z.q.size();
+    Eigen::MatrixXd e_metric_band = Eigen::MatrixXd::Zero(3, n);
+    for (int j = 0; j < n; ++j) {
+      e_metric_band(0, j) = 2.0 + 0.1 * j;
+      if (j + 1 < n)
+        e_metric_band(1, j) = -0.6;
+      if (j + 2 < n)
+        e_metric_band(2, j) = 0.2;
+    }
+    z.set_metric(e_metric_band);
+  }
+
+  Eigen::MatrixXd band_to_dense(const stan::mcmc::banded_e_point& z) {
+    int n = z.e_metric_band_.cols();
+    Eigen::MatrixXd e_metric = Eigen::MatrixXd::Zero(n, n);
+    for (int k = 0; k < z.e_metric_band_.rows(); ++k)
+      for (int j = 0; j + k < n; ++j) {
+        e_metric(j + k, j) = z.e_metric_band_(k, j);
+        e_metric(j, j + k) = z.e_metric_band_(k, j);
+      }
+    return e_metric;
+  }
+}
+
+TEST(McmcBandedEMetric, sample_p) {
+  rng_t base_rng(0);
+
+  Eigen::VectorXd q(5);
+  q << 5, 1, -2, 0.5, 3;
+
+  stan::mcmc::mock_model model(q.size());
+
+  stan::mcmc::banded_e_metric<stan::mcmc::mock_model, rng_t> metric(model);
+  stan::mcmc::banded_e_point z(q.size());
+  set_test_metric(z);
+
+  int n_samples = 1000;
+  double m = 0;
+  double m2 = 0;
+
+  for (int i = 0; i < n_samples; ++i) {
+    metric.sample_p(z, base_rng);
+    double tau = metric.tau(z);
+
+    double delta = tau - m;
+    m += delta / static_cast<double>(i + 1);
+    m2 += delta * (tau - m);
+  }
+
+  double var = m2 / (n_samples + 1.0);
+
+  // Mean within 5sigma of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(m   - 0.5 * q.size()) < 5.0 * sqrt(var));
+
+  // Variance within 10% of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(var - 0.5 * q.size()) < 0.1 * q.size());
+}
+
+TEST(McmcBandedEMetric, dense_equivalent) {
+  int n = 6;
+  stan::mcmc::mock_model model(n);
+
+  stan::mcmc::banded_e_metric<stan::mcmc::mock_model, rng_t>
+    banded_metric(model);
+  stan::mcmc::banded_e_point z(n);
+  set_test_metric(z);
+
+  stan::mcmc::dense_e_metric<stan::mcmc::mock_model, rng_t>
+    dense_metric(model);
+  stan::mcmc::dense_e_point z_dense(n);
+  Eigen::MatrixXd e_metric = band_to_dense(z);
+  z_dense.set_metric(e_metric.inverse());
+
+  for (int i = 0; i < n; ++i)
+    z.p(i) = std::cos(1.0 + i);
+  z_dense.p = z.p;
+
+  EXPECT_FLOAT_EQ(dense_metric.T(z_dense), banded_metric.T(z));
+
+  Eigen::VectorXd dense_dtau_dp = dense_metric.dtau_dp(z_dense);
+  Eigen::VectorXd banded_dtau_dp = banded_metric.dtau_dp(z);
+  for (int i = 0; i < n; ++i)
+    EXPECT_FLOAT_EQ(dense_dtau_dp(i), banded_dtau_dp(i));
+
+  // the momentum covariance is the mass matrix
+  rng_t base_rng(0);
+  int n_samples = 20000;
+  Eigen::MatrixXd cov = Eigen::MatrixXd::Zero(n, n);
+  for (int s = 0; s < n_samples; ++s) {
+    banded_metric.sample_p(z, base_rng);
+    cov += z.p * z.p.transpose() / n_samples;
+  }
+  for (int i = 0; i < n; ++i)
+    for (int j = 0; j < n; ++j)
+      EXPECT_NEAR(e_metric(i, j), cov(i, j),
+                  0.05 * std::sqrt(e_metric(i, i) * e_metric(j, j)));
+}
+
+TEST(McmcBandedEMetric, set_metric_not_positive_definite) {
+  stan::mcmc::banded_e_point z(3);
+  Eigen::MatrixXd e_metric_band(2, 3);
+  e_metric_band << 1, 1, 1,
+                   2, 2, 0;
+  EXPECT_THROW(z.set_metric(e_metric_band), std::domain_error);
+}
+
+TEST(McmcBandedEMetric, gradients) {
+  rng_t base_rng(0);
+
+  Eigen::VectorXd q = Eigen::VectorXd::Ones(11);
+
+  stan::mcmc::banded_e_point z(q.size());
+  z.q = q;
+  z.p.setOnes();
+  set_test_metric(z);
+
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream model_output;
+  std::stringstream debug, info, warn, error, fatal;
+  stan::callbacks::stream_logger logger(debug, info, warn, error, fatal);
+
+  funnel_model_namespace::funnel_model model(data_var_context, &model_output);
+
+  stan::mcmc::banded_e_metric<funnel_model_namespace::funnel_model, rng_t>
+    metric(model);
+
+  double epsilon = 1e-6;
+
+  metric.init(z, logger);
+  Eigen::VectorXd g1 = metric.dtau_dq(z, logger);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+
+    double delta = 0;
+
+    z.q(i) += epsilon;
+    metric.update_potential(z, logger);
+    delta += metric.tau(z);
+
+    z.q(i) -= 2 * epsilon;
+    metric.update_potential(z, logger);
+    delta -= metric.tau(z);
+
+    z.q(i) += epsilon;
+    metric.update_potential(z, logger);
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g1(i), epsilon);
+  }
+
+  Eigen::VectorXd g2 = metric.dtau_dp(z);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+
+    double delta = 0;
+
+    z.p(i) += epsilon;
+    delta += metric.tau(z);
+
+    z.p(i) -= 2 * epsilon;
+    delta -= metric.tau(z);
+
+    z.p(i) += epsilon;
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g2(i), epsilon);
+  }
+
+  Eigen::VectorXd g3 = metric.dphi_dq(z, logger);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+
+    double delta = 0;
+
+    z.q(i) += epsilon;
+    metric.update_potential(z, logger);
+    delta += metric.phi(z);
+
+    z.q(i) -= 2 * epsilon;
+    metric.update_potential(z, logger);
+    delta -= metric.phi(z);
+
+    z.q(i) += epsilon;
+    metric.update_potential(z, logger);
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g3(i), epsilon);
+
+  }
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", debug.str());
+  EXPECT_EQ("", info.str());
+  EXPECT_EQ("", warn.str());
+  EXPECT_EQ("", error.str());
+  EXPECT_EQ("", fatal.str());
+}
+
+TEST(McmcBandedEMetric, streams) {
+  stan::test::capture_std_streams();
+
+  rng_t base_rng(0);
+
+  Eigen::VectorXd q(2);
+  q(0) = 5;
+  q(1) = 1;
+
+
+  stan::mcmc::mock_model model(q.size());
+
+  // typedef to use within Google Test macros
+  typedef stan::mcmc::banded_e_metric<stan::mcmc::mock_model, rng_t>
+    banded_e;
+
+  EXPECT_NO_THROW(banded_e metric(model));
+
+  stan::test::reset_std_streams();
+  EXPECT_EQ("", stan::test::cout_ss.str());
+  EXPECT_EQ("", stan::test::cerr_ss.str());
+}
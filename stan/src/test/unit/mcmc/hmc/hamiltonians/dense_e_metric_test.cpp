@@ -1,5 +1,7 @@
 #include <string>
 #include <boost/random/additive_combine.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
 #include <stan/io/dump.hpp>
 #include <test/unit/mcmc/hmc/mock_hmc.hpp>
 #include <stan/mcmc/hmc/hamiltonians/dense_e_metric.hpp>
@@ -44,6 +46,48 @@ TEST(McmcDenseEMetric, sample_p) {
   EXPECT_TRUE(std::fabs(var - 0.5 * q.size()) < 0.1 * q.size());
 }
 
+TEST(McmcDenseEMetric, sample_p_cached_cholesky) {
+  Eigen::MatrixXd inv_e_metric(3, 3);
+  inv_e_metric << 2.0, 0.5, 0.1,
+                  0.5, 1.0, 0.3,
+                  0.1, 0.3, 0.7;
+
+  stan::mcmc::mock_model model(3);
+  stan::mcmc::dense_e_metric<stan::mcmc::mock_model, rng_t> metric(model);
+  stan::mcmc::dense_e_point z(3);
+  z.set_metric(inv_e_metric);
+
+  rng_t base_rng(0);
+  rng_t check_rng(0);
+  boost::variate_generator<rng_t&, boost::normal_distribution<> >
+    rand_gaus(check_rng, boost::normal_distribution<>());
+
+  for (int n = 0; n < 10; ++n) {
+    metric.sample_p(z, base_rng);
+
+    Eigen::VectorXd u(3);
+    for (int i = 0; i < 3; ++i)
+      u(i) = rand_gaus();
+    Eigen::VectorXd p = inv_e_metric.llt().matrixL().solve(u);
+
+    for (int i = 0; i < 3; ++i)
+      EXPECT_FLOAT_EQ(p(i), z.p(i));
+  }
+
+  stan::mcmc::dense_e_point z_copy(z);
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_FLOAT_EQ(z.inv_e_metric_chol_(i, j),
+                      z_copy.inv_e_metric_chol_(i, j));
+
+  z.inv_e_metric_ = 4 * inv_e_metric;
+  z.update_metric();
+  Eigen::MatrixXd L = inv_e_metric.llt().matrixL();
+  for (int i = 0; i < 3; ++i)
+    for (int j = 0; j < 3; ++j)
+      EXPECT_FLOAT_EQ(2 * L(i, j), z.inv_e_metric_chol_(i, j));
+}
+
 TEST(McmcDenseEMetric, gradients) {
   rng_t base_rng(0);
 
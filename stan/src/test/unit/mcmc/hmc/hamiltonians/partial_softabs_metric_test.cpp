@@ -0,0 +1,342 @@
+#include <stan/io/dump.hpp>
+#include <stan/mcmc/hmc/hamiltonians/partial_softabs_metric.hpp>
+#include <stan/mcmc/hmc/hamiltonians/softabs_metric.hpp>
+#include <stan/callbacks/stream_logger.hpp>
+#include <test/unit/mcmc/hmc/mock_hmc.hpp>
+#include <test/test-models/good/mcmc/hmc/hamiltonians/funnel.hpp>
+#include <test/unit/util.hpp>
+
+#include <boost/random/additive_combine.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <vector>
+
+typedef boost::ecuyer1988 rng_t;
+typedef funnel_model_namespace::funnel_model funnel_t;
+
+TEST(McmcPartialSoftAbs, sample_p) {
+  rng_t base_rng(0);
+
+  Eigen::VectorXd q(2);
+  q(0) = 5;
+  q(1) = 1;
+
+  stan::mcmc::mock_model model(q.size());
+  stan::mcmc::partial_softabs_metric<stan::mcmc::mock_model, rng_t>
+    metric(model);
+  stan::mcmc::partial_softabs_point z(q.size());
+  z.set_subspace(Eigen::MatrixXd::Identity(2, 1), 3.0);
+
+  int n_samples = 1000;
+  double m = 0;
+  double m2 = 0;
+
+  std::stringstream debug, info, warn, error, fatal;
+  stan::callbacks::stream_logger logger(debug, info, warn, error, fatal);
+
+  metric.update_metric(z, logger);
+
+  for (int i = 0; i < n_samples; ++i) {
+    metric.sample_p(z, base_rng);
+    double tau = metric.tau(z);
+
+    double delta = tau - m;
+    m += delta / static_cast<double>(i + 1);
+    m2 += delta * (tau - m);
+  }
+
+  double var = m2 / (n_samples + 1.0);
+
+  // Mean within 5sigma of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(m   - 0.5 * q.size()) < 5.0 * sqrt(var));
+
+  // Variance within 10% of expected value (d / 2)
+  EXPECT_TRUE(std::fabs(var - 0.5 * q.size()) < 0.1 * q.size());
+
+  EXPECT_EQ("", debug.str());
+  EXPECT_EQ("", info.str());
+  EXPECT_EQ("", warn.str());
+  EXPECT_EQ("", error.str());
+  EXPECT_EQ("", fatal.str());
+}
+
+TEST(McmcPartialSoftAbs, full_subspace_matches_softabs) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream model_output;
+  std::stringstream debug, info, warn, error, fatal;
+  stan::callbacks::stream_logger logger(debug, info, warn, error, fatal);
+
+  funnel_t model(data_var_context, &model_output);
+
+  Eigen::VectorXd q(11);
+  Eigen::VectorXd p(11);
+  for (int i = 0; i < 11; ++i) {
+    q(i) = 0.3 * std::sin(1.0 + i);
+    p(i) = std::cos(2.0 + i);
+  }
+
+  stan::mcmc::softabs_metric<funnel_t, rng_t> softabs(model);
+  stan::mcmc::softabs_point z_softabs(11);
+  z_softabs.q = q;
+  z_softabs.p = p;
+  softabs.init(z_softabs, logger);
+
+  stan::mcmc::partial_softabs_metric<funnel_t, rng_t> metric(model);
+  stan::mcmc::partial_softabs_point z(11);
+  z.set_subspace(Eigen::MatrixXd::Identity(11, 11), 1.0);
+  z.q = q;
+  z.p = p;
+  metric.init(z, logger);
+
+  EXPECT_FLOAT_EQ(softabs.T(z_softabs), metric.T(z));
+  EXPECT_FLOAT_EQ(softabs.phi(z_softabs), metric.phi(z));
+
+  Eigen::VectorXd expected = softabs.dtau_dp(z_softabs);
+  Eigen::VectorXd actual = metric.dtau_dp(z);
+  for (int i = 0; i < 11; ++i)
+    EXPECT_NEAR(expected(i), actual(i), 1e-8);
+
+  expected = softabs.dtau_dq(z_softabs, logger);
+  actual = metric.dtau_dq(z, logger);
+  for (int i = 0; i < 11; ++i)
+    EXPECT_NEAR(expected(i), actual(i), 1e-8);
+
+  expected = softabs.dphi_dq(z_softabs, logger);
+  actual = metric.dphi_dq(z, logger);
+  for (int i = 0; i < 11; ++i)
+    EXPECT_NEAR(expected(i), actual(i), 1e-8);
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", error.str());
+}
+
+TEST(McmcPartialSoftAbs, gradients) {
+  Eigen::VectorXd q = Eigen::VectorXd::Ones(11);
+
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream model_output;
+  std::stringstream debug, info, warn, error, fatal;
+  stan::callbacks::stream_logger logger(debug, info, warn, error, fatal);
+
+  funnel_t model(data_var_context, &model_output);
+
+  stan::mcmc::partial_softabs_metric<funnel_t, rng_t> metric(model);
+  stan::mcmc::partial_softabs_point z(q.size());
+  z.q = q;
+  z.p.setOnes();
+  metric.update_subspace(z, 3, logger);
+  ASSERT_EQ(3, z.subspace.cols());
+
+  double epsilon = 1e-6;
+
+  metric.init(z, logger);
+  Eigen::VectorXd g1 = metric.dtau_dq(z, logger);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+
+    double delta = 0;
+
+    z.q(i) += epsilon;
+    metric.init(z, logger);
+    delta += metric.tau(z);
+
+    z.q(i) -= 2 * epsilon;
+    metric.init(z, logger);
+    delta -= metric.tau(z);
+
+    z.q(i) += epsilon;
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g1(i), epsilon);
+  }
+
+  metric.init(z, logger);
+  Eigen::VectorXd g2 = metric.dtau_dp(z);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+
+    double delta = 0;
+
+    z.p(i) += epsilon;
+    delta += metric.tau(z);
+
+    z.p(i) -= 2 * epsilon;
+    delta -= metric.tau(z);
+
+    z.p(i) += epsilon;
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g2(i), epsilon);
+  }
+
+  Eigen::VectorXd g3 = metric.dphi_dq(z, logger);
+
+  for (int i = 0; i < z.q.size(); ++i) {
+    double delta = 0;
+
+    z.q(i) += epsilon;
+    metric.init(z, logger);
+    delta += metric.phi(z);
+
+    z.q(i) -= 2 * epsilon;
+    metric.init(z, logger);
+    delta -= metric.phi(z);
+
+    z.q(i) += epsilon;
+
+    delta /= 2 * epsilon;
+
+    EXPECT_NEAR(delta, g3(i), epsilon);
+  }
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", debug.str());
+  EXPECT_EQ("", info.str());
+  EXPECT_EQ("", warn.str());
+  EXPECT_EQ("", error.str());
+  EXPECT_EQ("", fatal.str());
+}
+
+TEST(McmcPartialSoftAbs, update_subspace) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream model_output;
+  std::stringstream debug, info, warn, error, fatal;
+  stan::callbacks::stream_logger logger(debug, info, warn, error, fatal);
+
+  funnel_t model(data_var_context, &model_output);
+
+  Eigen::VectorXd q(11);
+  for (int i = 0; i < 11; ++i)
+    q(i) = 0.5 * std::cos(3.0 * i);
+
+  double lp;
+  Eigen::VectorXd grad;
+  Eigen::MatrixXd hessian;
+  stan::math::hessian(stan::mcmc::softabs_fun<funnel_t>(model, 0),
+                      q, lp, grad, hessian);
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(-hessian);
+
+  // distinct eigenvalue magnitudes in decreasing order
+  std::vector<double> lambda;
+  for (int i = 0; i < 11; ++i)
+    lambda.push_back(std::fabs(solver.eigenvalues()(i)));
+  std::sort(lambda.begin(), lambda.end(), std::greater<double>());
+  std::vector<double> distinct(1, lambda[0]);
+  for (size_t i = 1; i < lambda.size(); ++i)
+    if (distinct.back() - lambda[i] > 1e-8)
+      distinct.push_back(lambda[i]);
+  ASSERT_EQ(3U, distinct.size());
+
+  stan::mcmc::partial_softabs_metric<funnel_t, rng_t> metric(model);
+  stan::mcmc::partial_softabs_point z(11);
+  z.q = q;
+  metric.update_subspace(z, 2, logger);
+
+  ASSERT_EQ(2, z.subspace.cols());
+  Eigen::MatrixXd identity = z.subspace.transpose() * z.subspace;
+  for (int i = 0; i < 2; ++i)
+    for (int j = 0; j < 2; ++j)
+      EXPECT_NEAR(i == j ? 1 : 0, identity(i, j), 1e-10);
+
+  // the Krylov space is an invariant subspace spanned by one
+  // eigenvector for each distinct eigenvalue, so the Ritz values
+  // are exact
+  metric.init(z, logger);
+  std::vector<double> ritz(2);
+  for (int i = 0; i < 2; ++i)
+    ritz[i] = std::fabs(z.eigen_deco.eigenvalues()(i));
+  std::sort(ritz.begin(), ritz.end(), std::greater<double>());
+  EXPECT_NEAR(distinct[0], ritz[0], 1e-8 * distinct[0]);
+  EXPECT_NEAR(distinct[1], ritz[1], 1e-8 * distinct[0]);
+
+  double alpha_lambda = z.alpha * distinct[2];
+  EXPECT_NEAR(distinct[2] / std::tanh(alpha_lambda), z.complement_metric,
+              1e-8 * distinct[0]);
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", error.str());
+}
+
+TEST(McmcPartialSoftAbs, cached_metric) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  std::stringstream model_output;
+  std::stringstream debug, info, warn, error, fatal;
+  stan::callbacks::stream_logger logger(debug, info, warn, error, fatal);
+
+  funnel_t model(data_var_context, &model_output);
+
+  stan::mcmc::partial_softabs_metric<funnel_t, rng_t> metric(model);
+  metric.set_subspace_rank(2);
+
+  stan::mcmc::partial_softabs_point z(11);
+  z.q.setOnes();
+  z.p.setOnes();
+  EXPECT_FALSE(z.metric_current());
+  metric.init(z, logger);
+  EXPECT_EQ(2, z.subspace.cols());
+  EXPECT_TRUE(z.metric_current());
+  EXPECT_TRUE(z.metric_gradient_valid);
+
+  // the subspace is only recomputed on request
+  Eigen::MatrixXd subspace = z.subspace;
+  z.q(0) = 0.5;
+  metric.init(z, logger);
+  for (int i = 0; i < 11; ++i)
+    for (int j = 0; j < 2; ++j)
+      EXPECT_EQ(subspace(i, j), z.subspace(i, j));
+
+  // a point moved without updating its metric is refreshed before use
+  stan::mcmc::partial_softabs_point z_fresh(z);
+  z_fresh.q(1) = -0.5;
+  z_fresh.invalidate_metric();
+  metric.init(z_fresh, logger);
+
+  z.ps_point::operator=(z_fresh);
+  EXPECT_FALSE(z.metric_current());
+  Eigen::VectorXd dphi_dq = metric.dphi_dq(z, logger);
+  Eigen::VectorXd expected = metric.dphi_dq(z_fresh, logger);
+  EXPECT_TRUE(z.metric_current());
+  for (int i = 0; i < 11; ++i)
+    EXPECT_FLOAT_EQ(expected(i), dphi_dq(i));
+
+  EXPECT_EQ("", model_output.str());
+  EXPECT_EQ("", error.str());
+}
+
+TEST(McmcPartialSoftAbs, streams) {
+  stan::test::capture_std_streams();
+
+  Eigen::VectorXd q(2);
+  q(0) = 5;
+  q(1) = 1;
+
+  stan::mcmc::mock_model model(q.size());
+
+  // typedef to use within Google Test macros
+  typedef stan::mcmc::partial_softabs_metric<stan::mcmc::mock_model, rng_t>
+    partial_softabs;
+
+  EXPECT_NO_THROW(partial_softabs metric(model));
+
+  stan::test::reset_std_streams();
+  EXPECT_EQ("", stan::test::cout_ss.str());
+  EXPECT_EQ("", stan::test::cerr_ss.str());
+}
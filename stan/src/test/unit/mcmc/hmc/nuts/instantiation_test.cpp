@@ -3,9 +3,15 @@
 #include <stan/mcmc/hmc/nuts/unit_e_nuts.hpp>
 #include <stan/mcmc/hmc/nuts/diag_e_nuts.hpp>
 #include <stan/mcmc/hmc/nuts/dense_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/low_rank_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/banded_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/partial_softabs_nuts.hpp>
 #include <stan/mcmc/hmc/nuts/adapt_unit_e_nuts.hpp>
 #include <stan/mcmc/hmc/nuts/adapt_diag_e_nuts.hpp>
 #include <stan/mcmc/hmc/nuts/adapt_dense_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/adapt_low_rank_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/adapt_banded_e_nuts.hpp>
+#include <stan/mcmc/hmc/nuts/adapt_partial_softabs_nuts.hpp>
 #include <boost/random/additive_combine.hpp>
 #include <stan/io/dump.hpp>
 #include <fstream>
@@ -34,6 +40,16 @@ TEST(McmcNuts, instantiaton_test) {
   
   stan::mcmc::dense_e_nuts<gauss3D_model_namespace::gauss3D_model, rng_t>
     dense_e_sampler(model, base_rng);
+
+  stan::mcmc::low_rank_e_nuts<gauss3D_model_namespace::gauss3D_model, rng_t>
+    low_rank_e_sampler(model, base_rng);
+
+  stan::mcmc::banded_e_nuts<gauss3D_model_namespace::gauss3D_model, rng_t>
+    banded_e_sampler(model, base_rng);
+
+  stan::mcmc::partial_softabs_nuts<gauss3D_model_namespace::gauss3D_model,
+                                   rng_t>
+    partial_softabs_sampler(model, base_rng, 2);
   
   stan::mcmc::adapt_unit_e_nuts<gauss3D_model_namespace::gauss3D_model, rng_t>
     adapt_unit_e_sampler(model, base_rng);
@@ -43,4 +59,16 @@ TEST(McmcNuts, instantiaton_test) {
   
   stan::mcmc::adapt_dense_e_nuts<gauss3D_model_namespace::gauss3D_model, rng_t>
     adapt_dense_e_sampler(model, base_rng);
+
+  stan::mcmc::adapt_low_rank_e_nuts<gauss3D_model_namespace::gauss3D_model,
+                                    rng_t>
+    adapt_low_rank_e_sampler(model, base_rng, 2);
+
+  stan::mcmc::adapt_banded_e_nuts<gauss3D_model_namespace::gauss3D_model,
+                                  rng_t>
+    adapt_banded_e_sampler(model, base_rng, 1);
+
+  stan::mcmc::adapt_partial_softabs_nuts<
+    gauss3D_model_namespace::gauss3D_model, rng_t>
+    adapt_partial_softabs_sampler(model, base_rng, 2);
 }
@@ -0,0 +1,82 @@
+#include <stan/mcmc/low_rank_adaptation.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+#include <gtest/gtest.h>
+
+TEST(McmcLowRankAdaptation, learn_low_rank) {
+  stan::test::unit::instrumented_logger logger;
+
+  const int n = 10;
+  Eigen::VectorXd q = Eigen::VectorXd::Zero(n);
+  Eigen::VectorXd inv_metric(Eigen::VectorXd::Zero(n));
+  Eigen::MatrixXd inv_metric_low_rank(Eigen::MatrixXd::Zero(n, 2));
+
+  const int n_learn = 10;
+
+  Eigen::VectorXd target_inv_metric(Eigen::VectorXd::Ones(n));
+  target_inv_metric *= 1e-3 * 5.0 / (n_learn + 5.0);
+
+  stan::mcmc::low_rank_adaptation adapter(n, 2);
+  adapter.set_window_params(50, 0, 0, n_learn, logger);
+
+  for (int i = 0; i < n_learn; ++i)
+    adapter.learn_low_rank(inv_metric, inv_metric_low_rank, q);
+
+  for (int i = 0; i < n; ++i)
+    EXPECT_EQ(target_inv_metric(i), inv_metric(i));
+  EXPECT_EQ(0, inv_metric_low_rank.cols());
+  EXPECT_EQ(0, logger.call_count());
+}
+
+TEST(McmcLowRankAdaptation, learn_correlated_direction) {
+  stan::test::unit::instrumented_logger logger;
+
+  const int n = 4;
+  const int n_learn = 40;
+
+  // draws along (1, 1, 0, 0) plus small independent noise
+  std::vector<Eigen::VectorXd> draws;
+  for (int i = 0; i < n_learn; ++i) {
+    Eigen::VectorXd q(n);
+    double t = std::sin(0.7 * i) * 3;
+    q << t + 0.1 * std::cos(1.3 * i), t + 0.1 * std::sin(2.9 * i),
+      std::cos(0.4 * i), std::sin(1.1 * i);
+    draws.push_back(q);
+  }
+
+  Eigen::VectorXd inv_metric(Eigen::VectorXd::Ones(n));
+  Eigen::MatrixXd inv_metric_low_rank(n, 0);
+
+  stan::mcmc::low_rank_adaptation adapter(n, 1);
+  adapter.set_window_params(100, 0, 0, n_learn, logger);
+
+  for (int i = 0; i < n_learn; ++i)
+    adapter.learn_low_rank(inv_metric, inv_metric_low_rank, draws[i]);
+
+  Eigen::MatrixXd centered(n, n_learn);
+  for (int i = 0; i < n_learn; ++i)
+    centered.col(i) = draws[i];
+  centered.colwise() -= centered.rowwise().mean();
+  Eigen::MatrixXd covar = centered * centered.transpose() / (n_learn - 1.0);
+
+  const double a = n_learn / (n_learn + 5.0);
+  const double b = 1e-3 * 5.0 / (n_learn + 5.0);
+
+  ASSERT_EQ(1, inv_metric_low_rank.cols());
+  for (int i = 0; i < n; ++i)
+    EXPECT_FLOAT_EQ(a * covar(i, i) + b, inv_metric(i));
+
+  // the inverse metric has the regularized sample covariance along
+  // the principal direction of the scaled draws
+  Eigen::VectorXd sd = covar.diagonal().cwiseSqrt();
+  Eigen::MatrixXd corr = sd.cwiseInverse().asDiagonal() * covar
+    * sd.cwiseInverse().asDiagonal();
+  Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> solver(corr);
+  Eigen::VectorXd v = sd.cwiseInverse().asDiagonal()
+    * solver.eigenvectors().col(n - 1);
+
+  Eigen::MatrixXd inv_metric_dense = Eigen::MatrixXd(inv_metric.asDiagonal())
+    + inv_metric_low_rank * inv_metric_low_rank.transpose();
+  EXPECT_FLOAT_EQ(v.dot(a * covar * v) + b * v.squaredNorm(),
+                  v.dot(inv_metric_dense * v));
+  EXPECT_EQ(0, logger.call_count());
+}
@@ -0,0 +1,24 @@
+#include <stan/mcmc/subspace_adaptation.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+#include <gtest/gtest.h>
+#include <vector>
+
+TEST(McmcSubspaceAdaptation, learn_subspace) {
+  stan::test::unit::instrumented_logger logger;
+
+  stan::mcmc::subspace_adaptation adapter;
+  adapter.set_window_params(1000, 75, 50, 25, logger);
+
+  std::vector<int> updates;
+  for (int i = 0; i < 1000; ++i)
+    if (adapter.learn_subspace())
+      updates.push_back(i);
+
+  ASSERT_EQ(5U, updates.size());
+  EXPECT_EQ(99, updates[0]);
+  EXPECT_EQ(149, updates[1]);
+  EXPECT_EQ(249, updates[2]);
+  EXPECT_EQ(449, updates[3]);
+  EXPECT_EQ(949, updates[4]);
+  EXPECT_EQ(0, logger.call_count());
+}
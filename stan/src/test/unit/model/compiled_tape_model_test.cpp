@@ -0,0 +1,119 @@
+#include <stan/model/compiled_tape_model.hpp>
+#include <stan/model/gradient.hpp>
+#include <stan/model/log_prob_grad.hpp>
+#include <stan/io/dump.hpp>
+#include <test/test-models/good/model/compiled_tape_glm.hpp>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+typedef stan::model::compiled_tape_model<stan_model> compiled_stan_model;
+
+class ModelCompiledTapeModel : public testing::Test {
+public:
+  ModelCompiledTapeModel()
+    : data_stream("N <- 4\n"
+                  "x <- c(0.5, -1.2, 2.0, 0.3)\n"
+                  "y <- c(1.1, -0.4, 2.8, 0.9)\n"),
+      data(data_stream), params_i(0) {
+  }
+
+  void expect_log_prob_grad(compiled_stan_model& model,
+                            stan_model& plain, double alpha, double beta,
+                            double log_sigma) {
+    std::vector<double> params_r(3);
+    params_r[0] = alpha;
+    params_r[1] = beta;
+    params_r[2] = log_sigma;
+    std::vector<double> grad, grad_expected;
+    double lp = stan::model::log_prob_grad<true, true>(model, params_r,
+                                                       params_i, grad,
+                                                       &msgs);
+    double lp_expected
+      = stan::model::log_prob_grad<true, true>(plain, params_r, params_i,
+                                               grad_expected, &msgs);
+    EXPECT_FLOAT_EQ(lp_expected, lp);
+    ASSERT_EQ(grad_expected.size(), grad.size());
+    for (size_t n = 0; n < grad.size(); ++n)
+      EXPECT_FLOAT_EQ(grad_expected[n], grad[n]);
+  }
+
+  std::stringstream data_stream;
+  std::stringstream msgs;
+  stan::io::dump data;
+  std::vector<int> params_i;
+};
+
+TEST_F(ModelCompiledTapeModel, log_prob_grad) {
+  compiled_stan_model model(data, &msgs);
+  stan_model plain(data, &msgs);
+  EXPECT_EQ(3U, model.num_params_r());
+
+  expect_log_prob_grad(model, plain, 0.4, 0.8, -0.1);
+  EXPECT_EQ(1U, model.num_recordings());
+  EXPECT_EQ(0U, model.num_replays());
+  expect_log_prob_grad(model, plain, -0.7, 1.3, 0.5);
+  expect_log_prob_grad(model, plain, 1.1, 0.2, 0.0);
+  EXPECT_EQ(1U, model.num_recordings());
+  EXPECT_EQ(2U, model.num_replays());
+  EXPECT_TRUE((model.replay_enabled<true, true>()));
+
+  // the other branch of the if statement is recorded anew
+  expect_log_prob_grad(model, plain, 1.1, -0.6, 0.3);
+  EXPECT_EQ(2U, model.num_recordings());
+  expect_log_prob_grad(model, plain, 0.2, -1.4, -0.3);
+  EXPECT_EQ(2U, model.num_recordings());
+  EXPECT_EQ(3U, model.num_replays());
+
+  // double evaluations and other template arguments are separate
+  std::vector<double> params_r(3, 0.5);
+  EXPECT_FLOAT_EQ((plain.log_prob<false, false>(params_r, params_i)),
+                  (model.log_prob<false, false>(params_r, params_i)));
+  EXPECT_EQ(2U, model.num_recordings());
+}
+
+TEST_F(ModelCompiledTapeModel, gradient) {
+  compiled_stan_model model(data, &msgs);
+  stan_model plain(data, &msgs);
+  Eigen::VectorXd x(3);
+  x << 0.3, 0.9, 0.2;
+  double f, f_expected;
+  Eigen::VectorXd grad_f, grad_f_expected;
+  for (int i = 0; i < 3; ++i) {
+    x(0) += 0.25;
+    stan::model::gradient(model, x, f, grad_f, &msgs);
+    stan::model::gradient(plain, x, f_expected, grad_f_expected, &msgs);
+    EXPECT_FLOAT_EQ(f_expected, f);
+    for (int n = 0; n < 3; ++n)
+      EXPECT_FLOAT_EQ(grad_f_expected(n), grad_f(n));
+  }
+  EXPECT_EQ(2U, model.num_replays());
+}
+
+TEST_F(ModelCompiledTapeModel, check_interval) {
+  compiled_stan_model model(data, &msgs, 2);
+  stan_model plain(data, &msgs);
+  expect_log_prob_grad(model, plain, 0.4, 0.8, -0.1);
+  expect_log_prob_grad(model, plain, 0.5, 0.8, -0.1);
+  EXPECT_EQ(1U, model.num_recordings());
+  // second replay is checked against a recording
+  expect_log_prob_grad(model, plain, 0.6, 0.8, -0.1);
+  EXPECT_EQ(2U, model.num_recordings());
+  EXPECT_EQ(2U, model.num_replays());
+  EXPECT_TRUE((model.replay_enabled<true, true>()));
+}
+
+TEST_F(ModelCompiledTapeModel, non_finite) {
+  compiled_stan_model model(data, &msgs);
+  std::vector<double> params_r(3, 0.5);
+  std::vector<double> grad;
+  stan::model::log_prob_grad<true, true>(model, params_r, params_i, grad,
+                                         &msgs);
+  // a replay with an infinite log density falls back to log_prob()
+  params_r[2] = 1000;
+  double lp = stan::model::log_prob_grad<true, true>(model, params_r,
+                                                     params_i, grad, &msgs);
+  EXPECT_TRUE(stan::math::is_inf(lp));
+  EXPECT_EQ(2U, model.num_recordings());
+  EXPECT_EQ(0U, model.num_replays());
+}
@@ -0,0 +1,123 @@
+#define STAN_THREADS
+#include <stan/model/grad_hess_log_prob.hpp>
+#include <stan/model/hessian_times_vector.hpp>
+#include <stan/io/empty_var_context.hpp>
+#include <test/test-models/good/optimization/rosenbrock.hpp>
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <vector>
+
+class ModelUtilGradHessLogProbParallel : public testing::Test {
+public:
+  ModelUtilGradHessLogProbParallel()
+    : model(context, &model_log) {
+  }
+
+  void TearDown() {
+    unsetenv("STAN_NUM_THREADS");
+  }
+
+  // Checks against the analytic gradient and Hessian of
+  // -((1 - x)^2 + 100 (y - x^2)^2).
+  void test_rosenbrock(double x, double y) {
+    std::vector<double> params_r(2);
+    params_r[0] = x;
+    params_r[1] = y;
+    std::vector<int> params_i;
+    std::vector<double> gradient;
+    std::vector<double> hessian;
+    double lp
+      = stan::model::grad_hess_log_prob<true, true>(model, params_r, params_i,
+                                                    gradient, hessian);
+    EXPECT_FLOAT_EQ(-((1 - x) * (1 - x)
+                      + 100 * (y - x * x) * (y - x * x)), lp);
+    ASSERT_EQ(2U, gradient.size());
+    EXPECT_FLOAT_EQ(2 * (1 - x) + 400 * x * (y - x * x), gradient[0]);
+    EXPECT_FLOAT_EQ(-200 * (y - x * x), gradient[1]);
+    ASSERT_EQ(4U, hessian.size());
+    EXPECT_FLOAT_EQ(-2 + 400 * y - 1200 * x * x, hessian[0]);
+    EXPECT_FLOAT_EQ(400 * x, hessian[1]);
+    EXPECT_FLOAT_EQ(400 * x, hessian[2]);
+    EXPECT_FLOAT_EQ(-200, hessian[3]);
+  }
+
+  stan::io::empty_var_context context;
+  std::stringstream model_log;
+  rosenbrock_model_namespace::rosenbrock_model model;
+};
+
+// Rosenbrock model flagged as not supporting fvar<var>, as stanc
+// does for models calling higher-order functions.
+class rosenbrock_no_fvar_var_model
+  : public rosenbrock_model_namespace::rosenbrock_model {
+public:
+  static const bool fvar_var_log_prob = false;
+
+  explicit rosenbrock_no_fvar_var_model(stan::io::var_context& context)
+    : rosenbrock_model_namespace::rosenbrock_model(context,
+        static_cast<std::ostream*>(0)) { }
+};
+
+TEST_F(ModelUtilGradHessLogProbParallel, serial) {
+  test_rosenbrock(-1.2, 1.0);
+  test_rosenbrock(0.5, 3.0);
+}
+
+TEST_F(ModelUtilGradHessLogProbParallel, threads) {
+  setenv("STAN_NUM_THREADS", "2", 1);
+  test_rosenbrock(-1.2, 1.0);
+  test_rosenbrock(0.5, 3.0);
+}
+
+TEST_F(ModelUtilGradHessLogProbParallel, bad_num_threads) {
+  std::vector<double> params_r(2);
+  std::vector<int> params_i;
+  std::vector<double> gradient;
+  std::vector<double> hessian;
+  setenv("STAN_NUM_THREADS", "0", 1);
+  EXPECT_THROW((stan::model::grad_hess_log_prob<true, true>(model, params_r,
+                                                            params_i,
+                                                            gradient,
+                                                            hessian)),
+               std::invalid_argument);
+}
+
+TEST_F(ModelUtilGradHessLogProbParallel, finite_diff_fallback) {
+  EXPECT_TRUE(stan::model::has_fvar_var_log_prob
+              <rosenbrock_model_namespace::rosenbrock_model>::value);
+  EXPECT_FALSE(stan::model::has_fvar_var_log_prob
+               <rosenbrock_no_fvar_var_model>::value);
+
+  rosenbrock_no_fvar_var_model fallback_model(context);
+  std::vector<double> params_r(2);
+  params_r[0] = -1.2;
+  params_r[1] = 1.0;
+  std::vector<int> params_i;
+  std::vector<double> gradient;
+  std::vector<double> hessian;
+  double lp
+    = stan::model::grad_hess_log_prob<true, true>(fallback_model, params_r,
+                                                  params_i, gradient,
+                                                  hessian);
+  EXPECT_FLOAT_EQ(-(2.2 * 2.2 + 100 * 0.44 * 0.44), lp);
+  ASSERT_EQ(2U, gradient.size());
+  EXPECT_FLOAT_EQ(2 * 2.2 - 400 * 1.2 * -0.44, gradient[0]);
+  EXPECT_FLOAT_EQ(200 * 0.44, gradient[1]);
+  ASSERT_EQ(4U, hessian.size());
+  EXPECT_NEAR(-2 + 400 - 1200 * 1.44, hessian[0], 1e-6);
+  EXPECT_NEAR(-480, hessian[1], 1e-6);
+  EXPECT_NEAR(-480, hessian[2], 1e-6);
+  EXPECT_NEAR(-200, hessian[3], 1e-6);
+
+  Eigen::VectorXd x(2);
+  x << -1.2, 1.0;
+  Eigen::VectorXd v(2);
+  v << 1.0, -2.0;
+  double f;
+  Eigen::VectorXd hess_f_dot_v;
+  stan::model::hessian_times_vector(fallback_model, x, v, f, hess_f_dot_v);
+  EXPECT_FLOAT_EQ(lp, f);
+  ASSERT_EQ(2, hess_f_dot_v.size());
+  EXPECT_NEAR(hessian[0] * v(0) + hessian[1] * v(1), hess_f_dot_v(0), 1e-6);
+  EXPECT_NEAR(hessian[2] * v(0) + hessian[3] * v(1), hess_f_dot_v(1), 1e-6);
+}
@@ -38,3 +38,26 @@ TEST(ModelUtil, grad_hess_log_prob) {
   EXPECT_EQ("", stan::test::cout_ss.str());
   EXPECT_EQ("", stan::test::cerr_ss.str());
 }
+
+TEST(ModelUtil, grad_hess_log_prob_exact) {
+  std::fstream data_stream(std::string("").c_str(), std::fstream::in);
+  stan::io::dump data_var_context(data_stream);
+  data_stream.close();
+
+  stan_model model(data_var_context, static_cast<std::stringstream*>(0));
+  std::vector<double> params_r(1, 1.5);
+  std::vector<int> params_i(0);
+  std::vector<double> gradient;
+  std::vector<double> hessian;
+
+  double lp = stan::model::grad_hess_log_prob<true, true, stan_model>(model,
+                                                                      params_r,
+                                                                      params_i,
+                                                                      gradient,
+                                                                      hessian);
+  EXPECT_FLOAT_EQ(-0.5 * 1.5 * 1.5, lp);
+  ASSERT_EQ(1U, gradient.size());
+  EXPECT_EQ(-1.5, gradient[0]);
+  ASSERT_EQ(1U, hessian.size());
+  EXPECT_EQ(-1.0, hessian[0]);
+}
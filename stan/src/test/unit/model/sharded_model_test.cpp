@@ -0,0 +1,241 @@
+#include <stan/model/sharded_model.hpp>
+#include <stan/model/socketpair_communicator.hpp>
+#include <stan/model/gradient.hpp>
+#include <stan/model/log_prob_grad.hpp>
+#include <stan/model/log_prob_propto.hpp>
+#include <stan/io/dump.hpp>
+#include <test/test-models/good/model/sharded_normal.hpp>
+#include <gtest/gtest.h>
+#include <unistd.h>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+typedef stan::model::sharded_model<stan_model> sharded_stan_model;
+
+const double y[] = { 1.2, -0.3, 2.5, 0.7, 1.9, -1.1 };
+
+// shard r of num_shards holds an equal slice of y; shard 0 the prior
+stan::io::dump shard_data(int r, int num_shards, bool bad_y = false) {
+  int N = 6 / num_shards;
+  std::stringstream ss;
+  ss << "N <- " << N << "\n"
+     << "include_prior <- " << (r == 0) << "\n"
+     << "y <- c(";
+  for (int n = 0; n < N; ++n) {
+    if (n > 0)
+      ss << ", ";
+    if (bad_y && r == num_shards - 1)
+      ss << "NaN";
+    else
+      ss << y[r * N + n];
+  }
+  ss << ")\n";
+  return stan::io::dump(ss);
+}
+
+// run serve_shard() in the workers, which never return
+void serve_workers(stan::model::socketpair_communicator& comm,
+                   bool bad_y = false) {
+  if (comm.rank() == 0)
+    return;
+  std::stringstream msgs;
+  stan::io::dump data = shard_data(comm.rank(), comm.size(), bad_y);
+  stan_model shard(data, &msgs);
+  stan::model::serve_shard(shard, comm, &msgs);
+  _exit(0);
+}
+
+class ModelShardedModel : public testing::Test {
+public:
+  ModelShardedModel()
+    : full_data(shard_data(0, 1)), full(full_data, &msgs),
+      params_r(2), params_i(0) {
+    params_r[0] = 0.4;
+    params_r[1] = -0.2;
+  }
+
+  std::stringstream msgs;
+  stan::io::dump full_data;
+  stan_model full;
+  std::vector<double> params_r;
+  std::vector<int> params_i;
+};
+
+TEST_F(ModelShardedModel, log_prob_grad) {
+  stan::model::socketpair_communicator comm(3);
+  serve_workers(comm);
+  stan::io::dump data = shard_data(0, 3);
+  sharded_stan_model model(comm, data, &msgs);
+  EXPECT_EQ(3, model.num_shards());
+
+  std::vector<double> grad, grad_expected;
+  double lp, lp_expected;
+
+  lp = stan::model::log_prob_grad<true, true>(model, params_r, params_i,
+                                              grad, &msgs);
+  lp_expected = stan::model::log_prob_grad<true, true>(full, params_r,
+                                                       params_i,
+                                                       grad_expected, &msgs);
+  EXPECT_FLOAT_EQ(lp_expected, lp);
+  ASSERT_EQ(grad_expected.size(), grad.size());
+  for (size_t n = 0; n < grad.size(); ++n)
+    EXPECT_FLOAT_EQ(grad_expected[n], grad[n]);
+
+  lp = stan::model::log_prob_grad<false, false>(model, params_r, params_i,
+                                                grad, &msgs);
+  lp_expected = stan::model::log_prob_grad<false, false>(full, params_r,
+                                                         params_i,
+                                                         grad_expected,
+                                                         &msgs);
+  EXPECT_FLOAT_EQ(lp_expected, lp);
+  for (size_t n = 0; n < grad.size(); ++n)
+    EXPECT_FLOAT_EQ(grad_expected[n], grad[n]);
+
+  Eigen::VectorXd x(2), g, g_expected;
+  x << 0.4, -0.2;
+  double f, f_expected;
+  stan::model::gradient(model, x, f, g, &msgs);
+  stan::model::gradient(full, x, f_expected, g_expected, &msgs);
+  EXPECT_FLOAT_EQ(f_expected, f);
+  for (int n = 0; n < g.size(); ++n)
+    EXPECT_FLOAT_EQ(g_expected(n), g(n));
+}
+
+TEST_F(ModelShardedModel, log_prob) {
+  stan::model::socketpair_communicator comm(2);
+  serve_workers(comm);
+  stan::io::dump data = shard_data(0, 2);
+  sharded_stan_model model(comm, data, &msgs);
+
+  double lp = model.log_prob<false, true>(params_r, params_i, &msgs);
+  EXPECT_FLOAT_EQ((full.log_prob<false, true>(params_r, params_i, &msgs)),
+                  lp);
+  lp = model.log_prob<false, false>(params_r, params_i, &msgs);
+  EXPECT_FLOAT_EQ((full.log_prob<false, false>(params_r, params_i, &msgs)),
+                  lp);
+  EXPECT_FLOAT_EQ(stan::model::log_prob_propto<true>(full, params_r,
+                                                     params_i, &msgs),
+                  stan::model::log_prob_propto<true>(model, params_r,
+                                                     params_i, &msgs));
+}
+
+TEST_F(ModelShardedModel, shard_error) {
+  stan::model::socketpair_communicator comm(3);
+  serve_workers(comm, true);
+  stan::io::dump data = shard_data(0, 3);
+  sharded_stan_model model(comm, data, &msgs);
+
+  std::vector<double> grad;
+  try {
+    stan::model::log_prob_grad<true, true>(model, params_r, params_i, grad,
+                                           &msgs);
+    FAIL() << "expected std::domain_error";
+  } catch (const std::domain_error& e) {
+    EXPECT_EQ(0U, std::string(e.what()).find("shard 2: "));
+  }
+
+  // shards keep serving after an error
+  params_r[0] = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_THROW((model.log_prob<false, false>(params_r, params_i, &msgs)),
+               std::domain_error);
+}
+
+TEST_F(ModelShardedModel, bad_reply_size) {
+  stan::model::socketpair_communicator comm(3);
+  if (comm.rank() == 1) {
+    // answer the first request with a reply of the wrong size
+    std::vector<double> request;
+    comm.recv(0, request);
+    comm.send(0, std::vector<double>(3, stan::model::SHARD_OK));
+  }
+  serve_workers(comm);
+  stan::io::dump data = shard_data(0, 3);
+  sharded_stan_model model(comm, data, &msgs);
+
+  std::vector<double> grad, grad_expected;
+  try {
+    stan::model::log_prob_grad<true, true>(model, params_r, params_i, grad,
+                                           &msgs);
+    FAIL() << "expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_EQ(0U, std::string(e.what()).find("shard 1: "));
+  }
+
+  // the reply of shard 2 was read, so the next call is in sync
+  double lp = stan::model::log_prob_grad<true, true>(model, params_r,
+                                                     params_i, grad, &msgs);
+  double lp_expected
+    = stan::model::log_prob_grad<true, true>(full, params_r, params_i,
+                                             grad_expected, &msgs);
+  EXPECT_FLOAT_EQ(lp_expected, lp);
+  ASSERT_EQ(grad_expected.size(), grad.size());
+  for (size_t n = 0; n < grad.size(); ++n)
+    EXPECT_FLOAT_EQ(grad_expected[n], grad[n]);
+}
+
+// forwards to a communicator, failing the first send to one rank
+class failing_send_communicator : public stan::model::shard_communicator {
+public:
+  failing_send_communicator(stan::model::shard_communicator& comm,
+                            int fail_to)
+    : comm_(comm), fail_to_(fail_to) { }
+
+  int rank() const { return comm_.rank(); }
+  int size() const { return comm_.size(); }
+
+  void send(int to, const std::vector<double>& buf) {
+    if (to == fail_to_) {
+      fail_to_ = -1;
+      throw std::runtime_error("send failed");
+    }
+    comm_.send(to, buf);
+  }
+
+  bool recv(int from, std::vector<double>& buf) {
+    return comm_.recv(from, buf);
+  }
+
+private:
+  stan::model::shard_communicator& comm_;
+  int fail_to_;
+};
+
+TEST_F(ModelShardedModel, send_error) {
+  stan::model::socketpair_communicator comm(3);
+  serve_workers(comm);
+  failing_send_communicator failing_comm(comm, 2);
+  stan::io::dump data = shard_data(0, 3);
+  sharded_stan_model model(failing_comm, data, &msgs);
+
+  std::vector<double> grad, grad_expected;
+  try {
+    stan::model::log_prob_grad<true, true>(model, params_r, params_i, grad,
+                                           &msgs);
+    FAIL() << "expected std::runtime_error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_EQ("shard 2: send failed", std::string(e.what()));
+  }
+
+  // the reply of shard 1 was read, so the next call is in sync
+  params_r[0] = -0.9;
+  double lp = stan::model::log_prob_grad<true, true>(model, params_r,
+                                                     params_i, grad, &msgs);
+  double lp_expected
+    = stan::model::log_prob_grad<true, true>(full, params_r, params_i,
+                                             grad_expected, &msgs);
+  EXPECT_FLOAT_EQ(lp_expected, lp);
+  ASSERT_EQ(grad_expected.size(), grad.size());
+  for (size_t n = 0; n < grad.size(); ++n)
+    EXPECT_FLOAT_EQ(grad_expected[n], grad[n]);
+}
+
+TEST(ModelSocketpairCommunicator, single_process) {
+  stan::model::socketpair_communicator comm(1);
+  EXPECT_EQ(0, comm.rank());
+  EXPECT_EQ(1, comm.size());
+  EXPECT_THROW(stan::model::socketpair_communicator(0),
+               std::invalid_argument);
+}
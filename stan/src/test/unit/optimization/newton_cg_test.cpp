@@ -0,0 +1,189 @@
+#include <gtest/gtest.h>
+#include <stan/optimization/newton_cg.hpp>
+#include <stan/io/dump.hpp>
+#include <test/test-models/good/optimization/rosenbrock.hpp>
+
+typedef rosenbrock_model_namespace::rosenbrock_model Model;
+typedef stan::optimization::NewtonCG<Model> Optimizer;
+
+// Quadratic log density which throws when differentiated twice, so
+// its gradient can be evaluated but not its Hessian-vector products.
+struct no_hessian_model {
+  size_t num_params_r() const { return 2; }
+
+  template <typename T>
+  static void check_order(const T& x) { }
+
+  template <typename T>
+  static void check_order(const stan::math::fvar<T>& x) {
+    throw std::domain_error("no_hessian_model: no second derivatives");
+  }
+
+  template <bool propto, bool jacobian_adjust_transform, typename T>
+  T log_prob(std::vector<T>& params_r, std::vector<int>& params_i,
+             std::ostream* msgs = 0) const {
+    check_order(params_r[0]);
+    return -0.5 * (params_r[0] * params_r[0] + params_r[1] * params_r[1]);
+  }
+
+  template <bool propto, bool jacobian_adjust_transform, typename T>
+  T log_prob(Eigen::Matrix<T, Eigen::Dynamic, 1>& params_r,
+             std::ostream* msgs = 0) const {
+    check_order(params_r(0));
+    return -0.5 * (params_r(0) * params_r(0) + params_r(1) * params_r(1));
+  }
+};
+
+TEST(OptimizationNewtonCG, TrustRegionOptions) {
+  stan::optimization::TrustRegionOptions<double> tr_opts;
+  EXPECT_FLOAT_EQ(1.0, tr_opts.radius0);
+  EXPECT_FLOAT_EQ(1e10, tr_opts.maxRadius);
+  EXPECT_FLOAT_EQ(1e-12, tr_opts.minRadius);
+  EXPECT_FLOAT_EQ(1e-4, tr_opts.eta);
+  EXPECT_EQ(100U, tr_opts.maxCGIts);
+}
+
+TEST(OptimizationNewtonCG, rosenbrock_convergence) {
+  // -1,1 is the standard initialization for the Rosenbrock function
+  std::vector<double> cont_vector(2);
+  cont_vector[0] = -1; cont_vector[1] = 1;
+  std::vector<int> disc_vector;
+
+  static const std::string DATA("");
+  std::stringstream data_stream(DATA);
+  stan::io::dump dummy_context(data_stream);
+
+  Model rb_model(dummy_context);
+  std::stringstream out;
+  Optimizer newton_cg(rb_model, cont_vector, disc_vector, &out);
+  EXPECT_EQ("", out.str());
+  EXPECT_FLOAT_EQ(-4, newton_cg.logp());
+
+  int ret = newton_cg.minimize(cont_vector);
+
+  // Check that the return code is normal
+  EXPECT_GT(ret, 0);
+
+  // Check the correct minimum was found
+  EXPECT_NEAR(cont_vector[0], 1.0, 1e-6);
+  EXPECT_NEAR(cont_vector[1], 1.0, 1e-6);
+
+  // Check that it didn't take too long to get there
+  EXPECT_LE(newton_cg.iter_num(), 40);
+  EXPECT_LE(newton_cg.grad_evals(), 50);
+  EXPECT_EQ(newton_cg.cg_iter_num(), newton_cg.hessian_vector_evals());
+}
+
+TEST(OptimizationNewtonCG, rosenbrock_cg_iter) {
+  std::vector<double> cont_vector(2);
+  cont_vector[0] = -1; cont_vector[1] = 1;
+  std::vector<int> disc_vector;
+
+  static const std::string DATA("");
+  std::stringstream data_stream(DATA);
+  stan::io::dump dummy_context(data_stream);
+
+  Model rb_model(dummy_context);
+  Optimizer newton_cg(rb_model, cont_vector, disc_vector, 0);
+  newton_cg._tr_opts.maxCGIts = 1;
+
+  int ret = newton_cg.minimize(cont_vector);
+
+  // each attempted step is a single conjugate gradient iteration
+  // followed by one evaluation of the trial point
+  EXPECT_EQ(newton_cg.cg_iter_num() + 1, newton_cg.grad_evals());
+  EXPECT_GT(ret, 0);
+  EXPECT_NEAR(cont_vector[0], 1.0, 1e-4);
+  EXPECT_NEAR(cont_vector[1], 1.0, 1e-4);
+}
+
+TEST(OptimizationNewtonCG, rosenbrock_termconds) {
+  std::vector<double> cont_vector(2);
+  cont_vector[0] = -1; cont_vector[1] = 1;
+  std::vector<int> disc_vector;
+
+  static const std::string DATA("");
+  std::stringstream data_stream(DATA);
+  stan::io::dump dummy_context(data_stream);
+
+  Model rb_model(dummy_context);
+  Optimizer newton_cg(rb_model, cont_vector, disc_vector, 0);
+
+  newton_cg._conv_opts.maxIts = 3;
+  int ret = 0;
+  while (ret == 0)
+    ret = newton_cg.step();
+  EXPECT_EQ(stan::optimization::TERM_MAXIT, ret);
+  EXPECT_EQ(3U, newton_cg.iter_num());
+
+  newton_cg.initialize(cont_vector);
+  newton_cg._conv_opts.maxIts = 1e9;
+  newton_cg._conv_opts.tolAbsGrad = 1e3;
+  EXPECT_EQ(stan::optimization::TERM_ABSGRAD, newton_cg.step());
+  EXPECT_EQ(1U, newton_cg.iter_num());
+}
+
+TEST(OptimizationNewtonCG, hessian_throws) {
+  std::vector<double> cont_vector(2);
+  cont_vector[0] = -1; cont_vector[1] = 1;
+  std::vector<int> disc_vector;
+
+  no_hessian_model model;
+  std::stringstream out;
+  stan::optimization::NewtonCG<no_hessian_model>
+    newton_cg(model, cont_vector, disc_vector, &out);
+  EXPECT_FLOAT_EQ(-1, newton_cg.logp());
+
+  // the domain error rejects the step instead of escaping step()
+  EXPECT_EQ(stan::optimization::TERM_LSFAIL, newton_cg.step());
+  EXPECT_EQ(1U, newton_cg.hessian_vector_evals());
+  EXPECT_NE(std::string::npos,
+            out.str().find("no_hessian_model: no second derivatives"));
+  std::vector<double> x;
+  newton_cg.params_r(x);
+  EXPECT_FLOAT_EQ(-1, x[0]);
+  EXPECT_FLOAT_EQ(1, x[1]);
+}
+
+TEST(OptimizationNewtonCG, zero_gradient) {
+  // the gradient is exactly zero at the minimum of the Rosenbrock
+  // function
+  std::vector<double> cont_vector(2, 1);
+  std::vector<int> disc_vector;
+
+  static const std::string DATA("");
+  std::stringstream data_stream(DATA);
+  stan::io::dump dummy_context(data_stream);
+
+  Model rb_model(dummy_context);
+  Optimizer newton_cg(rb_model, cont_vector, disc_vector, 0);
+  newton_cg._conv_opts.tolAbsGrad = 0;
+  EXPECT_FLOAT_EQ(0, newton_cg.grad_norm());
+
+  // the zero step is rejected without a Hessian-vector product
+  EXPECT_EQ(stan::optimization::TERM_LSFAIL, newton_cg.step());
+  EXPECT_EQ(0U, newton_cg.hessian_vector_evals());
+  std::vector<double> x;
+  newton_cg.params_r(x);
+  EXPECT_FLOAT_EQ(1, x[0]);
+  EXPECT_FLOAT_EQ(1, x[1]);
+}
+
+TEST(OptimizationNewtonCG, get_code_string) {
+  std::vector<double> cont_vector(2, 0);
+  std::vector<int> disc_vector;
+
+  static const std::string DATA("");
+  std::stringstream data_stream(DATA);
+  stan::io::dump dummy_context(data_stream);
+
+  Model rb_model(dummy_context);
+  Optimizer newton_cg(rb_model, cont_vector, disc_vector, 0);
+
+  EXPECT_EQ("Successful step completed",
+            newton_cg.get_code_string(stan::optimization::TERM_SUCCESS));
+  EXPECT_EQ("Trust region shrank below its minimum radius,"
+            " no more progress can be made",
+            newton_cg.get_code_string(stan::optimization::TERM_LSFAIL));
+  EXPECT_EQ("Unknown termination code", newton_cg.get_code_string(100));
+}
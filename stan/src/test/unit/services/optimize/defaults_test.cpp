@@ -97,6 +97,20 @@ TEST(optimize_defaults, history_size) {
   EXPECT_EQ(5, history_size::default_value());
 }
 
+TEST(optimize_defaults, cg_iter) {
+  using stan::services::optimize::cg_iter;
+  EXPECT_EQ("Maximum number of conjugate gradient iterations per"
+            " Newton-CG step.",
+            cg_iter::description());
+
+  EXPECT_NO_THROW(cg_iter::validate(cg_iter::default_value()));
+  EXPECT_NO_THROW(cg_iter::validate(1));
+  EXPECT_THROW(cg_iter::validate(0),
+               std::invalid_argument);
+
+  EXPECT_EQ(100, cg_iter::default_value());
+}
+
 TEST(optimize_defaults, iter) {
   using stan::services::optimize::iter;
   EXPECT_EQ("Total number of iterations.",
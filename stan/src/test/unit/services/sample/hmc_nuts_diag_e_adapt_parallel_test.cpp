@@ -0,0 +1,208 @@
+#define STAN_THREADS
+#include <stan/services/sample/hmc_nuts_diag_e_adapt.hpp>
+#include <gtest/gtest.h>
+#include <stan/io/empty_var_context.hpp>
+#include <test/test-models/good/optimization/rosenbrock.hpp>
+#include <test/unit/services/instrumented_callbacks.hpp>
+#include <iostream>
+
+class ServicesSampleHmcNutsDiagEAdaptParallel : public testing::Test {
+public:
+  ServicesSampleHmcNutsDiagEAdaptParallel()
+    : model(context, &model_log),
+      num_chains(3), init(num_chains), parameter(num_chains),
+      diagnostic(num_chains) {
+    for (size_t n = 0; n < num_chains; ++n) {
+      init_ptr.push_back(&init[n]);
+      parameter_ptr.push_back(&parameter[n]);
+      diagnostic_ptr.push_back(&diagnostic[n]);
+      contexts.push_back(&context);
+      metrics.push_back(&unit_e_metric);
+    }
+  }
+
+  std::stringstream model_log;
+  stan::test::unit::instrumented_logger logger;
+  stan::io::empty_var_context context;
+  stan_model model;
+  size_t num_chains;
+  std::vector<stan::test::unit::instrumented_writer> init, parameter,
+    diagnostic;
+  std::vector<stan::callbacks::writer*> init_ptr, parameter_ptr,
+    diagnostic_ptr;
+  stan::io::dump unit_e_metric
+    = stan::services::util::create_unit_e_diag_inv_metric(2);
+  std::vector<stan::io::var_context*> contexts, metrics;
+};
+
+TEST_F(ServicesSampleHmcNutsDiagEAdaptParallel, call_count) {
+  unsigned int random_seed = 0;
+  unsigned int chain = 1;
+  double init_radius = 0;
+  int num_warmup = 200;
+  int num_samples = 400;
+  int num_thin = 5;
+  bool save_warmup = true;
+  int refresh = 0;
+  double stepsize = 0.1;
+  double stepsize_jitter = 0;
+  int max_depth = 8;
+  double delta = .1;
+  double gamma = .1;
+  double kappa = .1;
+  double t0 = .1;
+  unsigned int init_buffer = 50;
+  unsigned int term_buffer = 50;
+  unsigned int window = 100;
+  stan::test::unit::instrumented_interrupt interrupt;
+  EXPECT_EQ(interrupt.call_count(), 0);
+
+  int return_code = stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, num_chains, 2, contexts, metrics, random_seed, chain,
+      init_radius, num_warmup, num_samples, num_thin, save_warmup, refresh,
+      stepsize, stepsize_jitter, max_depth, delta, gamma, kappa, t0,
+      init_buffer, term_buffer, window,
+      interrupt, logger, init_ptr,
+      parameter_ptr, diagnostic_ptr);
+
+  EXPECT_EQ(0, return_code);
+
+  int num_output_lines = (num_warmup+num_samples)/num_thin;
+  EXPECT_EQ(num_chains * (num_warmup+num_samples), interrupt.call_count());
+  for (size_t n = 0; n < num_chains; ++n) {
+    EXPECT_EQ(1, parameter[n].call_count("vector_string"));
+    EXPECT_EQ(num_output_lines, parameter[n].call_count("vector_double"));
+    EXPECT_EQ(1, diagnostic[n].call_count("vector_string"));
+    EXPECT_EQ(num_output_lines, diagnostic[n].call_count("vector_double"));
+  }
+  EXPECT_EQ(num_chains, logger.find_info("seconds (Total)"));
+  EXPECT_EQ(0, logger.call_count_error());
+}
+
+TEST_F(ServicesSampleHmcNutsDiagEAdaptParallel, mismatched_sizes) {
+  stan::test::unit::instrumented_interrupt interrupt;
+  std::vector<stan::io::var_context*> short_contexts(contexts.begin(),
+                                                     contexts.end() - 1);
+  std::vector<stan::callbacks::writer*> short_diagnostic_ptr(
+      diagnostic_ptr.begin(), diagnostic_ptr.end() - 1);
+
+  EXPECT_THROW(stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, num_chains, 2, short_contexts, metrics, 0, 1, 0, 10, 10, 1,
+      false, 0, 0.1, 0, 8, .8, .05, .75, 10, 15, 10, 25,
+      interrupt, logger, init_ptr, parameter_ptr, diagnostic_ptr),
+               std::invalid_argument);
+  EXPECT_THROW(stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, num_chains, 2, contexts, metrics, 0, 1, 0, 10, 10, 1,
+      false, 0, 0.1, 0, 8, .8, .05, .75, 10, 15, 10, 25,
+      interrupt, logger, init_ptr, parameter_ptr, short_diagnostic_ptr),
+               std::invalid_argument);
+  EXPECT_EQ(0U, interrupt.call_count());
+  for (size_t n = 0; n < num_chains; ++n)
+    EXPECT_EQ(0U, parameter[n].call_count());
+}
+
+TEST_F(ServicesSampleHmcNutsDiagEAdaptParallel, matches_single_chain) {
+  unsigned int random_seed = 0;
+  unsigned int chain = 1;
+  double init_radius = 2;
+  int num_warmup = 100;
+  int num_samples = 100;
+  int num_thin = 1;
+  bool save_warmup = false;
+  int refresh = 0;
+  double stepsize = 0.1;
+  double stepsize_jitter = 0;
+  int max_depth = 8;
+  double delta = .8;
+  double gamma = .05;
+  double kappa = .75;
+  double t0 = 10;
+  unsigned int init_buffer = 15;
+  unsigned int term_buffer = 10;
+  unsigned int window = 25;
+  stan::test::unit::instrumented_interrupt interrupt;
+
+  int return_code = stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, num_chains, 0, contexts, metrics, random_seed, chain,
+      init_radius, num_warmup, num_samples, num_thin, save_warmup, refresh,
+      stepsize, stepsize_jitter, max_depth, delta, gamma, kappa, t0,
+      init_buffer, term_buffer, window,
+      interrupt, logger, init_ptr,
+      parameter_ptr, diagnostic_ptr);
+  EXPECT_EQ(0, return_code);
+
+  for (size_t n = 0; n < num_chains; ++n) {
+    stan::test::unit::instrumented_writer single_init, single_parameter,
+      single_diagnostic;
+    return_code = stan::services::sample::hmc_nuts_diag_e_adapt(
+        model, context, unit_e_metric, random_seed, chain + n, init_radius,
+        num_warmup, num_samples, num_thin, save_warmup, refresh,
+        stepsize, stepsize_jitter, max_depth, delta, gamma, kappa, t0,
+        init_buffer, term_buffer, window,
+        interrupt, logger, single_init,
+        single_parameter, single_diagnostic);
+    EXPECT_EQ(0, return_code);
+
+    std::vector<std::vector<double> > expected
+      = single_parameter.vector_double_values();
+    std::vector<std::vector<double> > found
+      = parameter[n].vector_double_values();
+    ASSERT_EQ(expected.size(), found.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i].size(), found[i].size());
+      for (size_t j = 0; j < expected[i].size(); ++j)
+        EXPECT_FLOAT_EQ(expected[i][j], found[i][j]);
+    }
+  }
+}
+
+TEST_F(ServicesSampleHmcNutsDiagEAdaptParallel, convergence_monitor) {
+  unsigned int random_seed = 0;
+  unsigned int chain = 1;
+  double init_radius = 2;
+  int num_warmup = 100;
+  int num_samples = 2000;
+  int num_thin = 1;
+  bool save_warmup = true;
+  int refresh = 0;
+  double stepsize = 0.1;
+  double stepsize_jitter = 0;
+  int max_depth = 8;
+  double delta = .8;
+  double gamma = .05;
+  double kappa = .75;
+  double t0 = 10;
+  unsigned int init_buffer = 15;
+  unsigned int term_buffer = 10;
+  unsigned int window = 25;
+  stan::test::unit::instrumented_interrupt interrupt;
+  stan::mcmc::convergence_monitor monitor(num_chains, 20, 50);
+
+  int return_code = stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, num_chains, 0, contexts, metrics, random_seed, chain,
+      init_radius, num_warmup, num_samples, num_thin, save_warmup, refresh,
+      stepsize, stepsize_jitter, max_depth, delta, gamma, kappa, t0,
+      init_buffer, term_buffer, window,
+      interrupt, logger, init_ptr,
+      parameter_ptr, diagnostic_ptr, &monitor);
+  EXPECT_EQ(0, return_code);
+
+  EXPECT_TRUE(monitor.target_reached());
+  EXPECT_GE(monitor.min_ess(), 20);
+  EXPECT_EQ(0U, monitor.num_draws() % 50);
+  std::vector<std::string> names = monitor.names();
+  ASSERT_EQ(3U, names.size());
+  EXPECT_EQ("lp__", names[0]);
+
+  // the chains stopping last do not draw all samples
+  int num_draws = 0;
+  for (size_t n = 0; n < num_chains; ++n) {
+    int num_output_lines = parameter[n].call_count("vector_double");
+    EXPECT_GE(num_output_lines, num_warmup + 50);
+    num_draws += num_output_lines - num_warmup;
+  }
+  EXPECT_LT(num_draws, static_cast<int>(num_chains) * num_samples);
+  EXPECT_LE(1, logger.find_info("Target effective sample size reached"));
+  EXPECT_EQ(1, logger.find_info("Convergence monitor: after"));
+  EXPECT_EQ(0, logger.call_count_error());
+}
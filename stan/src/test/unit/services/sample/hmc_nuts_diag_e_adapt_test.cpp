@@ -205,3 +205,44 @@ TEST_F(ServicesSampleHmcNutsDiagEAdapt, output_regression) {
   EXPECT_EQ(1, logger.find_info("seconds (Total)"));
   EXPECT_EQ(0, logger.call_count_error());
 }
+
+TEST_F(ServicesSampleHmcNutsDiagEAdapt, convergence_monitor) {
+  unsigned int random_seed = 0;
+  unsigned int chain = 1;
+  double init_radius = 2;
+  int num_warmup = 100;
+  int num_samples = 2000;
+  int num_thin = 1;
+  bool save_warmup = true;
+  int refresh = 0;
+  double stepsize = 0.1;
+  double stepsize_jitter = 0;
+  int max_depth = 8;
+  double delta = .8;
+  double gamma = .05;
+  double kappa = .75;
+  double t0 = 10;
+  unsigned int init_buffer = 15;
+  unsigned int term_buffer = 10;
+  unsigned int window = 25;
+  stan::test::unit::instrumented_interrupt interrupt;
+  stan::io::dump unit_e_metric
+    = stan::services::util::create_unit_e_diag_inv_metric(2);
+  stan::mcmc::convergence_monitor monitor(1, 20, 50);
+
+  int return_code = stan::services::sample::hmc_nuts_diag_e_adapt(
+      model, context, unit_e_metric, random_seed, chain, init_radius,
+      num_warmup, num_samples, num_thin, save_warmup, refresh,
+      stepsize, stepsize_jitter, max_depth, delta, gamma, kappa, t0,
+      init_buffer, term_buffer, window,
+      interrupt, logger, init, parameter, diagnostic, &monitor);
+  EXPECT_EQ(0, return_code);
+
+  EXPECT_TRUE(monitor.target_reached());
+  EXPECT_GE(monitor.min_ess(), 20);
+  EXPECT_EQ(0U, monitor.num_draws() % 50);
+  // sampling stops at the check which reached the target
+  EXPECT_EQ(num_warmup + static_cast<int>(monitor.num_draws()),
+            parameter.call_count("vector_double"));
+  EXPECT_LT(static_cast<int>(monitor.num_draws()), num_samples);
+}
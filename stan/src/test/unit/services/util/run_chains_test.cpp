@@ -0,0 +1,56 @@
+#define STAN_THREADS
+#include <stan/services/util/run_chains.hpp>
+#include <stan/services/error_codes.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+TEST(ServicesUtil, run_chains_all_chains_run) {
+  std::vector<int> visits(10, 0);
+  std::vector<int> return_codes
+    = stan::services::util::run_chains(10, 4, [&](size_t n) {
+        ++visits[n];
+        return stan::services::error_codes::OK;
+      });
+  ASSERT_EQ(10U, return_codes.size());
+  for (size_t n = 0; n < visits.size(); ++n) {
+    EXPECT_EQ(1, visits[n]);
+    EXPECT_EQ(stan::services::error_codes::OK, return_codes[n]);
+  }
+  EXPECT_EQ(stan::services::error_codes::OK,
+            stan::services::util::combine_return_codes(return_codes));
+}
+
+TEST(ServicesUtil, run_chains_return_codes) {
+  std::vector<int> return_codes
+    = stan::services::util::run_chains(3, 0, [](size_t n) {
+        return n == 1 ? stan::services::error_codes::CONFIG
+          : stan::services::error_codes::OK;
+      });
+  EXPECT_EQ(stan::services::error_codes::OK, return_codes[0]);
+  EXPECT_EQ(stan::services::error_codes::CONFIG, return_codes[1]);
+  EXPECT_EQ(stan::services::error_codes::OK, return_codes[2]);
+  EXPECT_EQ(stan::services::error_codes::CONFIG,
+            stan::services::util::combine_return_codes(return_codes));
+}
+
+TEST(ServicesUtil, run_chains_rethrows) {
+  std::vector<int> visits(5, 0);
+  EXPECT_THROW(stan::services::util::run_chains(5, 2, [&](size_t n) {
+        ++visits[n];
+        if (n == 2)
+          throw std::domain_error("chain failed");
+        return stan::services::error_codes::OK;
+      }), std::domain_error);
+  for (size_t n = 0; n < visits.size(); ++n)
+    EXPECT_EQ(1, visits[n]);
+}
+
+TEST(ServicesUtil, check_num_chains) {
+  std::vector<int> x(3);
+  EXPECT_NO_THROW(stan::services::util::check_num_chains("f", "x", x, 3));
+  EXPECT_THROW(stan::services::util::check_num_chains("f", "x", x, 4),
+               std::invalid_argument);
+  EXPECT_THROW(stan::services::util::check_num_chains("f", "x", x, 2),
+               std::invalid_argument);
+}
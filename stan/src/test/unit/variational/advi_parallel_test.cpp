@@ -0,0 +1,212 @@
+#define STAN_THREADS
+#include <test/test-models/good/variational/multivariate_no_constraint.hpp>
+#include <stan/variational/advi.hpp>
+#include <stan/callbacks/stream_logger.hpp>
+#include <gtest/gtest.h>
+#include <boost/random/additive_combine.hpp> // L'Ecuyer RNG
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+
+typedef boost::ecuyer1988 rng_t;
+typedef multivariate_no_constraint_model_namespace::multivariate_no_constraint_model Model;
+
+// Model whose draws with a positive first coordinate are dropped,
+// writing a message at every evaluation.
+struct dropping_model {
+  template <bool propto, bool jacobian_adjust_transform, typename T>
+  T log_prob(Eigen::Matrix<T, Eigen::Dynamic, 1>& params_r,
+             std::ostream* msgs) const {
+    *msgs << "draw " << stan::math::value_of(params_r(0));
+    if (params_r(0) > 0)
+      throw std::domain_error("dropping_model: positive draw");
+    return -0.5 * stan::math::dot_self(params_r);
+  }
+};
+
+class advi_parallel_test : public testing::Test {
+public:
+  advi_parallel_test()
+    : data_stream(""),
+      dummy_context(data_stream),
+      my_model(dummy_context),
+      logger(log_stream, log_stream, log_stream, log_stream, log_stream),
+      cont_params(Eigen::VectorXd::Zero(my_model.num_params_r())),
+      mu(Eigen::VectorXd::Constant(my_model.num_params_r(), 0.3)),
+      omega(Eigen::VectorXd::Constant(my_model.num_params_r(), -0.2)) {
+  }
+
+  void TearDown() {
+    unsetenv("STAN_NUM_THREADS");
+  }
+
+  double elbo(const char* num_threads) {
+    setenv("STAN_NUM_THREADS", num_threads, 1);
+    rng_t base_rng(0);
+    stan::variational::advi<Model, stan::variational::normal_meanfield, rng_t>
+      test_advi(my_model, cont_params, base_rng, 20, 50, 100, 1);
+    stan::variational::normal_meanfield q(mu, omega);
+    return test_advi.calc_ELBO(q, logger);
+  }
+
+  stan::variational::normal_meanfield meanfield_grad(const char* num_threads) {
+    setenv("STAN_NUM_THREADS", num_threads, 1);
+    rng_t base_rng(0);
+    stan::variational::normal_meanfield q(mu, omega);
+    stan::variational::normal_meanfield grad(my_model.num_params_r());
+    q.calc_grad(grad, my_model, cont_params, 20, base_rng, logger);
+    return grad;
+  }
+
+  stan::variational::normal_fullrank fullrank_grad(const char* num_threads) {
+    setenv("STAN_NUM_THREADS", num_threads, 1);
+    rng_t base_rng(0);
+    stan::variational::normal_fullrank q(mu);
+    stan::variational::normal_fullrank grad(my_model.num_params_r());
+    q.calc_grad(grad, my_model, cont_params, 20, base_rng, logger);
+    return grad;
+  }
+
+  std::stringstream data_stream;
+  stan::io::dump dummy_context;
+  Model my_model;
+  std::stringstream log_stream;
+  stan::callbacks::stream_logger logger;
+  Eigen::VectorXd cont_params;
+  Eigen::VectorXd mu;
+  Eigen::VectorXd omega;
+};
+
+TEST_F(advi_parallel_test, calc_ELBO_independent_of_threads) {
+  double elbo_serial = elbo("1");
+  EXPECT_EQ(elbo_serial, elbo("3"));
+  EXPECT_EQ(elbo_serial, elbo("-1"));
+}
+
+TEST_F(advi_parallel_test, meanfield_calc_grad_independent_of_threads) {
+  stan::variational::normal_meanfield grad_serial = meanfield_grad("1");
+  stan::variational::normal_meanfield grad_threads = meanfield_grad("3");
+  for (int d = 0; d < grad_serial.dimension(); ++d) {
+    EXPECT_EQ(grad_serial.mu()(d), grad_threads.mu()(d));
+    EXPECT_EQ(grad_serial.omega()(d), grad_threads.omega()(d));
+  }
+}
+
+TEST_F(advi_parallel_test, fullrank_calc_grad_independent_of_threads) {
+  stan::variational::normal_fullrank grad_serial = fullrank_grad("1");
+  stan::variational::normal_fullrank grad_threads = fullrank_grad("3");
+  for (int d = 0; d < grad_serial.dimension(); ++d)
+    EXPECT_EQ(grad_serial.mu()(d), grad_threads.mu()(d));
+  for (int i = 0; i < grad_serial.dimension(); ++i)
+    for (int j = 0; j < grad_serial.dimension(); ++j)
+      EXPECT_EQ(grad_serial.L_chol()(i, j), grad_threads.L_chol()(i, j));
+}
+
+TEST_F(advi_parallel_test, bad_num_threads) {
+  setenv("STAN_NUM_THREADS", "0", 1);
+  rng_t base_rng(0);
+  stan::variational::normal_meanfield q(mu, omega);
+  stan::variational::normal_meanfield grad(my_model.num_params_r());
+  EXPECT_THROW(q.calc_grad(grad, my_model, cont_params, 20, base_rng, logger),
+               std::invalid_argument);
+}
+
+TEST_F(advi_parallel_test, log_prob_draws_in_serial_order) {
+  dropping_model model;
+  stan::variational::normal_meanfield q(Eigen::VectorXd::Zero(2),
+                                        Eigen::VectorXd::Zero(2));
+
+  // draw and evaluate one draw at a time
+  rng_t rng_expected(0);
+  std::stringstream log_expected;
+  stan::callbacks::stream_logger logger_expected(log_expected, log_expected,
+                                                 log_expected, log_expected,
+                                                 log_expected);
+  Eigen::VectorXd expected(20);
+  Eigen::VectorXd zeta(2);
+  for (int i = 0; i < 20; ) {
+    q.sample(rng_expected, zeta);
+    std::stringstream ss;
+    try {
+      double lp = model.log_prob<false, true>(zeta, &ss);
+      logger_expected.info(ss);
+      expected(i++) = lp;
+    } catch (const std::domain_error& e) {
+    }
+  }
+
+  const char* num_threads[] = {"1", "3"};
+  for (int n = 0; n < 2; ++n) {
+    setenv("STAN_NUM_THREADS", num_threads[n], 1);
+    rng_t base_rng(0);
+    std::stringstream log;
+    stan::callbacks::stream_logger logger(log, log, log, log, log);
+    Eigen::VectorXd log_prob;
+    stan::variational::log_prob_draws(q, model, 20, 100, base_rng, logger,
+                                      "log_prob_draws", log_prob);
+    ASSERT_EQ(20, log_prob.size());
+    for (int i = 0; i < 20; ++i)
+      EXPECT_EQ(expected(i), log_prob(i));
+    EXPECT_EQ(log_expected.str(), log.str());
+    rng_t rng_next(rng_expected);
+    EXPECT_EQ(rng_next(), base_rng());
+  }
+}
+
+TEST_F(advi_parallel_test, gradient_draws_in_serial_order) {
+  dropping_model model;
+  stan::variational::normal_meanfield q(Eigen::VectorXd::Zero(2),
+                                        Eigen::VectorXd::Zero(2));
+
+  // draw and evaluate one draw at a time
+  rng_t rng_expected(0);
+  Eigen::MatrixXd eta_expected(2, 20);
+  Eigen::MatrixXd grad_expected(2, 20);
+  for (int i = 0; i < 20; ) {
+    Eigen::VectorXd eta(2);
+    for (int d = 0; d < 2; ++d)
+      eta(d) = stan::math::normal_rng(0, 1, rng_expected);
+    double lp;
+    Eigen::VectorXd grad;
+    std::stringstream ss;
+    try {
+      stan::model::gradient(model, q.transform(eta), lp, grad, &ss);
+      eta_expected.col(i) = eta;
+      grad_expected.col(i) = grad;
+      ++i;
+    } catch (const std::exception& e) {
+    }
+  }
+
+  const char* num_threads[] = {"1", "3"};
+  for (int n = 0; n < 2; ++n) {
+    setenv("STAN_NUM_THREADS", num_threads[n], 1);
+    rng_t base_rng(0);
+    Eigen::MatrixXd eta;
+    Eigen::MatrixXd grad;
+    stan::variational::gradient_draws(q, model, 20, 100, base_rng, logger,
+                                      "gradient_draws", eta, grad);
+    for (int i = 0; i < 20; ++i) {
+      for (int d = 0; d < 2; ++d) {
+        EXPECT_EQ(eta_expected(d, i), eta(d, i));
+        EXPECT_EQ(grad_expected(d, i), grad(d, i));
+      }
+    }
+    rng_t rng_next(rng_expected);
+    EXPECT_EQ(rng_next(), base_rng());
+  }
+}
+
+TEST_F(advi_parallel_test, max_dropped_draws) {
+  setenv("STAN_NUM_THREADS", "3", 1);
+  dropping_model model;
+  stan::variational::normal_meanfield q(Eigen::VectorXd::Zero(2),
+                                        Eigen::VectorXd::Zero(2));
+  rng_t base_rng(0);
+  Eigen::VectorXd log_prob;
+  EXPECT_THROW(stan::variational::log_prob_draws(q, model, 20, 3, base_rng,
+                                                 logger, "log_prob_draws",
+                                                 log_prob),
+               std::domain_error);
+}